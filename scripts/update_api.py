@@ -316,6 +316,11 @@ def display_args_to_z3(params):
 NULLWrapped = [ 'Z3_mk_context', 'Z3_mk_context_rc' ]
 Unwrapped = [ 'Z3_del_context', 'Z3_get_error_code' ]
 
+# Reference counting functions do not report errors. The Python wrappers
+# skip the error check for them, because they are called for every object.
+def is_py_unchecked(name):
+    return name.endswith('_inc_ref') or name.endswith('_dec_ref')
+
 def mk_py_wrappers():
     core_py.write("""
 class Elementaries:
@@ -357,6 +362,10 @@ def Z3_solver_propagate_diseq(ctx, s, diseq_eh, _elems = Elementaries(_lib.Z3_so
     _elems.f(ctx, s, diseq_eh)
     _elems.Check(ctx)
 
+def Z3_solver_propagate_batch(ctx, s, batch_eh, _elems = Elementaries(_lib.Z3_solver_propagate_batch)):
+    _elems.f(ctx, s, batch_eh)
+    _elems.Check(ctx)
+
 def Z3_optimize_register_model_eh(ctx, o, m, user_ctx, on_model_eh, _elems = Elementaries(_lib.Z3_optimize_register_model_eh)):
     _elems.f(ctx, o, m, user_ctx, on_model_eh)
     _elems.Check(ctx)
@@ -384,7 +393,7 @@ def mk_py_wrapper_single(sig, decode_string=True):
     core_py.write("  %s_elems.f(" % lval)
     display_args_to_z3(params)
     core_py.write(")\n")
-    if len(params) > 0 and param_type(params[0]) == CONTEXT and not name in Unwrapped:
+    if len(params) > 0 and param_type(params[0]) == CONTEXT and not name in Unwrapped and not is_py_unchecked(name):
         core_py.write("  _elems.Check(a0)\n")
     if result == STRING and decode_string:
         core_py.write("  return _to_pystr(r)\n")
@@ -1203,6 +1212,8 @@ def ml_plus_type(ts):
         return 'Z3_fixedpoint_plus'
     elif ts == 'Z3_optimize':
         return 'Z3_optimize_plus'
+    elif ts == 'Z3_simplifier':
+        return 'Z3_simplifier_plus'
     else:
         return ts
 
@@ -1247,6 +1258,8 @@ def ml_minus_type(ts):
         return 'Z3_fixedpoint'
     elif ts == 'Z3_optimize_plus':
         return 'Z3_optimize'
+    elif ts == 'Z3_simplifier_plus':
+        return 'Z3_simplifier'
     else:
         return ts
 
@@ -1853,6 +1866,9 @@ fresh_eh_type = ctypes.CFUNCTYPE(ctypes.c_void_p, ctypes.c_void_p, ctypes.c_void
 fixed_eh_type = ctypes.CFUNCTYPE(None, ctypes.c_void_p, ctypes.c_void_p, ctypes.c_uint, ctypes.c_void_p)
 final_eh_type = ctypes.CFUNCTYPE(None, ctypes.c_void_p, ctypes.c_void_p)
 eq_eh_type    = ctypes.CFUNCTYPE(None, ctypes.c_void_p, ctypes.c_void_p, ctypes.c_uint, ctypes.c_uint)
+batch_eh_type = ctypes.CFUNCTYPE(None, ctypes.c_void_p, ctypes.c_void_p, 
+                                 ctypes.c_uint, ctypes.POINTER(ctypes.c_uint), ctypes.POINTER(ctypes.c_void_p), 
+                                 ctypes.c_uint, ctypes.POINTER(ctypes.c_uint), ctypes.POINTER(ctypes.c_uint))
 
 _lib.Z3_solver_propagate_init.restype = None
 _lib.Z3_solver_propagate_init.argtypes = [ContextObj, SolverObj, ctypes.c_void_p, push_eh_type, pop_eh_type, fresh_eh_type]
@@ -1869,6 +1885,9 @@ _lib.Z3_solver_propagate_eq.argtypes = [ContextObj, SolverObj, eq_eh_type]
 _lib.Z3_solver_propagate_diseq.restype = None
 _lib.Z3_solver_propagate_diseq.argtypes = [ContextObj, SolverObj, eq_eh_type]
 
+_lib.Z3_solver_propagate_batch.restype = None
+_lib.Z3_solver_propagate_batch.argtypes = [ContextObj, SolverObj, batch_eh_type]
+
 on_model_eh_type = ctypes.CFUNCTYPE(None, ctypes.c_void_p)
 _lib.Z3_optimize_register_model_eh.restype = None
 _lib.Z3_optimize_register_model_eh.argtypes = [ContextObj, OptimizeObj, ModelObj, ctypes.c_void_p, on_model_eh_type]
@@ -0,0 +1,239 @@
+# -- /usr/bin/env python
+"""
+Runs a corpus of SMT-LIB2, DIMACS and CHC benchmarks through the z3
+binary with fixed seeds and records the wall time, the maximal memory,
+the number of conflicts and the resource count of every run.
+
+With --baseline the results are compared against a stored run. The time
+samples of a benchmark are compared by a Mann-Whitney U test, so a
+regression is only reported if the slowdown is significant. Conflicts,
+resource counts and memory are reported when the median changes by more
+than the threshold.
+
+With --reduce-dir and --baseline-z3, SMT-LIB2 benchmarks whose resource
+count regressed are reduced by expr_delta (test-z3 smt2_delta) as long
+as the reduced benchmark keeps the outcome and the regression against
+the baseline binary.
+"""
+import argparse
+import json
+import logging
+import math
+import os
+import re
+import shutil
+import subprocess
+import sys
+import tempfile
+import time
+
+BENCH_EXTENSIONS = (".smt2", ".smt", ".cnf", ".dimacs")
+STAT_RE = re.compile(r":([A-Za-z0-9._-]+)\s+([0-9]+(?:\.[0-9]+)?)")
+RESULTS = ("sat", "unsat", "unknown", "timeout")
+
+
+def collect_benchmarks(paths):
+    result = []
+    for path in paths:
+        if os.path.isdir(path):
+            for root, dirs, files in os.walk(path):
+                dirs.sort()
+                for f in sorted(files):
+                    if f.endswith(BENCH_EXTENSIONS):
+                        result.append(os.path.join(root, f))
+        elif os.path.isfile(path):
+            result.append(path)
+        else:
+            logging.error('"{}" does not exist'.format(path))
+    return result
+
+
+def run_z3(z3, bench, seed, timeout):
+    args = [z3, "-st", "-T:{}".format(timeout),
+            "smt.random_seed={}".format(seed),
+            "sat.random_seed={}".format(seed)]
+    if bench.endswith((".cnf", ".dimacs")):
+        args.append("-dimacs")
+    args.append(bench)
+    start = time.perf_counter()
+    proc = subprocess.run(args, stdout=subprocess.PIPE, stderr=subprocess.STDOUT,
+                          universal_newlines=True)
+    wall = time.perf_counter() - start
+    outcome = "unknown"
+    for line in proc.stdout.splitlines():
+        line = line.strip()
+        if line in RESULTS or line == "s SATISFIABLE" or line == "s UNSATISFIABLE":
+            outcome = {"s SATISFIABLE": "sat", "s UNSATISFIABLE": "unsat"}.get(line, line)
+            break
+    stats = {}
+    for key, value in STAT_RE.findall(proc.stdout):
+        stats[key] = stats.get(key, 0) + float(value)
+    conflicts = sum(v for k, v in stats.items() if k.endswith("conflicts"))
+    return {
+        "outcome": outcome,
+        "time": wall,
+        "memory": stats.get("max-memory", 0.0),
+        "conflicts": conflicts,
+        "rlimit": stats.get("rlimit-count", 0.0),
+    }
+
+
+def run_corpus(z3, benchmarks, seeds, timeout):
+    results = {}
+    for bench in benchmarks:
+        runs = [run_z3(z3, bench, seed, timeout) for seed in seeds]
+        results[bench] = {
+            "outcome": [r["outcome"] for r in runs],
+            "time": [r["time"] for r in runs],
+            "memory": [r["memory"] for r in runs],
+            "conflicts": [r["conflicts"] for r in runs],
+            "rlimit": [r["rlimit"] for r in runs],
+        }
+        logging.info("{} {} time {:.3f}".format(bench, runs[0]["outcome"], median(results[bench]["time"])))
+    return results
+
+
+def median(xs):
+    ys = sorted(xs)
+    n = len(ys)
+    if n == 0:
+        return 0.0
+    if n % 2 == 1:
+        return ys[n // 2]
+    return (ys[n // 2 - 1] + ys[n // 2]) / 2.0
+
+
+def mann_whitney_p(xs, ys):
+    """
+    Two-sided p-value of the Mann-Whitney U test with the normal
+    approximation and tie correction.
+    """
+    n1, n2 = len(xs), len(ys)
+    if n1 == 0 or n2 == 0:
+        return 1.0
+    values = sorted([(x, 0) for x in xs] + [(y, 1) for y in ys])
+    ranks = [0.0] * len(values)
+    ties = 0.0
+    i = 0
+    while i < len(values):
+        j = i
+        while j + 1 < len(values) and values[j + 1][0] == values[i][0]:
+            j += 1
+        for k in range(i, j + 1):
+            ranks[k] = (i + j) / 2.0 + 1.0
+        t = j - i + 1
+        ties += t * t * t - t
+        i = j + 1
+    r1 = sum(r for r, (_, g) in zip(ranks, values) if g == 0)
+    u = r1 - n1 * (n1 + 1) / 2.0
+    n = n1 + n2
+    var = n1 * n2 / 12.0 * ((n + 1) - ties / (n * (n - 1)))
+    if var <= 0:
+        return 1.0
+    z = (abs(u - n1 * n2 / 2.0) - 0.5) / math.sqrt(var)
+    return math.erfc(max(z, 0.0) / math.sqrt(2.0))
+
+
+def compare(results, baseline, alpha, threshold):
+    regressions = []
+    for bench, cur in sorted(results.items()):
+        if bench not in baseline:
+            continue
+        base = baseline[bench]
+        if set(cur["outcome"]) != set(base["outcome"]):
+            regressions.append((bench, "outcome", sorted(set(base["outcome"])), sorted(set(cur["outcome"]))))
+        t0, t1 = median(base["time"]), median(cur["time"])
+        p = mann_whitney_p(base["time"], cur["time"])
+        if t1 > threshold * t0 and p < alpha:
+            regressions.append((bench, "time", t0, t1, p))
+        for key in ("conflicts", "rlimit", "memory"):
+            v0, v1 = median(base[key]), median(cur[key])
+            if v1 > threshold * v0 and v1 > v0 + 1:
+                regressions.append((bench, key, v0, v1))
+    return regressions
+
+
+def reduce_benchmark(test_z3, z3, baseline_z3, bench, seed, timeout, threshold, out_dir):
+    """
+    Greedy delta debugging: take the first delta of the current benchmark
+    that keeps the outcome and the resource count regression.
+    """
+    def regressed(f):
+        cur = run_z3(z3, f, seed, timeout)
+        base = run_z3(baseline_z3, f, seed, timeout)
+        return cur["outcome"] == base["outcome"] and cur["rlimit"] > threshold * base["rlimit"]
+
+    if not regressed(bench):
+        return None
+    tmp_dir = tempfile.mkdtemp()
+    cur = os.path.join(tmp_dir, "cur.smt2")
+    shutil.copyfile(bench, cur)
+    n = 0
+    while True:
+        cand = os.path.join(tmp_dir, "cand.smt2")
+        if os.path.exists(cand):
+            os.remove(cand)
+        subprocess.run([test_z3, "smt2_delta", cur, str(n), cand],
+                       stdout=subprocess.DEVNULL, stderr=subprocess.DEVNULL)
+        if not os.path.exists(cand):
+            break
+        if regressed(cand):
+            shutil.copyfile(cand, cur)
+            n = 0
+        else:
+            n += 1
+    out = os.path.join(out_dir, os.path.basename(bench))
+    shutil.copyfile(cur, out)
+    shutil.rmtree(tmp_dir)
+    return out
+
+
+def main(args):
+    logging.basicConfig(level=logging.INFO)
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument("corpus", nargs="+", help="benchmark files or directories")
+    parser.add_argument("--z3", required=True, help="z3 binary")
+    parser.add_argument("--test-z3", dest="test_z3", default=None, help="test-z3 binary, used for reduction")
+    parser.add_argument("--seeds", default="0,1,2", help="comma separated random seeds")
+    parser.add_argument("--timeout", type=int, default=60, help="timeout per run in seconds")
+    parser.add_argument("--output", default=None, help="write the results to this file")
+    parser.add_argument("--baseline", default=None, help="compare against the results in this file")
+    parser.add_argument("--alpha", type=float, default=0.05, help="significance level of the time comparison")
+    parser.add_argument("--threshold", type=float, default=1.1, help="relative change that counts as a regression")
+    parser.add_argument("--baseline-z3", dest="baseline_z3", default=None, help="z3 binary of the baseline, used for reduction")
+    parser.add_argument("--reduce-dir", dest="reduce_dir", default=None, help="write reduced regressions to this directory")
+    pargs = parser.parse_args(args)
+
+    seeds = [int(s) for s in pargs.seeds.split(",") if s]
+    benchmarks = collect_benchmarks(pargs.corpus)
+    if not benchmarks:
+        logging.error("no benchmarks found")
+        return 1
+    results = run_corpus(pargs.z3, benchmarks, seeds, pargs.timeout)
+    if pargs.output:
+        with open(pargs.output, "w") as f:
+            json.dump(results, f, indent=1, sort_keys=True)
+        logging.info('Wrote "{}"'.format(pargs.output))
+    if not pargs.baseline:
+        return 0
+    if not os.path.exists(pargs.baseline):
+        logging.warning('Baseline "{}" does not exist'.format(pargs.baseline))
+        return 0
+    with open(pargs.baseline) as f:
+        baseline = json.load(f)
+    regressions = compare(results, baseline, pargs.alpha, pargs.threshold)
+    for r in regressions:
+        logging.warning("regression: " + " ".join(str(x) for x in r))
+    if pargs.reduce_dir and pargs.test_z3 and pargs.baseline_z3:
+        os.makedirs(pargs.reduce_dir, exist_ok=True)
+        benches = sorted(set(r[0] for r in regressions if r[1] == "rlimit" and r[0].endswith(".smt2")))
+        for bench in benches:
+            out = reduce_benchmark(pargs.test_z3, pargs.z3, pargs.baseline_z3, bench, seeds[0],
+                                   pargs.timeout, pargs.threshold, pargs.reduce_dir)
+            if out:
+                logging.info('Reduced "{}" to "{}"'.format(bench, out))
+    return 1 if regressions else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main(sys.argv[1:]))
@@ -70,7 +70,7 @@ public:
             for_each_expr_core<proc, expr_fast_mark1, true, true>(p, visited, g.form(i));
         }
         p.prune_non_select();
-        double total = ackr_helper::calculate_lemma_bound(p.m_fun2terms, p.m_sel2terms);
+        double total = ackr_helper::calculate_lemma_bound(g.m(), p.m_fun2terms, p.m_sel2terms);
         TRACE("ackermannize", tout << "total=" << total << std::endl;);
         return result(total);
     }
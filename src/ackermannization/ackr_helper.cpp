@@ -16,15 +16,76 @@
 --*/
 #include "ackermannization/ackr_helper.h"
 
-double ackr_helper::calculate_lemma_bound(fun2terms_map const& occs1, sel2terms_map const& occs2) {
+static double lemma_bound(ast_manager& m, ackr_helper::app_set const& ts) {
+    ackr_helper::app_partition p;
+    ackr_helper::partition(m, ts, p);
+    double w = p.wild.size();
+    double total = ackr_helper::n_choose_2_chk(p.wild.size());
+    for (unsigned k = 0; k < p.var_args.size(); ++k) {
+        double v = p.var_args[k].size();
+        double c = p.const_args[k].size();
+        total += ackr_helper::n_choose_2_chk(p.var_args[k].size()) + v * c + w * (v + c);
+    }
+    return total;
+}
+
+double ackr_helper::calculate_lemma_bound(ast_manager& m, fun2terms_map const& occs1, sel2terms_map const& occs2) {
     double total = 0;
-    for (auto const& kv : occs1) {
-        total += n_choose_2_chk(kv.m_value->var_args.size());
-        total += kv.m_value->const_args.size() * kv.m_value->var_args.size();
+    for (auto const& kv : occs1)
+        total += lemma_bound(m, *kv.m_value);
+    for (auto const& kv : occs2)
+        total += lemma_bound(m, *kv.m_value);
+    return total;
+}
+
+void ackr_helper::partition(ast_manager& m, app_set const& ts, app_partition& p) {
+    p.wild.reset();
+    p.var_args.reset();
+    p.const_args.reset();
+    if (ts.var_args.empty())
+        return;
+    unsigned num_args = (*ts.var_args.begin())->get_num_args();
+    unsigned best = UINT_MAX, best_count = 0;
+    for (unsigned i = 0; i < num_args; ++i) {
+        bool ok = true;
+        for (app* t : ts.const_args)
+            ok &= m.is_unique_value(t->get_arg(i));
+        if (!ok)
+            continue;
+        unsigned count = 0;
+        for (app* t : ts.var_args)
+            if (m.is_unique_value(t->get_arg(i)))
+                ++count;
+        if (count > best_count)
+            best = i, best_count = count;
     }
-    for (auto const& kv : occs2) {
-        total += n_choose_2_chk(kv.m_value->var_args.size());
-        total += kv.m_value->const_args.size() * kv.m_value->var_args.size();
+    if (best == UINT_MAX) {
+        for (app* t : ts.var_args)
+            p.wild.push_back(t);
+        p.var_args.push_back(ptr_vector<app>());
+        p.const_args.push_back(ptr_vector<app>());
+        for (app* t : ts.const_args)
+            p.const_args.back().push_back(t);
+        return;
     }
-    return total;
+    obj_map<expr, unsigned> value2group;
+    auto group_of = [&](expr* v) {
+        unsigned k = 0;
+        if (!value2group.find(v, k)) {
+            k = p.var_args.size();
+            value2group.insert(v, k);
+            p.var_args.push_back(ptr_vector<app>());
+            p.const_args.push_back(ptr_vector<app>());
+        }
+        return k;
+    };
+    for (app* t : ts.var_args) {
+        expr* v = t->get_arg(best);
+        if (m.is_unique_value(v))
+            p.var_args[group_of(v)].push_back(t);
+        else
+            p.wild.push_back(t);
+    }
+    for (app* t : ts.const_args)
+        p.const_args[group_of(t->get_arg(best))].push_back(t);
 }
@@ -28,6 +28,17 @@ public:
     typedef app_occ  app_set;
     typedef obj_map<func_decl, app_set*> fun2terms_map;
     typedef obj_map<app, app_set*>       sel2terms_map;
+
+    /**
+       \brief Terms of an app_set grouped by the value of their argument at a key position.
+       Terms in different groups are never congruent. Variable terms that do not
+       have a value at the key position are wild and may be congruent to any term.
+    */
+    struct app_partition {
+        ptr_vector<app>         wild;
+        vector<ptr_vector<app>> var_args;
+        vector<ptr_vector<app>> const_args;
+    };
     
     ackr_helper(ast_manager& m) : m_bvutil(m), m_autil(m) {}
     
@@ -100,7 +111,12 @@ public:
     /**
        \brief Calculates an upper bound for congruence lemmas given a map of function of occurrences.
     */
-    static double calculate_lemma_bound(fun2terms_map const& occs1, sel2terms_map const& occs2);
+    static double calculate_lemma_bound(ast_manager& m, fun2terms_map const& occs1, sel2terms_map const& occs2);
+
+    /**
+       \brief Partition the terms of ts by the argument position where most variable terms have a unique value.
+    */
+    static void partition(ast_manager& m, app_set const& ts, app_partition& p);
     
     /** \brief Calculate n choose 2. **/
     inline static unsigned n_choose_2(unsigned n) { return (n & 1) ? (n * (n >> 1)) : (n >> 1) * (n - 1); }
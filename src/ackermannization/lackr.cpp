@@ -73,7 +73,7 @@ bool lackr::mk_ackermann(/*out*/goal_ref& g, double lemmas_upper_bound) {
     if (!init())
         return false;
     if (lemmas_upper_bound != std::numeric_limits<double>::infinity() &&
-        ackr_helper::calculate_lemma_bound(m_fun2terms, m_sel2terms) > lemmas_upper_bound) {
+        ackr_helper::calculate_lemma_bound(m, m_fun2terms, m_sel2terms) > lemmas_upper_bound) {
         return false;
     }
     eager_enc();
@@ -154,19 +154,31 @@ void lackr::eager_enc() {
 }
 
 void lackr::ackr(app_set const* ts) {
-    auto r = ts->var_args.end();
-    for (auto j = ts->var_args.begin(); j != r; ++j) {
-        app * const t1 = *j;
-        auto k = j;
-        ++k;
-        for (; k != r; ++k) {
-            app * const t2 = *k;
-            if (t1 != t2) {
+    ackr_helper::app_partition p;
+    ackr_helper::partition(m, *ts, p);
+    // wild terms are paired with every other term
+    for (unsigned i = 0; i < p.wild.size(); ++i) {
+        checkpoint();
+        app * const t1 = p.wild[i];
+        for (unsigned j = i + 1; j < p.wild.size(); ++j)
+            ackr(t1, p.wild[j]);
+        for (auto const& vs : p.var_args)
+            for (app* t2 : vs)
+                ackr(t1, t2);
+        for (auto const& cs : p.const_args)
+            for (app* t2 : cs)
+                ackr(t1, t2);
+    }
+    // the remaining terms are only congruent within their group
+    for (unsigned k = 0; k < p.var_args.size(); ++k) {
+        checkpoint();
+        ptr_vector<app> const& vs = p.var_args[k];
+        for (unsigned i = 0; i < vs.size(); ++i) {
+            app * const t1 = vs[i];
+            for (unsigned j = i + 1; j < vs.size(); ++j)
+                ackr(t1, vs[j]);
+            for (app* t2 : p.const_args[k])
                 ackr(t1, t2);
-            }
-        }
-        for (app* t2 : ts->const_args) {
-            ackr(t1, t2);
         }
     }
 }
@@ -45,6 +45,22 @@ Revision History:
 
 extern bool is_numeral_sort(Z3_context c, Z3_sort ty);
 
+struct Z3_simplifier_ref : public api::object {
+    params_ref  m_params;
+    th_rewriter m_rw;
+    unsigned    m_cache_size;
+    Z3_simplifier_ref(api::context& c, params_ref const& p):
+        api::object(c),
+        m_params(p),
+        m_rw(c.m(), p),
+        m_cache_size(p.get_uint("cache_size", 1000000)) {
+        m_rw.set_solver(alloc(api::seq_expr_solver, c.m(), p));
+    }
+};
+
+inline Z3_simplifier_ref * to_simplifier(Z3_simplifier s) { return reinterpret_cast<Z3_simplifier_ref *>(s); }
+inline Z3_simplifier of_simplifier(Z3_simplifier_ref * s) { return reinterpret_cast<Z3_simplifier>(s); }
+
 extern "C" {
 
     Z3_symbol Z3_API Z3_mk_int_symbol(Z3_context c, int i) {
@@ -184,6 +200,60 @@ extern "C" {
         Z3_CATCH_RETURN(nullptr);
     }
 
+    Z3_ast Z3_API Z3_mk_app_dag(Z3_context c,
+                                unsigned num_decls, Z3_func_decl const decls[],
+                                unsigned num_leaves, Z3_ast const leaves[],
+                                unsigned code_size, unsigned const code[],
+                                unsigned num_nodes, Z3_ast nodes[]) {
+        Z3_TRY;
+        LOG_Z3_mk_app_dag(c, num_decls, decls, num_leaves, leaves, code_size, code, num_nodes, nodes);
+        RESET_ERROR_CODE();
+        mk_c(c)->reset_last_result();
+        ast_manager& m = mk_c(c)->m();
+        ptr_buffer<expr> args;
+        unsigned pc = 0;
+        app* a = nullptr;
+        for (unsigned i = 0; i < num_nodes; ++i) {
+            if (pc + 2 > code_size || code[pc] >= num_decls || code[pc + 1] > code_size - pc - 2) {
+                SET_ERROR_CODE(Z3_INVALID_ARG, "malformed DAG code");
+                RETURN_Z3(nullptr);
+            }
+            func_decl* d = to_func_decl(decls[code[pc]]);
+            unsigned num_args = code[pc + 1];
+            pc += 2;
+            args.reset();
+            for (unsigned j = 0; j < num_args; ++j, ++pc) {
+                unsigned r = code[pc];
+                if (r < num_leaves) 
+                    args.push_back(to_expr(leaves[r]));
+                else if (r - num_leaves < i)
+                    args.push_back(to_expr(nodes[r - num_leaves]));
+                else {
+                    SET_ERROR_CODE(Z3_INVALID_ARG, "DAG node refers to a later node");
+                    RETURN_Z3(nullptr);
+                }
+            }
+            func_decl_info* info = d->get_info();
+            if (info)
+                a = m.mk_app(info->get_family_id(), info->get_decl_kind(), info->get_num_parameters(), info->get_parameters(), num_args, args.data());
+            else
+                a = m.mk_app(d, num_args, args.data());
+            if (!a) {
+                SET_ERROR_CODE(Z3_SORT_ERROR, nullptr);
+                RETURN_Z3(nullptr);
+            }
+            mk_c(c)->save_multiple_ast_trail(a);
+            check_sorts(c, a);
+            nodes[i] = of_ast(a);
+        }
+        if (pc != code_size) {
+            SET_ERROR_CODE(Z3_INVALID_ARG, "malformed DAG code");
+            RETURN_Z3(nullptr);
+        }
+        RETURN_Z3_mk_app_dag(of_ast(a));
+        Z3_CATCH_RETURN(nullptr);
+    }
+
     Z3_ast Z3_API Z3_mk_const(Z3_context c, Z3_symbol s, Z3_sort ty) {
         Z3_TRY;
         LOG_Z3_mk_const(c, s, ty);
@@ -806,6 +876,72 @@ extern "C" {
         Z3_CATCH_RETURN(nullptr);
     }
 
+    Z3_simplifier Z3_API Z3_mk_simplifier(Z3_context c, Z3_params p) {
+        Z3_TRY;
+        LOG_Z3_mk_simplifier(c, p);
+        RESET_ERROR_CODE();
+        Z3_simplifier_ref * s = alloc(Z3_simplifier_ref, *mk_c(c), to_param_ref(p));
+        mk_c(c)->save_object(s);
+        RETURN_Z3(of_simplifier(s));
+        Z3_CATCH_RETURN(nullptr);
+    }
+
+    void Z3_API Z3_simplifier_inc_ref(Z3_context c, Z3_simplifier s) {
+        Z3_TRY;
+        LOG_Z3_simplifier_inc_ref(c, s);
+        RESET_ERROR_CODE();
+        to_simplifier(s)->inc_ref();
+        Z3_CATCH;
+    }
+
+    void Z3_API Z3_simplifier_dec_ref(Z3_context c, Z3_simplifier s) {
+        Z3_TRY;
+        LOG_Z3_simplifier_dec_ref(c, s);
+        if (s)
+            to_simplifier(s)->dec_ref();
+        Z3_CATCH;
+    }
+
+    Z3_ast Z3_API Z3_simplifier_apply(Z3_context c, Z3_simplifier s, Z3_ast _a) {
+        Z3_TRY;
+        LOG_Z3_simplifier_apply(c, s, _a);
+        RESET_ERROR_CODE();
+        CHECK_IS_EXPR(_a, nullptr);
+        ast_manager & m = mk_c(c)->m();
+        Z3_simplifier_ref * sr = to_simplifier(s);
+        params_ref const& p = sr->m_params;
+        unsigned timeout     = p.get_uint("timeout", mk_c(c)->get_timeout());
+        bool     use_ctrl_c  = p.get_bool("ctrl_c", false);
+        expr_ref result(m);
+        cancel_eh<reslimit> eh(m.limit());
+        api::context::set_interruptable si(*(mk_c(c)), eh);
+        {
+            scoped_ctrl_c ctrlc(eh, false, use_ctrl_c);
+            scoped_timer timer(timeout, &eh);
+            try {
+                sr->m_rw(to_expr(_a), result);
+            }
+            catch (z3_exception & ex) {
+                sr->m_rw.reset();
+                mk_c(c)->handle_exception(ex);
+                RETURN_Z3(nullptr);
+            }
+        }
+        if (sr->m_rw.get_cache_size() > sr->m_cache_size)
+            sr->m_rw.reset();
+        mk_c(c)->save_ast_trail(result);
+        RETURN_Z3(of_ast(result.get()));
+        Z3_CATCH_RETURN(nullptr);
+    }
+
+    void Z3_API Z3_simplifier_reset(Z3_context c, Z3_simplifier s) {
+        Z3_TRY;
+        LOG_Z3_simplifier_reset(c, s);
+        RESET_ERROR_CODE();
+        to_simplifier(s)->m_rw.reset();
+        Z3_CATCH;
+    }
+
     Z3_ast Z3_API Z3_update_term(Z3_context c, Z3_ast _a, unsigned num_args, Z3_ast const _args[]) {
         Z3_TRY;
         LOG_Z3_update_term(c, _a, num_args, _args);
@@ -1346,6 +1482,7 @@ extern "C" {
             RETURN_Z3(nullptr);
         }
         SASSERT(mk_c(c)->m().contains(to_ast(a)));
+        lock_guard lock(mk_c(c)->translate_mux());
         ast_translation translator(mk_c(c)->m(), mk_c(target)->m());
         ast * _result = translator(to_ast(a));
         mk_c(target)->save_ast_trail(_result);
@@ -110,6 +110,7 @@ extern "C" {
         if (c == t) {
             RETURN_Z3(v);
         }
+        lock_guard lock(mk_c(c)->translate_mux());
         ast_translation translator(mk_c(c)->m(), mk_c(t)->m()); 
         Z3_ast_vector_ref * new_v = alloc(Z3_ast_vector_ref, *mk_c(t), mk_c(t)->m());
         mk_c(t)->save_object(new_v);
@@ -79,6 +79,7 @@ namespace api {
         scoped_ptr<cmd_context>    m_cmd;
         add_plugins                m_plugins;
         mutex                      m_mux;
+        mutex                      m_translate_mux; // serializes translations from this context
 
         arith_util                 m_arith_util;
         bv_util                    m_bv_util;
@@ -136,6 +137,13 @@ namespace api {
         ~context();
         ast_manager & m() const { return *(m_manager.get()); }
 
+        /**
+           \brief Translations from a context update the reference counts of its terms.
+           They take this lock so that several threads can translate from the same
+           source context into their own contexts.
+        */
+        mutex & translate_mux() { return m_translate_mux; }
+
         ast_context_params & params() { m_params.updt_params(); return m_params; }
         scoped_ptr<cmd_context>& cmd() { return m_cmd; }
         bool produce_proofs() const { return m().proofs_enabled(); }
@@ -171,6 +171,7 @@ extern "C" {
         Z3_TRY;
         LOG_Z3_goal_translate(c, g, target);
         RESET_ERROR_CODE();
+        lock_guard lock(mk_c(c)->translate_mux());
         ast_translation translator(mk_c(c)->m(), mk_c(target)->m());
         Z3_goal_ref * _r = alloc(Z3_goal_ref, *mk_c(target));
         _r->m_goal       = to_goal_ref(g)->translate(translator);
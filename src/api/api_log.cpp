@@ -16,6 +16,7 @@ Revision History:
 
 --*/
 #include<fstream>
+#include<chrono>
 #include "api/z3.h"
 #include "api/api_log_macros.h"
 #include "api/z3_logger.h"
@@ -23,9 +24,50 @@ Revision History:
 #include "util/z3_version.h"
 #include "util/mutex.h"
 
-static std::ostream * g_z3_log = nullptr;
+/**
+   \brief Log file with a large buffer.
+
+   The log used to be flushed after every line, which made logging
+   dominated by system calls. The buffer is now flushed at the end of
+   an API call only when FLUSH_INTERVAL_MS passed since the last flush,
+   so a crash loses at most the calls of the last interval.
+*/
+class log_file : public std::ofstream {
+    static const size_t   BUFFER_SIZE = 1 << 20;
+    static const unsigned FLUSH_INTERVAL_MS = 100;
+    typedef std::chrono::steady_clock clock;
+    char              m_buffer[BUFFER_SIZE];
+    clock::time_point m_last_flush;
+public:
+    log_file(char const * filename): m_last_flush(clock::now()) {
+        // the buffer must be installed before the file is opened
+        rdbuf()->pubsetbuf(m_buffer, BUFFER_SIZE);
+        open(filename);
+    }
+
+    void flush_if_due() {
+        clock::time_point now = clock::now();
+        if (now - m_last_flush >= std::chrono::milliseconds(FLUSH_INTERVAL_MS)) {
+            flush();
+            m_last_flush = now;
+        }
+    }
+};
+
+static log_file * g_z3_log = nullptr;
 atomic<bool> g_z3_log_enabled;
 
+namespace {
+    // flush a log that is still open when the process exits.
+    struct log_exit_flush {
+        ~log_exit_flush() {
+            if (g_z3_log != nullptr)
+                g_z3_log->flush();
+        }
+    };
+    log_exit_flush g_log_exit_flush;
+}
+
 #ifdef Z3_LOG_SYNC
 static mutex g_log_mux;
 #define SCOPED_LOCK() lock_guard lock(g_log_mux)
@@ -73,12 +115,12 @@ std::ostream & operator<<(std::ostream & out, ll_escaped const & d) {
 }
 }
 
-void R()              { *g_z3_log << 'R' << std::endl; }
-void P(void * obj)    { *g_z3_log << "P " << obj <<std::endl; }
-void I(int64_t i)     { *g_z3_log << "I " << i << std::endl; }
-void U(uint64_t u)    { *g_z3_log << "U " << u << std::endl; }
-void D(double d)      { *g_z3_log << "D " << d << std::endl; }
-void S(Z3_string str) { *g_z3_log << "S \"" << ll_escaped{str} << '"' << std::endl; }
+void R()              { *g_z3_log << "R\n"; }
+void P(void * obj)    { *g_z3_log << "P " << obj << '\n'; }
+void I(int64_t i)     { *g_z3_log << "I " << i << '\n'; }
+void U(uint64_t u)    { *g_z3_log << "U " << u << '\n'; }
+void D(double d)      { *g_z3_log << "D " << d << '\n'; }
+void S(Z3_string str) { *g_z3_log << "S \"" << ll_escaped{str} << "\"\n"; }
 void Sy(Z3_symbol sym) {
     symbol s = symbol::c_api_ext2symbol(sym);
     if (s.is_null()) {
@@ -90,14 +132,17 @@ void Sy(Z3_symbol sym) {
     else {
         *g_z3_log << "$ |" << ll_escaped{s.bare_str()} << '|';
     }
-    *g_z3_log << std::endl;
+    *g_z3_log << '\n';
+}
+void Ap(unsigned sz)  { *g_z3_log << "p " << sz << '\n'; }
+void Au(unsigned sz)  { *g_z3_log << "u " << sz << '\n'; }
+void Ai(unsigned sz)  { *g_z3_log << "i " << sz << '\n'; }
+void Asy(unsigned sz) { *g_z3_log << "s " << sz << '\n'; }
+void C(unsigned id)   {
+    *g_z3_log << "C " << id << '\n';
+    g_z3_log->flush_if_due();
 }
-void Ap(unsigned sz)  { *g_z3_log << "p " << sz << std::endl; }
-void Au(unsigned sz)  { *g_z3_log << "u " << sz << std::endl; }
-void Ai(unsigned sz)  { *g_z3_log << "i " << sz << std::endl; }
-void Asy(unsigned sz) { *g_z3_log << "s " << sz << std::endl; }
-void C(unsigned id)   { *g_z3_log << "C " << id << std::endl; }
-static void _Z3_append_log(char const * msg) { *g_z3_log << "M \"" << ll_escaped{msg} << '"' << std::endl; }
+static void _Z3_append_log(char const * msg) { *g_z3_log << "M \"" << ll_escaped{msg} << "\"\n"; }
 
 void ctx_enable_logging() {
     SCOPED_LOCK();
@@ -120,14 +165,14 @@ extern "C" {
         SCOPED_LOCK();
         Z3_close_log_unsafe();
 
-        g_z3_log = alloc(std::ofstream, filename);
+        g_z3_log = alloc(log_file, filename);
         if (g_z3_log->bad() || g_z3_log->fail()) {
             dealloc(g_z3_log);
             g_z3_log = nullptr;
             res = false;
         }
         else {
-            *g_z3_log << "V \"" << Z3_MAJOR_VERSION << "." << Z3_MINOR_VERSION << "." << Z3_BUILD_NUMBER << "." << Z3_REVISION_NUMBER << '"' << std::endl;
+            *g_z3_log << "V \"" << Z3_MAJOR_VERSION << "." << Z3_MINOR_VERSION << "." << Z3_BUILD_NUMBER << "." << Z3_REVISION_NUMBER << "\"\n";
             res = true;
         }
 
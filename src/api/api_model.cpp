@@ -74,6 +74,93 @@ extern "C" {
         Z3_CATCH_RETURN(nullptr);
     }
 
+    /**
+       \brief Return the numeral assigned to the constant f in the model, 0 if f has no interpretation.
+    */
+    static bool get_numeral_value(Z3_context c, model& mdl, func_decl* f, rational& val) {
+        if (f->get_arity() != 0) {
+            SET_ERROR_CODE(Z3_INVALID_ARG, "constant expected");
+            return false;
+        }
+        expr* e = mdl.get_const_interp(f);
+        if (!e) {
+            val.reset();
+            return true;
+        }
+        unsigned bv_size;
+        if (mk_c(c)->autil().is_numeral(e, val) && val.is_int())
+            return true;
+        if (mk_c(c)->bvutil().is_numeral(e, val, bv_size))
+            return true;
+        SET_ERROR_CODE(Z3_INVALID_ARG, "the value is not an integer or bit-vector numeral");
+        return false;
+    }
+
+    bool Z3_API Z3_model_get_bool_values(Z3_context c, Z3_model m, unsigned num_consts, Z3_func_decl const consts[], unsigned num_words, unsigned words[]) {
+        Z3_TRY;
+        LOG_Z3_model_get_bool_values(c, m, num_consts, consts, num_words, words);
+        RESET_ERROR_CODE();
+        CHECK_NON_NULL(m, false);
+        if (num_words < (num_consts + 31) / 32) {
+            SET_ERROR_CODE(Z3_INVALID_ARG, "the buffer is too small");
+            return false;
+        }
+        ast_manager& mgr = mk_c(c)->m();
+        model& mdl = *to_model_ref(m);
+        for (unsigned i = 0; i < (num_consts + 31) / 32; ++i)
+            words[i] = 0;
+        for (unsigned i = 0; i < num_consts; ++i) {
+            func_decl* f = to_func_decl(consts[i]);
+            if (f->get_arity() != 0 || !mgr.is_bool(f->get_range())) {
+                SET_ERROR_CODE(Z3_INVALID_ARG, "Boolean constant expected");
+                return false;
+            }
+            expr* e = mdl.get_const_interp(f);
+            if (!e || mgr.is_false(e))
+                continue;
+            if (!mgr.is_true(e)) {
+                SET_ERROR_CODE(Z3_INVALID_ARG, "the value is not a Boolean constant");
+                return false;
+            }
+            words[i / 32] |= (1u << (i % 32));
+        }
+        return true;
+        Z3_CATCH_RETURN(false);
+    }
+
+    bool Z3_API Z3_model_get_numeral_words(Z3_context c, Z3_model m, unsigned num_consts, Z3_func_decl const consts[], unsigned words_per_value, unsigned num_words, unsigned words[]) {
+        Z3_TRY;
+        LOG_Z3_model_get_numeral_words(c, m, num_consts, consts, words_per_value, num_words, words);
+        RESET_ERROR_CODE();
+        CHECK_NON_NULL(m, false);
+        if (words_per_value == 0 || num_words / words_per_value < num_consts) {
+            SET_ERROR_CODE(Z3_INVALID_ARG, "the buffer is too small");
+            return false;
+        }
+        model& mdl = *to_model_ref(m);
+        rational val;
+        rational limit = rational::power_of_two(32 * words_per_value);
+        rational two32 = rational::power_of_two(32);
+        for (unsigned i = 0; i < num_consts; ++i) {
+            if (!get_numeral_value(c, mdl, to_func_decl(consts[i]), val))
+                return false;
+            if (val.is_neg())
+                val += limit;
+            if (val.is_neg() || val >= limit) {
+                SET_ERROR_CODE(Z3_INVALID_ARG, "the value does not fit in the given number of words");
+                return false;
+            }
+            unsigned* w = words + static_cast<size_t>(i) * words_per_value;
+            for (unsigned j = 0; j < words_per_value; ++j) {
+                rational r = mod(val, two32);
+                w[j] = r.get_unsigned();
+                val = div(val - r, two32);
+            }
+        }
+        return true;
+        Z3_CATCH_RETURN(false);
+    }
+
     bool Z3_API Z3_model_has_interp(Z3_context c, Z3_model m, Z3_func_decl a) {
         Z3_TRY;
         LOG_Z3_model_has_interp(c, m, a);
@@ -216,6 +303,7 @@ extern "C" {
         Z3_TRY;
         LOG_Z3_model_translate(c, m, target);
         RESET_ERROR_CODE();
+        lock_guard lock(mk_c(c)->translate_mux());
         Z3_model_ref* dst = alloc(Z3_model_ref, *mk_c(target));
         ast_translation tr(mk_c(c)->m(), mk_c(target)->m());
         dst->m_model = to_model_ref(m)->translate(tr);
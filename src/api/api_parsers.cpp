@@ -160,12 +160,10 @@ extern "C" {
             mk_c(c)->cmd()->set_solver_factory(mk_smt_strategic_solver_factory());
         }
         scoped_ptr<cmd_context>& ctx = mk_c(c)->cmd();
-        std::string s(str);
-        std::istringstream is(s);
         ctx->set_regular_stream(ous);
         ctx->set_diagnostic_stream(ous);
         try {
-            if (!parse_smt2_commands(*ctx.get(), is)) {
+            if (!parse_smt2_commands(*ctx.get(), str, strlen(str))) {
                 SET_ERROR_CODE(Z3_PARSER_ERROR, ous.str());
                 RETURN_Z3(mk_c(c)->mk_external_string(ous.str()));
             }
@@ -23,6 +23,8 @@ Revision History:
 #include "util/scoped_timer.h"
 #include "util/file_path.h"
 #include "ast/ast_pp.h"
+#include "ast/ast_binary.h"
+#include "ast/ast_util.h"
 #include "api/z3.h"
 #include "api/api_log_macros.h"
 #include "api/api_context.h"
@@ -43,7 +45,50 @@ Revision History:
 #include "sat/sat_solver.h"
 #include "sat/tactic/goal2sat.h"
 #include "sat/tactic/sat2goal.h"
+#include "util/gparams.h"
+#include "util/thread_pool.h"
+#include <condition_variable>
+#include <deque>
+#include <thread>
+
+/**
+   \brief A check started by Z3_solver_check_async.
+*/
+struct solver_async_check {
+    Z3_context              m_ctx;
+    Z3_solver               m_solver;
+    expr_ref_vector         m_assumptions;
+    void*                   m_check_eh_ctx;
+    Z3_check_eh*            m_check_eh;
+    std::mutex              m_mux;
+    std::condition_variable m_cv;
+    bool                    m_done { false };
+    Z3_lbool                m_result { Z3_L_UNDEF };
+    // exception raised by the check, it is reported by Z3_solver_check_async_wait
+    bool                    m_failed { false };
+    unsigned                m_error_code { 0 };
+    std::string             m_error;
+
+    solver_async_check(Z3_context c, Z3_solver s, ast_manager& m):
+        m_ctx(c), m_solver(s), m_assumptions(m),
+        m_check_eh_ctx(to_solver(s)->m_check_eh_ctx), m_check_eh(to_solver(s)->m_check_eh) {}
+
+    void set_exception(z3_exception& ex) {
+        m_failed = true;
+        m_error_code = ex.has_error_code() ? ex.error_code() : 0;
+        m_error = ex.msg();
+    }
+
+    bool done() {
+        std::lock_guard<std::mutex> lock(m_mux);
+        return m_done;
+    }
 
+    void wait() {
+        std::unique_lock<std::mutex> lock(m_mux);
+        m_cv.wait(lock, [&] { return m_done; });
+    }
+};
 
 extern "C" {
 
@@ -122,11 +167,33 @@ extern "C" {
     void Z3_solver_ref::set_eh(event_handler* eh) {
         lock_guard lock(m_mux);
         m_eh = eh;
+        if (eh && m_async_pending) {
+            m_async_pending = false;
+            if (m_async_cancel) 
+                (*eh)(API_INTERRUPT_EH_CALLER);
+            m_async_cancel = false;
+        }
     }
 
     void Z3_solver_ref::set_cancel() {
         lock_guard lock(m_mux);
         if (m_eh) (*m_eh)(API_INTERRUPT_EH_CALLER);
+        else if (m_async_pending) m_async_cancel = true;
+    }
+
+    static solver_async_check* wait_async_check(Z3_solver_ref* s) {
+        solver_async_check* a = s->m_async;
+        a->wait();
+        lock_guard lock(s->m_mux);
+        s->m_async = nullptr;
+        return a;
+    }
+
+    Z3_solver_ref::~Z3_solver_ref() {
+        if (m_async) {
+            set_cancel();
+            dealloc(wait_async_check(this));
+        }
     }
 
     void Z3_solver_ref::assert_expr(expr * e) {
@@ -228,6 +295,7 @@ extern "C" {
         RESET_ERROR_CODE();
         params_ref const& p = to_solver(s)->m_params; 
         Z3_solver_ref * sr = alloc(Z3_solver_ref, *mk_c(target), nullptr);
+        lock_guard lock(mk_c(c)->translate_mux());
         init_solver(c, s);
         sr->m_solver = to_solver(s)->m_solver->translate(mk_c(target)->m(), p);
         mk_c(target)->save_object(sr);
@@ -326,6 +394,39 @@ extern "C" {
         Z3_CATCH;
     }
 
+    void Z3_API Z3_solver_to_binary(Z3_context c, Z3_solver s, Z3_string file_name) {
+        Z3_TRY;
+        LOG_Z3_solver_to_binary(c, s, file_name);
+        RESET_ERROR_CODE();
+        init_solver(c, s);
+        std::ofstream os(file_name, std::ios::binary);
+        if (!os) {
+            SET_ERROR_CODE(Z3_FILE_ACCESS_ERROR, nullptr);
+            return;
+        }
+        expr_ref_vector fmls(mk_c(c)->m());
+        to_solver_ref(s)->get_assertions(fmls);
+        ast_to_binary(mk_c(c)->m(), fmls, os);
+        Z3_CATCH;
+    }
+
+    void Z3_API Z3_solver_from_binary(Z3_context c, Z3_solver s, Z3_string file_name) {
+        Z3_TRY;
+        LOG_Z3_solver_from_binary(c, s, file_name);
+        RESET_ERROR_CODE();
+        std::ifstream is(file_name, std::ios::binary);
+        init_solver(c, s);
+        if (!is) {
+            SET_ERROR_CODE(Z3_FILE_ACCESS_ERROR, nullptr);
+            return;
+        }
+        expr_ref_vector fmls(mk_c(c)->m());
+        ast_from_binary(mk_c(c)->m(), is, fmls);
+        for (expr* e : fmls)
+            to_solver(s)->assert_expr(e);
+        Z3_CATCH;
+    }
+
     Z3_string Z3_API Z3_solver_get_help(Z3_context c, Z3_solver s) {
         Z3_TRY;
         LOG_Z3_solver_get_help(c, s);
@@ -477,6 +578,40 @@ extern "C" {
         Z3_CATCH;
     }
 
+    void Z3_API Z3_solver_assert_clauses(Z3_context c, Z3_solver s, unsigned num_atoms, Z3_ast const atoms[], unsigned num_lits, int const lits[]) {
+        Z3_TRY;
+        LOG_Z3_solver_assert_clauses(c, s, num_atoms, atoms, num_lits, lits);
+        RESET_ERROR_CODE();
+        init_solver(c, s);
+        ast_manager& m = mk_c(c)->m();
+        for (unsigned i = 0; i < num_atoms; ++i) {
+            CHECK_FORMULA(atoms[i],);
+        }
+        if (num_lits > 0 && lits[num_lits - 1] != 0) {
+            SET_ERROR_CODE(Z3_INVALID_ARG, "last clause is not terminated by 0");
+            return;
+        }
+        expr_ref_vector clause(m), fmls(m);
+        for (unsigned i = 0; i < num_lits; ++i) {
+            int lit = lits[i];
+            if (lit == 0) {
+                fmls.push_back(::mk_or(clause));
+                clause.reset();
+                continue;
+            }
+            unsigned idx = lit < 0 ? -static_cast<unsigned>(lit) : static_cast<unsigned>(lit);
+            if (idx > num_atoms) {
+                SET_ERROR_CODE(Z3_INVALID_ARG, "literal does not refer to an atom");
+                return;
+            }
+            expr* a = to_expr(atoms[idx - 1]);
+            clause.push_back(lit < 0 ? m.mk_not(a) : a);
+        }
+        for (expr* f : fmls)
+            to_solver(s)->assert_expr(f);
+        Z3_CATCH;
+    }
+
     
     Z3_ast_vector Z3_API Z3_solver_get_assertions(Z3_context c, Z3_solver s) {
         Z3_TRY;
@@ -562,7 +697,7 @@ extern "C" {
         Z3_CATCH_RETURN(nullptr);
     }
 
-    static Z3_lbool _solver_check(Z3_context c, Z3_solver s, unsigned num_assumptions, Z3_ast const assumptions[]) {
+    static Z3_lbool _solver_check(Z3_context c, Z3_solver s, unsigned num_assumptions, Z3_ast const assumptions[], solver_async_check* async = nullptr) {
         for (unsigned i = 0; i < num_assumptions; i++) {
             if (!is_expr(to_ast(assumptions[i]))) {
                 SET_ERROR_CODE(Z3_INVALID_ARG, "assumption is not an expression");
@@ -575,7 +710,7 @@ extern "C" {
         timeout              = to_solver(s)->m_params.get_uint("timeout", timeout);
         timeout              = sp.timeout() != UINT_MAX ? sp.timeout() : timeout;
         unsigned rlimit      = to_solver(s)->m_params.get_uint("rlimit", mk_c(c)->get_rlimit());
-        bool     use_ctrl_c  = to_solver(s)->m_params.get_bool("ctrl_c", true);
+        bool     use_ctrl_c  = !async && to_solver(s)->m_params.get_bool("ctrl_c", true);
         cancel_eh<reslimit> eh(mk_c(c)->m().limit());
         to_solver(s)->set_eh(&eh);
         api::context::set_interruptable si(*(mk_c(c)), eh);
@@ -592,7 +727,10 @@ extern "C" {
                 to_solver_ref(s)->set_reason_unknown(eh);
                 to_solver(s)->set_eh(nullptr);
                 if (mk_c(c)->m().inc()) {
-                    mk_c(c)->handle_exception(ex);
+                    if (async)
+                        async->set_exception(ex);
+                    else
+                        mk_c(c)->handle_exception(ex);
                 }
                 return Z3_L_UNDEF;
             }
@@ -627,6 +765,177 @@ extern "C" {
         Z3_CATCH_RETURN(Z3_L_UNDEF);
     }
     
+    static void run_async_check(solver_async_check* a) {
+        Z3_lbool r = Z3_L_UNDEF;
+        try {
+            r = _solver_check(a->m_ctx, a->m_solver, a->m_assumptions.size(), reinterpret_cast<Z3_ast const*>(a->m_assumptions.data()), a);
+        }
+        catch (z3_exception & ex) {
+            a->set_exception(ex);
+        }
+        Z3_check_eh* check_eh = a->m_check_eh;
+        void* check_eh_ctx = a->m_check_eh_ctx;
+        {
+            // a may be deleted as soon as m_done is observed.
+            std::lock_guard<std::mutex> lock(a->m_mux);
+            a->m_result = r;
+            a->m_done = true;
+            a->m_cv.notify_all();
+        }
+        if (check_eh)
+            check_eh(check_eh_ctx, r);
+    }
+
+#ifndef SINGLE_THREAD
+    /**
+       \brief Run the asynchronous checks on at most async_threads workers,
+       such that checks of the same context run one after the other.
+    */
+    class async_check_scheduler {
+        std::mutex                      m_mux;
+        std::deque<solver_async_check*> m_queue;
+        ptr_vector<api::context>        m_busy;     // contexts with a running check
+        unsigned                        m_running { 0 };
+        thread_pool                     m_pool;
+
+        unsigned max_running() const {
+            unsigned n = gparams::get_ref().get_uint("async_threads", 0);
+            if (n == 0)
+                n = std::thread::hardware_concurrency();
+            return n == 0 ? 1 : n;
+        }
+
+        // called with m_mux held.
+        solver_async_check* next() {
+            for (auto it = m_queue.begin(); it != m_queue.end(); ++it) {
+                api::context* c = mk_c((*it)->m_ctx);
+                if (!m_busy.contains(c)) {
+                    solver_async_check* a = *it;
+                    m_queue.erase(it);
+                    m_busy.push_back(c);
+                    return a;
+                }
+            }
+            return nullptr;
+        }
+
+        void drain() {
+            api::context* done = nullptr;
+            while (true) {
+                solver_async_check* a;
+                {
+                    std::lock_guard<std::mutex> lock(m_mux);
+                    if (done)
+                        m_busy.erase(done);
+                    a = next();
+                    if (!a) {
+                        --m_running;
+                        return;
+                    }
+                }
+                done = mk_c(a->m_ctx);
+                run_async_check(a);
+            }
+        }
+
+    public:
+        void submit(solver_async_check* a) {
+            {
+                std::lock_guard<std::mutex> lock(m_mux);
+                m_queue.push_back(a);
+                if (m_running >= max_running())
+                    return;
+                ++m_running;
+            }
+            m_pool.run([this]() { drain(); });
+        }
+    };
+
+    static async_check_scheduler& get_async_check_scheduler() {
+        // leaked on purpose: checks may complete during static destruction.
+        static async_check_scheduler* s = new async_check_scheduler();
+        return *s;
+    }
+#endif
+
+    void Z3_API Z3_solver_check_async(Z3_context c, Z3_solver s, unsigned num_assumptions, Z3_ast const assumptions[]) {
+        Z3_TRY;
+        LOG_Z3_solver_check_async(c, s, num_assumptions, assumptions);
+        RESET_ERROR_CODE();
+        init_solver(c, s);
+        for (unsigned i = 0; i < num_assumptions; i++) {
+            if (!is_expr(to_ast(assumptions[i]))) {
+                SET_ERROR_CODE(Z3_INVALID_ARG, "assumption is not an expression");
+                return;
+            }
+        }
+        Z3_solver_ref* r = to_solver(s);
+        if (r->m_async) {
+            if (!r->m_async->done()) {
+                SET_ERROR_CODE(Z3_INVALID_USAGE, "an asynchronous check of the solver is running");
+                return;
+            }
+            dealloc(wait_async_check(r));
+        }
+        solver_async_check* a = alloc(solver_async_check, c, s, mk_c(c)->m());
+        for (unsigned i = 0; i < num_assumptions; i++) 
+            a->m_assumptions.push_back(to_expr(assumptions[i]));
+        {
+            lock_guard lock(r->m_mux);
+            r->m_async = a;
+            r->m_async_pending = true;
+            r->m_async_cancel = false;
+        }
+#ifndef SINGLE_THREAD
+        get_async_check_scheduler().submit(a);
+#else
+        run_async_check(a);
+#endif
+        Z3_CATCH;
+    }
+
+    bool Z3_API Z3_solver_check_async_done(Z3_context c, Z3_solver s) {
+        Z3_TRY;
+        LOG_Z3_solver_check_async_done(c, s);
+        RESET_ERROR_CODE();
+        solver_async_check* a = to_solver(s)->m_async;
+        return !a || a->done();
+        Z3_CATCH_RETURN(true);
+    }
+
+    Z3_lbool Z3_API Z3_solver_check_async_wait(Z3_context c, Z3_solver s) {
+        Z3_TRY;
+        LOG_Z3_solver_check_async_wait(c, s);
+        RESET_ERROR_CODE();
+        if (!to_solver(s)->m_async) {
+            SET_ERROR_CODE(Z3_INVALID_USAGE, "no asynchronous check was started");
+            return Z3_L_UNDEF;
+        }
+        solver_async_check* a = wait_async_check(to_solver(s));
+        Z3_lbool r = a->m_result;
+        if (a->m_failed) {
+            if (a->m_error_code != 0) {
+                z3_error ex(a->m_error_code);
+                mk_c(c)->handle_exception(ex);
+            }
+            else {
+                default_exception ex(std::string(a->m_error));
+                mk_c(c)->handle_exception(ex);
+            }
+        }
+        dealloc(a);
+        return r;
+        Z3_CATCH_RETURN(Z3_L_UNDEF);
+    }
+
+    void Z3_API Z3_solver_check_async_eh(Z3_context c, Z3_solver s, void* user_context, Z3_check_eh check_eh) {
+        Z3_TRY;
+        RESET_ERROR_CODE();
+        to_solver(s)->m_check_eh_ctx = user_context;
+        to_solver(s)->m_check_eh = check_eh;
+        Z3_CATCH;
+    }
+
     Z3_model Z3_API Z3_solver_get_model(Z3_context c, Z3_solver s) {
         Z3_TRY;
         LOG_Z3_solver_get_model(c, s);
@@ -930,6 +1239,17 @@ extern "C" {
         Z3_CATCH;        
     }
 
+    void Z3_API Z3_solver_propagate_batch(
+        Z3_context  c, 
+        Z3_solver   s,
+        Z3_batch_eh batch_eh) {
+        Z3_TRY;
+        RESET_ERROR_CODE();
+        solver::batch_eh_t _batch = (void(*)(void*,solver::propagate_callback*,unsigned,unsigned const*,expr* const*,unsigned,unsigned const*,unsigned const*))batch_eh;
+        to_solver_ref(s)->user_propagate_register_batch(_batch);
+        Z3_CATCH;        
+    }
+
     unsigned Z3_API Z3_solver_propagate_register(Z3_context c, Z3_solver s, Z3_ast e) {
         Z3_TRY;
         LOG_Z3_solver_propagate_register(c, s, e);
@@ -946,4 +1266,14 @@ extern "C" {
         Z3_CATCH;        
     }
 
+    void Z3_API Z3_solver_propagate_consequences(Z3_context c, Z3_solver_callback s, unsigned num_fixed, unsigned const* fixed_ids, unsigned num_eqs, unsigned const* eq_lhs, unsigned const* eq_rhs, unsigned num_conseqs, Z3_ast const* conseqs) {
+        Z3_TRY;
+        LOG_Z3_solver_propagate_consequences(c, s, num_fixed, fixed_ids, num_eqs, eq_lhs, eq_rhs, num_conseqs, conseqs);
+        RESET_ERROR_CODE();
+        auto* cb = reinterpret_cast<solver::propagate_callback*>(s);
+        for (unsigned i = 0; i < num_conseqs; ++i)
+            cb->propagate_cb(num_fixed, fixed_ids, num_eqs, eq_lhs, eq_rhs, to_expr(conseqs[i]));
+        Z3_CATCH;        
+    }
+
 };
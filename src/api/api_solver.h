@@ -38,6 +38,8 @@ struct solver2smt2_pp {
 
 };
 
+struct solver_async_check;
+
 struct Z3_solver_ref : public api::object {
     scoped_ptr<solver_factory> m_solver_factory;
     ref<solver>                m_solver;
@@ -46,10 +48,16 @@ struct Z3_solver_ref : public api::object {
     scoped_ptr<solver2smt2_pp> m_pp;
     mutex                      m_mux;
     event_handler*             m_eh;
+    solver_async_check*        m_async;         // check started by Z3_solver_check_async
+    bool                       m_async_pending; // the asynchronous check did not start yet
+    bool                       m_async_cancel;  // interrupt received before the asynchronous check started
+    void*                      m_check_eh_ctx;
+    Z3_check_eh*               m_check_eh;
 
     Z3_solver_ref(api::context& c, solver_factory * f): 
-        api::object(c), m_solver_factory(f), m_solver(nullptr), m_logic(symbol::null), m_eh(nullptr) {}
-    ~Z3_solver_ref() override {}
+        api::object(c), m_solver_factory(f), m_solver(nullptr), m_logic(symbol::null), m_eh(nullptr),
+        m_async(nullptr), m_async_pending(false), m_async_cancel(false), m_check_eh_ctx(nullptr), m_check_eh(nullptr) {}
+    ~Z3_solver_ref() override;
 
     void assert_expr(expr* e);
     void assert_expr(expr* e, expr* t);
@@ -2688,6 +2688,24 @@ namespace z3 {
             check_error();
             return to_check_result(r);
         }
+        /**
+           \brief Start a check without blocking the calling thread, see #Z3_solver_check_async.
+           The context must not be used until check_async_wait returns.
+        */
+        void check_async() { Z3_solver_check_async(ctx(), m_solver, 0, 0); check_error(); }
+        void check_async(expr_vector const& assumptions) {
+            unsigned n = assumptions.size();
+            array<Z3_ast> _assumptions(n);
+            for (unsigned i = 0; i < n; i++) {
+                check_context(*this, assumptions[i]);
+                _assumptions[i] = assumptions[i];
+            }
+            Z3_solver_check_async(ctx(), m_solver, n, _assumptions.ptr());
+            check_error();
+        }
+        bool check_async_done() { bool r = Z3_solver_check_async_done(ctx(), m_solver); check_error(); return r; }
+        check_result check_async_wait() { Z3_lbool r = Z3_solver_check_async_wait(ctx(), m_solver); check_error(); return to_check_result(r); }
+        void interrupt() { Z3_solver_interrupt(ctx(), m_solver); }
         model get_model() const { Z3_model m = Z3_solver_get_model(ctx(), m_solver); check_error(); return model(ctx(), m); }
         check_result consequences(expr_vector& assumptions, expr_vector& vars, expr_vector& conseq) {
             Z3_lbool r = Z3_solver_get_consequences(ctx(), m_solver, assumptions, vars, conseq);
@@ -3877,10 +3895,12 @@ namespace z3 {
         typedef std::function<void(unsigned, expr const&)> fixed_eh_t;
         typedef std::function<void(void)> final_eh_t;
         typedef std::function<void(unsigned, unsigned)> eq_eh_t;
+        typedef std::function<void(unsigned, unsigned const*, expr_vector const&, unsigned, unsigned const*, unsigned const*)> batch_eh_t;
 
         final_eh_t m_final_eh;
         eq_eh_t    m_eq_eh;
         fixed_eh_t m_fixed_eh;
+        batch_eh_t m_batch_eh;
         solver*    s;
         Z3_context c;
         Z3_solver_callback cb { nullptr };
@@ -3929,6 +3949,17 @@ namespace z3 {
             static_cast<user_propagator_base*>(p)->m_final_eh(); 
         }
 
+        static void batch_eh(void* _p, Z3_solver_callback cb, unsigned num_fixed, unsigned const* ids, Z3_ast const* _values,
+                             unsigned num_eqs, unsigned const* lhs, unsigned const* rhs) {
+            user_propagator_base* p = static_cast<user_propagator_base*>(_p);
+            scoped_cb _cb(p, cb);
+            scoped_context ctx(p->ctx());
+            expr_vector values(ctx());
+            for (unsigned i = 0; i < num_fixed; ++i)
+                values.push_back(expr(ctx(), _values[i]));
+            p->m_batch_eh(num_fixed, ids, values, num_eqs, lhs, rhs);
+        }
+
 
     public:
         user_propagator_base(Z3_context c) : s(nullptr), c(c) {}
@@ -4009,8 +4040,30 @@ namespace z3 {
         }
 
 
+        /**
+           \brief register a callback that receives the fixed values and the equalities
+           since its previous invocation in a single call. It replaces the fixed and eq callbacks.
+        */
+
+        void register_batch(batch_eh_t& f) { 
+            assert(s);
+            m_batch_eh = f; 
+            Z3_solver_propagate_batch(ctx(), *s, batch_eh); 
+        }
+
+        void register_batch() { 
+            assert(s);
+            m_batch_eh = [this](unsigned num_fixed, unsigned const* ids, expr_vector const& values, unsigned num_eqs, unsigned const* lhs, unsigned const* rhs) {
+                batch(num_fixed, ids, values, num_eqs, lhs, rhs);
+            };
+            Z3_solver_propagate_batch(ctx(), *s, batch_eh); 
+        }
+
         virtual void fixed(unsigned /*id*/, expr const& /*e*/) { }
 
+        virtual void batch(unsigned /*num_fixed*/, unsigned const* /*ids*/, expr_vector const& /*values*/, 
+                           unsigned /*num_eqs*/, unsigned const* /*lhs*/, unsigned const* /*rhs*/) { }
+
         virtual void eq(unsigned /*x*/, unsigned /*y*/) { }
 
         virtual void final() { }
@@ -4054,6 +4107,14 @@ namespace z3 {
             assert(conseq.ctx() == ctx());
             Z3_solver_propagate_consequence(ctx(), cb, num_fixed, fixed, num_eqs, lhs, rhs, conseq);
         }
+
+        void propagate(unsigned num_fixed, unsigned const* fixed, 
+                       unsigned num_eqs, unsigned const* lhs, unsigned const * rhs, 
+                       expr_vector const& conseqs) {
+            assert(cb);
+            array<Z3_ast> _conseqs(conseqs);
+            Z3_solver_propagate_consequences(ctx(), cb, num_fixed, fixed, num_eqs, lhs, rhs, _conseqs.size(), _conseqs.ptr());
+        }
     };
 
 
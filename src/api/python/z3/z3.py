@@ -344,11 +344,12 @@ class AstRef(Z3PPObject):
     def __init__(self, ast, ctx=None):
         self.ast = ast
         self.ctx = _get_ctx(ctx)
-        Z3_inc_ref(self.ctx.ref(), self.as_ast())
+        Z3_inc_ref(self.ctx.ctx, self.as_ast())
 
     def __del__(self):
-        if self.ctx.ref() is not None and self.ast is not None:
-            Z3_dec_ref(self.ctx.ref(), self.as_ast())
+        ctx_ref = self.ctx.ctx
+        if ctx_ref is not None and self.ast is not None:
+            Z3_dec_ref(ctx_ref, self.as_ast())
             self.ast = None
 
     def __deepcopy__(self, memo={}):
@@ -1175,6 +1176,12 @@ def _coerce_expr_merge(s, a):
 
 
 def _coerce_exprs(a, b, ctx=None):
+    # Fast path: expressions of the same sort need no coercion.
+    # Sorts are hash-consed, so it suffices to compare the pointers.
+    if isinstance(a, ExprRef) and isinstance(b, ExprRef) and a.ctx is b.ctx:
+        ctx_ref = a.ctx.ctx
+        if Z3_get_sort(ctx_ref, a.as_ast()).value == Z3_get_sort(ctx_ref, b.as_ast()).value:
+            return (a, b)
     if not is_expr(a) and not is_expr(b):
         a = _py2expr(a, ctx)
         b = _py2expr(b, ctx)
@@ -6424,6 +6431,60 @@ class ModelRef(Z3PPObject):
         except Z3Exception:
             return None
 
+    def bool_values(self, consts):
+        """Return the values of the Boolean constants `consts` in the model as a list of Python Booleans.
+        Constants without an interpretation are `False`.
+
+        >>> a, b = Bools('a b')
+        >>> s = Solver()
+        >>> s.add(a, Not(b))
+        >>> s.check()
+        sat
+        >>> s.model().bool_values([a, b])
+        [True, False]
+        """
+        num = len(consts)
+        _consts = (FuncDecl * num)()
+        for i in range(num):
+            _consts[i] = consts[i].decl().ast
+        num_words = (num + 31) // 32
+        words = (ctypes.c_uint * num_words)()
+        if not Z3_model_get_bool_values(self.ctx.ref(), self.model, num, _consts, num_words, words):
+            raise Z3Exception("Boolean constants expected")
+        return [(words[i // 32] >> (i % 32)) & 1 == 1 for i in range(num)]
+
+    def int_values(self, consts, words_per_value=2):
+        """Return the values of the integer or bit-vector constants `consts` in the model as a list of
+        Python integers. Each value must fit in `words_per_value` 32-bit words, integers are signed and
+        bit-vectors are unsigned. Constants without an interpretation are 0.
+
+        >>> x, y = Ints('x y')
+        >>> s = Solver()
+        >>> s.add(x == -3, y == 2**40)
+        >>> s.check()
+        sat
+        >>> s.model().int_values([x, y])
+        [-3, 1099511627776]
+        """
+        num = len(consts)
+        _consts = (FuncDecl * num)()
+        for i in range(num):
+            _consts[i] = consts[i].decl().ast
+        num_words = num * words_per_value
+        words = (ctypes.c_uint * num_words)()
+        if not Z3_model_get_numeral_words(self.ctx.ref(), self.model, num, _consts, words_per_value, num_words, words):
+            raise Z3Exception("integer or bit-vector constants with small enough values expected")
+        bits = 32 * words_per_value
+        result = []
+        for i in range(num):
+            v = 0
+            for j in range(words_per_value - 1, -1, -1):
+                v = (v << 32) | words[i * words_per_value + j]
+            if is_int(consts[i]) and v >= 1 << (bits - 1):
+                v -= 1 << bits
+            result.append(v)
+        return result
+
     def num_sorts(self):
         """Return the number of uninterpreted sorts that contain an interpretation in the model `self`.
 
@@ -7022,6 +7083,63 @@ class Solver(Z3PPObject):
         r = Z3_solver_check_assumptions(self.ctx.ref(), self.solver, num, _assumptions)
         return CheckSatResult(r)
 
+    def check_async(self, *assumptions):
+        """Start checking the assertions in the solver plus the optional assumptions without blocking.
+        Until `check_async_wait()` returns, the context of the solver must not be used except for
+        `check_async_done()`, `check_async_wait()` and `interrupt()`.
+
+        >>> x = Int('x')
+        >>> s = Solver()
+        >>> s.add(x > 0, x < 2)
+        >>> s.check_async()
+        >>> s.check_async_wait()
+        sat
+        """
+        s = BoolSort(self.ctx)
+        assumptions = _get_args(assumptions)
+        num = len(assumptions)
+        _assumptions = (Ast * num)()
+        for i in range(num):
+            _assumptions[i] = s.cast(assumptions[i]).as_ast()
+        Z3_solver_check_async(self.ctx.ref(), self.solver, num, _assumptions)
+
+    def check_async_done(self):
+        """Return `True` if the check started by `check_async()` is completed."""
+        return Z3_solver_check_async_done(self.ctx.ref(), self.solver)
+
+    def check_async_wait(self):
+        """Wait for the check started by `check_async()` and return its result."""
+        return CheckSatResult(Z3_solver_check_async_wait(self.ctx.ref(), self.solver))
+
+    def interrupt(self):
+        """Interrupt the check that is running on the solver."""
+        Z3_solver_interrupt(self.ctx.ref(), self.solver)
+
+    def check_future(self, *assumptions, **kwargs):
+        """Start checking the assertions in the solver plus the optional assumptions and
+        return an asyncio future of the result. The check is polled on the running event loop
+        every `poll` seconds (default 0.01). Canceling the future interrupts the check.
+        """
+        import asyncio
+        poll = kwargs.get("poll", 0.01)
+        loop = asyncio.get_event_loop()
+        future = loop.create_future()
+        self.check_async(*assumptions)
+
+        def _poll():
+            if future.cancelled():
+                self.interrupt()
+                self.check_async_wait()
+            elif self.check_async_done():
+                try:
+                    future.set_result(self.check_async_wait())
+                except Z3Exception as e:
+                    future.set_exception(e)
+            else:
+                loop.call_later(poll, _poll)
+        loop.call_soon(_poll)
+        return future
+
     def model(self):
         """Return a model for the last `check()`.
 
@@ -11186,6 +11304,16 @@ def user_prop_diseq(ctx, cb, x, y):
     prop.cb = None
 
 
+def user_prop_batch(ctx, cb, num_fixed, ids, values, num_eqs, lhs, rhs):
+    prop = _prop_closures.get(ctx)
+    prop.cb = cb
+    c = prop.ctx()
+    fixed = [(ids[i], _to_expr_ref(ctypes.c_void_p(values[i]), c)) for i in range(num_fixed)]
+    eqs = [(lhs[i], rhs[i]) for i in range(num_eqs)]
+    prop.batch(fixed, eqs)
+    prop.cb = None
+
+
 _user_prop_push = push_eh_type(user_prop_push)
 _user_prop_pop = pop_eh_type(user_prop_pop)
 _user_prop_fresh = fresh_eh_type(user_prop_fresh)
@@ -11193,6 +11321,7 @@ _user_prop_fixed = fixed_eh_type(user_prop_fixed)
 _user_prop_final = final_eh_type(user_prop_final)
 _user_prop_eq = eq_eh_type(user_prop_eq)
 _user_prop_diseq = eq_eh_type(user_prop_diseq)
+_user_prop_batch = batch_eh_type(user_prop_batch)
 
 
 class UserPropagateBase:
@@ -11215,6 +11344,7 @@ class UserPropagateBase:
         self.final = None
         self.eq = None
         self.diseq = None
+        self.batch = None
         if ctx:
             # TBD fresh is broken: ctx is not of the right type when we reach here.
             self._ctx = Context()
@@ -11267,6 +11397,16 @@ class UserPropagateBase:
         Z3_solver_propagate_diseq(self.ctx_ref(), self.solver.solver, _user_prop_diseq)
         self.diseq = diseq
 
+    def add_batch(self, batch):
+        """Register batch(fixed, eqs). It is invoked with the list of pairs (id, value)
+        of the registered expressions that were fixed and the list of pairs (x, y) of the
+        equalities since its previous invocation. It replaces the fixed and eq callbacks.
+        """
+        assert not self.batch
+        assert not self._ctx
+        Z3_solver_propagate_batch(self.ctx_ref(), self.solver.solver, _user_prop_batch)
+        self.batch = batch
+
     def push(self):
         raise Z3Exception("push needs to be overwritten")
 
@@ -11298,5 +11438,18 @@ class UserPropagateBase:
         Z3_solver_propagate_consequence(e.ctx.ref(), ctypes.c_void_p(
             self.cb), num_fixed, _ids, num_eqs, _lhs, _rhs, e.ast)
 
+    #
+    # Propagate several consequences that share the justification ids and eqs.
+    #
+    def propagate_many(self, es, ids, eqs=[]):
+        num_fixed = len(ids)
+        _ids = (ctypes.c_uint * num_fixed)(*ids)
+        num_eqs = len(eqs)
+        _lhs = (ctypes.c_uint * num_eqs)(*[x for x, _ in eqs])
+        _rhs = (ctypes.c_uint * num_eqs)(*[y for _, y in eqs])
+        _es = (Ast * len(es))(*[e.ast for e in es])
+        Z3_solver_propagate_consequences(self.ctx_ref(), ctypes.c_void_p(
+            self.cb), num_fixed, _ids, num_eqs, _lhs, _rhs, len(es), _es)
+
     def conflict(self, ids):
         self.propagate(BoolVal(False, self.ctx()), ids, eqs=[])
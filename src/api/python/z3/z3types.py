@@ -201,6 +201,14 @@ class AstMapObj(ctypes.c_void_p):
         return obj
 
 
+class SimplifierObj(ctypes.c_void_p):
+    def __init__(self, simplifier):
+        self._as_parameter_ = simplifier
+
+    def from_param(obj):
+        return obj
+
+
 class Params(ctypes.c_void_p):
     def __init__(self, params):
         self._as_parameter_ = params
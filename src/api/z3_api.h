@@ -35,6 +35,7 @@ DEFINE_TYPE(Z3_func_entry);
 DEFINE_TYPE(Z3_fixedpoint);
 DEFINE_TYPE(Z3_optimize);
 DEFINE_TYPE(Z3_rcf_num);
+DEFINE_TYPE(Z3_simplifier);
 
 /** \defgroup capi C API */
 /**@{*/
@@ -71,6 +72,7 @@ DEFINE_TYPE(Z3_rcf_num);
    - \c Z3_apply_result: collection of subgoals resulting from applying of a tactic to a goal.
    - \c Z3_solver: (incremental) solver, possibly specialized by a particular tactic or logic.
    - \c Z3_stats: statistical data for a solver.
+   - \c Z3_simplifier: simplifier that keeps its rewrite cache across calls.
 */
 
 /**
@@ -1412,6 +1414,7 @@ typedef enum
   def_Type('OPTIMIZE',         'Z3_optimize',         'OptimizeObj')
   def_Type('PARAM_DESCRS',     'Z3_param_descrs',     'ParamDescrs')
   def_Type('RCF_NUM',          'Z3_rcf_num',          'RCFNumObj')
+  def_Type('SIMPLIFIER',       'Z3_simplifier',       'SimplifierObj')
 */
 
 /**
@@ -1429,6 +1432,12 @@ typedef void* Z3_fresh_eh(void* ctx, Z3_context new_context);
 typedef void Z3_fixed_eh(void* ctx, Z3_solver_callback cb, unsigned id, Z3_ast value);
 typedef void Z3_eq_eh(void* ctx, Z3_solver_callback cb, unsigned x, unsigned y);
 typedef void Z3_final_eh(void* ctx, Z3_solver_callback cb);
+typedef void Z3_batch_eh(void* ctx, Z3_solver_callback cb, unsigned num_fixed, unsigned const* fixed_ids, Z3_ast const* values, unsigned num_eqs, unsigned const* eq_lhs, unsigned const* eq_rhs);
+
+/**
+   \brief callback function for the completion of #Z3_solver_check_async.
+*/
+typedef void Z3_check_eh(void* ctx, Z3_lbool result);
 
 
 /**
@@ -2195,6 +2204,32 @@ extern "C" {
         unsigned num_args,
         Z3_ast const args[]);
 
+    /**
+       \brief Create a DAG of function applications in a single call.
+
+       The DAG is described by \c code, a sequence of \c num_nodes nodes in postfix order.
+       Each node is encoded as an index into \c decls, the number of arguments \c n,
+       and \c n argument references. A reference \c r smaller than \c num_leaves
+       denotes \c leaves[r]; otherwise it denotes the node <tt>r - num_leaves</tt>,
+       which must precede the node that refers to it.
+
+       Built-in declarations, such as the declaration of a conjunction or of a bit-vector
+       addition obtained with #Z3_get_app_decl, are instantiated for the arguments of each
+       node, so one declaration can be used for applications of different arities and sorts.
+
+       The nodes are stored in \c nodes, and the last one is returned.
+
+       \sa Z3_mk_app
+
+       def_API('Z3_mk_app_dag', AST, (_in(CONTEXT), _in(UINT), _in_array(1, FUNC_DECL), _in(UINT), _in_array(3, AST), _in(UINT), _in_array(5, UINT), _in(UINT), _out_array(7, AST)))
+    */
+    Z3_ast Z3_API Z3_mk_app_dag(
+        Z3_context c,
+        unsigned num_decls, Z3_func_decl const decls[],
+        unsigned num_leaves, Z3_ast const leaves[],
+        unsigned code_size, unsigned const code[],
+        unsigned num_nodes, Z3_ast nodes[]);
+
     /**
        \brief Declare and create a constant.
 
@@ -5150,6 +5185,58 @@ extern "C" {
        def_API('Z3_simplify_get_param_descrs', PARAM_DESCRS, (_in(CONTEXT),))
     */
     Z3_param_descrs Z3_API Z3_simplify_get_param_descrs(Z3_context c);
+
+    /**
+       \brief Create a simplifier that is configured by the given parameter set,
+       see #Z3_simplify_get_param_descrs.
+
+       Unlike #Z3_simplify_ex, the simplifier keeps the simplified forms of
+       subterms between calls to #Z3_simplifier_apply, so terms that share
+       subterms with previously simplified terms are simplified faster.
+       The cache is cleared when it holds more than \c cache_size entries
+       (parameter \c cache_size, default 1000000), or by #Z3_simplifier_reset.
+
+       \remark Reference counting must be used to manage simplifiers, even when the Z3_context was
+       created using #Z3_mk_context instead of #Z3_mk_context_rc.
+
+       \sa Z3_simplifier_apply
+       \sa Z3_simplifier_reset
+
+       def_API('Z3_mk_simplifier', SIMPLIFIER, (_in(CONTEXT), _in(PARAMS)))
+    */
+    Z3_simplifier Z3_API Z3_mk_simplifier(Z3_context c, Z3_params p);
+
+    /**
+       \brief Increment the reference counter of the given simplifier.
+
+       def_API('Z3_simplifier_inc_ref', VOID, (_in(CONTEXT), _in(SIMPLIFIER)))
+    */
+    void Z3_API Z3_simplifier_inc_ref(Z3_context c, Z3_simplifier s);
+
+    /**
+       \brief Decrement the reference counter of the given simplifier.
+
+       def_API('Z3_simplifier_dec_ref', VOID, (_in(CONTEXT), _in(SIMPLIFIER)))
+    */
+    void Z3_API Z3_simplifier_dec_ref(Z3_context c, Z3_simplifier s);
+
+    /**
+       \brief Simplify \c a using the simplifier \c s.
+
+       \sa Z3_mk_simplifier
+
+       def_API('Z3_simplifier_apply', AST, (_in(CONTEXT), _in(SIMPLIFIER), _in(AST)))
+    */
+    Z3_ast Z3_API Z3_simplifier_apply(Z3_context c, Z3_simplifier s, Z3_ast a);
+
+    /**
+       \brief Clear the cache of the simplifier \c s.
+
+       \sa Z3_mk_simplifier
+
+       def_API('Z3_simplifier_reset', VOID, (_in(CONTEXT), _in(SIMPLIFIER)))
+    */
+    void Z3_API Z3_simplifier_reset(Z3_context c, Z3_simplifier s);
     /**@}*/
 
     /** @name Modifiers */
@@ -5191,6 +5278,8 @@ extern "C" {
     /**
        \brief Translate/Copy the AST \c a from context \c source to context \c target.
        AST \c a must have been created using context \c source.
+       Several threads may translate from the same \c source context concurrently,
+       each into its own \c target, as long as \c source is not otherwise used meanwhile.
        \pre source != target
 
        def_API('Z3_translate', AST, (_in(CONTEXT), _in(AST), _in(CONTEXT)))
@@ -5258,6 +5347,41 @@ extern "C" {
     */
     Z3_ast_opt Z3_API Z3_model_get_const_interp(Z3_context c, Z3_model m, Z3_func_decl a);
 
+    /**
+       \brief Store the values of the Boolean constants \c consts in the model \c m as packed bits.
+       The value of \c consts[i] is bit <tt>i % 32</tt> of \c words[i / 32]. Constants without an
+       interpretation in the model are \c false.
+
+       Return \c false, and set the error code, if a constant is not Boolean, if its value
+       is neither \c true nor \c false, or if \c num_words is smaller than <tt>(num_consts + 31) / 32</tt>.
+
+       \pre Z3_get_arity(c, consts[i]) == 0
+
+       \sa Z3_model_get_const_interp
+
+       def_API('Z3_model_get_bool_values', BOOL, (_in(CONTEXT), _in(MODEL), _in(UINT), _in_array(2, FUNC_DECL), _in(UINT), _out_array(4, UINT)))
+    */
+    bool Z3_API Z3_model_get_bool_values(Z3_context c, Z3_model m, unsigned num_consts, Z3_func_decl const consts[], unsigned num_words, unsigned words[]);
+
+    /**
+       \brief Store the values of the integer and bit-vector constants \c consts in the model \c m
+       as sequences of \c words_per_value 32-bit words. The value of \c consts[i] is stored, least
+       significant word first, in <tt>words[i * words_per_value]</tt> to
+       <tt>words[(i + 1) * words_per_value - 1]</tt>. Negative integers are stored in two's complement,
+       so with \c words_per_value 2 the buffer holds 64-bit values that a little-endian machine can
+       read as an array of \c int64_t or \c uint64_t. Constants without an interpretation in the model are 0.
+
+       Return \c false, and set the error code, if a value is not a numeral or does not fit,
+       or if \c num_words is smaller than <tt>num_consts * words_per_value</tt>.
+
+       \pre Z3_get_arity(c, consts[i]) == 0
+
+       \sa Z3_model_get_bool_values
+
+       def_API('Z3_model_get_numeral_words', BOOL, (_in(CONTEXT), _in(MODEL), _in(UINT), _in_array(2, FUNC_DECL), _in(UINT), _in(UINT), _out_array(5, UINT)))
+    */
+    bool Z3_API Z3_model_get_numeral_words(Z3_context c, Z3_model m, unsigned num_consts, Z3_func_decl const consts[], unsigned words_per_value, unsigned num_words, unsigned words[]);
+
     /**
        \brief Test if there exists an interpretation (i.e., assignment) for \c a in the model \c m.
 
@@ -6419,6 +6543,10 @@ extern "C" {
     /**
        \brief Copy a solver \c s from the context \c source to the context \c target.
 
+       Several threads may copy solvers from the same \c source context concurrently,
+       each into its own \c target, as long as \c source is not otherwise used meanwhile.
+       This lets worker contexts share a background theory that is asserted once in \c source.
+
        def_API('Z3_solver_translate', SOLVER, (_in(CONTEXT), _in(SOLVER), _in(CONTEXT)))
     */
     Z3_solver Z3_API Z3_solver_translate(Z3_context source, Z3_solver s, Z3_context target);
@@ -6570,6 +6698,21 @@ extern "C" {
     */
     void Z3_API Z3_solver_assert_and_track(Z3_context c, Z3_solver s, Z3_ast a, Z3_ast p);
 
+    /**
+       \brief Assert a set of clauses into the solver.
+
+       The clauses are given in DIMACS style: \c lits is a sequence of clauses,
+       each clause is a sequence of non-zero integers terminated by 0. The
+       integer \c i stands for \c atoms[i-1] and \c -i stands for its negation.
+
+       \pre \c atoms must be Boolean expressions.
+
+       \sa Z3_solver_assert
+
+       def_API('Z3_solver_assert_clauses', VOID, (_in(CONTEXT), _in(SOLVER), _in(UINT), _in_array(2, AST), _in(UINT), _in_array(4, INT)))
+    */
+    void Z3_API Z3_solver_assert_clauses(Z3_context c, Z3_solver s, unsigned num_atoms, Z3_ast const atoms[], unsigned num_lits, int const lits[]);
+
     /**
        \brief load solver assertions from a file.
 
@@ -6590,6 +6733,29 @@ extern "C" {
     */
     void Z3_API Z3_solver_from_string(Z3_context c, Z3_solver s, Z3_string file_name);
 
+    /**
+       \brief save the solver assertions to a file in the compact binary format.
+
+       The binary format stores the shared expression DAG directly and is
+       much faster to load than SMT-LIB2 text. Assertions that use datatypes,
+       recursive function definitions or lambdas cannot be saved in this format.
+
+       \sa Z3_solver_from_binary
+
+       def_API('Z3_solver_to_binary', VOID, (_in(CONTEXT), _in(SOLVER), _in(STRING)))
+    */
+    void Z3_API Z3_solver_to_binary(Z3_context c, Z3_solver s, Z3_string file_name);
+
+    /**
+       \brief load solver assertions from a file produced by #Z3_solver_to_binary.
+
+       \sa Z3_solver_to_binary
+       \sa Z3_solver_from_file
+
+       def_API('Z3_solver_from_binary', VOID, (_in(CONTEXT), _in(SOLVER), _in(STRING)))
+    */
+    void Z3_API Z3_solver_from_binary(Z3_context c, Z3_solver s, Z3_string file_name);
+
     /**
        \brief Return the set of asserted formulas on the solver.
 
@@ -6670,6 +6836,18 @@ extern "C" {
     */
     void Z3_API Z3_solver_propagate_diseq(Z3_context c, Z3_solver s, Z3_eq_eh eq_eh);
 
+    /**
+       \brief register a callback that receives, in a single call, the expressions
+       that were bound to fixed values and the equalities between expressions since
+       its previous invocation. The callback is invoked before the solver propagates
+       or performs a final check. When it is registered, the callbacks registered with
+       \c Z3_solver_propagate_fixed and \c Z3_solver_propagate_eq are not invoked.
+
+       The arrays are only valid during the callback.
+       The SAT-based solver does not report equalities.
+    */
+    void Z3_API Z3_solver_propagate_batch(Z3_context c, Z3_solver s, Z3_batch_eh batch_eh);
+
     /**
        \brief register an expression to propagate on with the solver.
        Only expressions of type Bool and type Bit-Vector can be registered for propagation.
@@ -6690,6 +6868,16 @@ extern "C" {
     
     void Z3_API Z3_solver_propagate_consequence(Z3_context c, Z3_solver_callback, unsigned num_fixed, unsigned const* fixed_ids, unsigned num_eqs, unsigned const* eq_lhs, unsigned const* eq_rhs, Z3_ast conseq);
 
+    /**
+       \brief propagate several consequences that share the same justification.
+       It has the same effect as calling \c Z3_solver_propagate_consequence
+       for every element of \c conseqs.
+
+       def_API('Z3_solver_propagate_consequences', VOID, (_in(CONTEXT), _in(SOLVER_CALLBACK), _in(UINT), _in_array(2, UINT), _in(UINT), _in_array(4, UINT), _in_array(4, UINT), _in(UINT), _in_array(7, AST)))
+    */
+    
+    void Z3_API Z3_solver_propagate_consequences(Z3_context c, Z3_solver_callback, unsigned num_fixed, unsigned const* fixed_ids, unsigned num_eqs, unsigned const* eq_lhs, unsigned const* eq_rhs, unsigned num_conseqs, Z3_ast const* conseqs);
+
     /**
        \brief Check whether the assertions in a given solver are consistent or not.
 
@@ -6724,6 +6912,50 @@ extern "C" {
     Z3_lbool Z3_API Z3_solver_check_assumptions(Z3_context c, Z3_solver s,
                                                 unsigned num_assumptions, Z3_ast const assumptions[]);
 
+    /**
+       \brief Start checking the assertions in the given solver and the
+       given assumptions without blocking the calling thread.
+
+       The check runs on a worker thread of Z3. At most \c async_threads
+       checks (a global parameter, 0 means the number of hardware threads)
+       run at the same time, and checks of solvers that belong to the same
+       context run one after the other. Each check is limited by the
+       \c timeout and \c rlimit parameters of its solver.
+
+       Until #Z3_solver_check_async_wait returns, or the callback registered
+       with #Z3_solver_check_async_eh is invoked, the context of \c s may only
+       be used to invoke #Z3_solver_check_async_done, #Z3_solver_check_async_wait
+       and #Z3_solver_interrupt on \c s. Errors during the check are reported
+       by #Z3_solver_check_async_wait.
+
+       \sa Z3_solver_check_assumptions
+
+       def_API('Z3_solver_check_async', VOID, (_in(CONTEXT), _in(SOLVER), _in(UINT), _in_array(2, AST)))
+    */
+    void Z3_API Z3_solver_check_async(Z3_context c, Z3_solver s,
+                                      unsigned num_assumptions, Z3_ast const assumptions[]);
+
+    /**
+       \brief Return true if the check started by #Z3_solver_check_async is completed.
+
+       def_API('Z3_solver_check_async_done', BOOL, (_in(CONTEXT), _in(SOLVER)))
+    */
+    bool Z3_API Z3_solver_check_async_done(Z3_context c, Z3_solver s);
+
+    /**
+       \brief Wait for the check started by #Z3_solver_check_async and return its result.
+       The check can be canceled with #Z3_solver_interrupt.
+
+       def_API('Z3_solver_check_async_wait', INT, (_in(CONTEXT), _in(SOLVER)))
+    */
+    Z3_lbool Z3_API Z3_solver_check_async_wait(Z3_context c, Z3_solver s);
+
+    /**
+       \brief register a callback that is invoked, on the worker thread, when a check
+       started by #Z3_solver_check_async on \c s completes.
+    */
+    void Z3_API Z3_solver_check_async_eh(Z3_context c, Z3_solver s, void* user_context, Z3_check_eh check_eh);
+
     /**
        \brief Retrieve congruence class representatives for terms.
 
@@ -36,6 +36,10 @@ void throw_invalid_reference() {
 struct z3_replayer::imp {
     z3_replayer &            m_owner;
     std::istream &           m_stream;
+    static const size_t      BUFFER_SIZE = 1 << 16;
+    char                     m_buffer[BUFFER_SIZE]; // input is read in blocks instead of per character
+    char const *             m_pos;
+    char const *             m_end;
     int                      m_curr;  // current char;
     int                      m_line;  // line
     svector<char>            m_string;
@@ -114,6 +118,8 @@ struct z3_replayer::imp {
     imp(z3_replayer & o, std::istream & in):
         m_owner(o),
         m_stream(in),
+        m_pos(m_buffer),
+        m_end(m_buffer),
         m_curr(0),
         m_line(1) {
         next();
@@ -162,7 +168,21 @@ struct z3_replayer::imp {
 
     int curr() const { return m_curr; }
     void new_line() { m_line++; }
-    void next() { m_curr = m_stream.get(); }
+    bool fill() {
+        if (!m_stream.read(m_buffer, BUFFER_SIZE) && m_stream.gcount() == 0)
+            return false;
+        m_pos = m_buffer;
+        m_end = m_buffer + m_stream.gcount();
+        return true;
+    }
+
+    void next() {
+        if (m_pos == m_end && !fill()) {
+            m_curr = EOF;
+            return;
+        }
+        m_curr = static_cast<unsigned char>(*m_pos++);
+    }
 
     void read_string_core(char delimiter) {
         if (curr() != delimiter)
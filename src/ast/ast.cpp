@@ -323,6 +323,7 @@ static app_flags mk_const_flags() {
     r.m_ground          = true;
     r.m_has_quantifiers = false;
     r.m_has_labels      = false;
+    r.m_size            = 1;
     return r;
 }
 
@@ -332,6 +333,7 @@ static app_flags mk_default_app_flags() {
     r.m_ground          = true;
     r.m_has_quantifiers = false;
     r.m_has_labels      = false;
+    r.m_size            = 1;
     return r;
 }
 
@@ -363,6 +365,7 @@ quantifier::quantifier(quantifier_kind k, unsigned num_decls, sort * const * dec
     m_weight(weight),
     m_has_unused_vars(true),
     m_has_labels(::has_labels(body)),
+    m_size(::get_tree_size(body) == UINT_MAX ? UINT_MAX : ::get_tree_size(body) + 1),
     m_qid(qid),
     m_skid(skid),
     m_num_patterns(num_patterns),
@@ -387,6 +390,7 @@ quantifier::quantifier(unsigned num_decls, sort * const * decl_sorts, symbol con
     m_weight(1),
     m_has_unused_vars(true),
     m_has_labels(::has_labels(body)),
+    m_size(::get_tree_size(body) == UINT_MAX ? UINT_MAX : ::get_tree_size(body) + 1),
     m_qid(symbol()),
     m_skid(symbol()),
     m_num_patterns(0),
@@ -1422,6 +1426,8 @@ ast_manager::~ast_manager() {
             dealloc(p);
     }
     m_plugins.reset();
+    if (m_bulk_release)
+        release_all_nodes();
     while (!m_ast_table.empty()) {
         DEBUG_CODE(IF_VERBOSE(0, verbose_stream() << "ast_manager LEAKED: " << m_ast_table.size() << std::endl););
         ptr_vector<ast> roots;
@@ -1490,6 +1496,33 @@ ast_manager::~ast_manager() {
     }
 }
 
+/**
+   \brief Free every node without following references.
+   Plugins are already deallocated, so parameters are released without del_eh.
+*/
+void ast_manager::release_all_nodes() {
+    ptr_vector<ast> nodes;
+    for (ast * n : m_ast_table)
+        nodes.push_back(n);
+    m_ast_table.reset();
+    m_lambda_defs.reset();
+    for (ast * n : nodes) {
+        switch (n->get_kind()) {
+        case AST_SORT:
+            if (to_sort(n)->m_info != nullptr)
+                dealloc(to_sort(n)->get_info());
+            break;
+        case AST_FUNC_DECL:
+            if (to_func_decl(n)->m_info != nullptr)
+                dealloc(to_func_decl(n)->get_info());
+            break;
+        default:
+            break;
+        }
+        deallocate_node(n, ::get_node_size(n));
+    }
+}
+
 void ast_manager::compact_memory() {
     m_alloc.consolidate();
     unsigned capacity = m_ast_table.capacity();
@@ -1637,6 +1670,18 @@ bool ast_manager::is_unique_value(expr* e) const {
     return false;
 }
 
+unsigned ast_manager::acquire_epoch() {
+    if (m_epoch_in_use || m_concurrent)
+        return 0;
+    if (++m_epoch == (1u << AST_EPOCH_NUM_BITS)) {
+        for (ast * n : m_ast_table)
+            n->m_epoch = 0;
+        m_epoch = 1;
+    }
+    m_epoch_in_use = true;
+    return m_epoch;
+}
+
 bool ast_manager::are_equal(expr * a, expr * b) const {
     if (a == b) {
         return true;
@@ -1721,6 +1766,7 @@ static void track_id(ast_manager& m, ast* n, unsigned id) {
 #endif
 
 ast * ast_manager::register_node_core(ast * n) {
+    concurrent_guard _g(*this);
     unsigned h = get_node_hash(n);
     n->m_hash = h;
 #ifdef Z3DEBUG
@@ -1783,9 +1829,12 @@ ast * ast_manager::register_node_core(ast * n) {
             if (is_label(t))
                 f->m_has_labels = true;
             unsigned depth = 0;
+            unsigned size = 1;
             for (unsigned i = 0; i < num_args; i++) {
                 expr * arg = t->get_arg(i);
                 inc_ref(arg);
+                unsigned arg_size = ::get_tree_size(arg);
+                size = arg_size > UINT_MAX - size ? UINT_MAX : size + arg_size;
                 unsigned arg_depth = 0;
                 switch (arg->get_kind()) {
                 case AST_APP: {
@@ -1818,6 +1867,7 @@ ast * ast_manager::register_node_core(ast * n) {
             if (depth > c_max_depth)
                 depth = c_max_depth;
             f->m_depth = depth;
+            f->m_size  = size;
             SASSERT(t->get_depth() == depth);
         }
         break;
@@ -1840,6 +1890,7 @@ ast * ast_manager::register_node_core(ast * n) {
 
 
 void ast_manager::delete_node(ast * n) {
+    concurrent_guard _g(*this);
     TRACE("delete_node_bug", tout << mk_ll_pp(n, *this) << "\n";);
 
     SASSERT(m_ast_table.contains(n));
@@ -47,6 +47,7 @@ Revision History:
 #include "util/z3_exception.h"
 #include "util/dependency.h"
 #include "util/rlimit.h"
+#include "util/mutex.h"
 #include <variant>
 
 #define RECYCLE_FREE_AST_INDICES
@@ -448,6 +449,8 @@ char const * get_ast_kind_name(ast_kind k);
 
 class shared_occs_mark;
 
+#define AST_EPOCH_NUM_BITS 13
+
 class ast {
 protected:
     friend class ast_manager;
@@ -467,6 +470,9 @@ protected:
     //    shared_occs used one of the public marks.
     //  - This was a constant source of assertion violations.
     unsigned m_mark_shared_occs:1;
+    // Visit epoch used by expr_epoch_mark, see ast_manager::acquire_epoch.
+    unsigned m_epoch:AST_EPOCH_NUM_BITS;
+    friend class expr_epoch_mark;
     friend class shared_occs_mark;
     void mark_so(bool flag) { m_mark_shared_occs = flag; }
     void reset_mark_so() { m_mark_shared_occs = false; }
@@ -489,7 +495,7 @@ protected:
         --m_ref_count;
     }
 
-    ast(ast_kind k):m_id(UINT_MAX), m_kind(k), m_mark1(false), m_mark2(false), m_mark_shared_occs(false), m_ref_count(0) {
+    ast(ast_kind k):m_id(UINT_MAX), m_kind(k), m_mark1(false), m_mark2(false), m_mark_shared_occs(false), m_epoch(0), m_ref_count(0) {
         DEBUG_CODE({
             m_mark1_owner = 0;
             m_mark2_owner = 0;
@@ -686,6 +692,7 @@ struct app_flags {
     unsigned     m_ground:1;   // application does not have free variables or nested quantifiers.
     unsigned     m_has_quantifiers:1; // application has nested quantifiers.
     unsigned     m_has_labels:1; // application has nested labels.
+    unsigned     m_size;       // number of nodes of the application as a tree, saturates at UINT_MAX.
 };
 
 class app : public expr {
@@ -726,6 +733,7 @@ public:
 
     unsigned get_depth() const { return flags()->m_depth; }
     bool is_ground() const { return flags()->m_ground; }
+    unsigned get_tree_size() const { return flags()->m_size; }
     bool has_quantifiers() const { return flags()->m_has_quantifiers; }
     bool has_labels() const { return flags()->m_has_labels; }
 };
@@ -838,6 +846,7 @@ class quantifier : public expr {
     int                 m_weight;
     bool                m_has_unused_vars;
     bool                m_has_labels;
+    unsigned            m_size;
     symbol              m_qid;
     symbol              m_skid;
     unsigned            m_num_patterns;
@@ -870,6 +879,7 @@ public:
     sort * _get_sort() const { return m_sort; }
 
     unsigned get_depth() const { return m_depth; }
+    unsigned get_tree_size() const { return m_size; }
 
     int get_weight() const { return m_weight; }
     symbol const & get_qid() const { return m_qid; }
@@ -1377,6 +1387,16 @@ inline unsigned get_depth(expr const * n) {
     else return 1;
 }
 
+/**
+   \brief Return the number of nodes of n viewed as a tree, without patterns.
+   The count saturates at UINT_MAX.
+*/
+inline unsigned get_tree_size(expr const * n) {
+    if (is_app(n)) return to_app(n)->get_tree_size();
+    else if (is_quantifier(n)) return to_quantifier(n)->get_tree_size();
+    else return 1;
+}
+
 inline bool has_quantifiers(expr const * n) {
     return is_app(n) ? to_app(n)->has_quantifiers() : is_quantifier(n);
 }
@@ -1464,7 +1484,11 @@ public:
 
     void update_fresh_id(ast_manager const& other);
 
-    unsigned mk_fresh_id() { return ++m_fresh_id; }
+    void update_fresh_id(unsigned id) { m_fresh_id = std::max(m_fresh_id, id); }
+
+    unsigned get_fresh_id() const { return m_fresh_id; }
+
+    unsigned mk_fresh_id() { concurrent_guard _g(*this); return ++m_fresh_id; }
 
 protected:
     reslimit                  m_limit;
@@ -1487,6 +1511,11 @@ protected:
     proof *                   m_undef_proof;
     unsigned                  m_fresh_id;
     bool                      m_debug_ref_count;
+    bool                      m_concurrent { false };
+    bool                      m_bulk_release { false };
+    unsigned                  m_epoch { 0 };
+    bool                      m_epoch_in_use { false };
+    recursive_mutex           m_concurrent_mux;
     u_map<unsigned>           m_debug_free_indices;
     std::fstream*             m_trace_stream;
     bool                      m_trace_stream_owner;
@@ -1615,15 +1644,56 @@ public:
 
     unsigned get_num_asts() const { return m_ast_table.size(); }
 
+    /**
+       \brief Return a fresh visit epoch for marking nodes in place, or 0 if
+       the epoch is in use by another traversal or the manager is concurrent.
+       Epochs wrap around after 2^AST_EPOCH_NUM_BITS - 1 traversals, and then
+       the epochs of all nodes are cleared.
+    */
+    unsigned acquire_epoch();
+    void release_epoch() { SASSERT(m_epoch_in_use); m_epoch_in_use = false; }
+
     void debug_ref_count() { m_debug_ref_count = true; }
 
+    /**
+       \brief In concurrent mode hash-consing, node allocation, reference counting and
+       node deletion are serialized on a manager-wide lock, so that several threads
+       can share the terms of this manager instead of translating them into private
+       managers. Caches maintained by decl_plugins (e.g., numerals) are not covered,
+       such terms should be created before the manager is shared.
+       The mode has to be set while the manager is not used by other threads.
+    */
+    void set_concurrent(bool f) { m_concurrent = f; }
+    bool is_concurrent() const { return m_concurrent; }
+
+    /**
+       \brief Stop reference counting and release all nodes in bulk when the manager is destroyed.
+       Intended for clients that throw away the manager together with everything
+       built on it: subsequent dec_ref calls are no-ops, so tearing down solvers and
+       contexts does not traverse and delete terms one at a time.
+       Terms are no longer reclaimed until the manager is deleted.
+    */
+    void start_bulk_release() { m_bulk_release = true; }
+    bool in_bulk_release() const { return m_bulk_release; }
+
+    class concurrent_guard {
+        ast_manager& m;
+        bool         m_locked;
+    public:
+        concurrent_guard(ast_manager& m): m(m), m_locked(m.m_concurrent) { if (m_locked) m.m_concurrent_mux.lock(); }
+        ~concurrent_guard() { if (m_locked) m.m_concurrent_mux.unlock(); }
+    };
+
     void inc_ref(ast* n) {
-        if (n) 
+        if (n) {
+            concurrent_guard _g(*this);
             n->inc_ref();
+        }
     }
     
     void dec_ref(ast* n) {
-        if (n) {
+        if (n && !m_bulk_release) {
+            concurrent_guard _g(*this);
             n->dec_ref();
             if (n->get_ref_count() == 0)
                 delete_node(n);
@@ -1662,11 +1732,15 @@ protected:
 
     void delete_node(ast * n);
 
+    void release_all_nodes();
+
     void * allocate_node(unsigned size) {
+        concurrent_guard _g(*this);
         return m_alloc.allocate(size);
     }
 
     void deallocate_node(ast * n, unsigned sz) {
+        concurrent_guard _g(*this);
         m_alloc.deallocate(sz, n);
     }
 
@@ -2007,6 +2081,7 @@ public:
     void mk(expr_array & r) { m_expr_array_manager.mk(r); }
     void del(expr_array & r) { m_expr_array_manager.del(r); }
     void copy(expr_array const & s, expr_array & r) { m_expr_array_manager.copy(s, r); }
+    bool is_shared(expr_array const & s, expr_array const & r) const { return m_expr_array_manager.is_shared(s, r); }
     unsigned size(expr_array const & r) const { return m_expr_array_manager.size(r); }
     bool empty(expr_array const & r) const { return m_expr_array_manager.empty(r); }
     expr * get(expr_array const & r, unsigned i) const { return m_expr_array_manager.get(r, i); }
@@ -2448,6 +2523,34 @@ public:
     void reset() { m_marked.reset(); }
 };
 
+/**
+   \brief Marks nodes using the visit epoch of the manager, so neither marking
+   nor reset touch a table. If the epoch is taken by an enclosing traversal,
+   the marks are kept in an expr_mark instead.
+*/
+class expr_epoch_mark {
+    ast_manager & m;
+    unsigned      m_epoch;
+    expr_mark     m_fallback;
+public:
+    expr_epoch_mark(ast_manager & m): m(m), m_epoch(m.acquire_epoch()) {}
+    ~expr_epoch_mark() { if (m_epoch) m.release_epoch(); }
+    bool is_marked(expr * n) const { return m_epoch ? n->m_epoch == m_epoch : m_fallback.is_marked(n); }
+    void mark(expr * n) { if (m_epoch) n->m_epoch = m_epoch; else m_fallback.mark(n, true); }
+    void mark(expr * n, bool flag) {
+        if (!m_epoch) m_fallback.mark(n, flag);
+        else if (flag) n->m_epoch = m_epoch;
+        else if (n->m_epoch == m_epoch) n->m_epoch = 0;
+    }
+    void reset() {
+        if (m_epoch) {
+            m.release_epoch();
+            m_epoch = m.acquire_epoch();
+        }
+        m_fallback.reset();
+    }
+};
+
 template<unsigned IDX>
 class ast_fast_mark {
     ptr_buffer<ast> m_to_unmark;
@@ -0,0 +1,591 @@
+/*++
+Copyright (c) 2021 Microsoft Corporation
+
+Module Name:
+
+    ast_binary.cpp
+
+Abstract:
+
+    Compact binary serialization of expression DAGs.
+
+--*/
+
+#include "ast/ast_binary.h"
+#include "util/map.h"
+#include "util/common_msgs.h"
+#include <cstring>
+
+namespace {
+
+    const char     g_magic[4] = { 'Z', '3', 'B', 'N' };
+    const unsigned g_version = 1;
+
+    enum symbol_tag { SYM_NULL, SYM_NUM, SYM_STR };
+    enum sort_tag { SORT_UNINTERP, SORT_INFO, SORT_PLAIN };
+    enum size_tag { SIZE_FINITE, SIZE_VERY_BIG, SIZE_INFINITE };
+
+    class writer {
+        ast_manager&           m;
+        std::ostream&          m_out;
+        obj_map<ast, unsigned> m_node2idx;
+        ptr_vector<ast>        m_nodes;
+        ptr_vector<ast>        m_todo;
+        map<symbol, unsigned, symbol_hash_proc, symbol_eq_proc> m_sym2idx;
+        svector<symbol>        m_symbols;
+
+        void u8(unsigned char c) { m_out.put(c); }
+
+        void u32(unsigned n) {
+            char buf[4];
+            for (unsigned i = 0; i < 4; ++i, n >>= 8)
+                buf[i] = static_cast<char>(n & 0xFF);
+            m_out.write(buf, 4);
+        }
+
+        void u64(uint64_t n) {
+            u32(static_cast<unsigned>(n & 0xFFFFFFFF));
+            u32(static_cast<unsigned>(n >> 32));
+        }
+
+        void str(std::string const& s) {
+            u32(static_cast<unsigned>(s.size()));
+            m_out.write(s.data(), s.size());
+        }
+
+        void sym(symbol const& s) { u32(m_sym2idx[s]); }
+
+        void node(ast* n) { u32(m_node2idx[n]); }
+
+        void add_symbol(symbol const& s) {
+            if (!m_sym2idx.contains(s)) {
+                m_sym2idx.insert(s, m_symbols.size());
+                m_symbols.push_back(s);
+            }
+        }
+
+        void push(ast* n) {
+            if (!m_node2idx.contains(n))
+                m_todo.push_back(n);
+        }
+
+        void push_params(decl_info const* info) {
+            if (!info)
+                return;
+            for (parameter const& p : info->parameters()) {
+                if (p.is_ast())
+                    push(p.get_ast());
+                else if (p.is_symbol())
+                    add_symbol(p.get_symbol());
+                else if (p.is_external())
+                    throw default_exception("binary serialization does not support external parameters, used by " + m.get_family_name(info->get_family_id()).str());
+            }
+        }
+
+        void check_family(family_id fid) {
+            if (fid == null_family_id)
+                return;
+            symbol const& name = m.get_family_name(fid);
+            if (name == "datatype" || name == "recfun")
+                throw default_exception("binary serialization does not support declarations from " + name.str());
+            add_symbol(name);
+        }
+
+        void push_children(ast* n) {
+            switch (n->get_kind()) {
+            case AST_SORT: {
+                sort* s = to_sort(n);
+                add_symbol(s->get_name());
+                if (s->get_info()) {
+                    check_family(s->get_family_id());
+                    push_params(s->get_info());
+                }
+                break;
+            }
+            case AST_FUNC_DECL: {
+                func_decl* f = to_func_decl(n);
+                add_symbol(f->get_name());
+                if (f->get_info()) {
+                    if (f->get_info()->is_lambda())
+                        throw default_exception("binary serialization does not support lambda definitions");
+                    check_family(f->get_family_id());
+                    push_params(f->get_info());
+                }
+                for (sort* s : *f)
+                    push(s);
+                push(f->get_range());
+                break;
+            }
+            case AST_APP:
+                push(to_app(n)->get_decl());
+                for (expr* arg : *to_app(n))
+                    push(arg);
+                break;
+            case AST_VAR:
+                push(to_var(n)->get_sort());
+                break;
+            case AST_QUANTIFIER: {
+                quantifier* q = to_quantifier(n);
+                for (unsigned i = 0; i < q->get_num_decls(); ++i) {
+                    add_symbol(q->get_decl_name(i));
+                    push(q->get_decl_sort(i));
+                }
+                add_symbol(q->get_qid());
+                add_symbol(q->get_skid());
+                push(q->get_expr());
+                for (unsigned i = 0; i < q->get_num_patterns(); ++i)
+                    push(q->get_pattern(i));
+                for (unsigned i = 0; i < q->get_num_no_patterns(); ++i)
+                    push(q->get_no_pattern(i));
+                break;
+            }
+            default:
+                UNREACHABLE();
+            }
+        }
+
+        void collect(ast* root) {
+            push(root);
+            while (!m_todo.empty()) {
+                ast* n = m_todo.back();
+                if (m_node2idx.contains(n)) {
+                    m_todo.pop_back();
+                    continue;
+                }
+                unsigned sz = m_todo.size();
+                push_children(n);
+                if (sz == m_todo.size()) {
+                    m_todo.pop_back();
+                    m_node2idx.insert(n, m_nodes.size());
+                    m_nodes.push_back(n);
+                }
+            }
+        }
+
+        void write_symbol(symbol const& s) {
+            if (s == symbol::null)
+                u8(SYM_NULL);
+            else if (s.is_numerical()) {
+                u8(SYM_NUM);
+                u32(s.get_num());
+            }
+            else {
+                u8(SYM_STR);
+                str(s.str());
+            }
+        }
+
+        void write_params(decl_info const& info) {
+            u32(info.get_num_parameters());
+            for (parameter const& p : info.parameters()) {
+                u8(p.get_kind());
+                switch (p.get_kind()) {
+                case parameter::PARAM_INT: u32(static_cast<unsigned>(p.get_int())); break;
+                case parameter::PARAM_AST: node(p.get_ast()); break;
+                case parameter::PARAM_SYMBOL: sym(p.get_symbol()); break;
+                case parameter::PARAM_ZSTRING: str(p.get_zstring().encode()); break;
+                case parameter::PARAM_RATIONAL: str(p.get_rational().to_string()); break;
+                case parameter::PARAM_DOUBLE: {
+                    double d = p.get_double();
+                    uint64_t bits;
+                    memcpy(&bits, &d, sizeof(bits));
+                    u64(bits);
+                    break;
+                }
+                default:
+                    UNREACHABLE();
+                }
+            }
+        }
+
+        void write_sort(sort* s) {
+            sort_info* info = s->get_info();
+            if (!info) {
+                u8(SORT_PLAIN);
+                sym(s->get_name());
+            }
+            else if (info->get_family_id() == user_sort_family_id) {
+                u8(SORT_UNINTERP);
+                sym(s->get_name());
+                write_params(*info);
+            }
+            else {
+                u8(SORT_INFO);
+                sym(s->get_name());
+                sym(m.get_family_name(info->get_family_id()));
+                u32(static_cast<unsigned>(info->get_decl_kind()));
+                sort_size const& sz = info->get_num_elements();
+                if (sz.is_finite()) {
+                    u8(SIZE_FINITE);
+                    u64(sz.size());
+                }
+                else
+                    u8(sz.is_very_big() ? SIZE_VERY_BIG : SIZE_INFINITE);
+                u8(info->private_parameters());
+                write_params(*info);
+            }
+        }
+
+        void write_func_decl(func_decl* f) {
+            sym(f->get_name());
+            func_decl_info* info = f->get_info();
+            u8(info != nullptr);
+            if (info) {
+                bool interp = info->get_family_id() != null_family_id;
+                u8(interp);
+                if (interp) {
+                    sym(m.get_family_name(info->get_family_id()));
+                    u32(static_cast<unsigned>(info->get_decl_kind()));
+                }
+                unsigned flags =
+                    (info->is_left_associative() ? 1 : 0) |
+                    (info->is_right_associative() ? 2 : 0) |
+                    (info->is_flat_associative() ? 4 : 0) |
+                    (info->is_commutative() ? 8 : 0) |
+                    (info->is_chainable() ? 16 : 0) |
+                    (info->is_pairwise() ? 32 : 0) |
+                    (info->is_injective() ? 64 : 0) |
+                    (info->is_idempotent() ? 128 : 0) |
+                    (info->is_skolem() ? 256 : 0);
+                u32(flags);
+                write_params(*info);
+            }
+            u32(f->get_arity());
+            for (sort* s : *f)
+                node(s);
+            node(f->get_range());
+        }
+
+        void write_node(ast* n) {
+            u8(n->get_kind());
+            switch (n->get_kind()) {
+            case AST_SORT:
+                write_sort(to_sort(n));
+                break;
+            case AST_FUNC_DECL:
+                write_func_decl(to_func_decl(n));
+                break;
+            case AST_APP:
+                node(to_app(n)->get_decl());
+                u32(to_app(n)->get_num_args());
+                for (expr* arg : *to_app(n))
+                    node(arg);
+                break;
+            case AST_VAR:
+                u32(to_var(n)->get_idx());
+                node(to_var(n)->get_sort());
+                break;
+            case AST_QUANTIFIER: {
+                quantifier* q = to_quantifier(n);
+                u8(q->get_kind());
+                u32(q->get_num_decls());
+                for (unsigned i = 0; i < q->get_num_decls(); ++i) {
+                    sym(q->get_decl_name(i));
+                    node(q->get_decl_sort(i));
+                }
+                node(q->get_expr());
+                u32(static_cast<unsigned>(q->get_weight()));
+                sym(q->get_qid());
+                sym(q->get_skid());
+                u32(q->get_num_patterns());
+                for (unsigned i = 0; i < q->get_num_patterns(); ++i)
+                    node(q->get_pattern(i));
+                u32(q->get_num_no_patterns());
+                for (unsigned i = 0; i < q->get_num_no_patterns(); ++i)
+                    node(q->get_no_pattern(i));
+                break;
+            }
+            default:
+                UNREACHABLE();
+            }
+        }
+
+    public:
+        writer(ast_manager& m, std::ostream& out): m(m), m_out(out) {}
+
+        void operator()(unsigned num_roots, expr* const* roots) {
+            for (unsigned i = 0; i < num_roots; ++i)
+                collect(roots[i]);
+            m_out.write(g_magic, 4);
+            u32(g_version);
+            u32(m_symbols.size());
+            for (symbol const& s : m_symbols)
+                write_symbol(s);
+            u32(m_nodes.size());
+            for (ast* n : m_nodes)
+                write_node(n);
+            u32(num_roots);
+            for (unsigned i = 0; i < num_roots; ++i)
+                node(roots[i]);
+        }
+    };
+
+    class reader {
+        ast_manager&    m;
+        char const*     m_data;
+        size_t          m_size;
+        size_t          m_pos { 0 };
+        svector<symbol> m_symbols;
+        ast_ref_vector  m_nodes;
+
+        void fail(char const* msg) {
+            throw default_exception(std::string("invalid binary input: ") + msg);
+        }
+
+        void ensure(size_t n) {
+            if (m_pos + n > m_size)
+                fail("unexpected end of input");
+        }
+
+        unsigned char u8() {
+            ensure(1);
+            return static_cast<unsigned char>(m_data[m_pos++]);
+        }
+
+        unsigned u32() {
+            ensure(4);
+            unsigned n = 0;
+            for (unsigned i = 4; i-- > 0; )
+                n = (n << 8) | static_cast<unsigned char>(m_data[m_pos + i]);
+            m_pos += 4;
+            return n;
+        }
+
+        uint64_t u64() {
+            uint64_t lo = u32();
+            uint64_t hi = u32();
+            return lo | (hi << 32);
+        }
+
+        std::string str() {
+            unsigned n = u32();
+            ensure(n);
+            std::string s(m_data + m_pos, n);
+            m_pos += n;
+            return s;
+        }
+
+        symbol const& sym() {
+            unsigned idx = u32();
+            if (idx >= m_symbols.size())
+                fail("symbol index out of range");
+            return m_symbols[idx];
+        }
+
+        ast* node() {
+            unsigned idx = u32();
+            if (idx >= m_nodes.size())
+                fail("node index out of range");
+            return m_nodes.get(idx);
+        }
+
+        sort* sort_node() {
+            ast* n = node();
+            if (!is_sort(n))
+                fail("expected sort");
+            return to_sort(n);
+        }
+
+        expr* expr_node() {
+            ast* n = node();
+            if (!is_expr(n))
+                fail("expected expression");
+            return to_expr(n);
+        }
+
+        family_id family() {
+            symbol const& name = sym();
+            family_id fid = m.mk_family_id(name);
+            if (!m.has_plugin(fid))
+                fail("unknown family");
+            return fid;
+        }
+
+        void read_symbol() {
+            switch (u8()) {
+            case SYM_NULL: m_symbols.push_back(symbol::null); break;
+            case SYM_NUM: m_symbols.push_back(symbol(u32())); break;
+            case SYM_STR: m_symbols.push_back(symbol(str().c_str())); break;
+            default: fail("unknown symbol tag");
+            }
+        }
+
+        void read_params(vector<parameter>& ps) {
+            unsigned n = u32();
+            for (unsigned i = 0; i < n; ++i) {
+                switch (u8()) {
+                case parameter::PARAM_INT: ps.push_back(parameter(static_cast<int>(u32()))); break;
+                case parameter::PARAM_AST: ps.push_back(parameter(node())); break;
+                case parameter::PARAM_SYMBOL: ps.push_back(parameter(sym())); break;
+                case parameter::PARAM_ZSTRING: ps.push_back(parameter(zstring(str().c_str()))); break;
+                case parameter::PARAM_RATIONAL: ps.push_back(parameter(rational(str().c_str()))); break;
+                case parameter::PARAM_DOUBLE: {
+                    uint64_t bits = u64();
+                    double d;
+                    memcpy(&d, &bits, sizeof(d));
+                    ps.push_back(parameter(d));
+                    break;
+                }
+                default:
+                    fail("unknown parameter kind");
+                }
+            }
+        }
+
+        sort* read_sort() {
+            unsigned char tag = u8();
+            symbol name = sym();
+            vector<parameter> ps;
+            switch (tag) {
+            case SORT_PLAIN:
+                return m.mk_uninterpreted_sort(name);
+            case SORT_UNINTERP:
+                read_params(ps);
+                return m.mk_uninterpreted_sort(name, ps.size(), ps.data());
+            case SORT_INFO: {
+                family_id fid = family();
+                decl_kind k = static_cast<decl_kind>(u32());
+                sort_size sz;
+                switch (u8()) {
+                case SIZE_FINITE: sz = sort_size::mk_finite(u64()); break;
+                case SIZE_VERY_BIG: sz = sort_size::mk_very_big(); break;
+                default: sz = sort_size::mk_infinite(); break;
+                }
+                bool private_params = u8() != 0;
+                read_params(ps);
+                return m.mk_sort(name, sort_info(fid, k, sz, ps.size(), ps.data(), private_params));
+            }
+            default:
+                fail("unknown sort tag");
+                return nullptr;
+            }
+        }
+
+        func_decl* read_func_decl() {
+            symbol name = sym();
+            bool has_info = u8() != 0;
+            family_id fid = null_family_id;
+            decl_kind k = null_decl_kind;
+            unsigned flags = 0;
+            vector<parameter> ps;
+            if (has_info) {
+                if (u8() != 0) {
+                    fid = family();
+                    k = static_cast<decl_kind>(u32());
+                }
+                flags = u32();
+                read_params(ps);
+            }
+            unsigned arity = u32();
+            ptr_buffer<sort> domain;
+            for (unsigned i = 0; i < arity; ++i)
+                domain.push_back(sort_node());
+            sort* range = sort_node();
+            if (!has_info)
+                return m.mk_func_decl(name, arity, domain.data(), range);
+            func_decl_info info(fid, k, ps.size(), ps.data());
+            info.set_left_associative((flags & 1) != 0);
+            info.set_right_associative((flags & 2) != 0);
+            info.set_flat_associative((flags & 4) != 0);
+            info.set_commutative((flags & 8) != 0);
+            info.set_chainable((flags & 16) != 0);
+            info.set_pairwise((flags & 32) != 0);
+            info.set_injective((flags & 64) != 0);
+            info.set_idempotent((flags & 128) != 0);
+            info.set_skolem((flags & 256) != 0);
+            return m.mk_func_decl(name, arity, domain.data(), range, info);
+        }
+
+        ast* read_node() {
+            switch (u8()) {
+            case AST_SORT:
+                return read_sort();
+            case AST_FUNC_DECL:
+                return read_func_decl();
+            case AST_APP: {
+                ast* d = node();
+                if (!is_func_decl(d))
+                    fail("expected declaration");
+                unsigned n = u32();
+                ptr_buffer<expr> args;
+                for (unsigned i = 0; i < n; ++i)
+                    args.push_back(expr_node());
+                return m.mk_app(to_func_decl(d), n, args.data());
+            }
+            case AST_VAR: {
+                unsigned idx = u32();
+                return m.mk_var(idx, sort_node());
+            }
+            case AST_QUANTIFIER: {
+                quantifier_kind k = static_cast<quantifier_kind>(u8());
+                unsigned n = u32();
+                buffer<symbol> names;
+                ptr_buffer<sort> sorts;
+                for (unsigned i = 0; i < n; ++i) {
+                    names.push_back(sym());
+                    sorts.push_back(sort_node());
+                }
+                expr* body = expr_node();
+                int weight = static_cast<int>(u32());
+                symbol qid = sym();
+                symbol skid = sym();
+                ptr_buffer<expr> patterns, no_patterns;
+                unsigned np = u32();
+                for (unsigned i = 0; i < np; ++i)
+                    patterns.push_back(expr_node());
+                unsigned nnp = u32();
+                for (unsigned i = 0; i < nnp; ++i)
+                    no_patterns.push_back(expr_node());
+                if (k == lambda_k)
+                    return m.mk_lambda(n, sorts.data(), names.data(), body);
+                if (k != forall_k && k != exists_k)
+                    fail("unknown quantifier kind");
+                return m.mk_quantifier(k, n, sorts.data(), names.data(), body, weight, qid, skid,
+                                       np, patterns.data(), nnp, no_patterns.data());
+            }
+            default:
+                fail("unknown node kind");
+                return nullptr;
+            }
+        }
+
+    public:
+        reader(ast_manager& m, char const* data, size_t size): m(m), m_data(data), m_size(size), m_nodes(m) {}
+
+        void operator()(expr_ref_vector& roots) {
+            ensure(4);
+            if (memcmp(m_data, g_magic, 4) != 0)
+                fail("bad magic");
+            m_pos = 4;
+            if (u32() != g_version)
+                fail("unsupported version");
+            unsigned num_symbols = u32();
+            for (unsigned i = 0; i < num_symbols; ++i)
+                read_symbol();
+            unsigned num_nodes = u32();
+            for (unsigned i = 0; i < num_nodes; ++i) {
+                if (!m.inc())
+                    throw default_exception(Z3_CANCELED_MSG);
+                m_nodes.push_back(read_node());
+            }
+            unsigned num_roots = u32();
+            for (unsigned i = 0; i < num_roots; ++i)
+                roots.push_back(expr_node());
+        }
+    };
+}
+
+void ast_to_binary(ast_manager& m, unsigned num_roots, expr* const* roots, std::ostream& out) {
+    writer w(m, out);
+    w(num_roots, roots);
+}
+
+void ast_from_binary(ast_manager& m, char const* data, size_t size, expr_ref_vector& roots) {
+    reader r(m, data, size);
+    r(roots);
+}
+
+void ast_from_binary(ast_manager& m, std::istream& in, expr_ref_vector& roots) {
+    std::string buffer((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    ast_from_binary(m, buffer.data(), buffer.size(), roots);
+}
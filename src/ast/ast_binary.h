@@ -0,0 +1,47 @@
+/*++
+Copyright (c) 2021 Microsoft Corporation
+
+Module Name:
+
+    ast_binary.h
+
+Abstract:
+
+    Compact binary serialization of expression DAGs.
+
+    The format is a single contiguous buffer that can be loaded from a
+    memory mapped file:
+
+      header      magic "Z3BN", format version
+      symbols     table of symbols used as names, families and quantifier ids
+      nodes       sorts, declarations and expressions in topological order,
+                  every node refers to its children by their position in the table
+      roots       positions of the serialized root expressions
+
+    All integers are stored as little-endian 32 bit words (64 bits for sort sizes
+    and doubles). Families are stored by name, so a buffer can be loaded into any
+    ast_manager that has the corresponding plugins installed.
+
+    Declarations that depend on plugin state that is not part of the DAG
+    (datatypes, recursive functions, plugin-specific external parameters and
+    lambda definitions) are not supported and raise an exception.
+
+--*/
+#pragma once
+
+#include "ast/ast.h"
+#include <iostream>
+
+void ast_to_binary(ast_manager& m, unsigned num_roots, expr* const* roots, std::ostream& out);
+
+inline void ast_to_binary(ast_manager& m, expr_ref_vector const& roots, std::ostream& out) {
+    ast_to_binary(m, roots.size(), roots.data(), out);
+}
+
+/**
+   \brief load roots from a buffer produced by ast_to_binary.
+   Throws default_exception if the buffer is malformed.
+*/
+void ast_from_binary(ast_manager& m, char const* data, size_t size, expr_ref_vector& roots);
+
+void ast_from_binary(ast_manager& m, std::istream& in, expr_ref_vector& roots);
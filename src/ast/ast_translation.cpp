@@ -24,6 +24,9 @@ Revision History:
 #include "ast/ast_translation.h"
 #include "ast/ast_ll_pp.h"
 #include "ast/ast_pp.h"
+#ifndef SINGLE_THREAD
+#include "util/thread_pool.h"
+#endif
 
 ast_translation::~ast_translation() {
     reset_cache();
@@ -39,7 +42,8 @@ void ast_translation::cleanup() {
 
 void ast_translation::reset_cache() {
     for (auto & kv : m_cache) {
-        m_from_manager.dec_ref(kv.m_key);
+        if (m_pin_source)
+            m_from_manager.dec_ref(kv.m_key);
         m_to_manager.dec_ref(kv.m_value);
     }
     m_cache.reset();
@@ -48,7 +52,8 @@ void ast_translation::reset_cache() {
 void ast_translation::cache(ast * s, ast * t) {
     SASSERT(!m_cache.contains(s));
     if (s->get_ref_count() > 1) {
-        m_from_manager.inc_ref(s);
+        if (m_pin_source)
+            m_from_manager.inc_ref(s);
         m_to_manager.inc_ref(t);
         m_cache.insert(s, t);
         ++m_insert_count;
@@ -339,6 +344,53 @@ ast * ast_translation::process(ast const * _n) {
     return r;
 }
 
+void translate_parallel(ast_manager & from, expr_ref_vector const & src, ptr_vector<ast_manager> const & to, vector<expr_ref_vector> & dst) {
+    dst.reset();
+    for (ast_manager* m : to)
+        dst.push_back(expr_ref_vector(*m));
+    // plugins and fresh ids are copied up front: they are shared state of the source.
+    for (ast_manager* m : to) {
+        if (m != &from) {
+            m->copy_families_plugins(from);
+            m->update_fresh_id(from);
+        }
+    }
+    auto worker = [&](unsigned i) {
+        ast_translation tr(from, *to[i], false);
+        tr.set_pin_source(false);
+        expr_ref_vector & r = dst[i];
+        for (expr* e : src)
+            r.push_back(tr(e));
+    };
+#ifdef SINGLE_THREAD
+    for (unsigned i = 0; i < to.size(); ++i)
+        worker(i);
+#else
+    if (to.size() <= 1) {
+        for (unsigned i = 0; i < to.size(); ++i)
+            worker(i);
+        return;
+    }
+    vector<std::string> ex_msgs(to.size(), std::string());
+    svector<bool> has_exception(to.size(), false);
+    thread_pool threads;
+    for (unsigned i = 0; i < to.size(); ++i)
+        threads.run([&, i]() {
+            try {
+                worker(i);
+            }
+            catch (z3_exception& ex) {
+                ex_msgs[i] = ex.msg();
+                has_exception[i] = true;
+            }
+        });
+    threads.join();
+    for (unsigned i = 0; i < to.size(); ++i)
+        if (has_exception[i])
+            throw default_exception(std::move(ex_msgs[i]));
+#endif
+}
+
 expr_dependency * expr_dependency_translation::operator()(expr_dependency * d) {
     if (d == nullptr)
         return d;
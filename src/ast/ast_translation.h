@@ -41,6 +41,7 @@ class ast_translation {
     unsigned            m_miss_count;
     unsigned            m_insert_count;
     unsigned            m_num_process;
+    bool                m_pin_source;
 
     void cache(ast * s, ast * t);
     void collect_decl_extra_children(decl * d);
@@ -59,6 +60,7 @@ public:
         m_miss_count = 0;
         m_insert_count = 0;
         m_num_process = 0;
+        m_pin_source = true;
         if (&from != &to) {
             if (copy_plugins)
                 m_to_manager.copy_families_plugins(m_from_manager);
@@ -95,6 +97,14 @@ public:
 
     void reset_cache();
     void cleanup();
+
+    /**
+       \brief When pinning is disabled, the cache does not increment the reference
+       counts of the source terms. The source manager is then only read, so several
+       translations from the same source may run concurrently into distinct targets.
+       The caller must keep the source terms alive while the cache is in use.
+    */
+    void set_pin_source(bool f) { SASSERT(m_cache.empty()); m_pin_source = f; }
     
     unsigned loop_count() const { return m_loop_count; }
     unsigned hit_count() const { return m_hit_count; }
@@ -113,6 +123,13 @@ inline expr * translate(expr const * e, ast_manager & from, ast_manager & to) {
 }
 
 
+/**
+   \brief Translate src into each of the managers in to, such that dst[i] is the
+   translation into to[i]. The translations run concurrently, one per target.
+   The source manager is not modified while they run.
+*/
+void translate_parallel(ast_manager & from, expr_ref_vector const & src, ptr_vector<ast_manager> const & to, vector<expr_ref_vector> & dst);
+
 class expr_dependency_translation {
     ast_translation & m_translation;
     ptr_vector<expr>  m_buffer;
@@ -318,6 +318,7 @@ namespace euf {
         }
         num_scopes -= m_num_scopes;
         m_num_scopes = 0;
+        SASSERT(m_to_rebuild.empty());
 
         SASSERT(m_new_lits_qhead <= m_new_lits.size());
         unsigned old_lim = m_scopes.size() - num_scopes;
@@ -435,7 +436,7 @@ namespace euf {
 
         if (j.is_congruence() && (m.is_false(r2->get_expr()) || m.is_true(r2->get_expr())))
             add_literal(n1, false);
-        if (n1->is_equality() && n1->value() == l_false)
+        if (!m_in_batch && n1->is_equality() && n1->value() == l_false)
             new_diseq(n1);
         remove_parents(r1, r2);
         push_eq(r1, n1, r2->num_parents());
@@ -444,6 +445,10 @@ namespace euf {
             c->m_root = r2;
         std::swap(r1->m_next, r2->m_next);
         r2->inc_class_size(r1->class_size());   
+        if (m_in_batch) {
+            m_to_rebuild.push_back(std::make_pair(r1, n1));
+            return;
+        }
         merge_th_eq(r1, r2);
         reinsert_parents(r1, r2);
         if (m_on_merge)
@@ -491,6 +496,25 @@ namespace euf {
         }
     }
 
+    /**
+       \brief complete the merges deferred in batch mode, in the order they were made.
+       The parents of each old root are re-inserted under the current root of its class.
+    */
+    void egraph::rebuild() {
+        for (unsigned i = 0; i < m_to_rebuild.size(); ++i) {
+            auto [r1, n1] = m_to_rebuild[i];
+            enode* r2 = r1->get_root();
+            ++m_stats.m_num_rebuilds;
+            if (n1->is_equality() && n1->value() == l_false)
+                new_diseq(n1);
+            merge_th_eq(r1, r2);
+            reinsert_parents(r1, r2);
+            if (m_on_merge)
+                m_on_merge(r2, r1);
+        }
+        m_to_rebuild.reset();
+    }
+
     void egraph::merge_th_eq(enode* n, enode* root) {
         SASSERT(n != root);
         for (auto iv : enode_th_vars(n)) {
@@ -523,6 +547,13 @@ namespace euf {
                 erase_from_table(p);
         }
 
+        // with deferred rebuilding, a parent of r1 may have been re-inserted
+        // by undoing a later merge without being recorded among the parents of r2.
+        if (m_batch_merge) 
+            for (enode* p : enode_parents(r1))
+                if (p->merge_enabled() && m_table.contains_ptr(p))
+                    erase_from_table(p);
+
         for (enode* c : enode_class(r1))
             c->m_root = r1;
 
@@ -538,10 +569,16 @@ namespace euf {
         SASSERT(m_new_lits_qhead <= m_new_lits.size());
         SASSERT(m_num_scopes == 0 || m_to_merge.empty());
         force_push();
-        for (unsigned i = 0; i < m_to_merge.size() && m.limit().inc() && !inconsistent(); ++i) {
-            auto const& w = m_to_merge[i];
-            merge(w.a, w.b, justification::congruence(w.commutativity));                
+        flet<bool> _in_batch(m_in_batch, m_batch_merge);
+        do {
+            for (unsigned i = 0; i < m_to_merge.size() && m.limit().inc() && !inconsistent(); ++i) {
+                auto const& w = m_to_merge[i];
+                merge(w.a, w.b, justification::congruence(w.commutativity));                
+            }
+            m_to_merge.reset();
+            rebuild();
         }
+        while (!m_to_merge.empty() && !inconsistent());
         m_to_merge.reset();
         return 
             (m_new_lits_qhead < m_new_lits.size()) || 
@@ -806,6 +843,8 @@ namespace euf {
         st.update("euf propagations theory eqs", m_stats.m_num_th_eqs);
         st.update("euf propagations theory diseqs", m_stats.m_num_th_diseqs);
         st.update("euf propagations literal", m_stats.m_num_lits);
+        if (m_batch_merge)
+            st.update("euf rebuilds", m_stats.m_num_rebuilds);
     }
 
     void egraph::copy_from(egraph const& src, std::function<void*(void*)>& copy_justification) {
@@ -89,6 +89,7 @@ namespace euf {
             unsigned m_num_lits;
             unsigned m_num_eqs;
             unsigned m_num_conflicts;
+            unsigned m_num_rebuilds;
             stats() { reset(); }
             void reset() { memset(this, 0, sizeof(*this)); }
         };
@@ -154,6 +155,9 @@ namespace euf {
         };
         ast_manager&           m;
         svector<to_merge>      m_to_merge;
+        svector<std::pair<enode*, enode*>> m_to_rebuild; // old root and node of merges waiting for rebuild
+        bool                   m_batch_merge = false;
+        bool                   m_in_batch = false;
         etable                 m_table;
         region                 m_region;
         svector<update_record> m_updates;
@@ -206,6 +210,7 @@ namespace euf {
         void merge_th_eq(enode* n, enode* root);
         void merge_justification(enode* n1, enode* n2, justification j);
         void reinsert_parents(enode* r1, enode* r2);
+        void rebuild();
         void remove_parents(enode* r1, enode* r2);
         void unmerge_justification(enode* n1);
         void reinsert_equality(enode* p);
@@ -293,6 +298,14 @@ namespace euf {
         void set_value(enode* n, lbool value);
         void set_bool_var(enode* n, unsigned v) { n->set_bool_var(v); }
 
+        /**
+           \brief when enabled, congruence merges found by propagate are performed in rounds.
+           The classes are united immediately, while re-inserting parents in the table,
+           theory variable merges and the merge callback are deferred to the end of the round.
+           A parent with arguments in several merged classes is then re-inserted once.
+        */
+        void set_batch_merge(bool f) { m_batch_merge = f; }
+
         void set_on_merge(std::function<void(enode* root,enode* other)>& on_merge) { m_on_merge = on_merge; }
         void set_on_make(std::function<void(enode* n)>& on_make) { m_on_make = on_make; }
         void set_used_eq(std::function<void(expr*,expr*,expr*)>& used_eq) { m_used_eq = used_eq; }
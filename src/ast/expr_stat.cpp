@@ -60,29 +60,6 @@ void get_expr_stat(expr * n, expr_stat & r) {
 }
 
 unsigned get_symbol_count(expr * n) {
-    unsigned r = 0;
-    ptr_buffer<expr> todo;
-    todo.push_back(n);
-    while (!todo.empty()) {
-        n = todo.back();
-        unsigned j;
-        todo.pop_back();
-        r++;
-        switch (n->get_kind()) {
-        case AST_APP:
-            j = to_app(n)->get_num_args();
-            while (j > 0) {
-                --j;
-                todo.push_back(to_app(n)->get_arg(j));
-            }
-            break;
-        case AST_QUANTIFIER:
-            todo.push_back(to_quantifier(n)->get_expr());
-            break;
-        default:
-            break;
-        }
-    }
-    return r;
+    return get_tree_size(n);
 }
 
@@ -134,11 +134,17 @@ void for_each_expr(ForEachProc & proc, unsigned n, expr * const* es) {
         for_each_expr_core<ForEachProc, expr_mark, false, false>(proc, visited, es[i]);
 }
 
+template<typename ForEachProc>
+void for_each_expr(ForEachProc & proc, ast_manager & m, expr * n) {
+    expr_epoch_mark visited(m);
+    for_each_expr_core<ForEachProc, expr_epoch_mark, false, false>(proc, visited, n);
+}
+
 template<typename ForEachProc>
 void for_each_expr(ForEachProc & proc, expr_ref_vector const& es) {
-    expr_mark visited;
+    expr_epoch_mark visited(es.get_manager());
     for (expr* e : es) 
-        for_each_expr_core<ForEachProc, expr_mark, false, false>(proc, visited, e);
+        for_each_expr_core<ForEachProc, expr_epoch_mark, false, false>(proc, visited, e);
 }
 
 template<typename ForEachProc>
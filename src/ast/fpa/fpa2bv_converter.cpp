@@ -4259,6 +4259,99 @@ func_decl * fpa2bv_converter::mk_bv_uf(func_decl * f, sort * const * domain, sor
     return res;
 }
 
+fpa2bv_converter_wrapped::~fpa2bv_converter_wrapped() {
+    for (auto const& kv : m_op2lazy) {
+        m.dec_ref(kv.m_key);
+        m.dec_ref(kv.m_value);
+    }
+}
+
+void fpa2bv_converter_wrapped::mk_lazy(func_decl* f, unsigned num, expr* const* args, expr_ref& result) {
+    sort* s = f->get_range();
+    unsigned ebits = m_util.get_ebits(s);
+    unsigned sbits = m_util.get_sbits(s);
+    unsigned bv_sz = ebits + sbits;
+    func_decl* bv_f = nullptr;
+    if (!m_op2lazy.find(f, bv_f)) {
+        bv_f = m.mk_fresh_func_decl(f->get_name(), symbol::null, f->get_arity(), f->get_domain(), m_bv_util.mk_sort(bv_sz));
+        m.inc_ref(f);
+        m.inc_ref(bv_f);
+        m_op2lazy.insert(f, bv_f);
+        m_lazy2op.insert(bv_f, f);
+    }
+    app_ref bv_app(m.mk_app(bv_f, num, args), m);
+    result = m_util.mk_fp(m_bv_util.mk_extract(bv_sz - 1, bv_sz - 1, bv_app),
+                          m_bv_util.mk_extract(bv_sz - 2, sbits - 1, bv_app),
+                          m_bv_util.mk_extract(sbits - 2, 0, bv_app));
+}
+
+void fpa2bv_converter_wrapped::mk_div(func_decl* f, unsigned num, expr* const* args, expr_ref& result) {
+    if (m_lazy)
+        mk_lazy(f, num, args, result);
+    else
+        fpa2bv_converter::mk_div(f, num, args, result);
+}
+
+void fpa2bv_converter_wrapped::mk_rem(func_decl* f, unsigned num, expr* const* args, expr_ref& result) {
+    if (m_lazy)
+        mk_lazy(f, num, args, result);
+    else
+        fpa2bv_converter::mk_rem(f, num, args, result);
+}
+
+void fpa2bv_converter_wrapped::mk_fma(func_decl* f, unsigned num, expr* const* args, expr_ref& result) {
+    if (m_lazy)
+        mk_lazy(f, num, args, result);
+    else
+        fpa2bv_converter::mk_fma(f, num, args, result);
+}
+
+void fpa2bv_converter_wrapped::mk_sqrt(func_decl* f, unsigned num, expr* const* args, expr_ref& result) {
+    if (m_lazy)
+        mk_lazy(f, num, args, result);
+    else
+        fpa2bv_converter::mk_sqrt(f, num, args, result);
+}
+
+func_decl* fpa2bv_converter_wrapped::get_lazy_op(expr* e) const {
+    func_decl* f = nullptr;
+    if (is_app(e) && m_lazy2op.find(to_app(e)->get_decl(), f))
+        return f;
+    return nullptr;
+}
+
+bool fpa2bv_converter_wrapped::blast_lazy(app* e, expr_ref& result) {
+    func_decl* f = get_lazy_op(e);
+    SASSERT(f);
+    // the rewriter may have folded arguments into numerals,
+    // the bit-blasters expect them in the form bv2rm(b) and fp(s, e, g).
+    expr_ref_vector args(m);
+    scoped_mpf v(m_util.fm());
+    for (expr* arg : *e) {
+        expr_ref a(arg, m);
+        if (m_util.is_rm_numeral(arg))
+            mk_rounding_mode(to_app(arg)->get_decl_kind(), a);
+        else if (m_util.is_numeral(arg, v))
+            mk_numeral(arg->get_sort(), v, a);
+        else if (!m_util.is_bv2rm(arg) && !m_util.is_fp(arg))
+            return false;
+        args.push_back(a);
+    }
+    expr_ref r(m);
+    switch (f->get_decl_kind()) {
+    case OP_FPA_DIV: fpa2bv_converter::mk_div(f, args.size(), args.data(), r); break;
+    case OP_FPA_REM: fpa2bv_converter::mk_rem(f, args.size(), args.data(), r); break;
+    case OP_FPA_FMA: fpa2bv_converter::mk_fma(f, args.size(), args.data(), r); break;
+    case OP_FPA_SQRT: fpa2bv_converter::mk_sqrt(f, args.size(), args.data(), r); break;
+    default: UNREACHABLE(); return false;
+    }
+    expr_ref sgn(m), exp(m), sig(m);
+    split_fp(r, sgn, exp, sig);
+    expr* cargs[3] = { sgn, exp, sig };
+    result = m_bv_util.mk_concat(3, cargs);
+    return true;
+}
+
 void fpa2bv_converter_wrapped::mk_const(func_decl* f, expr_ref& result) {
     SASSERT(f->get_family_id() == null_family_id);
     SASSERT(f->get_arity() == 0);
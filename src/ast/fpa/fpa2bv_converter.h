@@ -101,11 +101,11 @@ public:
     void mk_sub(func_decl * f, unsigned num, expr * const * args, expr_ref & result);
     void mk_neg(func_decl * f, unsigned num, expr * const * args, expr_ref & result);
     void mk_mul(func_decl * f, unsigned num, expr * const * args, expr_ref & result);
-    void mk_div(func_decl * f, unsigned num, expr * const * args, expr_ref & result);
-    void mk_rem(func_decl * f, unsigned num, expr * const * args, expr_ref & result);
+    virtual void mk_div(func_decl * f, unsigned num, expr * const * args, expr_ref & result);
+    virtual void mk_rem(func_decl * f, unsigned num, expr * const * args, expr_ref & result);
     void mk_abs(func_decl * f, unsigned num, expr * const * args, expr_ref & result);
-    void mk_fma(func_decl * f, unsigned num, expr * const * args, expr_ref & result);
-    void mk_sqrt(func_decl * f, unsigned num, expr * const * args, expr_ref & result);
+    virtual void mk_fma(func_decl * f, unsigned num, expr * const * args, expr_ref & result);
+    virtual void mk_sqrt(func_decl * f, unsigned num, expr * const * args, expr_ref & result);
     void mk_round_to_integral(func_decl * f, unsigned num, expr * const * args, expr_ref & result);
     void mk_abs(sort * s, expr_ref & x, expr_ref & result);
 
@@ -232,17 +232,46 @@ private:
 
 class fpa2bv_converter_wrapped : public fpa2bv_converter {
     th_rewriter& m_rw;
+    // In lazy mode fp.div, fp.fma, fp.sqrt and fp.rem are replaced by applications
+    // of fresh bit-vector functions; the solver bit-blasts an occurrence only when
+    // its value in a candidate model is wrong (see blast_lazy).
+    bool                           m_lazy;
+    obj_map<func_decl, func_decl*> m_op2lazy;
+    obj_map<func_decl, func_decl*> m_lazy2op;
+
+    void mk_lazy(func_decl * f, unsigned num, expr * const * args, expr_ref & result);
+
  public:
 
     fpa2bv_converter_wrapped(ast_manager & m, th_rewriter& rw) :
         fpa2bv_converter(m),
-        m_rw(rw) {}
-    virtual ~fpa2bv_converter_wrapped() {}
+        m_rw(rw),
+        m_lazy(false) {}
+    virtual ~fpa2bv_converter_wrapped();
     void mk_const(func_decl * f, expr_ref & result) override;
     void mk_rm_const(func_decl * f, expr_ref & result) override;
+    void mk_div(func_decl * f, unsigned num, expr * const * args, expr_ref & result) override;
+    void mk_rem(func_decl * f, unsigned num, expr * const * args, expr_ref & result) override;
+    void mk_fma(func_decl * f, unsigned num, expr * const * args, expr_ref & result) override;
+    void mk_sqrt(func_decl * f, unsigned num, expr * const * args, expr_ref & result) override;
     app_ref wrap(expr * e);
     app_ref unwrap(expr * e, sort * s);
 
+    void set_lazy(bool f) { m_lazy = f; }
+    bool is_lazy() const { return m_lazy; }
+    bool has_lazy() const { return !m_lazy2op.empty(); }
+    /**
+       \brief Return the operation abstracted by the application e, or nullptr
+       if e is not an application of an abstraction function.
+    */
+    func_decl* get_lazy_op(expr* e) const;
+    /**
+       \brief Bit-blast the operation abstracted by e. The result is a bit-vector
+       term that equals e in every model of the semantics of the operation.
+       Side conditions are added to m_extra_assertions.
+    */
+    bool blast_lazy(app* e, expr_ref& result);
+
     expr* bv2rm_value(expr* b);
     expr* bv2fpa_value(sort* s, expr* a, expr* b = nullptr, expr* c = nullptr);
     
@@ -47,6 +47,8 @@ class contains_vars::imp {
                 m_contains = true;
             break;
         case AST_APP:
+            if (to_app(n)->is_ground())
+                break;
             j = to_app(n)->get_num_args();
             while (j > 0) {
                 --j;
@@ -100,6 +102,8 @@ bool contains_vars::operator()(expr* e) {
 }
 
 bool has_free_vars(expr * n) {
+    if (is_app(n) && to_app(n)->is_ground())
+        return false;
     contains_vars p;
     return p(n);
 }
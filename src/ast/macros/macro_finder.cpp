@@ -19,6 +19,7 @@ Revision History:
 
 #include "ast/macros/macro_finder.h"
 #include "ast/occurs.h"
+#include "ast/for_each_expr.h"
 #include "ast/ast_pp.h"
 #include "ast/ast_ll_pp.h"
 
@@ -266,12 +267,41 @@ macro_finder::macro_finder(ast_manager & m, macro_manager & mm):
     m(m),
     m_macro_manager(mm),
     m_util(mm.get_util()),
-    m_autil(m) {
+    m_autil(m),
+    m_examined_pinned(m) {
 }
 
 macro_finder::~macro_finder() {
 }
 
+namespace {
+    struct macro_occurs_proc {
+        struct found {};
+        macro_manager & m_macro_manager;
+        macro_occurs_proc(macro_manager & mm): m_macro_manager(mm) {}
+        void operator()(var * n) {}
+        void operator()(quantifier * n) {}
+        void operator()(app * n) { if (m_macro_manager.contains(n->get_decl())) throw found(); }
+    };
+}
+
+/**
+   \brief n was not a macro in the previous round, and it does not change
+   unless it contains a macro that was found after it was expanded.
+*/
+bool macro_finder::is_examined(expr * n) const {
+    if (!m_examined.contains(n))
+        return false;
+    macro_occurs_proc proc(m_macro_manager);
+    try {
+        for_each_expr(proc, n);
+    }
+    catch (const macro_occurs_proc::found &) {
+        return false;
+    }
+    return true;
+}
+
 bool macro_finder::expand_macros(expr_ref_vector const& exprs, proof_ref_vector const& prs, expr_dependency_ref_vector const& deps,  expr_ref_vector & new_exprs, proof_ref_vector & new_prs, expr_dependency_ref_vector & new_deps) {
     TRACE("macro_finder", tout << "starting expand_macros:\n";
           m_macro_manager.display(tout););
@@ -283,6 +313,14 @@ bool macro_finder::expand_macros(expr_ref_vector const& exprs, proof_ref_vector
         expr * n       = exprs[i];
         proof * pr     = m.proofs_enabled() ? prs[i] : nullptr;
         expr_dependency * dep = deps.get(i, nullptr);
+        if (is_examined(n)) {
+            new_exprs.push_back(n);
+            if (m.proofs_enabled())
+                new_prs.push_back(pr);
+            if (deps_valid)
+                new_deps.push_back(dep);
+            continue;
+        }
         expr_ref new_n(m), def(m);
         proof_ref new_pr(m);
         expr_dependency_ref new_dep(m);
@@ -302,6 +340,7 @@ bool macro_finder::expand_macros(expr_ref_vector const& exprs, proof_ref_vector
             found_new_macro = true;
         }
         else {
+            mark_examined(new_n);
             new_exprs.push_back(new_n);
             if (m.proofs_enabled())
                 new_prs.push_back(new_pr);
@@ -321,6 +360,7 @@ void macro_finder::operator()(expr_ref_vector const& exprs, proof_ref_vector con
     proof_ref_vector  _new_prs(m);
     expr_dependency_ref_vector _new_deps(m);
     unsigned num = exprs.size();
+    reset_examined();
     if (expand_macros(exprs, prs, deps, _new_exprs, _new_prs, _new_deps)) {
         for (unsigned i = 0; i < num; ++i) {
             expr_ref_vector  old_exprs(m);
@@ -337,6 +377,7 @@ void macro_finder::operator()(expr_ref_vector const& exprs, proof_ref_vector con
                 break;
         }
     }
+    reset_examined();
     new_exprs.append(_new_exprs);
     new_prs.append(_new_prs);
     new_deps.append(_new_deps);
@@ -351,6 +392,10 @@ bool macro_finder::expand_macros(unsigned num, justified_expr const * fmls, vect
     for (unsigned i = 0; i < num; i++) {
         expr * n       = fmls[i].get_fml();
         proof * pr     = m.proofs_enabled() ? fmls[i].get_proof() : nullptr;
+        if (is_examined(n)) {
+            new_fmls.push_back(fmls[i]);
+            continue;
+        }
         expr_ref new_n(m), def(m);
         proof_ref new_pr(m);
         expr_dependency_ref new_dep(m);
@@ -370,6 +415,7 @@ bool macro_finder::expand_macros(unsigned num, justified_expr const * fmls, vect
             found_new_macro = true;
         }
         else {
+            mark_examined(new_n);
             new_fmls.push_back(justified_expr(m, new_n, new_pr));
         }
     }
@@ -379,6 +425,7 @@ bool macro_finder::expand_macros(unsigned num, justified_expr const * fmls, vect
 void macro_finder::operator()(unsigned n, justified_expr const* fmls, vector<justified_expr>& new_fmls) {
     TRACE("macro_finder", tout << "processing macros...\n";);
     vector<justified_expr> _new_fmls;
+    reset_examined();
     if (expand_macros(n, fmls, _new_fmls)) {
         while (true) {
             vector<justified_expr> old_fmls;
@@ -388,6 +435,7 @@ void macro_finder::operator()(unsigned n, justified_expr const* fmls, vector<jus
                 break;
         }
     }
+    reset_examined();
     new_fmls.append(_new_fmls);
 }
 
@@ -30,6 +30,13 @@ class macro_finder {
     macro_manager &             m_macro_manager;
     macro_util &                m_util;
     arith_util                  m_autil;
+    // formulas of the previous round that are not macros.
+    // They are only examined again if they contain a macro found since.
+    obj_hashtable<expr>         m_examined;
+    expr_ref_vector             m_examined_pinned;
+    void mark_examined(expr * n) { m_examined.insert(n); m_examined_pinned.push_back(n); }
+    void reset_examined() { m_examined.reset(); m_examined_pinned.reset(); }
+    bool is_examined(expr * n) const;
     bool expand_macros(expr_ref_vector const& exprs, proof_ref_vector const& prs, expr_dependency_ref_vector const & deps, 
                        expr_ref_vector & new_exprs, proof_ref_vector & new_prs, expr_dependency_ref_vector& new_deps);
     bool expand_macros(unsigned n, justified_expr const * fmls, vector<justified_expr>& new_fmls);
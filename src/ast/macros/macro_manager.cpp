@@ -120,7 +120,7 @@ bool macro_manager::insert(func_decl * f, quantifier * q, proof * pr, expr_depen
     TRACE("macro_insert", tout << "trying to create macro: " << f->get_name() << "\n" << mk_pp(q, m) << "\n";);
 
     // if we already have a macro for f then return false;
-    if (m_decls.contains(f)) {
+    if (contains(f)) {
         TRACE("macro_insert", tout << "we already have a macro for: " << f->get_name() << "\n";);
         return false;
     }
@@ -358,6 +358,8 @@ void quasi_macros::apply_macros(expr_ref_vector & exprs, proof_ref_vector & prs,
         expr_dependency_ref dep(m);
         proof * p = m.proofs_enabled() ? prs.get(i) : nullptr;
         m_macro_manager.expand_macros(exprs.get(i), p, deps.get(i), r, pr, dep);
+        if (r == exprs.get(i))
+            continue;
         m_rewriter(r, rr, prr);
         if (pr) pr = m.mk_modus_ponens(pr, prr);
         exprs[i] = rr;
@@ -384,6 +386,10 @@ void quasi_macros::apply_macros(unsigned n, justified_expr const* fmls, vector<j
         proof * p = m.proofs_enabled() ? fmls[i].get_proof() : nullptr;
         expr_dependency_ref dep(m);
         m_macro_manager.expand_macros(fmls[i].get_fml(), p, nullptr, r, pr, dep);
+        if (r == fmls[i].get_fml()) {
+            new_fmls.push_back(fmls[i]);
+            continue;
+        }
         m_rewriter(r, rr, prr);
         if (pr) pr = m.mk_modus_ponens(pr, prr);
         new_fmls.push_back(justified_expr(m, rr, pr));
@@ -51,13 +51,51 @@ expr_pattern_match::match_quantifier(quantifier* qf, app_ref_vector& patterns, u
         return false; 
     }
     m_regs[0] = qf->get_expr();
-    for (unsigned i = 0; i < m_precompiled.size(); ++i) {
+    get_candidates(qf);
+    for (unsigned i : m_candidates) {
         if (match_quantifier(i, qf, patterns, weight)) 
             return true;
     }    
     return false;
 }
 
+/**
+   \brief symbols that match_decl can identify share a key:
+   uninterpreted symbols are keyed by themselves,
+   interpreted symbols by their family and kind.
+*/
+uint64_t expr_pattern_match::root_key(func_decl const * d) const {
+    if (d->get_family_id() == null_family_id)
+        return static_cast<uint64_t>(d->get_id());
+    return (static_cast<uint64_t>(d->get_family_id() + 1) << 32) | d->get_decl_kind();
+}
+
+/**
+   \brief collect the precompiled quantifiers that can match the body of qf
+   in the order they were compiled.
+*/
+void expr_pattern_match::get_candidates(quantifier * qf) {
+    m_candidates.reset();
+    expr * body = qf->get_expr();
+    unsigned_vector const * indexed = nullptr;
+    if (is_app(body)) {
+        auto * e = m_root_index.find_core(root_key(to_app(body)->get_decl()));
+        if (e)
+            indexed = &e->get_data().m_value;
+    }
+    if (!indexed) {
+        m_candidates.append(m_unindexed);
+        return;
+    }
+    unsigned i = 0, j = 0;
+    while (i < indexed->size() || j < m_unindexed.size()) {
+        if (j == m_unindexed.size() || (i < indexed->size() && (*indexed)[i] < m_unindexed[j]))
+            m_candidates.push_back((*indexed)[i++]);
+        else
+            m_candidates.push_back(m_unindexed[j++]);
+    }
+}
+
 bool
 expr_pattern_match::match_quantifier(unsigned i, quantifier* qf, app_ref_vector& patterns, unsigned& weight) {
     quantifier* qf2 = m_precompiled[i].get();
@@ -84,8 +122,8 @@ expr_pattern_match::match_quantifier(unsigned i, quantifier* qf, app_ref_vector&
 bool expr_pattern_match::match_quantifier_index(quantifier* qf, app_ref_vector& patterns, unsigned& index) {
     if (m_regs.empty()) return false;
     m_regs[0] = qf->get_expr();
-
-    for (unsigned i = 0; i < m_precompiled.size(); ++i) {
+    get_candidates(qf);
+    for (unsigned i : m_candidates) {
         unsigned weight = 0;
         if (match_quantifier(i, qf, patterns, weight)) {
             index = i;
@@ -119,6 +157,11 @@ expr_pattern_match::compile(expr* q)
     SASSERT(q->get_kind() == AST_QUANTIFIER);
     quantifier* qf = to_quantifier(q);
     unsigned ip = m_instrs.size();
+    expr * body = qf->get_expr();
+    if (is_app(body) && !is_var(to_app(body)->get_decl())) 
+        m_root_index.insert_if_not_there(root_key(to_app(body)->get_decl()), unsigned_vector()).push_back(m_precompiled.size());
+    else
+        m_unindexed.push_back(m_precompiled.size());
     m_first_instrs.push_back(ip);
     m_precompiled.push_back(qf);
 
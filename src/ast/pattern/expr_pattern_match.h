@@ -113,6 +113,11 @@ class expr_pattern_match {
     ptr_vector<expr>              m_regs;
     ptr_vector<var>               m_bound_dom;
     ptr_vector<var>               m_bound_rng;
+    // precompiled quantifiers indexed by the symbol at the root of their body.
+    // the remaining quantifiers can match any body.
+    u64_map<unsigned_vector>      m_root_index;
+    unsigned_vector               m_unindexed;
+    unsigned_vector               m_candidates;
 
  public:
     expr_pattern_match(ast_manager & manager);
@@ -129,6 +134,8 @@ class expr_pattern_match {
     void compile(expr* q);
     bool match(expr* a, unsigned init, subst& s);
     bool match_decl(func_decl const * pat, func_decl const * d) const;
+    uint64_t root_key(func_decl const * d) const;
+    void get_candidates(quantifier * qf);
     bool is_var(func_decl* d);
     void display(std::ostream& out, instr const& pc) const;
 };
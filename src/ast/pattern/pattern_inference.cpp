@@ -113,7 +113,9 @@ pattern_inference_cfg::pattern_inference_cfg(ast_manager & m, pattern_inference_
     m_pattern_weight_lt(m_candidates_info),
     m_collect(m, *this),
     m_contains_subpattern(*this),
-    m_database(m) {
+    m_database(m),
+    m_cached_bodies(m),
+    m_cached_patterns(m) {
     if (params.m_pi_arith == AP_NO)
         register_forbidden_family(m_afid);
 }
@@ -517,11 +519,47 @@ bool pattern_inference_cfg::has_preferred_patterns(ptr_vector<app> & candidate_p
     return found;
 }
 
+unsigned pattern_inference_cfg::pattern_mode() const {
+    return (m_forbidden.size() << 2) | (m_nested_arith_only ? 2 : 0) | (m_block_loop_patterns ? 1 : 0);
+}
+
+void pattern_inference_cfg::reset_pattern_cache() {
+    m_pattern_cache.reset();
+    m_cached_bodies.reset();
+    m_cached_patterns.reset();
+}
+
 void pattern_inference_cfg::mk_patterns(unsigned num_bindings,
                                     expr *   n,
                                     unsigned num_no_patterns,
                                     expr * const * no_patterns,
                                     app_ref_buffer & result) {
+    if (num_no_patterns > 0) {
+        mk_patterns_core(num_bindings, n, num_no_patterns, no_patterns, result);
+        return;
+    }
+    pattern_key key(n, num_bindings, pattern_mode());
+    std::pair<unsigned, unsigned> range;
+    if (m_pattern_cache.find(key, range)) {
+        for (unsigned i = range.first; i < range.second; ++i)
+            result.push_back(m_cached_patterns.get(i));
+        return;
+    }
+    unsigned sz = result.size();
+    mk_patterns_core(num_bindings, n, 0, nullptr, result);
+    range.first = m_cached_patterns.size();
+    for (unsigned i = sz; i < result.size(); ++i)
+        m_cached_patterns.push_back(result[i]);
+    range.second = m_cached_patterns.size();
+    m_cached_bodies.push_back(n);
+    m_pattern_cache.insert(key, range);
+}
+
+void pattern_inference_cfg::mk_patterns_core(unsigned num_bindings,
+                                    expr *   n,
+                                    unsigned num_no_patterns,
+                                    expr * const * no_patterns,
+                                    app_ref_buffer & result) {
     m_num_bindings    = num_bindings;
     m_num_no_patterns = num_no_patterns;
     m_no_patterns     = no_patterns;
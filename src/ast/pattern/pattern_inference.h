@@ -191,6 +191,29 @@ class pattern_inference_cfg :  public default_rewriter_cfg {
     ptr_vector<pre_pattern>      m_pre_patterns;
     expr_pattern_match           m_database;
 
+    /**
+       \brief Patterns inferred for a body. Quantifiers that differ only in
+       their names share the body, so the inference is performed once for them.
+       The mode records the state of the inference heuristics.
+    */
+    struct pattern_key {
+        expr *   m_body;
+        unsigned m_num_bindings;
+        unsigned m_mode;
+        pattern_key(): m_body(nullptr), m_num_bindings(0), m_mode(0) {}
+        pattern_key(expr * b, unsigned n, unsigned mode): m_body(b), m_num_bindings(n), m_mode(mode) {}
+        unsigned hash() const { return combine_hash(m_body->get_id(), hash_u_u(m_num_bindings, m_mode)); }
+        bool operator==(pattern_key const & k) const {
+            return m_body == k.m_body && m_num_bindings == k.m_num_bindings && m_mode == k.m_mode;
+        }
+    };
+    typedef map<pattern_key, std::pair<unsigned, unsigned>, obj_hash<pattern_key>, default_eq<pattern_key> > pattern_cache;
+    pattern_cache              m_pattern_cache;   // key -> range in m_cached_patterns
+    expr_ref_vector            m_cached_bodies;
+    app_ref_vector             m_cached_patterns;
+
+    unsigned pattern_mode() const;
+
     void candidates2unary_patterns(ptr_vector<app> const & candidate_patterns,
                                    ptr_vector<app> & remaining_candidate_patterns,
                                    app_ref_buffer & result);
@@ -213,6 +236,8 @@ class pattern_inference_cfg :  public default_rewriter_cfg {
                      unsigned num_no_patterns,           // IN num. patterns that should not be used.
                      expr * const * no_patterns,         // IN patterns that should not be used.
                      app_ref_buffer & result);           // OUT result
+
+    void mk_patterns_core(unsigned num_bindings, expr * n, unsigned num_no_patterns, expr * const * no_patterns, app_ref_buffer & result);
     
 public:
     pattern_inference_cfg(ast_manager & m, pattern_inference_params const & params);
@@ -220,6 +245,7 @@ public:
     void register_forbidden_family(family_id fid) {
         SASSERT(fid != m_bfid);
         m_forbidden.push_back(fid);
+        reset_pattern_cache();
     }
 
     /**
@@ -228,8 +254,11 @@ public:
     */
     void register_preferred(func_decl * f) {
         m_preferred.insert(f);
+        reset_pattern_cache();
     }
 
+    void reset_pattern_cache();
+
     bool reduce_quantifier(quantifier * old_q, 
                            expr * new_body, 
                            expr * const * new_patterns, 
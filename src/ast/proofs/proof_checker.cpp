@@ -15,83 +15,9 @@ Copyright (c) 2015 Microsoft Corporation
 
 #define SAME_OP(_d1_, _d2_) ((_d1_ == _d2_) || (IS_EQUIV(_d1_) && IS_EQUIV(_d2_)))
 
-proof_checker::hyp_decl_plugin::hyp_decl_plugin() :
-    m_cons(nullptr),
-    m_atom(nullptr),
-    m_nil(nullptr),
-    m_cell(nullptr) {
-}
-
-void proof_checker::hyp_decl_plugin::finalize() {
-    m_manager->dec_ref(m_cons);
-    m_manager->dec_ref(m_atom);
-    m_manager->dec_ref(m_nil);
-    m_manager->dec_ref(m_cell);
-}
-
-void proof_checker::hyp_decl_plugin::set_manager(ast_manager* m, family_id id) {
-    decl_plugin::set_manager(m,id);
-    m_cell = m->mk_sort(symbol("cell"), sort_info(id, CELL_SORT));
-    m_cons = m->mk_func_decl(symbol("cons"), m_cell, m_cell, m_cell, func_decl_info(id, OP_CONS));
-    m_atom = m->mk_func_decl(symbol("atom"), m->mk_bool_sort(), m_cell, func_decl_info(id, OP_ATOM));
-    m_nil  = m->mk_const_decl(symbol("nil"), m_cell, func_decl_info(id, OP_NIL));
-    m->inc_ref(m_cell);
-    m->inc_ref(m_cons);
-    m->inc_ref(m_atom);
-    m->inc_ref(m_nil);
-}
-
-sort * proof_checker::hyp_decl_plugin::mk_sort(decl_kind k, unsigned num_parameters, parameter const* parameters) {
-    SASSERT(k == CELL_SORT);
-    return m_cell;
-}
-
-func_decl * proof_checker::hyp_decl_plugin::mk_func_decl(decl_kind k) {
-    switch(k) {
-    case OP_CONS: return m_cons;
-    case OP_ATOM: return m_atom;
-    case OP_NIL: return m_nil;
-    default:
-        UNREACHABLE();
-        return nullptr;
-    }
-}
-
-func_decl * proof_checker::hyp_decl_plugin::mk_func_decl(
-    decl_kind k, unsigned num_parameters, parameter const * parameters,
-    unsigned arity, sort * const * domain, sort * range) {
-    return mk_func_decl(k);
-}
-
-func_decl * proof_checker::hyp_decl_plugin::mk_func_decl(
-    decl_kind k, unsigned num_parameters, parameter const * parameters,
-    unsigned num_args, expr * const * args, sort * range) {
-    return mk_func_decl(k);
-}
-
-void proof_checker::hyp_decl_plugin::get_op_names(svector<builtin_name> & op_names, symbol const & logic) {
-    if (logic == symbol::null) {
-        op_names.push_back(builtin_name("cons", OP_CONS));
-        op_names.push_back(builtin_name("atom", OP_ATOM));
-        op_names.push_back(builtin_name("nil", OP_NIL));
-    }
-}
-
-void proof_checker::hyp_decl_plugin::get_sort_names(svector<builtin_name> & sort_names, symbol const & logic) {
-    if (logic == symbol::null) {
-        sort_names.push_back(builtin_name("cell", CELL_SORT));
-    }
-}
-
-proof_checker::proof_checker(ast_manager& m) : m(m), m_todo(m), m_marked(), m_pinned(m), m_nil(m),
+proof_checker::proof_checker(ast_manager& m) : m(m), m_todo(m), m_marked(), m_pinned(m),
                                                m_dump_lemmas(false), m_logic("AUFLIRA"), m_proof_lemma_id(0) {
-    symbol fam_name("proof_hypothesis");
-    if (!m.has_plugin(fam_name)) {
-        m.register_plugin(fam_name, alloc(hyp_decl_plugin));
-    }
-    m_hyp_fid = m.mk_family_id(fam_name);
-    // m_spc_fid = m.get_family_id("spc");
-    m_nil = m.mk_const(m_hyp_fid, OP_NIL);
+    m_hyp_sets.push_back(uint_set());
 }
 
 bool proof_checker::check(proof* p, expr_ref_vector& side_conditions) {
@@ -109,6 +35,9 @@ bool proof_checker::check(proof* p, expr_ref_vector& side_conditions) {
     }
 
     m_hypotheses.reset();
+    m_hyp_sets.shrink(1);
+    m_hyp_atoms.reset();
+    m_atom2hyp.reset();
     m_pinned.reset();
     m_todo.reset();
     m_marked.reset();
@@ -1076,7 +1005,8 @@ void proof_checker::get_ors(expr* e, expr_ref_vector& ors) {
 
 void proof_checker::get_hypotheses(proof* p, expr_ref_vector& ante) {
     ptr_vector<proof> stack;
-    expr* h = nullptr, *hyp = nullptr;
+    expr* hyp = nullptr;
+    unsigned h = 0;
 
     stack.push_back(p);
     while (!stack.empty()) {
@@ -1087,69 +1017,40 @@ void proof_checker::get_hypotheses(proof* p, expr_ref_vector& ante) {
             continue;
         }
         if (is_hypothesis(p) && match_fact(p, hyp)) {
-            hyp = mk_atom(hyp);
-            m_pinned.push_back(hyp);
-            m_hypotheses.insert(p, hyp);
+            m_hypotheses.insert(p, mk_hyp(hyp));
             stack.pop_back();
             continue;
         }
         // in this system all hypotheses get bound by lemmas.
         if (m.is_lemma(p)) {
-            m_hypotheses.insert(p, mk_nil());
+            m_hypotheses.insert(p, 0);
             stack.pop_back();
             continue;
         }
         bool all_found = true;
-        ptr_vector<expr> hyps;
+        h = 0;
         for (unsigned i = 0; i < m.get_num_parents(p); ++i) {
             proof* p_i = m.get_parent(p, i);
-            if (m_hypotheses.find(p_i, h)) {
-                hyps.push_back(h);
-            }
-            else {
+            unsigned h_i = 0;
+            if (!m_hypotheses.find(p_i, h_i)) {
                 stack.push_back(p_i);
                 all_found = false;
             }
+            else if (all_found) {
+                h = mk_hyp_union(h, h_i);
+            }
         }
         if (all_found) {
-            h = mk_hyp(hyps.size(), hyps.data());
-            m_pinned.push_back(h);
             m_hypotheses.insert(p, h);
             stack.pop_back();
         }
     }
 
-    //
-    // dis-assemble the set of obtained hypotheses.
-    //
     if (!m_hypotheses.find(p, h)) {
         UNREACHABLE();
     }
-
-    ptr_buffer<expr> hyps;
-    ptr_buffer<expr> todo;
-    expr_mark mark;
-    todo.push_back(h);
-    expr* a = nullptr, *b = nullptr;
-
-    while (!todo.empty()) {
-        h = todo.back();
-
-        todo.pop_back();
-        if (mark.is_marked(h)) {
-            continue;
-        }
-        mark.mark(h, true);
-        if (match_cons(h, a, b)) {
-            todo.push_back(a);
-            todo.push_back(b);
-        }
-        else if (match_atom(h, a)) {
-            ante.push_back(a);
-        }
-        else {
-            SASSERT(match_nil(h));
-        }
+    for (unsigned i : m_hyp_sets[h]) {
+        ante.push_back(m_hyp_atoms[i]);
     }
     TRACE("proof_checker",
           {
@@ -1162,71 +1063,38 @@ void proof_checker::get_hypotheses(proof* p, expr_ref_vector& ante) {
 
 }
 
-bool proof_checker::match_nil(expr const* e) const {
-    return
-        is_app(e) &&
-        to_app(e)->get_family_id() == m_hyp_fid &&
-        to_app(e)->get_decl_kind() == OP_NIL;
-}
-
-bool proof_checker::match_cons(expr const* e, expr*& a, expr*& b) const {
-    if (is_app(e) &&
-        to_app(e)->get_family_id() == m_hyp_fid &&
-        to_app(e)->get_decl_kind() == OP_CONS) {
-        a = to_app(e)->get_arg(0);
-        b = to_app(e)->get_arg(1);
-        return true;
-    }
-    return false;
-}
-
-
-bool proof_checker::match_atom(expr const* e, expr*& a) const {
-    if (is_app(e) &&
-        to_app(e)->get_family_id() == m_hyp_fid &&
-        to_app(e)->get_decl_kind() == OP_ATOM) {
-        a = to_app(e)->get_arg(0);
-        return true;
-    }
-    return false;
-}
-
-expr* proof_checker::mk_atom(expr* e) {
-    return m.mk_app(m_hyp_fid, OP_ATOM, e);
-}
-
-expr* proof_checker::mk_cons(expr* a, expr* b) {
-    return m.mk_app(m_hyp_fid, OP_CONS, a, b);
-}
-
-expr* proof_checker::mk_nil() {
-    return m_nil.get();
-}
-
 bool proof_checker::is_hypothesis(proof const* p) const {
     return
         m.is_proof(p) &&
         p->get_decl_kind() == PR_HYPOTHESIS;
 }
 
-expr* proof_checker::mk_hyp(unsigned num_hyps, expr * const * hyps) {
-    expr* result = nullptr;
-    for (unsigned i = 0; i < num_hyps; ++i) {
-        if (!match_nil(hyps[i])) {
-            if (result) {
-                result = mk_cons(result, hyps[i]);
-            }
-            else {
-                result = hyps[i];
-            }
-        }
-    }
-    if (result == nullptr) {
-        return mk_nil();
-    }
-    else {
-        return result;
-    }
+unsigned proof_checker::mk_hyp(expr* e) {
+    unsigned s = 0;
+    if (!m_atom2hyp.find(e, s)) {
+        s = m_hyp_sets.size();
+        m_hyp_sets.push_back(uint_set());
+        m_hyp_sets.back().insert(m_hyp_atoms.size());
+        m_hyp_atoms.push_back(e);
+        m_pinned.push_back(e);
+        m_atom2hyp.insert(e, s);
+    }
+    return s;
+}
+
+/**
+   \brief return the index of the union of two hypothesis sets.
+   A new set is only created if neither set contains the other.
+*/
+unsigned proof_checker::mk_hyp_union(unsigned s1, unsigned s2) {
+    if (s1 == s2 || m_hyp_sets[s2].subset_of(m_hyp_sets[s1]))
+        return s1;
+    if (m_hyp_sets[s1].subset_of(m_hyp_sets[s2]))
+        return s2;
+    uint_set u(m_hyp_sets[s1]);
+    u |= m_hyp_sets[s2];
+    m_hyp_sets.push_back(u);
+    return m_hyp_sets.size() - 1;
 }
 
 void proof_checker::dump_proof(proof const* pr) {
@@ -20,52 +20,23 @@ Revision History:
 
 #include "ast/ast.h"
 #include "util/map.h"
+#include "util/uint_set.h"
 
 class proof_checker {
     ast_manager&     m;
     proof_ref_vector m_todo;
     expr_mark        m_marked;
     expr_ref_vector  m_pinned;
-    obj_map<expr, expr*> m_hypotheses;
-    family_id        m_hyp_fid;
-    // family_id        m_spc_fid;
-    app_ref          m_nil;
+    // the hypotheses of a proof are an index into m_hyp_sets.
+    // the sets range over indices into m_hyp_atoms and are shared between proofs.
+    // set 0 is empty, m_atom2hyp maps a hypothesis to its singleton set.
+    obj_map<expr, unsigned> m_hypotheses;
+    vector<uint_set> m_hyp_sets;
+    ptr_vector<expr> m_hyp_atoms;
+    obj_map<expr, unsigned> m_atom2hyp;
     bool             m_dump_lemmas;
     std::string      m_logic; 
     unsigned         m_proof_lemma_id;
-    enum hyp_decl_kind {
-        OP_CONS,
-        OP_ATOM,
-        OP_NIL
-    };
-    enum hyp_sort_kind {
-        CELL_SORT
-    };
-    class hyp_decl_plugin : public decl_plugin {
-    protected:
-        func_decl* m_cons;
-        func_decl* m_atom;
-        func_decl* m_nil;
-        sort*      m_cell;
-        void set_manager(ast_manager * m, family_id id) override;
-        func_decl * mk_func_decl(decl_kind k);
-    public:
-        hyp_decl_plugin();
-
-        ~hyp_decl_plugin() override {}
-
-        void finalize() override;
-        
-        decl_plugin * mk_fresh() override { return alloc(hyp_decl_plugin); }
-
-        sort * mk_sort(decl_kind k, unsigned num_parameters, parameter const* parameters) override;
-        func_decl * mk_func_decl(decl_kind k, unsigned num_parameters, parameter const * parameters,
-                                 unsigned arity, sort * const * domain, sort * range) override;
-        func_decl * mk_func_decl(decl_kind k, unsigned num_parameters, parameter const * parameters,
-                                 unsigned num_args, expr * const * args, sort * range) override;
-        void get_op_names(svector<builtin_name> & op_names, symbol const & logic) override;
-        void get_sort_names(svector<builtin_name> & sort_names, symbol const & logic) override;
-    };
 public:
     proof_checker(ast_manager& m);
     void set_dump_lemmas(char const * logic = "AUFLIA") { m_dump_lemmas = true; m_logic = logic; } 
@@ -100,14 +71,9 @@ private:
     void get_ors(expr* e, expr_ref_vector& ors);
     void get_hypotheses(proof* p, expr_ref_vector& ante);
 
-    bool match_nil(expr const* e) const;
-    bool match_cons(expr const* e, expr*& a, expr*& b) const;
-    bool match_atom(expr const* e, expr*& a) const;
-    expr* mk_nil();
-    expr* mk_cons(expr* a, expr* b);
-    expr* mk_atom(expr* e);
     bool is_hypothesis(proof const* p) const;
-    expr* mk_hyp(unsigned num_hyps, expr * const * hyps);
+    unsigned mk_hyp(expr* e);
+    unsigned mk_hyp_union(unsigned s1, unsigned s2);
     void dump_proof(proof const* pr);
     void dump_proof(unsigned num_antecedents, expr * const * antecedents, expr * consequent);
 
@@ -32,6 +32,7 @@ namespace q {
         m_num_instances_curr_search(0),
         m_num_instances_curr_branch(0),
         m_max_generation(0),
+        m_num_conflicts(0),
         m_max_cost(0.0f) {
     }
 
@@ -41,6 +41,7 @@ namespace q {
         unsigned m_num_instances_curr_search;
         unsigned m_num_instances_curr_branch; //!< only updated if QI_TRACK_INSTANCES is true
         unsigned m_max_generation; //!< max. generation of an instance
+        unsigned m_num_conflicts;  //!< number of times an instance was used in conflict resolution
         float    m_max_cost;
 
         friend class quantifier_stat_gen;
@@ -103,6 +104,14 @@ namespace q {
             m_num_instances_curr_branch++;
         }
 
+        unsigned get_num_conflicts() const {
+            return m_num_conflicts;
+        }
+
+        void inc_num_conflicts() {
+            m_num_conflicts++;
+        }
+
         void reset_num_instances_curr_search() {
             m_num_instances_curr_search = 0;
         }
@@ -36,6 +36,117 @@ static void sort_args(expr * & l1, expr * & l2, expr * & l3) {
     l1 = args[0]; l2 = args[1]; l3 = args[2];
 }
 
+static void sort_args(expr * & l1, expr * & l2) {
+    if (l2->get_id() < l1->get_id())
+        std::swap(l1, l2);
+}
+
+static bool has_arg(expr * e, expr * a) {
+    for (expr * arg : *to_app(e))
+        if (arg == a)
+            return true;
+    return false;
+}
+
+/**
+   \brief Two-level rules for a conjunction of a and b:
+   a & (a | c) = a and a & !(a | c) = false.
+   The flattening of bool_rewriter covers the rules with nested conjunctions.
+*/
+bool bit_blaster_cfg::absorb_and(expr * a, expr * b, expr_ref & r) {
+    expr * n;
+    for (unsigned i = 0; i < 2; ++i, std::swap(a, b)) {
+        if (m().is_or(b) && has_arg(b, a)) {
+            r = a;
+            return true;
+        }
+        if (m().is_not(b, n) && m().is_or(n) && has_arg(n, a)) {
+            r = m().mk_false();
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+   \brief Two-level rules for a disjunction of a and b:
+   a | (a & c) = a and a | !(a & c) = true.
+*/
+bool bit_blaster_cfg::absorb_or(expr * a, expr * b, expr_ref & r) {
+    expr * n;
+    for (unsigned i = 0; i < 2; ++i, std::swap(a, b)) {
+        if (m().is_and(b) && has_arg(b, a)) {
+            r = a;
+            return true;
+        }
+        if (m().is_not(b, n) && m().is_and(n) && has_arg(n, a)) {
+            r = m().mk_true();
+            return true;
+        }
+    }
+    return false;
+}
+
+void bit_blaster_cfg::mk_xor(expr * a, expr * b, expr_ref & r) {
+    sort_args(a, b);
+    m_rw.mk_xor(a, b, r);
+}
+
+void bit_blaster_cfg::mk_iff(expr * a, expr * b, expr_ref & r) {
+    sort_args(a, b);
+    m_rw.mk_iff(a, b, r);
+}
+
+void bit_blaster_cfg::mk_and(expr * a, expr * b, expr_ref & r) {
+    if (absorb_and(a, b, r))
+        return;
+    sort_args(a, b);
+    m_rw.mk_and(a, b, r);
+}
+
+void bit_blaster_cfg::mk_and(expr * a, expr * b, expr * c, expr_ref & r) {
+    sort_args(a, b, c);
+    m_rw.mk_and(a, b, c, r);
+}
+
+void bit_blaster_cfg::mk_and(unsigned sz, expr * const * args, expr_ref & r) {
+    ptr_buffer<expr> sorted;
+    sorted.append(sz, args);
+    std::sort(sorted.begin(), sorted.end(), ast_lt_proc());
+    m_rw.mk_and(sz, sorted.data(), r);
+}
+
+void bit_blaster_cfg::mk_or(expr * a, expr * b, expr_ref & r) {
+    if (absorb_or(a, b, r))
+        return;
+    sort_args(a, b);
+    m_rw.mk_or(a, b, r);
+}
+
+void bit_blaster_cfg::mk_or(expr * a, expr * b, expr * c, expr_ref & r) {
+    sort_args(a, b, c);
+    m_rw.mk_or(a, b, c, r);
+}
+
+void bit_blaster_cfg::mk_or(unsigned sz, expr * const * args, expr_ref & r) {
+    ptr_buffer<expr> sorted;
+    sorted.append(sz, args);
+    std::sort(sorted.begin(), sorted.end(), ast_lt_proc());
+    m_rw.mk_or(sz, sorted.data(), r);
+}
+
+void bit_blaster_cfg::mk_nand(expr * a, expr * b, expr_ref & r) {
+    expr_ref t(m());
+    mk_and(a, b, t);
+    m_rw.mk_not(t, r);
+}
+
+void bit_blaster_cfg::mk_nor(expr * a, expr * b, expr_ref & r) {
+    expr_ref t(m());
+    mk_or(a, b, t);
+    m_rw.mk_not(t, r);
+}
+
 
 void bit_blaster_cfg::mk_xor3(expr * l1, expr * l2, expr * l3, expr_ref & r) {
     TRACE("xor3", tout << "#" << l1->get_id() << " #" << l2->get_id() << " #" << l3->get_id(););
@@ -44,6 +44,8 @@ struct pb2bv_rewriter::imp {
     unsigned                  m_num_translated;
     unsigned                  m_compile_bv;
     unsigned                  m_compile_card;
+    unsigned                  m_card_networks;
+    unsigned                  m_card_reused;
 
     struct card2bv_rewriter {               
         typedef expr* pliteral;
@@ -62,6 +64,18 @@ struct pb2bv_rewriter::imp {
         symbol m_pb_solver;
         unsigned m_min_arity;
 
+        // cardinality networks shared by the constraints over the same literals.
+        // out[i] is implied by, or implies, i+1 true literals according to
+        // m_at_most and m_at_least.
+        struct shared_card {
+            bool             m_at_most;
+            bool             m_at_least;
+            ptr_vector<expr> m_out;
+            shared_card(): m_at_most(false), m_at_least(false) {}
+        };
+        obj_map<expr, unsigned> m_card2net;  // disjunction of the sorted literals -> m_nets
+        vector<shared_card>     m_nets;
+
         template<lbool is_le>
         expr_ref mk_le_ge(expr_ref_vector& fmls, expr* a, expr* b, expr* bound) {
             expr_ref x(m), y(m), result(m);
@@ -887,27 +901,32 @@ struct pb2bv_rewriter::imp {
             }
             else if (pb.is_at_most_k(f) && pb.get_k(f).is_unsigned()) {
                 if (m_keep_cardinality_constraints && f->get_arity() >= m_min_arity) return false;
-                result = m_sort.le(full, pb.get_k(f).get_unsigned(), sz, args);
+                result = mk_shared_card(full, true, false, pb.get_k(f).get_unsigned(), sz, args);
+                if (!result) result = m_sort.le(full, pb.get_k(f).get_unsigned(), sz, args);
                 ++m_imp.m_compile_card;
             }
             else if (pb.is_at_least_k(f) && pb.get_k(f).is_unsigned()) {
                 if (m_keep_cardinality_constraints && f->get_arity() >= m_min_arity) return false;
-                result = m_sort.ge(full, pb.get_k(f).get_unsigned(), sz, args);
+                result = mk_shared_card(full, false, true, pb.get_k(f).get_unsigned(), sz, args);
+                if (!result) result = m_sort.ge(full, pb.get_k(f).get_unsigned(), sz, args);
                 ++m_imp.m_compile_card;
             }
             else if (pb.is_eq(f) && pb.get_k(f).is_unsigned() && pb.has_unit_coefficients(f)) {
                 if (m_keep_cardinality_constraints && f->get_arity() >= m_min_arity) return false;
-                result = m_sort.eq(full, pb.get_k(f).get_unsigned(), sz, args);
+                result = mk_shared_card(full, true, true, pb.get_k(f).get_unsigned(), sz, args);
+                if (!result) result = m_sort.eq(full, pb.get_k(f).get_unsigned(), sz, args);
                 ++m_imp.m_compile_card;
             }
             else if (pb.is_le(f) && pb.get_k(f).is_unsigned() && pb.has_unit_coefficients(f)) {
                 if (m_keep_cardinality_constraints && f->get_arity() >= m_min_arity) return false;
-                result = m_sort.le(full, pb.get_k(f).get_unsigned(), sz, args);
+                result = mk_shared_card(full, true, false, pb.get_k(f).get_unsigned(), sz, args);
+                if (!result) result = m_sort.le(full, pb.get_k(f).get_unsigned(), sz, args);
                 ++m_imp.m_compile_card;
             }
             else if (pb.is_ge(f) && pb.get_k(f).is_unsigned() && pb.has_unit_coefficients(f)) {
                 if (m_keep_cardinality_constraints && f->get_arity() >= m_min_arity) return false;
-                result = m_sort.ge(full, pb.get_k(f).get_unsigned(), sz, args);
+                result = mk_shared_card(full, false, true, pb.get_k(f).get_unsigned(), sz, args);
+                if (!result) result = m_sort.ge(full, pb.get_k(f).get_unsigned(), sz, args);
                 ++m_imp.m_compile_card;
             }
             else if (pb.is_eq(f) && pb.get_k(f).is_unsigned() && has_small_coefficients(f) && m_pb_solver == "solver") {
@@ -927,6 +946,88 @@ struct pb2bv_rewriter::imp {
             return true;
         }
 
+        bool use_shared_card() {
+            switch (m_sort.cfg().m_encoding) {
+            case sorting_network_encoding::sorted_at_most:
+            case sorting_network_encoding::bimander_at_most:
+            case sorting_network_encoding::ordered_at_most:
+            case sorting_network_encoding::grouped_at_most:
+                return true;
+            default:
+                return false;
+            }
+        }
+
+        /**
+           \brief return the first k outputs of a network over xs in the given directions.
+           A network built for a previous constraint over the same literals is
+           reused if it has enough outputs, otherwise it is replaced by a network
+           that also covers the previous constraints.
+        */
+        ptr_vector<expr> const& shared_card_outputs(bool at_most, bool at_least, unsigned k, unsigned n, expr* const* xs) {
+            ptr_vector<expr> lits(n, xs);
+            std::sort(lits.begin(), lits.end(), ast_lt_proc());
+            expr_ref key(m.mk_or(n, lits.data()), m);
+            unsigned idx = 0;
+            if (m_card2net.find(key, idx)) {
+                shared_card const& net = m_nets[idx];
+                if (net.m_out.size() >= k && (net.m_at_most || !at_most) && (net.m_at_least || !at_least)) {
+                    ++m_imp.m_card_reused;
+                    return net.m_out;
+                }
+                k = std::max(k, net.m_out.size());
+                at_most |= net.m_at_most;
+                at_least |= net.m_at_least;
+            }
+            else {
+                idx = m_nets.size();
+                m_nets.push_back(shared_card());
+                m_card2net.insert(trail(key), idx);
+            }
+            ptr_vector<expr> out;
+            m_sort.card_outputs(at_most, at_least, k, n, lits.data(), out);
+            shared_card& net = m_nets[idx];
+            net.m_at_most = at_most;
+            net.m_at_least = at_least;
+            net.m_out.swap(out);
+            ++m_imp.m_card_networks;
+            return net.m_out;
+        }
+
+        /**
+           \brief encode sum xs <= k, sum xs >= k or sum xs = k using a shared network.
+           Return null if the encoding of m_sort does not use a cardinality network, 
+           such as for trivial bounds and bounds that are 1 after dualization.
+        */
+        pliteral mk_shared_card(bool full, bool is_le, bool is_ge, unsigned k, unsigned n, expr* const* xs) {
+            if (!use_shared_card() || k == 0 || k >= n)
+                return nullptr;
+            ptr_vector<expr> in;
+            if (2*k > n) {
+                // sum xs <= k iff sum ~xs >= n - k
+                for (unsigned i = 0; i < n; ++i)
+                    in.push_back(mk_not(xs[i]));
+                xs = in.data();
+                k = n - k;
+                std::swap(is_le, is_ge);
+            }
+            if (k == 1)
+                return nullptr;
+            ptr_vector<expr> const& out = shared_card_outputs(is_le || full, is_ge || full, is_le ? k + 1 : k, n, xs);
+            if (is_le && is_ge) {
+                pliteral lits[2] = { out[k-1], mk_not(out[k]) };
+                return mk_min(2, lits);
+            }
+            if (is_le)
+                return mk_not(out[k]);
+            return out[k-1];
+        }
+
+        void reset_shared_card() {
+            m_card2net.reset();
+            m_nets.reset();
+        }
+
         bool has_small_coefficients(func_decl* f) {
             unsigned sz = f->get_arity();
             unsigned sum = 0;
@@ -1066,6 +1167,8 @@ struct pb2bv_rewriter::imp {
         updt_params(p);
         m_compile_bv = 0;
         m_compile_card = 0;
+        m_card_networks = 0;
+        m_card_reused = 0;
     }
 
     void updt_params(params_ref const & p) {
@@ -1099,6 +1202,8 @@ struct pb2bv_rewriter::imp {
             unsigned lim = m_fresh_lim[new_sz];
             m_fresh.resize(lim);
             m_fresh_lim.resize(new_sz);
+            // the clauses of the shared networks were asserted in the popped scopes.
+            m_rw.m_cfg.m_r.reset_shared_card();
         }
         m_rw.reset();
     }
@@ -1113,6 +1218,9 @@ struct pb2bv_rewriter::imp {
         st.update("pb-compile-card", m_compile_card);
         st.update("pb-aux-variables", m_fresh.size());
         st.update("pb-aux-clauses", m_rw.m_cfg.m_r.m_sort.m_stats.m_num_compiled_clauses);
+        st.update("pb-aux-card-vars", m_rw.m_cfg.m_r.m_sort.m_stats.m_num_compiled_vars);
+        st.update("pb-card-networks", m_card_networks);
+        st.update("pb-card-networks-reused", m_card_reused);
     }
 
 };
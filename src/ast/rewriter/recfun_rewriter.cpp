@@ -38,4 +38,35 @@ br_status recfun_rewriter::mk_app_core(func_decl * f, unsigned num_args, expr *
         return BR_FAILED;
 }
 
-
+bool recfun_evaluator::operator()(app* t, expr_ref& value) {
+    expr* v = nullptr;
+    if (m_values.find(t, v)) {
+        value = v;
+        return true;
+    }
+    if (m_failed.contains(t) || !m_rec.is_defined(t) || t->get_num_args() == 0)
+        return false;
+    for (expr* arg : *t)
+        if (!m.is_value(arg))
+            return false;
+    m_pinned.push_back(t);
+    if (!m_rw) {
+        params_ref p;
+        p.set_uint("max_steps", m_max_steps);
+        m_rw = alloc(th_rewriter, m, p);
+    }
+    try {
+        (*m_rw)(t, value);
+    }
+    catch (rewriter_exception&) {
+        m_rw->reset();
+        value = nullptr;
+    }
+    if (!value || !m.is_value(value)) {
+        m_failed.insert(t);
+        return false;
+    }
+    m_pinned.push_back(value);
+    m_values.insert(t, value);
+    return true;
+}
@@ -20,6 +20,7 @@ Author:
 
 #include "ast/recfun_decl_plugin.h"
 #include "ast/rewriter/rewriter.h"
+#include "ast/rewriter/th_rewriter.h"
 
 class recfun_rewriter {
     ast_manager& m;
@@ -33,3 +34,25 @@ public:
 
 };
 
+/**
+   \brief memoized evaluation of recursive functions applied to values.
+   The evaluation unfolds the definitions by rewriting and gives up after
+   a bounded number of rewrite steps, since the recursion need not terminate.
+*/
+class recfun_evaluator {
+    ast_manager&            m;
+    recfun::util            m_rec;
+    unsigned                m_max_steps;
+    scoped_ptr<th_rewriter> m_rw;
+    obj_map<app, expr*>     m_values;
+    obj_hashtable<app>      m_failed;
+    expr_ref_vector         m_pinned;
+public:
+    recfun_evaluator(ast_manager& m, unsigned max_steps = 100000): m(m), m_rec(m), m_max_steps(max_steps), m_pinned(m) {}
+
+    /**
+       \brief evaluate a defined function applied to values.
+       Return true and the value of t if the evaluation succeeds.
+    */
+    bool operator()(app* t, expr_ref& value);
+};
@@ -25,15 +25,15 @@ template<typename Config>
 template<bool ProofGen>
 void rewriter_tpl<Config>::process_var(var * v) {
     if (m_cfg.reduce_var(v, m_r, m_pr)) {
-        result_stack().push_back(m_r);
         SASSERT(v->get_sort() == m_r->get_sort());
+        // the reference of m_r is moved to the result stack
+        result_stack().push_back(std::move(m_r));
         if (ProofGen) {
             result_pr_stack().push_back(m_pr);
             m_pr = nullptr;
         }
         set_new_child_flag(v);
-        TRACE("rewriter", tout << mk_ismt2_pp(v, m()) << " -> " << m_r << "\n";);
-        m_r = nullptr;
+        TRACE("rewriter", tout << mk_ismt2_pp(v, m()) << " -> " << mk_ismt2_pp(result_stack().back(), m()) << "\n";);
         return;
     }
     unsigned idx = v->get_idx();
@@ -105,7 +105,6 @@ bool rewriter_tpl<Config>::process_const(app * t0) {
         m_r = t;
         // fall through
     case BR_DONE:
-        result_stack().push_back(m_r.get());
         if (ProofGen) {
             SASSERT(rewrites_from(t0, m_pr));
             SASSERT(rewrites_to(m_r, m_pr));
@@ -115,7 +114,7 @@ bool rewriter_tpl<Config>::process_const(app * t0) {
                 result_pr_stack().push_back(m().mk_rewrite(t0, m_r));
             m_pr = nullptr;
         }
-        m_r = nullptr;
+        result_stack().push_back(std::move(m_r));
         set_new_child_flag(t0);
         return true;
     default: 
@@ -456,16 +455,15 @@ void rewriter_tpl<Config>::process_app(app * t, frame & fr) {
             }
         }
         result_stack().shrink(fr.m_spos);
-        result_stack().push_back(m_r);
-        cache_result<ProofGen>(t, m_r, m_pr, fr.m_cache_result);
+        result_stack().push_back(std::move(m_r));
+        cache_result<ProofGen>(t, result_stack().back(), m_pr, fr.m_cache_result);
         if (ProofGen) {
             result_pr_stack().shrink(fr.m_spos);
             result_pr_stack().push_back(m_pr);
             m_pr = nullptr;
         }
         frame_stack().pop_back();
-        set_new_child_flag(t, m_r);
-        m_r = nullptr;
+        set_new_child_flag(t, result_stack().back());
         return;
     }
     case REWRITE_BUILTIN:
@@ -479,11 +477,10 @@ void rewriter_tpl<Config>::process_app(app * t, frame & fr) {
             m_pr = m().mk_transitivity(pr1, pr2);
             result_pr_stack().push_back(m_pr);
         }
-        m_r = result_stack().back();
+        // replace the original result by the rewritten one in place
+        result_stack().set(result_stack().size() - 2, result_stack().back());
         result_stack().pop_back();
-        result_stack().pop_back();
-        result_stack().push_back(m_r);
-        cache_result<ProofGen>(t, m_r, m_pr, fr.m_cache_result);
+        cache_result<ProofGen>(t, result_stack().back(), m_pr, fr.m_cache_result);
         frame_stack().pop_back();
         set_new_child_flag(t);
         return;
@@ -3014,8 +3014,13 @@ expr_ref seq_rewriter::mk_derivative(expr* r) {
     sort* seq_sort = nullptr, * ele_sort = nullptr;
     VERIFY(m_util.is_re(r, seq_sort));
     VERIFY(m_util.is_seq(seq_sort, ele_sort));
+    expr* d = re().find_derivative(r);
+    if (d)
+        return expr_ref(d, m());
     expr_ref v(m().mk_var(0, ele_sort), m());
-    return mk_antimirov_deriv(v, r, m().mk_true());
+    expr_ref result = mk_antimirov_deriv(v, r, m().mk_true());
+    re().insert_derivative(r, result);
+    return result;
 }
 
 expr_ref seq_rewriter::mk_derivative(expr* ele, expr* r) {
@@ -408,6 +408,8 @@ public:
     /*
     make the derivative of r wrt the canonical variable v0 = (:var 0), 
     for example mk_derivative(a+) = (if (v0 = 'a') then a* else [])
+    The result is cached by the seq plugin, so it is shared by all
+    rewriters of the manager and survives resets of the op cache.
     */
     expr_ref mk_derivative(expr* r);
 
@@ -62,6 +62,7 @@ struct th_rewriter_cfg : public default_rewriter_cfg {
     bool                m_pull_cheap_ite = true;
     bool                m_flat = true;
     bool                m_cache_all = false;
+    bool                m_persistent_cache = false;
     bool                m_push_ite_arith = true;
     bool                m_push_ite_bv = true;
     bool                m_ignore_patterns_on_ground_qbody = true;
@@ -77,6 +78,7 @@ struct th_rewriter_cfg : public default_rewriter_cfg {
         m_max_steps      = p.max_steps();
         m_pull_cheap_ite = p.pull_cheap_ite();
         m_cache_all      = p.cache_all();
+        m_persistent_cache = p.persistent_cache();
         m_push_ite_arith = p.push_ite_arith();
         m_push_ite_bv    = p.push_ite_bv();
         m_ignore_patterns_on_ground_qbody = p.ignore_patterns_on_ground_qbody();
@@ -847,6 +849,22 @@ struct th_rewriter::imp : public rewriter_tpl<th_rewriter_cfg> {
     void set_solver(expr_solver* solver) {
         m_cfg.m_seq_rw.set_solver(solver);
     }
+
+    // the top-level cache only depends on the parameters when there is no substitution,
+    // no bindings and no interrupted rewrite.
+    bool keep_cache() const {
+        return 
+            m_cfg.m_persistent_cache && 
+            !m_cfg.m_subst && 
+            !m_proof_gen &&
+            m_bindings.empty() &&
+            frame_stack().empty() &&
+            m_cache == m_cache_stack[0];
+    }
+
+    void flush_cache() {
+        reset_cache();
+    }
 };
 
 th_rewriter::th_rewriter(ast_manager & m, params_ref const & p):
@@ -860,7 +878,10 @@ ast_manager & th_rewriter::m() const {
 
 void th_rewriter::updt_params(params_ref const & p) {
     m_params = p;
+    bool was_persistent = m_imp->cfg().m_persistent_cache;
     m_imp->cfg().updt_params(p);
+    if (was_persistent)
+        m_imp->flush_cache();
 }
 
 void th_rewriter::get_param_descrs(param_descrs & r) {
@@ -891,6 +912,8 @@ void th_rewriter::cleanup() {
 }
 
 void th_rewriter::reset() {
+    if (m_imp->keep_cache())
+        return;
     m_imp->reset();
     m_imp->cfg().reset();
 }
@@ -35,11 +35,36 @@ seq_decl_plugin::seq_decl_plugin(): m_init(false),
 void seq_decl_plugin::finalize() {
     for (psig* s : m_sigs) 
         dealloc(s);
+    reset_derivatives();
     m_manager->dec_ref(m_string);
     m_manager->dec_ref(m_char);
     m_manager->dec_ref(m_reglan);
 }
 
+expr* seq_decl_plugin::find_derivative(expr* r) const {
+    expr* d = nullptr;
+    m_derivatives.find(r, d);
+    return d;
+}
+
+void seq_decl_plugin::insert_derivative(expr* r, expr* d) {
+    if (m_derivatives.size() >= m_max_derivatives)
+        reset_derivatives();
+    if (m_derivatives.contains(r))
+        return;
+    m_manager->inc_ref(r);
+    m_manager->inc_ref(d);
+    m_derivatives.insert(r, d);
+}
+
+void seq_decl_plugin::reset_derivatives() {
+    for (auto const& kv : m_derivatives) {
+        m_manager->dec_ref(kv.m_key);
+        m_manager->dec_ref(kv.m_value);
+    }
+    m_derivatives.reset();
+}
+
 bool seq_decl_plugin::is_sort_param(sort* s, unsigned& idx) {
     return
         s->get_name().is_numerical() &&
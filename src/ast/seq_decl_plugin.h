@@ -136,6 +136,12 @@ class seq_decl_plugin : public decl_plugin {
     bool             m_has_seq;
     char_decl_plugin* m_char_plugin { nullptr };
 
+    // Symbolic derivatives of regular expressions with respect to (:var 0).
+    // They are kept by the plugin so that they are shared by all rewriters
+    // and solvers that use the manager.
+    obj_map<expr, expr*> m_derivatives;
+    unsigned             m_max_derivatives { 10000 };
+
     void match(psig& sig, unsigned dsz, sort* const* dom, sort* range, sort_ref& rng);
 
     void match_assoc(psig& sig, unsigned dsz, sort* const* dom, sort* range, sort_ref& rng);
@@ -205,6 +211,10 @@ public:
 
     char_decl_plugin& get_char_plugin() const { return *m_char_plugin; }
 
+    expr* find_derivative(expr* r) const;
+    void insert_derivative(expr* r, expr* d);
+    void reset_derivatives();
+
 };
 
 class seq_util {
@@ -525,6 +535,9 @@ public:
         app* mk_derivative(expr* ele, expr* r) { return m.mk_app(m_fid, OP_RE_DERIVATIVE, ele, r); }
         app* mk_antimorov_union(expr* r1, expr* r2) { return m.mk_app(m_fid, _OP_RE_ANTIMOROV_UNION, r1, r2); }
 
+        expr* find_derivative(expr* r) const { return u.seq.find_derivative(r); }
+        void insert_derivative(expr* r, expr* d) { u.seq.insert_derivative(r, d); }
+
         bool is_to_re(expr const* n)    const { return is_app_of(n, m_fid, OP_SEQ_TO_RE); }
         bool is_concat(expr const* n)    const { return is_app_of(n, m_fid, OP_RE_CONCAT); }
         bool is_union(expr const* n)    const { return is_app_of(n, m_fid, OP_RE_UNION); }
@@ -287,6 +287,10 @@ ATOMIC_CMD(get_assertions_cmd, "get-assertions", "retrieve asserted terms when i
 
 ATOMIC_CMD(reset_assertions_cmd, "reset-assertions", "reset all asserted formulas (but retain definitions and declarations)", ctx.reset_assertions(); ctx.print_success(););
 
+ATOMIC_CMD(checkpoint_cmd, "checkpoint", "record the current declarations, definitions and assertions as a checkpoint", ctx.checkpoint(); ctx.print_success(););
+
+ATOMIC_CMD(restore_checkpoint_cmd, "restore-checkpoint", "discard the declarations, definitions and assertions since the last checkpoint", ctx.restore_checkpoint(); ctx.print_success(););
+
 UNARY_CMD(set_logic_cmd, "set-logic", "<symbol>", "set the background logic.", CPK_SYMBOL, symbol const &,
           if (ctx.set_logic(arg))
               ctx.print_success();
@@ -889,6 +893,8 @@ void install_basic_cmds(cmd_context & ctx) {
 
     ctx.insert(alloc(get_unsat_assumptions_cmd));
     ctx.insert(alloc(reset_assertions_cmd));
+    ctx.insert(alloc(checkpoint_cmd));
+    ctx.insert(alloc(restore_checkpoint_cmd));
 }
 
 
@@ -1437,6 +1437,7 @@ void cmd_context::reset(bool finalize) {
     m_mcs.reset();
     m_mcs.push_back(nullptr);
     m_scopes.reset();
+    m_checkpoint = 0;
     m_opt = nullptr;
     m_pp_env = nullptr;
     m_dt_eh  = nullptr;
@@ -1536,6 +1537,20 @@ void cmd_context::push(unsigned n) {
         push();
 }
 
+void cmd_context::checkpoint() {
+    push();
+    m_checkpoint = num_scopes();
+}
+
+void cmd_context::restore_checkpoint() {
+    if (!has_checkpoint())
+        throw cmd_exception("there is no checkpoint to restore");
+    unsigned lvl = m_checkpoint;
+    pop(num_scopes() - lvl + 1);
+    push();
+    m_checkpoint = lvl;
+}
+
 void cmd_context::restore_func_decls(unsigned old_sz) {
     SASSERT(old_sz <= m_func_decls_stack.size());
     svector<sf_pair>::iterator it  = m_func_decls_stack.begin() + old_sz;
@@ -1638,6 +1653,8 @@ void cmd_context::pop(unsigned n) {
     restore_psort_inst(s.m_psort_inst_stack_lim);
     m_mcs.shrink(m_mcs.size() - n);
     m_scopes.shrink(new_lvl);
+    if (new_lvl < m_checkpoint)
+        m_checkpoint = 0;
     if (!m_global_decls)
         pm().pop(n);
     while (n--) {
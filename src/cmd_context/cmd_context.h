@@ -256,6 +256,7 @@ protected:
     };
 
     svector<scope>               m_scopes;
+    unsigned                     m_checkpoint { 0 }; // scope level of the checkpoint, 0 if there is none
     scoped_ptr<solver_factory>   m_solver_factory;
     ref<solver>                  m_solver;
     ref<check_sat_result>        m_check_sat_result;
@@ -464,6 +465,14 @@ public:
     void push();
     void push(unsigned n);
     void pop(unsigned n);
+    /**
+       \brief Record the current declarations and assertions as a checkpoint.
+       restore_checkpoint() discards everything that was added after the checkpoint,
+       without parsing and declaring the contents before it again.
+    */
+    void checkpoint();
+    void restore_checkpoint();
+    bool has_checkpoint() const { return m_checkpoint > 0 && m_checkpoint <= m_scopes.size(); }
     void check_sat(unsigned num_assumptions, expr * const * assumptions);
     void get_consequences(expr_ref_vector const& assumptions, expr_ref_vector const& vars, expr_ref_vector & conseq);
     void reset_assertions();
@@ -396,6 +396,11 @@ typename symbolic_automata<T, M>::automaton_t* symbolic_automata<T, M>::mk_produ
         }
     }
     
+    // The same pair of guards occurs in many pairs of states.
+    // Their conjunction and its satisfiability are computed once.
+    typedef std::pair<T*, T*> guard_pair;
+    map<guard_pair, unsigned, pair_hash<ptr_hash<T>, ptr_hash<T> >, default_eq<guard_pair> > guard2id;
+    refs_t guards(m);
     unsigned n = 1;
     moves_t mvsA, mvsB;
     while (!todo.empty()) {
@@ -407,14 +412,25 @@ typename symbolic_automata<T, M>::automaton_t* symbolic_automata<T, M>::mk_produ
         b.get_moves_from(curr_pair.second, mvsB, true);
         for (unsigned i = 0; i < mvsA.size(); ++i) {
             for (unsigned j = 0; j < mvsB.size(); ++j) {
-                ref_t ab(m_ba.mk_and(mvsA[i].t(), mvsB[j].t()), m);   
-                lbool is_sat = m_ba.is_sat(ab);
-                if (is_sat == l_false) {
-                    continue;
+                guard_pair g(mvsA[i].t(), mvsB[j].t());
+                unsigned gid;
+                if (!guard2id.find(g, gid)) {
+                    ref_t ab(m_ba.mk_and(g.first, g.second), m);   
+                    lbool is_sat = m_ba.is_sat(ab);
+                    if (is_sat == l_undef) {
+                        return nullptr;
+                    }
+                    gid = UINT_MAX;
+                    if (is_sat == l_true) {
+                        gid = guards.size();
+                        guards.push_back(ab);
+                    }
+                    guard2id.insert(g, gid);
                 }
-                else if (is_sat == l_undef) {
-                    return nullptr;
+                if (gid == UINT_MAX) {
+                    continue;
                 }
+                T* ab = guards.get(gid);
                 unsigned_pair tgt_pair(mvsA[i].dst(), mvsB[j].dst());
                 unsigned tgt;
                 if (!pair2id.find(tgt_pair, tgt)) {
@@ -749,6 +749,7 @@ namespace dd {
         m_free_nodes.reset();
         IF_VERBOSE(13, verbose_stream() << "(bdd :gc " << m_nodes.size() << ")\n";);
         bool_vector reachable(m_nodes.size(), false);
+        reachable[false_bdd] = reachable[true_bdd] = true;
         for (unsigned i = m_bdd_stack.size(); i-- > 0; ) {
             reachable[m_bdd_stack[i]] = true;
             m_todo.push_back(m_bdd_stack[i]);
@@ -784,13 +785,19 @@ namespace dd {
         std::sort(m_free_nodes.begin(), m_free_nodes.end());
         m_free_nodes.reverse();
 
+        // keep the computed entries whose arguments and result survive.
+        // The operation of an entry is either a dummy node or the third argument
+        // of an ite, so it is also checked for reachability.
+        // The cache is flushed when it outgrows the node table.
+        bool keep_computed = m_op_cache.size() <= 2 * m_nodes.size();
         ptr_vector<op_entry> to_delete, to_keep;
         for (auto* e : m_op_cache) {            
-            if (e->m_result != null_bdd) {
-                to_delete.push_back(e);
+            if (e->m_result == null_bdd ||
+                (keep_computed && reachable[e->m_bdd1] && reachable[e->m_bdd2] && reachable[e->m_op] && reachable[e->m_result])) {
+                to_keep.push_back(e);
             }
             else {
-                to_keep.push_back(e);
+                to_delete.push_back(e);
             }
         }
         m_op_cache.reset();
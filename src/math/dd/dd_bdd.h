@@ -101,7 +101,7 @@ namespace dd {
 
         struct eq_entry {
             bool operator()(op_entry * a, op_entry * b) const { 
-                return a->m_bdd1 == b->m_bdd2 && a->m_bdd2 == b->m_bdd2 && a->m_op == b->m_op;
+                return a->m_bdd1 == b->m_bdd1 && a->m_bdd2 == b->m_bdd2 && a->m_op == b->m_op;
             }
         };
 
@@ -196,6 +196,7 @@ namespace dd {
     bool pdd_manager::check_result(op_entry*& e1, op_entry const* e2, PDD a, PDD b, PDD c) {
         if (e1 != e2) {
             SASSERT(e2->m_result != null_pdd);
+            ++m_stats.m_num_cache_hits;
             push_entry(e1);
             e1 = nullptr;
             return true;            
@@ -890,7 +891,9 @@ namespace dd {
             e = m_node_table.insert_if_not_there2(n);
             e->get_data().m_refcount = 0;      
         }
-        if (do_gc) {
+        // grow the node vector only if garbage collection did not free a third of the nodes,
+        // so that nodes are reused before the vector gets sparse.
+        if (do_gc && (m_free_nodes.empty() || m_free_nodes.size()*3 < m_nodes.size())) {
             if (m_nodes.size() > m_max_num_nodes) {
                 throw mem_out();
             }
@@ -1128,6 +1131,7 @@ namespace dd {
     }
 
     void pdd_manager::gc() {
+        ++m_stats.m_num_gc;
         init_dmark();
         m_free_nodes.reset();
         SASSERT(well_formed());
@@ -1150,13 +1154,17 @@ namespace dd {
         std::sort(m_free_nodes.begin(), m_free_nodes.end());
         m_free_nodes.reverse();
 
+        // keep the computed entries whose arguments and result survive.
+        // The cache is flushed when it outgrows the node table.
+        bool keep_computed = m_op_cache.size() <= 2 * m_nodes.size();
         ptr_vector<op_entry> to_delete, to_keep;
         for (auto* e : m_op_cache) {            
-            if (e->m_result != null_pdd) {
-                to_delete.push_back(e);
+            if (e->m_result == null_pdd ||
+                (keep_computed && reachable[e->m_pdd1] && reachable[e->m_pdd2] && reachable[e->m_result])) {
+                to_keep.push_back(e);
             }
             else {
-                to_keep.push_back(e);
+                to_delete.push_back(e);
             }
         }
         m_op_cache.reset();
@@ -1178,6 +1186,14 @@ namespace dd {
         SASSERT(well_formed());
     }
 
+    void pdd_manager::collect_statistics(statistics& st) const {
+        st.update("pdd nodes", m_nodes.size());
+        st.update("pdd free nodes", m_free_nodes.size());
+        st.update("pdd gc", m_stats.m_num_gc);
+        st.update("pdd cache entries", m_op_cache.size());
+        st.update("pdd cache hits", m_stats.m_num_cache_hits);
+    }
+
     void pdd_manager::init_mark() {
         m_mark.resize(m_nodes.size());
         ++m_mark_level;
@@ -34,6 +34,7 @@ Author:
 #include "util/map.h"
 #include "util/small_object_allocator.h"
 #include "util/rational.h"
+#include "util/statistics.h"
 
 namespace dd {
     class test;
@@ -134,12 +135,17 @@ namespace dd {
 
         struct eq_entry {
             bool operator()(op_entry * a, op_entry * b) const { 
-                return a->m_pdd1 == b->m_pdd2 && a->m_pdd2 == b->m_pdd2 && a->m_op == b->m_op;
+                return a->m_pdd1 == b->m_pdd1 && a->m_pdd2 == b->m_pdd2 && a->m_op == b->m_op;
             }
         };
 
         typedef ptr_hashtable<op_entry, hash_entry, eq_entry> op_table;
 
+        struct stats {
+            unsigned m_num_gc { 0 };
+            unsigned m_num_cache_hits { 0 };
+        };
+
         svector<node>              m_nodes;
         vector<rational>           m_values;
         op_table                   m_op_cache;
@@ -165,6 +171,7 @@ namespace dd {
         rational                   m_freeze_value;
         rational                   m_mod2N;
         unsigned                   m_power_of_2 { 0 };
+        stats                      m_stats;
 
         void reset_op_cache();
         void init_nodes(unsigned_vector const& l2v);
@@ -265,6 +272,7 @@ namespace dd {
 
         void reset(unsigned_vector const& level2var);
         void set_max_num_nodes(unsigned n) { m_max_num_nodes = n; }
+        void collect_statistics(statistics& st) const;
         unsigned_vector const& get_level2var() const { return m_level2var; }
 
         pdd mk_var(unsigned i);
@@ -651,7 +651,9 @@ hilbert_basis::hilbert_basis(reslimit& lim):
     m_limit(lim),
     m_use_support(true),
     m_use_ordered_support(true),
-    m_use_ordered_subsumption(true)
+    m_use_ordered_subsumption(true),
+    m_max_resolves(UINT_MAX),
+    m_resolve_limit(UINT_MAX)
 {
     m_index = alloc(index, *this);
     m_passive = alloc(passive, *this);
@@ -699,6 +701,7 @@ void hilbert_basis::collect_statistics(statistics& st) const {
     st.update("hb.num_subsumptions", m_stats.m_num_subsumptions);
     st.update("hb.num_resolves", m_stats.m_num_resolves);
     st.update("hb.num_saturations", m_stats.m_num_saturations);
+    st.update("hb.num_early_terminations", m_stats.m_num_early_terminations);
     st.update("hb.basis_size", get_basis_size());
     m_index->collect_statistics(st);
 }
@@ -804,6 +807,7 @@ void hilbert_basis::add_unit_vector(unsigned i, numeral const& e) {
 lbool hilbert_basis::saturate() {
     init_basis();
     m_current_ineq = 0;
+    m_resolve_limit = m_max_resolves > UINT_MAX - m_stats.m_num_resolves ? UINT_MAX : m_stats.m_num_resolves + m_max_resolves;
     while (checkpoint() && m_current_ineq < m_ineqs.size()) {
         select_inequality();
         stopwatch sw;
@@ -818,12 +822,16 @@ lbool hilbert_basis::saturate() {
                    });
 
         ++m_stats.m_num_saturations;
+        if (r == l_undef) {
+            ++m_stats.m_num_early_terminations;
+        }
         if (r != l_true) {
             return r;
         }        
         ++m_current_ineq;
     }
     if (!checkpoint()) {
+        ++m_stats.m_num_early_terminations;
         return l_undef;
     }
     return l_true;
@@ -1113,7 +1121,7 @@ hilbert_basis::offset_t hilbert_basis::alloc_vector() {
 }
 
 bool hilbert_basis::checkpoint() {
-    return m_limit.inc();
+    return m_limit.inc() && m_stats.m_num_resolves < m_resolve_limit;
 }
 
 bool hilbert_basis::add_goal(offset_t idx) {
@@ -70,6 +70,7 @@ class hilbert_basis {
         unsigned m_num_subsumptions;
         unsigned m_num_resolves;
         unsigned m_num_saturations;
+        unsigned m_num_early_terminations;
         stats() { reset(); }
         void reset() { memset(this, 0, sizeof(*this)); }
     };
@@ -105,6 +106,8 @@ class hilbert_basis {
     bool               m_use_support;             // parameter: (associativity) resolve only against vectors that are initially in basis.
     bool               m_use_ordered_support;     // parameter: (commutativity) resolve in order
     bool               m_use_ordered_subsumption; // parameter
+    unsigned           m_max_resolves;            // parameter: resolution steps before saturate gives up.
+    unsigned           m_resolve_limit;
 
 
     class iterator {
@@ -166,6 +169,7 @@ public:
     void set_use_support(bool b) { m_use_support = b; }
     void set_use_ordered_support(bool b) { m_use_ordered_support = b; }
     void set_use_ordered_subsumption(bool b) { m_use_ordered_subsumption = b; }
+    void set_max_resolves(unsigned n) { m_max_resolves = n; }
 
     // add inequality v*x >= 0
     // add inequality v*x <= 0
@@ -26,6 +26,28 @@ Revision History:
 #include "math/lp/test_bound_analyzer.h"
 
 namespace lp {
+
+/*
+  Activity of a row sum a_j*x_j: the sums of the finite lower and upper
+  bounds of the monoids a_j*x_j, together with the number of monoids that
+  are unbounded from below or above. The row positions of the unbounded
+  monoids are summed, so when there is exactly one of them its position is
+  known without scanning the row.
+*/
+struct row_activity {
+    uint64_t m_stamp { 0 };      // row stamp of the matrix when the activity was computed
+    unsigned m_epoch { UINT_MAX };
+    bool     m_has_big { false };
+    mpq      m_min;
+    mpq      m_max;
+    unsigned m_min_inf { 0 };
+    unsigned m_max_inf { 0 };
+    unsigned m_min_inf_pos { 0 };
+    unsigned m_max_inf_pos { 0 };
+    unsigned m_min_strict { 0 };
+    unsigned m_max_strict { 0 };
+};
+
 template <typename C, typename B> // C plays a role of a container, B - lp_bound_propagator
 class bound_analyzer_on_row {
     const C&                           m_row;
@@ -35,6 +57,7 @@ class bound_analyzer_on_row {
     // -1 means that such a value is not found, -2 means that at least two of such monoids were found
     int                                m_column_of_l; // index of an unlimited from below monoid
     impq                               m_rs;
+    row_activity const*                m_activity;
 
 public :
     // constructor
@@ -50,7 +73,8 @@ public :
         m_row_index(row_or_term_index),
         m_column_of_u(-1),
         m_column_of_l(-1),
-        m_rs(rs)
+        m_rs(rs),
+        m_activity(nullptr)
     {}
 
     
@@ -63,14 +87,37 @@ public :
         a.analyze();
     }
 
+    // the same as analyze_row, but the row sums are taken from the activity of the row
+    static void analyze_row(const C & row,
+                            row_activity const& act,
+                            const numeric_pair<mpq>& rs,
+                            unsigned row_or_term_index,
+                            B & bp) {
+        bound_analyzer_on_row a(row, null_ci, rs, row_or_term_index, bp);
+        a.analyze(act);
+    }
+
 private:
 
+    void analyze(row_activity const& act) {
+        if (act.m_min_inf > 1 && act.m_max_inf > 1)
+            return;
+        m_activity = &act;
+        m_column_of_u = act.m_max_inf == 0 ? -1 : act.m_max_inf == 1 ? static_cast<int>(m_row[act.m_max_inf_pos].var()) : -2;
+        m_column_of_l = act.m_min_inf == 0 ? -1 : act.m_min_inf == 1 ? static_cast<int>(m_row[act.m_min_inf_pos].var()) : -2;
+        limit_monoids();
+    }
+
     void analyze() {
         for (const auto & c : m_row) {
             if ((m_column_of_l == -2) && (m_column_of_u == -2))
                 return;
             analyze_bound_on_var_on_coeff(c.var(), c.coeff());
         }
+        limit_monoids();
+    }
+
+    void limit_monoids() {
         if (m_column_of_u >= 0)
             limit_monoid_u_from_below();
         else if (m_column_of_u == -1)
@@ -168,11 +215,17 @@ private:
         int strict = 0;
         m_total.reset();
         lp_assert(is_zero(m_total));
-        for (const auto& p : m_row) {
-            bool str;
-            m_total -= monoid_min(p.coeff(), p.var(), str);
-            if (str)
-                strict++;
+        if (m_activity) {
+            m_total -= m_activity->m_min;
+            strict = m_activity->m_min_strict;
+        }
+        else {
+            for (const auto& p : m_row) {
+                bool str;
+                m_total -= monoid_min(p.coeff(), p.var(), str);
+                if (str)
+                    strict++;
+            }
         }
         
         for (const auto &p : m_row) {
@@ -194,11 +247,17 @@ private:
         int strict = 0;
         m_total.reset();
         lp_assert(is_zero(m_total));
-        for (const auto &p : m_row) {
-            bool str;
-            m_total -= monoid_max(p.coeff(), p.var(), str);
-            if (str)
-                strict++;
+        if (m_activity) {
+            m_total -= m_activity->m_max;
+            strict = m_activity->m_max_strict;
+        }
+        else {
+            for (const auto &p : m_row) {
+                bool str;
+                m_total -= monoid_max(p.coeff(), p.var(), str);
+                if (str)
+                    strict++;
+            }
         }
 
         for (const auto& p : m_row) {
@@ -225,16 +284,24 @@ private:
         unsigned j;
         m_bound = -m_rs.x;
         bool strict = false;
-        for (const auto& p : m_row) {
-            j = p.var();
-            if (j == static_cast<unsigned>(m_column_of_u)) {
-                u_coeff = p.coeff();
-                continue;
+        if (m_activity) {
+            // the unlimited monoid does not contribute to the activity
+            u_coeff = m_row[m_activity->m_max_inf_pos].coeff();
+            m_bound -= m_activity->m_max;
+            strict = m_activity->m_max_strict > 0;
+        }
+        else {
+            for (const auto& p : m_row) {
+                j = p.var();
+                if (j == static_cast<unsigned>(m_column_of_u)) {
+                    u_coeff = p.coeff();
+                    continue;
+                }
+                bool str;
+                m_bound -= monoid_max(p.coeff(), j, str);
+                if (str)
+                    strict = true;
             }
-            bool str;
-            m_bound -= monoid_max(p.coeff(), j, str);
-            if (str)
-                strict = true;
         }
 
         m_bound /= u_coeff;
@@ -254,17 +321,24 @@ private:
         unsigned j;
         m_bound = -m_rs.x;
         bool strict = false;
-        for (const auto &p : m_row) {
-            j = p.var();
-            if (j == static_cast<unsigned>(m_column_of_l)) {
-                l_coeff = p.coeff();
-                continue;
+        if (m_activity) {
+            l_coeff = m_row[m_activity->m_min_inf_pos].coeff();
+            m_bound -= m_activity->m_min;
+            strict = m_activity->m_min_strict > 0;
+        }
+        else {
+            for (const auto &p : m_row) {
+                j = p.var();
+                if (j == static_cast<unsigned>(m_column_of_l)) {
+                    l_coeff = p.coeff();
+                    continue;
+                }
+
+                bool str;
+                m_bound -= monoid_min(p.coeff(), j, str);
+                if (str)
+                    strict = true;
             }
-
-            bool str;
-            m_bound -= monoid_min(p.coeff(), j, str);
-            if (str)
-                strict = true;
         }
         m_bound /= l_coeff;
         if (is_pos(l_coeff)) {
@@ -408,8 +408,119 @@ int gomory::find_basic_var() {
     return result;
 }
     
+namespace {
+    // sparse coefficients of a cut in doubles, normalized to unit length
+    struct cut_vector {
+        vector<std::pair<unsigned, double>> m_coeffs;
+        double m_efficacy;
+        unsigned m_index;
+    };
+
+    double dot(cut_vector const& a, cut_vector const& b) {
+        double r = 0;
+        unsigned i = 0, j = 0;
+        while (i < a.m_coeffs.size() && j < b.m_coeffs.size()) {
+            unsigned u = a.m_coeffs[i].first, v = b.m_coeffs[j].first;
+            if (u == v)
+                r += a.m_coeffs[i++].second * b.m_coeffs[j++].second;
+            else if (u < v)
+                ++i;
+            else
+                ++j;
+        }
+        return r;
+    }
+}
+
+/**
+   \brief create cuts from several rows and keep the ones that are violated most
+   relative to their norm (efficacy) and that are not nearly parallel to a cut
+   with higher efficacy. The best cut is returned in lia.m_t, lia.m_k, the
+   others are queued in lia.m_cuts.
+*/
+lia_move gomory::cut_batch() {
+    unsigned batch = lia.settings().m_gomory_batch;
+    vector<std::pair<unsigned, unsigned>> rows; // row size, basic column
+    for (unsigned j : lra.r_basis()) {
+        if (!lia.column_is_int_inf(j))
+            continue;
+        const row_strip<mpq>& row = lra.get_row(lia.row_of_basic_column(j));
+        if (is_gomory_cut_target(row))
+            rows.push_back(std::make_pair(row.size(), j));
+    }
+    if (rows.empty())
+        return lia_move::undef;
+    std::sort(rows.begin(), rows.end());
+    if (rows.size() > 4 * batch)
+        rows.shrink(4 * batch);
+
+    vector<int_solver::cut> cuts;
+    vector<cut_vector> vectors;
+    const auto & x = lra.r_x();
+    for (auto const& [sz, j] : rows) {
+        const row_strip<mpq>& row = lra.get_row(lia.row_of_basic_column(j));
+        explanation ex;
+        lia.m_t.clear();
+        lia.m_k.reset();
+        lia_move r = cut(lia.m_t, lia.m_k, &ex, j, row);
+        if (r == lia_move::conflict) {
+            lia.m_ex->add_expl(ex);
+            return r;
+        }
+        if (r != lia_move::cut)
+            continue;
+        cut_vector cv;
+        double norm = 0;
+        for (lar_term::ival p : lia.m_t) {
+            double c = p.coeff().get_double();
+            cv.m_coeffs.push_back(std::make_pair(p.column().index(), c));
+            norm += c * c;
+        }
+        if (norm == 0)
+            continue;
+        norm = sqrt(norm);
+        for (auto & p : cv.m_coeffs)
+            p.second /= norm;
+        std::sort(cv.m_coeffs.begin(), cv.m_coeffs.end());
+        // the cut is t >= k and the current solution has t < k
+        cv.m_efficacy = (lia.m_k - lia.m_t.apply(x).x).get_double() / norm;
+        cv.m_index = cuts.size();
+        vectors.push_back(cv);
+        cuts.push_back(int_solver::cut());
+        cuts.back().m_t = lia.m_t;
+        cuts.back().m_k = lia.m_k;
+        cuts.back().m_ex = ex;
+    }
+    if (cuts.empty())
+        return lia_move::undef;
+
+    std::sort(vectors.begin(), vectors.end(), [](cut_vector const& a, cut_vector const& b) { return a.m_efficacy > b.m_efficacy; });
+    vector<cut_vector const*> selected;
+    for (cut_vector const& cv : vectors) {
+        if (selected.size() >= batch)
+            break;
+        bool parallel = false;
+        for (cut_vector const* s : selected)
+            parallel |= std::abs(dot(cv, *s)) > 0.95;
+        if (!parallel)
+            selected.push_back(&cv);
+    }
+    TRACE("gomory_cut", tout << "batch of " << selected.size() << " cuts from " << cuts.size() << " candidates\n";);
+    // the remaining cuts are returned by next_cut in the order of decreasing efficacy
+    for (unsigned i = selected.size(); i-- > 1; )
+        lia.m_cuts.push_back(cuts[selected[i]->m_index]);
+    int_solver::cut const& best = cuts[selected[0]->m_index];
+    lia.m_t = best.m_t;
+    lia.m_k = best.m_k;
+    lia.m_ex->add_expl(best.m_ex);
+    lia.m_upper = false;
+    return lia_move::cut;
+}
+
 lia_move gomory::operator()() {
     lra.move_non_basic_columns_to_bounds(true);
+    if (lia.settings().m_gomory_batch > 1)
+        return cut_batch();
     int j = find_basic_var();
     if (j == -1) return lia_move::undef;
     unsigned r = lia.row_of_basic_column(j);
@@ -30,6 +30,7 @@ namespace lp {
         int find_basic_var();
         bool is_gomory_cut_target(const row_strip<mpq>& row);
         lia_move cut(lar_term & t, mpq & k, explanation* ex, unsigned basic_inf_int_j, const row_strip<mpq>& row);
+        lia_move cut_batch();
     public:
         gomory(int_solver& lia);
         lia_move operator()();
@@ -25,6 +25,11 @@
 
 namespace nla {
 typedef intervals::interval interv;
+
+// cross_nested stops after reporting 100 forms
+static const unsigned max_cached_forms = 100;
+static const unsigned max_cached_nodes = 100000;
+
 horner::horner(core * c) : common(c), m_row_sum(m_nex_creator) {}
 
 template <typename T>
@@ -87,16 +92,79 @@ bool horner::lemmas_on_row(const T& row) {
     if (!e->is_sum())
         return false;
     
+
+    auto* entry = m_row_cache.find_core(m_row_index);
+    if (entry && equal(entry->get_data().m_value.m_sum, e)) {
+        c().lp_settings().stats().m_horner_cache_hits++;
+        bool ret = lemmas_on_cached_row(entry->get_data().m_value, dep);
+        c().m_intervals.get_dep_intervals().reset();
+        c().invalidate_grobner_basis();
+        return ret;
+    }
+    if (m_cache_creator.size() > max_cached_nodes) {
+        m_row_cache.reset();
+        m_cache_creator.clear();
+    }
+    cached_row new_cr;
+    new_cr.m_sum = m_cache_creator.clone(e);
     cross_nested cn(
-        [this, dep](const nex* n) { return c().m_intervals.check_nex(n, dep); },
+        [this, dep, &new_cr](const nex* n) {
+            if (new_cr.m_forms.size() < max_cached_forms)
+                new_cr.m_forms.push_back(m_cache_creator.clone(n));
+            return c().m_intervals.check_nex(n, dep);
+        },
         [this](unsigned j)   { return c().var_is_fixed(j); },
         [this]() { return c().random(); }, m_nex_creator);
     bool ret = lemmas_on_expr(cn, to_sum(e));
+    if (new_cr.m_forms.size() < max_cached_forms)
+        m_row_cache.insert(m_row_index, new_cr);
+    else
+        m_row_cache.erase(m_row_index);
     c().m_intervals.get_dep_intervals().reset(); // clean the memory allocated by the interval bound dependencies
+    c().invalidate_grobner_basis();
     return ret;
 
 }
 
+bool horner::lemmas_on_cached_row(cached_row const& cr, u_dependency* dep) {
+    for (nex const* n : cr.m_forms) 
+        if (c().m_intervals.check_nex(n, dep))
+            return true;
+    return false;
+}
+
+bool horner::equal(const nex* a, const nex* b) {
+    if (a->type() != b->type())
+        return false;
+    switch (a->type()) {
+    case expr_type::VAR:
+        return to_var(a)->var() == to_var(b)->var();
+    case expr_type::SCALAR:
+        return to_scalar(a)->value() == to_scalar(b)->value();
+    case expr_type::MUL: {
+        nex_mul const& ma = a->to_mul(), &mb = b->to_mul();
+        if (ma.size() != mb.size() || ma.coeff() != mb.coeff())
+            return false;
+        for (unsigned i = 0; i < ma.size(); i++) 
+            if (ma[i].pow() != mb[i].pow() || !equal(ma[i].e(), mb[i].e()))
+                return false;
+        return true;
+    }
+    case expr_type::SUM: {
+        nex_sum const& sa = a->to_sum(), &sb = b->to_sum();
+        if (sa.size() != sb.size())
+            return false;
+        for (unsigned i = 0; i < sa.size(); i++) 
+            if (!equal(sa[i], sb[i]))
+                return false;
+        return true;
+    }
+    default:
+        UNREACHABLE();
+        return false;
+    }
+}
+
 bool horner::horner_lemmas() {
     if (!c().m_nla_settings.run_horner()) {
         TRACE("nla_solver", tout << "not generating horner lemmas\n";);
@@ -24,14 +24,26 @@
 #include "math/lp/nex.h"
 #include "math/lp/cross_nested.h"
 #include "math/lp/u_set.h"
+#include "util/map.h"
 
 namespace nla {
 class core;
 
 
 class horner : common {
+    // The cross-nested forms explored for a row. They are replayed
+    // while the simplified sum of the row does not change.
+    struct cached_row {
+        nex*            m_sum = nullptr;
+        ptr_vector<nex> m_forms;
+    };
     nex_creator::sum_factory  m_row_sum;
     unsigned         m_row_index;                      
+    nex_creator      m_cache_creator;
+    u_map<cached_row> m_row_cache;
+
+    static bool equal(const nex* a, const nex* b);
+    bool lemmas_on_cached_row(cached_row const& cr, u_dependency* dep);
 public:
     typedef intervals::interval interv;
     horner(core *core);
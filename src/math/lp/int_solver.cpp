@@ -149,6 +149,7 @@ lia_move int_solver::check(lp::explanation * e) {
     m_ex = e;
     m_ex->clear();
     m_upper = false;
+    m_cuts.reset();
     lia_move r = lia_move::undef;
 
     if (m_gcd.should_apply()) r = m_gcd();
@@ -167,6 +168,19 @@ lia_move int_solver::check(lp::explanation * e) {
     return r;
 }
 
+bool int_solver::next_cut() {
+    if (m_cuts.empty())
+        return false;
+    cut& c = m_cuts.back();
+    m_t = c.m_t;
+    m_k = c.m_k;
+    m_upper = false;
+    m_ex->clear();
+    m_ex->add_expl(c.m_ex);
+    m_cuts.pop_back();
+    return true;
+}
+
 std::ostream& int_solver::display_inf_rows(std::ostream& out) const {
     unsigned num = lra.A_r().column_count();
     for (unsigned v = 0; v < num; v++) {
@@ -68,6 +68,14 @@ class int_solver {
     bool                m_upper;           // we have a cut m_t*x <= k if m_upper is true nad m_t*x >= k otherwise
     hnf_cutter          m_hnf_cutter;
     unsigned            m_hnf_cut_period;
+
+    // additional cuts m_t >= m_k of a batch of gomory cuts
+    struct cut {
+        lar_term    m_t;
+        mpq         m_k;
+        explanation m_ex;
+    };
+    vector<cut>         m_cuts;
 public:
     int_solver(lar_solver& lp);
     
@@ -77,6 +85,8 @@ public:
     lar_term const& get_term() const { return m_t; }
     mpq const& get_offset() const { return m_k; }
     bool is_upper() const { return m_upper; }
+    // move the next cut of the last batch into the term, offset and explanation.
+    bool next_cut();
     bool is_base(unsigned j) const;
     bool is_real(unsigned j) const;
     const impq & lower_bound(unsigned j) const;
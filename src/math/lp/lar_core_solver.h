@@ -128,6 +128,8 @@ public:
 
     void solve();
 
+    void solve_with_double_filter();
+
     bool lower_bounds_are_set() const { return true; }
 
     const indexed_vector<mpq> & get_pivot_row() const {
@@ -384,7 +386,7 @@ public:
     // here we compact the trace as we go to avoid unnecessary column changes
     template <typename L, typename K> 
     void catch_up_in_lu(const vector<unsigned> & trace_of_basis_change, const vector<int> & basis_heading, lp_primal_core_solver<L,K> & cs) {
-        if (cs.m_factorization == nullptr || cs.m_factorization->m_refactor_counter + trace_of_basis_change.size()/2 >= 200) {
+        if (cs.m_factorization == nullptr || cs.m_factorization->m_refactor_counter + trace_of_basis_change.size()/2 >= settings().lu_refactor_period) {
             for (unsigned i = 0; i < trace_of_basis_change.size(); i+= 2) {
                 unsigned entering = trace_of_basis_change[i];
                 unsigned leaving = trace_of_basis_change[i+1];
@@ -629,21 +631,25 @@ public:
     }
 
     void get_bounds_for_double_solver() {
+        get_bounds_for_double_solver(m_d_lower_bounds, m_d_upper_bounds);
+    }
+
+    void get_bounds_for_double_solver(vector<double> & lower_bounds, vector<double> & upper_bounds) {
         unsigned n = m_n();
-        m_d_lower_bounds.resize(n);
-        m_d_upper_bounds.resize(n);
+        lower_bounds.resize(n);
+        upper_bounds.resize(n);
         double delta = find_delta_for_strict_boxed_bounds().get_double();
         if (delta > 0.000001)
             delta = 0.000001;
         for (unsigned j = 0; j < n; j++) {
             if (lower_bound_is_set(j)) {
                 const auto & lb = m_r_solver.m_lower_bounds[j];
-                m_d_lower_bounds[j] = lb.x.get_double() + delta * lb.y.get_double();
+                lower_bounds[j] = lb.x.get_double() + delta * lb.y.get_double();
             }
             if (upper_bound_is_set(j)) {
                 const auto & ub = m_r_solver.m_upper_bounds[j];
-                m_d_upper_bounds[j] = ub.x.get_double() + delta * ub.y.get_double();
-                lp_assert(!lower_bound_is_set(j) || (m_d_upper_bounds[j] >= m_d_lower_bounds[j]));
+                upper_bounds[j] = ub.x.get_double() + delta * ub.y.get_double();
+                lp_assert(!lower_bound_is_set(j) || (upper_bounds[j] >= lower_bounds[j]));
             }
         }
     }
@@ -698,6 +704,64 @@ public:
     }
 
 
+    bool need_to_filter_with_doubles() const {
+        return settings().m_double_filter &&
+            settings().use_tableau_rows() &&
+            m_r_A.row_count() >= settings().min_rows_for_double_filter &&
+            m_r_solver.inf_set_size() > 1;
+    }
+
+    /**
+       \brief run the simplex in doubles on a copy of the tableau, starting from the current basis.
+       Return the trace of basis changes; heading_d receives the final basis heading
+       and signature the positions of the non-basic columns.
+       The trace is empty if the floating point solver did not succeed.
+    */
+    vector<unsigned> find_solution_signature_with_doubles_tableau(lar_solution_signature & signature, vector<int> & heading_d) {
+        unsigned m = m_r_A.row_count(), n = m_r_A.column_count();
+        static_matrix<double, double> A(m, n);
+        create_double_matrix(A);
+        vector<double> lower_bounds, upper_bounds;
+        get_bounds_for_double_solver(lower_bounds, upper_bounds);
+        vector<unsigned> basis_d, nbasis_d;
+        fill_basis_d(basis_d, heading_d, nbasis_d);
+        vector<double> b(m), costs(n);
+        vector<double> x(n);
+        double delta = find_delta_for_strict_bounds(find_delta_for_strict_boxed_bounds()).get_double();
+        if (delta > 0.000001)
+            delta = 0.000001;
+        for (unsigned j = 0; j < n; j++)
+            x[j] = m_r_x[j].x.get_double() + delta * m_r_x[j].y.get_double();
+        // recompute the basic columns so that A x = 0 holds in doubles
+        for (unsigned i = 0; i < m; i++) {
+            unsigned bj = basis_d[i];
+            double v = 0;
+            for (auto const & c : A.m_rows[i])
+                if (c.var() != bj)
+                    v -= c.coeff() * x[c.var()];
+            x[bj] = v;
+        }
+
+        lp_primal_core_solver<double, double> ds(A, b, x, basis_d, nbasis_d, heading_d, costs,
+                                                 m_column_types(), lower_bounds, upper_bounds,
+                                                 settings(), m_r_solver.m_column_names);
+        ds.m_costs.resize(n);
+        ds.m_d.resize(n);
+        for (unsigned j = 0; j < n; j++)
+            if (!ds.column_is_feasible(j))
+                ds.insert_column_into_inf_set(j);
+
+        // the floating point search is a heuristic, keep it short
+        flet<unsigned> _max_iterations(settings().max_total_number_of_iterations, 10 * m + 1000);
+        ds.start_tracing_basis_changes();
+        ds.find_feasible_solution();
+        ds.stop_tracing_basis_changes();
+        if (settings().get_cancel_flag() || ds.get_status() == lp_status::FLOATING_POINT_ERROR)
+            return vector<unsigned>();
+        extract_signature_from_lp_core_solver(ds, signature);
+        return ds.m_trace_of_basis_change_vector;
+    }
+
     bool lower_bound_is_set(unsigned j) const {
         switch (m_column_types[j]) {
         case column_type::free_column:
@@ -136,6 +136,29 @@ unsigned lar_core_solver::get_number_of_non_ints() const {
     return n;
 }
 
+/**
+   \brief find a candidate basis with the simplex in doubles, then move the exact
+   tableau to that basis and repair the solution with the exact simplex.
+*/
+void lar_core_solver::solve_with_double_filter() {
+    ++settings().stats().m_double_filter_calls;
+    lar_solution_signature signature;
+    vector<int> heading_d;
+    vector<unsigned> changes_of_basis = find_solution_signature_with_doubles_tableau(signature, heading_d);
+    if (settings().get_cancel_flag()) {
+        m_r_solver.set_status(lp_status::TIME_EXHAUSTED);
+        return;
+    }
+    if (!changes_of_basis.empty()) {
+        settings().stats().m_double_filter_pivots += changes_of_basis.size() / 2;
+        // if a pivot is degenerate in exact arithmetic the replay stops and
+        // the signature is used partially
+        catch_up_in_lu_tableau(changes_of_basis, heading_d);
+        prepare_solver_x_with_signature_tableau(signature);
+    }
+    m_r_solver.find_feasible_solution();
+}
+
 void lar_core_solver::solve() {
     TRACE("lar_solver", tout << m_r_solver.get_status() << "\n";);
     lp_assert(m_r_solver.non_basic_columns_are_set_correctly());
@@ -164,6 +187,12 @@ void lar_core_solver::solve() {
             solve_on_signature(solution_signature, changes_of_basis);
 
         lp_assert(!settings().use_tableau() || r_basis_is_OK());
+    } else if (need_to_filter_with_doubles()) {
+        TRACE("lar_solver", tout << "filtering with doubles\n";);
+        solve_with_double_filter();
+        if (m_r_solver.get_status() == lp_status::TIME_EXHAUSTED)
+            return;
+        lp_assert(r_basis_is_OK());
     } else {
         if (!settings().use_tableau()) {
             TRACE("lar_solver", tout << "no tablau\n";);
@@ -149,6 +149,121 @@ namespace lp {
         return false;
     }
 
+    void lar_solver::set_activity_bounds(unsigned j) {
+        m_activity_bounds.reserve(j + 1);
+        auto& b = m_activity_bounds[j];
+        b.m_epoch = m_activity_epoch;
+        b.m_has_lower = column_has_lower_bound(j);
+        b.m_has_upper = column_has_upper_bound(j);
+        if (b.m_has_lower) {
+            auto const& l = m_mpq_lar_core_solver.m_r_lower_bounds()[j];
+            b.m_lower = l.x;
+            b.m_lower_strict = !is_zero(l.y);
+        }
+        if (b.m_has_upper) {
+            auto const& u = m_mpq_lar_core_solver.m_r_upper_bounds()[j];
+            b.m_upper = u.x;
+            b.m_upper_strict = !is_zero(u.y);
+        }
+    }
+
+    static void update_activity_side(mpq& sum, unsigned& num_inf, unsigned& inf_pos, unsigned& num_strict,
+                                     unsigned pos, const mpq& coeff, bool has_bound, const mpq& bound, bool strict, bool add) {
+        if (!has_bound) {
+            if (add) {
+                num_inf++;
+                inf_pos += pos;
+            }
+            else {
+                num_inf--;
+                inf_pos -= pos;
+            }
+        }
+        else if (add) {
+            sum.addmul(coeff, bound);
+            num_strict += strict;
+        }
+        else {
+            sum.submul(coeff, bound);
+            num_strict -= strict;
+        }
+    }
+
+    // add or remove the contribution of the monoid coeff*x_j at position pos of the row
+    void lar_solver::update_row_activity(row_activity& a, unsigned pos, const mpq& coeff, activity_bounds const& b, bool add) {
+        if (coeff.is_pos()) {
+            update_activity_side(a.m_min, a.m_min_inf, a.m_min_inf_pos, a.m_min_strict, pos, coeff, b.m_has_lower, b.m_lower, b.m_lower_strict, add);
+            update_activity_side(a.m_max, a.m_max_inf, a.m_max_inf_pos, a.m_max_strict, pos, coeff, b.m_has_upper, b.m_upper, b.m_upper_strict, add);
+        }
+        else {
+            update_activity_side(a.m_min, a.m_min_inf, a.m_min_inf_pos, a.m_min_strict, pos, coeff, b.m_has_upper, b.m_upper, b.m_upper_strict, add);
+            update_activity_side(a.m_max, a.m_max_inf, a.m_max_inf_pos, a.m_max_strict, pos, coeff, b.m_has_lower, b.m_lower, b.m_lower_strict, add);
+        }
+    }
+
+    bool lar_solver::row_activity_is_valid(unsigned i) const {
+        if (i >= m_row_activities.size())
+            return false;
+        auto const& a = m_row_activities[i];
+        return a.m_epoch == m_activity_epoch && a.m_stamp == A_r().row_stamp(i);
+    }
+
+    void lar_solver::init_row_activity(unsigned i) {
+        m_row_activities.reserve(i + 1);
+        auto& a = m_row_activities[i];
+        a.m_stamp = A_r().row_stamp(i);
+        a.m_epoch = m_activity_epoch;
+        a.m_has_big = false;
+        a.m_min.reset();
+        a.m_max.reset();
+        a.m_min_inf = a.m_max_inf = 0;
+        a.m_min_inf_pos = a.m_max_inf_pos = 0;
+        a.m_min_strict = a.m_max_strict = 0;
+        auto const& row = A_r().m_rows[i];
+        for (unsigned k = 0; k < row.size(); ++k) {
+            auto const& c = row[k];
+            if (c.coeff().is_big()) {
+                // the row is not used for propagation and its activity is not maintained
+                a.m_has_big = true;
+                return;
+            }
+            unsigned j = c.var();
+            if (j >= m_activity_bounds.size() || m_activity_bounds[j].m_epoch != m_activity_epoch)
+                set_activity_bounds(j);
+            update_row_activity(a, k, c.coeff(), m_activity_bounds[j], true);
+        }
+    }
+
+    // Update the activities of the valid rows for the columns with changed bounds.
+    // Every column of a valid row has bounds of the current epoch.
+    void lar_solver::update_row_activities() {
+        activity_bounds old;
+        for (unsigned j : m_activity_dirty_columns) {
+            if (j >= A_r().column_count() || j >= m_activity_bounds.size() ||
+                m_activity_bounds[j].m_epoch != m_activity_epoch)
+                continue;
+            std::swap(old, m_activity_bounds[j]);
+            set_activity_bounds(j);
+            for (auto const& cc : A_r().m_columns[j]) {
+                unsigned i = cc.var();
+                if (!row_activity_is_valid(i) || m_row_activities[i].m_has_big)
+                    continue;
+                const mpq& coeff = A_r().m_rows[i][cc.offset()].coeff();
+                update_row_activity(m_row_activities[i], cc.offset(), coeff, old, false);
+                update_row_activity(m_row_activities[i], cc.offset(), coeff, m_activity_bounds[j], true);
+            }
+        }
+        m_activity_dirty_columns.reset();
+    }
+
+    row_activity const& lar_solver::get_row_activity(unsigned i) {
+        if (!m_activity_dirty_columns.empty())
+            update_row_activities();
+        if (!row_activity_is_valid(i))
+            init_row_activity(i);
+        return m_row_activities[i];
+    }
+
     void lar_solver::substitute_basis_var_in_terms_for_row(unsigned i) {
         // todo : create a map from term basic vars to the rows where they are used
         unsigned basis_j = m_mpq_lar_core_solver.m_r_solver.m_basis[i];
@@ -278,6 +393,9 @@ namespace lp {
         remove_non_fixed_from_fixed_var_table();
         clean_popped_elements(n, m_columns_with_changed_bounds);
         clean_popped_elements(n, m_incorrect_columns);
+        // bounds are restored without notification, the activities have to be recomputed
+        m_activity_dirty_columns.reset();
+        ++m_activity_epoch;
 
         for (auto rid : m_row_bounds_to_replay)
             insert_row_with_changed_bounds(rid);
@@ -2528,6 +2646,51 @@ namespace lp {
         m_mpq_lar_core_solver.m_r_solver.pivot_column_tableau(j, row_index);
         m_mpq_lar_core_solver.m_r_solver.change_basis(j, r_basis()[row_index]);
     }
+
+    /**
+       \brief pivot the columns that were basic into the basis, replacing columns
+       that were not basic, and move the non-basic columns to their previous values
+       when these are within bounds. The columns that leave the basis are moved to
+       a bound, so the values stay consistent with the tableau.
+    */
+    void lar_solver::apply_column_hints(vector<column_hint> const& hints) {
+        if (!use_tableau() || tableau_with_costs())
+            return;
+        auto& slv = m_mpq_lar_core_solver.m_r_solver;
+        unsigned n = A_r().column_count();
+        svector<bool> hinted_basic(n, false);
+        for (auto const& h : hints)
+            if (h.m_column < n && h.m_is_basic)
+                hinted_basic[h.m_column] = true;
+        for (auto const& h : hints) {
+            unsigned j = h.m_column;
+            if (j >= n || !h.m_is_basic || is_base(j))
+                continue;
+            for (auto const& c : A_r().m_columns[j]) {
+                unsigned bj = r_basis()[c.var()];
+                if (hinted_basic[bj])
+                    continue;
+                pivot_column_tableau(j, c.var());
+                impq delta;
+                if (slv.make_column_feasible(bj, delta))
+                    change_basic_columns_dependend_on_a_given_nb_column(bj, delta);
+                remove_column_from_inf_set(bj);
+                slv.track_column_feasibility(j);
+                break;
+            }
+        }
+        for (auto const& h : hints) {
+            unsigned j = h.m_column;
+            if (j >= n || is_base(j) || h.m_value == get_column_value(j))
+                continue;
+            if (column_has_lower_bound(j) && h.m_value < column_lower_bound(j))
+                continue;
+            if (column_has_upper_bound(j) && h.m_value > column_upper_bound(j))
+                continue;
+            set_value_for_nbasic_column(j, h.m_value);
+        }
+        set_status(lp_status::UNKNOWN);
+    }
 } // namespace lp
 
 
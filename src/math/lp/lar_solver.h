@@ -35,6 +35,7 @@
 #include "math/lp/lp_primal_core_solver.h"
 #include "math/lp/random_updater.h"
 #include "util/stacked_value.h"
+#include "util/uint_set.h"
 #include "math/lp/stacked_vector.h"
 #include "math/lp/implied_bound.h"
 #include "math/lp/bound_analyzer_on_row.h"
@@ -91,6 +92,23 @@ class lar_solver : public column_namer {
     u_set                                               m_columns_with_changed_bounds;
     u_set                                               m_rows_with_changed_bounds;
     unsigned_vector                                     m_row_bounds_to_replay;
+    // activities of the tableau rows used by bound propagation.
+    // m_activity_bounds[j] holds the bounds of column j seen by the activities,
+    // the activities are brought up to date for the columns in m_activity_dirty_columns.
+    // The epoch is increased on pop, when all activities become invalid
+    struct activity_bounds {
+        unsigned m_epoch { UINT_MAX };
+        bool     m_has_lower { false };
+        bool     m_has_upper { false };
+        bool     m_lower_strict { false };
+        bool     m_upper_strict { false };
+        mpq      m_lower;
+        mpq      m_upper;
+    };
+    vector<row_activity>                                m_row_activities;
+    vector<activity_bounds>                             m_activity_bounds;
+    indexed_uint_set                                    m_activity_dirty_columns;
+    unsigned                                            m_activity_epoch { 0 };
     
     u_set                                               m_basic_columns_with_changed_cost;
     // these are basic columns with the value changed, so the the corresponding row in the tableau
@@ -141,7 +159,17 @@ class lar_solver : public column_namer {
 
     inline void clear_columns_with_changed_bounds() { m_columns_with_changed_bounds.clear(); }
     inline void increase_by_one_columns_with_changed_bounds() { m_columns_with_changed_bounds.increase_size_by_one(); }
-    inline void insert_to_columns_with_changed_bounds(unsigned j) { m_columns_with_changed_bounds.insert(j); }
+    inline void insert_to_columns_with_changed_bounds(unsigned j) {
+        m_columns_with_changed_bounds.insert(j);
+        if (!m_activity_dirty_columns.contains(j))
+            m_activity_dirty_columns.insert(j);
+    }
+    void set_activity_bounds(unsigned j);
+    static void update_row_activity(row_activity& a, unsigned pos, const mpq& coeff, activity_bounds const& b, bool add);
+    bool row_activity_is_valid(unsigned i) const;
+    void init_row_activity(unsigned i);
+    void update_row_activities();
+    row_activity const& get_row_activity(unsigned i);
     
     void update_column_type_and_bound_check_on_equal(unsigned j, lconstraint_kind kind, const mpq & right_side, constraint_index constr_index, unsigned&);
     void update_column_type_and_bound(unsigned j, lconstraint_kind kind, const mpq & right_side, constraint_index constr_index);
@@ -175,10 +203,21 @@ class lar_solver : public column_namer {
         unsigned row_index,
         lp_bound_propagator<T> & bp ) {
         
-        if (A_r().m_rows[row_index].size() > settings().max_row_length_for_bound_propagation
-            || row_has_a_big_num(row_index))
+        if (A_r().m_rows[row_index].size() > settings().max_row_length_for_bound_propagation)
             return;
         lp_assert(use_tableau());
+        if (settings().m_bprop_row_activities) {
+            row_activity const& act = get_row_activity(row_index);
+            if (!act.m_has_big)
+                bound_analyzer_on_row<row_strip<mpq>, lp_bound_propagator<T>>::analyze_row(A_r().m_rows[row_index],
+                                                                                           act,
+                                                                                           zero_of_type<numeric_pair<mpq>>(),
+                                                                                           row_index,
+                                                                                           bp);
+            return;
+        }
+        if (row_has_a_big_num(row_index))
+            return;
         
         bound_analyzer_on_row<row_strip<mpq>, lp_bound_propagator<T>>::analyze_row(A_r().m_rows[row_index],
                                                                                    null_ci,
@@ -546,6 +585,19 @@ public:
     }
 
     void pivot_column_tableau(unsigned j, unsigned row_index);
+
+    /**
+       \brief state of a column in a previous solver, used to warm start simplex.
+       The basis of the tableau survives pop, the hints transfer it to fresh
+       solvers that are created for clones of a context.
+    */
+    struct column_hint {
+        lpvar m_column;
+        bool  m_is_basic;
+        impq  m_value;
+        column_hint(lpvar j, bool is_basic, impq const& v): m_column(j), m_is_basic(is_basic), m_value(v) {}
+    };
+    void apply_column_hints(vector<column_hint> const& hints);
     
     inline const impq & column_upper_bound(unsigned j) const {
         return m_mpq_lar_core_solver.upper_bound(j);
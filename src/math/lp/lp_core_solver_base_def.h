@@ -598,6 +598,7 @@ divide_row_by_pivot(unsigned pivot_row, unsigned pivot_col) {
         return false;
     
     this->m_b[pivot_row] /= coeff;
+    m_A.touch_row(pivot_row);
     for (unsigned j = 0; j < size; j++) {
         auto & c = row[j];
         if (c.var() != pivot_col) {
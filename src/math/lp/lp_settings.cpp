@@ -33,4 +33,8 @@ void lp::lp_settings::updt_params(params_ref const& _p) {
     report_frequency = p.arith_rep_freq();
     m_simplex_strategy = static_cast<lp::simplex_strategy_enum>(p.arith_simplex_strategy());
     m_nlsat_delay = p.arith_nl_delay();
+    m_double_filter = p.arith_double_filter();
+    m_gomory_batch = std::max(1u, p.arith_gomory_batch());
+    m_bprop_row_activities = p.arith_bprop_activities();
+    lu_refactor_period = std::max(1u, p.arith_lu_refactor_period());
 }
@@ -123,10 +123,15 @@ struct statistics {
     unsigned m_nla_calls;
     unsigned m_horner_calls;
     unsigned m_horner_conflicts;
+    unsigned m_horner_cache_hits;
     unsigned m_cross_nested_forms;
+    unsigned m_cross_nested_fp_filtered;
     unsigned m_grobner_calls;
     unsigned m_grobner_conflicts;
+    unsigned m_grobner_reuses;
     unsigned m_offset_eqs;
+    unsigned m_double_filter_calls;
+    unsigned m_double_filter_pivots;
     statistics() { reset(); }
     void reset() { memset(this, 0, sizeof(*this)); }
     void collect_statistics(::statistics& st) const {
@@ -144,10 +149,15 @@ struct statistics {
         st.update("arith-hnf-cuts", m_hnf_cuts);
         st.update("arith-horner-calls", m_horner_calls);
         st.update("arith-horner-conflicts", m_horner_conflicts);
+        st.update("arith-horner-cache-hits", m_horner_cache_hits);
         st.update("arith-horner-cross-nested-forms", m_cross_nested_forms);
+        st.update("arith-horner-fp-filtered", m_cross_nested_fp_filtered);
         st.update("arith-grobner-calls", m_grobner_calls);
         st.update("arith-grobner-conflicts", m_grobner_conflicts);
+        st.update("arith-grobner-reuses", m_grobner_reuses);
         st.update("arith-offset-eqs", m_offset_eqs);
+        st.update("arith-double-filter", m_double_filter_calls);
+        st.update("arith-double-filter-pivots", m_double_filter_pivots);
 
     }
 };
@@ -219,6 +229,8 @@ public:
     // end of dual section
     bool                   m_bound_propagation { true };
     bool                   presolve_with_double_solver_for_lar { true };
+    bool                   m_double_filter { false }; // find candidate bases with the simplex in doubles
+    unsigned               min_rows_for_double_filter { 100 };
     simplex_strategy_enum  m_simplex_strategy;
     
     int              report_frequency { 1000 };
@@ -228,9 +240,12 @@ public:
     double           density_threshold { 0.7 };
     bool             use_breakpoints_in_feasibility_search { false };
     unsigned         max_row_length_for_bound_propagation { 300 };
+    bool             m_bprop_row_activities { true }; // cache the row activities for bound propagation
     bool             backup_costs { true };
     unsigned         column_number_threshold_for_using_lu_in_lar_solver { 4000 };
     unsigned         m_int_gomory_cut_period { 4 };
+    unsigned         m_gomory_batch { 1 };  // maximal number of gomory cuts added in one round
+    unsigned         lu_refactor_period { 200 }; // maximal number of column replacements between LU factorizations
     unsigned         m_int_find_cube_period { 4 };
 private:
     unsigned         m_hnf_cut_period { 4 };
@@ -213,6 +213,9 @@ protected:
     // this routing also pins the variables to the boundaries
     bool row_is_obsolete(std::unordered_map<unsigned, T> & row, unsigned row_index );
 
+    // a row with a single column is turned into a bound of the column
+    bool row_is_singleton(std::unordered_map<unsigned, T> & row, unsigned row_index);
+
     void remove_fixed_or_zero_columns();
 
     void remove_fixed_or_zero_columns_from_row(unsigned i, std::unordered_map<unsigned, T> & row);
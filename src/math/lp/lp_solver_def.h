@@ -347,6 +347,52 @@ template <typename T, typename X>    bool lp_solver<T, X>::row_is_obsolete(std::
     return false; // it is unreachable
 }
 
+template <typename T, typename X>    bool lp_solver<T, X>::row_is_singleton(std::unordered_map<unsigned, T> & row, unsigned row_index) {
+    if (row.size() != 1)
+        return false;
+    auto const& t = *row.begin();
+    T a = t.second;
+    if (numeric_traits<T>::is_zero(a))
+        return false;
+    column_info<T> * ci = m_map_from_var_index_to_column_info[t.first];
+    if (ci->is_fixed())
+        return false;
+    auto & constraint = m_constraints[row_index];
+    T v = constraint.m_rs / a;
+    bool set_lower = false, set_upper = false;
+    switch (constraint.m_relation) {
+    case lp_relation::Equal:
+        set_lower = set_upper = true;
+        break;
+    case lp_relation::Greater_or_equal:
+        set_lower = a > numeric_traits<T>::zero();
+        set_upper = !set_lower;
+        break;
+    case lp_relation::Less_or_equal:
+        set_upper = a > numeric_traits<T>::zero();
+        set_lower = !set_upper;
+        break;
+    }
+    if (set_lower && (!ci->lower_bound_is_set() || ci->get_lower_bound() < v)) {
+        ci->set_lower_bound(v);
+        ci->set_lower_bound_strict(false);
+    }
+    if (set_upper && (!ci->upper_bound_is_set() || v < ci->get_upper_bound())) {
+        ci->set_upper_bound(v);
+        ci->set_upper_bound_strict(false);
+    }
+    if (ci->lower_bound_is_set() && ci->upper_bound_is_set()) {
+        T diff = ci->get_lower_bound() - ci->get_upper_bound();
+        if (!val_is_smaller_than_eps(diff, m_settings.refactor_tolerance)) {
+            m_status = lp_status::INFEASIBLE;
+        }
+        else if (constraint.m_relation == lp_relation::Equal) {
+            ci->set_fixed_value(v);
+        }
+    }
+    return true;
+}
+
 template <typename T, typename X> void lp_solver<T, X>::remove_fixed_or_zero_columns() {
     for (auto & i_row : m_A_values) {
         remove_fixed_or_zero_columns_from_row(i_row.first, i_row.second);
@@ -379,7 +425,7 @@ template <typename T, typename X> void lp_solver<T, X>::remove_fixed_or_zero_col
 template <typename T, typename X> unsigned lp_solver<T, X>::try_to_remove_some_rows() {
     vector<unsigned> rows_to_delete;
     for (auto & t : m_A_values) {
-        if (row_is_obsolete(t.second, t.first)) {
+        if (row_is_singleton(t.second, t.first) || row_is_obsolete(t.second, t.first)) {
             rows_to_delete.push_back(t.first);
         }
 
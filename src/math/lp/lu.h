@@ -147,6 +147,8 @@ public:
     indexed_vector<T>           m_y_copy;
     indexed_vector<unsigned>    m_ii; //to optimize the work with the m_index fields
     unsigned                    m_refactor_counter;
+    unsigned                    m_eta_fill;           // non-zeroes of the row eta matrices added by replace_column
+    unsigned                    m_factorization_fill; // non-zeroes of U after the factorization
     // constructor
     // if A is an m by n matrix then basis has length m and values in [0,n); the values are all different
     // they represent the set of m columns
@@ -309,7 +311,11 @@ public:
     void prepare_entering(unsigned entering, indexed_vector<T> & w) {
         init_vector_w(entering, w);
     }
-    bool need_to_refactor() { return m_refactor_counter >= 200; }
+    // the updates are applied in place, Forrest-Tomlin style, until there are too many of them
+    // or their row eta matrices hold more non-zeroes than the factorization itself
+    bool need_to_refactor() const {
+        return m_refactor_counter >= m_settings.lu_refactor_period || m_eta_fill > m_factorization_fill;
+    }
     
     void adjust_dimension_with_matrix_A() {
         lp_assert(m_A.row_count() >= m_dim);
@@ -114,7 +114,9 @@ lu<M>::lu(const M& A,
     m_settings(settings),
     m_failure(false),
     m_row_eta_work_vector(A.row_count()),
-    m_refactor_counter(0) {
+    m_refactor_counter(0),
+    m_eta_fill(0),
+    m_factorization_fill(0) {
     lp_assert(!(numeric_traits<T>::precise() && settings.use_tableau()));
 #ifdef Z3DEBUG
     debug_test_of_basis(A, basis);
@@ -138,7 +140,9 @@ lu<M>::lu(const M& A,
     m_settings(settings),
     m_failure(false),
     m_row_eta_work_vector(A.row_count()),
-    m_refactor_counter(0) {
+    m_refactor_counter(0),
+    m_eta_fill(0),
+    m_factorization_fill(0) {
     lp_assert(A.row_count() == A.column_count());
     create_initial_factorization();
 #ifdef Z3DEBUG
@@ -774,6 +778,7 @@ void lu<M>::create_initial_factorization(){
         // TBD does not compile: lp_assert(m_U.is_upper_triangular_and_maximums_are_set_correctly_in_rows(m_settings));
         //        lp_assert(is_correct());
         // lp_assert(m_U.is_upper_triangular_and_maximums_are_set_correctly_in_rows(m_settings));
+        m_factorization_fill = m_U.get_number_of_nonzeroes();
         return;
     }
     j++;
@@ -790,6 +795,7 @@ void lu<M>::create_initial_factorization(){
     m_dense_LU->conjugate_by_permutation(m_Q);
     push_matrix_to_tail(m_dense_LU);
     m_refactor_counter = 0;
+    m_factorization_fill = m_U.get_number_of_nonzeroes();
     // lp_assert(is_correct());
     // lp_assert(m_U.is_upper_triangular_and_maximums_are_set_correctly_in_rows(m_settings));
 }
@@ -919,6 +925,7 @@ void lu<M>::replace_column(T pivot_elem_for_checking, indexed_vector<T> & w, uns
     m_Q.multiply_by_permutation_from_right(m_r_wave);
     m_R.multiply_by_permutation_reverse_from_left(m_r_wave);
     if (row_eta != nullptr) {
+        m_eta_fill += row_eta->size();
         row_eta->conjugate_by_permutation(m_Q);
         push_matrix_to_tail(row_eta);
     }
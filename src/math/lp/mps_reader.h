@@ -95,13 +95,9 @@ inline vector<std::string> string_split(const std::string &source, const char *d
     return results;
 }
 
+// the tokens contain no delimiters, so they are already trimmed
 inline vector<std::string> split_and_trim(const std::string &line) {
-    auto split = string_split(line, " \t", false);
-    vector<std::string> ret;
-    for (auto s : split) {
-        ret.push_back(trim(s));
-    }
-    return ret;
+    return string_split(line, " \t", false);
 }
 
 template <typename T, typename X>
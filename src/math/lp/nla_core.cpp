@@ -149,6 +149,8 @@ void core::push() {
 void core::pop(unsigned n) {
     TRACE("nla_solver_verbose", tout << "n = " << n << "\n";);
     m_emons.pop(n);
+    // constraint indices of the dependencies are reused after pop
+    invalidate_grobner_basis();
     SASSERT(elists_are_consistent(false));
 }
 
@@ -1054,6 +1056,7 @@ new_lemma::~new_lemma() {
     (void)name;
     // code for checking lemma can be added here
     TRACE("nla_solver", tout << name << " " << (++i) << "\n" << *this; );
+    c.filter_last_lemma();
 }
 
 lemma& new_lemma::current() const {
@@ -1178,7 +1181,7 @@ bool core::conflict_found() const {
 }
 
 bool core::done() const {
-    return m_lemma_vec->size() >= 10 || 
+    return m_lemma_vec->size() >= m_lemma_pool_size || 
         conflict_found() || 
         lp_settings().get_cancel_flag();
 }
@@ -1458,6 +1461,120 @@ bool core::integrality_holds() {
 /**
  * Cycle through different end-game solvers weighted by probability.
  */
+bool core::terms_are_equal(lp::lar_term const& a, lp::lar_term const& b) const {
+    if (a.size() != b.size())
+        return false;
+    auto const& bc = b.coeffs<u_map<rational>>();
+    for (lp::lar_term::ival p : a) {
+        auto* e = bc.find_core(p.column().index());
+        if (!e || e->get_data().m_value != p.coeff())
+            return false;
+    }
+    return true;
+}
+
+bool core::ineqs_are_equal(ineq const& a, ineq const& b) const {
+    return a.cmp() == b.cmp() && a.rs() == b.rs() && terms_are_equal(a.term(), b.term());
+}
+
+/**
+   \brief a subsumes b if the inequalities of a are among the inequalities of b
+   and the explanation of a is contained in the explanation of b.
+*/
+bool core::lemma_subsumes(lemma const& a, lemma const& b) const {
+    if (a.ineqs().size() > b.ineqs().size() || a.expl().size() > b.expl().size())
+        return false;
+    for (ineq const& i : a.ineqs()) {
+        bool found = false;
+        for (ineq const& j : b.ineqs())
+            if ((found = ineqs_are_equal(i, j)))
+                break;
+        if (!found)
+            return false;
+    }
+    if (a.expl().size() == 0)
+        return true;
+    uint_set cis;
+    for (auto p : b.expl())
+        cis.insert(p.ci());
+    for (auto p : a.expl())
+        if (!cis.contains(p.ci()))
+            return false;
+    return true;
+}
+
+/**
+   \brief the inequalities of a lemma are false in the current model. The violation
+   of the lemma is the smallest distance of an inequality to its right-hand side.
+*/
+rational core::lemma_violation(lemma const& l) const {
+    rational r;
+    bool first = true;
+    for (ineq const& i : l.ineqs()) {
+        rational d = i.cmp() == llc::NE ? rational::zero() : abs(value(i.term()) - i.rs());
+        if (first || d < r)
+            r = d;
+        first = false;
+    }
+    return r;
+}
+
+/**
+   \brief remove the last lemma if an earlier lemma of the round subsumes it,
+   otherwise remove the earlier lemmas that it subsumes.
+*/
+void core::filter_last_lemma() {
+    vector<lemma>& lv = *m_lemma_vec;
+    if (lv.size() <= 1)
+        return;
+    lemma const& last = lv.back();
+    unsigned sz = lv.size() - 1;
+    for (unsigned i = 0; i < sz; ++i) {
+        if (lemma_subsumes(lv[i], last)) {
+            TRACE("nla_solver", tout << "lemma is subsumed\n"; print_lemma(last, tout););
+            lv.pop_back();
+            ++m_stats.m_nla_filtered_lemmas;
+            return;
+        }
+    }
+    unsigned j = 0;
+    for (unsigned i = 0; i < sz; ++i) {
+        if (lemma_subsumes(last, lv[i])) {
+            ++m_stats.m_nla_filtered_lemmas;
+            continue;
+        }
+        if (i != j)
+            lv[j] = lv[i];
+        ++j;
+    }
+    if (j < sz) {
+        lv[j++] = lv.back();
+        lv.shrink(j);
+    }
+}
+
+void core::select_most_violated_lemmas() {
+    vector<lemma>& lv = *m_lemma_vec;
+    if (lv.size() <= m_max_lemmas)
+        return;
+    vector<rational> violation;
+    unsigned_vector idx;
+    for (unsigned i = 0; i < lv.size(); ++i) {
+        violation.push_back(lemma_violation(lv[i]));
+        idx.push_back(i);
+    }
+    std::stable_sort(idx.begin(), idx.end(), [&](unsigned i, unsigned j) {
+        bool ci = lv[i].ineqs().empty(), cj = lv[j].ineqs().empty();
+        if (ci != cj)
+            return ci;
+        return violation[i] > violation[j];
+    });
+    vector<lemma> selected;
+    for (unsigned k = 0; k < m_max_lemmas; ++k)
+        selected.push_back(lv[idx[k]]);
+    lv.swap(selected);
+}
+
 void core::check_weighted(unsigned sz, std::pair<unsigned, std::function<void(void)>>* checks) {
     unsigned bound = 0;
     for (unsigned i = 0; i < sz; ++i) 
@@ -1542,6 +1659,8 @@ lbool core::check(vector<lemma>& l_vec) {
     if (ret == l_undef && !l_vec.empty() && m_reslim.inc()) 
         ret = l_false;
 
+    select_most_violated_lemmas();
+
     m_stats.m_nla_lemmas += l_vec.size();
     for (const auto& l : l_vec)
         m_stats.m_nla_explanations += static_cast<unsigned>(l.expl().size());
@@ -1640,8 +1759,14 @@ void core::run_grobner() {
     find_nl_cluster();
 
     lp_settings().stats().m_grobner_calls++;
-    configure_grobner();
-    m_pdd_grobner.saturate();
+    if (grobner_input_is_unchanged()) {
+        // only the intervals of the variables changed, check the saved basis against them
+        lp_settings().stats().m_grobner_reuses++;
+    }
+    else {
+        configure_grobner();
+        m_pdd_grobner.saturate();
+    }
     bool conflict = false;
     unsigned n = m_pdd_grobner.number_of_conflicts_to_report();
     SASSERT(n > 0);
@@ -1663,8 +1788,43 @@ void core::run_grobner() {
     }
 }
 
+void core::add_fixed_var_to_grobner_input(lpvar j) {
+    if (!var_is_fixed(j))
+        return;
+    unsigned lc, uc;
+    m_lar_solver.get_bound_constraint_witnesses_for_column(j, lc, uc);
+    m_grobner_new_input.push_back(j);
+    m_grobner_new_input.push_back(lc);
+    m_grobner_new_input.push_back(uc);
+}
+
+// The equations added by configure_grobner depend only on the variable order,
+// the coefficients of the rows and the fixed variables with their witnesses.
+bool core::grobner_input_is_unchanged() {
+    m_grobner_new_input.reset();
+    m_grobner_new_input.push_back(m_lar_solver.column_count());
+    grobner_level2var(m_grobner_new_input);
+    const auto& matrix = m_lar_solver.A_r();
+    for (unsigned i : m_rows) {
+        uint64_t stamp = matrix.row_stamp(i);
+        m_grobner_new_input.push_back(i);
+        m_grobner_new_input.push_back(static_cast<unsigned>(stamp));
+        m_grobner_new_input.push_back(static_cast<unsigned>(stamp >> 32));
+        for (const auto& c : matrix.m_rows[i]) {
+            add_fixed_var_to_grobner_input(c.var());
+            if (is_monic_var(c.var()))
+                for (lpvar k : m_emons[c.var()].vars())
+                    add_fixed_var_to_grobner_input(k);
+        }
+    }
+    bool unchanged = m_grobner_basis_valid && m_grobner_input == m_grobner_new_input;
+    m_grobner_input.swap(m_grobner_new_input);
+    return unchanged;
+}
+
 void core::configure_grobner() {
     m_pdd_grobner.reset();
+    m_grobner_basis_valid = false;
     try {
         set_level2var_for_grobner();
         for (unsigned i : m_rows) {
@@ -1675,6 +1835,7 @@ void core::configure_grobner() {
         IF_VERBOSE(2, verbose_stream() << "pdd throw\n");
         return;
     }
+    m_grobner_basis_valid = true;
 #if 0
     IF_VERBOSE(2, m_pdd_grobner.display(verbose_stream()));
     dd::pdd_eval eval(m_pdd_manager);
@@ -1890,6 +2051,12 @@ void core::set_active_vars_weights(nex_creator& nc) {
 }
 
 void core::set_level2var_for_grobner() {
+    unsigned_vector l2v;
+    grobner_level2var(l2v);
+    m_pdd_manager.reset(l2v);
+}
+
+void core::grobner_level2var(unsigned_vector& l2v) const {
     unsigned n = m_lar_solver.column_count();
     unsigned_vector sorted_vars(n), weighted_vars(n);
     for (unsigned j = 0; j < n; j++) {
@@ -1912,11 +2079,8 @@ void core::set_level2var_for_grobner() {
                                                       unsigned wb = weighted_vars[b];
                                                       return wa < wb || (wa == wb && a < b); });
 
-    unsigned_vector l2v(n);
     for (unsigned j = 0; j < n; j++)
-        l2v[j] = sorted_vars[j];
-
-    m_pdd_manager.reset(l2v);
+        l2v.push_back(sorted_vars[j]);
 }
 
 unsigned core::get_var_weight(lpvar j) const {
@@ -1969,7 +2133,9 @@ bool core::influences_nl_var(lpvar j) const {
 void core::collect_statistics(::statistics & st) {
     st.update("arith-nla-explanations", m_stats.m_nla_explanations);
     st.update("arith-nla-lemmas", m_stats.m_nla_lemmas);
+    st.update("arith-nla-filtered-lemmas", m_stats.m_nla_filtered_lemmas);
     st.update("arith-nra-calls", m_stats.m_nra_calls);    
+    m_pdd_manager.collect_statistics(st);
 }
 
 
@@ -142,6 +142,7 @@ class core {
     struct stats {
         unsigned m_nla_explanations;
         unsigned m_nla_lemmas;
+        unsigned m_nla_filtered_lemmas;
         unsigned m_nra_calls;
         stats() { reset(); }
         void reset() {
@@ -175,6 +176,12 @@ private:
     svector<lpvar>           m_add_buffer;
     mutable lp::u_set        m_active_var_set;
     lp::u_set                m_rows;
+    // the input of the last Groebner basis computation: the variable order,
+    // the rows with their stamps and the witnesses of the fixed variables.
+    // The basis is reused while the input does not change.
+    unsigned_vector          m_grobner_input;
+    unsigned_vector          m_grobner_new_input;
+    bool                     m_grobner_basis_valid { false };
     reslimit                 m_nra_lim;
 public:
     reslimit&                m_reslim;
@@ -187,6 +194,18 @@ private:
 
     void check_weighted(unsigned sz, std::pair<unsigned, std::function<void(void)>>* checks);
 
+    // a round collects up to m_lemma_pool_size lemmas that are neither duplicates
+    // nor subsumed by other lemmas of the round, and sends the m_max_lemmas most
+    // violated of them.
+    unsigned                 m_max_lemmas { 10 };
+    unsigned                 m_lemma_pool_size { 20 };
+    bool terms_are_equal(lp::lar_term const& a, lp::lar_term const& b) const;
+    bool ineqs_are_equal(ineq const& a, ineq const& b) const;
+    bool lemma_subsumes(lemma const& a, lemma const& b) const;
+    rational lemma_violation(lemma const& l) const;
+    void filter_last_lemma();
+    void select_most_violated_lemmas();
+
 public:    
     void insert_to_refine(lpvar j);
     void erase_from_to_refine(lpvar j);
@@ -249,6 +268,9 @@ public:
     bool need_run_grobner() const { 
         return m_nla_settings.run_grobner() && lp_settings().stats().m_nla_calls % m_nla_settings.grobner_frequency() == 0; 
     }
+
+    // the dependencies of the Groebner equations are no longer valid
+    void invalidate_grobner_basis() { m_grobner_basis_valid = false; }
     
     void incremental_linearization(bool);
     
@@ -471,7 +493,10 @@ public:
     bool check_pdd_eq(const dd::solver::equation*);
     const rational& val_of_fixed_var_with_deps(lpvar j, u_dependency*& dep);
     dd::pdd pdd_expr(const rational& c, lpvar j, u_dependency*&);
+    void grobner_level2var(unsigned_vector& l2v) const;
     void set_level2var_for_grobner();
+    void add_fixed_var_to_grobner_input(lpvar j);
+    bool grobner_input_is_unchanged();
     void configure_grobner();
     bool influences_nl_var(lpvar) const;
     bool is_nl_var(lpvar) const;
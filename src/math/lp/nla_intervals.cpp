@@ -2,6 +2,8 @@
 #include "math/interval/interval_def.h"
 #include "math/lp/nla_intervals.h"
 #include "util/mpq.h"
+#include <cmath>
+#include <limits>
 
 namespace nla {
 typedef enum dep_intervals::with_deps_t e_with_deps;
@@ -79,9 +81,197 @@ std::ostream& intervals::display_separating_interval(std::ostream& out, const ne
           return out;
 }
 
+// Directed rounding for the double filter. A result rounded up is at least,
+// and a result rounded down is at most, the exact value.
+static const double fp_inf = std::numeric_limits<double>::infinity();
+
+static double fp_round(double r, double err, bool up) {
+    // err is the sign of exact - r
+    if (up)
+        return err > 0 ? std::nextafter(r, fp_inf) : r;
+    return err < 0 ? std::nextafter(r, -fp_inf) : r;
+}
+
+// false if r is not the quotient of integers that are exact doubles
+static bool fp_of_rational(rational const& r, bool up, double& result) {
+    static const rational max_exact = rational::power_of_two(53);
+    rational n = numerator(r), d = denominator(r);
+    if (abs(n) > max_exact || d > max_exact)
+        return false;
+    double nd = n.get_double(), dd = d.get_double();
+    result = nd / dd;
+    if (!std::isfinite(result))
+        return false;
+    // the sign of nd - result * dd is the sign of r - result
+    result = fp_round(result, -std::fma(result, dd, -nd), up);
+    return true;
+}
+
+static bool fp_mul(double a, double b, bool up, double& result) {
+    if (a == 0 || b == 0) {
+        result = 0;
+        return true;
+    }
+    result = a * b;
+    if (std::isinf(a) || std::isinf(b))
+        return true;
+    if (!std::isfinite(result))
+        return false;
+    result = fp_round(result, std::fma(a, b, -result), up);
+    return true;
+}
+
+static bool fp_add(double a, double b, bool up, double& result) {
+    result = a + b;
+    if (std::isinf(a) || std::isinf(b))
+        return !std::isnan(result);
+    if (!std::isfinite(result))
+        return false;
+    double bb = result - a;
+    double err = (a - (result - bb)) + (b - bb);
+    result = fp_round(result, err, up);
+    return true;
+}
+
+static bool fp_power(double a, unsigned p, bool up, double& result) {
+    bool neg = a < 0 && p % 2 == 1;
+    double b = std::fabs(a);
+    // |a|^p is monotone in the factors, round its magnitude up iff the result is rounded up
+    bool mag_up = neg ? !up : up;
+    result = 1;
+    for (unsigned i = 0; i < p; i++)
+        if (!fp_mul(result, b, mag_up, result))
+            return false;
+    if (neg)
+        result = -result;
+    return true;
+}
+
+bool intervals::fp_var_interval(lpvar v, fp_interval& a) const {
+    lp::constraint_index ci;
+    rational val;
+    bool is_strict;
+    a.m_lower = -fp_inf;
+    a.m_upper = fp_inf;
+    if (ls().has_lower_bound(v, ci, val, is_strict) && !fp_of_rational(val, true, a.m_lower))
+        return false;
+    if (ls().has_upper_bound(v, ci, val, is_strict) && !fp_of_rational(val, false, a.m_upper))
+        return false;
+    return a.m_lower <= a.m_upper;
+}
+
+bool intervals::fp_interval_of_sum(const nex_sum& e, fp_interval& a) {
+    if (e.is_a_linear_term()) {
+        // interval_of_sum intersects with the bounds of the term, leave it to the exact computation
+        rational c, b;
+        lp::lar_term norm_t = expression_to_normalized_term(&e, c, b);
+        lp::explanation exp;
+        if (m_core->explain_by_equiv(norm_t, exp) || find_term_column(norm_t, c) + 1 != 0)
+            return false;
+    }
+    if (has_inf_interval(e)) {
+        a.m_lower = -fp_inf;
+        a.m_upper = fp_inf;
+        return true;
+    }
+    if (!fp_interval_of_expr(e[0], 1, a))
+        return false;
+    for (unsigned k = 1; k < e.size(); k++) {
+        fp_interval b;
+        if (!fp_interval_of_expr(e[k], 1, b) ||
+            !fp_add(a.m_lower, b.m_lower, true, a.m_lower) ||
+            !fp_add(a.m_upper, b.m_upper, false, a.m_upper))
+            return false;
+    }
+    return a.m_lower <= a.m_upper;
+}
+
+bool intervals::fp_interval_of_mul(const nex_mul& e, fp_interval& a) {
+    if (get_zero_interval_child(e))
+        return false;
+    if (!fp_of_rational(e.coeff(), true, a.m_lower) || !fp_of_rational(e.coeff(), false, a.m_upper))
+        return false;
+    for (const auto& ep : e) {
+        fp_interval b;
+        if (!fp_interval_of_expr(ep.e(), ep.pow(), b))
+            return false;
+        double lo = fp_inf, hi = -fp_inf, r;
+        for (double x : { a.m_lower, a.m_upper }) {
+            for (double y : { b.m_lower, b.m_upper }) {
+                if (!fp_mul(x, y, true, r))
+                    return false;
+                lo = std::min(lo, r);
+                if (!fp_mul(x, y, false, r))
+                    return false;
+                hi = std::max(hi, r);
+            }
+        }
+        a.m_lower = lo;
+        a.m_upper = hi;
+        if (a.m_lower > a.m_upper)
+            return false;
+    }
+    return true;
+}
+
+bool intervals::fp_interval_of_expr(const nex* e, unsigned p, fp_interval& a) {
+    switch (e->type()) {
+    case expr_type::SCALAR: {
+        rational v = power(to_scalar(e)->value(), p);
+        return fp_of_rational(v, true, a.m_lower) && fp_of_rational(v, false, a.m_upper) && a.m_lower <= a.m_upper;
+    }
+    case expr_type::SUM:
+        if (!fp_interval_of_sum(e->to_sum(), a))
+            return false;
+        break;
+    case expr_type::MUL:
+        if (!fp_interval_of_mul(e->to_mul(), a))
+            return false;
+        break;
+    case expr_type::VAR:
+        if (!fp_var_interval(e->to_var().var(), a))
+            return false;
+        break;
+    default:
+        UNREACHABLE();
+        return false;
+    }
+    if (p == 1)
+        return true;
+    double lo = a.m_lower, hi = a.m_upper;
+    if (p % 2 == 1 || lo >= 0) {
+        if (!fp_power(lo, p, true, a.m_lower) || !fp_power(hi, p, false, a.m_upper))
+            return false;
+    }
+    else if (hi <= 0) {
+        if (!fp_power(hi, p, true, a.m_lower) || !fp_power(lo, p, false, a.m_upper))
+            return false;
+    }
+    else {
+        double l, u;
+        if (!fp_power(lo, p, false, l) || !fp_power(hi, p, false, u))
+            return false;
+        a.m_lower = 0;
+        a.m_upper = std::max(l, u);
+    }
+    return a.m_lower <= a.m_upper;
+}
+
+// true if the interval of n certainly contains 0 in its interior.
+// It is computed in doubles as an inner approximation of interval_of_expr,
+// such that check_nex can skip the exact computation.
+bool intervals::fp_contains_zero(const nex* n) {
+    fp_interval a;
+    return fp_interval_of_expr(n, 1, a) && a.m_lower < 0 && a.m_upper > 0;
+}
+
 // return true iff the interval of n is does not contain 0
 bool intervals::check_nex(const nex* n, u_dependency* initial_deps) {
     m_core->lp_settings().stats().m_cross_nested_forms++;
+    if (fp_contains_zero(n)) {
+        m_core->lp_settings().stats().m_cross_nested_fp_filtered++;
+        return false;
+    }
     scoped_dep_interval i(get_dep_intervals());
     std::function<void (const lp::explanation&)> f = [this](const lp::explanation& e) {
         new_lemma lemma(*m_core, "check_nex");
@@ -25,6 +25,17 @@ class intervals {
 public:
     typedef dep_intervals::interval interval;
 private:
+    // inner approximation in doubles of the interval computed by interval_of_expr:
+    // every point of [m_lower, m_upper] belongs to the exact interval.
+    struct fp_interval {
+        double m_lower;
+        double m_upper;
+    };
+    bool fp_var_interval(lpvar v, fp_interval& a) const;
+    bool fp_interval_of_sum(const nex_sum& e, fp_interval& a);
+    bool fp_interval_of_mul(const nex_mul& e, fp_interval& a);
+    bool fp_interval_of_expr(const nex* e, unsigned p, fp_interval& a);
+    bool fp_contains_zero(const nex* e);
     u_dependency* mk_dep(lp::constraint_index ci);
     u_dependency* mk_dep(lp::explanation const&);
     lp::lar_solver& ls();
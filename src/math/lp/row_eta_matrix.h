@@ -69,6 +69,8 @@ public:
         apply_from_left_local_to_T(w, settings);
     }
 
+    unsigned size() const { return m_row_vector.size(); }
+
     void push_back(unsigned row_index, T val ) {
         lp_assert(row_index != m_row);
         m_row_vector.push_back(row_index, val);
@@ -0,0 +1,253 @@
+/*++
+Copyright (c) 2021 Microsoft Corporation
+
+Module Name:
+
+    small_rational.h
+
+Abstract:
+
+    Rational coefficients for the lp tableau.
+
+    The numerator and denominator are kept in 64-bit integers as long as
+    they fit. The operations on them use checked_int64; when one of them
+    overflows the value is promoted to mpq. Values are kept normalized:
+    the denominator is positive, numerator and denominator are coprime,
+    and a value is stored as mpq only if it does not fit in 64 bits.
+
+--*/
+#pragma once
+
+#include "util/checked_int64.h"
+#include "math/lp/numeric_pair.h"
+
+namespace lp {
+
+class small_rational {
+    typedef checked_int64<true> i64;
+
+    int64_t m_num { 0 };
+    int64_t m_den { 1 };
+    bool    m_big { false };
+    mpq     m_val;           // the value if m_big
+
+    static int64_t gcd(int64_t a, int64_t b) {
+        uint64_t x = a < 0 ? 0 - static_cast<uint64_t>(a) : static_cast<uint64_t>(a);
+        uint64_t y = b < 0 ? 0 - static_cast<uint64_t>(b) : static_cast<uint64_t>(b);
+        while (y != 0) {
+            uint64_t t = x % y;
+            x = y;
+            y = t;
+        }
+        return static_cast<int64_t>(x);
+    }
+
+    // throws i64::overflow_exception if the normalized value does not fit.
+    void set_small(i64 n, i64 d) {
+        SASSERT(!d.is_zero());
+        if (d.is_neg()) {
+            n.neg();
+            d.neg();
+        }
+        int64_t g = gcd(n.get_int64(), d.get_int64());
+        if (g > 1) {
+            n = i64(n.get_int64() / g);
+            d = i64(d.get_int64() / g);
+        }
+        m_num = n.get_int64();
+        m_den = d.get_int64();
+        m_big = false;
+    }
+
+    void set(mpq const & v) {
+        if (v.is_int64()) {
+            m_num = v.get_int64();
+            m_den = 1;
+            m_big = false;
+            return;
+        }
+        if (!v.is_int()) {
+            mpq n = numerator(v), d = denominator(v);
+            if (n.is_int64() && d.is_int64()) {
+                m_num = n.get_int64();
+                m_den = d.get_int64();
+                m_big = false;
+                return;
+            }
+        }
+        m_val = v;
+        m_big = true;
+    }
+
+public:
+    small_rational() {}
+    small_rational(int n): m_num(n) {}
+    small_rational(unsigned n): m_num(n) {}
+    small_rational(int64_t n, int64_t d) {
+        try {
+            set_small(i64(n), i64(d));
+        }
+        catch (i64::overflow_exception &) {
+            set(mpq(n, mpq::i64()) / mpq(d, mpq::i64()));
+        }
+    }
+    explicit small_rational(mpq const & v) { set(v); }
+
+    bool is_big() const { return m_big; }
+
+    mpq to_mpq() const {
+        if (m_big)
+            return m_val;
+        if (m_den == 1)
+            return mpq(m_num, mpq::i64());
+        return mpq(m_num, mpq::i64()) / mpq(m_den, mpq::i64());
+    }
+
+    bool is_zero() const { return !m_big && m_num == 0; }
+    bool is_one() const { return !m_big && m_num == 1 && m_den == 1; }
+    bool is_minus_one() const { return !m_big && m_num == -1 && m_den == 1; }
+    bool is_pos() const { return m_big ? m_val.is_pos() : m_num > 0; }
+    bool is_neg() const { return m_big ? m_val.is_neg() : m_num < 0; }
+    bool is_int() const { return m_big ? m_val.is_int() : m_den == 1; }
+    double get_double() const { return m_big ? m_val.get_double() : static_cast<double>(m_num) / static_cast<double>(m_den); }
+
+    small_rational & operator+=(small_rational const & b) {
+        if (!m_big && !b.m_big) {
+            try {
+                if (m_den == b.m_den)
+                    set_small(i64(m_num) + i64(b.m_num), i64(m_den));
+                else
+                    set_small(i64(m_num) * i64(b.m_den) + i64(b.m_num) * i64(m_den), i64(m_den) * i64(b.m_den));
+                return *this;
+            }
+            catch (i64::overflow_exception &) {
+            }
+        }
+        set(to_mpq() + b.to_mpq());
+        return *this;
+    }
+
+    small_rational & operator-=(small_rational const & b) {
+        if (!m_big && !b.m_big) {
+            try {
+                if (m_den == b.m_den)
+                    set_small(i64(m_num) - i64(b.m_num), i64(m_den));
+                else
+                    set_small(i64(m_num) * i64(b.m_den) - i64(b.m_num) * i64(m_den), i64(m_den) * i64(b.m_den));
+                return *this;
+            }
+            catch (i64::overflow_exception &) {
+            }
+        }
+        set(to_mpq() - b.to_mpq());
+        return *this;
+    }
+
+    small_rational & operator*=(small_rational const & b) {
+        if (!m_big && !b.m_big) {
+            try {
+                // cross cancellation keeps the products small
+                int64_t g1 = gcd(m_num, b.m_den), g2 = gcd(b.m_num, m_den);
+                set_small(i64(m_num / g1) * i64(b.m_num / g2), i64(m_den / g2) * i64(b.m_den / g1));
+                return *this;
+            }
+            catch (i64::overflow_exception &) {
+            }
+        }
+        set(to_mpq() * b.to_mpq());
+        return *this;
+    }
+
+    small_rational & operator/=(small_rational const & b) {
+        SASSERT(!b.is_zero());
+        if (!m_big && !b.m_big) {
+            try {
+                int64_t g1 = gcd(m_num, b.m_num), g2 = gcd(m_den, b.m_den);
+                set_small(i64(m_num / g1) * i64(b.m_den / g2), i64(m_den / g2) * i64(b.m_num / g1));
+                return *this;
+            }
+            catch (i64::overflow_exception &) {
+            }
+        }
+        set(to_mpq() / b.to_mpq());
+        return *this;
+    }
+
+    // this += a * b
+    void addmul(small_rational const & a, small_rational const & b) {
+        if (a.is_one())
+            *this += b;
+        else if (a.is_minus_one())
+            *this -= b;
+        else
+            *this += a * b;
+    }
+
+    small_rational operator-() const {
+        if (!m_big && m_num != INT64_MIN) {
+            small_rational r(*this);
+            r.m_num = -m_num;
+            return r;
+        }
+        return small_rational(-to_mpq());
+    }
+
+    friend bool operator==(small_rational const & a, small_rational const & b) {
+        // both values are normalized
+        if (a.m_big || b.m_big)
+            return a.m_big && b.m_big && a.m_val == b.m_val;
+        return a.m_num == b.m_num && a.m_den == b.m_den;
+    }
+
+    friend bool operator<(small_rational const & a, small_rational const & b) {
+        if (!a.m_big && !b.m_big) {
+            if (a.m_den == b.m_den)
+                return a.m_num < b.m_num;
+            try {
+                return i64(a.m_num) * i64(b.m_den) < i64(b.m_num) * i64(a.m_den);
+            }
+            catch (i64::overflow_exception &) {
+            }
+        }
+        return a.to_mpq() < b.to_mpq();
+    }
+
+    friend bool operator!=(small_rational const & a, small_rational const & b) { return !(a == b); }
+    friend bool operator>(small_rational const & a, small_rational const & b) { return b < a; }
+    friend bool operator<=(small_rational const & a, small_rational const & b) { return !(b < a); }
+    friend bool operator>=(small_rational const & a, small_rational const & b) { return !(a < b); }
+
+    friend small_rational operator+(small_rational const & a, small_rational const & b) { small_rational r(a); r += b; return r; }
+    friend small_rational operator-(small_rational const & a, small_rational const & b) { small_rational r(a); r -= b; return r; }
+    friend small_rational operator*(small_rational const & a, small_rational const & b) { small_rational r(a); r *= b; return r; }
+    friend small_rational operator/(small_rational const & a, small_rational const & b) { small_rational r(a); r /= b; return r; }
+
+    friend small_rational abs(small_rational const & a) { return a.is_neg() ? -a : a; }
+
+    friend std::ostream & operator<<(std::ostream & out, small_rational const & a) {
+        return out << a.to_mpq();
+    }
+};
+
+inline void addmul(small_rational & r, small_rational const & a, small_rational const & b) { r.addmul(a, b); }
+
+template<>
+class numeric_traits<small_rational> {
+public:
+    static bool precise() { return true; }
+    static small_rational const & zero() { static small_rational z(0); return z; }
+    static small_rational const & one() { static small_rational o(1); return o; }
+    static bool is_zero(small_rational const & v) { return v.is_zero(); }
+    static double get_double(small_rational const & d) { return d.get_double(); }
+    static bool is_pos(small_rational const & d) { return d.is_pos(); }
+    static bool is_neg(small_rational const & d) { return d.is_neg(); }
+    static bool is_int(small_rational const & d) { return d.is_int(); }
+    static bool is_big(small_rational const & d) { return d.is_big(); }
+};
+
+template <>
+struct convert_struct<double, small_rational> {
+    static double convert(small_rational const & q) { return q.get_double(); }
+};
+
+}
@@ -28,6 +28,7 @@ Revision History:
 #include "math/lp/lp_primal_core_solver.h"
 #include "math/lp/scaler.h"
 #include "math/lp/lar_solver.h"
+#include "math/lp/small_rational.h"
 namespace lp {
 template void static_matrix<double, double>::add_columns_at_the_end(unsigned int);
 template void static_matrix<double, double>::clear();
@@ -48,6 +49,7 @@ template void static_matrix<double, double>::init_empty_matrix(unsigned int, uns
 template void static_matrix<double, double>::init_row_columns(unsigned int, unsigned int);
 template static_matrix<double, double>::ref & static_matrix<double, double>::ref::operator=(double const&);
 template void static_matrix<double, double>::set(unsigned int, unsigned int, double const&);
+template void static_matrix<double, double>::add_new_element(unsigned int, unsigned int, double const&);
 template static_matrix<double, double>::static_matrix(unsigned int, unsigned int);
 template void static_matrix<mpq, mpq>::add_column_to_vector(mpq const&, unsigned int, mpq*) const;
 template void static_matrix<mpq, mpq>::add_columns_at_the_end(unsigned int);
@@ -80,5 +82,14 @@ template bool lp::static_matrix<lp::mpq, lp::mpq>::pivot_row_to_row_given_cell(u
 template bool lp::static_matrix<lp::mpq, lp::numeric_pair<lp::mpq> >::pivot_row_to_row_given_cell(unsigned int, column_cell&, unsigned int);
 template void lp::static_matrix<lp::mpq, lp::numeric_pair<lp::mpq> >::remove_element(vector<lp::row_cell<lp::mpq>, true, unsigned int>&, lp::row_cell<lp::mpq>&);
 
+template static_matrix<small_rational, small_rational>::static_matrix(unsigned int, unsigned int);
+template void static_matrix<small_rational, small_rational>::init_row_columns(unsigned int, unsigned int);
+template void static_matrix<small_rational, small_rational>::set(unsigned int, unsigned int, small_rational const&);
+template small_rational static_matrix<small_rational, small_rational>::get_elem(unsigned int, unsigned int) const;
+template void static_matrix<small_rational, small_rational>::add_columns_at_the_end(unsigned int);
+template void static_matrix<small_rational, small_rational>::copy_column_to_indexed_vector(unsigned int, indexed_vector<small_rational>&) const;
+template bool static_matrix<small_rational, small_rational>::is_correct() const;
+template bool static_matrix<small_rational, small_rational>::pivot_row_to_row_given_cell(unsigned int, column_cell&, unsigned int);
+
 }
 
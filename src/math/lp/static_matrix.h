@@ -71,6 +71,10 @@ public:
     indexed_vector<T> m_work_vector;
     vector<row_strip<T>> m_rows;
     vector<column_strip> m_columns;
+    // m_row_stamps[i] changes every time row i is modified,
+    // it lets clients cache values computed from a row
+    svector<uint64_t>    m_row_stamps;
+    uint64_t             m_stamp { 0 };
     // starting inner classes
     class ref {
         static_matrix & m_matrix;
@@ -130,7 +134,18 @@ public:
     void add_columns_at_the_end(unsigned delta);
     void add_new_element(unsigned i, unsigned j, const T & v);
 
-    void add_row() {m_rows.push_back(row_strip<T>());}
+    void add_row() {
+        m_rows.push_back(row_strip<T>());
+        touch_row(m_rows.size() - 1);
+    }
+
+    void touch_row(unsigned i) {
+        if (i >= m_row_stamps.size())
+            m_row_stamps.resize(i + 1, 0);
+        m_row_stamps[i] = ++m_stamp;
+    }
+
+    uint64_t row_stamp(unsigned i) const { return i < m_row_stamps.size() ? m_row_stamps[i] : 0; }
     void add_column() {
         m_columns.push_back(column_strip());
         m_vector_of_row_offsets.push_back(-1);
@@ -146,6 +161,7 @@ public:
         for (auto & t : m_columns[column]) {
             auto & r = m_rows[t.var()][t.offset()];
             r.coeff() *= alpha;
+            touch_row(t.var());
         }
     }
     
@@ -273,12 +289,14 @@ public:
         for (auto & t : m_rows[row]) {
             t.coeff() *= alpha;
         }
+        touch_row(row);
     }
 
     void divide_row(unsigned row, T const & alpha) {
         for (auto & t : m_rows[row]) {
             t.coeff() /= alpha;
         }
+        touch_row(row);
     }
     
     T dot_product_with_column(const vector<T> & y, unsigned j) const {
@@ -298,6 +316,8 @@ public:
         auto t = m_rows[i];
         m_rows[i] = m_rows[ii];
         m_rows[ii] = t;
+        touch_row(i);
+        touch_row(ii);
         // now fix the columns
         for (auto & rc : m_rows[i]) {
             column_cell & cc = m_columns[rc.var()][rc.offset()];
@@ -32,6 +32,7 @@ void  static_matrix<T, X>::init_row_columns(unsigned m, unsigned n) {
     lp_assert(m_rows.size() == 0 && m_columns.size() == 0);
     for (unsigned i = 0; i < m; i++) {
         m_rows.push_back(row_strip<T>());
+        touch_row(i);
     }
     for (unsigned j = 0; j < n; j++) {
         m_columns.push_back(column_strip());
@@ -51,6 +52,7 @@ template <typename T, typename X> bool static_matrix<T, X>::pivot_row_to_row_giv
     T alpha = -get_val(c);
     lp_assert(!is_zero(alpha));
     auto & rowii = m_rows[ii];
+    touch_row(ii);
     remove_element(rowii, rowii[c.offset()]);
     scan_row_ii_to_offset_vector(rowii);
     unsigned prev_size_ii = rowii.size();
@@ -97,6 +99,7 @@ template <typename T, typename X> void static_matrix<T, X>::clear() {
     m_vector_of_row_offsets.clear();
     m_rows.clear();
     m_columns.clear();
+    m_row_stamps.reset();
 }
 
 template <typename T, typename X> void static_matrix<T, X>::init_vector_of_row_offsets() {
@@ -156,6 +159,7 @@ template <typename T, typename X> void static_matrix<T, X>::set(unsigned row, un
     if (numeric_traits<T>::is_zero(val)) return;
     lp_assert(row < row_count() && col < column_count());
     auto & r = m_rows[row];
+    touch_row(row);
     unsigned offs_in_cols = m_columns[col].size();
     m_columns[col].push_back(make_column_cell(row, r.size()));
     r.push_back(make_row_cell(col, offs_in_cols, val));
@@ -368,6 +372,7 @@ void static_matrix<T, X>::remove_element(vector<row_cell<T>> & row_vals, row_cel
     auto & column_vals = m_columns[row_el_iv.var()];
     column_cell& cs = m_columns[row_el_iv.var()][column_offset];
     unsigned row_offset = cs.offset();
+    touch_row(cs.var());
     if (column_offset != column_vals.size() - 1) {
         auto & cc = column_vals[column_offset] = column_vals.back(); // copy from the tail
         m_rows[cc.var()][cc.offset()].offset() = column_offset;
@@ -388,6 +393,7 @@ void static_matrix<T, X>::add_new_element(unsigned row, unsigned col, const T& v
     auto & col_vals = m_columns[col];
     unsigned row_el_offs = row_vals.size();
     unsigned col_el_offs = col_vals.size();
+    touch_row(row);
     row_vals.push_back(row_cell<T>(col, col_el_offs, val));
     col_vals.push_back(column_cell(row, row_el_offs));
 }
@@ -20,6 +20,7 @@ Notes:
 #include "util/basic_interval.h"
 #include "util/scoped_ptr_vector.h"
 #include "util/mpbqi.h"
+#include "util/map.h"
 #include "util/timeit.h"
 #include "util/common_msgs.h"
 #include "math/polynomial/algebraic_numbers.h"
@@ -47,7 +48,8 @@ namespace algebraic_numbers {
         unsigned   m_sign_lower:1;
         unsigned   m_not_rational:1; // if true we know for sure it is not a rational
         unsigned   m_i:29; // number is the i-th root of p, 0 if it is not known which root of p the number is.
-        algebraic_cell():m_p_sz(0), m_p(nullptr), m_minimal(false), m_not_rational(false), m_i(0) {}
+        unsigned   m_id;   // identifies the value of the cell in the comparison cache, renewed whenever the value changes.
+        algebraic_cell():m_p_sz(0), m_p(nullptr), m_minimal(false), m_not_rational(false), m_i(0), m_id(0) {}
         bool is_minimal() const { return m_minimal != 0; }
     };
 
@@ -89,9 +91,17 @@ namespace algebraic_numbers {
         bool                       m_factor;
         polynomial::factor_params  m_factor_params;
         int                        m_zero_accuracy;
+        unsigned                   m_compare_cache_size;
+
+        // Results of comparisons that could not be decided by the isolating intervals,
+        // keyed by the ids of the two cells. Ids are never reused, so entries of
+        // deleted or modified cells are never hit again.
+        u64_map<int>             m_compare_cache;
+        unsigned                 m_next_cell_id;
 
         // statistics
         unsigned                 m_compare_cheap;
+        unsigned                 m_compare_cache_hits;
         unsigned                 m_compare_sturm;
         unsigned                 m_compare_refine;
         unsigned                 m_compare_poly_eq;
@@ -114,7 +124,8 @@ namespace algebraic_numbers {
             m_isolate_roots(bqm()),
             m_isolate_lowers(bqm()),
             m_isolate_uppers(bqm()),
-            m_add_tmp(upm()) {
+            m_add_tmp(upm()),
+            m_next_cell_id(0) {
             updt_params(p);
             reset_statistics();
             m_x = pm().mk_var();
@@ -136,6 +147,7 @@ namespace algebraic_numbers {
 
         void reset_statistics() {
             m_compare_cheap   = 0;
+            m_compare_cache_hits = 0;
             m_compare_sturm   = 0;
             m_compare_refine  = 0;
             m_compare_poly_eq = 0;
@@ -144,6 +156,7 @@ namespace algebraic_numbers {
         void collect_statistics(statistics & st) {
 #ifndef _EXTERNAL_RELEASE
             st.update("algebraic compare cheap", m_compare_cheap);
+            st.update("algebraic compare cache hits", m_compare_cache_hits);
             st.update("algebraic compare sturm", m_compare_sturm);
             st.update("algebraic compare refine", m_compare_refine);
             st.update("algebraic compare poly", m_compare_poly_eq);
@@ -158,6 +171,9 @@ namespace algebraic_numbers {
             m_factor_params.m_p_trials = p.factor_num_primes();
             m_factor_params.m_max_search_size = p.factor_search_size();
             m_zero_accuracy            = -static_cast<int>(p.zero_accuracy());
+            m_compare_cache_size       = p.compare_cache_size();
+            if (m_compare_cache_size == 0)
+                m_compare_cache.reset();
         }
 
         unsynch_mpq_manager & qm() {
@@ -421,6 +437,7 @@ namespace algebraic_numbers {
             if (c->m_minimal)
                 c->m_not_rational = true;
             normalize_coeffs(c);
+            renew_id(c);
             return c;
         }
 
@@ -459,6 +476,15 @@ namespace algebraic_numbers {
             }
         }
 
+        void renew_id(algebraic_cell * c) {
+            c->m_id = ++m_next_cell_id;
+            if (m_next_cell_id == UINT_MAX) {
+                // ids are about to be reused
+                m_next_cell_id = 0;
+                m_compare_cache.reset();
+            }
+        }
+
         void set_interval(algebraic_cell * c, mpbqi const & i) {
             bqim().set(c->m_interval, i);
         }
@@ -476,6 +502,7 @@ namespace algebraic_numbers {
             target->m_sign_lower   = source->m_sign_lower;
             target->m_not_rational = source->m_not_rational;
             target->m_i            = source->m_i;
+            renew_id(target);
             //SASSERT(acell_inv(*source)); source could be owned by a different manager
             SASSERT(acell_inv(*target));
         }
@@ -507,6 +534,7 @@ namespace algebraic_numbers {
                     c->m_i            = 0;
                     update_sign_lower(c);
                     normalize_coeffs(c);
+                    renew_id(c);
                 }
                 SASSERT(acell_inv(*a.to_algebraic()));
             }
@@ -1619,6 +1647,7 @@ namespace algebraic_numbers {
                 upm().p_minus_x(c->m_p_sz, c->m_p);
                 bqim().neg(c->m_interval);
                 update_sign_lower(c);
+                renew_id(c);
                 SASSERT(acell_inv(*c));
             }
         }
@@ -1758,6 +1787,39 @@ namespace algebraic_numbers {
             return upm().eq(cell_a->m_p_sz, cell_a->m_p, cell_b->m_p_sz, cell_b->m_p);
         }
 
+        #define COMPARE_INTERVAL()                  \
+        if (bqm().le(a_upper, b_lower)) {           \
+            m_compare_cheap++;                      \
+            return sign_neg;                        \
+        }                                           \
+        if (bqm().ge(a_lower, b_upper)) {           \
+            m_compare_cheap++;                      \
+            return sign_pos;                        \
+        }
+
+        static uint64_t compare_key(unsigned id_a, unsigned id_b) {
+            return (static_cast<uint64_t>(id_a) << 32) | id_b;
+        }
+
+        bool find_compare_cache(algebraic_cell const * cell_a, algebraic_cell const * cell_b, ::sign & r) {
+            int s;
+            if (m_compare_cache.find(compare_key(cell_a->m_id, cell_b->m_id), s)) {
+                r = static_cast<::sign>(s);
+                return true;
+            }
+            if (m_compare_cache.find(compare_key(cell_b->m_id, cell_a->m_id), s)) {
+                r = static_cast<::sign>(-s);
+                return true;
+            }
+            return false;
+        }
+
+        void insert_compare_cache(unsigned id_a, unsigned id_b, ::sign r) {
+            if (m_compare_cache.size() >= m_compare_cache_size)
+                m_compare_cache.reset();
+            m_compare_cache.insert(compare_key(id_a, id_b), r);
+        }
+
         ::sign compare_core(numeral & a, numeral & b) {
             SASSERT(!a.is_basic() && !b.is_basic());
             algebraic_cell * cell_a = a.to_algebraic();
@@ -1767,18 +1829,36 @@ namespace algebraic_numbers {
             mpbq const & b_lower = lower(cell_b);
             mpbq const & b_upper = upper(cell_b);
 
-            #define COMPARE_INTERVAL()                  \
-            if (bqm().le(a_upper, b_lower)) {           \
-                m_compare_cheap++;                      \
-                return sign_neg;                        \
-            }                                           \
-            if (bqm().ge(a_lower, b_upper)) {           \
-                m_compare_cheap++;                      \
-                return sign_pos;                        \
-            }
-
             COMPARE_INTERVAL();
 
+            if (m_compare_cache_size == 0)
+                return compare_overlapping(a, b);
+
+            // The intervals overlap. Refinement, Sturm sequences and the
+            // polynomial equality test are expensive, so reuse the result of a
+            // previous comparison of the same values.
+            ::sign r;
+            if (find_compare_cache(cell_a, cell_b, r)) {
+                m_compare_cache_hits++;
+                return r;
+            }
+            // the cells may be deleted by refinement
+            unsigned id_a = cell_a->m_id, id_b = cell_b->m_id;
+            r = compare_overlapping(a, b);
+            if (m_limit.inc())
+                insert_compare_cache(id_a, id_b, r);
+            return r;
+        }
+
+        ::sign compare_overlapping(numeral & a, numeral & b) {
+            SASSERT(!a.is_basic() && !b.is_basic());
+            algebraic_cell * cell_a = a.to_algebraic();
+            algebraic_cell * cell_b = b.to_algebraic();
+            mpbq const & a_lower = lower(cell_a);
+            mpbq const & a_upper = upper(cell_a);
+            mpbq const & b_lower = lower(cell_b);
+            mpbq const & b_upper = upper(cell_b);
+
             // if cell_a and cell_b, contain the same polynomial,
             // and the intervals are overlapping, then they are
             // the same root.
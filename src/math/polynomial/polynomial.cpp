@@ -1857,6 +1857,7 @@ namespace polynomial {
         unsigned_vector          m_degree2pos;
         bool                     m_use_sparse_gcd;
         bool                     m_use_prs_gcd;
+        bool                     m_use_modular_resultant;
 
         // Debugging method: check if the coefficients of p are in the numeral_manager.
         bool consistent_coeffs(polynomial const * p) {
@@ -2338,6 +2339,7 @@ namespace polynomial {
             inc_ref(m_unit_poly);
             m_use_sparse_gcd = true;
             m_use_prs_gcd = false;
+            m_use_modular_resultant = true;
         }
 
         imp(reslimit& lim, manager & w, unsynch_mpz_manager & m, monomial_manager * mm):
@@ -5398,6 +5400,81 @@ namespace polynomial {
                     Res(A, B) = (-1)^(m*n) * mul(Res(R, B), lc^(m - r - d * n))
         */
         void resultant(polynomial const * p, polynomial const * q, var x, polynomial_ref & result) {
+            if (m_use_modular_resultant && !m().modular() && !is_const(p) && !is_const(q) &&
+                mod_resultant(p, q, x, result))
+                return;
+            prs_resultant(p, q, x, result);
+        }
+
+        // sum of the absolute values of the coefficients of p
+        void norm1(polynomial const * p, numeral & r) {
+            scoped_numeral a(m());
+            m().reset(r);
+            for (unsigned i = 0; i < p->size(); i++) {
+                m().set(a, p->a(i));
+                m().abs(a);
+                m().add(r, a, r);
+            }
+        }
+
+        /**
+           \brief Compute Res(p, q, x) as the Chinese remainder combination of the
+           resultants of the images of p and q in Z_p for word sized primes p.
+
+           Res(p, q, x) is the determinant of the Sylvester matrix. Its coefficients are
+           bounded by |p|_1^deg(q) * |q|_1^deg(p), where |.|_1 is the sum of the absolute
+           values of the coefficients, so the combination is exact when the product of the
+           primes exceeds twice the bound. Primes where a leading coefficient vanishes are
+           skipped, the images of the remaining primes are images of the resultant.
+
+           Return false if there are not enough primes.
+        */
+        bool mod_resultant(polynomial const * p, polynomial const * q, var x, polynomial_ref & result) {
+            SASSERT(!m().modular());
+            unsigned d_p = degree(p, x);
+            unsigned d_q = degree(q, x);
+            if (d_p == 0 || d_q == 0)
+                return false;
+            scoped_numeral bound(m()), n_p(m()), n_q(m());
+            norm1(p, n_p);
+            norm1(q, n_q);
+            m().power(n_p, d_q, n_p);
+            m().power(n_q, d_p, n_q);
+            m().mul(n_p, n_q, bound);
+            m().mul(bound, 2, bound);
+            TRACE("mod_resultant", tout << "p: " << p << "\nq: " << q << "\nbound: " << bound << "\n";);
+
+            polynomial_ref p_Zp(m_wrapper), q_Zp(m_wrapper), r_Zp(m_wrapper), C_star(m_wrapper);
+            scoped_numeral prime(m()), modulus(m());
+            for (unsigned i = 0; i < NUM_BIG_PRIMES; i++) {
+                checkpoint();
+                m().set(prime, g_big_primes[i]);
+                {
+                    scoped_set_zp setZp(m_wrapper, prime);
+                    p_Zp = normalize(p);
+                    q_Zp = normalize(q);
+                    if (degree(p_Zp, x) < d_p || degree(q_Zp, x) < d_q)
+                        continue; // bad prime, leading coefficient vanished
+                    prs_resultant(p_Zp, q_Zp, x, r_Zp);
+                }
+                if (C_star.get() == nullptr) {
+                    C_star = r_Zp;
+                    m().set(modulus, prime);
+                }
+                else {
+                    CRA_combine_images(r_Zp, prime, C_star, modulus, C_star);
+                }
+                if (m().gt(modulus, bound)) {
+                    TRACE("mod_resultant", tout << "result: " << C_star << "\n";);
+                    result = C_star;
+                    return true;
+                }
+            }
+            TRACE("mod_resultant", tout << "not enough primes\n";);
+            return false;
+        }
+
+        void prs_resultant(polynomial const * p, polynomial const * q, var x, polynomial_ref & result) {
             polynomial_ref A(pm());
             polynomial_ref B(pm());
             A = const_cast<polynomial*>(p);
@@ -6984,6 +7061,10 @@ namespace polynomial {
         return m_imp->m_manager.m();
     }
 
+    reslimit & manager::limit() const {
+        return m_imp->m_limit;
+    }
+
     monomial_manager & manager::mm() const {
         return m_imp->mm();
     }
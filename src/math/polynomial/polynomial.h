@@ -201,6 +201,7 @@ namespace polynomial {
         numeral_manager & m() const;
         monomial_manager & mm() const;
         small_object_allocator & allocator() const;
+        reslimit & limit() const;
 
         /**
            \brief Return true if Z_p[X1, ..., Xn]
@@ -29,6 +29,7 @@ Notes:
 #include "util/ref_vector.h"
 #include "util/ref_buffer.h"
 #include "util/common_msgs.h"
+#include "util/map.h"
 
 #ifndef REALCLOSURE_INI_BUFFER_SIZE
 #define REALCLOSURE_INI_BUFFER_SIZE 32
@@ -395,6 +396,15 @@ namespace realclosure {
         scoped_mpbq                    m_plus_inf_approx; // lower bound for binary rational intervals used to approximate an infinite positive value
         scoped_mpbq                    m_minus_inf_approx; // upper bound for binary rational intervals used to approximate an infinite negative value
         bool                           m_lazy_algebraic_normalization;
+        unsigned                       m_sign_cache_size;
+
+        // Signs of polynomials q at algebraic extensions x computed by expensive_algebraic_poly_interval.
+        // The coefficients of q are pinned by the cache, and the entries for x are deleted with x.
+        struct sign_entry {
+            polynomial m_p;
+            int        m_sign;
+        };
+        ptr_addr_map<algebraic, ptr_vector<sign_entry>*> m_sign_cache;
 
         // Tracing
         unsigned                       m_exec_depth;
@@ -521,6 +531,8 @@ namespace realclosure {
 
         ~imp() {
             restore_saved_intervals(); // to free memory
+            while (!m_sign_cache.empty())
+                del_sign_cache(m_sign_cache.begin()->m_key);
             dec_ref(m_one);
             dec_ref(m_pi);
             dec_ref(m_e);
@@ -738,6 +750,7 @@ namespace realclosure {
             m_inf_precision      = p.inf_precision();
             m_max_precision      = p.max_precision();
             m_lazy_algebraic_normalization = p.lazy_algebraic_normalization();
+            m_sign_cache_size    = p.sign_cache_size();
             bqm().power(mpbq(2), m_inf_precision, m_plus_inf_approx);
             bqm().set(m_minus_inf_approx, m_plus_inf_approx);
             bqm().neg(m_minus_inf_approx);
@@ -823,6 +836,7 @@ namespace realclosure {
         }
 
         void del_algebraic(algebraic * a) {
+            del_sign_cache(a);
             reset_p(a->m_p);
             bqim().del(a->m_interval);
             bqim().del(a->m_iso_interval);
@@ -4560,6 +4574,63 @@ namespace realclosure {
             }
         }
 
+        // ---------------------------------
+        //
+        // Sign cache
+        //
+        // ---------------------------------
+
+        static bool same_coeffs(polynomial const & p, polynomial const & q) {
+            if (p.size() != q.size())
+                return false;
+            for (unsigned i = 0; i < p.size(); i++)
+                if (p[i] != q[i])
+                    return false;
+            return true;
+        }
+
+        bool find_cached_sign(polynomial const & q, algebraic * x, int & s) {
+            ptr_vector<sign_entry>* entries = nullptr;
+            if (!m_sign_cache.find(x, entries))
+                return false;
+            for (sign_entry* e : *entries) {
+                if (same_coeffs(e->m_p, q)) {
+                    s = e->m_sign;
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        void cache_sign(polynomial const & q, algebraic * x, int s) {
+            if (m_sign_cache_size == 0 || q.empty())
+                return;
+            ptr_vector<sign_entry>* entries = nullptr;
+            if (!m_sign_cache.find(x, entries)) {
+                entries = alloc(ptr_vector<sign_entry>);
+                m_sign_cache.insert(x, entries);
+            }
+            if (entries->size() >= m_sign_cache_size)
+                return;
+            sign_entry* e = alloc(sign_entry);
+            e->m_sign = s;
+            set_p(e->m_p, q.size(), q.data());
+            entries->push_back(e);
+        }
+
+        void del_sign_cache(algebraic * x) {
+            ptr_vector<sign_entry>* entries = nullptr;
+            if (!m_sign_cache.find(x, entries))
+                return;
+            // erase first, releasing the coefficients may delete other extensions.
+            m_sign_cache.erase(x);
+            for (sign_entry* e : *entries) {
+                reset_p(e->m_p);
+                dealloc(e);
+            }
+            dealloc(entries);
+        }
+
         /**
            \brief If q(x) != 0, return true and store in r an interval that contains the value q(x), but does not contain 0.
                   If q(x) == 0, return false
@@ -4574,6 +4645,29 @@ namespace realclosure {
                 }
                 return true;
             }
+            int s;
+            if (find_cached_sign(q, x, s)) {
+                if (s == 0)
+                    return false;
+                if (!depends_on_infinitesimals(q, x))
+                    refine_until_sign_determined(q, x, r);
+                else if (s > 0)
+                    set_lower_zero(r);
+                else
+                    set_upper_zero(r);
+                SASSERT(!contains_zero(r));
+                return true;
+            }
+            bool is_nz = expensive_algebraic_poly_sign(q, x, r);
+            cache_sign(q, x, !is_nz ? 0 : (bqim().is_P(r) ? 1 : -1));
+            return is_nz;
+        }
+
+        /**
+           \brief Sign determination of q(x) when the interval of q(x) contains zero.
+           It has the same contract as expensive_algebraic_poly_interval.
+        */
+        bool expensive_algebraic_poly_sign(polynomial const & q, algebraic * x, mpbqi & r) {
             int num_roots = x->num_roots_inside_interval();
             SASSERT(x->sdt() != 0 || num_roots == 1);
             polynomial const & p = x->p();
@@ -0,0 +1,272 @@
+/*++
+Copyright (c) 2021 Microsoft Corporation
+
+Module Name:
+
+    bv_batch_evaluator.cpp
+
+Abstract:
+
+    Evaluation of bit-vector and Boolean terms of at most 64 bits
+    on machine integers.
+
+--*/
+#include "model/bv_batch_evaluator.h"
+
+static inline uint64_t mk_mask(unsigned sz) {
+    return sz >= 64 ? ~0ull : (1ull << sz) - 1;
+}
+
+static inline int64_t to_signed(uint64_t v, unsigned sz) {
+    return sz == 0 ? 0 : static_cast<int64_t>(v << (64 - sz)) >> (64 - sz);
+}
+
+bv_batch_evaluator::bv_batch_evaluator(ast_manager& m):
+    m(m),
+    m_bv(m),
+    m_program(m) {
+}
+
+bool bv_batch_evaluator::is_supported(sort* s) const {
+    return m.is_bool(s) || (m_bv.is_bv_sort(s) && m_bv.get_bv_size(s) <= 64);
+}
+
+bool bv_batch_evaluator::apply(func_decl* f, unsigned num_args, uint64_t const* const* args, unsigned n, uint64_t* r) const {
+    family_id fid = f->get_family_id();
+    uint64_t const* a = num_args > 0 ? args[0] : nullptr;
+    uint64_t const* b = num_args > 1 ? args[1] : nullptr;
+    if (fid == m.get_basic_family_id()) {
+        switch (f->get_decl_kind()) {
+        case OP_NOT:
+            for (unsigned i = 0; i < n; ++i) r[i] = a[i] ^ 1;
+            return true;
+        case OP_AND:
+            for (unsigned i = 0; i < n; ++i) r[i] = 1;
+            for (unsigned j = 0; j < num_args; ++j)
+                for (unsigned i = 0; i < n; ++i) r[i] &= args[j][i];
+            return true;
+        case OP_OR:
+            for (unsigned i = 0; i < n; ++i) r[i] = 0;
+            for (unsigned j = 0; j < num_args; ++j)
+                for (unsigned i = 0; i < n; ++i) r[i] |= args[j][i];
+            return true;
+        case OP_XOR:
+            for (unsigned i = 0; i < n; ++i) r[i] = a[i] ^ b[i];
+            return true;
+        case OP_IMPLIES:
+            for (unsigned i = 0; i < n; ++i) r[i] = (a[i] ^ 1) | b[i];
+            return true;
+        case OP_EQ:
+            for (unsigned i = 0; i < n; ++i) r[i] = a[i] == b[i];
+            return true;
+        case OP_ITE:
+            for (unsigned i = 0; i < n; ++i) r[i] = a[i] ? b[i] : args[2][i];
+            return true;
+        default:
+            return false;
+        }
+    }
+    if (fid != m_bv.get_fid() || !is_supported(f->get_range()))
+        return false;
+    for (unsigned j = 0; j < num_args; ++j)
+        if (!m_bv.is_bv_sort(f->get_domain(j)))
+            return false;
+    unsigned sz = m.is_bool(f->get_range()) ? 1 : m_bv.get_bv_size(f->get_range());
+    unsigned asz = num_args > 0 ? m_bv.get_bv_size(f->get_domain(0)) : 0;
+    uint64_t mask = mk_mask(sz);
+    switch (f->get_decl_kind()) {
+    case OP_BADD:
+        for (unsigned i = 0; i < n; ++i) r[i] = a[i];
+        for (unsigned j = 1; j < num_args; ++j)
+            for (unsigned i = 0; i < n; ++i) r[i] = (r[i] + args[j][i]) & mask;
+        return true;
+    case OP_BMUL:
+        for (unsigned i = 0; i < n; ++i) r[i] = a[i];
+        for (unsigned j = 1; j < num_args; ++j)
+            for (unsigned i = 0; i < n; ++i) r[i] = (r[i] * args[j][i]) & mask;
+        return true;
+    case OP_BSUB:
+        for (unsigned i = 0; i < n; ++i) r[i] = (a[i] - b[i]) & mask;
+        return true;
+    case OP_BNEG:
+        for (unsigned i = 0; i < n; ++i) r[i] = (0 - a[i]) & mask;
+        return true;
+    case OP_BAND:
+        for (unsigned i = 0; i < n; ++i) r[i] = a[i];
+        for (unsigned j = 1; j < num_args; ++j)
+            for (unsigned i = 0; i < n; ++i) r[i] &= args[j][i];
+        return true;
+    case OP_BOR:
+        for (unsigned i = 0; i < n; ++i) r[i] = a[i];
+        for (unsigned j = 1; j < num_args; ++j)
+            for (unsigned i = 0; i < n; ++i) r[i] |= args[j][i];
+        return true;
+    case OP_BXOR:
+        for (unsigned i = 0; i < n; ++i) r[i] = a[i];
+        for (unsigned j = 1; j < num_args; ++j)
+            for (unsigned i = 0; i < n; ++i) r[i] ^= args[j][i];
+        return true;
+    case OP_BNOT:
+        for (unsigned i = 0; i < n; ++i) r[i] = ~a[i] & mask;
+        return true;
+    case OP_BSHL:
+        for (unsigned i = 0; i < n; ++i) r[i] = b[i] >= sz ? 0 : (a[i] << b[i]) & mask;
+        return true;
+    case OP_BLSHR:
+        for (unsigned i = 0; i < n; ++i) r[i] = b[i] >= sz ? 0 : a[i] >> b[i];
+        return true;
+    case OP_BASHR:
+        for (unsigned i = 0; i < n; ++i) {
+            int64_t s = to_signed(a[i], sz);
+            r[i] = b[i] >= sz ? (s < 0 ? mask : 0) : static_cast<uint64_t>(s >> b[i]) & mask;
+        }
+        return true;
+    case OP_BUDIV:
+    case OP_BUDIV_I:
+        for (unsigned i = 0; i < n; ++i) r[i] = b[i] == 0 ? mask : a[i] / b[i];
+        return true;
+    case OP_BUREM:
+    case OP_BUREM_I:
+        for (unsigned i = 0; i < n; ++i) r[i] = b[i] == 0 ? a[i] : a[i] % b[i];
+        return true;
+    case OP_ULEQ:
+        for (unsigned i = 0; i < n; ++i) r[i] = a[i] <= b[i];
+        return true;
+    case OP_ULT:
+        for (unsigned i = 0; i < n; ++i) r[i] = a[i] < b[i];
+        return true;
+    case OP_UGEQ:
+        for (unsigned i = 0; i < n; ++i) r[i] = a[i] >= b[i];
+        return true;
+    case OP_UGT:
+        for (unsigned i = 0; i < n; ++i) r[i] = a[i] > b[i];
+        return true;
+    case OP_SLEQ:
+        for (unsigned i = 0; i < n; ++i) r[i] = to_signed(a[i], asz) <= to_signed(b[i], asz);
+        return true;
+    case OP_SLT:
+        for (unsigned i = 0; i < n; ++i) r[i] = to_signed(a[i], asz) < to_signed(b[i], asz);
+        return true;
+    case OP_SGEQ:
+        for (unsigned i = 0; i < n; ++i) r[i] = to_signed(a[i], asz) >= to_signed(b[i], asz);
+        return true;
+    case OP_SGT:
+        for (unsigned i = 0; i < n; ++i) r[i] = to_signed(a[i], asz) > to_signed(b[i], asz);
+        return true;
+    case OP_CONCAT:
+        for (unsigned i = 0; i < n; ++i) r[i] = 0;
+        for (unsigned j = 0; j < num_args; ++j) {
+            unsigned s = m_bv.get_bv_size(f->get_domain(j));
+            for (unsigned i = 0; i < n; ++i) r[i] = s >= 64 ? args[j][i] : (r[i] << s) | args[j][i];
+        }
+        return true;
+    case OP_EXTRACT: {
+        unsigned lo = m_bv.get_extract_low(f);
+        for (unsigned i = 0; i < n; ++i) r[i] = (a[i] >> lo) & mask;
+        return true;
+    }
+    case OP_ZERO_EXT:
+        for (unsigned i = 0; i < n; ++i) r[i] = a[i];
+        return true;
+    case OP_SIGN_EXT:
+        for (unsigned i = 0; i < n; ++i) r[i] = static_cast<uint64_t>(to_signed(a[i], asz)) & mask;
+        return true;
+    default:
+        return false;
+    }
+}
+
+bool bv_batch_evaluator::operator()(expr* t, ptr_vector<expr> const& vars, unsigned n, uint64_t const* values, uint64_t* result) {
+    if (!compile(t, vars, m_program))
+        return false;
+    run(m_program, n, values, result);
+    return true;
+}
+
+bool bv_batch_evaluator::compile(expr* t, ptr_vector<expr> const& vars, program& p) {
+    p.m_term = t;
+    p.m_num_vars = vars.size();
+    p.m_num_regs = vars.size();
+    p.m_consts.reset();
+    p.m_instrs.reset();
+    p.m_arg_regs.reset();
+    m_index.reset();
+    m_todo.reset();
+    for (unsigned j = 0; j < vars.size(); ++j)
+        m_index.insert(vars[j], j);
+    rational val;
+    m_todo.push_back(t);
+    while (!m_todo.empty()) {
+        expr* e = m_todo.back();
+        if (m_index.contains(e)) {
+            m_todo.pop_back();
+            continue;
+        }
+        if (!is_app(e) || !is_supported(e->get_sort()))
+            return false;
+        app* a = to_app(e);
+        uint64_t v = 0;
+        bool is_value = true;
+        if (m_bv.is_numeral(e, val))
+            v = val.get_uint64();
+        else if (m.is_true(e))
+            v = 1;
+        else if (!m.is_false(e))
+            is_value = false;
+        if (is_value) {
+            p.m_consts.push_back(std::make_pair(p.m_num_regs, v));
+            m_index.insert(e, p.m_num_regs++);
+            m_todo.pop_back();
+            continue;
+        }
+        if (a->get_num_args() == 0)
+            return false;
+        bool visited = true;
+        for (expr* arg : *a) {
+            if (!m_index.contains(arg)) {
+                m_todo.push_back(arg);
+                visited = false;
+            }
+        }
+        if (!visited)
+            continue;
+        m_todo.pop_back();
+        // with no assignments apply only checks that the operation is supported.
+        m_args.reset();
+        m_args.resize(a->get_num_args(), nullptr);
+        if (!apply(a->get_decl(), a->get_num_args(), m_args.data(), 0, nullptr))
+            return false;
+        program::instr ins;
+        ins.m_f = a->get_decl();
+        ins.m_num_args = a->get_num_args();
+        ins.m_args = p.m_arg_regs.size();
+        ins.m_result = p.m_num_regs++;
+        for (expr* arg : *a)
+            p.m_arg_regs.push_back(m_index[arg]);
+        p.m_instrs.push_back(ins);
+        m_index.insert(e, ins.m_result);
+    }
+    p.m_result = m_index[t];
+    return true;
+}
+
+void bv_batch_evaluator::run(program const& p, unsigned n, uint64_t const* values, uint64_t* result) {
+    if (n == 0)
+        return;
+    m_columns.reserve(p.m_num_regs * n, 0);
+    uint64_t* cols = m_columns.data();
+    for (unsigned i = 0; i < p.m_num_vars * n; ++i)
+        cols[i] = values[i];
+    for (auto const& c : p.m_consts)
+        for (unsigned i = 0; i < n; ++i)
+            cols[c.first * n + i] = c.second;
+    for (auto const& ins : p.m_instrs) {
+        m_args.reset();
+        for (unsigned j = 0; j < ins.m_num_args; ++j)
+            m_args.push_back(cols + p.m_arg_regs[ins.m_args + j] * n);
+        VERIFY(apply(ins.m_f, ins.m_num_args, m_args.data(), n, cols + ins.m_result * n));
+    }
+    uint64_t const* r = cols + p.m_result * n;
+    for (unsigned i = 0; i < n; ++i)
+        result[i] = r[i];
+}
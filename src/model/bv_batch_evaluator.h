@@ -0,0 +1,97 @@
+/*++
+Copyright (c) 2021 Microsoft Corporation
+
+Module Name:
+
+    bv_batch_evaluator.h
+
+Abstract:
+
+    Evaluation of bit-vector and Boolean terms of at most 64 bits
+    on machine integers.
+
+    A term is evaluated under many assignments at once: every sub-term
+    is stored as a column with one value per assignment, and every
+    operation is a loop over the columns of its arguments.
+    Booleans are represented by 0 and 1.
+
+    Division and remainder by zero follow the SMT-LIB semantics
+    (bvudiv x 0 = -1, bvurem x 0 = x), as in bv_rewriter with hi_div0.
+
+    A term can be compiled once into a program, a sequence of
+    instructions over registers, and then run under new assignments
+    without traversing or allocating terms.
+
+--*/
+#pragma once
+
+#include "ast/bv_decl_plugin.h"
+#include "util/obj_hashtable.h"
+
+class bv_batch_evaluator {
+public:
+    /**
+       \brief a compiled term. Registers 0 .. num_vars-1 hold the
+       variables, followed by the constants and the instruction results.
+    */
+    class program {
+        friend class bv_batch_evaluator;
+        struct instr {
+            func_decl* m_f;
+            unsigned   m_num_args;
+            unsigned   m_args;      // offset into m_arg_regs
+            unsigned   m_result;
+        };
+        expr_ref             m_term;
+        unsigned             m_num_vars { 0 };
+        unsigned             m_num_regs { 0 };
+        unsigned             m_result { 0 };
+        svector<std::pair<unsigned, uint64_t>> m_consts;
+        svector<instr>       m_instrs;
+        unsigned_vector      m_arg_regs;
+    public:
+        program(ast_manager& m): m_term(m) {}
+        unsigned num_instrs() const { return m_instrs.size(); }
+    };
+
+private:
+    ast_manager&             m;
+    bv_util                  m_bv;
+    obj_map<expr, unsigned>  m_index;    // register of a compiled sub-term
+    svector<uint64_t>        m_columns;
+    ptr_vector<expr>         m_todo;
+    ptr_buffer<uint64_t const> m_args;
+    program                  m_program;
+
+    bool is_supported(sort* s) const;
+
+public:
+    bv_batch_evaluator(ast_manager& m);
+
+    /**
+       \brief Apply f to the values of its arguments for n assignments.
+       args[j][i] is the value of argument j in assignment i, the result is
+       stored in r[i]. Return false if f is not supported.
+    */
+    bool apply(func_decl* f, unsigned num_args, uint64_t const* const* args, unsigned n, uint64_t* r) const;
+
+    /**
+       \brief Evaluate t under n assignments to the terms vars.
+       values[j*n + i] is the value of vars[j] in assignment i.
+       The value of t in assignment i is stored in result[i].
+       Return false if t contains a sub-term that is neither in vars nor
+       supported by apply.
+    */
+    bool operator()(expr* t, ptr_vector<expr> const& vars, unsigned n, uint64_t const* values, uint64_t* result);
+
+    /**
+       \brief Compile t over the terms vars into p.
+       Return false under the same conditions as operator().
+    */
+    bool compile(expr* t, ptr_vector<expr> const& vars, program& p);
+
+    /**
+       \brief Run p under n assignments, values and result are as in operator().
+    */
+    void run(program const& p, unsigned n, uint64_t const* values, uint64_t* result);
+};
@@ -22,6 +22,7 @@ Revision History:
 #include "ast/ast_util.h"
 #include "model/func_interp.h"
 #include "ast/array_decl_plugin.h"
+#include "ast/arith_decl_plugin.h"
 
 func_entry::func_entry(ast_manager & m, unsigned arity, expr * const * args, expr * result):
     m_args_are_values(true),
@@ -76,7 +77,8 @@ func_interp::func_interp(ast_manager & m, unsigned arity):
     m_else(nullptr),
     m_args_are_values(true),
     m_interp(nullptr),
-    m_array_interp(nullptr) {
+    m_array_interp(nullptr),
+    m_index_valid(false) {
 }
 
 func_interp::~func_interp() {
@@ -176,6 +178,19 @@ bool func_interp::is_constant() const {
    args_are_values to true if for all entries e e.args_are_values() is true.
 */
 func_entry * func_interp::get_entry(expr * const * args) const {
+    if (m_entries.size() >= 16 && !has_irrational(args)) {
+        if (!m_index_valid)
+            build_index();
+        unsigned idx = UINT_MAX;
+        if (!m_index.find(hash_args(args), idx))
+            return nullptr;
+        for (; idx != UINT_MAX; idx = m_index_next[idx]) {
+            func_entry* curr = m_entries[idx];
+            if (curr->eq_args(m(), m_arity, args))
+                return curr;
+        }
+        return nullptr;
+    }
     for (func_entry* curr : m_entries) {
         if (curr->eq_args(m(), m_arity, args))
             return curr;
@@ -183,6 +198,44 @@ func_entry * func_interp::get_entry(expr * const * args) const {
     return nullptr;
 }
 
+unsigned func_interp::hash_args(expr * const * args) const {
+    unsigned h = m_arity;
+    for (unsigned i = 0; i < m_arity; i++)
+        h = combine_hash(h, args[i]->get_id());
+    return h;
+}
+
+void func_interp::add_to_index(unsigned idx) const {
+    unsigned h = hash_args(m_entries[idx]->get_args());
+    unsigned next = UINT_MAX;
+    m_index.find(h, next);
+    m_index.insert(h, idx);
+    m_index_next.setx(idx, next, UINT_MAX);
+}
+
+void func_interp::build_index() const {
+    m_index.reset();
+    m_index_next.reset();
+    for (unsigned i = 0; i < m_entries.size(); ++i)
+        add_to_index(i);
+    m_index_valid = true;
+}
+
+/**
+   \brief entries are indexed by the ids of their arguments.
+   This coincides with are_equal, except for irrational algebraic numbers,
+   which are compared by value.
+*/
+bool func_interp::has_irrational(expr * const * args) const {
+    for (unsigned i = 0; i < m_arity; i++) {
+        expr* a = args[i];
+        if (is_app(a) && to_app(a)->get_family_id() == arith_family_id &&
+            to_app(a)->get_decl_kind() == OP_IRRATIONAL_ALGEBRAIC_NUM)
+            return true;
+    }
+    return false;
+}
+
 void func_interp::insert_entry(expr * const * args, expr * r) {
     reset_interp_cache();
     func_entry * entry = get_entry(args);
@@ -213,12 +266,15 @@ void func_interp::insert_new_entry(expr * const * args, expr * r) {
     if (!new_entry->args_are_values())
         m_args_are_values = false;
     m_entries.push_back(new_entry);
+    if (m_index_valid)
+        add_to_index(m_entries.size() - 1);
 }
 
 void func_interp::del_entry(unsigned idx) {
     auto* e = m_entries[idx];
     m_entries[idx] = m_entries.back();
     m_entries.pop_back();
+    reset_index();
     e->deallocate(m(), m_arity);
 }
 
@@ -276,6 +332,7 @@ void func_interp::compress() {
     }
     if (j < m_entries.size()) {
         reset_interp_cache();
+        reset_index();
         m_entries.shrink(j);
     }
     // other compression, if else is a default branch.
@@ -302,6 +359,7 @@ void func_interp::compress() {
         }
         m_entries.reset();
         reset_interp_cache();
+        reset_index();
         expr_ref new_else(m().mk_var(0, m_else->get_sort()), m());
         m().inc_ref(new_else);
         m().dec_ref(m_else);
@@ -29,6 +29,7 @@ Revision History:
 --*/
 #pragma once
 
+#include "util/map.h"
 #include "ast/ast.h"
 #include "ast/ast_translation.h"
 
@@ -74,8 +75,21 @@ class func_interp {
 
     expr *                 m_array_interp; // <! interp with lambda abstraction
 
+    // index from the hash of the arguments to the first entry with this hash.
+    // entries with the same hash are chained by m_index_next.
+    // it is built on the first lookup in a large interpretation.
+    mutable u_map<unsigned> m_index;
+    mutable unsigned_vector m_index_next;
+    mutable bool            m_index_valid;
+
     void reset_interp_cache();
 
+    unsigned hash_args(expr * const * args) const;
+    void add_to_index(unsigned idx) const;
+    void build_index() const;
+    void reset_index() { m_index_valid = false; m_index.reset(); m_index_next.reset(); }
+    bool has_irrational(expr * const * args) const;
+
     expr * get_interp_core() const;
 
     expr_ref get_array_interp_core(func_decl * f) const;
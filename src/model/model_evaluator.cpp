@@ -36,6 +36,7 @@ Revision History:
 #include "model/model.h"
 #include "model/model_evaluator_params.hpp"
 #include "model/model_evaluator.h"
+#include "model/bv_batch_evaluator.h"
 #include "model/model_v2_pp.h"
 
 
@@ -57,6 +58,8 @@ struct evaluator_cfg : public default_rewriter_cfg {
     arith_util                      m_au;
     fpa_util                        m_fpau;
     datatype::util                  m_dt;
+    bv_util                         m_bvu;
+    bv_batch_evaluator              m_bv64;
     unsigned long long              m_max_memory;
     unsigned                        m_max_steps;
     bool                            m_model_completion;
@@ -84,6 +87,8 @@ struct evaluator_cfg : public default_rewriter_cfg {
         m_au(m),
         m_fpau(m),
         m_dt(m),
+        m_bvu(m),
+        m_bv64(m),
         m_pinned(m) {
         bool flat = true;
         m_b_rw.set_flat(flat);
@@ -158,6 +163,42 @@ struct evaluator_cfg : public default_rewriter_cfg {
         return st;
     }
 
+    /**
+       \brief Evaluate bit-vector operations on numerals of at most 64 bits on machine integers.
+       Division by zero is left to the rewriter, which knows whether hi_div0 is set.
+    */
+    br_status reduce_bv64(func_decl * f, unsigned num, expr * const * args, expr_ref & result) {
+        uint64_t values[3];
+        uint64_t const* ptrs[3];
+        sort* s = f->get_range();
+        if (num == 0 || num > 3 || (!m.is_bool(s) && (!m_bvu.is_bv_sort(s) || m_bvu.get_bv_size(s) > 64)))
+            return BR_FAILED;
+        rational v;
+        unsigned sz;
+        for (unsigned i = 0; i < num; ++i) {
+            if (!m_bvu.is_numeral(args[i], v, sz) || sz > 64)
+                return BR_FAILED;
+            values[i] = v.get_uint64();
+            ptrs[i] = values + i;
+        }
+        switch (f->get_decl_kind()) {
+        case OP_BUDIV: case OP_BUDIV_I: case OP_BUREM: case OP_BUREM_I:
+            if (values[1] == 0)
+                return BR_FAILED;
+            break;
+        default:
+            break;
+        }
+        uint64_t r;
+        if (!m_bv64.apply(f, num, ptrs, 1, &r))
+            return BR_FAILED;
+        if (m.is_bool(s))
+            result = m.mk_bool_val(r != 0);
+        else
+            result = m_bvu.mk_numeral(rational(r, rational::ui64()), s);
+        return BR_DONE;
+    }
+
     br_status reduce_app_core(func_decl * f, unsigned num, expr * const * args, expr_ref & result, proof_ref & result_pr) {
         result_pr = nullptr;
         family_id fid = f->get_family_id();
@@ -230,8 +271,11 @@ struct evaluator_cfg : public default_rewriter_cfg {
         }
         if (fid == m_a_rw.get_fid())
             st = m_a_rw.mk_app_core(f, num, args, result);
-        else if (fid == m_bv_rw.get_fid())
-            st = m_bv_rw.mk_app_core(f, num, args, result);
+        else if (fid == m_bv_rw.get_fid()) {
+            st = reduce_bv64(f, num, args, result);
+            if (st == BR_FAILED)
+                st = m_bv_rw.mk_app_core(f, num, args, result);
+        }
         else if (fid == m_ar_rw.get_fid())
             st = m_ar_rw.mk_app_core(f, num, args, result);
         else if (fid == m_dt_rw.get_fid())
@@ -20,6 +20,8 @@ Revision History:
 #include<sstream>
 #include "model/model_smt2_pp.h"
 #include "ast/ast_smt2_pp.h"
+#include "ast/ast_smt_pp.h"
+#include "ast/pp_params.hpp"
 #include "ast/func_decl_dependencies.h"
 #include "ast/recfun_decl_plugin.h"
 #include "ast/pp.h"
@@ -290,8 +292,93 @@ static void pp_funs(std::ostream & out, ast_printer_context & ctx, model_core co
     }
 }
 
+/**
+   \brief print the interpretations of the constants and functions without building format trees.
+   Values and function bodies are written directly by ast_smt_pp, which introduces
+   let-bindings for shared sub-terms.
+*/
+static void pp_compact(std::ostream & out, ast_printer_context & ctx, model_core const & md, unsigned indent) {
+    ast_manager & m = ctx.get_ast_manager();
+    ast_smt_pp smt_pp(m);
+    unsigned num = md.get_num_constants();
+    for (unsigned i = 0; i < num; i++) {
+        func_decl * c = md.get_constant(i);
+        pp_indent(out, indent);
+        out << "(define-fun ";
+        pp_symbol(out, c->get_name());
+        out << " () ";
+        ctx.display(out, c->get_range());
+        out << " ";
+        smt_pp.display_expr_smt2(out, md.get_const_interp(c), indent);
+        out << ")\n";
+    }
+
+    recfun::util recfun_util(m);
+    sbuffer<symbol> names;
+    ptr_buffer<char const> var_names;
+    ptr_buffer<func_decl> func_decls;
+    sort_fun_decls(m, md, func_decls);
+    for (func_decl * f : func_decls) {
+        if (recfun_util.is_defined(f) && !recfun_util.is_generated(f)) 
+            continue;
+        if (!m.is_considered_uninterpreted(f)) 
+            continue;            
+        func_interp * f_i = md.get_func_interp(f);
+        unsigned arity = f->get_arity();
+        names.reset();
+        var_names.reset();
+        for (unsigned j = 0; j < arity; j++) {
+            std::stringstream strm;
+            strm << "x!" << (j+1);
+            names.push_back(symbol(strm.str()));
+        }
+        // variable i is the i'th argument, ast_smt_pp names variables from the end.
+        for (unsigned j = arity; j-- > 0; )
+            var_names.push_back(names[j].bare_str());
+        pp_indent(out, indent);
+        out << "(define-fun ";
+        pp_symbol(out, f->get_name());
+        out << " (";
+        for (unsigned j = 0; j < arity; j++) {
+            if (j > 0) out << " ";
+            out << "(" << names[j] << " ";
+            ctx.display(out, f->get_domain(j));
+            out << ")";
+        }
+        out << ") ";
+        ctx.display(out, f->get_range());
+        out << " ";
+        for (unsigned i = 0; i < f_i->num_entries(); i++) {
+            func_entry const * e = f_i->get_entry(i);
+            out << "(ite ";
+            if (arity > 1) out << "(and ";
+            for (unsigned j = 0; j < arity; j++) {
+                if (j > 0) out << " ";
+                out << "(= " << names[j] << " ";
+                smt_pp.display_expr_smt2(out, e->get_arg(j), indent);
+                out << ")";
+            }
+            if (arity > 1) out << ")";
+            out << " ";
+            smt_pp.display_expr_smt2(out, e->get_result(), indent);
+            out << " ";
+        }
+        if (f_i->is_partial())
+            out << "#unspecified";
+        else
+            smt_pp.display_expr_smt2(out, f_i->get_else(), indent, var_names.size(), var_names.data());
+        for (unsigned i = 0; i < f_i->num_entries(); i++)
+            out << ")";
+        out << ")\n";
+    }
+}
+
 void model_smt2_pp(std::ostream & out, ast_printer_context & ctx, model_core const & m, unsigned indent) {
     pp_uninterp_sorts(out, ctx, m, indent);
+    if (pp_params().compact()) {
+        pp_compact(out, ctx, m, indent);
+        return;
+    }
     pp_consts(out, ctx, m, indent);
     pp_funs(out, ctx, m, indent);
 }
@@ -299,9 +386,7 @@ void model_smt2_pp(std::ostream & out, ast_printer_context & ctx, model_core con
 void model_smt2_pp(std::ostream & out, ast_manager & m, model_core const & md, unsigned indent) {
     scoped_ptr<ast_printer_context> ctx;
     ctx = mk_simple_ast_printer_context(m);
-    pp_uninterp_sorts(out, *(ctx.get()), md, indent);
-    pp_consts(out, *(ctx.get()), md, indent);
-    pp_funs(out, *(ctx.get()), md, indent);
+    model_smt2_pp(out, *(ctx.get()), md, indent);
 }
 
 std::ostream& operator<<(std::ostream& out, model_core const& m) {
@@ -290,6 +290,8 @@ namespace datalog {
     unsigned context::soft_timeout() const { return m_params->datalog_timeout(); }
     bool context::similarity_compressor() const { return m_params->datalog_similarity_compressor(); }
     unsigned context::similarity_compressor_threshold() const { return m_params->datalog_similarity_compressor_threshold(); }
+    unsigned context::join_threads() const { return m_params->datalog_join_threads(); }
+    unsigned context::spill_memory() const { return m_params->datalog_spill_memory(); }
     unsigned context::initial_restart_timeout() const { return m_params->datalog_initial_restart_timeout(); }
     bool context::generate_explanations() const { return m_params->datalog_generate_explanations(); }
     bool context::explanations_on_relation_level() const { return m_params->datalog_explanations_on_relation_level(); }
@@ -35,6 +35,11 @@ Revision History:
 #include "muz/transforms/dl_transforms.h"
 #include "muz/transforms/dl_mk_rule_inliner.h"
 #include "muz/base/fp_params.hpp"
+#include "ast/ast_translation.h"
+#include "util/scoped_ptr_vector.h"
+#ifndef SINGLE_THREAD
+#include "util/thread_pool.h"
+#endif
 
 
 namespace datalog {
@@ -1165,6 +1170,9 @@ namespace datalog {
         lbool check() {
             setup();
             unsigned max_depth = b.m_ctx.get_params().bmc_linear_unrolling_depth();
+            unsigned num_workers = b.m_ctx.get_params().bmc_workers();
+            if (num_workers > 1)
+                return check_par(max_depth, num_workers);
             for (unsigned i = 0; i < max_depth; ++i) {
                 IF_VERBOSE(1, verbose_stream() << "level: " << i << "\n";);
                 b.checkpoint();
@@ -1183,6 +1191,85 @@ namespace datalog {
 
     private:
 
+        /**
+           \brief Check num_workers consecutive levels at a time, each on a copy
+           of the solver in its own manager. The copies are created once and
+           receive the frames asserted since the previous round, so they are
+           extended incrementally like the main solver. The main solver only
+           re-checks the smallest satisfiable level to produce the trace.
+        */
+        lbool check_par(unsigned max_depth, unsigned num_workers) {
+#ifdef SINGLE_THREAD
+            num_workers = 1;
+#endif
+            scoped_ptr_vector<ast_manager> managers;
+            sref_vector<solver> solvers;
+            try {
+                for (unsigned j = 0; j < num_workers; ++j) {
+                    managers.push_back(alloc(ast_manager, m, true));
+                    solvers.push_back(b.m_solver->translate(*managers.back(), b.m_solver->get_params()));
+                }
+            }
+            catch (z3_exception&) {
+                return l_undef;
+            }
+            scoped_limits sl(m.limit());
+            for (ast_manager* wm : managers)
+                sl.push_child(&(wm->limit()));
+            unsigned_vector synced(num_workers, 0u);
+            vector<expr_ref> queries;
+            svector<lbool> results;
+            for (unsigned i = 0; i < max_depth; i += num_workers) {
+                unsigned k = std::min(num_workers, max_depth - i);
+                IF_VERBOSE(1, verbose_stream() << "level: " << i << "-" << (i + k - 1) << "\n";);
+                b.checkpoint();
+                for (unsigned j = 0; j < k; ++j)
+                    compile(i + j);
+                queries.reset();
+                for (unsigned j = 0; j < k; ++j) {
+                    ast_translation tr(m, *managers[j]);
+                    for (; synced[j] < b.m_assertions.size(); ++synced[j])
+                        solvers[j]->assert_expr(tr(b.m_assertions.get(synced[j])));
+                    queries.push_back(expr_ref(tr(mk_level_predicate(b.m_query_pred, i + j).get()), *managers[j]));
+                }
+                results.reset();
+                results.resize(k, l_undef);
+#ifndef SINGLE_THREAD
+                thread_pool threads;
+                for (unsigned j = 0; j < k; ++j) {
+                    threads.run([&, j]() {
+                        try {
+                            expr* q = queries[j].get();
+                            results[j] = solvers[j]->check_sat(1, &q);
+                        }
+                        catch (z3_exception&) {
+                            results[j] = l_undef;
+                        }
+                        // deeper levels are not needed once a trace is found
+                        if (results[j] == l_true)
+                            for (unsigned l = j + 1; l < k; ++l)
+                                managers[l]->limit().cancel();
+                    });
+                }
+                threads.join();
+#else
+                expr* q = queries[0].get();
+                results[0] = solvers[0]->check_sat(1, &q);
+#endif
+                for (unsigned j = 0; j < k; ++j) {
+                    if (results[j] == l_undef)
+                        return l_undef;
+                    if (results[j] == l_true) {
+                        lbool res = check(i + j);
+                        if (res == l_true)
+                            get_model(i + j);
+                        return res;
+                    }
+                }
+            }
+            return l_undef;
+        }
+
         void get_model(unsigned level) {
             if (!m.inc()) {
                 return;
@@ -1440,7 +1527,8 @@ namespace datalog {
         m_rules(ctx),
         m_query_pred(m),
         m_answer(m),
-        m_rule_trace(ctx.get_rule_manager()) {
+        m_rule_trace(ctx.get_rule_manager()),
+        m_assertions(m) {
     }
 
     bmc::~bmc() {}
@@ -1448,6 +1536,7 @@ namespace datalog {
     lbool bmc::query(expr* query) {
         m_solver = nullptr;
         m_answer = nullptr;
+        m_assertions.reset();
         m_ctx.ensure_opened();
         m_rules.reset();
         datalog::rule_manager& rule_manager = m_ctx.get_rule_manager();
@@ -1515,6 +1604,7 @@ namespace datalog {
     void bmc::assert_expr(expr* e) {
         TRACE("bmc", tout << mk_pp(e, m) << "\n";);
         m_solver->assert_expr(e);
+        m_assertions.push_back(e);
     }
 
     bool bmc::is_linear() const {
@@ -35,6 +35,7 @@ namespace datalog {
         func_decl_ref    m_query_pred;
         expr_ref         m_answer;
         rule_ref_vector  m_rule_trace;
+        expr_ref_vector  m_assertions;   // formulas asserted to m_solver
 
         void checkpoint();
 
@@ -1099,7 +1099,7 @@ namespace datalog {
 
     void compiler::compile_loop(const func_decl_vector & head_preds, const func_decl_set & widened_preds,
             const pred2idx & global_head_deltas, const pred2idx & global_tail_deltas, 
-            const pred2idx & local_deltas, instruction_block & acc) {
+            const pred2idx & local_deltas, instruction_block & acc, const pred2idx * total_deltas) {
         instruction_block * loop_body = alloc(instruction_block);
         loop_body->set_observer(&m_instruction_observer);
 
@@ -1115,6 +1115,12 @@ namespace datalog {
 
         svector<reg_idx> loop_control_regs; //loop is controlled by global src regs
         collect_map_range(loop_control_regs, global_tail_deltas);
+        if (total_deltas) {
+            for (auto const& kv : global_head_deltas) {
+                loop_body->push_back(instruction::mk_union(kv.m_value, total_deltas->find(kv.m_key), 
+                    execution_context::void_register));
+            }
+        }
         //move target deltas into source deltas at the end of the loop
         //and clear local deltas
         make_inloop_delta_transition(global_head_deltas, global_tail_deltas, local_deltas, *loop_body);
@@ -1192,6 +1198,44 @@ namespace datalog {
         }
     }
 
+    void compiler::compile_incremental_stratum(const func_decl_set & head_preds,
+            pred2idx & input_deltas, instruction_block & acc) {
+        func_decl_vector preds_vector;
+        func_decl_set global_deltas_dummy;
+        detect_chains(head_preds, preds_vector, global_deltas_dummy);
+
+        pred2idx d_global_src;
+        get_fresh_registers(head_preds, d_global_src);
+        pred2idx d_global_tgt;
+        get_fresh_registers(head_preds, d_global_tgt);
+        pred2idx d_local;
+        pred2idx d_total;  //all facts added to the head predicates
+        get_fresh_registers(head_preds, d_total);
+
+        //the initial deltas are the new facts of the head predicates together with 
+        //the consequences of the new facts of the lower strata
+        for (func_decl * pred : preds_vector) {
+            reg_idx d_src = d_global_src.find(pred);
+            reg_idx d_new;
+            if (input_deltas.find(pred, d_new)) {
+                acc.push_back(instruction::mk_clone(d_new, d_src));
+            }
+            for (rule * r : m_rule_set.get_predicate_rules(pred)) {
+                compile_rule_evaluation(r, &input_deltas, d_src, false, acc);
+            }
+        }
+        for (func_decl * pred : preds_vector) {
+            acc.push_back(instruction::mk_clone(d_global_src.find(pred), d_total.find(pred)));
+        }
+
+        func_decl_set empty_func_decl_set;
+        compile_loop(preds_vector, empty_func_decl_set, d_global_tgt, d_global_src, d_local, acc, &d_total);
+
+        for (func_decl * pred : preds_vector) {
+            input_deltas.insert(pred, d_total.find(pred));
+        }
+    }
+
     bool compiler::is_nonrecursive_stratum(const func_decl_set & preds) const {
         SASSERT(preds.size()>0);
         if(preds.size()>1) {
@@ -1336,5 +1380,86 @@ namespace datalog {
     }
 
 
+    bool compiler::do_incremental_compilation(obj_map<func_decl, func_decl*> const & new_facts,
+            instruction_block & execution_code, instruction_block & termination_code) {
+
+        if (all_or_nothing_deltas() || compile_with_widening()) {
+            return false;
+        }
+
+        instruction_block & acc = execution_code;
+        acc.set_observer(&m_instruction_observer);
+
+        //load predicate data
+        for (rule * r : m_rule_set) {
+            ensure_predicate_loaded(r->get_decl(), acc);
+            unsigned rule_len = r->get_uninterpreted_tail_size();
+            for (unsigned j = 0; j < rule_len; j++) {
+                ensure_predicate_loaded(r->get_tail(j)->get_decl(), acc);
+            }
+        }
+
+        //load the new facts
+        pred2idx input_deltas;
+        for (auto const& kv : new_facts) {
+            reg_idx reg;
+            if (!m_pred_regs.find(kv.m_key, reg)) {
+                continue;
+            }
+            reg_idx delta_reg = get_fresh_register(m_reg_signatures[reg]);
+            acc.push_back(instruction::mk_load(m_context.get_manager(), kv.m_value, delta_reg));
+            input_deltas.insert(kv.m_key, delta_reg);
+        }
+
+        //propagate the new facts through the strata in the order of their dependencies
+        for (func_decl_set * strat_preds : m_rule_set.get_stratifier().get_strats()) {
+            bool has_delta = false;
+            for (func_decl * pred : *strat_preds) {
+                for (rule * r : m_rule_set.get_predicate_rules(pred)) {
+                    unsigned pos_len = r->get_positive_tail_size();
+                    unsigned rule_len = r->get_uninterpreted_tail_size();
+                    for (unsigned j = 0; j < rule_len; j++) {
+                        if (!input_deltas.contains(r->get_decl(j))) {
+                            continue;
+                        }
+                        if (j >= pos_len) {
+                            //new facts of a negated predicate may retract facts
+                            acc.set_observer(nullptr);
+                            return false;
+                        }
+                        has_delta = true;
+                    }
+                }
+            }
+            if (!has_delta) {
+                continue;
+            }
+            if (is_nonrecursive_stratum(*strat_preds)) {
+                func_decl * head_pred = *strat_preds->begin();
+                reg_idx output_delta;
+                if (!input_deltas.find(head_pred, output_delta)) {
+                    output_delta = get_fresh_register(m_reg_signatures[m_pred_regs.find(head_pred)]);
+                }
+                pred2idx output_deltas;
+                output_deltas.insert(head_pred, output_delta);
+                compile_nonrecursive_stratum(*strat_preds, &input_deltas, output_deltas, false, acc);
+                input_deltas.insert(head_pred, output_delta);
+            }
+            else {
+                compile_incremental_stratum(*strat_preds, input_deltas, acc);
+            }
+        }
+
+        //store predicate data
+        for (auto const& kv : m_pred_regs) {
+            termination_code.push_back(instruction::mk_store(m_context.get_manager(), kv.m_key, kv.m_value));
+        }
+
+        acc.set_observer(nullptr);
+
+        TRACE("dl", execution_code.display(execution_context(m_context), tout););
+        return true;
+    }
+
 }
 
@@ -226,9 +226,15 @@ namespace datalog {
 
         void make_inloop_delta_transition(const pred2idx & global_head_deltas, 
             const pred2idx & global_tail_deltas, const pred2idx & local_deltas, instruction_block & acc);
+        /**
+           \brief Generate the loop of the fixpoint search of a recursive stratum. If \c total_deltas
+           is given, the facts added to the head predicates in each iteration are also collected
+           in its registers.
+         */
         void compile_loop(const func_decl_vector & head_preds, const func_decl_set & widened_preds,
             const pred2idx & global_head_deltas, const pred2idx & global_tail_deltas, 
-            const pred2idx & local_deltas, instruction_block & acc);
+            const pred2idx & local_deltas, instruction_block & acc,
+            const pred2idx * total_deltas = nullptr);
         void compile_dependent_rules(const func_decl_set & head_preds,
             const pred2idx * input_deltas, const pred2idx & output_deltas, 
             bool add_saturation_marks, instruction_block & acc);
@@ -252,6 +258,14 @@ namespace datalog {
             const pred2idx * input_deltas, const pred2idx & output_deltas, 
             bool add_saturation_marks, instruction_block & acc);
 
+        /**
+           \brief Generate code that adds to the head predicates of a recursive stratum the
+           consequences of the new facts in \c input_deltas, and store the added facts
+           of the head predicates in \c input_deltas.
+         */
+        void compile_incremental_stratum(const func_decl_set & head_preds,
+            pred2idx & input_deltas, instruction_block & acc);
+
         bool all_saturated(const func_decl_set & preds) const;
 
         void reset();
@@ -270,6 +284,17 @@ namespace datalog {
         void do_compilation(instruction_block & execution_code, 
             instruction_block & termination_code);
 
+        /**
+           \brief Compile \c rules into pseudocode that extends the relations, which are saturated
+           except for the new facts stored under the predicates of \c new_facts, by the
+           consequences of these facts.
+
+           Return false if this is not possible, since a predicate with new facts is used
+           under negation.
+        */
+        bool do_incremental_compilation(obj_map<func_decl, func_decl*> const & new_facts,
+            instruction_block & execution_code, instruction_block & termination_code);
+
     public:
 
         static void compile(context & ctx, rule_set const & rules, instruction_block & execution_code, 
@@ -278,6 +303,13 @@ namespace datalog {
                 .do_compilation(execution_code, termination_code);
         }
 
+        static bool compile_incremental(context & ctx, rule_set const & rules, 
+                obj_map<func_decl, func_decl*> const & new_facts,
+                instruction_block & execution_code, instruction_block & termination_code) {
+            return compiler(ctx, rules, execution_code)
+                .do_incremental_compilation(new_facts, execution_code, termination_code);
+        }
+
     };
 
 
@@ -20,10 +20,12 @@ Revision History:
 #include<utility>
 #include<sstream>
 #include<limits>
+#include<cmath>
 #include "ast/ast_pp.h"
 #include "util/trace.h"
 #include "muz/rel/dl_mk_simple_joins.h"
 #include "muz/rel/dl_relation_manager.h"
+#include "muz/rel/dl_table_relation.h"
 
 
 namespace datalog {
@@ -133,6 +135,7 @@ namespace datalog {
         
         ast_ref_vector m_pinned;
         mutable ptr_vector<sort> m_vars;
+        mutable obj_map<func_decl, svector<cost> > m_column_sizes; // sampled distinct values per column
 
     public:
         join_planner(context & ctx, rule_set & rs_aux_copy)
@@ -601,6 +604,60 @@ namespace datalog {
             return static_cast<cost>(m_context.get_sort_size_estimate(s));            
         }
 
+        cost get_column_size(app * t, unsigned idx) const {
+            func_decl * pred = t->get_decl();
+            svector<cost> sizes;
+            if (!m_column_sizes.find(pred, sizes)) {
+                sample_column_sizes(pred, sizes);
+                m_column_sizes.insert(pred, sizes);
+            }
+            cost dom = get_domain_size(t->get_arg(idx));
+            if (idx < sizes.size() && sizes[idx] > 0 && sizes[idx] < dom)
+                return sizes[idx];
+            return dom;
+        }
+
+        /**
+           \brief Estimate the number of distinct values in the columns of the
+           relation of pred from a sample of its rows. No estimate is produced
+           for relations that were not computed or are not tables.
+        */
+        void sample_column_sizes(func_decl * pred, svector<cost> & sizes) const {
+            static const unsigned max_sample = 1000;
+            rel_context_base* rel = m_context.get_rel_context();
+            if (!rel) 
+                return;
+            relation_manager& rm = rel->get_rmanager();
+            relation_base * r = rm.try_get_relation(pred);
+            if (!r || !(m_context.saturation_was_run() || rm.is_saturated(pred)) || !r->from_table())
+                return;
+            table_base const& t = static_cast<table_relation const&>(*r).get_table();
+            unsigned n = t.get_signature().size();
+            unsigned num_rows = t.get_size_estimate_rows();
+            if (num_rows == 0)
+                return;
+            vector<u_map<unsigned> > counts(n);
+            unsigned k = 0;
+            for (table_base::row_interface& row : t) {
+                if (k == max_sample)
+                    break;
+                ++k;
+                for (unsigned i = 0; i < n; ++i) {
+                    unsigned v = static_cast<unsigned>(row[i]);
+                    counts[i].insert_if_not_there(v, 0)++;
+                }
+            }
+            // scale the number of values seen once to the whole relation
+            cost scale = sqrt(static_cast<cost>(num_rows) / static_cast<cost>(k));
+            for (unsigned i = 0; i < n; ++i) {
+                cost once = 0, more = 0;
+                for (auto const& kv : counts[i]) {
+                    if (kv.m_value == 1) ++once; else ++more;
+                }
+                sizes.push_back(std::max(cost(1), scale * once + more));
+            }
+        }
+
         unsigned get_stratum(func_decl * pred) const {
             return m_rs_aux_copy.get_predicate_strat(pred);
         }
@@ -645,20 +702,22 @@ namespace datalog {
                 expr* arg = t1->get_arg(arg_index1);
                 SASSERT(is_var(arg));
                 if (non_local_vars.contains(to_var(arg)->get_idx())) {
-                    inters_size *= get_domain_size(arg);
+                    inters_size *= std::max(get_column_size(t1, arg_index1), get_column_size(t2, arg_index2));
                 }
                 // joined arguments must have the same domain
                 SASSERT(get_domain_size(arg) == get_domain_size(t2->get_arg(arg_index2)));
             }
             // remove contributions from projected columns.
-            for (expr* arg : *t1) {
+            for (unsigned i = 0; i < t1->get_num_args(); ++i) {
+                expr* arg = t1->get_arg(i);
                 if (is_var(arg) && !non_local_vars.contains(to_var(arg)->get_idx())) {
-                    inters_size *= get_domain_size(arg);
+                    inters_size *= get_column_size(t1, i);
                 }
             }
-            for (expr* arg : *t2) {
+            for (unsigned i = 0; i < t2->get_num_args(); ++i) {
+                expr* arg = t2->get_arg(i);
                 if (is_var(arg) && !non_local_vars.contains(to_var(arg)->get_idx())) {
-                    inters_size *= get_domain_size(arg);
+                    inters_size *= get_column_size(t2, i);
                 }
             }
 
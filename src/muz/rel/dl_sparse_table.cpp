@@ -18,8 +18,13 @@ Revision History:
 --*/
 
 #include<utility>
+#include<cstring>
+#ifndef SINGLE_THREAD
+#include "util/thread_pool.h"
+#endif
 #include "muz/base/dl_context.h"
 #include "muz/base/dl_util.h"
+#include "muz/rel/dl_relation_manager.h"
 #include "muz/rel/dl_sparse_table.h"
 
 namespace datalog {
@@ -643,8 +648,14 @@ namespace datalog {
 
     void sparse_table::self_agnostic_join_project(const sparse_table & t1, const sparse_table & t2,
             unsigned joined_col_cnt, const unsigned * t1_joined_cols, const unsigned * t2_joined_cols,
-            const unsigned * removed_cols, bool tables_swapped, sparse_table & result) {
+            const unsigned * removed_cols, bool tables_swapped, sparse_table & result, unsigned num_threads) {
 
+#ifndef SINGLE_THREAD
+        if (num_threads > 1 && joined_col_cnt > 0 && t1.row_count() >= 4096) {
+            par_join_project(t1, t2, joined_col_cnt, t1_joined_cols, t2_joined_cols, removed_cols, tables_swapped, result, num_threads);
+            return;
+        }
+#endif
         verbose_action _va("join_project", 1);
         unsigned t1_entry_size = t1.m_fact_size;
         unsigned t2_entry_size = t2.m_fact_size;
@@ -731,6 +742,100 @@ namespace datalog {
         }
     }
 
+#ifndef SINGLE_THREAD
+    void sparse_table::par_join_project(const sparse_table & t1, const sparse_table & t2,
+            unsigned joined_col_cnt, const unsigned * t1_joined_cols, const unsigned * t2_joined_cols,
+            const unsigned * removed_cols, bool tables_swapped, sparse_table & result, unsigned num_threads) {
+
+        verbose_action _va("par_join_project", 1);
+        unsigned t1_entry_size = t1.m_fact_size;
+        unsigned res_entry_size = result.m_fact_size;
+        size_t t1end = t1.m_data.after_last_offset();
+
+        // query the index sequentially, it uses the reserve of the tables for lookups.
+        key_value t1_key;
+        t1_key.resize(joined_col_cnt);
+        key_indexer& t2_indexer = t2.get_key_indexer(joined_col_cnt, t2_joined_cols);
+        bool key_modified = true;
+        key_indexer::query_result t2_offsets;
+        svector<store_offset> t1_rows;
+        vector<key_indexer::query_result> matches;
+        size_t num_rows = 0;
+        for (size_t t1idx = 0; t1idx != t1end; t1idx += t1_entry_size) {
+            for (unsigned i = 0; i < joined_col_cnt; i++) {
+                table_element val = t1.m_column_layout.get(t1.get_at_offset(t1idx), t1_joined_cols[i]);
+                if (t1_key[i] != val) {
+                    t1_key[i] = val;
+                    key_modified = true;
+                }
+            }
+            if (key_modified) {
+                t2_offsets = t2_indexer.get_matching_offsets(t1_key);
+                key_modified = false;
+            }
+            if (t2_offsets.empty()) 
+                continue;
+            t1_rows.push_back(t1idx);
+            matches.push_back(t2_offsets);
+            num_rows += t2_offsets.end() - t2_offsets.begin();
+        }
+
+        // split the matches into chunks of about the same number of joined rows.
+        unsigned_vector chunk_begin;
+        svector<size_t> chunk_rows;
+        size_t rows_per_chunk = num_rows / num_threads + 1;
+        size_t rows = 0;
+        for (unsigned i = 0; i < matches.size(); ++i) {
+            if (i == 0 || rows >= rows_per_chunk) {
+                chunk_begin.push_back(i);
+                chunk_rows.push_back(0);
+                rows = 0;
+            }
+            size_t n = matches[i].end() - matches[i].begin();
+            rows += n;
+            chunk_rows.back() += n;
+        }
+        chunk_begin.push_back(matches.size());
+        unsigned num_chunks = chunk_rows.size();
+        vector<svector<char>> buffers(num_chunks);
+        for (unsigned c = 0; c < num_chunks; ++c)
+            buffers[c].resize(chunk_rows[c] * res_entry_size, 0);
+
+        auto fill_chunk = [&](unsigned c) {
+            char * res_ptr = buffers[c].data();
+            for (unsigned i = chunk_begin[c]; i < chunk_begin[c + 1]; ++i) {
+                char const * t1ptr = t1.get_at_offset(t1_rows[i]);
+                for (store_offset t2ofs : matches[i]) {
+                    char const * t2ptr = t2.get_at_offset(t2ofs);
+                    if (tables_swapped) {
+                        concatenate_rows(t2.m_column_layout, t1.m_column_layout, result.m_column_layout,
+                            t2ptr, t1ptr, res_ptr, removed_cols);
+                    } else {
+                        concatenate_rows(t1.m_column_layout, t2.m_column_layout, result.m_column_layout,
+                            t1ptr, t2ptr, res_ptr, removed_cols);
+                    }
+                    res_ptr += res_entry_size;
+                }
+            }
+        };
+
+        thread_pool threads;
+        for (unsigned c = 0; c < num_chunks; ++c) 
+            threads.run([&, c]() { fill_chunk(c); });
+        threads.join();
+
+        // insert the joined rows in chunk order, so the result does not depend on scheduling.
+        for (svector<char> const& buffer : buffers) {
+            for (size_t ofs = 0; ofs < buffer.size(); ofs += res_entry_size) {
+                result.m_data.ensure_reserve();
+                result.garbage_collect();
+                memcpy(result.m_data.get_reserve_ptr(), buffer.data() + ofs, res_entry_size);
+                result.add_reserve_content();
+            }
+        }
+    }
+#endif
+
 
     // -----------------------------------
     //
@@ -833,6 +938,7 @@ namespace datalog {
             sparse_table_plugin & plugin = t1.get_plugin();
 
             sparse_table * res = get(plugin.mk_empty(get_result_signature()));
+            unsigned num_threads = plugin.get_manager().get_context().join_threads();
 
             //If we join with some intersection, want to iterate over the smaller table and
             //do indexing into the bigger one. If we simply do a product, we want the bigger
@@ -840,11 +946,11 @@ namespace datalog {
             //the cache)
             if ( (t1.row_count() > t2.row_count()) == (!m_cols1.empty()) ) {
                 sparse_table::self_agnostic_join_project(t2, t1, m_cols1.size(), m_cols2.data(), 
-                    m_cols1.data(), m_removed_cols.data(), true, *res);
+                    m_cols1.data(), m_removed_cols.data(), true, *res, num_threads);
             }
             else {
                 sparse_table::self_agnostic_join_project(t1, t2, m_cols1.size(), m_cols1.data(), 
-                    m_cols2.data(), m_removed_cols.data(), false, *res);
+                    m_cols2.data(), m_removed_cols.data(), false, *res, num_threads);
             }
             TRACE("dl_table_relation", tb1.display(tout); tb2.display(tout); res->display(tout); );
             return res;
@@ -450,7 +450,16 @@ namespace datalog {
         */
         static void self_agnostic_join_project(const sparse_table & t1, const sparse_table & t2,
             unsigned joined_col_cnt, const unsigned * t1_joined_cols, const unsigned * t2_joined_cols,
-            const unsigned * removed_cols, bool tables_swapped, sparse_table & result);
+            const unsigned * removed_cols, bool tables_swapped, sparse_table & result, unsigned num_threads = 1);
+
+        /**
+           \brief Parallel version of the indexed join of \c self_agnostic_join_project.
+           The index is queried and the result is filled sequentially, the joined
+           rows are produced by \c num_threads threads.
+        */
+        static void par_join_project(const sparse_table & t1, const sparse_table & t2,
+            unsigned joined_col_cnt, const unsigned * t1_joined_cols, const unsigned * t2_joined_cols,
+            const unsigned * removed_cols, bool tables_swapped, sparse_table & result, unsigned num_threads);
 
 
         /**
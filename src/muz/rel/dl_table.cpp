@@ -145,6 +145,335 @@ namespace datalog {
         return mk_iterator(alloc(our_iterator_core, *this, true));
     }
 
+    // -----------------------------------
+    //
+    // sorted_table
+    //
+    // -----------------------------------
+
+    table_base * sorted_table_plugin::mk_empty(const table_signature & s) {
+        SASSERT(can_handle_signature(s));
+        return alloc(sorted_table, *this, s);
+    }
+
+    /**
+       \brief Spill the runs of the least recently used tables, other than the
+       joined tables t1 and t2, until the runs in memory fit in the budget.
+       It is called when a join starts, because no table rows are referenced then.
+    */
+    void sorted_table_plugin::spill_cold_tables(sorted_table const& t1, sorted_table const& t2) {
+        size_t budget = static_cast<size_t>(get_manager().get_context().spill_memory()) * 1024 * 1024;
+        if (budget == 0) 
+            return;
+        size_t in_memory = 0;
+        for (sorted_table* t : m_tables) 
+            in_memory += t->memory();
+        if (in_memory <= budget) 
+            return;
+        ptr_vector<sorted_table> cold;
+        for (sorted_table* t : m_tables) 
+            if (t != &t1 && t != &t2 && t->memory() > 0) 
+                cold.push_back(t);
+        std::sort(cold.begin(), cold.end(), [](sorted_table* a, sorted_table* b) { return a->m_last_use < b->m_last_use; });
+        for (sorted_table* t : cold) {
+            if (in_memory <= budget) 
+                break;
+            size_t sz = t->memory();
+            if (t->spill()) 
+                in_memory -= sz;
+        }
+    }
+
+    sorted_table::sorted_table(sorted_table_plugin & plugin, const table_signature & sig)
+        : table_base(plugin, sig), m_num_cols(sig.size()), m_num_rows(0), m_spill(nullptr), m_last_use(0) {
+        plugin.m_tables.push_back(this);
+    }
+
+    sorted_table::~sorted_table() {
+        if (m_spill) 
+            fclose(m_spill);
+        get_plugin().m_tables.erase(this);
+    }
+
+    void sorted_table::ensure_loaded() const {
+        m_last_use = ++get_plugin().m_clock;
+        if (!m_spill) 
+            return;
+        m_rows.resize(m_num_rows * m_num_cols);
+        rewind(m_spill);
+        size_t n = m_rows.size();
+        if (n > 0 && fread(m_rows.data(), sizeof(table_element), n, m_spill) != n) 
+            throw default_exception("could not read spilled table");
+        fclose(m_spill);
+        m_spill = nullptr;
+    }
+
+    bool sorted_table::spill() const {
+        merge_pending();
+        FILE* f = tmpfile();
+        if (!f) 
+            return false;
+        size_t n = m_rows.size();
+        if (n > 0 && fwrite(m_rows.data(), sizeof(table_element), n, f) != n) {
+            fclose(f);
+            return false;
+        }
+        IF_VERBOSE(10, verbose_stream() << "(datalog spill :rows " << m_num_rows << ")\n";);
+        m_spill = f;
+        m_rows.finalize();
+        m_orders.reset();
+        return true;
+    }
+
+    int sorted_table::compare(table_element const* r1, table_element const* r2) const {
+        for (unsigned i = 0; i < m_num_cols; ++i) {
+            if (r1[i] != r2[i]) 
+                return r1[i] < r2[i] ? -1 : 1;
+        }
+        return 0;
+    }
+
+    /**
+       \brief Binary search for f in the sorted run. 
+       idx is the position of f, or where it would be inserted.
+    */
+    bool sorted_table::find(table_element const* f, unsigned& idx) const {
+        ensure_loaded();
+        unsigned lo = 0, hi = m_num_rows;
+        while (lo < hi) {
+            unsigned mid = lo + (hi - lo) / 2;
+            int c = compare(row(mid), f);
+            if (c == 0) {
+                idx = mid;
+                return true;
+            }
+            if (c < 0) 
+                lo = mid + 1;
+            else 
+                hi = mid;
+        }
+        idx = lo;
+        return false;
+    }
+
+    void sorted_table::merge_pending() const {
+        if (m_pending.empty()) 
+            return;
+        ensure_loaded();
+        svector<table_element const*> added;
+        for (table_fact const& f : m_pending) 
+            added.push_back(f.data());
+        std::sort(added.begin(), added.end(), [&](table_element const* a, table_element const* b) { return compare(a, b) < 0; });
+        svector<table_element> rows;
+        unsigned i = 0, j = 0;
+        while (i < m_num_rows || j < added.size()) {
+            table_element const* r;
+            if (j == added.size() || (i < m_num_rows && compare(row(i), added[j]) < 0))
+                r = row(i++);
+            else 
+                r = added[j++];
+            rows.append(m_num_cols, r);
+        }
+        m_rows.swap(rows);
+        m_num_rows += added.size();
+        m_pending.reset();
+        m_orders.reset();
+    }
+
+    /**
+       \brief Sort the distinct rows that were appended to m_rows.
+    */
+    void sorted_table::sort_rows() {
+        unsigned_vector order;
+        for (unsigned i = 0; i < m_num_rows; ++i) 
+            order.push_back(i);
+        std::sort(order.begin(), order.end(), [&](unsigned a, unsigned b) { return compare(row(a), row(b)) < 0; });
+        svector<table_element> rows;
+        for (unsigned i : order) 
+            rows.append(m_num_cols, row(i));
+        m_rows.swap(rows);
+        m_orders.reset();
+    }
+
+    sorted_table::key_order const& sorted_table::get_order(unsigned col_cnt, unsigned const* cols) const {
+        merge_pending();
+        ensure_loaded();
+        for (key_order* o : m_orders) 
+            if (o->m_cols.size() == col_cnt && std::equal(cols, cols + col_cnt, o->m_cols.begin()))
+                return *o;
+        key_order* o = alloc(key_order);
+        o->m_cols.append(col_cnt, cols);
+        for (unsigned i = 0; i < m_num_rows; ++i) 
+            o->m_rows.push_back(i);
+        std::sort(o->m_rows.begin(), o->m_rows.end(), [&](unsigned a, unsigned b) {
+                table_element const* ra = row(a), *rb = row(b);
+                for (unsigned i = 0; i < col_cnt; ++i) 
+                    if (ra[cols[i]] != rb[cols[i]]) 
+                        return ra[cols[i]] < rb[cols[i]];
+                return a < b;
+            });
+        m_orders.push_back(o);
+        return *o;
+    }
+
+    void sorted_table::add_fact(const table_fact & f) {
+        unsigned idx;
+        if (!find(f.data(), idx)) 
+            m_pending.insert(f);
+    }
+
+    void sorted_table::remove_fact(const table_element* fact) {
+        table_fact f(m_num_cols, fact);
+        if (m_pending.contains(f)) {
+            m_pending.remove(f);
+            return;
+        }
+        unsigned idx;
+        if (!find(fact, idx)) 
+            return;
+        std::copy(m_rows.begin() + (idx + 1) * m_num_cols, m_rows.end(), m_rows.begin() + idx * m_num_cols);
+        m_rows.shrink(m_rows.size() - m_num_cols);
+        --m_num_rows;
+        m_orders.reset();
+    }
+
+    bool sorted_table::contains_fact(const table_fact & f) const {
+        unsigned idx;
+        return find(f.data(), idx) || m_pending.contains(f);
+    }
+
+    void sorted_table::reset() {
+        if (m_spill) 
+            fclose(m_spill);
+        m_spill = nullptr;
+        m_rows.reset();
+        m_num_rows = 0;
+        m_pending.reset();
+        m_orders.reset();
+    }
+
+    table_base * sorted_table::clone() const {
+        merge_pending();
+        ensure_loaded();
+        sorted_table * res = static_cast<sorted_table *>(get_plugin().mk_empty(get_signature()));
+        res->m_rows = m_rows;
+        res->m_num_rows = m_num_rows;
+        return res;
+    }
+
+    class sorted_table_plugin::join_fn : public convenient_table_join_fn {
+    public:
+        join_fn(const table_signature & t1_sig, const table_signature & t2_sig, unsigned col_cnt, const unsigned * cols1, const unsigned * cols2) 
+            : convenient_table_join_fn(t1_sig, t2_sig, col_cnt, cols1, cols2) {}
+
+        table_base * operator()(const table_base & _t1, const table_base & _t2) override {
+            const sorted_table & t1 = static_cast<const sorted_table &>(_t1);
+            const sorted_table & t2 = static_cast<const sorted_table &>(_t2);
+            t1.get_plugin().spill_cold_tables(t1, t2);
+            unsigned col_cnt = m_cols1.size();
+            sorted_table::key_order const& o1 = t1.get_order(col_cnt, m_cols1.data());
+            sorted_table::key_order const& o2 = t2.get_order(col_cnt, m_cols2.data());
+            sorted_table * res = static_cast<sorted_table *>(t1.get_plugin().mk_empty(get_result_signature()));
+
+            auto compare_keys = [&](unsigned i, unsigned j) {
+                table_element const* r1 = t1.row(o1.m_rows[i]);
+                table_element const* r2 = t2.row(o2.m_rows[j]);
+                for (unsigned k = 0; k < col_cnt; ++k) 
+                    if (r1[m_cols1[k]] != r2[m_cols2[k]]) 
+                        return r1[m_cols1[k]] < r2[m_cols2[k]] ? -1 : 1;
+                return 0;
+            };
+
+            unsigned n1 = t1.m_num_rows, n2 = t2.m_num_rows;
+            unsigned i = 0, j = 0;
+            while (i < n1 && j < n2) {
+                int c = compare_keys(i, j);
+                if (c < 0) {
+                    ++i;
+                    continue;
+                }
+                if (c > 0) {
+                    ++j;
+                    continue;
+                }
+                unsigned j_end = j + 1;
+                while (j_end < n2 && compare_keys(i, j_end) == 0) 
+                    ++j_end;
+                unsigned i_end = i + 1;
+                while (i_end < n1 && compare_keys(i_end, j) == 0) 
+                    ++i_end;
+                for (; i < i_end; ++i) {
+                    table_element const* r1 = t1.row(o1.m_rows[i]);
+                    for (unsigned k = j; k < j_end; ++k) {
+                        res->m_rows.append(t1.m_num_cols, r1);
+                        res->m_rows.append(t2.m_num_cols, t2.row(o2.m_rows[k]));
+                        ++res->m_num_rows;
+                    }
+                }
+                j = j_end;
+            }
+            res->sort_rows();
+            return res;
+        }
+    };
+
+    table_join_fn * sorted_table_plugin::mk_join_fn(const table_base & t1, const table_base & t2,
+            unsigned col_cnt, const unsigned * cols1, const unsigned * cols2) {
+        if (t1.get_kind() != get_kind() || t2.get_kind() != get_kind()) 
+            return nullptr;
+        return alloc(join_fn, t1.get_signature(), t2.get_signature(), col_cnt, cols1, cols2);
+    }
+
+    class sorted_table::our_iterator_core : public iterator_core {
+        const sorted_table & m_parent;
+        unsigned m_idx;
+
+        class our_row : public row_interface {
+            const our_iterator_core & m_parent;
+        public:
+            our_row(const our_iterator_core & parent) : row_interface(parent.m_parent), m_parent(parent) {}
+
+            void get_fact(table_fact & result) const override {
+                m_parent.m_parent.ensure_loaded();
+                result.reset();
+                result.append(m_parent.m_parent.m_num_cols, m_parent.m_parent.row(m_parent.m_idx));
+            }
+            table_element operator[](unsigned col) const override {
+                m_parent.m_parent.ensure_loaded();
+                return m_parent.m_parent.row(m_parent.m_idx)[col];
+            }
+        };
+
+        our_row m_row_obj;
+
+    public:
+        our_iterator_core(const sorted_table & t, bool finished) : 
+            m_parent(t), m_idx(finished ? t.m_num_rows : 0), m_row_obj(*this) {}
+
+        bool is_finished() const override {
+            return m_idx == m_parent.m_num_rows;
+        }
+
+        row_interface & operator*() override {
+            SASSERT(!is_finished());
+            return m_row_obj;
+        }
+        void operator++() override {
+            SASSERT(!is_finished());
+            ++m_idx;
+        }
+    };
+
+    table_base::iterator sorted_table::begin() const {
+        merge_pending();
+        return mk_iterator(alloc(our_iterator_core, *this, false));
+    }
+
+    table_base::iterator sorted_table::end() const {
+        merge_pending();
+        return mk_iterator(alloc(our_iterator_core, *this, true));
+    }
+
     // -----------------------------------
     //
     // bitvector_table
@@ -28,6 +28,7 @@ Revision History:
 #include "util/hashtable.h"
 #include "util/map.h"
 #include "util/ref_vector.h"
+#include "util/scoped_ptr_vector.h"
 #include "util/vector.h"
 #include "util/union_find.h"
 #include "muz/rel/dl_base.h"
@@ -102,6 +103,104 @@ namespace datalog {
         bool knows_exact_size() const override { return true; }
     };
 
+    // -----------------------------------
+    //
+    // sorted_table
+    //
+    // -----------------------------------
+
+    class sorted_table;
+
+    class sorted_table_plugin : public table_plugin {
+        friend class sorted_table;
+    protected:
+        class join_fn;
+        ptr_vector<sorted_table> m_tables;
+        unsigned                 m_clock;
+
+        void spill_cold_tables(sorted_table const& t1, sorted_table const& t2);
+    public:
+        typedef sorted_table table;
+
+        sorted_table_plugin(relation_manager & manager) 
+            : table_plugin(symbol("sorted"), manager), m_clock(0) {}
+
+        bool can_handle_signature(const table_signature & s) override { return s.functional_columns() == 0; }
+
+        table_base * mk_empty(const table_signature & s) override;
+
+        table_join_fn * mk_join_fn(const table_base & t1, const table_base & t2,
+            unsigned col_cnt, const unsigned * cols1, const unsigned * cols2) override;
+    };
+
+    /**
+       \brief Table stored as a sorted run of distinct rows and a hash table of
+       rows added since the last merge. The pending rows are merged into the run
+       when the table is traversed or joined.
+
+       Orders of the rows by join keys are kept until the run changes, so joins
+       with the same key columns on an unchanged table are merge joins on the
+       stored order.
+
+       When the runs of all tables exceed datalog.spill_memory, the runs of the
+       least recently used tables are written to temporary files and read back
+       when the table is accessed again.
+    */
+    class sorted_table : public table_base {
+        friend class sorted_table_plugin;
+        friend class sorted_table_plugin::join_fn;
+
+        class our_iterator_core;
+
+        typedef hashtable<table_fact, svector_hash_proc<table_element_hash>, 
+            vector_eq_proc<table_fact> > storage;
+
+        struct key_order {
+            unsigned_vector m_cols;
+            unsigned_vector m_rows;     // row indices ordered by the values of m_cols
+        };
+
+        unsigned                           m_num_cols;
+        mutable unsigned                   m_num_rows;
+        mutable svector<table_element>     m_rows;       // sorted distinct rows, m_num_cols elements per row
+        mutable storage                    m_pending;    // rows not in m_rows
+        mutable scoped_ptr_vector<key_order> m_orders;
+        mutable FILE*                      m_spill;      // holds m_rows when they are not in memory
+        mutable unsigned                   m_last_use;
+
+        sorted_table(sorted_table_plugin & plugin, const table_signature & sig);
+        ~sorted_table() override;
+
+        void ensure_loaded() const;
+        bool spill() const;
+        size_t memory() const { return m_spill ? 0 : m_num_rows * m_num_cols * sizeof(table_element); }
+
+        table_element const* row(unsigned i) const { return m_rows.data() + i * m_num_cols; }
+        int compare(table_element const* r1, table_element const* r2) const;
+        bool find(table_element const* f, unsigned& idx) const;
+        void merge_pending() const;
+        void sort_rows();
+        key_order const& get_order(unsigned col_cnt, unsigned const* cols) const;
+
+    public:
+        sorted_table_plugin & get_plugin() const
+        { return static_cast<sorted_table_plugin &>(table_base::get_plugin()); }
+
+        void add_fact(const table_fact & f) override;
+        void remove_fact(const table_element* fact) override;
+        bool contains_fact(const table_fact & f) const override;
+        void reset() override;
+        table_base * clone() const override;
+        bool empty() const override { return m_num_rows == 0 && m_pending.empty(); }
+
+        iterator begin() const override;
+        iterator end() const override;
+
+        unsigned get_size_estimate_rows() const override { return m_num_rows + m_pending.size(); }
+        unsigned get_size_estimate_bytes() const override { return get_size_estimate_rows() * m_num_cols * 8; }
+        bool knows_exact_size() const override { return true; }
+    };
+
     // -----------------------------------
     //
     // bitvector_table
@@ -42,7 +42,10 @@ namespace datalog {
             relation_plugin(karr_relation_plugin::get_name(), rm),
             m_hb(get_ast_manager().limit()),
             a(get_ast_manager())
-        {}            
+        {
+            // dualization gives up on large systems, the relation is then approximated by top.
+            m_hb.set_max_resolves(100000);
+        }            
         
         bool can_handle_signature(const relation_signature & sig) override {
             return get_manager().get_context().karr();
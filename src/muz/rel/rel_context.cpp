@@ -49,6 +49,7 @@ Revision History:
 #include "muz/transforms/dl_mk_interp_tail_simplifier.h"
 #include "muz/transforms/dl_mk_bit_blast.h"
 #include "muz/transforms/dl_mk_separate_negated_tails.h"
+#include "muz/base/fp_params.hpp"
 #include "ast/ast_util.h"
 
 
@@ -98,7 +99,10 @@ namespace datalog {
           m_answer(m), 
           m_last_result_relation(nullptr),
           m_ectx(ctx),
-          m_sw(0) {
+          m_sw(0),
+          m_inc_rules(ctx.get_rule_manager()),
+          m_inc_query(m),
+          m_inc_query_pred(m) {
 
         // register plugins for builtin tables
 
@@ -106,6 +110,7 @@ namespace datalog {
 
         rm.register_plugin(alloc(sparse_table_plugin, rm));
         rm.register_plugin(alloc(hashtable_table_plugin, rm));
+        rm.register_plugin(alloc(sorted_table_plugin, rm));
         rm.register_plugin(alloc(bitvector_table_plugin, rm));
         rm.register_plugin(lazy_table_plugin::mk_sparse(rm));
 
@@ -119,6 +124,7 @@ namespace datalog {
     }
 
     rel_context::~rel_context() {
+        inc_reset();
         if (m_last_result_relation) {
             m_last_result_relation->deallocate();
             m_last_result_relation = nullptr;
@@ -231,6 +237,7 @@ namespace datalog {
  
     lbool rel_context::query(unsigned num_rels, func_decl * const* rels) {
         setup_default_relation();
+        inc_reset();
         get_rmanager().reset_saturated_marks();
         scoped_query _scoped_query(m_context);
         for (unsigned i = 0; i < num_rels; ++i) {
@@ -332,7 +339,16 @@ namespace datalog {
 
     lbool rel_context::query(expr* query) {
         setup_default_relation();
+        lbool res;
+        if (inc_is_valid(query) && inc_saturate(res)) {
+            return mk_query_answer(m_inc_query_pred, res);
+        }
+        inc_reset();
         get_rmanager().reset_saturated_marks();
+        rule_ref_vector rules(m_context.get_rule_manager());
+        for (rule* r : m_context.get_rules()) {
+            rules.push_back(r);
+        }
         scoped_query _scoped_query(m_context);
         rule_manager& rm = m_context.get_rule_manager();
         func_decl_ref query_pred(m);
@@ -358,11 +374,23 @@ namespace datalog {
             query_pred = m_context.get_rules().get_pred(query_pred);
         }
 
-        lbool res = saturate(_scoped_query);
+        res = saturate(_scoped_query);
         
         query_pred = m_context.get_rules().get_pred(query_pred);
 
+        if (res == l_true && m_context.get_params().datalog_incremental() && 
+            !m_context.generate_explanations()) {
+            inc_record(query, rules, query_pred);
+        }
+
+        return mk_query_answer(query_pred, res);
+    }
+
+    lbool rel_context::mk_query_answer(func_decl* query_pred, lbool res) {
         if (res != l_undef) {            
+            if (m_last_result_relation) {
+                m_last_result_relation->deallocate();
+            }
             m_last_result_relation = get_relation(query_pred).clone();
             if (m_last_result_relation->empty()) {
                 res = l_false;
@@ -381,6 +409,132 @@ namespace datalog {
         return res;
     }
 
+    void rel_context::inc_reset() {
+        for (auto const& kv : m_inc_deltas) {
+            kv.m_value->deallocate();
+        }
+        m_inc_deltas.reset();
+        m_inc_preds.reset();
+        m_inc_xform = nullptr;
+        m_inc_rules.reset();
+        m_inc_query = nullptr;
+        m_inc_query_pred = nullptr;
+    }
+
+    void rel_context::inc_record(expr* query, rule_ref_vector const& rules, func_decl* query_pred) {
+        m_inc_rules.append(rules);
+        m_inc_xform = alloc(rule_set, m_context.get_rules());
+        m_inc_query = query;
+        m_inc_query_pred = query_pred;
+        for (rule* r : *m_inc_xform) {
+            m_inc_preds.insert(r->get_decl());
+            for (unsigned i = 0; i < r->get_uninterpreted_tail_size(); ++i) {
+                m_inc_preds.insert(r->get_decl(i));
+            }
+        }
+        m_inc_preds.insert(query_pred);
+    }
+
+    /**
+       \brief The cached query can be reused if the rules of the context did not change since.
+    */
+    bool rel_context::inc_is_valid(expr* query) {
+        if (!m_inc_xform || m_inc_query != query || !m_context.get_params().datalog_incremental()) {
+            return false;
+        }
+        rule_set const& rules = m_context.get_rules();
+        if (rules.get_num_rules() != m_inc_rules.size()) {
+            return false;
+        }
+        for (unsigned i = 0; i < m_inc_rules.size(); ++i) {
+            if (rules.get_rule(i) != m_inc_rules.get(i)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /**
+       \brief Return the relation that collects the new facts of \c pred, or null if
+       the facts are not covered by the cached query.
+    */
+    relation_base* rel_context::inc_get_delta(func_decl* pred) {
+        if (!m_inc_xform) {
+            return nullptr;
+        }
+        if (!m_inc_preds.contains(pred)) {
+            // the transformations removed the predicate, e.g., since it had no facts.
+            inc_reset();
+            return nullptr;
+        }
+        relation_base* delta = nullptr;
+        if (!m_inc_deltas.find(pred, delta)) {
+            delta = get_rmanager().mk_empty_relation(get_relation(pred).get_signature(), pred);
+            m_inc_deltas.insert(pred, delta);
+        }
+        return delta;
+    }
+
+    /**
+       \brief Add the consequences of the facts added after the cached query to the relations.
+       Return false if they have to be computed from scratch.
+    */
+    bool rel_context::inc_saturate(lbool& result) {
+        relation_manager& rm = get_rmanager();
+        obj_map<func_decl, func_decl*> new_facts;
+        func_decl_ref_vector delta_preds(m);
+        for (auto const& kv : m_inc_deltas) {
+            func_decl* p = kv.m_key;
+            func_decl* d = m.mk_fresh_func_decl(p->get_name(), symbol("delta"), p->get_arity(), 
+                                                p->get_domain(), p->get_range());
+            delta_preds.push_back(d);
+            rm.store_relation(d, kv.m_value);
+            new_facts.insert(p, d);
+        }
+        m_inc_deltas.reset();
+
+        m_ectx.reset();
+        m_code.reset();
+        instruction_block termination_code;
+        bool ok = compiler::compile_incremental(m_context, *m_inc_xform, new_facts, m_code, termination_code);
+        if (ok) {
+            ::stopwatch sw;
+            sw.start();
+            if (m_context.soft_timeout() != 0) {
+                m_ectx.set_timelimit(m_context.soft_timeout());
+            }
+            bool early_termination = !m_code.perform(m_ectx);
+            m_ectx.reset_timelimit();
+            VERIFY(termination_code.perform(m_ectx) || m_context.canceled());
+            m_code.process_all_costs();
+            sw.stop();
+            m_sw += sw.get_seconds();
+
+            if (m_context.canceled()) {
+                result = l_undef;
+            }
+            else if (early_termination) {
+                m_context.set_status(memory::above_high_watermark() ? MEMOUT : TIMEOUT);
+                result = l_undef;
+            }
+            else {
+                m_context.set_status(OK);
+                result = l_true;
+            }
+        }
+
+        func_decl_set preds = rm.collect_predicates();
+        for (func_decl* d : delta_preds) {
+            preds.remove(d);
+        }
+        rm.restrict_predicates(preds);
+        if (ok && result == l_undef) {
+            // the deltas are lost, the next query recomputes the relations.
+            inc_reset();
+        }
+        return ok;
+    }
+
     void rel_context::reset_negated_tables() {
         const rule_set& all_rules = m_context.get_rules();
         rule_set::pred_set_vector const & pred_sets = all_rules.get_strats();
@@ -447,7 +601,15 @@ namespace datalog {
     }
 
     void rel_context::restrict_predicates(func_decl_set const& predicates) {
-        get_rmanager().restrict_predicates(predicates);
+        if (m_inc_preds.empty()) {
+            get_rmanager().restrict_predicates(predicates);
+            return;
+        }
+        func_decl_set preds(predicates);
+        for (func_decl* p : m_inc_preds) {
+            preds.insert(p);
+        }
+        get_rmanager().restrict_predicates(preds);
     }
 
     relation_base & rel_context::get_relation(func_decl * pred)  { return get_rmanager().get_relation(pred); }
@@ -551,7 +713,14 @@ namespace datalog {
  
     void rel_context::add_fact(func_decl* pred, relation_fact const& fact) {
         get_rmanager().reset_saturated_marks();
-        get_relation(pred).add_fact(fact);
+        relation_base & rel = get_relation(pred);
+        if (m_inc_xform && !rel.contains_fact(fact)) {
+            relation_base* delta = inc_get_delta(pred);
+            if (delta) {
+                delta->add_fact(fact);
+            }
+        }
+        rel.add_fact(fact);
         if (!m_context.print_aig().is_null()) {
             m_table_facts.push_back(std::make_pair(pred, fact));
         }
@@ -562,6 +731,13 @@ namespace datalog {
         relation_base & rel0 = get_relation(pred);
         if (rel0.from_table()) {
             table_relation & rel = static_cast<table_relation &>(rel0);
+            if (m_inc_xform && !rel.get_table().contains_fact(fact)) {
+                relation_base* delta = inc_get_delta(pred);
+                if (delta) {
+                    SASSERT(delta->from_table());
+                    static_cast<table_relation *>(delta)->add_table_fact(fact);
+                }
+            }
             rel.add_table_fact(fact);
             // TODO: table facts?
         }
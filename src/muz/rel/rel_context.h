@@ -42,9 +42,25 @@ namespace datalog {
         instruction_block  m_code;
         double             m_sw;
 
+        // state of incremental queries, see datalog.incremental
+        rule_ref_vector    m_inc_rules;       // rules of the context before the cached query
+        scoped_ptr<rule_set> m_inc_xform;     // transformed rules of the cached query
+        expr_ref           m_inc_query;
+        func_decl_ref      m_inc_query_pred;
+        func_decl_set      m_inc_preds;       // predicates of m_inc_xform, their relations are kept
+        obj_map<func_decl, relation_base*> m_inc_deltas; // facts added after the cached query
+
         class scoped_query;
 
         void reset_negated_tables();
+
+        void inc_reset();
+        void inc_record(expr* query, rule_ref_vector const& rules, func_decl* query_pred);
+        bool inc_is_valid(expr* query);
+        relation_base* inc_get_delta(func_decl* pred);
+        bool inc_saturate(lbool& result);
+
+        lbool mk_query_answer(func_decl* query_pred, lbool res);
         
         relation_plugin & get_ordinary_relation_plugin(symbol relation_name);
         
@@ -208,8 +208,28 @@ tbv& tbv_manager::set_or(tbv& dst,  tbv const& src) const {
     return dst;
 }
 bool tbv_manager::set_and(tbv& dst,  tbv const& src) const {
-    m.set_and(dst, src); 
-    return is_well_formed(dst);
+    return set_and(dst, dst, src);
+}
+
+/**
+   \brief dst := a & b, and check that the result has no BIT_z.
+   The conjunction and the check are done in one branch-free pass over the words.
+*/
+bool tbv_manager::set_and(tbv& dst, tbv const& a, tbv const& b) const {
+    unsigned nw = m.num_words();
+    if (nw == 0) 
+        return true;
+    unsigned bad = 0;
+    for (unsigned i = 0; i + 1 < nw; ++i) {
+        unsigned w = a.m_data[i] & b.m_data[i];
+        dst.m_data[i] = w;
+        bad |= ~(w | (w << 1) | 0x55555555);
+    }
+    unsigned w = a.m_data[nw - 1] & b.m_data[nw - 1];
+    dst.m_data[nw - 1] = w;
+    w = m.last_word(dst);
+    bad |= ~(w | (w << 1) | 0x55555555 | ~m.get_mask());
+    return bad == 0;
 }
 
 bool tbv_manager::is_well_formed(tbv const& dst) const {
@@ -270,8 +290,7 @@ bool tbv_manager::contains(tbv const& a, unsigned_vector const& colsa,
 }
 
 bool tbv_manager::intersect(tbv const& a, tbv const& b, tbv& result) {
-    copy(result, a);
-    return set_and(result, b);
+    return set_and(result, a, b);
 }
 
 std::ostream& tbv_manager::display(std::ostream& out, tbv const& b, unsigned hi, unsigned lo) const {
@@ -163,6 +163,14 @@ void pob_queue::set_root(pob& root) {
     reset();
 }
 
+void pob_queue::reset_root(pob& root) {
+    unsigned max_level = m_max_level;
+    unsigned min_depth = m_min_depth;
+    set_root(root);
+    m_max_level = max_level;
+    m_min_depth = min_depth;
+}
+
 void pob_queue::reset() {
     while (!m_data.empty()) {
         pob *p = m_data.top();
@@ -472,6 +480,7 @@ lemma::lemma (ast_manager &manager, expr * body, unsigned lvl) :
     m_zks(m), m_bindings(m),
     m_pob(nullptr), m_ctp(nullptr),
     m_lvl(lvl), m_init_lvl(m_lvl),
+    m_failed_lvl(infty_level()), m_failed_stamp(0),
     m_bumped(0), m_weakness(WEAKNESS_MAX),
     m_external(false), m_blocked(false),
     m_background(false) {
@@ -485,6 +494,7 @@ lemma::lemma(pob_ref const &p) :
     m_zks(m), m_bindings(m),
     m_pob(p), m_ctp(nullptr),
     m_lvl(p->level()), m_init_lvl(m_lvl),
+    m_failed_lvl(infty_level()), m_failed_stamp(0),
     m_bumped(0), m_weakness(p->weakness()),
     m_external(false), m_blocked(false),
     m_background(false) {
@@ -500,6 +510,7 @@ lemma::lemma(pob_ref const &p, expr_ref_vector &cube, unsigned lvl) :
     m_zks(m), m_bindings(m),
     m_pob(p), m_ctp(nullptr),
     m_lvl(p->level()), m_init_lvl(m_lvl),
+    m_failed_lvl(infty_level()), m_failed_stamp(0),
     m_bumped(0), m_weakness(p->weakness()),
     m_external(false), m_blocked(false),
     m_background(false) {
@@ -600,6 +611,7 @@ void lemma::update_cube (pob_ref const &p, expr_ref_vector &cube) {
     SASSERT(m_pob.get() == p.get());
     m_cube.reset();
     m_body.reset();
+    reset_push_failed();
     m_cube.append(cube);
     if (m_cube.empty()) {m_cube.push_back(m.mk_true());}
 
@@ -746,6 +758,7 @@ void pred_transformer::collect_statistics(statistics& st) const
     st.update("SPACER num reach queries", m_stats.m_num_reach_queries);
 
     st.update("SPACER num ctp blocked", m_stats.m_num_ctp_blocked);
+    st.update("SPACER num push failed cached", m_stats.m_num_push_failed_cached);
     st.update("SPACER num is_invariant", m_stats.m_num_is_invariant);
     st.update("SPACER num lemma jumped", m_stats.m_num_lemma_level_jump);
 
@@ -1322,7 +1335,18 @@ bool pred_transformer::is_qblocked (pob &n) {
 void pred_transformer::mbp(app_ref_vector &vars, expr_ref &fml, model &mdl,
                            bool reduce_all_selects, bool force) {
     scoped_watch _t_(m_mbp_watch);
-    qe_project(m, vars, fml, mdl, reduce_all_selects, use_native_mbp(), !force);
+    if (!use_native_mbp()) {
+        qe_project(m, vars, fml, mdl, reduce_all_selects, false, !force);
+        return;
+    }
+    params_ref p;
+    p.set_bool("reduce_all_selects", reduce_all_selects);
+    p.set_bool("dont_sub", !force);
+    if (!m_mbp)
+        m_mbp = alloc(qe::mbproj, m, p);
+    else
+        m_mbp->updt_params(p);
+    m_mbp->spacer(vars, mdl, fml);
 }
 
 //
@@ -1468,6 +1492,15 @@ bool pred_transformer::is_invariant(unsigned level, lemma* lem,
     if (lem->is_blocked()) return false;
 
     m_stats.m_num_is_invariant++;
+
+    // -- the formulas at level are the same as in the last failed
+    // -- attempt, and background invariants are not asserted
+    unsigned stamp = m_solver->get_stamp(level);
+    if (!ctx.use_bg_invs() && lem->is_push_failed(level, stamp)) {
+        m_stats.m_num_push_failed_cached++;
+        return false;
+    }
+
     if (is_ctp_blocked(lem)) {
         m_stats.m_num_ctp_blocked++;
         return false;
@@ -1513,6 +1546,7 @@ bool pred_transformer::is_invariant(unsigned level, lemma* lem,
     else if (r == l_true) {
         // TBD: optionally remove unused symbols from the model
         if (mdl_ref_ptr) {lem->set_ctp(*mdl_ref_ptr);}
+        lem->set_push_failed(level, stamp);
     }
     else {lem->reset_ctp();}
 
@@ -1813,6 +1847,15 @@ void pred_transformer::add_premises(decl2rel const& pts, unsigned lvl,
 void pred_transformer::inherit_lemmas(pred_transformer& other)
 {m_frames.inherit_frames (other.m_frames);}
 
+void pred_transformer::inherit_frames(pred_transformer& other)
+{
+    inherit_lemmas(other);
+    if (other.get_num_levels() > 0) {ensure_level(other.get_num_levels() - 1);}
+}
+
+unsigned pred_transformer::num_assertions() const
+{return m_solver->num_assertions();}
+
 app* pred_transformer::extend_initial (expr *e)
 {
     // create fresh extend literal
@@ -2266,6 +2309,7 @@ context::context(fp_params const& params, ast_manager& m) :
     m(m),
     m_context(nullptr),
     m_pm(m),
+    m_rules(nullptr),
     m_query_pred(m),
     m_query(nullptr),
     m_pob_queue(),
@@ -2345,6 +2389,7 @@ void context::updt_params() {
     m_weak_abs = m_params.spacer_weak_abs();
     m_use_restarts = m_params.spacer_restarts();
     m_restart_initial_threshold = m_params.spacer_restart_initial_threshold();
+    m_gc_assertions = m_params.spacer_gc_assertions();
     m_pdr_bfs = m_params.spacer_gpdr_bfs();
     m_use_bg_invs = m_params.spacer_use_bg_invs();
 
@@ -2436,6 +2481,7 @@ void context::inherit_lemmas(const decl2rel &rels) {
 void context::update_rules(datalog::rule_set& rules)
 {
     decl2rel rels;
+    m_rules = &rules;
     // SMT params must be set before any expression is asserted to any
     // solver
     init_global_smt_params();
@@ -3011,6 +3057,7 @@ lbool context::solve_core (unsigned from_lvl)
     m_pob_queue.set_root (*root);
 
     unsigned max_level = m_max_level;
+    m_gc_base = num_assertions();
 
     for (unsigned i = from_lvl; i < max_level; ++i) {
         checkpoint();
@@ -3033,6 +3080,12 @@ lbool context::solve_core (unsigned from_lvl)
                 m_callbacks[i]->unfold_eh();
         }
 
+        if (m_gc_assertions > 0 && num_assertions() >= m_gc_base + m_gc_assertions &&
+            !m_params.spacer_print_json().is_non_empty_string()) {
+            gc_lemmas();
+            m_gc_base = num_assertions();
+        }
+
         m_pob_queue.inc_level ();
         lvl = m_pob_queue.max_level ();
         m_stats.m_max_depth = std::max(m_stats.m_max_depth, lvl);
@@ -3043,6 +3096,47 @@ lbool context::solve_core (unsigned from_lvl)
     return l_undef;
 }
 
+unsigned context::num_assertions() const {
+    unsigned r = 0;
+    for (auto &kv : m_rels) {r += kv.m_value->num_assertions();}
+    return r;
+}
+
+/**
+   \brief Rebuild the predicate transformers from their live lemmas.
+
+   The solvers of the predicate transformers keep every formula asserted so
+   far, including lemmas that were pushed to a higher level and lemmas that
+   were subsumed. The new predicate transformers only assert the lemmas that
+   remain after simplification. Reach facts and proof obligations other
+   than the root are dropped and recomputed on demand.
+*/
+void context::gc_lemmas() {
+    SASSERT(m_rules);
+    simplify_formulas();
+    pob &old_root = m_pob_queue.get_root();
+    unsigned lvl = old_root.level();
+    unsigned depth = old_root.depth();
+
+    decl2rel rels;
+    init_rules(*m_rules, rels);
+    for (auto &entry : rels) {
+        pred_transformer *pt = nullptr;
+        if (m_rels.find(entry.m_key, pt)) {entry.m_value->inherit_frames(*pt);}
+    }
+    pred_transformer *query = nullptr;
+    VERIFY(rels.find(m_query_pred, query));
+    m_pob_queue.reset_root(*query->mk_pob(nullptr, lvl, depth, m.mk_true()));
+
+    IF_VERBOSE(1, verbose_stream() << "(spacer.gc :assertions " << num_assertions(););
+    for (auto &entry : m_rels) {dealloc(entry.m_value);}
+    m_rels.reset();
+    for (auto &entry : rels) {m_rels.insert(entry.m_key, entry.m_value);}
+    m_query = query;
+    m_stats.m_num_gc++;
+    IF_VERBOSE(1, verbose_stream() << " -> " << num_assertions() << ")\n";);
+}
+
 void context::log_enter_level(unsigned lvl) {
 
     if (m_trace_stream) { *m_trace_stream << "\n* LEVEL " << lvl << "\n\n"; }
@@ -3971,6 +4065,7 @@ void context::collect_statistics(statistics& st) const
     st.update("SPACER num lemmas", m_stats.m_num_lemmas);
     // -- number of restarts taken
     st.update("SPACER restarts", m_stats.m_num_restarts);
+    st.update("SPACER lemma gc", m_stats.m_num_gc);
 
     // -- time to initialize the rules
     st.update ("time.spacer.init_rules", m_init_rules_watch.get_seconds ());
@@ -32,6 +32,7 @@ Notes:
 #include "muz/spacer/spacer_json.h"
 
 #include "muz/base/fp_params.hpp"
+#include "qe/qe_mbp.h"
 
 namespace datalog {
     class rule_set;
@@ -124,6 +125,8 @@ class lemma {
     model_ref m_ctp;           // counter-example to pushing
     unsigned m_lvl;            // current level of the lemma
     unsigned m_init_lvl;       // level at which lemma was created
+    unsigned m_failed_lvl;     // level to which pushing the lemma last failed
+    unsigned m_failed_stamp;   // solver stamp of the failed attempt
     unsigned m_bumped:16;
     unsigned m_weakness:16;
     unsigned m_external:1;    // external lemma from another solver
@@ -145,6 +148,16 @@ public:
     void set_ctp(model_ref &v) {m_ctp = v;}
     void reset_ctp() {m_ctp.reset();}
 
+    /// pushing to lvl is known to fail while the solver has the given stamp
+    bool is_push_failed(unsigned lvl, unsigned stamp) const {
+        return m_failed_lvl == lvl && m_failed_stamp == stamp;
+    }
+    void set_push_failed(unsigned lvl, unsigned stamp) {
+        m_failed_lvl = lvl;
+        m_failed_stamp = stamp;
+    }
+    void reset_push_failed() {m_failed_lvl = infty_level();}
+
     void bump() {m_bumped++;}
     unsigned get_bumped() {return m_bumped;}
 
@@ -209,6 +222,7 @@ class pred_transformer {
         unsigned m_num_propagations; // num of times lemma is pushed higher
         unsigned m_num_invariants; // num of infty lemmas found
         unsigned m_num_ctp_blocked; // num of time ctp blocked lemma pushing
+        unsigned m_num_push_failed_cached; // num of failed pushes known from an earlier attempt
         unsigned m_num_is_invariant; // num of times lemmas are pushed
         unsigned m_num_lemma_level_jump; // lemma learned at higher level than expected
         unsigned m_num_reach_queries;
@@ -407,6 +421,7 @@ class pred_transformer {
     stopwatch                    m_must_reachable_watch;
     stopwatch                    m_ctp_watch;
     stopwatch                    m_mbp_watch;
+    scoped_ptr<qe::mbproj>       m_mbp;             // native mbp, kept to reuse projections
     bool                         m_has_quantified_frame; // True when a quantified lemma is in the frame
 
     void init_sig();
@@ -558,6 +573,9 @@ public:
     void add_premises(decl2rel const& pts, unsigned lvl, expr_ref_vector& r);
 
     void inherit_lemmas(pred_transformer& other);
+    /// inherit the lemmas and the number of frames of other
+    void inherit_frames(pred_transformer& other);
+    unsigned num_assertions() const;
 
     void ground_free_vars(expr* e, app_ref_vector& vars, ptr_vector<app>& aux_vars,
                           bool is_init);
@@ -841,6 +859,8 @@ public:
 
     pob& get_root() const {return *m_root.get ();}
     void set_root(pob& n);
+    /// replace the root, keeping the current level and depth
+    void reset_root(pob& n);
     bool is_root(pob& n) const {return m_root.get () == &n;}
 
     unsigned max_level() const {return m_max_level;}
@@ -913,6 +933,7 @@ class context {
         unsigned m_num_restarts;
         unsigned m_num_lemmas_imported;
         unsigned m_num_lemmas_discarded;
+        unsigned m_num_gc;
         stats() { reset(); }
         void reset() { memset(this, 0, sizeof(*this)); }
     };
@@ -939,6 +960,7 @@ class context {
     random_gen           m_random;
     spacer_children_order m_children_order;
     decl2rel             m_rels;         // Map from relation predicate to fp-operator.
+    datalog::rule_set*   m_rules;        // rules of m_rels
     func_decl_ref        m_query_pred;
     pred_transformer*    m_query;
     mutable pob_queue    m_pob_queue;
@@ -982,6 +1004,8 @@ class context {
     unsigned             m_max_level;
     unsigned             m_restart_initial_threshold;
     unsigned             m_blast_term_ite_inflation;
+    unsigned             m_gc_assertions;
+    unsigned             m_gc_base;      // number of assertions after the last rebuild
     scoped_ptr_vector<spacer_callback> m_callbacks;
     json_marshaller      m_json_marshaller;
     std::fstream*        m_trace_stream;
@@ -1045,6 +1069,8 @@ class context {
     void checkpoint();
 
     void simplify_formulas();
+    unsigned num_assertions() const;
+    void gc_lemmas();
 
     void dump_json();
 
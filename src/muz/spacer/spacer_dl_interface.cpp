@@ -35,6 +35,12 @@ Revision History:
 #include "ast/scoped_proof.h"
 #include "muz/transforms/dl_transforms.h"
 #include "muz/spacer/spacer_callback.h"
+#include "ast/ast_translation.h"
+#include "util/scoped_ptr_vector.h"
+#ifndef SINGLE_THREAD
+#include <mutex>
+#include "util/thread_pool.h"
+#endif
 
 using namespace spacer;
 
@@ -81,6 +87,146 @@ void dl_interface::check_reset()
 }
 
 
+namespace {
+    // worker contexts only hold rules, they never create engines.
+    class null_register_engine : public datalog::register_engine_base {
+    public:
+        datalog::engine_base* mk_engine(datalog::DL_ENGINE engine_type) override { return nullptr; }
+        void set_context(datalog::context* ctx) override {}
+    };
+
+    struct par_worker {
+        scoped_ptr<ast_manager>       m_manager;
+        params_ref                    m_params;
+        smt_params                    m_fparams;
+        null_register_engine          m_register_engine;
+        scoped_ptr<datalog::context>  m_ctx;
+        scoped_ptr<datalog::rule_set> m_rules;
+        scoped_ptr<spacer::context>   m_spacer;
+        lbool                         m_result { l_undef };
+    };
+}
+
+/**
+   \brief Solve the query with num_workers copies of spacer that use
+   different strategies, each in its own manager.
+   The lemmas of the first copy that finishes are added to the main
+   context, which then re-establishes the result: an invariant found by the
+   copy is checked in a single iteration, a counterexample is searched for
+   with the frames of the copy.
+*/
+void dl_interface::solve_par(func_decl* query_pred, unsigned num_workers) {
+#ifndef SINGLE_THREAD
+    ast_manager& m = m_ctx.get_manager();
+    if (m.proofs_enabled())
+        return;
+    unsigned min_level = m_ctx.get_params().spacer_min_level();
+    unsigned seed = m_ctx.get_params().spacer_random_seed();
+    scoped_ptr_vector<par_worker> workers;
+    scoped_limits sl(m.limit());
+    func_decl_ref_vector preds(m);
+    obj_hashtable<func_decl> seen;
+    for (datalog::rule* r : m_spacer_rules) {
+        func_decl* p = r->get_decl();
+        if (!seen.contains(p)) {
+            seen.insert(p);
+            preds.push_back(p);
+        }
+    }
+    try {
+        for (unsigned i = 0; i < num_workers; ++i) {
+            par_worker* w = alloc(par_worker);
+            workers.push_back(w);
+            w->m_manager = alloc(ast_manager, m, true);
+            ast_manager& wm = *w->m_manager;
+            sl.push_child(&wm.limit());
+            w->m_params.copy(m_ctx.get_params().p);
+            w->m_params.set_uint("spacer.random_seed", seed + i);
+            w->m_params.set_uint("spacer.workers", 1);
+            if (i % 2 == 1)
+                w->m_params.set_uint("spacer.order_children", 2);
+            if (i % 4 == 2)
+                w->m_params.set_bool("spacer.q3.use_qgen", true);
+            if (i % 4 == 3)
+                w->m_params.set_bool("spacer.use_euf_gen", true);
+            if (i % 8 >= 4)
+                w->m_params.set_bool("spacer.use_lim_num_gen", true);
+            w->m_ctx = alloc(datalog::context, wm, w->m_register_engine, w->m_fparams, w->m_params);
+            w->m_rules = alloc(datalog::rule_set, *w->m_ctx);
+            datalog::rule_manager& rm = w->m_ctx->get_rule_manager();
+            ast_translation tr(m, wm);
+            app_ref_vector tail(wm);
+            svector<bool> neg;
+            for (datalog::rule* r : m_spacer_rules) {
+                tail.reset();
+                neg.reset();
+                for (unsigned j = 0; j < r->get_tail_size(); ++j) {
+                    tail.push_back(tr(r->get_tail(j)));
+                    neg.push_back(r->is_neg_tail(j));
+                }
+                app_ref head(tr(r->get_head()), wm);
+                w->m_rules->add_rule(rm.mk(head, tail.size(), tail.data(), neg.data(), r->name(), false));
+            }
+            func_decl* q = tr(query_pred);
+            w->m_rules->set_output_predicate(q);
+            w->m_rules->close();
+            w->m_spacer = alloc(spacer::context, w->m_ctx->get_params(), wm);
+            w->m_spacer->set_query(q);
+            w->m_spacer->update_rules(*w->m_rules);
+        }
+    }
+    catch (z3_exception&) {
+        return;
+    }
+
+    std::mutex mux;
+    int winner = -1;
+    thread_pool threads;
+    for (unsigned i = 0; i < num_workers; ++i) {
+        threads.run([&, i]() {
+            par_worker& w = *workers[i];
+            try {
+                w.m_result = w.m_spacer->solve(min_level);
+            }
+            catch (z3_exception&) {
+                w.m_result = l_undef;
+            }
+            if (w.m_result == l_undef)
+                return;
+            std::lock_guard<std::mutex> lock(mux);
+            if (winner != -1)
+                return;
+            winner = i;
+            for (unsigned j = 0; j < num_workers; ++j)
+                if (j != i)
+                    workers[j]->m_manager->limit().cancel();
+        });
+    }
+    threads.join();
+
+    if (winner == -1 || !m.inc())
+        return;
+    par_worker& w = *workers[winner];
+    IF_VERBOSE(1, verbose_stream() << "(spacer.par :worker " << winner << " :result " << w.m_result << ")\n";);
+    ast_translation tr(*w.m_manager, m);
+    ast_translation to_worker(m, *w.m_manager);
+    for (func_decl* p : preds) {
+        func_decl* wp = to_worker(p);
+        if (w.m_result == l_false) {
+            expr_ref inv = w.m_spacer->get_cover_delta(-1, wp, wp);
+            m_context->add_invariant(p, tr(inv.get()));
+            continue;
+        }
+        unsigned num_levels = w.m_spacer->get_num_levels(wp);
+        for (unsigned lvl = 0; lvl < num_levels; ++lvl) {
+            expr_ref lemmas = w.m_spacer->get_cover_delta(lvl, wp, wp);
+            if (!w.m_manager->is_true(lemmas))
+                m_context->add_cover(lvl, p, tr(lemmas.get()));
+        }
+    }
+#endif
+}
+
 lbool dl_interface::query(expr * query)
 {
     //we restore the initial state in the datalog context
@@ -164,6 +310,9 @@ lbool dl_interface::query(expr * query)
         return l_false;
     }
 
+    if (m_ctx.get_params().spacer_workers() > 1)
+        solve_par(query_pred, m_ctx.get_params().spacer_workers());
+
     return m_context->solve(m_ctx.get_params().spacer_min_level());
 
 }
@@ -41,6 +41,7 @@ class dl_interface : public datalog::engine_base {
     ast_ref_vector    m_refs;
 
     void check_reset();
+    void solve_par(func_decl* query_pred, unsigned num_workers);
 
 public:
     dl_interface(datalog::context& ctx);
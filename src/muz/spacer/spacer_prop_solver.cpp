@@ -53,7 +53,9 @@ prop_solver::prop_solver(ast_manager &m,
     m_uses_level(infty_level()),
     m_delta_level(false),
     m_in_level(false),
-    m_use_push_bg(p.spacer_keep_proxy())
+    m_use_push_bg(p.spacer_keep_proxy()),
+    m_clock(0),
+    m_infty_stamp(0)
 {
 
     m_random.set_seed(p.spacer_random_seed());
@@ -122,6 +124,7 @@ void prop_solver::assert_expr(expr * form)
     SASSERT(!m_in_level);
     m_contexts[0]->assert_expr(form);
     m_contexts[1]->assert_expr(form);
+    m_infty_stamp = ++m_clock;
     IF_VERBOSE(21, verbose_stream() << "$ asserted " << mk_pp(form, m) << "\n";);
     TRACE("spacer", tout << "add_formula: " << mk_pp(form, m) << "\n";);
 }
@@ -133,7 +136,19 @@ void prop_solver::assert_expr(expr * form, unsigned level)
     ensure_level(level);
     app * lev_atom = m_pos_level_atoms[level].get();
     app_ref lform(m.mk_or(form, lev_atom), m);
+    unsigned infty_stamp = m_infty_stamp;
     assert_expr(lform);
+    m_infty_stamp = infty_stamp;
+    m_level_stamps.reserve(level + 1, 0);
+    m_level_stamps[level] = m_clock;
+}
+
+unsigned prop_solver::get_stamp(unsigned level) const
+{
+    unsigned stamp = m_infty_stamp;
+    for (unsigned i = level; i < m_level_stamps.size(); ++i)
+        stamp = std::max(stamp, m_level_stamps[i]);
+    return stamp;
 }
 
 
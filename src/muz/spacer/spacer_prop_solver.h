@@ -60,6 +60,12 @@ private:
     bool                m_use_push_bg;
     unsigned            m_current_level;    // set when m_in_level
 
+    /// stamps of the last assertion enabled at exactly a level and at
+    /// all levels. They identify the formulas a query at a level sees.
+    unsigned            m_clock;
+    unsigned            m_infty_stamp;
+    unsigned_vector     m_level_stamps;
+
     random_gen          m_random;
 
     void assert_level_atoms(unsigned level);
@@ -94,6 +100,17 @@ public:
     void assert_expr(expr * form);
     void assert_expr(expr * form, unsigned level);
 
+    /**
+       \brief Return a stamp of the formulas that are enabled at level.
+       The stamp changes whenever a formula that is enabled at level is
+       asserted, so queries at level with the same stamp and assumptions
+       have the same result.
+    */
+    unsigned get_stamp(unsigned level) const;
+
+    /// number of formulas asserted so far
+    unsigned num_assertions() const {return m_clock;}
+
     void assert_exprs(const expr_ref_vector &fmls) {
         for (auto *f : fmls) assert_expr(f);
     }
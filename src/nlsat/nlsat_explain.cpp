@@ -21,6 +21,10 @@ Revision History:
 #include "nlsat/nlsat_evaluator.h"
 #include "math/polynomial/algebraic_numbers.h"
 #include "util/ref_buffer.h"
+#include "util/scoped_ptr_vector.h"
+#ifndef SINGLE_THREAD
+#include <thread>
+#endif
 
 namespace nlsat {
 
@@ -45,6 +49,27 @@ namespace nlsat {
         bool                    m_minimize_cores;
         bool                    m_factor;
         bool                    m_signed_project;
+        unsigned                m_projection_threads;
+
+#ifndef SINGLE_THREAD
+        /**
+           \brief State of a thread computing psc chains.
+           Each thread owns a polynomial manager; polynomials are converted
+           to and from it by the calling thread.
+        */
+        struct psc_worker {
+            reslimit                                m_limit;
+            unsynch_mpz_manager                     m_nm;
+            pmanager                                m_pm;
+            polynomial_ref_vector                   m_ps;
+            polynomial_ref_vector                   m_qs;
+            scoped_ptr_vector<polynomial_ref_vector> m_chains;
+            unsigned_vector                         m_pairs;
+            bool                                    m_failed;
+            psc_worker(): m_pm(m_limit, m_nm), m_ps(m_pm), m_qs(m_pm), m_failed(false) {}
+        };
+        scoped_ptr_vector<psc_worker> m_workers;
+#endif
 
         struct todo_set {
             polynomial::cache  &    m_cache;
@@ -152,6 +177,7 @@ namespace nlsat {
             m_full_dimensional = false;
             m_minimize_cores   = false;
             m_signed_project   = false;
+            m_projection_threads = 1;
         }
         
         ~imp() {
@@ -632,9 +658,15 @@ namespace nlsat {
         */
         void psc(polynomial_ref & p, polynomial_ref & q, var x) {
             polynomial_ref_vector & S = m_psc_tmp;
-            polynomial_ref s(m_pm);
-
             psc_chain(p, q, x, S);
+            add_psc(p, q, S);
+        }
+
+        /**
+           \brief Add v-psc(p, q, x) into m_todo, where S is the psc chain of p and q.
+        */
+        void add_psc(polynomial_ref const & p, polynomial_ref const & q, polynomial_ref_vector const & S) {
+            polynomial_ref s(m_pm);
             unsigned sz = S.size();
             TRACE("nlsat_explain", tout << "computing psc of\n"; display(tout, p); tout << "\n"; display(tout, q); tout << "\n";
                   for (unsigned i = 0; i < sz; ++i) {
@@ -684,6 +716,18 @@ namespace nlsat {
             polynomial_ref p(m_pm);
             polynomial_ref p_prime(m_pm);
             unsigned sz = ps.size();
+            if (m_projection_threads > 1) {
+                polynomial_ref_vector as(m_pm), bs(m_pm);
+                for (unsigned i = 0; i < sz; i++) {
+                    p = ps.get(i);
+                    if (degree(p, x) < 2)
+                        continue;
+                    as.push_back(p);
+                    bs.push_back(derivative(p, x));
+                }
+                psc_pairs(as, bs, x);
+                return;
+            }
             for (unsigned i = 0; i < sz; i++) {
                 p = ps.get(i);
                 if (degree(p, x) < 2)
@@ -705,6 +749,17 @@ namespace nlsat {
             polynomial_ref p(m_pm);
             polynomial_ref q(m_pm);
             unsigned sz = ps.size();
+            if (m_projection_threads > 1) {
+                polynomial_ref_vector as(m_pm), bs(m_pm);
+                for (unsigned i = 0; i + 1 < sz; i++) {
+                    for (unsigned j = i + 1; j < sz; j++) {
+                        as.push_back(ps.get(i));
+                        bs.push_back(ps.get(j));
+                    }
+                }
+                psc_pairs(as, bs, x);
+                return;
+            }
             for (unsigned i = 0; i < sz - 1; i++) {
                 p = ps.get(i);
                 for (unsigned j = i + 1; j < sz; j++) {
@@ -714,6 +769,101 @@ namespace nlsat {
             }
         }
 
+        /**
+           \brief Add v-psc(x, as[i], bs[i]) into m_todo for every i.
+           The psc chains are computed first, possibly in parallel.
+        */
+        void psc_pairs(polynomial_ref_vector const & as, polynomial_ref_vector const & bs, var x) {
+            scoped_ptr_vector<polynomial_ref_vector> chains;
+            psc_chains(as, bs, x, chains);
+            polynomial_ref p(m_pm), q(m_pm);
+            for (unsigned i = 0; i < as.size(); i++) {
+                p = as.get(i);
+                q = bs.get(i);
+                add_psc(p, q, *chains[i]);
+            }
+        }
+
+        void psc_chains(polynomial_ref_vector const & as, polynomial_ref_vector const & bs, var x, scoped_ptr_vector<polynomial_ref_vector> & chains) {
+            unsigned n = as.size();
+            for (unsigned i = 0; i < n; i++)
+                chains.push_back(alloc(polynomial_ref_vector, m_pm));
+#ifndef SINGLE_THREAD
+            unsigned num_threads = std::min(m_projection_threads, n);
+            if (num_threads > 1) {
+                psc_chains_parallel(as, bs, x, num_threads, chains);
+                return;
+            }
+#endif
+            polynomial_ref p(m_pm), q(m_pm);
+            for (unsigned i = 0; i < n; i++) {
+                p = as.get(i);
+                q = bs.get(i);
+                psc_chain(p, q, x, *chains[i]);
+            }
+        }
+
+#ifndef SINGLE_THREAD
+        void psc_chains_parallel(polynomial_ref_vector const & as, polynomial_ref_vector const & bs, var x,
+                                 unsigned num_threads, scoped_ptr_vector<polynomial_ref_vector> & chains) {
+            while (m_workers.size() < num_threads)
+                m_workers.push_back(alloc(psc_worker));
+            for (unsigned i = 0; i < as.size(); i++) {
+                psc_worker & w = *m_workers[i % num_threads];
+                w.m_pairs.push_back(i);
+                w.m_ps.push_back(convert(m_pm, as.get(i), w.m_pm));
+                w.m_qs.push_back(convert(m_pm, bs.get(i), w.m_pm));
+            }
+
+            {
+                scoped_limits sl(m_pm.limit());
+                for (unsigned k = 0; k < num_threads; k++) {
+                    m_workers[k]->m_limit.reset_cancel();
+                    sl.push_child(&m_workers[k]->m_limit);
+                }
+                auto worker_thread = [&](psc_worker & w) {
+                    try {
+                        for (unsigned i = 0; i < w.m_pairs.size(); i++) {
+                            w.m_chains.push_back(alloc(polynomial_ref_vector, w.m_pm));
+                            w.m_pm.psc_chain(w.m_ps.get(i), w.m_qs.get(i), x, *w.m_chains.back());
+                        }
+                    }
+                    catch (z3_exception &) {
+                        w.m_failed = true;
+                    }
+                };
+                vector<std::thread> threads;
+                for (unsigned k = 0; k < num_threads; k++)
+                    threads.push_back(std::thread([&, k]() { worker_thread(*m_workers[k]); }));
+                for (auto & th : threads)
+                    th.join();
+            }
+
+            polynomial_ref p(m_pm), q(m_pm);
+            for (unsigned k = 0; k < num_threads; k++) {
+                psc_worker & w = *m_workers[k];
+                for (unsigned i = 0; i < w.m_pairs.size(); i++) {
+                    polynomial_ref_vector & S = *chains[w.m_pairs[i]];
+                    if (w.m_failed || i >= w.m_chains.size()) {
+                        // recompute the chains the thread did not finish
+                        p = as.get(w.m_pairs[i]);
+                        q = bs.get(w.m_pairs[i]);
+                        S.reset();
+                        psc_chain(p, q, x, S);
+                        continue;
+                    }
+                    for (poly * s : *w.m_chains[i])
+                        S.push_back(convert(w.m_pm, s, m_pm));
+                }
+                w.m_chains.reset();
+                w.m_ps.reset();
+                w.m_qs.reset();
+                w.m_pairs.reset();
+                w.m_failed = false;
+            }
+        }
+#endif
+
         void test_root_literal(atom::kind k, var y, unsigned i, poly * p, scoped_literal_vector& result) {
             m_result = &result;
             add_root_literal(k, y, i, p);
@@ -1860,6 +2010,10 @@ namespace nlsat {
         m_imp->m_factor = f;
     }
 
+    void explain::set_projection_threads(unsigned n) {
+        m_imp->m_projection_threads = std::max(1u, n);
+    }
+
     void explain::set_signed_project(bool f) {
         m_imp->m_signed_project = f;
     }
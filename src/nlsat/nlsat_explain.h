@@ -43,6 +43,7 @@ namespace nlsat {
         void set_minimize_cores(bool f);
         void set_factor(bool f);
         void set_signed_project(bool f);
+        void set_projection_threads(unsigned n);
 
         /**
            \brief Given a set of literals ls[0], ... ls[n-1] s.t.
@@ -276,6 +276,7 @@ namespace nlsat {
             m_explain.set_simplify_cores(m_simplify_cores);
             m_explain.set_minimize_cores(min_cores);
             m_explain.set_factor(p.factor());
+            m_explain.set_projection_threads(p.projection_threads());
             m_am.updt_params(p.p);
         }
 
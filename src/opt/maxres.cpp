@@ -50,6 +50,20 @@ Author:
 
 Notes:
 
+    With maxres.stratify, the soft constraints are solved in strata of
+    decreasing weight. The next stratum is extended by lower weights
+    until the soft constraints of the stratum outnumber its distinct
+    weights, such that instances with many distinct weights are not
+    split into many small strata. Soft constraints whose weight exceeds
+    the gap between the upper and lower bound are hardened.
+
+    With maxres.anytime_workers, LNS and SLS workers search for better
+    solutions on copies of the solver. Their models improve the upper
+    bound, which is also used for hardening.
+
+    With maxres.core_threads, further disjoint cores are extracted in
+    parallel on copies of the solver after the first core of a round.
+
 --*/
 
 #include "ast/ast_pp.h"
@@ -58,11 +72,15 @@ Notes:
 #include "model/model_smt2_pp.h"
 #include "solver/solver.h"
 #include "solver/mus.h"
+#include "util/thread_pool.h"
+#include "util/sorting_network.h"
+#include "ast/ast_translation.h"
 #include "sat/sat_solver/inc_sat_solver.h"
 #include "smt/smt_solver.h"
 #include "opt/opt_context.h"
 #include "opt/opt_params.hpp"
 #include "opt/opt_lns.h"
+#include "opt/opt_portfolio.h"
 #include "opt/maxsmt.h"
 #include "opt/maxres.h"
 
@@ -78,6 +96,7 @@ private:
     struct stats {
         unsigned m_num_cores;
         unsigned m_num_cs;
+        unsigned m_num_hardened;
         stats() { reset(); }
         void reset() {
             memset(this, 0, sizeof(*this));
@@ -95,6 +114,32 @@ private:
         expr_ref_vector const& soft() override { return i.m_asms; }
     };
 
+    /**
+       \brief Cardinality network over the falsified soft constraints.
+       Its outputs are created for the first upper bound and tighter 
+       bounds are enforced by asserting negated outputs.
+    */
+    struct bound_nw {
+        typedef expr* pliteral;
+        typedef ptr_vector<expr> pliteral_vector;
+        maxres&            mr;
+        ast_manager&       m;
+        expr_ref_vector    m_trail;
+        psort_nw<bound_nw> m_sort;
+        ptr_vector<expr>   m_out;
+        bound_nw(maxres& mr): mr(mr), m(mr.m), m_trail(mr.m), m_sort(*this) {}
+
+        pliteral mk_false() { return m.mk_false(); }
+        pliteral mk_true() { return m.mk_true(); }
+        pliteral mk_max(unsigned n, pliteral const* as) { return trail(m.mk_or(n, as)); }
+        pliteral mk_min(unsigned n, pliteral const* as) { return trail(m.mk_and(n, as)); }
+        pliteral mk_not(pliteral a) { if (m.is_not(a, a)) return a; return trail(m.mk_not(a)); }
+        std::ostream& pp(std::ostream& out, pliteral lit) { return out << mk_pp(lit, m); }
+        pliteral trail(pliteral l) { m_trail.push_back(l); return l; }
+        pliteral fresh(char const* n) { return trail(mr.mk_fresh_bool(n)); }
+        void mk_clause(unsigned n, pliteral const* lits) { mr.add(mk_or(m, n, lits)); }
+    };
+
     unsigned         m_index;
     stats            m_stats;
     expr_ref_vector  m_B;
@@ -124,6 +169,12 @@ private:
     bool             m_dump_benchmarks;        // display benchmarks (into wcnf format)
     bool             m_enable_lns { false };   // enable LNS improvements
     unsigned         m_lns_conflicts { 1000 }; // number of conflicts used for LNS improvement
+    bool             m_stratify { false };     // solve soft constraints by decreasing weight
+    rational         m_stratum;                // minimal weight of the current stratum
+    unsigned         m_core_threads { 1 };     // number of threads for extracting disjoint cores
+    scoped_ptr<bound_nw> m_bound_nw;           // network for blocking upper bounds of unweighted soft constraints
+    unsigned         m_anytime_workers { 0 };  // number of LNS and SLS workers
+    scoped_ptr<anytime_portfolio> m_anytime;
     
     std::string      m_trace_id;
     typedef ptr_vector<expr> exprs;
@@ -220,16 +271,29 @@ public:
         trace();
         improve_model();
         if (is_sat != l_true) return is_sat;
+        m_stratum.reset();
+        if (m_stratify) {
+            for (expr* a : m_asms) {
+                m_stratum = std::max(m_stratum, get_weight(a) + 1);
+            }
+            lower_stratum();
+        }
+        start_anytime();
         while (m_lower < m_upper) {
             TRACE("opt_verbose", 
                   s().display(tout << m_asms << "\n") << "\n";
                   display(tout););
-            is_sat = check_sat_hill_climb(m_asms);
+            import_anytime();
+            harden();
+            is_sat = check_sat_stratified();
             if (!m.inc()) {
                 return l_undef;
             }
             switch (is_sat) {
             case l_true: 
+                if (lower_stratum()) {
+                    break;
+                }
                 CTRACE("opt", m_model->is_false(m_asms), 
                        tout << *m_model << "assumptions: ";
                        for (expr* a : m_asms) tout << mk_pp(a, m) << " -> " << (*m_model)(a) << " ";
@@ -327,6 +391,88 @@ public:
         return is_sat;
     }
 
+    /**
+       \brief Check the assumptions of the current stratum.
+    */
+    lbool check_sat_stratified() {
+        if (m_stratum.is_zero()) {
+            return check_sat_hill_climb(m_asms);
+        }
+        expr_ref_vector asms(m);
+        get_stratum(asms);
+        return check_sat_hill_climb(asms);
+    }
+
+    void get_stratum(expr_ref_vector& asms) {
+        for (expr* a : m_asms) {
+            if (get_weight(a) >= m_stratum) {
+                asms.push_back(a);
+            }
+        }
+    }
+
+    /**
+       \brief Include the assumptions of the next weight level, if any.
+       Weight levels are added to the stratum until the number of assumptions 
+       in the stratum exceeds the number of distinct weights of the stratum
+       by a ratio of 5/4.
+    */
+    bool lower_stratum() {
+        if (!m_stratify || m_stratum.is_zero()) {
+            return false;
+        }
+        vector<rational> weights;
+        for (expr* a : m_asms) {
+            weights.push_back(get_weight(a));
+        }
+        std::sort(weights.begin(), weights.end(), [](rational const& a, rational const& b) { return a > b; });
+        unsigned i = 0, num_asms = 0, num_weights = 0;
+        for (; i < weights.size() && weights[i] >= m_stratum; ++num_weights) {
+            rational w = weights[i];
+            for (; i < weights.size() && weights[i] == w; ++i, ++num_asms);
+        }
+        if (i == weights.size()) {
+            return false;
+        }
+        while (i < weights.size()) {
+            rational w = weights[i];
+            for (; i < weights.size() && weights[i] == w; ++i, ++num_asms);
+            ++num_weights;
+            m_stratum = w;
+            if (4 * num_asms > 5 * num_weights) {
+                break;
+            }
+        }
+        if (i == weights.size()) {
+            // the last stratum includes all assumptions
+            m_stratum.reset();
+        }
+        IF_VERBOSE(2, verbose_stream() << "(opt.maxres stratum " << m_stratum << " assumptions: " << num_asms << ")\n";);
+        return true;
+    }
+
+    /**
+       \brief Assert assumptions whose weight exceeds the gap between the bounds.
+       Falsifying such an assumption costs more than the current best assignment.
+    */
+    void harden() {
+        if ((!m_stratify && !m_anytime) || !m_model || m_c.num_objectives() > 1) {
+            return;
+        }
+        rational gap = m_upper - m_lower;
+        unsigned j = 0;
+        for (expr* a : m_asms) {
+            if (get_weight(a) > gap) {
+                add(a);
+                ++m_stats.m_num_hardened;
+            }
+            else {
+                m_asms[j++] = a;
+            }
+        }
+        m_asms.shrink(j);
+    }
+
     lbool check_sat(unsigned sz, expr* const* asms) {
         lbool r = s().check_sat(sz, asms);        
         if (r == l_true) {
@@ -357,18 +503,54 @@ public:
 
     lbool operator()() override {
         m_defs.reset();
+        lbool r = l_undef;
         switch(m_st) {
         case s_primal:
-            return mus_solver();
+            r = mus_solver();
+            stop_anytime();
+            break;
         case s_primal_dual:
-            return primal_dual_solver();
+            r = primal_dual_solver();
+            break;
         }
-        return l_undef;
+        return r;
+    }
+
+    void start_anytime() {
+        if (m_anytime_workers == 0 || m_soft.empty()) 
+            return;
+        expr_ref_vector fmls(m);
+        vector<rational> weights;
+        for (auto const& sf : m_soft) {
+            fmls.push_back(sf.s);
+            weights.push_back(sf.weight);
+        }
+        m_anytime = alloc(anytime_portfolio, m);
+        m_anytime->start(s(), fmls, weights, m_anytime_workers, m_upper);
+    }
+
+    void import_anytime() {
+        model_ref mdl;
+        if (m_anytime && m_anytime->get_model(mdl)) {
+            IF_VERBOSE(2, verbose_stream() << "(opt.maxres anytime model " << cost(*mdl) << ")\n";);
+            update_assignment(mdl);
+        }
+    }
+
+    void stop_anytime() {
+        if (!m_anytime) 
+            return;
+        m_anytime->stop();
+        // a model from the workers still improves an incomplete search.
+        if (m_lower < m_upper) 
+            import_anytime();
+        m_anytime = nullptr;
     }
 
     void collect_statistics(statistics& st) const override {
         st.update("maxres-cores", m_stats.m_num_cores);
         st.update("maxres-correction-sets", m_stats.m_num_cs);
+        st.update("maxres-hardened", m_stats.m_num_hardened);
     }
 
     struct weighted_core {
@@ -418,7 +600,14 @@ public:
             if (core.size()  >= m_max_core_size) break;
             if (cores.size() >= m_max_num_cores) break;
 
-            is_sat = check_sat_hill_climb(m_asms);            
+            if (m_core_threads > 1 && cores.size() == 1) {
+                is_sat = get_cores_par(cores);
+                if (is_sat != l_true) break;
+                if (cores.empty()) return l_true;
+                if (cores.size() >= m_max_num_cores) break;
+            }
+
+            is_sat = check_sat_stratified();
         }
 
         TRACE("opt", 
@@ -429,6 +618,106 @@ public:
         return is_sat;
     }
 
+    /**
+       \brief Extract disjoint cores of the current stratum in parallel.
+       The assumptions are distributed over copies of the solver, 
+       so the cores found by different copies are disjoint.
+    */
+    lbool get_cores_par(vector<weighted_core>& cores) {
+#ifdef SINGLE_THREAD
+        return l_true;
+#else
+        expr_ref_vector asms(m);
+        get_stratum(asms);
+        sort_assumptions(asms);
+        unsigned n = std::min(m_core_threads, asms.size());
+        if (n < 2) {
+            return l_true;
+        }
+        scoped_ptr_vector<ast_manager> managers;
+        sref_vector<solver> solvers;
+        try {
+            for (unsigned j = 0; j < n; ++j) {
+                managers.push_back(alloc(ast_manager, m, true));
+                solvers.push_back(s().translate(*managers.back(), m_params));
+            }
+        }
+        catch (z3_exception&) {
+            // the solver cannot be copied in its current state.
+            return l_true;
+        }
+        scoped_limits sl(m.limit());
+        for (ast_manager* wm : managers)
+            sl.push_child(&(wm->limit()));
+
+        vector<expr_ref_vector> wasms, wcores;
+        for (unsigned j = 0; j < n; ++j) {
+            ast_translation tr(m, *managers[j]);
+            wasms.push_back(expr_ref_vector(*managers[j]));
+            wcores.push_back(expr_ref_vector(*managers[j]));
+            for (unsigned i = j; i < asms.size(); i += n)
+                wasms[j].push_back(tr(asms.get(i)));
+        }
+        bool minimize = !m_c.sat_enabled();
+        svector<lbool> results(n, l_undef);
+        thread_pool threads;
+        for (unsigned j = 0; j < n; ++j) {
+            threads.run([&, j]() {
+                try {
+                    results[j] = solvers[j]->check_sat(wasms[j]);
+                    if (results[j] != l_false) 
+                        return;
+                    solvers[j]->get_unsat_core(wcores[j]);
+                    if (minimize && !wcores[j].empty()) {
+                        mus wmus(*solvers[j]);
+                        expr_ref_vector core(*managers[j]);
+                        wmus.add_soft(wcores[j].size(), wcores[j].data());
+                        results[j] = wmus.get_mus(core) == l_true ? l_false : l_undef;
+                        wcores[j].reset();
+                        wcores[j].append(core);
+                    }
+                }
+                catch (z3_exception&) {
+                    results[j] = l_undef;
+                }
+            });
+        }
+        threads.join();
+        if (!m.inc()) {
+            return l_undef;
+        }
+
+        for (unsigned j = 0; j < n; ++j) {
+            ast_translation tr(*managers[j], m);
+            if (results[j] == l_true) {
+                model_ref mdl;
+                solvers[j]->get_model(mdl);
+                if (mdl) {
+                    model_ref mdl1 = mdl->translate(tr);
+                    update_assignment(mdl1);
+                }
+                continue;
+            }
+            if (results[j] != l_false) 
+                continue;
+            exprs core;
+            for (expr* c : wcores[j]) 
+                core.push_back(tr(c));
+            ++m_stats.m_num_cores;
+            if (core.empty()) {
+                cores.reset();
+                m_lower = m_upper;
+                return l_true;
+            }
+            IF_VERBOSE(10, display_vec(verbose_stream() << "parallel core: ", core););
+            cores.push_back(weighted_core(core, core_weight(core)));
+            remove_soft(core, m_asms);
+            split_core(core);
+        }
+        return l_true;
+#endif
+    }
+
     void get_current_correction_set(exprs& cs) {
         model_ref mdl;
         s().get_model(mdl);
@@ -826,6 +1115,8 @@ public:
         verify_assignment();
 
         m_upper = upper;
+        if (m_anytime) 
+            m_anytime->set_upper(upper);
         
         trace();
 
@@ -834,6 +1125,7 @@ public:
 
     void add_upper_bound_block() {
         if (!m_add_upper_bound_block) return;
+        if (add_upper_bound_block_nw()) return;
         pb_util u(m);
         expr_ref_vector nsoft(m);
         vector<rational> weights;
@@ -847,6 +1139,38 @@ public:
         add(fml); 
     }
 
+    /**
+       \brief Block the upper bound using the outputs of a cardinality network
+       if all soft constraints have the same weight. The network is reused
+       for every improved upper bound.
+    */
+    bool add_upper_bound_block_nw() {
+        if (m_soft.empty()) return false;
+        rational w = m_soft[0].weight;
+        for (soft& s : m_soft) 
+            if (s.weight != w) 
+                return false;
+        // an improvement falsifies at most k soft constraints
+        rational k = ceil(m_upper / w) - rational::one();
+        if (k.is_neg()) {
+            add(m.mk_false());
+            return true;
+        }
+        if (k >= rational(m_soft.size())) 
+            return true;
+        unsigned bound = k.get_unsigned();
+        if (!m_bound_nw) {
+            m_bound_nw = alloc(bound_nw, *this);
+            ptr_vector<expr> nsoft;
+            for (soft& s : m_soft) 
+                nsoft.push_back(m_bound_nw->mk_not(s.s));
+            m_bound_nw->m_sort.at_most_outputs(bound + 1, nsoft.size(), nsoft.data(), m_bound_nw->m_out);
+        }
+        if (bound < m_bound_nw->m_out.size()) 
+            add(mk_not(m, m_bound_nw->m_out[bound]));
+        return true;
+    }
+
     void remove_soft(exprs const& core, expr_ref_vector& asms) {
         TRACE("opt", tout << "before remove: " << asms << "\n";);
         unsigned j = 0;
@@ -868,15 +1192,20 @@ public:
         m_max_correction_set_size = p.maxres_max_correction_set_size();
         m_pivot_on_cs =             p.maxres_pivot_on_correction_set();
         m_wmax =                    p.maxres_wmax();
+        m_mus.set_num_threads(p.maxres_mus_threads());
         m_dump_benchmarks =         p.dump_benchmarks();
         m_enable_lns =              p.enable_lns(); 
         m_lns_conflicts =           p.lns_conflicts();
+        m_stratify =                p.maxres_stratify();
+        m_core_threads =            std::max(1u, p.maxres_core_threads());
+        m_anytime_workers =         p.maxres_anytime_workers();
 	if (m_c.num_objectives() > 1)
 	  m_add_upper_bound_block = false;
     }
 
     lbool init_local() {
         m_lower.reset();
+        m_bound_nw = nullptr;
         m_trail.reset();
         lbool is_sat = l_true;
         obj_map<expr, rational> new_soft;
@@ -620,7 +620,11 @@ namespace opt {
 
     lbool context::execute_pareto() {        
         if (!m_pareto) {
-            set_pareto(alloc(gia_pareto, m, *this, m_solver.get(), m_params));
+            unsigned num_threads = opt_params(m_params).pareto_threads();
+            if (num_threads > 1)
+                set_pareto(alloc(par_pareto, m, *this, m_solver.get(), m_params, num_threads));
+            else
+                set_pareto(alloc(gia_pareto, m, *this, m_solver.get(), m_params));
         }
         lbool is_sat = (*(m_pareto.get()))();
         if (is_sat != l_true) {
@@ -21,7 +21,9 @@ Notes:
 #include "opt/opt_pareto.h"
 #include "ast/ast_pp.h"
 #include "ast/ast_util.h"
+#include "ast/ast_translation.h"
 #include "model/model_smt2_pp.h"
+#include "util/thread_pool.h"
 
 namespace opt {
 
@@ -64,31 +66,39 @@ namespace opt {
     }
 
     void pareto_base::mk_dominates() {
+        m_solver->assert_expr(mk_dominates(m_model));
+    }
+
+    void pareto_base::mk_not_dominated_by() {
+        m_solver->assert_expr(mk_not_dominated_by(m_model));
+    }
+
+    expr_ref pareto_base::mk_dominates(model_ref& mdl) {
         unsigned sz = cb.num_objectives();
         expr_ref fml(m);
         expr_ref_vector gt(m), fmls(m);
         for (unsigned i = 0; i < sz; ++i) {
-            fmls.push_back(cb.mk_ge(i, m_model));
-            gt.push_back(cb.mk_gt(i, m_model));
+            fmls.push_back(cb.mk_ge(i, mdl));
+            gt.push_back(cb.mk_gt(i, mdl));
         }
         fmls.push_back(mk_or(gt));
         fml = mk_and(fmls);
         IF_VERBOSE(10, verbose_stream() << "dominates: " << fml << "\n";);
-        TRACE("opt", model_smt2_pp(tout << fml << "\n", m, *m_model, 0););
-        m_solver->assert_expr(fml);        
+        TRACE("opt", model_smt2_pp(tout << fml << "\n", m, *mdl, 0););
+        return fml;
     }
 
-    void pareto_base::mk_not_dominated_by() {
+    expr_ref pareto_base::mk_not_dominated_by(model_ref& mdl) {
         unsigned sz = cb.num_objectives();
         expr_ref fml(m);
         expr_ref_vector le(m);
         for (unsigned i = 0; i < sz; ++i) {
-            le.push_back(cb.mk_le(i, m_model));
+            le.push_back(cb.mk_le(i, mdl));
         }
         fml = m.mk_not(mk_and(le));
         IF_VERBOSE(10, verbose_stream() << "not dominated by: " << fml << "\n";);
         TRACE("opt", tout << fml << "\n";);
-        m_solver->assert_expr(fml);        
+        return fml;
     }
 
     // ---------------------------------
@@ -109,5 +119,191 @@ namespace opt {
         return is_sat;
     }
 
-}
+    // ---------------------------------
+    // GIA on boxes of the objective space
+
+    lbool par_pareto::operator()() {
+        if (m_points.empty() && !m_done) {
+            if (!m_model || !init_solvers())
+                return gia_pareto::operator()();
+            unsigned sz = cb.num_objectives();
+            expr_ref_vector boxes(m), fmls(m);
+            for (unsigned i = 0; i < sz; ++i) {
+                fmls.reset();
+                fmls.push_back(cb.mk_gt(i, m_model));
+                for (unsigned j = 0; j < i; ++j)
+                    fmls.push_back(cb.mk_le(j, m_model));
+                boxes.push_back(mk_and(fmls));
+            }
+            vector<std::pair<model_ref, svector<symbol>>> found;
+            for (unsigned lo = 0; lo < sz; lo += m_solvers.size()) {
+                lbool is_sat = search(boxes, lo, std::min(sz, lo + m_solvers.size()), found);
+                if (is_sat == l_undef)
+                    return l_undef;
+            }
+            for (auto& p : found) {
+                bool is_new = true;
+                for (auto& q : m_points)
+                    is_new &= !is_same(p.first, q.first);
+                if (is_new) {
+                    exclude(p.first);
+                    m_points.push_back(p);
+                }
+            }
+            m_done = m_points.empty();
+        }
+        if (m_done)
+            return l_false;
+        m_model = m_points.back().first;
+        m_labels = m_points.back().second;
+        m_points.pop_back();
+        return l_true;
+    }
+
+    /**
+       \brief Copy the solver once the first Pareto point is excluded.
+       Returns false if the solver cannot be copied, in which case the
+       search continues sequentially.
+    */
+    bool par_pareto::init_solvers() {
+#ifdef SINGLE_THREAD
+        return false;
+#else
+        if (m_num_threads <= 1)
+            return false;
+        if (!m_solvers.empty())
+            return true;
+        unsigned n = std::min(m_num_threads, cb.num_objectives());
+        try {
+            for (unsigned i = 0; i < n; ++i) {
+                ast_manager* wm = alloc(ast_manager, m, true);
+                m_managers.push_back(wm);
+                m_solvers.push_back(m_solver->translate(*wm, m_params));
+            }
+        }
+        catch (z3_exception&) {
+            m_solvers.reset();
+            m_managers.reset();
+            m_num_threads = 1;
+            return false;
+        }
+        return true;
+#endif
+    }
+
+    /**
+       \brief Run GIA for the boxes lo .. hi-1 on the solver copies.
+       The copies run check-sat in rounds. The dominance constraints of the
+       models they find are created between rounds by the callback and
+       translated to the copies.
+    */
+    lbool par_pareto::search(expr_ref_vector const& boxes, unsigned lo, unsigned hi, vector<std::pair<model_ref, svector<symbol>>>& found) {
+#ifdef SINGLE_THREAD
+        return l_undef;
+#else
+        enum phase { in_box, global, finished };
+        unsigned n = hi - lo;
+        svector<phase> phases;
+        svector<lbool> results;
+        vector<model_ref> wmodels, models;
+        vector<svector<symbol>> labels;
+        for (unsigned j = 0; j < n; ++j) {
+            ast_translation tr(m, *m_managers[j]);
+            m_solvers[j]->push();
+            m_solvers[j]->assert_expr(tr(boxes.get(lo + j)));
+            phases.push_back(in_box);
+            results.push_back(l_undef);
+            wmodels.push_back(model_ref());
+            models.push_back(model_ref());
+            labels.push_back(svector<symbol>());
+        }
+        scoped_limits sl(m.limit());
+        for (unsigned j = 0; j < n; ++j)
+            sl.push_child(&(m_managers[j]->limit()));
+
+        auto pop_all = [&]() {
+            for (unsigned j = 0; j < n; ++j)
+                if (phases[j] != finished)
+                    m_solvers[j]->pop(1);
+        };
 
+        bool active = true;
+        while (active) {
+            thread_pool threads;
+            for (unsigned j = 0; j < n; ++j) {
+                if (phases[j] == finished)
+                    continue;
+                threads.run([&, j]() {
+                    try {
+                        results[j] = m_solvers[j]->check_sat(0, nullptr);
+                        if (results[j] == l_true) {
+                            m_solvers[j]->get_model(wmodels[j]);
+                            m_solvers[j]->get_labels(labels[j]);
+                        }
+                    }
+                    catch (z3_exception& ex) {
+                        IF_VERBOSE(2, verbose_stream() << "(opt.pareto worker " << j << " " << ex.msg() << ")\n";);
+                        results[j] = l_undef;
+                    }
+                });
+            }
+            threads.join();
+            if (!m.inc()) {
+                pop_all();
+                return l_undef;
+            }
+            active = false;
+            for (unsigned j = 0; j < n; ++j) {
+                if (phases[j] == finished)
+                    continue;
+                ast_translation tr(m, *m_managers[j]);
+                switch (results[j]) {
+                case l_undef:
+                    pop_all();
+                    return l_undef;
+                case l_true: {
+                    ast_translation back(*m_managers[j], m);
+                    models[j] = wmodels[j]->translate(back);
+                    models[j]->set_model_completion(true);
+                    wmodels[j] = nullptr;
+                    m_solvers[j]->assert_expr(tr(mk_dominates(models[j]).get()));
+                    break;
+                }
+                case l_false:
+                    m_solvers[j]->pop(1);
+                    if (phases[j] == in_box && models[j]) {
+                        m_solvers[j]->push();
+                        m_solvers[j]->assert_expr(tr(mk_dominates(models[j]).get()));
+                        phases[j] = global;
+                    }
+                    else {
+                        if (models[j])
+                            found.push_back(std::make_pair(models[j], labels[j]));
+                        phases[j] = finished;
+                    }
+                    break;
+                }
+                active |= phases[j] != finished;
+            }
+        }
+        return l_true;
+#endif
+    }
+
+    bool par_pareto::is_same(model_ref& a, model_ref& b) {
+        for (unsigned i = 0; i < cb.num_objectives(); ++i)
+            if (!b->is_true(cb.mk_le(i, a)) || !b->is_true(cb.mk_ge(i, a)))
+                return false;
+        return true;
+    }
+
+    void par_pareto::exclude(model_ref& mdl) {
+        expr_ref fml = mk_not_dominated_by(mdl);
+        m_solver->assert_expr(fml);
+        for (unsigned j = 0; j < m_solvers.size(); ++j) {
+            ast_translation tr(m, *m_managers[j]);
+            m_solvers[j]->assert_expr(tr(fml.get()));
+        }
+    }
+
+}
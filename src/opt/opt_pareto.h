@@ -21,6 +21,7 @@ Notes:
 
 #include "solver/solver.h"
 #include "model/model.h"
+#include "util/scoped_ptr_vector.h"
 
 namespace opt {
    
@@ -78,6 +79,10 @@ namespace opt {
         void mk_dominates();
 
         void mk_not_dominated_by();            
+
+        expr_ref mk_dominates(model_ref& mdl);
+
+        expr_ref mk_not_dominated_by(model_ref& mdl);
     };
     class gia_pareto : public pareto_base {
     public:
@@ -105,5 +110,39 @@ namespace opt {
 
         lbool operator()() override;
     };
+
+    /**
+       \brief GIA on copies of the solver.
+       The points that are not dominated by the last Pareto point p are
+       partitioned into the boxes gt_i(p) & le_0(p) & .. & le_{i-1}(p).
+       Each box is searched on its own solver copy, first inside the box
+       and then without the box, so that every copy ends in a Pareto point.
+       The regions dominated by the new points are excluded on all copies
+       and the points are returned one per call.
+    */
+    class par_pareto : public gia_pareto {
+        unsigned                        m_num_threads;
+        scoped_ptr_vector<ast_manager>  m_managers;
+        sref_vector<solver>             m_solvers;
+        vector<std::pair<model_ref, svector<symbol>>> m_points;
+        bool                            m_done { false };
+
+        bool init_solvers();
+        lbool search(expr_ref_vector const& boxes, unsigned lo, unsigned hi, vector<std::pair<model_ref, svector<symbol>>>& found);
+        bool is_same(model_ref& a, model_ref& b);
+        void exclude(model_ref& mdl);
+    public:
+        par_pareto(ast_manager & m, 
+                   pareto_callback& cb, 
+                   solver* s, 
+                   params_ref & p,
+                   unsigned num_threads):
+            gia_pareto(m, cb, s, p),
+            m_num_threads(num_threads) {
+        }
+        ~par_pareto() override {}
+
+        lbool operator()() override;
+    };
 }
 
@@ -21,19 +21,38 @@ Revision History:
 
 
 class opt_stream_buffer {
+    static const size_t BUFFER_SIZE = 1 << 16;
     std::istream & m_stream;
+    char           m_buffer[BUFFER_SIZE]; // input is read in blocks instead of per character
+    char const *   m_pos;
+    char const *   m_end;
     int            m_val;
     unsigned       m_line;
+
+    bool fill() {
+        if (!m_stream.read(m_buffer, BUFFER_SIZE) && m_stream.gcount() == 0)
+            return false;
+        m_pos = m_buffer;
+        m_end = m_buffer + m_stream.gcount();
+        return true;
+    }
 public:    
     opt_stream_buffer(std::istream & s):
         m_stream(s),
+        m_pos(m_buffer),
+        m_end(m_buffer),
         m_line(0) {
-        m_val = m_stream.get();
+        next();
     }
     int  operator *() const { return m_val;}
-    void operator ++() { m_val = m_stream.get(); }
+    void operator ++() { next(); }
     int ch() const { return m_val; }
-    void next() { m_val = m_stream.get(); }
+    void next() { 
+        if (m_pos == m_end && !fill())
+            m_val = EOF;
+        else
+            m_val = static_cast<unsigned char>(*m_pos++);
+    }
     bool eof() const { return ch() == EOF; }
     unsigned line() const { return m_line; }
     void skip_whitespace() {
@@ -0,0 +1,309 @@
+/*++
+Copyright (c) 2021 Microsoft Corporation
+
+Module Name:
+
+    opt_portfolio.cpp
+
+Abstract:
+
+    Anytime workers for maxsat problem instances.
+
+    Each worker owns a manager and a copy of the solver. Models are
+    handed to the main search through a transfer manager that is only
+    accessed under the lock of the slot. The main search polls the
+    slot through an atomic flag without taking the lock.
+
+--*/
+
+#include "ast/ast_translation.h"
+#include "ast/ast_util.h"
+#include "solver/solver.h"
+#include "util/scoped_ptr_vector.h"
+#include "util/thread_pool.h"
+#include "opt/maxsmt.h"
+#include "opt/opt_lns.h"
+#include "opt/pb_sls.h"
+#include "opt/opt_portfolio.h"
+#ifndef SINGLE_THREAD
+#include <atomic>
+#include <mutex>
+#endif
+
+namespace opt {
+
+#ifdef SINGLE_THREAD
+
+    struct anytime_portfolio::imp {
+        imp(ast_manager& m) {}
+        void start(solver& s, expr_ref_vector const& soft, vector<rational> const& weights,
+                   unsigned num_workers, rational const& upper) {}
+        bool get_model(model_ref& mdl) { return false; }
+        void set_upper(rational const& upper) {}
+        void stop() {}
+    };
+
+#else
+
+    struct anytime_portfolio::imp {
+
+        /**
+           \brief A worker searches for assignments of the soft literals m_soft,
+           which are equivalent to the soft constraints m_fmls.
+        */
+        struct worker : public lns_context {
+            imp&             p;
+            ast_manager&     m;
+            ref<solver>      m_solver;
+            expr_ref_vector  m_fmls;
+            expr_ref_vector  m_soft;
+            vector<rational> m_weights;
+            obj_map<expr, rational> m_weight;
+
+            worker(imp& p, ast_manager& m, solver* s):
+                p(p), m(m), m_solver(s), m_fmls(m), m_soft(m) {}
+            ~worker() override {}
+
+            void update_model(model_ref& mdl) override {
+                p.publish(m, mdl, cost(*mdl));
+            }
+            void relax_cores(vector<expr_ref_vector> const& cores) override {}
+            rational cost(model& mdl) override {
+                rational c(0);
+                for (unsigned i = 0; i < m_soft.size(); ++i)
+                    if (!mdl.is_true(m_soft.get(i)))
+                        c += m_weights[i];
+                return c;
+            }
+            rational weight(expr* e) override { return m_weight[e]; }
+            expr_ref_vector const& soft() override { return m_soft; }
+        };
+
+        ast_manager&              m;
+        ast_manager               m_tm;          // transfer manager, guarded by m_mux
+        std::mutex                m_mux;
+        std::atomic<bool>         m_has_model { false };
+        model_ref                 m_best;        // in m_tm, guarded by m_mux
+        rational                  m_best_cost;   // guarded by m_mux
+        scoped_ptr_vector<ast_manager> m_managers;
+        scoped_ptr_vector<worker> m_workers;
+        scoped_ptr<scoped_limits> m_limits;
+        thread_pool               m_threads;
+        bool                      m_running { false };
+
+        imp(ast_manager& m): m(m), m_tm(m, true) {}
+
+        ~imp() {
+            stop();
+        }
+
+        void publish(ast_manager& wm, model_ref& mdl, rational const& cost) {
+            std::lock_guard<std::mutex> lock(m_mux);
+            if (cost >= m_best_cost)
+                return;
+            ast_translation tr(wm, m_tm);
+            m_best = mdl->translate(tr);
+            m_best_cost = cost;
+            m_has_model = true;
+        }
+
+        bool is_improvement(rational const& cost) {
+            std::lock_guard<std::mutex> lock(m_mux);
+            return cost < m_best_cost;
+        }
+
+        void set_upper(rational const& upper) {
+            std::lock_guard<std::mutex> lock(m_mux);
+            if (upper < m_best_cost)
+                m_best_cost = upper;
+        }
+
+        bool get_model(model_ref& mdl) {
+            if (!m_has_model)
+                return false;
+            std::lock_guard<std::mutex> lock(m_mux);
+            if (!m_best)
+                return false;
+            ast_translation tr(m_tm, m);
+            mdl = m_best->translate(tr);
+            m_best = nullptr;
+            m_has_model = false;
+            return true;
+        }
+
+        void start(solver& s, expr_ref_vector const& soft, vector<rational> const& weights,
+                   unsigned num_workers, rational const& upper) {
+            SASSERT(!m_running);
+            m_best_cost = upper;
+            try {
+                for (unsigned j = 0; j < num_workers; ++j) {
+                    ast_manager* wm = alloc(ast_manager, m, true);
+                    m_managers.push_back(wm);
+                    params_ref p(s.get_params());
+                    p.set_uint("random_seed", p.get_uint("random_seed", 0) + j + 1);
+                    worker* w = alloc(worker, *this, *wm, s.translate(*wm, p));
+                    m_workers.push_back(w);
+                    ast_translation tr(m, *wm);
+                    for (unsigned i = 0; i < soft.size(); ++i) {
+                        expr_ref f(tr(soft.get(i)), *wm);
+                        expr_ref a(f, *wm);
+                        if (!is_uninterp_const(f)) {
+                            a = wm->mk_fresh_const("soft", wm->mk_bool_sort());
+                            w->m_solver->assert_expr(wm->mk_eq(a, f));
+                        }
+                        w->m_fmls.push_back(f);
+                        w->m_soft.push_back(a);
+                        w->m_weights.push_back(weights[i]);
+                        rational w0;
+                        w->m_weight.find(a, w0);
+                        w->m_weight.insert(a, w0 + weights[i]);
+                    }
+                    sort_by_weight(*w);
+                }
+            }
+            catch (z3_exception&) {
+                // the solver cannot be copied in its current state.
+                m_workers.reset();
+                m_managers.reset();
+                return;
+            }
+            m_limits = alloc(scoped_limits, m.limit());
+            for (ast_manager* wm : m_managers)
+                m_limits->push_child(&(wm->limit()));
+            m_running = true;
+            for (unsigned j = 0; j < m_workers.size(); ++j) {
+                m_threads.run([&, j]() {
+                    try {
+                        if (j % 2 == 0)
+                            run_lns(*m_workers[j]);
+                        else
+                            run_sls(*m_workers[j]);
+                    }
+                    catch (z3_exception& ex) {
+                        IF_VERBOSE(2, verbose_stream() << "(opt.anytime worker " << j << " " << ex.msg() << ")\n";);
+                    }
+                });
+            }
+        }
+
+        void sort_by_weight(worker& w) {
+            unsigned_vector idx;
+            for (unsigned i = 0; i < w.m_soft.size(); ++i)
+                idx.push_back(i);
+            std::stable_sort(idx.begin(), idx.end(), [&](unsigned i, unsigned j) { return w.m_weights[i] > w.m_weights[j]; });
+            expr_ref_vector fmls(w.m), soft(w.m);
+            vector<rational> weights;
+            for (unsigned i : idx) {
+                fmls.push_back(w.m_fmls.get(i));
+                soft.push_back(w.m_soft.get(i));
+                weights.push_back(w.m_weights[i]);
+            }
+            w.m_fmls.swap(fmls);
+            w.m_soft.swap(soft);
+            w.m_weights.swap(weights);
+        }
+
+        void run_lns(worker& w) {
+            solver& s = *w.m_solver;
+            if (s.check_sat(0, nullptr) != l_true)
+                return;
+            model_ref mdl;
+            s.get_model(mdl);
+            w.update_model(mdl);
+            lns l(s, w);
+            unsigned conflicts = 1000;
+            while (w.m.inc()) {
+                l.set_conflicts(conflicts);
+                l.climb(mdl);
+                if (conflicts < (1u << 20))
+                    conflicts *= 2;
+            }
+        }
+
+        /**
+           \brief Local search ignores the hard constraints it cannot compile. Its
+           assignments are therefore repaired by asserting the soft constraints
+           it satisfies as assumptions to the solver copy.
+        */
+        void run_sls(worker& w) {
+            ast_manager& wm = w.m;
+            solver& s = *w.m_solver;
+            smt::pb_sls sls(wm);
+            for (expr* f : s.get_assertions())
+                sls.add(f);
+            for (unsigned i = 0; i < w.m_fmls.size(); ++i)
+                sls.add(w.m_fmls.get(i), w.m_weights[i]);
+            if (s.check_sat(0, nullptr) != l_true)
+                return;
+            model_ref mdl, smdl;
+            s.get_model(mdl);
+            w.update_model(mdl);
+            expr_ref_vector asms(wm);
+            while (wm.inc()) {
+                sls.set_model(mdl);
+                if (sls() != l_true)
+                    return;
+                sls.get_model(smdl);
+                asms.reset();
+                rational cost(0);
+                for (unsigned i = 0; i < w.m_fmls.size(); ++i) {
+                    if (smdl->is_true(w.m_fmls.get(i)))
+                        asms.push_back(w.m_soft.get(i));
+                    else
+                        cost += w.m_weights[i];
+                }
+                if (!is_improvement(cost))
+                    continue;
+                switch (s.check_sat(asms)) {
+                case l_true:
+                    s.get_model(mdl);
+                    w.update_model(mdl);
+                    break;
+                case l_false:
+                    break;
+                default:
+                    return;
+                }
+            }
+        }
+
+        void stop() {
+            if (!m_running)
+                return;
+            for (ast_manager* wm : m_managers)
+                wm->limit().cancel();
+            m_threads.join();
+            m_running = false;
+            m_limits = nullptr;
+            m_workers.reset();
+            m_managers.reset();
+        }
+    };
+
+#endif
+
+    anytime_portfolio::anytime_portfolio(ast_manager& m) {
+        m_imp = alloc(imp, m);
+    }
+
+    anytime_portfolio::~anytime_portfolio() {
+        dealloc(m_imp);
+    }
+
+    void anytime_portfolio::start(solver& s, expr_ref_vector const& soft, vector<rational> const& weights,
+                                  unsigned num_workers, rational const& upper) {
+        m_imp->start(s, soft, weights, num_workers, upper);
+    }
+
+    bool anytime_portfolio::get_model(model_ref& mdl) {
+        return m_imp->get_model(mdl);
+    }
+
+    void anytime_portfolio::set_upper(rational const& upper) {
+        m_imp->set_upper(upper);
+    }
+
+    void anytime_portfolio::stop() {
+        m_imp->stop();
+    }
+};
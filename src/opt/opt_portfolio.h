@@ -0,0 +1,61 @@
+/*++
+Copyright (c) 2021 Microsoft Corporation
+
+Module Name:
+
+    opt_portfolio.h
+
+Abstract:
+   
+    Anytime workers for maxsat problem instances.
+
+    Worker threads search for assignments of low cost on copies of the
+    solver while the core-guided search runs in the main thread.
+    Workers alternate between large neighborhood search (opt_lns) and
+    stochastic local search (pb_sls) whose assignments are repaired by
+    the solver copy. The best model is kept in a shared slot from which
+    the main search picks up improved upper bounds.
+
+--*/
+
+#pragma once
+
+#include "ast/ast.h"
+#include "model/model.h"
+#include "util/rational.h"
+
+class solver;
+
+namespace opt {
+
+    class anytime_portfolio {
+        struct imp;
+        imp* m_imp;
+    public:
+        anytime_portfolio(ast_manager& m);
+        ~anytime_portfolio();
+
+        /**
+           \brief Start num_workers workers on copies of s for the soft constraints 
+           with the given weights. Only models of cost below upper are reported.
+        */
+        void start(solver& s, expr_ref_vector const& soft, vector<rational> const& weights,
+                   unsigned num_workers, rational const& upper);
+
+        /**
+           \brief Retrieve the best model found by the workers since the last call, if any.
+        */
+        bool get_model(model_ref& mdl);
+
+        /**
+           \brief Inform the workers about an upper bound found by the main search.
+        */
+        void set_upper(rational const& upper);
+
+        /**
+           \brief Cancel the workers and wait for them to finish.
+        */
+        void stop();
+    };
+
+};
@@ -31,6 +31,8 @@ Notes:
 #include "ast/ast_smt_pp.h"
 #include "ast/pp_params.hpp"
 #include "opt/opt_params.hpp"
+#include "smt/smt_solver.h"
+#include "ast/ast_translation.h"
 #include "model/model_smt2_pp.h"
 #include "util/stopwatch.h"
 
@@ -70,9 +72,17 @@ namespace opt {
         m_params.m_arith_auto_config_simplex = false;
     }
 
-    solver* opt_solver::translate(ast_manager& m, params_ref const& p) {
-        UNREACHABLE();
-        return nullptr;
+    /**
+       \brief The copy is a plain SMT solver over the current assertions.
+       It is used for satisfiability and core queries, such as core
+       minimization, but not for optimization.
+    */
+    solver* opt_solver::translate(ast_manager& dst, params_ref const& p) {
+        solver* r = mk_smt_solver(dst, p, symbol::null);
+        ast_translation tr(m, dst);
+        for (unsigned i = 0; i < get_num_assertions(); ++i)
+            r->assert_expr(tr(get_assertion(i)));
+        return r;
     }
 
     void opt_solver::collect_param_descrs(param_descrs & r) {
@@ -38,7 +38,13 @@ Notes:
 #include "ast/ast_util.h"
 #include "model/model_pp.h"
 #include "ast/rewriter/th_rewriter.h"
+#include "ast/ast_translation.h"
+#include "util/scoped_ptr_vector.h"
+#include "util/thread_pool.h"
 #include "opt/opt_params.hpp"
+#ifndef SINGLE_THREAD
+#include <atomic>
+#endif
 
 namespace opt {
 
@@ -208,6 +214,22 @@ namespace opt {
         unsigned num_scopes = 0;
         inf_eps last_objective = inf_eps(rational(-1), inf_rational(0));
 
+        //
+        // The model of the previous objective is a candidate solution.
+        // Its value is asserted in a scope that is retracted if it
+        // is not achievable, e.g., because other objectives were
+        // committed since.
+        //
+        bool has_hint = false;
+        m_model = nullptr;
+        rational hint;
+        if (m_best_model && arith.is_numeral((*m_best_model)(m_objs.get(obj_index)), hint)) {
+            has_hint = true;
+            m_s->push();
+            ++num_scopes;
+            m_s->assert_expr(m_s->mk_ge(obj_index, inf_eps(hint)));
+        }
+
         while (m.inc()) {
             SASSERT(delta_per_step.is_int());
             SASSERT(delta_per_step.is_pos());
@@ -255,6 +277,12 @@ namespace opt {
                 --num_scopes;
                 m_s->pop(1);                             
             }
+            else if (is_sat == l_false && has_hint && !m_model) {
+                has_hint = false;
+                m_s->pop(num_scopes);
+                num_scopes = 0;
+                last_bound = nullptr;
+            }
             else {
                 break;
             }
@@ -524,12 +552,108 @@ namespace opt {
         if (m_optsmt_engine == symbol("symba")) {
             is_sat = symba_opt();
         }
+        else if (m_box_threads > 1 && m_vars.size() > 1) {
+            is_sat = parallel_box();
+        }
         else {
             is_sat = geometric_opt();
         }
         return is_sat;
     }
 
+    /**
+       \brief Optimize each objective of box mode on its own copy of the solver.
+       The objectives do not constrain each other, so a copy maximizes one
+       objective by asserting the blocker of the optimizer until the blocker
+       is unsatisfiable. Copies are created before the threads start.
+    */
+    lbool optsmt::parallel_box() {
+#ifdef SINGLE_THREAD
+        return geometric_opt();
+#else
+        unsigned n = m_vars.size();
+        scoped_ptr_vector<ast_manager> managers;
+        scoped_ptr_vector<generic_model_converter> fms;
+        sref_vector<opt_solver> solvers;
+        for (unsigned j = 0; j < n; ++j) {
+            ast_manager* wm = alloc(ast_manager, m, true);
+            managers.push_back(wm);
+            generic_model_converter* fm = alloc(generic_model_converter, *wm, "box");
+            fms.push_back(fm);
+            opt_solver* s = alloc(opt_solver, *wm, m_params, *fm);
+            solvers.push_back(s);
+            ast_translation tr(m, *wm);
+            for (unsigned i = 0; i < m_s->get_num_assertions(); ++i)
+                s->assert_expr(tr(m_s->get_assertion(i)));
+            if (s->add_objective(tr(m_objs.get(j))) == smt::null_theory_var)
+                return geometric_opt();
+        }
+
+        svector<lbool> results(n, l_undef);
+        vector<inf_eps> values(n, inf_eps(rational(-1), inf_rational(0)));
+        std::atomic<unsigned> next(0);
+        scoped_limits sl(m.limit());
+        for (ast_manager* wm : managers)
+            sl.push_child(&(wm->limit()));
+
+        auto optimize = [&](unsigned j) {
+            opt_solver& s = *solvers[j];
+            expr_ref bound(s.get_manager());
+            lbool is_sat = s.check_sat(0, nullptr);
+            bool found = false;
+            while (is_sat == l_true) {
+                if (!s.maximize_objective(0, bound)) {
+                    is_sat = l_undef;
+                    break;
+                }
+                found = true;
+                values[j] = s.saved_objective_value(0);
+                if (!values[j].is_finite())
+                    break;
+                s.assert_expr(bound);
+                is_sat = s.check_sat(0, nullptr);
+            }
+            results[j] = (is_sat == l_false && found) ? l_true : is_sat;
+        };
+
+        thread_pool threads;
+        for (unsigned t = 0; t < std::min(n, m_box_threads); ++t) {
+            threads.run([&]() {
+                unsigned j;
+                while ((j = next++) < n) {
+                    try {
+                        optimize(j);
+                    }
+                    catch (z3_exception& ex) {
+                        IF_VERBOSE(2, verbose_stream() << "(optsmt.box objective " << j << " " << ex.msg() << ")\n";);
+                        results[j] = l_undef;
+                    }
+                }
+            });
+        }
+        threads.join();
+
+        if (!m.inc())
+            return l_undef;
+        for (unsigned j = 0; j < n; ++j)
+            if (results[j] != l_true)
+                return results[j];
+        for (unsigned j = 0; j < n; ++j) {
+            ast_translation tr(*managers[j], m);
+            model* mdl = solvers[j]->get_model_idx(0);
+            if (mdl)
+                m_models.set(j, mdl->translate(tr));
+            if (values[j] > m_lower[j])
+                m_lower[j] = values[j];
+            m_upper[j] = m_lower[j];
+        }
+        m_model = m_models[0];
+        solvers[0]->get_labels(m_labels);
+        IF_VERBOSE(2, verbose_stream() << "(optsmt.lower " << m_lower << ")\n";);
+        return l_true;
+#endif
+    }
+
 
     inf_eps optsmt::get_lower(unsigned i) const {
         if (i >= m_lower.size()) return inf_eps();
@@ -574,6 +698,8 @@ namespace opt {
     void optsmt::updt_params(params_ref& p) {
         opt_params _p(p);
         m_optsmt_engine = _p.optsmt_engine();        
+        m_box_threads = _p.box_threads();
+        m_params.copy(p);
     }
 
     void optsmt::reset() {
@@ -38,12 +38,14 @@ namespace opt {
         expr_ref_vector  m_lower_fmls;
         svector<smt::theory_var> m_vars;
         symbol           m_optsmt_engine;
+        unsigned         m_box_threads;
+        params_ref       m_params;
         model_ref        m_model, m_best_model;
         svector<symbol>  m_labels;
         sref_vector<model> m_models;
     public:
         optsmt(ast_manager& m, context& ctx): 
-            m(m), m_context(ctx), m_s(nullptr), m_objs(m), m_lower_fmls(m) {}
+            m(m), m_context(ctx), m_s(nullptr), m_objs(m), m_lower_fmls(m), m_box_threads(1) {}
 
         void setup(opt_solver& solver);
 
@@ -79,6 +81,8 @@ namespace opt {
 
         lbool geometric_opt();
 
+        lbool parallel_box();
+
         lbool symba_opt();
 
         lbool geometric_lex(unsigned idx, bool is_maximize);
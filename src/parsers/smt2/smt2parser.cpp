@@ -3013,10 +3013,10 @@ namespace smt2 {
         }
 
     public:
-        parser(cmd_context & ctx, std::istream & is, bool interactive, params_ref const & p, char const * filename=nullptr):
+        parser(cmd_context & ctx, std::istream * is, char const * data, size_t size, bool interactive, params_ref const & p, char const * filename):
             m_ctx(ctx),
             m_params(p),
-            m_scanner(ctx, is, interactive),
+            m_scanner(ctx, is, data, size, interactive),
             m_curr(scanner::NULL_TOKEN),
             m_curr_cmd(nullptr),
             m_num_bindings(0),
@@ -3067,6 +3067,14 @@ namespace smt2 {
             updt_params();
         }
 
+        parser(cmd_context & ctx, std::istream & is, bool interactive, params_ref const & p, char const * filename=nullptr):
+            parser(ctx, &is, nullptr, 0, interactive, p, filename) {
+        }
+
+        parser(cmd_context & ctx, char const * data, size_t size, params_ref const & p, char const * filename=nullptr):
+            parser(ctx, nullptr, data, size, false, p, filename) {
+        }
+
         ~parser() {
             reset_stack();
         }
@@ -3207,6 +3215,11 @@ bool parse_smt2_commands(cmd_context & ctx, std::istream & is, bool interactive,
     return p();
 }
 
+bool parse_smt2_commands(cmd_context & ctx, char const * data, size_t size, params_ref const & ps, char const * filename) {
+    smt2::parser p(ctx, data, size, ps, filename);
+    return p();
+}
+
 sort_ref parse_smt2_sort(cmd_context & ctx, std::istream & is, bool interactive, params_ref const & ps, char const * filename) {
     smt2::parser p(ctx, is, interactive, ps, filename);
     return p.parse_sort_ref(filename);
@@ -22,6 +22,11 @@ Revision History:
 
 bool parse_smt2_commands(cmd_context & ctx, std::istream & is, bool interactive = false, params_ref const & p = params_ref(), char const * filename = nullptr);
 
+/**
+   \brief parse the commands in [data, data + size) without copying the buffer.
+*/
+bool parse_smt2_commands(cmd_context & ctx, char const * data, size_t size, params_ref const & p = params_ref(), char const * filename = nullptr);
+
 sexpr_ref parse_sexpr(cmd_context& ctx, std::istream& is, params_ref const& ps, char const* filename);
 
 sort_ref parse_smt2_sort(cmd_context & ctx, std::istream & is, bool interactive, params_ref const & ps, char const * filename);
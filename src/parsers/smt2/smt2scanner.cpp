@@ -16,6 +16,7 @@ Author:
 Revision History:
 
 --*/
+#include <cstring>
 #include "parsers/smt2/smt2scanner.h"
 #include "parsers/util/parser_params.hpp"
 
@@ -27,17 +28,20 @@ namespace smt2 {
         if (m_at_eof)
             throw scanner_exception("unexpected end of file");
         if (m_interactive) {
-            m_curr = m_stream.get();
-            if (m_stream.eof())
+            m_curr = m_stream->get();
+            if (m_stream->eof())
                 m_at_eof = true;
         }
         else if (m_bpos < m_bend) {
-            m_curr = m_buffer[m_bpos];
+            m_curr = m_data[m_bpos];
             m_bpos++;
         }
+        else if (!m_stream) {
+            m_at_eof = true;
+        }
         else {
-            m_stream.read(m_buffer, SCANNER_BUFFER_SIZE);
-            m_bend = static_cast<unsigned>(m_stream.gcount());
+            m_stream->read(m_buffer, SCANNER_BUFFER_SIZE);
+            m_bend = static_cast<size_t>(m_stream->gcount());
             m_bpos = 0;
             if (m_bpos == m_bend) {
                 m_at_eof = true;
@@ -50,10 +54,46 @@ namespace smt2 {
         m_spos++;
     }
 
+    /**
+       \brief Consume in bulk the characters, starting with the current one, that
+       satisfy \c pred and are already buffered. The last buffered character is
+       never consumed, so the caller's character loop takes care of refilling
+       the buffer and of the character that ends the run.
+       Consumed characters are appended to \c out when it is not null.
+    */
+    template<typename Pred>
+    unsigned scanner::skip_run(Pred pred, svector<char>* out) {
+        if (m_interactive || m_at_eof || m_bpos == 0)
+            return 0;
+        char const * start = m_data + m_bpos - 1;
+        char const * last  = m_data + m_bend - 1;
+        char const * p     = start;
+        while (p < last && pred(*p))
+            ++p;
+        unsigned n = static_cast<unsigned>(p - start);
+        if (n == 0)
+            return 0;
+        if (out) {
+            unsigned sz = out->size();
+            out->resize(sz + n);
+            memcpy(out->data() + sz, start, n);
+        }
+        if (m_cache_input) {
+            unsigned sz = m_cache.size();
+            m_cache.resize(sz + n);
+            memcpy(m_cache.data() + sz, start, n);
+        }
+        m_spos += n;
+        m_bpos += n;
+        m_curr  = *p;
+        return n;
+    }
+
     void scanner::read_comment() {
         SASSERT(curr() == ';');
         next();
         while (true) {
+            skip_run([](char c) { return c != '\n'; }, nullptr);
             char c = curr();
             if (m_at_eof)
                 return;
@@ -92,6 +132,8 @@ namespace smt2 {
         m_string.reset();
         next();
         while (true) {
+            if (skip_run([](char c) { return c != '|' && c != '\\' && c != '\n'; }, &m_string))
+                escape = false;
             char c = curr();
             if (m_at_eof) {
                 throw scanner_exception("unexpected end of quoted symbol", m_line, m_spos);
@@ -113,7 +155,12 @@ namespace smt2 {
     }
 
     scanner::token scanner::read_symbol_core() {
+        auto is_symbol_char = [&](char c) {
+            signed char n = m_normalized[static_cast<unsigned char>(c)];
+            return n == 'a' || n == '0' || n == '-';
+        };
         while (!m_at_eof) {
+            skip_run(is_symbol_char, &m_string);
             char c = curr();
             signed char n = m_normalized[static_cast<unsigned char>(c)];
             if (n == 'a' || n == '0' || n == '-') {
@@ -195,6 +242,7 @@ namespace smt2 {
         next();
         m_string.reset();
         while (true) {
+            skip_run([](char c) { return c != '\"' && c != '\n'; }, &m_string);
             char c = curr();
             if (m_at_eof)
                 throw scanner_exception("unexpected end of string", m_line, m_spos);
@@ -270,7 +318,7 @@ namespace smt2 {
         }
     }
 
-    scanner::scanner(cmd_context & ctx, std::istream& stream, bool interactive) :
+    scanner::scanner(cmd_context & ctx, std::istream* stream, char const * data, size_t size, bool interactive) :
         ctx(ctx),
         m_interactive(interactive),
         m_spos(0),
@@ -279,8 +327,9 @@ namespace smt2 {
         m_line(1),
         m_pos(0),
         m_bv_size(UINT_MAX),
+        m_data(stream ? m_buffer : data),
         m_bpos(0),
-        m_bend(0),
+        m_bend(stream ? 0 : size),
         m_stream(stream),
         m_cache_input(false) {
 
@@ -336,6 +385,7 @@ namespace smt2 {
             switch (m_normalized[(unsigned char) c]) {
             case ' ':
                 next();
+                skip_run([&](char c) { return m_normalized[static_cast<unsigned char>(c)] == ' '; }, nullptr);
                 break;
             case '\n':
                 next();
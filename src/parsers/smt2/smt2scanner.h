@@ -46,10 +46,11 @@ namespace smt2 {
         signed char        m_normalized[256];
 #define SCANNER_BUFFER_SIZE 1024
         char               m_buffer[SCANNER_BUFFER_SIZE];
-        unsigned           m_bpos;
-        unsigned           m_bend;
+        char const *       m_data;   // either m_buffer or the caller supplied input
+        size_t             m_bpos;
+        size_t             m_bend;
         svector<char>      m_string;
-        std::istream&      m_stream;
+        std::istream*      m_stream; // nullptr when scanning an in-memory buffer
         
         bool               m_cache_input;
         svector<char>      m_cache;
@@ -59,6 +60,8 @@ namespace smt2 {
         char curr() const { return m_curr; }
         void new_line() { m_line++; m_spos = 0; }
         void next();
+        template<typename Pred>
+        unsigned skip_run(Pred pred, svector<char>* out);
         
     public:
         
@@ -75,7 +78,17 @@ namespace smt2 {
             EOF_TOKEN
         };
         
-        scanner(cmd_context & ctx, std::istream& stream, bool interactive = false);  
+        scanner(cmd_context & ctx, std::istream* stream, char const * data, size_t size, bool interactive);
+
+        scanner(cmd_context & ctx, std::istream& stream, bool interactive = false):
+            scanner(ctx, &stream, nullptr, 0, interactive) {}
+
+        /**
+           \brief scan the characters in [data, data + size).
+           The buffer is not copied and must outlive the scanner.
+        */
+        scanner(cmd_context & ctx, char const * data, size_t size):
+            scanner(ctx, nullptr, data, size, false) {}
         
         int get_line() const { return m_line; }
         int get_pos() const { return m_pos; }
@@ -52,10 +52,25 @@ namespace qe {
 
         struct stats {
             unsigned m_num_rounds;        
+            unsigned m_num_cell_hits;
             stats() { reset(); }
             void reset() { memset(this, 0, sizeof(*this)); }            
         };
         
+        /**
+           \brief A cell computed by projecting m_lits onto the variables
+           that are not in m_vars. Every model of the cell literals has an
+           extension that satisfies m_lits, so the cell is reused for any
+           later model in it.
+        */
+        struct cell {
+            unsigned                      m_hash;
+            nlsat::var_vector             m_vars;
+            nlsat::scoped_literal_vector  m_lits;
+            nlsat::scoped_literal_vector  m_cell;
+            cell(nlsat::solver& s): m_hash(0), m_lits(s), m_cell(s) {}
+        };
+
         struct solver_state {
             ast_manager&           m;
             params_ref             m_params;
@@ -78,6 +93,8 @@ namespace qe {
             nlsat::literal_vector                m_cached_asms;
             unsigned_vector                      m_cached_asms_lim;
             u_map<expr*>                         m_asm2fml;
+            scoped_ptr_vector<cell>              m_cells;
+            u_map<unsigned_vector>               m_hash2cells;
             solver_state(ast_manager& m, params_ref const& p):
                 m(m),
                 m_params(p),
@@ -246,6 +263,8 @@ namespace qe {
                 m_x2t.reset();
                 m_assumptions.reset();
                 m_asm2fml.reset();
+                m_cells.reset();
+                m_hash2cells.reset();
             }
         };
         ast_manager&           m;
@@ -381,6 +400,13 @@ namespace qe {
                 }
             }
             TRACE("qe", s.m_solver.display(tout, result.size(), result.data()); tout << "\n";);
+            if (find_cell(vars, result)) {
+                negate_clause(result);
+                return;
+            }
+            cell* c = alloc(cell, s.m_solver);
+            c->m_vars.append(vars);
+            c->m_lits.append(result.size(), result.data());
             // project quantified real variables.
             // They are sorted by size, so we project the largest variables first to avoid 
             // renaming variables. 
@@ -391,9 +417,59 @@ namespace qe {
                 TRACE("qe", display_project(std::cout, vars[i], result, new_result););
                 result.swap(new_result);
             }
+            c->m_cell.append(result.size(), result.data());
+            insert_cell(c);
             negate_clause(result);
         }
 
+        static unsigned cell_hash(nlsat::var_vector const& vars, unsigned n, nlsat::literal const* lits) {
+            unsigned h = vars.size();
+            for (nlsat::var v : vars)
+                h = combine_hash(h, v);
+            for (unsigned i = 0; i < n; ++i)
+                h = combine_hash(h, lits[i].index());
+            return h;
+        }
+
+        /**
+           \brief Reuse a cell of the same literals and variables that contains
+           the current model. The literals are compared in the order of the
+           assumptions, which is deterministic for a given level.
+        */
+        bool find_cell(nlsat::var_vector const& vars, clause& lits) {
+            unsigned h = cell_hash(vars, lits.size(), lits.data());
+            auto* e = s.m_hash2cells.find_core(h);
+            if (!e)
+                return false;
+            for (unsigned idx : e->get_data().m_value) {
+                cell const& c = *s.m_cells[idx];
+                if (c.m_vars != vars || c.m_lits.size() != lits.size())
+                    continue;
+                bool same = true;
+                for (unsigned i = 0; same && i < lits.size(); ++i)
+                    same = c.m_lits[i] == lits[i];
+                for (unsigned i = 0; same && i < c.m_cell.size(); ++i)
+                    same = s.m_solver.value(c.m_cell[i]) == l_true;
+                if (!same)
+                    continue;
+                ++m_stats.m_num_cell_hits;
+                lits.reset();
+                lits.append(c.m_cell.size(), c.m_cell.data());
+                return true;
+            }
+            return false;
+        }
+
+        void insert_cell(cell* c) {
+            if (s.m_cells.size() >= 10000) {
+                s.m_cells.reset();
+                s.m_hash2cells.reset();
+            }
+            c->m_hash = cell_hash(c->m_vars, c->m_lits.size(), c->m_lits.data());
+            s.m_hash2cells.insert_if_not_there(c->m_hash, unsigned_vector()).push_back(s.m_cells.size());
+            s.m_cells.push_back(c);
+        }
+
         void negate_clause(clause& result) {
             for (unsigned i = 0; i < result.size(); ++i) {
                 result.set(i, ~result[i]);
@@ -934,6 +1010,7 @@ namespace qe {
         void collect_statistics(statistics & st) const override {
             st.copy(m_st);
             st.update("qsat num rounds", m_stats.m_num_rounds); 
+            st.update("qsat num cell hits", m_stats.m_num_cell_hits);
         }
 
         void reset_statistics() override {
@@ -614,37 +614,90 @@ namespace qel {
             }
         }
 
-        bool is_unconstrained(var* x, expr* t, unsigned i, expr_ref_vector const& conjs) {
+        /**
+           \brief Collect the indices of the free variables of e, shifted by offset
+           under binders, that are not yet in found.
+        */
+        void collect_vars(expr* e, unsigned offset, uint_set& found, unsigned_vector& idxs) {
+            if (is_ground(e)) return;
+            ptr_buffer<expr> todo;
+            ast_mark mark;
+            todo.push_back(e);
+            while (!todo.empty()) {
+                e = todo.back();
+                todo.pop_back();
+                if (mark.is_marked(e) || is_ground(e)) continue;
+                mark.mark(e, true);
+                if (::is_var(e)) {
+                    unsigned idx = ::to_var(e)->get_idx();
+                    if (idx >= offset && !found.contains(idx - offset)) {
+                        found.insert(idx - offset);
+                        idxs.push_back(idx - offset);
+                    }
+                }
+                else if (is_app(e)) {
+                    todo.append(to_app(e)->get_num_args(), to_app(e)->get_args());
+                }
+                else if (is_quantifier(e)) {
+                    quantifier* q = to_quantifier(e);
+                    collect_vars(q->get_expr(), offset + q->get_num_decls(), found, idxs);
+                }
+            }
+        }
+
+        bool is_unconstrained(expr* x, expr* t, unsigned_vector const& num_occs) {
+            if (!is_variable(x) || !::is_var(x)) return false;
             sort* s = x->get_sort();
             if (!m.is_fully_interp(s) || !s->get_num_elements().is_infinite()) return false;
-            bool occ = occurs_var(x->get_idx(), t);
-            for (unsigned j = 0; !occ && j < conjs.size(); ++j) {
-                occ = (i != j) && occurs_var(x->get_idx(), conjs[j]);
-            }
-            return !occ;
+            unsigned idx = ::to_var(x)->get_idx();
+            return num_occs[idx] == 1 && !occurs_var(idx, t);
         }
 
+        /**
+           \brief Remove disequalities x != t where x occurs in no other conjunct.
+           The conjuncts that contain a variable are indexed, so removing a
+           disequality only revisits the conjuncts of variables that become
+           unique to one conjunct.
+        */
         bool remove_unconstrained(expr_ref_vector& conjs) {
-            bool reduced = false, change = true;
+            bool reduced = false;
             expr *r = nullptr, *l = nullptr, *ne = nullptr;
-            while (change) {
-                change = false;
-                for (unsigned i = 0; i < conjs.size(); ++i) {
-                    if (m.is_not(conjs[i].get(), ne) && m.is_eq(ne, l, r)) {
-                        TRACE("qe_lite", tout << mk_pp(conjs[i].get(), m) << " " << is_variable(l) << " " << is_variable(r) << "\n";);
-                        if (is_variable(l) && ::is_var(l) && is_unconstrained(::to_var(l), r, i, conjs)) {
-                            conjs[i] = m.mk_true();
-                            reduced = true;
-                            change = true;
-                        }
-                        else if (is_variable(r) && ::is_var(r) && is_unconstrained(::to_var(r), l, i, conjs)) {
-                            conjs[i] = m.mk_true();
-                            reduced = true;
-                            change = true;
-                        }
-                    }
+            unsigned n = conjs.size();
+            vector<unsigned_vector> conj2vars(n);
+            vector<unsigned_vector> var2conjs;
+            unsigned_vector num_occs;
+            uint_set found;
+            for (unsigned i = 0; i < n; ++i) {
+                unsigned_vector& idxs = conj2vars[i];
+                collect_vars(conjs.get(i), 0, found, idxs);
+                for (unsigned idx : idxs) {
+                    found.remove(idx);
+                    var2conjs.reserve(idx + 1);
+                    num_occs.reserve(idx + 1, 0);
+                    var2conjs[idx].push_back(i);
+                    ++num_occs[idx];
                 }
             }
+            unsigned_vector todo;
+            for (unsigned i = n; i-- > 0; )
+                todo.push_back(i);
+            while (!todo.empty()) {
+                unsigned i = todo.back();
+                todo.pop_back();
+                expr* e = conjs.get(i);
+                if (!m.is_not(e, ne) || !m.is_eq(ne, l, r))
+                    continue;
+                TRACE("qe_lite", tout << mk_pp(e, m) << " " << is_variable(l) << " " << is_variable(r) << "\n";);
+                if (!is_unconstrained(l, r, num_occs) && !is_unconstrained(r, l, num_occs))
+                    continue;
+                conjs[i] = m.mk_true();
+                reduced = true;
+                for (unsigned idx : conj2vars[i]) 
+                    if (--num_occs[idx] == 1) 
+                        for (unsigned j : var2conjs[idx]) 
+                            if (j != i) 
+                                todo.push_back(j);
+            }
             return reduced;
         }
 
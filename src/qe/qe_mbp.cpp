@@ -26,6 +26,7 @@ Revision History:
 #include "ast/expr_functors.h"
 #include "ast/for_each_expr.h"
 #include "ast/scoped_proof.h"
+#include "util/scoped_ptr_vector.h"
 #include "qe/qe_mbp.h"
 #include "qe/mbp/mbp_arith.h"
 #include "qe/mbp/mbp_arrays.h"
@@ -48,6 +49,86 @@ class mbproj::impl {
     bool m_reduce_all_selects;
     bool m_dont_sub;
 
+    /**
+       \brief A projection of m_fml onto the complement of m_vars.
+       It is a valid projection for every model that satisfies it, so it
+       is reused for later calls on the same formula and variables.
+    */
+    struct projection {
+        app_ref_vector m_vars;
+        expr_ref       m_result;
+        app_ref_vector m_rest;
+        bool           m_reduce_all_selects;
+        bool           m_dont_sub;
+        projection(ast_manager& m): m_vars(m), m_result(m), m_rest(m) {}
+    };
+    static const unsigned           max_projections_per_fml = 4;
+    static const unsigned           max_projections = 2000;
+    scoped_ptr_vector<projection>   m_projections;
+    obj_map<expr, unsigned_vector>  m_fml2projections;
+    expr_ref_vector                 m_projected_fmls;
+
+    static void sort_vars(app_ref_vector& vars) {
+        std::sort(vars.data(), vars.data() + vars.size(), [](app* a, app* b) { return a->get_id() < b->get_id(); });
+    }
+
+    bool find_projection(app_ref_vector& vars, model& mdl, expr_ref& fml) {
+        auto* e = m_fml2projections.find_core(fml);
+        if (!e)
+            return false;
+        app_ref_vector key(vars);
+        sort_vars(key);
+        model_evaluator eval(mdl);
+        eval.set_model_completion(false);
+        for (unsigned idx : e->get_data().m_value) {
+            projection const& p = *m_projections[idx];
+            if (p.m_reduce_all_selects != m_reduce_all_selects || p.m_dont_sub != m_dont_sub)
+                continue;
+            if (p.m_vars.size() != key.size())
+                continue;
+            bool same = true;
+            for (unsigned i = 0; same && i < key.size(); ++i)
+                same = p.m_vars.get(i) == key.get(i);
+            if (!same || !m.is_true(eval(p.m_result)))
+                continue;
+            TRACE("qe", tout << "reuse projection: " << p.m_result << "\n";);
+            fml = p.m_result;
+            vars.reset();
+            vars.append(p.m_rest);
+            return true;
+        }
+        return false;
+    }
+
+    void add_projection(expr* fml, app_ref_vector const& vars, expr* result, app_ref_vector const& rest) {
+        if (m_projections.size() >= max_projections) {
+            m_projections.reset();
+            m_fml2projections.reset();
+            m_projected_fmls.reset();
+        }
+        auto& idxs = m_fml2projections.insert_if_not_there(fml, unsigned_vector());
+        if (idxs.empty())
+            m_projected_fmls.push_back(fml);
+        projection* p = alloc(projection, m);
+        p->m_vars.append(vars);
+        sort_vars(p->m_vars);
+        p->m_result = result;
+        p->m_rest.append(rest);
+        p->m_reduce_all_selects = m_reduce_all_selects;
+        p->m_dont_sub = m_dont_sub;
+        if (idxs.size() < max_projections_per_fml) {
+            idxs.push_back(m_projections.size());
+            m_projections.push_back(p);
+        }
+        else {
+            // replace the oldest projection of fml.
+            unsigned idx = idxs[0];
+            idxs.erase(idxs.begin());
+            idxs.push_back(idx);
+            m_projections.set(idx, p);
+        }
+    }
+
     void add_plugin(mbp::project_plugin* p) {
         family_id fid = p->get_family_id();
         SASSERT(!m_plugins.get(fid, nullptr));
@@ -238,7 +319,7 @@ public:
         proj.extract_literals(model, vars, fmls);
     }
 
-    impl(ast_manager& m, params_ref const& p) :m(m), m_params(p), m_rw(m) {
+    impl(ast_manager& m, params_ref const& p) :m(m), m_params(p), m_rw(m), m_projected_fmls(m) {
         add_plugin(alloc(mbp::arith_project_plugin, m));
         add_plugin(alloc(mbp::datatype_project_plugin, m));
         add_plugin(alloc(mbp::array_project_plugin, m));
@@ -351,6 +432,16 @@ public:
     }
 
     void spacer(app_ref_vector& vars, model& mdl, expr_ref& fml) {
+        if (find_projection(vars, mdl, fml))
+            return;
+        expr_ref fml0(fml);
+        app_ref_vector vars0(vars);
+        spacer_core(vars, mdl, fml);
+        if (m.limit().inc())
+            add_projection(fml0, vars0, fml, vars);
+    }
+
+    void spacer_core(app_ref_vector& vars, model& mdl, expr_ref& fml) {
         TRACE("qe", tout << "Before projection:\n" << fml << "\n" << "Vars: " << vars << "\n";);
 
         model_evaluator eval(mdl, m_params);
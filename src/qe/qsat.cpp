@@ -39,6 +39,12 @@ Notes:
 #include "qe/qe_mbp.h"
 #include "qe/qe.h"
 #include "ast/rewriter/label_rewriter.h"
+#include "ast/ast_translation.h"
+#include "util/scoped_ptr_vector.h"
+#include "util/thread_pool.h"
+#ifndef SINGLE_THREAD
+#include <mutex>
+#endif
 
 namespace qe {
 
@@ -558,6 +564,10 @@ namespace qe {
         solver& s() { return *m_solver; }
         solver const& s() const { return *m_solver; }
 
+        void set_seed(unsigned seed) {
+            m_params.set_uint("random_seed", seed);
+        }
+
         void init() {
             m_solver = mk_smt_solver(m, m_params, symbol::null);
         }
@@ -598,6 +608,7 @@ namespace qe {
         
         struct stats {
             unsigned m_num_rounds;        
+            unsigned m_num_imported;
             stats() { reset(); }
             void reset() { memset(this, 0, sizeof(*this)); }
         };        
@@ -624,6 +635,26 @@ namespace qe {
         model_ref                  m_model_save;
         expr_ref                   m_gt;
         opt::inf_eps               m_value_save;
+        unsigned                   m_num_threads;
+        model_converter_ref        m_par_mc;       // model converter of the winning worker
+
+#ifndef SINGLE_THREAD
+        /**
+           \brief Blocking clauses of the existential player at level 0.
+           They are valid for every worker as the workers share the
+           prefix and the constants of the hoisted formula.
+        */
+        struct shared_clauses {
+            ast_manager      m;
+            std::mutex       m_mux;
+            expr_ref_vector  m_clauses;
+            unsigned_vector  m_owner;
+            shared_clauses(ast_manager& src): m(src, true), m_clauses(m) {}
+        };
+        shared_clauses*            m_shared { nullptr };
+        unsigned                   m_shared_head { 0 };
+        unsigned                   m_worker_id { 0 };
+#endif
 
         
         /**
@@ -635,6 +666,7 @@ namespace qe {
                 ++m_stats.m_num_rounds;
                 IF_VERBOSE(3, verbose_stream() << "(check-qsat level: " << m_level << " round: " << m_stats.m_num_rounds << ")\n";);
                 check_cancel();
+                import_clauses();
                 expr_ref_vector asms(m_asms);
                 m_pred_abs.get_assumptions(m_model.get(), asms);
                 if (m_model.get()) {
@@ -966,6 +998,8 @@ namespace qe {
                 add_assumption(fml);
             }
             else {
+                if (m_level == 0)
+                    share_clause(fml);
                 fml = m_pred_abs.mk_abstract(fml);
                 get_kernel(m_level).assert_expr(fml);
             }
@@ -973,6 +1007,138 @@ namespace qe {
             return true;
         }
         
+        void share_clause(expr* fml) {
+#ifndef SINGLE_THREAD
+            if (!m_shared || !m_avars.empty())
+                return;
+            std::lock_guard<std::mutex> lock(m_shared->m_mux);
+            ast_translation tr(m, m_shared->m);
+            m_shared->m_clauses.push_back(tr(fml));
+            m_shared->m_owner.push_back(m_worker_id);
+#endif
+        }
+
+        void import_clauses() {
+#ifndef SINGLE_THREAD
+            if (!m_shared)
+                return;
+            expr_ref_vector fmls(m);
+            {
+                std::lock_guard<std::mutex> lock(m_shared->m_mux);
+                ast_translation tr(m_shared->m, m);
+                for (; m_shared_head < m_shared->m_clauses.size(); ++m_shared_head)
+                    if (m_shared->m_owner[m_shared_head] != m_worker_id)
+                        fmls.push_back(tr(m_shared->m_clauses.get(m_shared_head)));
+            }
+            for (expr* fml : fmls) {
+                max_level level;
+                expr_ref_vector defs(m);
+                m_pred_abs.abstract_atoms(fml, level, defs);
+                m_ex.assert_expr(mk_and(defs));
+                m_fa.assert_expr(mk_and(defs));
+                m_ex.assert_expr(m_pred_abs.mk_abstract(fml));
+                ++m_stats.m_num_imported;
+            }
+#endif
+        }
+
+        /**
+           \brief Solve the hoisted formula fml with prefix vars on a worker.
+           The variables are hidden by the model converter of the main
+           instance, which also did the hoisting.
+        */
+        lbool check_hoisted(vector<app_ref_vector> const& vars, expr* _fml) {
+            expr_ref fml(_fml, m);
+            expr_ref_vector defs(m);
+            reset();
+            m_vars.append(vars);
+            initialize_levels();
+            m_pred_abs.abstract_atoms(fml, defs);
+            fml = m_pred_abs.mk_abstract(fml);
+            m_ex.assert_expr(mk_and(defs));
+            m_fa.assert_expr(mk_and(defs));
+            m_ex.assert_expr(fml);
+            m_fa.assert_expr(m.mk_not(fml));
+            return check_sat();
+        }
+
+        /**
+           \brief Run workers with different random seeds on copies of the
+           hoisted formula. They exchange the blocking clauses of the
+           existential player. The first worker that decides the formula
+           cancels the others.
+        */
+        lbool check_par(expr* fml) {
+#ifdef SINGLE_THREAD
+            return l_undef;
+#else
+            unsigned n = m_num_threads;
+            shared_clauses shared(m);
+            scoped_ptr_vector<ast_manager> managers;
+            scoped_ptr_vector<qsat> workers;
+            vector<vector<app_ref_vector>> vars;
+            vector<expr_ref> fmls;
+            for (unsigned j = 0; j < n; ++j) {
+                ast_manager* wm = alloc(ast_manager, m, true);
+                managers.push_back(wm);
+                ast_translation tr(m, *wm);
+                qsat* w = alloc(qsat, *wm, m_params, qsat_sat);
+                workers.push_back(w);
+                w->m_shared = &shared;
+                w->m_worker_id = j;
+                w->m_fa.set_seed(j);
+                w->m_ex.set_seed(j);
+                vars.push_back(vector<app_ref_vector>());
+                for (app_ref_vector const& vs : m_vars) {
+                    app_ref_vector wvs(*wm);
+                    for (app* v : vs)
+                        wvs.push_back(tr(v));
+                    vars.back().push_back(wvs);
+                }
+                fmls.push_back(expr_ref(tr(fml), *wm));
+            }
+            scoped_limits sl(m.limit());
+            for (ast_manager* wm : managers)
+                sl.push_child(&(wm->limit()));
+            std::mutex mux;
+            unsigned winner = UINT_MAX;
+            lbool result = l_undef;
+            thread_pool threads;
+            for (unsigned j = 0; j < n; ++j) {
+                threads.run([&, j]() {
+                    lbool r = l_undef;
+                    try {
+                        r = workers[j]->check_hoisted(vars[j], fmls[j]);
+                    }
+                    catch (z3_exception& ex) {
+                        IF_VERBOSE(2, verbose_stream() << "(qsat worker " << j << " " << ex.msg() << ")\n";);
+                    }
+                    if (r == l_undef)
+                        return;
+                    std::lock_guard<std::mutex> lock(mux);
+                    if (winner != UINT_MAX)
+                        return;
+                    winner = j;
+                    result = r;
+                    for (unsigned i = 0; i < n; ++i)
+                        if (i != j)
+                            managers[i]->limit().cancel();
+                });
+            }
+            threads.join();
+            for (qsat* w : workers)
+                w->collect_statistics(m_st);
+            if (result == l_true) {
+                qsat& w = *workers[winner];
+                ast_translation tr(*managers[winner], m);
+                m_model_save = w.m_model_save->translate(tr);
+                model_converter_ref mc = model2model_converter(m_model_save.get());
+                m_par_mc = concat(w.m_pred_abs.fmc()->translate(tr), mc.get());
+            }
+            return result;
+#endif
+        }
+
         void get_vars(unsigned level) {
             m_avars.reset();
             for (unsigned i = level; i < m_vars.size(); ++i) {
@@ -1250,7 +1416,8 @@ namespace qe {
             m_objective(nullptr),
             m_value(nullptr),
             m_was_sat(false),
-            m_gt(m)
+            m_gt(m),
+            m_num_threads(p.get_uint("qsat_threads", 1))
         {
         }
         
@@ -1259,9 +1426,11 @@ namespace qe {
         }
         
         void updt_params(params_ref const & p) override {
+            m_num_threads = p.get_uint("qsat_threads", m_num_threads);
         }
         
         void collect_param_descrs(param_descrs & r) override {
+            r.insert("qsat_threads", CPK_UINT, "(default: 1) number of workers that share blocking clauses when deciding quantified formulas");
         }
         
         void operator()(/* in */  goal_ref const & in, 
@@ -1299,14 +1468,21 @@ namespace qe {
             if (!is_ground(fml)) {
                 throw tactic_exception("formula is not hoistable");
             }
-            m_pred_abs.abstract_atoms(fml, defs);
-            fml = m_pred_abs.mk_abstract(fml);
-            m_ex.assert_expr(mk_and(defs));
-            m_fa.assert_expr(mk_and(defs));
-            m_ex.assert_expr(fml);
-            m_fa.assert_expr(m.mk_not(fml));
-            TRACE("qe", tout << "ex: " << fml << "\n";);
-            lbool is_sat = check_sat();
+            lbool is_sat;
+            m_par_mc = nullptr;
+            if (m_mode == qsat_sat && m_num_threads > 1) {
+                is_sat = check_par(fml);
+            }
+            else {
+                m_pred_abs.abstract_atoms(fml, defs);
+                fml = m_pred_abs.mk_abstract(fml);
+                m_ex.assert_expr(mk_and(defs));
+                m_fa.assert_expr(mk_and(defs));
+                m_ex.assert_expr(fml);
+                m_fa.assert_expr(m.mk_not(fml));
+                TRACE("qe", tout << "ex: " << fml << "\n";);
+                is_sat = check_sat();
+            }
             switch (is_sat) {
             case l_false:
                 in->reset();
@@ -1327,7 +1503,7 @@ namespace qe {
                 result.push_back(in.get());
                 if (in->models_enabled()) {                    
                     model_converter_ref mc;
-                    mc = model2model_converter(m_model_save.get());
+                    mc = m_par_mc ? m_par_mc : model2model_converter(m_model_save.get());
                     mc = concat(m_pred_abs.fmc(), mc.get());
                     in->add(mc.get());
                 }
@@ -1348,6 +1524,7 @@ namespace qe {
             m_ex.collect_statistics(st);        
             m_pred_abs.collect_statistics(st);
             st.update("qsat num rounds", m_stats.m_num_rounds); 
+            st.update("qsat num imported clauses", m_stats.m_num_imported);
             m_pred_abs.collect_statistics(st);
         }
         
@@ -1368,7 +1545,9 @@ namespace qe {
         }
         
         tactic * translate(ast_manager & m) override {
-            return alloc(qsat, m, m_params, m_mode);
+            qsat* result = alloc(qsat, m, m_params, m_mode);
+            result->m_num_threads = m_num_threads;
+            return result;
         }        
 
         lbool maximize(expr_ref_vector const& fmls, app* t, model_ref& mdl, opt::inf_eps& value) {
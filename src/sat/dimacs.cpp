@@ -113,8 +113,8 @@ static void read_clause(Buffer & in, std::ostream& err, sat::literal_vector & li
 }
 
 template<typename Buffer>
-static bool parse_dimacs_core(Buffer & in, std::ostream& err, sat::solver & solver) {
-    sat::literal_vector lits;
+static bool parse_dimacs_core(Buffer & in, std::ostream& err, sat::solver & solver, vector<sat::literal_vector>* cubes) {
+    sat::literal_vector lits, clauses;
     try {
         while (true) {
             skip_whitespace(in);
@@ -124,22 +124,34 @@ static bool parse_dimacs_core(Buffer & in, std::ostream& err, sat::solver & solv
             else if (*in == 'c' || *in == 'p') {
                 skip_line(in);
             }
+            else if (*in == 'a' && cubes) {
+                ++in;
+                read_clause(in, err, solver, lits);
+                cubes->push_back(lits);
+            }
             else {
                 read_clause(in, err, solver, lits);
-                solver.mk_clause(lits.size(), lits.data());
+                clauses.append(lits);
+                clauses.push_back(sat::null_literal);
             }
         }
     }
     catch (dimacs::lex_error) {
         return false;
     }
+    solver.mk_clauses(clauses.size(), clauses.data());
     return true;
 }
 
 
 bool parse_dimacs(std::istream & in, std::ostream& err, sat::solver & solver) {
     dimacs::stream_buffer _in(in);
-    return parse_dimacs_core(_in, err, solver);
+    return parse_dimacs_core(_in, err, solver, nullptr);
+}
+
+bool parse_icnf(std::istream & in, std::ostream& err, sat::solver & solver, vector<sat::literal_vector>& cubes) {
+    dimacs::stream_buffer _in(in);
+    return parse_dimacs_core(_in, err, solver, &cubes);
 }
 
 
@@ -25,19 +25,47 @@ Revision History:
 
 bool parse_dimacs(std::istream & s, std::ostream& err, sat::solver & solver);
 
+/**
+   \brief parse a problem in incremental DIMACS format.
+   The clauses are added to solver, the assumption lines "a l1 ... ln 0" are added to cubes.
+*/
+bool parse_icnf(std::istream & s, std::ostream& err, sat::solver & solver, vector<sat::literal_vector>& cubes);
+
 namespace dimacs {
     struct lex_error {};
 
     class stream_buffer {
+        static const size_t BUFFER_SIZE = 1 << 16;
         std::istream & m_stream;
+        char           m_buffer[BUFFER_SIZE]; // input is read in blocks instead of per character
+        char const *   m_pos;
+        char const *   m_end;
         int            m_val;
         unsigned       m_line;
+
+        bool fill() {
+            if (!m_stream.read(m_buffer, BUFFER_SIZE) && m_stream.gcount() == 0)
+                return false;
+            m_pos = m_buffer;
+            m_end = m_buffer + m_stream.gcount();
+            return true;
+        }
+
+        void next() {
+            if (m_pos == m_end && !fill())
+                m_val = EOF;
+            else
+                m_val = static_cast<unsigned char>(*m_pos++);
+        }
+
     public:
         
-    stream_buffer(std::istream & s):
-        m_stream(s),
+        stream_buffer(std::istream & s):
+            m_stream(s),
+            m_pos(m_buffer),
+            m_end(m_buffer),
             m_line(0) {
-            m_val = m_stream.get();
+            next();
         }
         
         int  operator *() const { 
@@ -45,7 +73,7 @@ namespace dimacs {
         }
         
         void operator ++() { 
-            m_val = m_stream.get();
+            next();
             if (m_val == '\n') ++m_line;
         }
         
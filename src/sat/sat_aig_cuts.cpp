@@ -16,25 +16,40 @@
   --*/
 
 #include "util/trace.h"
+#include "util/scoped_ptr_vector.h"
+#ifndef SINGLE_THREAD
+#include <mutex>
+#include "util/thread_pool.h"
+#endif
 #include "sat/sat_aig_cuts.h"
 #include "sat/sat_solver.h"
 #include "sat/sat_lut_finder.h"
 
 namespace sat {
         
-    aig_cuts::aig_cuts() {
-        m_cut_set1.init(m_region, m_config.m_max_cutset_size + 1, UINT_MAX);
-        m_cut_set2.init(m_region, m_config.m_max_cutset_size + 1, UINT_MAX);
+    aig_cuts::aig_cuts(): m_scratch(m_config.m_max_cutset_size + 1) {
         m_empty_cuts.init(m_region, m_config.m_max_cutset_size + 1, UINT_MAX);
         m_num_cut_calls = 0;
         m_num_cuts = 0;
     }
 
+    aig_cuts::scratch::scratch(unsigned max_sz, unsigned seed): m_rand(seed) {
+        m_cut_set1.init(m_region, max_sz, UINT_MAX);
+        m_cut_set2.init(m_region, max_sz, UINT_MAX);
+    }
+
     vector<cut_set> const& aig_cuts::operator()() {
         if (m_config.m_full) flush_roots();
         unsigned_vector node_ids = filter_valid_nodes();
         TRACE("cut_simplifier", display(tout););
-        augment(node_ids);
+#ifndef SINGLE_THREAD
+        if (m_config.m_num_threads > 1 && !m_on_cut_add && !m_on_cut_del)
+            augment_parallel(node_ids);
+        else
+#endif
+            augment(node_ids);
+        m_num_cuts += m_scratch.m_num_cuts;
+        m_scratch.m_num_cuts = 0;
         TRACE("cut_simplifier", display(tout););
         ++m_num_cut_calls;
         return m_cuts;
@@ -47,7 +62,8 @@ namespace sat {
             }
             IF_VERBOSE(20, m_cuts[id].display(verbose_stream() << "augment " << id << "\nbefore\n"));
             for (node const& n : m_aig[id]) {
-                augment(id, n);
+                if (is_touched(id, n) && augment(m_scratch, id, n, m_cuts[id])) 
+                    touch(id);
             }
 
 #if 0
@@ -59,90 +75,198 @@ namespace sat {
             }
             for (cut const& c : m_cut_save) {
                 lut lut(*this, c);
-                augment_lut(id, lut, cs);
+                augment_lut(m_scratch, id, lut, cs);
             }
 #endif
             IF_VERBOSE(20, m_cuts[id].display(verbose_stream() << "after\n"));            
         }
     }
 
-    void aig_cuts::augment(unsigned id, node const& n) {
-        unsigned nc = n.size();
-        m_insertions = 0;
-        cut_set& cs = m_cuts[id];
-        if (!is_touched(id, n)) {
-            // no-op
+    /**
+       \brief partition ids into levels such that the fan-ins of a node are on lower levels.
+       Fan-ins that close a cycle are ignored.
+     */
+    void aig_cuts::ids2levels(unsigned_vector const& ids, vector<unsigned_vector>& levels) const {
+        unsigned_vector level(m_aig.size(), UINT_MAX);
+        unsigned_vector todo;
+        for (unsigned id : ids) {
+            todo.push_back(id);
+            while (!todo.empty()) {
+                unsigned v = todo.back();
+                if (level[v] < UINT_MAX - 1) {
+                    todo.pop_back();
+                    continue;
+                }
+                level[v] = UINT_MAX - 1;
+                unsigned sz = todo.size();
+                unsigned lvl = 0;
+                for (node const& n : m_aig[v]) {
+                    if (n.is_var()) 
+                        continue;
+                    for (unsigned i = 0; i < n.size(); ++i) {
+                        unsigned w = child(n, i).var();
+                        if (w >= m_aig.size() || m_aig[w].empty()) 
+                            continue;
+                        if (level[w] == UINT_MAX) 
+                            todo.push_back(w);
+                        else if (level[w] != UINT_MAX - 1) 
+                            lvl = std::max(lvl, level[w] + 1);
+                    }
+                }
+                if (todo.size() > sz) 
+                    continue;
+                todo.pop_back();
+                level[v] = lvl;
+                levels.reserve(lvl + 1);
+                levels[lvl].push_back(v);
+            }
         }
-        else if (n.is_var()) {
+    }
+
+#ifndef SINGLE_THREAD
+    /**
+       \brief augment the nodes of each level concurrently.
+       The fan-ins of a level are on lower levels, so the cut sets they read
+       are not updated while the level is processed. Each worker has its own
+       scratch state and enumerates the cuts of a node into a copy of its cut set.
+       The copies are written back after the workers of the level are done.
+       Cut callbacks are not invoked concurrently, so they must be unset.
+     */
+    void aig_cuts::augment_parallel(unsigned_vector const& ids) {
+        vector<unsigned_vector> levels;
+        ids2levels(ids, levels);
+        unsigned num_threads = m_config.m_num_threads;
+        scoped_ptr_vector<scratch> workers;
+        for (unsigned i = 0; i < num_threads; ++i)
+            workers.push_back(alloc(scratch, m_config.m_max_cutset_size + 1, i + 1));
+        vector<cut_set> cuts;
+        bool_vector touched;
+        std::mutex mux;
+        std::string ex_msg;
+        bool has_exception = false;
+        for (unsigned_vector const& lvl : levels) {
+            if (lvl.size() < 2 * num_threads) {
+                augment(lvl);
+                continue;
+            }
+            cuts.reset();
+            cuts.resize(lvl.size());
+            touched.reset();
+            touched.resize(lvl.size(), false);
+            auto worker = [&](unsigned w) {
+                scratch& sc = *workers[w];
+                try {
+                    for (unsigned i = w; i < lvl.size(); i += num_threads) {
+                        unsigned id = lvl[i];
+                        cut_set& cs = cuts[i];
+                        cs.init(sc.m_out, m_config.m_max_cutset_size + 1, UINT_MAX);
+                        for (cut const& c : m_cuts[id])
+                            cs.push_back(m_on_cut_add, c);
+                        for (node const& n : m_aig[id]) 
+                            if ((touched[i] || is_touched(id, n)) && augment(sc, id, n, cs))
+                                touched[i] = true;
+                    }
+                }
+                catch (z3_exception& ex) {
+                    std::lock_guard<std::mutex> lock(mux);
+                    ex_msg = ex.msg();
+                    has_exception = true;
+                }
+            };
+            thread_pool threads;
+            for (unsigned w = 0; w < num_threads; ++w)
+                threads.run([&, w]() { worker(w); });
+            threads.join();
+            if (has_exception)
+                throw default_exception(std::move(ex_msg));
+            for (unsigned i = 0; i < lvl.size(); ++i) {
+                unsigned id = lvl[i];
+                cut_set& cs = m_cuts[id];
+                reset(cs);
+                for (cut const& c : cuts[i]) 
+                    push_back(cs, c);
+                if (touched[i])
+                    touch(id);
+            }
+            for (scratch* sc : workers)
+                sc->m_out.reset();
+        }
+        for (scratch* sc : workers)
+            m_num_cuts += sc->m_num_cuts;
+    }
+#endif
+
+    bool aig_cuts::augment(scratch& sc, unsigned id, node const& n, cut_set& cs) {
+        unsigned nc = n.size();
+        sc.m_insertions = 0;
+        if (n.is_var()) {
             SASSERT(!n.sign());
         }
         else if (n.is_lut()) {
             lut lut(*this, n);
-            augment_lut(id, lut, cs);
+            augment_lut(sc, id, lut, cs);
         }
         else if (n.is_ite()) {
-            augment_ite(id, n, cs);
+            augment_ite(sc, id, n, cs);
         }
         else if (nc == 0) { 
-            augment_aig0(id, n, cs);
+            augment_aig0(sc, id, n, cs);
         }
         else if (nc == 1) {
-            augment_aig1(id, n, cs);
+            augment_aig1(sc, id, n, cs);
         }
         else if (nc == 2) {
-            augment_aig2(id, n, cs);
+            augment_aig2(sc, id, n, cs);
         }
         else if (nc <= cut::max_cut_size()) {
-            augment_aigN(id, n, cs);
-        }
-        if (m_insertions > 0) {
-            touch(id);
+            augment_aigN(sc, id, n, cs);
         }
+        return sc.m_insertions > 0;
     }
 
-    bool aig_cuts::insert_cut(unsigned v, cut const& c, cut_set& cs) {
+    bool aig_cuts::insert_cut(scratch& sc, unsigned v, cut const& c, cut_set& cs) {
         if (!cs.insert(m_on_cut_add, m_on_cut_del, c)) {
             return true;
         }
-        m_num_cuts++;
-        if (++m_insertions > max_cutset_size(v)) {
+        sc.m_num_cuts++;
+        if (++sc.m_insertions > max_cutset_size(v)) {
             return false;
         }
         while (cs.size() >= max_cutset_size(v)) {
             // never evict the first entry, it is used for the starting point
-            unsigned idx = 1 + (m_rand() % (cs.size() - 1));
+            unsigned idx = 1 + (sc.m_rand() % (cs.size() - 1));
             evict(cs, idx);
         }
         return true;
     }
 
-    void aig_cuts::augment_lut(unsigned v, lut const& n, cut_set& cs) {
+    void aig_cuts::augment_lut(scratch& sc, unsigned v, lut const& n, cut_set& cs) {
         IF_VERBOSE(4, n.display(verbose_stream() << "augment_lut " << v << " ") << "\n");
         literal l1 = n.child(0);
         VERIFY(&cs != &lit2cuts(l1));
         for (auto const& a : lit2cuts(l1)) {
-            m_tables[0] = &a;
-            m_lits[0] = l1;
+            sc.m_tables[0] = &a;
+            sc.m_lits[0] = l1;
             cut b(a);
-            augment_lut_rec(v, n, b, 1, cs);                        
+            augment_lut_rec(sc, v, n, b, 1, cs);                        
         }
     }
 
-    void aig_cuts::augment_lut_rec(unsigned v, lut const& n, cut& a, unsigned idx, cut_set& cs) {
+    void aig_cuts::augment_lut_rec(scratch& sc, unsigned v, lut const& n, cut& a, unsigned idx, cut_set& cs) {
         if (idx < n.size()) {
             literal lit = n.child(idx); 
             VERIFY(&cs != &lit2cuts(lit));
             for (auto const& b : lit2cuts(lit)) {
                 cut ab;
                 if (!ab.merge(a, b)) continue;
-                m_tables[idx] = &b;
-                m_lits[idx] = lit;
-                augment_lut_rec(v, n, ab, idx + 1, cs);                
+                sc.m_tables[idx] = &b;
+                sc.m_lits[idx] = lit;
+                augment_lut_rec(sc, v, n, ab, idx + 1, cs);                
             }
             return;
         }
         for (unsigned i = n.size(); i-- > 0; ) { 
-            m_luts[i] = m_tables[i]->shift_table(a);            
+            sc.m_luts[i] = sc.m_tables[i]->shift_table(a);            
         }
         uint64_t r = 0;
         SASSERT(a.size() <= 6);
@@ -154,7 +278,7 @@ namespace sat {
             // based on the j'th output bit in lut[i]
             // m_lits[i].sign() tracks if output bit is negated
             for (unsigned i = n.size(); i-- > 0; ) {
-                w |= (((m_luts[i] >> j) ^ (uint64_t)m_lits[i].sign()) & 1u) << i;
+                w |= (((sc.m_luts[i] >> j) ^ (uint64_t)sc.m_lits[i].sign()) & 1u) << i;
             }
             r |= ((n.table() >> w) & 1u) << j;
         } 
@@ -162,12 +286,12 @@ namespace sat {
         IF_VERBOSE(8,
             verbose_stream() << "lut: " << v << " - " << a << "\n";
             for (unsigned i = 0; i < n.size(); ++i) {
-                verbose_stream() << m_lits[i] << ": " << *m_tables[i] << "\n";
+                verbose_stream() << sc.m_lits[i] << ": " << *sc.m_tables[i] << "\n";
             });
-        insert_cut(v, a, cs);
+        insert_cut(sc, v, a, cs);
     }  
 
-    void aig_cuts::augment_ite(unsigned v, node const& n, cut_set& cs) {
+    void aig_cuts::augment_ite(scratch& sc, unsigned v, node const& n, cut_set& cs) {
         IF_VERBOSE(4, display(verbose_stream() << "augment_ite " << v << " ", n) << "\n");
         literal l1 = child(n, 0);
         literal l2 = child(n, 1);
@@ -190,13 +314,13 @@ namespace sat {
                     if (l3.sign()) t3 = ~t3;
                     abc.set_table((t1 & t2) | ((~t1) & t3));
                     if (n.sign()) abc.negate();
-                    if (!insert_cut(v, abc, cs)) return;
+                    if (!insert_cut(sc, v, abc, cs)) return;
                 } 
             }
         }
     }
 
-    void aig_cuts::augment_aig0(unsigned v, node const& n, cut_set& cs) {
+    void aig_cuts::augment_aig0(scratch& sc, unsigned v, node const& n, cut_set& cs) {
         IF_VERBOSE(4, display(verbose_stream() << "augment_unit " << v << " ", n) << "\n");
         SASSERT(n.is_and() && n.size() == 0);
         reset(cs);
@@ -205,7 +329,7 @@ namespace sat {
         push_back(cs, c);
     }
 
-    void aig_cuts::augment_aig1(unsigned v, node const& n, cut_set& cs) {
+    void aig_cuts::augment_aig1(scratch& sc, unsigned v, node const& n, cut_set& cs) {
         IF_VERBOSE(4, display(verbose_stream() << "augment_aig1 " << v << " ", n) << "\n");
         SASSERT(n.is_and());
         literal lit = child(n, 0);
@@ -213,11 +337,11 @@ namespace sat {
         for (auto const& a : lit2cuts(lit)) {
             cut c(a);
             if (n.sign()) c.negate();
-            if (!insert_cut(v, c, cs)) return;             
+            if (!insert_cut(sc, v, c, cs)) return;             
         }
     }
 
-    void aig_cuts::augment_aig2(unsigned v, node const& n, cut_set& cs) {
+    void aig_cuts::augment_aig2(scratch& sc, unsigned v, node const& n, cut_set& cs) {
         IF_VERBOSE(4, display(verbose_stream() << "augment_aig2 " << v << " ", n) << "\n");
         SASSERT(n.is_and() || n.is_xor());
         literal l1 = child(n, 0);
@@ -236,14 +360,14 @@ namespace sat {
                 c.set_table(t3);
                 if (n.sign()) c.negate();
                 // validate_aig2(a, b, v, n, c); 
-                if (!insert_cut(v, c, cs)) return;                
+                if (!insert_cut(sc, v, c, cs)) return;                
             }
         }
     }
 
-    void aig_cuts::augment_aigN(unsigned v, node const& n, cut_set& cs) {
+    void aig_cuts::augment_aigN(scratch& sc, unsigned v, node const& n, cut_set& cs) {
         IF_VERBOSE(4, display(verbose_stream() << "augment_aigN " << v << " ", n) << "\n");
-        m_cut_set1.reset(m_on_cut_del);
+        sc.m_cut_set1.reset(m_on_cut_del);
         SASSERT(n.is_and() || n.is_xor());
         literal lit = child(n, 0);
         for (auto const& a : lit2cuts(lit)) {
@@ -251,13 +375,13 @@ namespace sat {
             if (lit.sign()) {
                 b.negate();
             }            
-            m_cut_set1.push_back(m_on_cut_add, b);
+            sc.m_cut_set1.push_back(m_on_cut_add, b);
         }
         for (unsigned i = 1; i < n.size(); ++i) {
-            m_cut_set2.reset(m_on_cut_del);
+            sc.m_cut_set2.reset(m_on_cut_del);
             lit = child(n, i);
-            m_insertions = 0;
-            for (auto const& a : m_cut_set1) {
+            sc.m_insertions = 0;
+            for (auto const& a : sc.m_cut_set1) {
                 for (auto const& b : lit2cuts(lit)) {
                     cut c;
                     if (!c.merge(a, b)) continue;
@@ -267,16 +391,16 @@ namespace sat {
                     uint64_t t3 = n.is_and() ? (t1 & t2) : (t1 ^ t2);
                     c.set_table(t3);
                     if (i + 1 == n.size() && n.sign()) c.negate();
-                    if (!insert_cut(UINT_MAX, c, m_cut_set2)) goto next_child;                    
+                    if (!insert_cut(sc, UINT_MAX, c, sc.m_cut_set2)) goto next_child;                    
                 }
             }
         next_child:
-            m_cut_set1.swap(m_cut_set2);
+            sc.m_cut_set1.swap(sc.m_cut_set2);
         }
-        m_insertions = 0;
-        for (auto & cut : m_cut_set1) {
+        sc.m_insertions = 0;
+        for (auto & cut : sc.m_cut_set1) {
             // validate_aigN(v, n, cut);
-            if (!insert_cut(v, cut, cs)) {
+            if (!insert_cut(sc, v, cut, cs)) {
                 break;
             }
         }        
@@ -321,7 +445,7 @@ namespace sat {
             on_node_add(v, n);            
             init_cut_set(v);
             if (n.is_const()) {
-                augment_aig0(v, n, m_cuts[v]);
+                augment_aig0(m_scratch, v, n, m_cuts[v]);
             }
             touch(v);
             IF_VERBOSE(12, display(verbose_stream() << "add " << v << " == ", n) << "\n");            
@@ -367,7 +491,7 @@ namespace sat {
         cut c;
         for (bool_var w : args) VERIFY(c.add(w));
         c.set_table(lut);
-        insert_cut(v, c, m_cuts[v]);
+        insert_cut(m_scratch, v, c, m_cuts[v]);
     }
 
 
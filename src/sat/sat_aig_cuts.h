@@ -63,7 +63,8 @@ namespace sat {
             unsigned m_max_aux;
             unsigned m_max_insertions;
             bool     m_full;
-        config(): m_max_cutset_size(20), m_max_aux(5), m_max_insertions(20), m_full(true) {}
+            unsigned m_num_threads;
+        config(): m_max_cutset_size(20), m_max_aux(5), m_max_insertions(20), m_full(true), m_num_threads(1) {}
         };
     private:
 
@@ -97,25 +98,36 @@ namespace sat {
             unsigned offset() const { return m_offset; }
             uint64_t lut() const { return m_lut; }
         };
+        // state used while enumerating the cuts of a node, one per thread.
+        struct scratch {
+            region            m_region;
+            region            m_out;
+            cut_set           m_cut_set1, m_cut_set2;
+            random_gen        m_rand;
+            unsigned          m_insertions { 0 };
+            unsigned          m_num_cuts { 0 };
+            cut const*        m_tables[6];
+            uint64_t          m_luts[6];
+            literal           m_lits[6];
+            scratch(unsigned max_sz, unsigned seed = 0);
+        };
+
         random_gen            m_rand;
         config                m_config;
+        scratch               m_scratch;
         vector<svector<node>> m_aig;    
         literal_vector        m_literals;
         region                m_region;
-        cut_set               m_cut_set1, m_cut_set2, m_empty_cuts;
+        cut_set               m_empty_cuts;
         vector<cut_set>       m_cuts;
         unsigned_vector       m_max_cutset_size;
         unsigned_vector       m_last_touched;
         unsigned              m_num_cut_calls;
         unsigned              m_num_cuts;
         svector<std::pair<bool_var, literal>> m_roots;
-        unsigned              m_insertions;
         on_clause_t           m_on_clause_add, m_on_clause_del;
         cut_set::on_update_t  m_on_cut_add, m_on_cut_del;
         literal_vector        m_clause;
-        cut const*            m_tables[6];
-        uint64_t              m_luts[6];
-        literal               m_lits[6];
 
         class to_root {
             literal_vector m_to_root;
@@ -159,20 +171,22 @@ namespace sat {
 
         unsigned_vector filter_valid_nodes() const;
         void augment(unsigned_vector const& ids);
-        void augment(unsigned id, node const& n);
-        void augment_ite(unsigned v,  node const& n, cut_set& cs);
-        void augment_aig0(unsigned v, node const& n, cut_set& cs);
-        void augment_aig1(unsigned v, node const& n, cut_set& cs);
-        void augment_aig2(unsigned v, node const& n, cut_set& cs);
-        void augment_aigN(unsigned v, node const& n, cut_set& cs);
+        void augment_parallel(unsigned_vector const& ids);
+        void ids2levels(unsigned_vector const& ids, vector<unsigned_vector>& levels) const;
+        bool augment(scratch& sc, unsigned id, node const& n, cut_set& cs);
+        void augment_ite(scratch& sc, unsigned v,  node const& n, cut_set& cs);
+        void augment_aig0(scratch& sc, unsigned v, node const& n, cut_set& cs);
+        void augment_aig1(scratch& sc, unsigned v, node const& n, cut_set& cs);
+        void augment_aig2(scratch& sc, unsigned v, node const& n, cut_set& cs);
+        void augment_aigN(scratch& sc, unsigned v, node const& n, cut_set& cs);
 
 
-        void augment_lut(unsigned v,  lut const& n, cut_set& cs);        
-        void augment_lut_rec(unsigned v, lut const& n, cut& a, unsigned idx, cut_set& cs);
+        void augment_lut(scratch& sc, unsigned v,  lut const& n, cut_set& cs);        
+        void augment_lut_rec(scratch& sc, unsigned v, lut const& n, cut& a, unsigned idx, cut_set& cs);
 
         cut_set const& lit2cuts(literal lit) const { return lit.var() < m_cuts.size() ? m_cuts[lit.var()] : m_empty_cuts; }
 
-        bool insert_cut(unsigned v, cut const& c, cut_set& cs);
+        bool insert_cut(scratch& sc, unsigned v, cut const& c, cut_set& cs);
 
         void flush_roots();
         bool flush_roots(bool_var var, to_root const& to_root, node& n);
@@ -211,6 +225,7 @@ namespace sat {
         void add_node(bool_var head, uint64_t lut, unsigned sz, bool_var const* args);
         void add_cut(bool_var v, uint64_t lut, bool_var_vector const& args);
         void set_root(bool_var v, literal r);
+        void set_num_threads(unsigned n) { m_config.m_num_threads = n; }
 
         void set_on_clause_add(on_clause_t& on_clause_add);
         void set_on_clause_del(on_clause_t& on_clause_del);
@@ -33,6 +33,7 @@ class sat_allocator {
     };
     char const *              m_id;
     size_t                    m_alloc_size;
+    size_t                    m_large_size;   // bytes of objects allocated outside of chunks
     ptr_vector<chunk>         m_chunks;
     void *                    m_chunk_ptr;
     ptr_vector<void>          m_free[NUM_FREE];
@@ -44,18 +45,20 @@ class sat_allocator {
         return (static_cast<unsigned>(size >> PTR_ALIGNMENT) + ((0 != (size & MASK)) ? 1u : 0u));
     }
 public:
-    sat_allocator(char const * id = "unknown"): m_id(id), m_alloc_size(0), m_chunk_ptr(nullptr) {}
+    sat_allocator(char const * id = "unknown"): m_id(id), m_alloc_size(0), m_large_size(0), m_chunk_ptr(nullptr) {}
     ~sat_allocator() { reset(); }
     void reset() {
         for (chunk * ch : m_chunks) dealloc(ch);
         m_chunks.reset();
         for (unsigned i = 0; i < NUM_FREE; ++i) m_free[i].reset();
         m_alloc_size = 0;
+        m_large_size = 0;
         m_chunk_ptr = nullptr;
     }
     void * allocate(size_t size) {
         m_alloc_size += size;
         if (size >= SMALL_OBJ_SIZE) {
+            m_large_size += size;
             return memory::allocate(size);
         }
         unsigned slot_id = free_slot_id(size);
@@ -82,6 +85,7 @@ public:
     void deallocate(size_t size, void * p) {
         m_alloc_size -= size;
         if (size >= SMALL_OBJ_SIZE) {
+            m_large_size -= size;
             memory::deallocate(p);
         }
         else {
@@ -90,6 +94,18 @@ public:
     }
     size_t get_allocation_size() const { return m_alloc_size; }
 
+    /**
+       \brief fraction of the chunk memory that is not occupied by live objects.
+       It grows as objects are freed and parked on the free lists.
+    */
+    double fragmentation() const {
+        size_t reserved = m_chunks.size() * static_cast<size_t>(CHUNK_SIZE);
+        size_t live = m_alloc_size - m_large_size;
+        if (reserved == 0 || live >= reserved)
+            return 0.0;
+        return 1.0 - static_cast<double>(live) / static_cast<double>(reserved);
+    }
+
     char const* id() const { return m_id; }
 };
 
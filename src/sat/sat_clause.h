@@ -142,6 +142,7 @@ namespace sat {
         clause_allocator();
         void          finalize();
         size_t        get_allocation_size() const { return m_allocator.get_allocation_size(); }
+        double        fragmentation() const { return m_allocator.fragmentation(); }
         clause *      get_clause(clause_offset cls_off) const;
         clause_offset get_offset(clause const * ptr) const;
         clause *      mk_clause(unsigned num_lits, literal const * lits, bool learned);
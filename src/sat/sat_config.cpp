@@ -79,6 +79,7 @@ namespace sat {
         m_propagate_prefetch = p.propagate_prefetch();
         m_inprocess_max   = p.inprocess_max();
         m_inprocess_out   = p.inprocess_out();
+        m_inprocess_profile = p.inprocess_profile();
 
         m_random_freq     = p.random_freq();
         m_random_seed     = p.random_seed();
@@ -90,7 +91,9 @@ namespace sat {
         m_enable_pre_simplify  = p.enable_pre_simplify();
         
         m_max_conflicts   = p.max_conflicts();
+        m_budget          = p.budget();
         m_num_threads     = p.threads();
+        m_threads_affinity = p.threads_affinity();
         m_ddfw_search     = p.ddfw_search();
         m_ddfw_threads    = p.ddfw_threads();
         m_prob_search     = p.prob_search();
@@ -103,9 +106,15 @@ namespace sat {
         m_local_search_dbg_flips = p.local_search_dbg_flips();
         //m_binspr            = p.binspr();
         m_binspr            = false;     // prevent adventurous users from trying feature that isn't ready
+        m_vivify            = p.vivify();
+        m_vivify_glue       = p.vivify_glue();
+        m_vivify_limit      = p.vivify_limit();
         m_anf_simplify      = p.anf();
         m_anf_delay         = p.anf_delay();
         m_anf_exlin         = p.anf_exlin();
+        m_gauss_simplify    = p.gauss();
+        m_gauss_delay       = p.gauss_delay();
+        m_gauss_max_xors    = p.gauss_max_xors();
         m_cut_simplify      = p.cut();
         m_cut_delay         = p.cut_delay();
         m_cut_aig           = p.cut_aig();
@@ -115,8 +124,10 @@ namespace sat {
         m_cut_dont_cares    = p.cut_dont_cares();
         m_cut_redundancies  = p.cut_redundancies();
         m_cut_force         = p.cut_force();
+        m_cut_threads       = p.cut_threads();
         m_lookahead_simplify = p.lookahead_simplify();
         m_lookahead_double = p.lookahead_double();
+        m_lookahead_threads = p.lookahead_threads();
         m_lookahead_simplify_bca = p.lookahead_simplify_bca();
         if (p.lookahead_reward() == symbol("heule_schur")) 
             m_lookahead_reward = heule_schur_reward;
@@ -174,19 +185,25 @@ namespace sat {
             m_gc_strategy = GC_PSM;
         else if (s == symbol("psm_glue"))
             m_gc_strategy = GC_PSM_GLUE;
+        else if (s == symbol("tiered"))
+            m_gc_strategy = GC_TIERED;
         else 
             throw sat_param_exception("invalid gc strategy");
         m_gc_initial      = p.gc_initial();
         m_gc_increment    = p.gc_increment();
         m_gc_small_lbd    = p.gc_small_lbd();
         m_gc_k            = std::min(255u, p.gc_k());
+        m_gc_tier1        = p.gc_tier1();
+        m_gc_tier2        = std::max(m_gc_tier1, p.gc_tier2());
         m_gc_burst        = p.gc_burst();
         m_gc_defrag       = p.gc_defrag();
+        m_gc_defrag_ratio = p.gc_defrag_ratio();
 
         m_force_cleanup   = p.force_cleanup();
 
         m_backtrack_scopes = p.backtrack_scopes();
         m_backtrack_init_conflicts = p.backtrack_conflicts();
+        m_backtrack_reuse_trail = p.backtrack_reuse_trail();
 
         m_minimize_lemmas = p.minimize_lemmas();
         m_core_minimize   = p.core_minimize();
@@ -196,6 +213,7 @@ namespace sat {
         m_drat_file       = p.drat_file();
         m_drat            = (m_drat_check_unsat || m_drat_file.is_non_empty_string() || m_drat_check_sat) && p.threads() == 1;
         m_drat_binary     = p.drat_binary();
+        m_drat_async      = p.drat_async();
         m_drat_activity   = p.drat_activity();
         m_dyn_sub_res     = p.dyn_sub_res();
 
@@ -44,7 +44,8 @@ namespace sat {
         GC_PSM,
         GC_GLUE,
         GC_GLUE_PSM,
-        GC_PSM_GLUE
+        GC_PSM_GLUE,
+        GC_TIERED
     };
 
     enum branching_heuristic {
@@ -105,12 +106,15 @@ namespace sat {
         double             m_slow_glue_avg;
         unsigned           m_inprocess_max;
         symbol             m_inprocess_out;
+        bool               m_inprocess_profile;
         double             m_random_freq;
         unsigned           m_random_seed;
         unsigned           m_burst_search;
         bool               m_enable_pre_simplify;
         unsigned           m_max_conflicts;
+        unsigned           m_budget;
         unsigned           m_num_threads;
+        bool               m_threads_affinity;
         bool               m_ddfw_search;
         unsigned           m_ddfw_threads;
         bool               m_prob_search;
@@ -119,6 +123,9 @@ namespace sat {
         local_search_mode  m_local_search_mode;
         bool               m_local_search_dbg_flips;
         bool               m_binspr;
+        bool               m_vivify;
+        unsigned           m_vivify_glue;
+        unsigned           m_vivify_limit;
         bool               m_cut_simplify;
         unsigned           m_cut_delay;
         bool               m_cut_aig;
@@ -128,9 +135,13 @@ namespace sat {
         bool               m_cut_dont_cares;
         bool               m_cut_redundancies;
         bool               m_cut_force;
+        unsigned           m_cut_threads;
         bool               m_anf_simplify;
         unsigned           m_anf_delay;
         bool               m_anf_exlin;
+        bool               m_gauss_simplify;
+        unsigned           m_gauss_delay;
+        unsigned           m_gauss_max_xors;
         bool               m_lookahead_simplify;
         bool               m_lookahead_simplify_bca;
         cutoff_t           m_lookahead_cube_cutoff;
@@ -142,6 +153,7 @@ namespace sat {
         double             m_lookahead_cube_psat_trigger;
         reward_t           m_lookahead_reward;
         bool               m_lookahead_double;
+        unsigned           m_lookahead_threads;
         bool               m_lookahead_global_autarky;
         double             m_lookahead_delta_fraction;
         bool               m_lookahead_use_learned;
@@ -159,14 +171,18 @@ namespace sat {
         unsigned           m_gc_increment;
         unsigned           m_gc_small_lbd;
         unsigned           m_gc_k;
+        unsigned           m_gc_tier1;
+        unsigned           m_gc_tier2;
         bool               m_gc_burst;
         bool               m_gc_defrag;
+        double             m_gc_defrag_ratio;
 
         bool               m_force_cleanup;
 
         // backtracking
         unsigned           m_backtrack_scopes;
         unsigned           m_backtrack_init_conflicts;
+        bool               m_backtrack_reuse_trail;
 
         bool               m_minimize_lemmas;
         bool               m_dyn_sub_res;
@@ -176,6 +192,7 @@ namespace sat {
         // drat proofs
         bool               m_drat;
         bool               m_drat_binary;
+        bool               m_drat_async;
         symbol             m_drat_file;
         bool               m_drat_check_unsat;
         bool               m_drat_check_sat;
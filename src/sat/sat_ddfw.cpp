@@ -85,32 +85,41 @@ namespace sat {
         return false;
     }
 
+    /**
+       \brief select a variable with positive reward with probability proportional to its score.
+       Otherwise select a variable with zero reward, or any variable in an unsatisfied clause.
+       The rewards are first gathered into a contiguous buffer so the remaining
+       passes are tight loops over arrays.
+    */
     bool_var ddfw::pick_var() {
+        unsigned sz = m_unsat_vars.size();
+        m_rewards.reserve(sz);
+        int* rewards = m_rewards.data();
+        bool_var const* vars = m_unsat_vars.begin();
+        for (unsigned i = 0; i < sz; ++i) 
+            rewards[i] = reward(vars[i]);
         double sum_pos = 0;
-        unsigned n = 1;
-        bool_var v0 = null_bool_var;
-        for (bool_var v : m_unsat_vars) {
-            int r = reward(v);
-            if (r > 0) {                
-                sum_pos += score(r);
-            }
-            else if (r == 0 && sum_pos == 0 && (m_rand() % (n++)) == 0) {
-                v0 = v;
-            }
-        }
+        for (unsigned i = 0; i < sz; ++i) 
+            if (rewards[i] > 0)
+                sum_pos += score(rewards[i]);
         if (sum_pos > 0) {
             double lim_pos = ((double) m_rand() / (1.0 + m_rand.max_value())) * sum_pos;                
-            for (bool_var v : m_unsat_vars) {
-                int r = reward(v);
+            for (unsigned i = 0; i < sz; ++i) {
+                int r = rewards[i];
                 if (r > 0) {
                     lim_pos -= score(r);
                     if (lim_pos <= 0) {
-                        if (m_par) update_reward_avg(v);
-                        return v;
+                        if (m_par) update_reward_avg(vars[i]);
+                        return vars[i];
                     }
                 }
             }
         }
+        unsigned n = 1;
+        bool_var v0 = null_bool_var;
+        for (unsigned i = 0; i < sz; ++i) 
+            if (rewards[i] == 0 && (m_rand() % (n++)) == 0)
+                v0 = vars[i];
         if (v0 != null_bool_var) {
             return v0;
         }
@@ -183,8 +192,8 @@ namespace sat {
             literal lit(v, false), nlit(v, true);
             value(v) = (m_rand() % 2) == 0; // m_use_list[lit.index()].size() >= m_use_list[nlit.index()].size();
         }
-        init_clause_data();
         flatten_use_list();
+        init_clause_data();
 
         m_reinit_count = 0;
         m_reinit_next = m_config.m_reinit_base;
@@ -212,10 +221,14 @@ namespace sat {
                 make_count(v) = 0;                
             }
         }
-        init_clause_data();
         flatten_use_list();
+        init_clause_data();
     }
 
+    /**
+       \brief store use lists and clause literals in contiguous arrays, 
+       the flip and weight shifting loops only walk these arrays.
+    */
     void ddfw::flatten_use_list() {
         m_use_list_index.reset();
         m_flat_use_list.reset();
@@ -224,6 +237,14 @@ namespace sat {
             m_flat_use_list.append(ul);
         }
         m_use_list_index.push_back(m_flat_use_list.size());
+
+        m_clause_index.reset();
+        m_flat_lits.reset();
+        for (auto const& ci : m_clauses) {
+            m_clause_index.push_back(m_flat_lits.size());
+            m_flat_lits.append(ci.m_clause->size(), ci.m_clause->begin());
+        }
+        m_clause_index.push_back(m_flat_lits.size());
     }
 
 
@@ -240,8 +261,7 @@ namespace sat {
             switch (ci.m_num_trues) {
             case 0: {
                 m_unsat.insert(cls_idx);
-                clause const& c = get_clause(cls_idx);
-                for (literal l : c) {
+                for (literal l : lits(cls_idx)) {
                     inc_reward(l, w);
                     inc_make(l);
                 }
@@ -263,8 +283,7 @@ namespace sat {
             switch (ci.m_num_trues) {
             case 0: {
                 m_unsat.remove(cls_idx);   
-                clause const& c = get_clause(cls_idx);
-                for (literal l : c) {
+                for (literal l : lits(cls_idx)) {
                     dec_reward(l, w);
                     dec_make(l);
                 }
@@ -319,7 +338,7 @@ namespace sat {
         unsigned sz = m_clauses.size();
         for (unsigned i = 0; i < sz; ++i) {
             auto& ci = m_clauses[i];
-            clause const& c = get_clause(i);
+            lit_range c = lits(i);
             ci.m_trues = 0;
             ci.m_num_trues = 0;
             for (literal lit : c) {
@@ -462,7 +481,7 @@ namespace sat {
     }
 
     unsigned ddfw::select_max_same_sign(unsigned cf_idx) {
-        clause const& c = get_clause(cf_idx);
+        lit_range c = lits(cf_idx);
         unsigned max_weight = 2;
         unsigned max_trues = 0;
         unsigned cl = UINT_MAX; // clause pointer to same sign, max weight satisfied clause.
@@ -501,7 +520,7 @@ namespace sat {
             SASSERT(wn - inc >= 1);            
             cf.m_weight += inc;
             cn.m_weight -= inc;
-            for (literal lit : get_clause(cf_idx)) {
+            for (literal lit : lits(cf_idx)) {
                 inc_reward(lit, inc);
             }
             if (cn.m_num_trues == 1) {
@@ -86,6 +86,9 @@ namespace sat {
         vector<unsigned_vector> m_use_list;
         unsigned_vector  m_flat_use_list;
         unsigned_vector  m_use_list_index;
+        literal_vector   m_flat_lits;     // literals of all clauses, stored contiguously
+        unsigned_vector  m_clause_index;  // clause -> position of its first literal in m_flat_lits
+        svector<int>     m_rewards;       // rewards of m_unsat_vars, gathered by pick_var
 
         indexed_uint_set m_unsat;
         indexed_uint_set m_unsat_vars;  // set of variables that are in unsat clauses
@@ -110,6 +113,18 @@ namespace sat {
             unsigned const* end() { return p.m_flat_use_list.data() + p.m_use_list_index[i + 1]; }
         };
 
+        struct lit_range {
+            literal const* m_begin;
+            literal const* m_end;
+            literal const* begin() const { return m_begin; }
+            literal const* end() const { return m_end; }
+        };
+
+        inline lit_range lits(unsigned idx) const {
+            literal const* base = m_flat_lits.data();
+            return { base + m_clause_index[idx], base + m_clause_index[idx + 1] };
+        }
+
         void flatten_use_list(); 
 
         double mk_score(unsigned r);
@@ -220,6 +235,8 @@ namespace sat {
         void collect_statistics(statistics& st) const override {} 
 
         double get_priority(bool_var v) const override { return m_probs[v]; }
+
+        lbool get_phase(bool_var v) const override { return v < num_vars() ? to_lbool(value(v)) : l_undef; }
     };
 }
 
@@ -19,11 +19,124 @@ Author:
 Notes:
 
 --*/
+#ifndef SINGLE_THREAD
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#endif
 #include "sat_solver.h"
 #include "sat_drat.h"
 
 
 namespace sat {
+
+    /**
+       \brief stream buffer for proof files. 
+
+       Proof lines are collected in a large buffer that is written to the file
+       when it fills up. In asynchronous mode the full buffer is handed to a
+       writer thread and filling continues in a second buffer, so the solver
+       only waits for the disk when both buffers are full.
+    */
+    class proof_buffer : public std::streambuf {
+        static const size_t BUFFER_SIZE = 1 << 20;
+        std::ofstream            m_file;
+        svector<char>            m_fill;
+#ifndef SINGLE_THREAD
+        bool                     m_async { false };
+        svector<char>            m_write;
+        size_t                   m_write_size { 0 };
+        bool                     m_done { false };
+        std::mutex               m_mux;
+        std::condition_variable  m_cv;
+        std::thread              m_thread;
+
+        void write_loop() {
+            std::unique_lock<std::mutex> lock(m_mux);
+            while (true) {
+                m_cv.wait(lock, [&]() { return m_write_size > 0 || m_done; });
+                if (m_write_size == 0)
+                    break;
+                lock.unlock();
+                m_file.write(m_write.data(), m_write_size);
+                lock.lock();
+                m_write_size = 0;
+                m_cv.notify_all();
+            }
+            m_file.flush();
+        }
+#endif
+
+        void reset_fill() {
+            setp(m_fill.data(), m_fill.data() + m_fill.size());
+        }
+
+        void flush_fill() {
+            size_t n = pptr() - pbase();
+            if (n == 0)
+                return;
+#ifndef SINGLE_THREAD
+            if (m_async) {
+                std::unique_lock<std::mutex> lock(m_mux);
+                m_cv.wait(lock, [&]() { return m_write_size == 0; });
+                m_fill.swap(m_write);
+                m_write_size = n;
+                m_cv.notify_all();
+                reset_fill();
+                return;
+            }
+#endif
+            m_file.write(m_fill.data(), n);
+            reset_fill();
+        }
+
+    protected:
+        int_type overflow(int_type ch) override {
+            flush_fill();
+            if (traits_type::eq_int_type(ch, traits_type::eof()))
+                return traits_type::not_eof(ch);
+            *pptr() = traits_type::to_char_type(ch);
+            pbump(1);
+            return ch;
+        }
+
+        // flushing the stream hands over the buffer, but does not wait for the disk.
+        int sync() override {
+            flush_fill();
+            return 0;
+        }
+
+    public:
+        proof_buffer(char const* file_name, std::ios_base::openmode mode, bool async):
+            m_file(file_name, mode) {
+            m_fill.resize(BUFFER_SIZE);
+            reset_fill();
+#ifndef SINGLE_THREAD
+            m_async = async;
+            if (m_async) {
+                m_write.resize(BUFFER_SIZE);
+                m_thread = std::thread([this]() { write_loop(); });
+            }
+#endif
+        }
+
+        ~proof_buffer() override {
+            flush_fill();
+#ifndef SINGLE_THREAD
+            if (m_async) {
+                {
+                    std::lock_guard<std::mutex> lock(m_mux);
+                    m_done = true;
+                }
+                m_cv.notify_all();
+                m_thread.join();
+                return;
+            }
+#endif
+            m_file.flush();
+        }
+    };
+
     drat::drat(solver& s) :
         s(s),
         m_out(nullptr),
@@ -36,7 +149,8 @@ namespace sat {
     {
         if (s.get_config().m_drat && s.get_config().m_drat_file.is_non_empty_string()) {
             auto mode = s.get_config().m_drat_binary ? (std::ios_base::binary | std::ios_base::out | std::ios_base::trunc) : std::ios_base::out;
-            m_out = alloc(std::ofstream, s.get_config().m_drat_file.str(), mode);
+            m_buffer = alloc(proof_buffer, s.get_config().m_drat_file.str().c_str(), mode, s.get_config().m_drat_async);
+            m_out = alloc(std::ostream, m_buffer);
             if (s.get_config().m_drat_binary) 
                 std::swap(m_out, m_bout);            
         }
@@ -47,6 +161,7 @@ namespace sat {
         if (m_bout) m_bout->flush();
         dealloc(m_out);
         dealloc(m_bout);
+        dealloc(m_buffer);
         for (unsigned i = 0; i < m_proof.size(); ++i) {
             clause* c = m_proof[i];
             if (c) 
@@ -55,6 +170,7 @@ namespace sat {
         m_proof.reset();
         m_out = nullptr;
         m_bout = nullptr;
+        m_buffer = nullptr;
     }
 
     void drat::updt_config() {            
@@ -59,6 +59,7 @@ Notes:
 namespace sat {
     class justification;
     class clause;
+    class proof_buffer;
 
     class drat {
         struct stats {
@@ -79,6 +80,7 @@ namespace sat {
         clause_allocator        m_alloc;
         std::ostream*           m_out;
         std::ostream*           m_bout;
+        proof_buffer*           m_buffer { nullptr };
         ptr_vector<clause>      m_proof;
         svector<status>         m_status;        
         literal_vector          m_units;
@@ -0,0 +1,148 @@
+/*++
+  Copyright (c) 2021 Microsoft Corporation
+
+  Module Name:
+
+   sat_gauss_simplifier.cpp
+
+  Abstract:
+
+    Gauss-Jordan elimination over the XOR constraints
+    that are encoded by the clauses.
+
+  --*/
+
+#include "util/union_find.h"
+#include "math/simplex/bit_matrix.h"
+#include "sat/sat_gauss_simplifier.h"
+#include "sat/sat_elim_eqs.h"
+#include "sat/sat_xor_finder.h"
+
+namespace sat {
+
+    struct gauss_simplifier::report {
+        gauss_simplifier& s;
+        stopwatch         m_watch;
+        report(gauss_simplifier& s): s(s) { m_watch.start(); }
+        ~report() {
+            m_watch.stop();
+            IF_VERBOSE(2,
+                       verbose_stream() << " (sat.gauss"
+                       << " :num-xors " << s.m_stats.m_num_xors
+                       << " :num-units " << s.m_stats.m_num_units
+                       << " :num-eqs " << s.m_stats.m_num_eqs
+                       << m_watch << ")\n");
+        }
+    };
+
+    void gauss_simplifier::operator()() {
+        report _report(*this);
+        collect_xors();
+        m_stats.m_num_xors += m_xors.size();
+        if (!m_xors.empty())
+            solve();
+        m_xors.reset();
+    }
+
+    void gauss_simplifier::collect_xors() {
+        clause_vector clauses(s.clauses());
+        std::function<void(literal_vector const&)> f =
+            [&,this](literal_vector const& x) {
+            if (m_xors.size() < m_max_xors)
+                m_xors.push_back(x);
+        };
+        xor_finder xf(s);
+        xf.set(f);
+        xf(clauses);
+        // the clauses stay, only the consequences of the xors are added.
+        for (clause* cp : xf.removed_clauses())
+            cp->unmark_used();
+    }
+
+    /**
+       \brief each xor is a row x_1 + .. + x_n = b, where the last column holds b.
+       A literal l of an xor contributes its variable, and 1 if l is negative.
+       The xors of xor_finder sum up to 1. Variables assigned at the base
+       level are moved to the right-hand side.
+     */
+    void gauss_simplifier::solve() {
+        unsigned_vector var2col(s.num_vars(), UINT_MAX);
+        bool_var_vector col2var;
+        for (auto const& x : m_xors)
+            for (literal l : x)
+                if (s.value(l) == l_undef && var2col[l.var()] == UINT_MAX) {
+                    var2col[l.var()] = col2var.size();
+                    col2var.push_back(l.var());
+                }
+        unsigned rhs = col2var.size();
+        bit_matrix bm;
+        bm.reset(rhs + 1);
+        for (auto const& x : m_xors) {
+            auto row = bm.add_row();
+            bool b = true;
+            for (literal l : x) {
+                lbool val = s.value(l);
+                if (val != l_undef) {
+                    b ^= (val == l_true);
+                    continue;
+                }
+                b ^= l.sign();
+                unsigned c = var2col[l.var()];
+                row.set(c, !row[c]);
+            }
+            row.set(rhs, b);
+        }
+
+        bm.solve();
+        TRACE("sat_gauss", tout << bm << "\n";);
+
+        union_find_default_ctx ctx;
+        union_find<> uf(ctx);
+        for (unsigned i = 2*s.num_vars(); i-- > 0; ) uf.mk_var();
+        unsigned old_num_eqs = m_stats.m_num_eqs;
+        for (auto const& row : bm) {
+            unsigned num_cols = 0;
+            unsigned cols[2] = { 0, 0 };
+            for (unsigned c : row) {
+                if (c == rhs)
+                    break;
+                if (num_cols < 2)
+                    cols[num_cols] = c;
+                if (++num_cols > 2)
+                    break;
+            }
+            bool b = row[rhs];
+            if (num_cols == 0 && b) {
+                s.set_conflict();
+                return;
+            }
+            else if (num_cols == 1) {
+                literal lit(col2var[cols[0]], !b);
+                s.assign_unit(lit);
+                ++m_stats.m_num_units;
+                TRACE("sat_gauss", tout << "unit " << lit << "\n";);
+            }
+            else if (num_cols == 2) {
+                // x + y = b, so x == y + b
+                literal x(col2var[cols[0]], false);
+                literal y(col2var[cols[1]], b);
+                uf.merge(x.index(), y.index());
+                uf.merge((~x).index(), (~y).index());
+                ++m_stats.m_num_eqs;
+                TRACE("sat_gauss", tout << "equivalence " << x << " == " << y << "\n";);
+            }
+            if (s.inconsistent())
+                return;
+        }
+        if (old_num_eqs < m_stats.m_num_eqs) {
+            elim_eqs elim(s);
+            elim(uf);
+        }
+    }
+
+    void gauss_simplifier::collect_statistics(statistics& st) const {
+        st.update("sat gauss xors", m_stats.m_num_xors);
+        st.update("sat gauss units", m_stats.m_num_units);
+        st.update("sat gauss eqs", m_stats.m_num_eqs);
+    }
+}
@@ -0,0 +1,51 @@
+/*++
+  Copyright (c) 2021 Microsoft Corporation
+
+  Module Name:
+
+   sat_gauss_simplifier.h
+
+  Abstract:
+
+    Gauss-Jordan elimination over the XOR constraints
+    that are encoded by the clauses.
+
+    The XORs are extracted by xor_finder and stored as rows of a
+    packed GF(2) matrix. Rows are added word by word. After
+    elimination, rows with one variable are units and rows with
+    two variables are equivalences, which are substituted by elim_eqs.
+    An empty row with an odd right-hand side is a conflict.
+
+  --*/
+#pragma once
+
+#include "util/statistics.h"
+#include "sat/sat_types.h"
+#include "sat/sat_solver.h"
+
+namespace sat {
+
+    class gauss_simplifier {
+        struct report;
+
+        struct stats {
+            unsigned m_num_xors, m_num_units, m_num_eqs;
+            stats() { reset(); }
+            void reset() { memset(this, 0, sizeof(*this)); }
+        };
+
+        solver&                 s;
+        unsigned                m_max_xors;
+        stats                   m_stats;
+        vector<literal_vector>  m_xors;
+
+        void collect_xors();
+        void solve();
+
+    public:
+        gauss_simplifier(solver& s, unsigned max_xors) : s(s), m_max_xors(max_xors) {}
+
+        void operator()();
+        void collect_statistics(statistics& st) const;
+    };
+}
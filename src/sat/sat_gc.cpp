@@ -57,6 +57,9 @@ namespace sat {
         case GC_PSM_GLUE:
             gc_psm_glue();
             break;
+        case GC_TIERED:
+            gc_tiered();
+            break;
         case GC_DYN_PSM:
             if (!m_assumptions.empty()) {
                 gc_glue_psm();
@@ -146,6 +149,48 @@ namespace sat {
         gc_half("psm-glue");
     }
 
+    /**
+       \brief Three tier clause database.
+       Clauses with glue at most gc.tier1 form the core and are never deleted.
+       Clauses with glue at most gc.tier2 are kept as long as they were used
+       since the previous gc, otherwise they are treated as local clauses.
+       Only the local clauses are sorted, by (glue, size), and the second half
+       of them is deleted unless they were used since the previous gc.
+    */
+    void solver::gc_tiered() {
+        TRACE("sat", tout << "gc\n";);
+        unsigned sz = m_learned.size();
+        unsigned j  = 0;
+        ptr_vector<clause> local;
+        for (unsigned i = 0; i < sz; ++i) {
+            clause* c = m_learned[i];
+            unsigned glue = c->glue();
+            if (glue <= m_config.m_gc_tier1 || (glue <= m_config.m_gc_tier2 && c->was_used()))
+                m_learned[j++] = c;
+            else
+                local.push_back(c);
+        }
+        unsigned num_kept = j;
+        std::stable_sort(local.begin(), local.end(), glue_lt());
+        unsigned half = local.size() / 2;
+        for (unsigned i = 0; i < local.size(); ++i) {
+            clause & c = *local[i];
+            if (i >= half && !c.was_used() && can_delete(c)) {
+                detach_clause(c);
+                del_clause(c);
+            }
+            else {
+                m_learned[j++] = &c;
+            }
+        }
+        for (unsigned i = 0; i < j; ++i)
+            m_learned[i]->unmark_used();
+        m_stats.m_gc_clause += sz - j;
+        m_learned.shrink(j);
+        IF_VERBOSE(SAT_VB_LVL, verbose_stream() << "(sat-gc :strategy tiered :kept " << num_kept << " :local " << local.size() 
+                   << " :deleted " << (sz - j) << ")\n";);
+    }
+
     /**
        \brief Compute the psm of all learned clauses.
     */
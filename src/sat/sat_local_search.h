@@ -261,6 +261,8 @@ namespace sat {
 
         double get_priority(bool_var v) const override { return m_vars[v].m_break_prob; }
 
+        lbool get_phase(bool_var v) const override { return v < m_best_phase.size() ? to_lbool(m_best_phase[v]) : l_undef; }
+
         void import(solver const& s, bool init);        
 
         void add_cardinality(unsigned sz, literal const* c, unsigned k);
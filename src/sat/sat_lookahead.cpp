@@ -25,6 +25,9 @@ Notes:
 #include "sat/sat_lookahead.h"
 #include "sat/sat_scc.h"
 #include "util/union_find.h"
+#ifndef SINGLE_THREAD
+#include "util/thread_pool.h"
+#endif
 
 namespace sat {
     lookahead::scoped_ext::scoped_ext(lookahead& p): p(p) {
@@ -1753,6 +1756,7 @@ namespace sat {
         literal last_changed = null_literal;
         unsigned ops = 0;
         m_max_ops = 100000;
+        probe_binary_parallel();
         while (change && !inconsistent() && ops < m_max_ops) {
             change = false;
             IF_VERBOSE(10, verbose_stream() << "(sat.lookahead :compute-reward " << m_lookahead.size() << ")\n");
@@ -1824,6 +1828,72 @@ namespace sat {
         TRACE("sat", display_lookahead(tout); );
     }
 
+    /**
+       \brief find failed literals among the lookahead candidates on multiple threads.
+       Each worker takes a share of the candidates and explores the binary implication
+       graph from a candidate with its own stamps. The graph and the assignment are not
+       updated while the workers run. A candidate is failed if it implies a false literal,
+       or a literal and its negation. The negations of the failed literals are assigned
+       when the workers are done, and the remaining candidates are evaluated by the
+       sequential lookahead.
+     */
+    void lookahead::probe_binary_parallel() {
+#ifndef SINGLE_THREAD
+        unsigned num_threads = std::min(m_config.m_num_threads, m_lookahead.size());
+        if (num_threads <= 1 || inconsistent()) 
+            return;
+        vector<literal_vector> failed(num_threads);
+        auto worker = [&](unsigned w) {
+            unsigned_vector stamp(2 * m_num_vars, 0u);
+            literal_vector todo;
+            unsigned id = 0;
+            for (unsigned i = w; i < m_lookahead.size(); i += num_threads) {
+                literal lit = m_lookahead[i].m_lit;
+                if (!is_undef(lit)) 
+                    continue;
+                ++id;
+                todo.reset();
+                todo.push_back(lit);
+                stamp[lit.index()] = id;
+                bool is_failed = false;
+                for (unsigned j = 0; !is_failed && j < todo.size() && j < m_config.m_probe_limit; ++j) {
+                    for (literal v : m_binary[todo[j].index()]) {
+                        if (is_true(v) || stamp[v.index()] == id) 
+                            continue;
+                        if (is_false(v) || stamp[(~v).index()] == id) {
+                            is_failed = true;
+                            break;
+                        }
+                        stamp[v.index()] = id;
+                        todo.push_back(v);
+                    }
+                }
+                if (is_failed) 
+                    failed[w].push_back(lit);
+            }
+        };
+        {
+            thread_pool threads;
+            for (unsigned w = 0; w < num_threads; ++w)
+                threads.run([&, w]() { worker(w); });
+            threads.join();
+        }
+        for (literal_vector const& lits : failed) {
+            for (literal lit : lits) {
+                if (inconsistent()) 
+                    return;
+                if (!is_undef(lit)) 
+                    continue;
+                TRACE("sat", tout << "failed binary probe " << lit << "\n";);
+                ++m_stats.m_probe_failed_literals;
+                lookahead_backtrack();
+                assign(~lit);
+                propagate();
+            }
+        }
+#endif
+    }
+
     literal lookahead::select_literal() {
         literal l = null_literal;
         double h = 0;
@@ -2588,6 +2658,7 @@ namespace sat {
         m_config.m_cube_psat_var_exp = m_s.m_config.m_lookahead_cube_psat_var_exp;
         m_config.m_cube_psat_clause_base = m_s.m_config.m_lookahead_cube_psat_clause_base;
         m_config.m_cube_psat_trigger = m_s.m_config.m_lookahead_cube_psat_trigger;
+        m_config.m_num_threads = m_s.m_config.m_lookahead_threads;
     }
 
     void lookahead::collect_statistics(statistics& st) const {
@@ -2601,6 +2672,7 @@ namespace sat {
         st.update("lh windfalls", m_stats.m_windfall_binaries);
         st.update("lh double lookahead propagations", m_stats.m_double_lookahead_propagations);
         st.update("lh double lookahead rounds", m_stats.m_double_lookahead_rounds);
+        st.update("lh probe failed literals", m_stats.m_probe_failed_literals);
     }
 
 }
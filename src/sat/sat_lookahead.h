@@ -91,6 +91,8 @@ namespace sat {
             double   m_cube_psat_var_exp;
             double   m_cube_psat_clause_base;
             double   m_cube_psat_trigger;
+            unsigned m_num_threads;
+            unsigned m_probe_limit;
 
             config() {
                 memset(this, 0, sizeof(*this));
@@ -112,6 +114,8 @@ namespace sat {
                 m_cube_psat_var_exp = 1.0;
                 m_cube_psat_clause_base = 2.0;
                 m_cube_psat_trigger = 5.0;
+                m_num_threads = 1;
+                m_probe_limit = 1000;
             }
         };
 
@@ -136,6 +140,7 @@ namespace sat {
             unsigned m_windfall_binaries;
             unsigned m_double_lookahead_propagations;
             unsigned m_double_lookahead_rounds;
+            unsigned m_probe_failed_literals;
             stats() { reset(); }
             void reset() { memset(this, 0, sizeof(*this)); }
         };
@@ -516,6 +521,7 @@ namespace sat {
         literal choose();
         literal choose_base();
         void compute_lookahead_reward();
+        void probe_binary_parallel();
         literal select_literal();
         void update_binary_clause_reward(literal l1, literal l2);
         void update_nary_clause_reward(clause const& c);
@@ -121,16 +121,19 @@ namespace sat {
                 // all clauses must be satisfied
                 bool sat = false;
                 bool undef = false;
-                for (literal const& l : e.m_clauses) {
+                unsigned pos = 0;
+                for (literal l : e.m_clauses) {
+                    ++pos;
                     if (l == null_literal) {
                         CTRACE("sat", !sat, 
                                tout << "exposed: " << m_exposed_lim << "\n";
                                if (m_solver) m_solver->display(tout);
                                display(tout);
                                for (unsigned v = 0; v < m.size(); ++v) tout << v << ": " << m[v] << "\n";
-                               for (literal const& l2 : e.m_clauses) {
+                               unsigned pos2 = 0;
+                               for (literal l2 : e.m_clauses) {
                                    if (l2 == null_literal) tout << "\n"; else tout << l2 << " ";
-                                   if (&l == &l2) break;
+                                   if (++pos2 == pos) break;
                                }
                                );
                         SASSERT(sat || undef);
@@ -158,22 +161,19 @@ namespace sat {
         bool ok = true;
         for (entry const & e : m_entries) {
             bool sat = false;
-            literal_vector::const_iterator it      = e.m_clauses.begin();
-            literal_vector::const_iterator itbegin = it;
-            literal_vector::const_iterator end     = e.m_clauses.end();
-            for (; it != end; ++it) {
-                literal l  = *it;
+            literal_vector clause;
+            for (literal l : e.m_clauses) {
                 if (l == null_literal) {
                     // end of clause
                     if (!sat) {
-                        TRACE("sat_model_bug", tout << "failed eliminated: " << mk_lits_pp(static_cast<unsigned>(it - itbegin), itbegin) << "\n";);
+                        TRACE("sat_model_bug", tout << "failed eliminated: " << clause << "\n";);
                         ok = false;
                     }
                     sat = false;
-                    itbegin = it;
-                    itbegin++;
+                    clause.reset();
                     continue;
                 }
+                clause.push_back(l);
                 if (sat)
                     continue;
                 if (value_at(l, m) == l_true)
@@ -65,12 +65,82 @@ namespace sat {
             unsigned ref_count() const { return m_refcount; }
         };
 
+        /**
+           \brief sequence of literals where clauses are separated by null_literal.
+           A literal is stored as the zig-zag encoded difference of its index to 
+           the index of the previous literal, using 7 bits per byte. The code 0 is 
+           the separator. Eliminated clauses tend to share variables with nearby 
+           indices, so most literals take a single byte.
+        */
+        class clause_buffer {
+            svector<unsigned char> m_data;
+            unsigned               m_last { 0 };
+            unsigned               m_size { 0 };
+        public:
+            void push_back(literal l) {
+                ++m_size;
+                if (l == null_literal) {
+                    m_data.push_back(0);
+                    return;
+                }
+                int64_t diff = static_cast<int64_t>(l.index()) - static_cast<int64_t>(m_last);
+                uint64_t code = ((static_cast<uint64_t>(diff) << 1) ^ static_cast<uint64_t>(diff >> 63)) + 1;
+                while (code >= 0x80) {
+                    m_data.push_back(static_cast<unsigned char>(code | 0x80));
+                    code >>= 7;
+                }
+                m_data.push_back(static_cast<unsigned char>(code));
+                m_last = l.index();
+            }
+            unsigned size() const { return m_size; }
+            bool empty() const { return m_size == 0; }
+            unsigned num_bytes() const { return m_data.size(); }
+
+            class iterator {
+                unsigned char const* m_pos;
+                unsigned char const* m_next;
+                unsigned char const* m_end;
+                unsigned             m_prev { 0 };
+                literal              m_lit;
+                void decode() {
+                    m_next = m_pos;
+                    if (m_next == m_end)
+                        return;
+                    uint64_t code = 0;
+                    unsigned shift = 0;
+                    unsigned char b;
+                    do {
+                        b = *m_next++;
+                        code |= static_cast<uint64_t>(b & 0x7f) << shift;
+                        shift += 7;
+                    }
+                    while (b & 0x80);
+                    if (code == 0) {
+                        m_lit = null_literal;
+                        return;
+                    }
+                    --code;
+                    int64_t diff = static_cast<int64_t>(code >> 1) ^ -static_cast<int64_t>(code & 1);
+                    m_prev = static_cast<unsigned>(m_prev + diff);
+                    m_lit = to_literal(m_prev);
+                }
+            public:
+                iterator(unsigned char const* pos, unsigned char const* end): m_pos(pos), m_end(end) { decode(); }
+                literal operator*() const { return m_lit; }
+                iterator& operator++() { m_pos = m_next; decode(); return *this; }
+                bool operator==(iterator const& other) const { return m_pos == other.m_pos; }
+                bool operator!=(iterator const& other) const { return m_pos != other.m_pos; }
+            };
+            iterator begin() const { return iterator(m_data.begin(), m_data.end()); }
+            iterator end() const { return iterator(m_data.end(), m_data.end()); }
+        };
+
         enum kind { ELIM_VAR = 0, BCE, CCE, ACCE, ABCE, ATE };
         class entry {
             friend class model_converter;
             bool_var                m_var;
             kind                    m_kind;
-            literal_vector          m_clauses; // the different clauses are separated by null_literal
+            clause_buffer           m_clauses; // the different clauses are separated by null_literal
             literal_vector          m_clause;  // original clause in case of CCE
             sref_vector<elim_stack> m_elim_stack;
             entry(kind k, bool_var v): m_var(v), m_kind(k) {}
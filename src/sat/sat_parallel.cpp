@@ -16,76 +16,63 @@ Author:
 Revision History:
 
 --*/
+#if !defined(SINGLE_THREAD) && defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#include <thread>
+#endif
 #include "sat/sat_parallel.h"
 #include "sat/sat_clause.h"
 #include "sat/sat_solver.h"
 
 namespace sat {
 
-    void parallel::vector_pool::next(unsigned& index) {
-        SASSERT(index < m_size);
-        unsigned n = index + 2 + get_length(index);
-        if (n >= m_size) {
-            index = 0;
-        }
-        else {
-            index = n;
-        }
-    }
-
-    void parallel::vector_pool::reserve(unsigned num_threads, unsigned sz) {
-        m_vectors.reset();
-        m_vectors.resize(sz, 0);
-        m_heads.reset();
-        m_heads.resize(num_threads, 0);
-        m_at_end.reset();
-        m_at_end.resize(num_threads, true);
-        m_tail = 0;
-        m_size = sz;
-    }
-    
-    void parallel::vector_pool::begin_add_vector(unsigned owner, unsigned n) {
-        SASSERT(m_tail < m_size);
-        unsigned capacity = n + 2;
-        m_vectors.reserve(m_size + capacity, 0);
-        IF_VERBOSE(3, verbose_stream() << owner << ": begin-add " << n << " tail: " << m_tail << " size: " << m_size << "\n";);
-        for (unsigned i = 0; i < m_heads.size(); ++i) {
-            while (m_tail < m_heads[i] && m_heads[i] < m_tail + capacity) {
-                next(m_heads[i]);
-            }
-            m_at_end[i] = false;
-        }
-        m_vectors[m_tail++] = owner;
-        m_vectors[m_tail++] = n;    
+    void parallel::vector_pool::reserve(unsigned num_owners, unsigned sz) {
+        m_num_slots = std::max(32u, sz / (4 * std::max(1u, num_owners)));
+        m_rings.reset();
+        for (unsigned i = 0; i < num_owners; ++i) 
+            m_rings.push_back(alloc(ring, m_num_slots));
+        m_cursors.reset();
+        m_cursors.resize(num_owners);
+        for (auto& c : m_cursors) 
+            c.resize(num_owners, 0);
+        m_next.reset();
+        m_next.resize(num_owners, 0);
     }
 
-    void parallel::vector_pool::add_vector_elem(unsigned e) {
-        m_vectors[m_tail++] = e;
+    void parallel::vector_pool::add_vector(unsigned owner, unsigned n, unsigned const* elems) {
+        ring& r = *m_rings[owner];
+        IF_VERBOSE(3, verbose_stream() << owner << ": add " << n << " seq: " << static_cast<uint64_t>(r.m_seq) << "\n";);
+        lock_guard lock(r.m_mux);
+        uint64_t seq = r.m_seq;
+        unsigned_vector& slot = r.m_slots[seq % m_num_slots];
+        slot.reset();
+        slot.append(n, elems);
+        r.m_seq = seq + 1;
     }
 
-    void parallel::vector_pool::end_add_vector() {
-        if (m_tail >= m_size) {
-            m_tail = 0;
-        }
-    }
-
-
-    bool parallel::vector_pool::get_vector(unsigned owner, unsigned& n, unsigned const*& ptr) {
-        unsigned head = m_heads[owner];      
-        unsigned iterations = 0;
-        while (head != m_tail || !m_at_end[owner]) {
-            ++iterations;
-            SASSERT(head < m_size && m_tail < m_size);            
-            bool is_self = owner == get_owner(head);
-            next(m_heads[owner]);
-            IF_VERBOSE(static_cast<unsigned>(iterations > m_size ? 0 : 3), verbose_stream() << owner << ": [" << head << ":" << m_heads[owner] << "] tail: " << m_tail << "\n";);
-            m_at_end[owner] = (m_heads[owner] == m_tail);
-            if (!is_self) {
-                n = get_length(head);
-                ptr = get_ptr(head);
-                return true;
-            }
-            head = m_heads[owner];
+    bool parallel::vector_pool::get_vector(unsigned owner, unsigned_vector& result) {
+        unsigned num_owners = m_rings.size();
+        svector<uint64_t>& cursors = m_cursors[owner];
+        for (unsigned k = 0; k < num_owners; ++k) {
+            unsigned producer = (m_next[owner] + k) % num_owners;
+            if (producer == owner)
+                continue;
+            ring& r = *m_rings[producer];
+            uint64_t& cursor = cursors[producer];
+            if (cursor == r.m_seq)
+                continue;
+            lock_guard lock(r.m_mux);
+            uint64_t seq = r.m_seq;
+            // clauses that were overwritten before this consumer got to them are dropped.
+            if (seq - cursor > m_num_slots)
+                cursor = seq - m_num_slots;
+            unsigned_vector const& slot = r.m_slots[cursor % m_num_slots];
+            result.reset();
+            result.append(slot);
+            ++cursor;
+            m_next[owner] = (producer + 1) % num_owners;
+            return true;
         }
         return false;
     }
@@ -98,7 +85,7 @@ namespace sat {
         }
     }
 
-    void parallel::init_solvers(solver& s, unsigned num_extra_solvers) {
+    void parallel::init_solvers(solver& s, unsigned num_extra_solvers, bool copy) {
         unsigned num_threads = num_extra_solvers + 1;
         m_solvers.init(num_extra_solvers);
         m_limits.init(num_extra_solvers);
@@ -110,7 +97,8 @@ namespace sat {
                 s.m_params.set_sym("phase", symbol("random"));
             }                        
             m_solvers[i] = alloc(sat::solver, s.m_params, m_limits[i]);
-            m_solvers[i]->copy(s, true);
+            if (copy)
+                m_solvers[i]->copy(s, true);
             m_solvers[i]->set_par(this, i);
             push_child(m_solvers[i]->rlimit());            
         }
@@ -118,6 +106,22 @@ namespace sat {
         s.m_params.set_sym("phase", saved_phase);        
     }
 
+    void parallel::copy_solver(solver& s, unsigned i) {
+        m_solvers[i]->copy(s, true);
+    }
+
+    void parallel::pin_thread(unsigned i) {
+#if !defined(SINGLE_THREAD) && defined(__linux__)
+        unsigned num_cores = std::thread::hardware_concurrency();
+        if (num_cores == 0)
+            return;
+        cpu_set_t cpus;
+        CPU_ZERO(&cpus);
+        CPU_SET(i % num_cores, &cpus);
+        pthread_setaffinity_np(pthread_self(), sizeof(cpus), &cpus);
+#endif
+    }
+
     void parallel::push_child(reslimit& rl) {
         m_scoped_rlimit.push_child(&rl);            
     }
@@ -147,13 +151,8 @@ namespace sat {
         if (s.get_config().m_num_threads == 1 || s.m_par_syncing_clauses) return;
         flet<bool> _disable_sync_clause(s.m_par_syncing_clauses, true);
         IF_VERBOSE(3, verbose_stream() << s.m_par_id << ": share " <<  l1 << " " << l2 << "\n";);
-        {
-            lock_guard lock(m_mux);
-            m_pool.begin_add_vector(s.m_par_id, 2);
-            m_pool.add_vector_elem(l1.index());
-            m_pool.add_vector_elem(l2.index());            
-            m_pool.end_add_vector();
-        }        
+        unsigned elems[2] = { l1.index(), l2.index() };
+        m_pool.add_vector(s.m_par_id, 2, elems);
     }
 
     void parallel::share_clause(solver& s, clause const& c) {        
@@ -162,37 +161,38 @@ namespace sat {
         unsigned n = c.size();
         unsigned owner = s.m_par_id;
         IF_VERBOSE(3, verbose_stream() << owner << ": share " <<  c << "\n";);
-        lock_guard lock(m_mux);
-        m_pool.begin_add_vector(owner, n);                
+        sbuffer<unsigned> elems;
         for (unsigned i = 0; i < n; ++i) {
-            m_pool.add_vector_elem(c[i].index());
+            elems.push_back(c[i].index());
         }
-        m_pool.end_add_vector();        
+        m_pool.add_vector(owner, n, elems.data());
     }
 
     void parallel::get_clauses(solver& s) {
         if (s.m_par_syncing_clauses) return;
         flet<bool> _disable_sync_clause(s.m_par_syncing_clauses, true);
-        lock_guard lock(m_mux);
         _get_clauses(s);        
     }
 
     void parallel::_get_clauses(solver& s) {
-        unsigned n;
-        unsigned const* ptr;
+        // buffers are local: several consumers may retrieve clauses concurrently.
+        unsigned_vector elems;
+        literal_vector lits;
         unsigned owner = s.m_par_id;
-        while (m_pool.get_vector(owner, n, ptr)) {
-            m_lits.reset();
+        while (m_pool.get_vector(owner, elems)) {
+            unsigned n = elems.size();
+            unsigned const* ptr = elems.data();
+            lits.reset();
             bool usable_clause = true;
             for (unsigned i = 0; usable_clause && i < n; ++i) {
                 literal lit(to_literal(ptr[i]));                
-                m_lits.push_back(lit);
+                lits.push_back(lit);
                 usable_clause = lit.var() <= s.m_par_num_vars && !s.was_eliminated(lit.var());
             }
-            IF_VERBOSE(3, verbose_stream() << s.m_par_id << ": retrieve " << m_lits << "\n";);
+            IF_VERBOSE(3, verbose_stream() << s.m_par_id << ": retrieve " << lits << "\n";);
             SASSERT(n >= 2);
             if (usable_clause) {
-                s.mk_clause_core(m_lits.size(), m_lits.data(), sat::status::redundant());
+                s.mk_clause_core(lits.size(), lits.data(), sat::status::redundant());
             }
         }        
     }
@@ -221,6 +221,11 @@ namespace sat {
         for (bool_var v = 0; v < m_priorities.size(); ++v) {
             s.update_activity(v, m_priorities[v]);
         }
+        // the saved phases of the solver follow the assignment of local search.
+        for (bool_var v = 0; v < m_phases.size() && v < s.num_vars(); ++v) {
+            if (m_phases[v] != l_undef && s.value(v) == l_undef) 
+                s.m_phase[v] = m_phases[v] == l_true;
+        }
         return true;
     }
 
@@ -236,8 +241,10 @@ namespace sat {
 
     void parallel::_to_solver(i_local_search& s) {        
         m_priorities.reset();
+        m_phases.reset();
         for (bool_var v = 0; m_solver_copy && v < m_solver_copy->num_vars(); ++v) {
             m_priorities.push_back(s.get_priority(v));
+            m_phases.push_back(s.get_phase(v));
         }
     }
 
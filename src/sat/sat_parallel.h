@@ -24,28 +24,33 @@ Revision History:
 #include "util/rlimit.h"
 #include "util/scoped_ptr_vector.h"
 #include "util/mutex.h"
+#include "util/buffer.h"
 
 namespace sat {
 
     class parallel {
 
         // shared pool of learned clauses.
+        // Each producer owns a ring of clause slots that only it writes to.
+        // Consumers keep a private read cursor per producer, so a receiving thread
+        // only contends with the single owner of the ring it is reading from.
+        // The published sequence number is atomic, allowing consumers to skip
+        // rings without new clauses without taking the ring's lock.
         class vector_pool {
-            unsigned_vector m_vectors;
-            unsigned        m_size{ 0 };
-            unsigned        m_tail{ 0 };
-            unsigned_vector m_heads;
-            bool_vector   m_at_end;
-            void next(unsigned& index);
-            unsigned get_owner(unsigned index) const { return m_vectors[index]; }
-            unsigned get_length(unsigned index) const { return m_vectors[index+1]; }
-            unsigned const* get_ptr(unsigned index) const { return m_vectors.data() + index + 2; }
+            struct ring {
+                mutex                   m_mux;
+                vector<unsigned_vector> m_slots;
+                atomic<uint64_t>        m_seq { 0 };  // number of clauses published so far
+                ring(unsigned num_slots): m_slots(num_slots) {}
+            };
+            scoped_ptr_vector<ring>    m_rings;
+            vector<svector<uint64_t>>  m_cursors;    // m_cursors[consumer][producer]
+            unsigned_vector            m_next;       // round-robin start per consumer
+            unsigned                   m_num_slots { 0 };
         public:
             void reserve(unsigned num_owners, unsigned sz);
-            void begin_add_vector(unsigned owner, unsigned n);
-            void end_add_vector();
-            void add_vector_elem(unsigned e);
-            bool get_vector(unsigned owner, unsigned& n, unsigned const*& ptr);
+            void add_vector(unsigned owner, unsigned n, unsigned const* elems);
+            bool get_vector(unsigned owner, unsigned_vector& result);
         };
 
         bool enable_add(clause const& c) const;
@@ -58,7 +63,6 @@ namespace sat {
         typedef hashtable<unsigned, u_hash, u_eq> index_set;
         literal_vector m_units;
         index_set      m_unit_set;
-        literal_vector m_lits;
         vector_pool    m_pool;
         mutex          m_mux;
 
@@ -67,6 +71,7 @@ namespace sat {
         scoped_ptr<solver> m_solver_copy;
         bool               m_consumer_ready;
         svector<double>    m_priorities;
+        svector<lbool>     m_phases;
 
         scoped_limits      m_scoped_rlimit;
         vector<reslimit>   m_limits;
@@ -78,7 +83,13 @@ namespace sat {
 
         ~parallel();
 
-        void init_solvers(solver& s, unsigned num_extra_solvers);
+        // when copy is false the clauses of solver i are copied later by copy_solver.
+        void init_solvers(solver& s, unsigned num_extra_solvers, bool copy = true);
+
+        void copy_solver(solver& s, unsigned i);
+
+        // bind the calling thread to core i modulo the number of cores.
+        static void pin_thread(unsigned i);
 
         void push_child(reslimit& rl);
 
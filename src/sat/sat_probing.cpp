@@ -149,15 +149,14 @@ namespace sat {
             literal lit = s.m_trail[i];
             m_assigned.insert(lit);
 
-#if 0
             // learn equivalences during probing:
-            if (implies(lit, l)) {
+            // l implies lit by propagation and lit implies l in the binary implication graph.
+            if (m_probing_equivs && !s.m_config.m_drat && implies(lit, l)) {
                 if (nullptr == find_binary_watch(s.get_wlist(lit), l) ||
                     nullptr == find_binary_watch(s.get_wlist(~l), ~lit)) {
                     m_equivs.push_back(std::make_pair(lit, l));
                 }
             }
-#endif
         }
         cache_bins(l, old_tr_sz);
         
@@ -276,17 +275,27 @@ namespace sat {
         }
         CASSERT("probing", s.check_invariant());
         finalize();
-        if (!m_equivs.empty()) {
+        if (!m_equivs.empty() && !s.inconsistent()) {
             union_find_default_ctx ctx;
             union_find<> uf(ctx);
             for (unsigned i = 2*s.num_vars(); i--> 0; ) uf.mk_var();
+            unsigned num_merged = 0;
             for (auto const& p : m_equivs) {
                 literal l1 = p.first, l2 = p.second;
+                // the literals may have been assigned or eliminated after they were probed.
+                if (s.value(l1) != l_undef || s.value(l2) != l_undef || s.was_eliminated(l1.var()) || s.was_eliminated(l2.var()))
+                    continue;
+                if (uf.find(l1.index()) == uf.find((~l2).index()))
+                    continue;
                 uf.merge(l1.index(), l2.index());
                 uf.merge((~l1).index(), (~l2).index());
+                ++num_merged;
+            }
+            m_num_equivs += num_merged;
+            if (num_merged > 0) {
+                elim_eqs elim(s);
+                elim(uf);
             }
-            elim_eqs elim(s);
-            elim(uf);
         }
         
         return r;
@@ -303,6 +312,7 @@ namespace sat {
         m_probing_cache       = p.probing_cache();
         m_probing_binary      = p.probing_binary();
         m_probing_cache_limit = p.probing_cache_limit();
+        m_probing_equivs      = p.probing_equivs();
     }
 
     void probing::collect_param_descrs(param_descrs & d) {
@@ -317,9 +327,11 @@ namespace sat {
 
     void probing::collect_statistics(statistics & st) const {
         st.update("sat probing assigned", m_num_assigned);
+        st.update("sat probing equivs", m_num_equivs);
     }
 
     void probing::reset_statistics() {
         m_num_assigned = 0;
+        m_num_equivs = 0;
     }
 };
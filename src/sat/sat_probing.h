@@ -40,9 +40,11 @@ namespace sat {
         bool               m_probing_cache;       // cache implicit binary clauses
         bool               m_probing_binary;      // try l1 and l2 for binary clauses l1 \/ l2
         unsigned long long m_probing_cache_limit; // memory limit for enabling caching.
+        bool               m_probing_equivs;      // learn equivalences from the binary implication graph
 
         // stats
         unsigned           m_num_assigned;        
+        unsigned           m_num_equivs;
         
         struct cache_entry {
             bool           m_available;
@@ -18,6 +18,9 @@ Author:
 Revision History:
 
 --*/
+#ifndef SINGLE_THREAD
+#include <thread>
+#endif
 #include "sat/sat_simplifier.h"
 #include "sat/sat_simplifier_params.hpp"
 #include "sat/sat_solver.h"
@@ -2033,6 +2036,91 @@ namespace sat {
         return true;
     }
 
+    /**
+       \brief Return false if eliminating v by resolution on the current clauses
+       would produce more clauses than it removes.
+       It only reads the occurrences of v, so distinct variables can be checked
+       concurrently when each thread uses its own visited marks.
+    */
+    bool simplifier::may_eliminate(bool_var v, svector<char> & visited, literal_vector & lits) const {
+        literal pos_l(v, false);
+        literal neg_l(v, true);
+        clause_use_list const & pos_occs = m_use_list.get(pos_l);
+        clause_use_list const & neg_occs = m_use_list.get(neg_l);
+        unsigned num_pos = pos_occs.num_irredundant() + num_nonlearned_bin(pos_l);
+        unsigned num_neg = neg_occs.num_irredundant() + num_nonlearned_bin(neg_l);
+        if (num_pos >= m_res_occ_cutoff && num_neg >= m_res_occ_cutoff)
+            return false;
+        clause_wrapper_vector pos_cls, neg_cls;
+        for (literal l : { pos_l, neg_l }) {
+            clause_wrapper_vector & r = l == pos_l ? pos_cls : neg_cls;
+            for (auto it = m_use_list.get(l).mk_iterator(); !it.at_end(); it.next()) 
+                if (!it.curr().is_learned())
+                    r.push_back(clause_wrapper(it.curr()));
+            for (auto const & w : get_wlist(~l)) 
+                if (w.is_binary_non_learned_clause())
+                    r.push_back(clause_wrapper(l, w.get_literal()));
+        }
+        unsigned before_clauses = num_pos + num_neg;
+        unsigned after_clauses = 0;
+        for (clause_wrapper const & c1 : pos_cls) {
+            lits.reset();
+            for (unsigned i = 0; i < c1.size(); ++i) 
+                if (c1[i] != pos_l) 
+                    lits.push_back(c1[i]);
+            for (literal l : lits) 
+                visited[l.index()] = true;
+            for (clause_wrapper const & c2 : neg_cls) {
+                bool tautology = false;
+                for (unsigned i = 0; !tautology && i < c2.size(); ++i) 
+                    tautology = visited[(~c2[i]).index()] && c2[i] != neg_l;
+                if (!tautology)
+                    ++after_clauses;
+                if (after_clauses > before_clauses)
+                    break;
+            }
+            for (literal l : lits) 
+                visited[l.index()] = false;
+            if (after_clauses > before_clauses)
+                return false;
+        }
+        return true;
+    }
+
+    /**
+       \brief mark the variables in vars that may be eliminated.
+       Screening is enabled by resolution.threads > 1. Every variable is
+       checked against the same clause set, so the result does not depend
+       on the number of threads.
+    */
+    void simplifier::screen_vars_for_elim(bool_var_vector const & vars, svector<char> & candidates) const {
+        unsigned sz = vars.size();
+        candidates.reset();
+        candidates.resize(sz, true);
+        if (m_res_threads <= 1 || sz == 0)
+            return;
+        unsigned num_lits = 2 * s.num_vars();
+        auto screen = [&](unsigned lo, unsigned hi) {
+            svector<char> visited(num_lits, (char)false);
+            literal_vector lits;
+            for (unsigned i = lo; i < hi; ++i)
+                candidates[i] = may_eliminate(vars[i], visited, lits);
+        };
+#ifndef SINGLE_THREAD
+        unsigned num_threads = std::min(m_res_threads, sz / 1000 + 1);
+        if (num_threads > 1) {
+            vector<std::thread> threads;
+            unsigned block = (sz + num_threads - 1) / num_threads;
+            for (unsigned lo = 0; lo < sz; lo += block) 
+                threads.push_back(std::thread(screen, lo, std::min(sz, lo + block)));
+            for (auto & th : threads)
+                th.join();
+            return;
+        }
+#endif
+        screen(0, sz);
+    }
+
     struct simplifier::elim_var_report {
         simplifier & m_simplifier;
         stopwatch    m_watch;
@@ -2059,15 +2147,18 @@ namespace sat {
         elim_var_report rpt(*this);
         bool_var_vector vars;
         order_vars_for_elim(vars);
+        svector<char> candidates;
+        screen_vars_for_elim(vars, candidates);
         sat::elim_vars elim_bdd(*this);
-        for (bool_var v : vars) {
+        for (unsigned i = 0; i < vars.size(); ++i) {
+            bool_var v = vars[i];
             checkpoint();
             if (m_elim_counter < 0) 
                 break;
             if (is_external(v)) {
                 // skip
             }
-            else if (try_eliminate(v)) {
+            else if (candidates[i] && try_eliminate(v)) {
                 m_num_elim_vars++;
             }
             else if (elim_vars_bdd_enabled() && elim_bdd(v)) { 
@@ -2102,6 +2193,7 @@ namespace sat {
         m_res_lit_cutoff3         = p.resolution_lit_cutoff_range3();
         m_res_cls_cutoff1         = p.resolution_cls_cutoff1();
         m_res_cls_cutoff2         = p.resolution_cls_cutoff2();
+        m_res_threads             = p.resolution_threads();
         m_subsumption             = p.subsumption();
         m_subsumption_limit       = p.subsumption_limit();
         m_elim_vars               = p.elim_vars();
@@ -99,6 +99,7 @@ namespace sat {
         unsigned               m_res_lit_cutoff3;
         unsigned               m_res_cls_cutoff1;
         unsigned               m_res_cls_cutoff2;
+        unsigned               m_res_threads;
 
         bool                   m_subsumption;
         unsigned               m_subsumption_limit;
@@ -204,6 +205,8 @@ namespace sat {
         void remove_bin_clauses(literal l);
         void remove_clauses(clause_use_list const & cs, literal l);
         bool try_eliminate(bool_var v);
+        bool may_eliminate(bool_var v, svector<char> & visited, literal_vector & lits) const;
+        void screen_vars_for_elim(bool_var_vector const & vars, svector<char> & candidates) const;
         void elim_vars();
 
         struct blocked_cls_report;
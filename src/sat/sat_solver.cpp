@@ -21,11 +21,14 @@ Revision History:
 #include <cmath>
 #ifndef SINGLE_THREAD
 #include <thread>
+#include <condition_variable>
+#include "util/thread_pool.h"
 #endif
 #include "util/luby.h"
 #include "util/trace.h"
 #include "util/max_cliques.h"
 #include "util/gparams.h"
+#include "util/phase_profiler.h"
 #include "sat/sat_solver.h"
 #include "sat/sat_integrity_checker.h"
 #include "sat/sat_lookahead.h"
@@ -33,6 +36,7 @@ Revision History:
 #include "sat/sat_prob.h"
 #include "sat/sat_anf_simplifier.h"
 #include "sat/sat_cut_simplifier.h"
+#include "sat/sat_gauss_simplifier.h"
 #if defined(_MSC_VER) && !defined(_M_ARM) && !defined(_M_ARM64)
 # include <xmmintrin.h>
 #endif
@@ -56,6 +60,7 @@ namespace sat {
         m_probing(*this, p),
         m_mus(*this),
         m_binspr(*this),
+        m_vivify(*this),
         m_inconsistent(false),
         m_searching(false),
         m_conflict(justification(0)),
@@ -373,6 +378,58 @@ namespace sat {
         return mk_clause(3, ls, st);
     }
 
+    /**
+       \brief add clauses in bulk. 
+       Watch lists and the clause vector are sized up front and clauses are
+       created in the order of their first literal, so clauses that share a
+       watch literal are allocated next to each other.
+    */
+    void solver::mk_clauses(unsigned num_lits, literal const * lits, sat::status st) {
+        unsigned_vector starts;
+        unsigned_vector num_watches;
+        num_watches.resize(2 * num_vars(), 0);
+        unsigned start = 0, num_large = 0;
+        for (unsigned i = 0; i < num_lits; ++i) {
+            if (lits[i] != null_literal)
+                continue;
+            unsigned sz = i - start;
+            if (sz > 0) {
+                starts.push_back(start);
+                if (sz >= 2) {
+                    num_watches[(~lits[start]).index()]++;
+                    num_watches[(~lits[start + 1]).index()]++;
+                }
+                if (sz > 3 || (sz == 3 && !ENABLE_TERNARY))
+                    ++num_large;
+            }
+            else 
+                mk_clause(0, nullptr, st);
+            start = i + 1;
+        }
+        SASSERT(start == num_lits);
+        // vector::reserve changes the size, grow the capacity by resizing and shrinking back.
+        watched dummy(null_literal, false);
+        for (unsigned l = 0; l < num_watches.size(); ++l) {
+            if (num_watches[l] == 0)
+                continue;
+            watch_list& wlist = m_watches[l];
+            unsigned sz = wlist.size();
+            wlist.resize(sz + num_watches[l], dummy);
+            wlist.shrink(sz);
+        }
+        unsigned old_sz = m_clauses.size();
+        m_clauses.resize(old_sz + num_large, nullptr);
+        m_clauses.shrink(old_sz);
+        std::stable_sort(starts.begin(), starts.end(), [&](unsigned a, unsigned b) { return lits[a].index() < lits[b].index(); });
+        literal_vector cls;
+        for (unsigned s : starts) {
+            cls.reset();
+            for (unsigned i = s; lits[i] != null_literal; ++i)
+                cls.push_back(lits[i]);
+            mk_clause(cls.size(), cls.data(), st);
+        }
+    }
+
     void solver::del_clause(clause& c) {
         if (!c.is_learned()) {
             m_stats.m_non_learned_generation++;
@@ -709,14 +766,19 @@ namespace sat {
 
     bool solver::should_defrag() {
         if (m_defrag_threshold > 0) --m_defrag_threshold;
-        return m_defrag_threshold == 0 && m_config.m_gc_defrag;
+        if (!m_config.m_gc_defrag)
+            return false;
+        if (m_config.m_gc_defrag_ratio > 0) 
+            return cls_allocator().fragmentation() >= m_config.m_gc_defrag_ratio;
+        return m_defrag_threshold == 0;
     }
 
     void solver::defrag_clauses() {
         m_defrag_threshold = 2;
         if (memory_pressure()) return;
         pop(scope_lvl());
-        IF_VERBOSE(2, verbose_stream() << "(sat-defrag)\n");
+        IF_VERBOSE(2, verbose_stream() << "(sat-defrag :fragmentation " << cls_allocator().fragmentation() << ")\n");
+        m_stats.m_defrag++;
         clause_allocator& alloc = m_cls_allocator[!m_cls_allocator_idx];
         ptr_vector<clause> new_clauses, new_learned;
         for (clause* c : m_clauses) c->unmark_used();
@@ -979,15 +1041,8 @@ namespace sat {
             }
         }
         
-        if (m_config.m_propagate_prefetch) {
-#if defined(__GNUC__) || defined(__clang__)
-            __builtin_prefetch((const char*)((m_watches[l.index()].data())));
-#else
-    #if !defined(_M_ARM) && !defined(_M_ARM64)
-            _mm_prefetch((const char*)((m_watches[l.index()].data())), _MM_HINT_T1);
-    #endif
-#endif
-        }
+        if (m_config.m_propagate_prefetch) 
+            prefetch(m_watches[l.index()].data());
 
         SASSERT(!l.sign() || !m_phase[v]);
         SASSERT(l.sign()  || m_phase[v]);
@@ -1019,6 +1074,25 @@ namespace sat {
     //
     // -----------------------
 
+    void solver::prefetch(void const* p) {
+#if defined(__GNUC__) || defined(__clang__)
+        __builtin_prefetch((const char*)p);
+#else
+    #if !defined(_M_ARM) && !defined(_M_ARM64)
+        _mm_prefetch((const char*)p, _MM_HINT_T1);
+    #endif
+#endif
+    }
+
+    /**
+       \brief request the clause of a watch that is going to be visited shortly.
+       Clauses whose blocked literal is true are skipped without being touched.
+    */
+    void solver::prefetch_clause(watched const& w) {
+        if (w.is_clause() && value(w.get_blocked_literal()) != l_true)
+            prefetch(&get_clause(w.get_clause_offset()));
+    }
+
     bool solver::propagate_core(bool update) {
         while (m_qhead < m_trail.size() && !m_inconsistent) {
             do {
@@ -1073,7 +1147,13 @@ namespace sat {
                     *it2 = *it;                 \
                 wlist.set_end(it2);             \
             }
+        bool prefetch_clauses = m_config.m_propagate_prefetch;
+        if (prefetch_clauses) 
+            for (unsigned i = 0; i < PREFETCH_DISTANCE && it + i != end; ++i)
+                prefetch_clause(it[i]);
         for (; it != end; ++it) {
+            if (prefetch_clauses && end - it > PREFETCH_DISTANCE)
+                prefetch_clause(it[PREFETCH_DISTANCE]);
             switch (it->get_kind()) {
             case watched::BINARY:
                 l1 = it->get_literal();
@@ -1271,6 +1351,18 @@ namespace sat {
         return result;
     }
 
+    lbool solver::cubes(bool_var_vector& vars, unsigned max_cubes, unsigned backtrack_level, vector<literal_vector>& cubes) {
+        literal_vector lits;
+        for (unsigned i = 0; i < max_cubes; ++i) {
+            lbool r = cube(vars, lits, backtrack_level);
+            if (r != l_undef || lits.empty())
+                return r;
+            cubes.push_back(lits);
+            backtrack_level = UINT_MAX;
+        }
+        return l_undef;
+    }
+
 
     // -----------------------
     //
@@ -1278,6 +1370,8 @@ namespace sat {
     //
     // -----------------------
     lbool solver::check(unsigned num_lits, literal const* lits) {
+        scoped_phase _phase("sat");
+        scoped_rlimit_account _account(rlimit(), "sat", m_config.m_budget);
         init_reason_unknown();
         pop_to_base_level();
         m_stats.m_units = init_trail_size();
@@ -1478,7 +1572,10 @@ namespace sat {
 
         sat::parallel par(*this);
         par.reserve(num_threads, 1 << 12);
-        par.init_solvers(*this, num_extra_solvers);
+        // with thread affinity each auxiliary solver copies the clauses in
+        // its own thread, so its memory is allocated close to the core that uses it.
+        bool affinity = m_config.m_threads_affinity;
+        par.init_solvers(*this, num_extra_solvers, !affinity);
         for (unsigned i = 0; i < ls.size(); ++i) {
             par.push_child(ls[i]->rlimit());
         }
@@ -1495,10 +1592,36 @@ namespace sat {
         lbool result = l_undef;
         bool canceled = false;
         std::mutex mux;
+        std::condition_variable copied;
+        int num_uncopied = affinity ? num_extra_solvers : 0;
 
         auto worker_thread = [&](int i) {
             try {
                 lbool r = l_undef;
+                if (affinity) {
+                    parallel::pin_thread(i);
+                    if (IS_AUX_SOLVER(i)) {
+                        // the main solver is not modified until all copies are done.
+                        bool ok = false;
+                        try {
+                            par.copy_solver(*this, i);
+                            ok = true;
+                        }
+                        catch (...) {
+                        }
+                        {
+                            std::lock_guard<std::mutex> lock(mux);
+                            --num_uncopied;
+                        }
+                        copied.notify_all();
+                        if (!ok)
+                            return;
+                    }
+                    else if (IS_MAIN_SOLVER(i)) {
+                        std::unique_lock<std::mutex> lock(mux);
+                        copied.wait(lock, [&]() { return num_uncopied == 0; });
+                    }
+                }
                 if (IS_AUX_SOLVER(i)) {
                     r = par.get_solver(i).check(num_lits, lits);
                 }
@@ -1552,13 +1675,11 @@ namespace sat {
             return l_undef;
         }
 
-        vector<std::thread> threads(num_threads);
+        thread_pool threads;
         for (int i = 0; i < num_threads; ++i) {
-            threads[i] = std::thread([&, i]() { worker_thread(i); });
-        }
-        for (auto & th : threads) {
-            th.join();
+            threads.run([&, i]() { worker_thread(i); });
         }
+        threads.join();
         
         if (IS_AUX_SOLVER(finished_id)) {
             m_stats = par.get_solver(finished_id).m_stats;
@@ -1963,6 +2084,41 @@ namespace sat {
     bool solver::should_simplify() const {
         return m_conflicts_since_init >= m_next_simplify && m_simplify_enabled;
     }
+    static char const* s_inprocess_phases[] = {
+        "sat.scc", "sat.simplifier", "sat.probing", "sat.asymm-branch", "sat.vivify",
+        "sat.lookahead", "sat.binspr", "sat.anf", "sat.gauss", "sat.cut"
+    };
+
+    struct solver::inprocess_profile {
+        solver&   s;
+        inprocess_stats* m_stats;
+        unsigned  m_num_clauses;
+        stopwatch m_watch;
+        scoped_phase m_phase;
+        inprocess_profile(solver& s, inprocess_pass p):
+            s(s),
+            m_stats(s.m_config.m_inprocess_profile ? s.m_inprocess_stats + p : nullptr),
+            m_num_clauses(0),
+            m_phase(s_inprocess_phases[p]) {
+            if (m_stats) {
+                m_num_clauses = s.num_clauses();
+                m_watch.start();
+            }
+        }
+        ~inprocess_profile() {
+            if (!m_stats)
+                return;
+            m_watch.stop();
+            unsigned num_clauses = s.num_clauses();
+            m_stats->m_calls++;
+            m_stats->m_time += m_watch.get_seconds();
+            if (num_clauses < m_num_clauses)
+                m_stats->m_removed += m_num_clauses - num_clauses;
+            else
+                m_stats->m_added += num_clauses - m_num_clauses;
+        }
+    };
+
     /**
        \brief Apply all simplifications.
     */
@@ -1995,29 +2151,47 @@ namespace sat {
         m_cleaner(m_config.m_force_cleanup);
         CASSERT("sat_simplify_bug", check_invariant());
 
-        m_scc();
+        {
+            inprocess_profile _p(*this, IP_SCC);
+            m_scc();
+        }
         CASSERT("sat_simplify_bug", check_invariant());
 
         if (m_ext) {
             m_ext->pre_simplify();
         }
       
-        m_simplifier(false);
+        {
+            inprocess_profile _p(*this, IP_SIMPLIFIER);
+            m_simplifier(false);
 
-        CASSERT("sat_simplify_bug", check_invariant());
-        CASSERT("sat_missed_prop", check_missed_propagation());
-        if (!m_learned.empty()) {
-            m_simplifier(true);
-            CASSERT("sat_missed_prop", check_missed_propagation());
             CASSERT("sat_simplify_bug", check_invariant());
+            CASSERT("sat_missed_prop", check_missed_propagation());
+            if (!m_learned.empty()) {
+                m_simplifier(true);
+                CASSERT("sat_missed_prop", check_missed_propagation());
+                CASSERT("sat_simplify_bug", check_invariant());
+            }
         }
         sort_watch_lits();
         CASSERT("sat_simplify_bug", check_invariant());
 
-        m_probing();
+        {
+            inprocess_profile _p(*this, IP_PROBING);
+            m_probing();
+        }
         CASSERT("sat_missed_prop", check_missed_propagation());
         CASSERT("sat_simplify_bug", check_invariant());
-        m_asymm_branch(false);
+        {
+            inprocess_profile _p(*this, IP_ASYMM_BRANCH);
+            m_asymm_branch(false);
+        }
+        CASSERT("sat_missed_prop", check_missed_propagation());
+        CASSERT("sat_simplify_bug", check_invariant());
+        if (m_config.m_vivify && !inconsistent()) {
+            inprocess_profile _p(*this, IP_VIVIFY);
+            m_vivify();
+        }
 
         CASSERT("sat_missed_prop", check_missed_propagation());
         CASSERT("sat_simplify_bug", check_invariant());
@@ -2026,6 +2200,7 @@ namespace sat {
             m_ext->simplify();
         }
         if (m_config.m_lookahead_simplify && !m_ext) {
+            inprocess_profile _p(*this, IP_LOOKAHEAD);
             lookahead lh(*this);
             lh.simplify(true);
             lh.collect_statistics(m_aux_stats);
@@ -2051,10 +2226,12 @@ namespace sat {
         }
 
         if (m_config.m_binspr && !inconsistent()) {
+            inprocess_profile _p(*this, IP_BINSPR);
             m_binspr();
         }
 
         if (m_config.m_anf_simplify && m_simplifications > m_config.m_anf_delay && !inconsistent()) {
+            inprocess_profile _p(*this, IP_ANF);
             anf_simplifier anf(*this);
             anf_simplifier::config cfg;
             cfg.m_enable_exlin = m_config.m_anf_exlin;
@@ -2062,8 +2239,16 @@ namespace sat {
             anf.collect_statistics(m_aux_stats);
             // TBD: throttle anf_delay based on yield
         }
+
+        if (m_config.m_gauss_simplify && m_simplifications > m_config.m_gauss_delay && !inconsistent()) {
+            inprocess_profile _p(*this, IP_GAUSS);
+            gauss_simplifier gauss(*this, m_config.m_gauss_max_xors);
+            gauss();
+            gauss.collect_statistics(m_aux_stats);
+        }
         
         if (m_cut_simplifier && m_simplifications > m_config.m_cut_delay && !inconsistent()) {
+            inprocess_profile _p(*this, IP_CUT);
             (*m_cut_simplifier)();
         }
 
@@ -2602,6 +2787,11 @@ namespace sat {
         
         if (use_backjumping(num_scopes)) {
             ++m_stats.m_backjumps;
+            if (m_config.m_backtrack_reuse_trail && !m_ext && backtrack_lvl > backjump_lvl) {
+                unsigned reused = num_reusable_scopes(backjump_lvl, backtrack_lvl - 1);
+                m_stats.m_reused_scopes += reused;
+                num_scopes -= reused;
+            }
             pop_reinit(num_scopes);
         }
         else {
@@ -2628,6 +2818,34 @@ namespace sat {
             (num_scopes <= m_config.m_backtrack_scopes || !allow_backtracking());
     }
 
+    /**
+       \brief number of decision levels above backjump_lvl, up to max_lvl, that can be kept.
+       A level is kept when its decision variable is at least as active as the
+       best unassigned variable, because the levels would be decided again in
+       the same order after backjumping.
+    */
+    unsigned solver::num_reusable_scopes(unsigned backjump_lvl, unsigned max_lvl) {
+        bool_var next = null_bool_var;
+        while (!m_case_split_queue.empty()) {
+            bool_var v = m_case_split_queue.min_var();
+            if (value(v) == l_undef && !was_eliminated(v)) {
+                next = v;
+                break;
+            }
+            // assigned variables are re-inserted when they are unassigned.
+            m_case_split_queue.next_var();
+        }
+        unsigned level = backjump_lvl;
+        for (; level < max_lvl; ++level) {
+            unsigned lim = m_scopes[level].m_trail_lim;
+            if (lim >= m_trail.size())
+                break;
+            if (next != null_bool_var && m_activity[m_trail[lim].var()] < m_activity[next])
+                break;
+        }
+        return level - backjump_lvl;
+    }
+
     bool solver::allow_backtracking() const {
         return m_conflicts_since_init > m_config.m_backtrack_init_conflicts;
     }
@@ -3777,10 +3995,29 @@ namespace sat {
         m_scc.collect_statistics(st);
         m_asymm_branch.collect_statistics(st);
         m_probing.collect_statistics(st);
+        m_vivify.collect_statistics(st);
         if (m_ext) m_ext->collect_statistics(st);
         if (m_local_search) m_local_search->collect_statistics(st);
         if (m_cut_simplifier) m_cut_simplifier->collect_statistics(st);
         st.copy(m_aux_stats);
+        if (m_config.m_inprocess_profile) {
+            // statistics keeps the key pointers, so the keys have to be literals.
+#define IP_KEYS(_n_) { "sat inprocess " _n_ " calls", "sat inprocess " _n_ " time", "sat inprocess " _n_ " removed", "sat inprocess " _n_ " added" }
+            static char const* keys[IP_NUM_PASSES][4] = {
+                IP_KEYS("scc"), IP_KEYS("simplifier"), IP_KEYS("probing"), IP_KEYS("asymm-branch"), IP_KEYS("vivify"),
+                IP_KEYS("lookahead"), IP_KEYS("binspr"), IP_KEYS("anf"), IP_KEYS("gauss"), IP_KEYS("cut")
+            };
+#undef IP_KEYS
+            for (unsigned i = 0; i < IP_NUM_PASSES; ++i) {
+                inprocess_stats const& s = m_inprocess_stats[i];
+                if (s.m_calls == 0)
+                    continue;
+                st.update(keys[i][0], s.m_calls);
+                st.update(keys[i][1], s.m_time);
+                st.update(keys[i][2], s.m_removed);
+                st.update(keys[i][3], s.m_added);
+            }
+        }
     }
 
     void solver::reset_statistics() {
@@ -3789,7 +4026,10 @@ namespace sat {
         m_simplifier.reset_statistics();
         m_asymm_branch.reset_statistics();
         m_probing.reset_statistics();
+        m_vivify.reset_statistics();
         m_aux_stats.reset();
+        for (inprocess_stats& s : m_inprocess_stats)
+            s = inprocess_stats();
     }
 
     // -----------------------
@@ -3990,6 +4230,25 @@ namespace sat {
 
     void solver::display_dimacs(std::ostream & out) const {
         out << "p cnf " << num_vars() << " " << num_clauses() << "\n";
+        display_dimacs_clauses(out);
+    }
+
+    /**
+       \brief display the clauses followed by one assumption line per cube,
+       in the incremental DIMACS format read by incremental solvers.
+    */
+    void solver::display_icnf(std::ostream & out, vector<literal_vector> const& cubes) const {
+        out << "p inccnf\n";
+        display_dimacs_clauses(out);
+        for (literal_vector const& cube : cubes) {
+            out << "a";
+            for (literal l : cube)
+                out << " " << dimacs_lit(l);
+            out << " 0\n";
+        }
+    }
+
+    void solver::display_dimacs_clauses(std::ostream & out) const {
         for (literal lit : m_trail) {
             out << dimacs_lit(lit) << " 0\n";
         }
@@ -4769,6 +5028,8 @@ namespace sat {
         st.update("sat elim bool vars bdd", m_elim_var_bdd);
         st.update("sat backjumps", m_backjumps);
         st.update("sat backtracks", m_backtracks);
+        st.update("sat defrag", m_defrag);
+        st.update("sat reused scopes", m_reused_scopes);
     }
 
     void stats::reset() {
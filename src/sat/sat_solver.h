@@ -42,6 +42,7 @@ Revision History:
 #include "sat/sat_probing.h"
 #include "sat/sat_mus.h"
 #include "sat/sat_binspr.h"
+#include "sat/sat_vivify.h"
 #include "sat/sat_drat.h"
 #include "sat/sat_parallel.h"
 #include "sat/sat_local_search.h"
@@ -78,6 +79,8 @@ namespace sat {
         unsigned m_units;
         unsigned m_backtracks;
         unsigned m_backjumps;
+        unsigned m_defrag;
+        unsigned m_reused_scopes;
         stats() { reset(); }
         void reset();
         void collect_statistics(statistics & st) const;
@@ -114,6 +117,7 @@ namespace sat {
         bool                    m_is_probing { false };
         mus                     m_mus;           // MUS for minimal core extraction
         binspr                  m_binspr;
+        vivify                  m_vivify;
         bool                    m_inconsistent;
         bool                    m_searching;
         // A conflict is usually a single justification. That is, a justification
@@ -205,6 +209,17 @@ namespace sat {
 
         statistics              m_aux_stats;
 
+        // cost and effect of the inprocessing passes, collected when sat.inprocess.profile is set.
+        enum inprocess_pass { IP_SCC, IP_SIMPLIFIER, IP_PROBING, IP_ASYMM_BRANCH, IP_VIVIFY, IP_LOOKAHEAD, IP_BINSPR, IP_ANF, IP_GAUSS, IP_CUT, IP_NUM_PASSES };
+        struct inprocess_stats {
+            unsigned m_calls   { 0 };
+            unsigned m_removed { 0 };
+            unsigned m_added   { 0 };
+            double   m_time    { 0 };
+        };
+        inprocess_stats         m_inprocess_stats[IP_NUM_PASSES];
+        struct inprocess_profile;
+
         void del_clauses(clause_vector& clauses);
 
         friend class integrity_checker;
@@ -212,6 +227,7 @@ namespace sat {
         friend class asymm_branch;
         friend class big;
         friend class binspr;
+        friend class vivify;
         friend class drat;
         friend class elim_eqs;
         friend class bcd;
@@ -275,6 +291,9 @@ namespace sat {
         clause* mk_clause(literal l1, literal l2, sat::status st = sat::status::asserted());
         clause* mk_clause(literal l1, literal l2, literal l3, sat::status st = sat::status::asserted());
 
+        // add the clauses in lits, each clause is terminated by null_literal.
+        void mk_clauses(unsigned num_lits, literal const * lits, sat::status st = sat::status::asserted());
+
         random_gen& rand() { return m_rand; }
 
     protected:
@@ -469,6 +488,10 @@ namespace sat {
         bool should_propagate() const;
         bool propagate_core(bool update);
         bool propagate_literal(literal l, bool update);
+        // number of watches between a prefetched clause and its use in propagate_literal
+        static const unsigned PREFETCH_DISTANCE = 4;
+        static void prefetch(void const* p);
+        void prefetch_clause(watched const& w);
         
         // -----------------------
         //
@@ -512,6 +535,13 @@ namespace sat {
         void set_activity(bool_var v, unsigned act);
 
         lbool  cube(bool_var_vector& vars, literal_vector& lits, unsigned backtrack_level);
+
+        /**
+           \brief produce up to max_cubes cubes with the same lookahead state.
+           The cubes found are appended to cubes. The result is l_undef unless the
+           lookahead solver closed the search space or found a model.
+        */
+        lbool  cubes(bool_var_vector& vars, unsigned max_cubes, unsigned backtrack_level, vector<literal_vector>& cubes);
         
         void display_lookahead_scores(std::ostream& out);
 
@@ -592,6 +622,7 @@ namespace sat {
         void gc_psm();
         void gc_glue_psm();
         void gc_psm_glue();
+        void gc_tiered();
         void save_psm();
         void gc_half(char const * st_name);
         void gc_dyn_psm();
@@ -633,6 +664,7 @@ namespace sat {
         literal_vector m_lemma;
         literal_vector m_ext_antecedents;
         bool use_backjumping(unsigned num_scopes) const;
+        unsigned num_reusable_scopes(unsigned backjump_lvl, unsigned max_lvl);
         bool allow_backtracking() const;
         bool resolve_conflict();
         lbool resolve_conflict_core();
@@ -827,6 +859,8 @@ namespace sat {
         void display_watches(std::ostream & out) const;
         void display_watches(std::ostream & out, literal lit) const;
         void display_dimacs(std::ostream & out) const;
+        void display_icnf(std::ostream & out, vector<literal_vector> const& cubes) const;
+        void display_dimacs_clauses(std::ostream & out) const;
         std::ostream& display_model(std::ostream& out) const;
         void display_wcnf(std::ostream & out, unsigned sz, literal const* lits, unsigned const* weights) const;
         void display_assignment(std::ostream & out) const;
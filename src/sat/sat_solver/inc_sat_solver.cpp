@@ -462,6 +462,60 @@ public:
         }
         return fmls;
     }
+
+    void cubes(expr_ref_vector& vs, unsigned backtrack_level, unsigned max_cubes, vector<expr_ref_vector>& result) override {
+        if (!is_internalized()) {
+            lbool r = internalize_formulas();
+            if (r != l_true) {
+                IF_VERBOSE(0, verbose_stream() << "internalize produced " << r << "\n");
+                result.push_back(expr_ref_vector(m));
+                return;
+            }
+        }
+        convert_internalized();
+        if (m_solver.inconsistent()) {
+            result.push_back(last_cube(false));
+            return;
+        }
+        obj_hashtable<expr> _vs;
+        for (expr* v : vs) _vs.insert(v);
+        sat::bool_var_vector vars;
+        for (auto& kv : m_map) {
+            if (_vs.empty() || _vs.contains(kv.m_key))
+                vars.push_back(kv.m_value);
+        }
+        vector<sat::literal_vector> lcubes;
+        lbool r = m_solver.cubes(vars, max_cubes, backtrack_level, lcubes);
+        expr_ref_vector lit2expr(m);
+        lit2expr.resize(m_solver.num_vars() * 2);
+        m_map.mk_inv(lit2expr);
+        for (sat::literal_vector const& lits : lcubes) {
+            expr_ref_vector fmls(m);
+            for (sat::literal l : lits) 
+                fmls.push_back(lit2expr.get(l.index()));
+            result.push_back(fmls);
+        }
+        vs.reset();
+        for (sat::bool_var v : vars) {
+            expr* x = lit2expr[sat::literal(v, false).index()].get();
+            if (x) 
+                vs.push_back(x);
+        }
+        switch (r) {
+        case l_true:
+            result.push_back(last_cube(true));
+            break;
+        case l_false: 
+            result.push_back(last_cube(false));
+            break;
+        default: 
+            if (lcubes.size() < max_cubes) {
+                set_reason_unknown(m_solver.get_reason_unknown());
+                result.push_back(expr_ref_vector(m));
+            }
+            break;
+        }
+    }
     
     lbool get_consequences_core(expr_ref_vector const& assumptions, expr_ref_vector const& vars, expr_ref_vector& conseq) override {
         init_preprocess();
@@ -682,6 +736,10 @@ public:
     void user_propagate_register_diseq(solver::eq_eh_t& diseq_eh) override {
         ensure_euf()->user_propagate_register_diseq(diseq_eh);
     }
+
+    void user_propagate_register_batch(solver::batch_eh_t& batch_eh) override {
+        ensure_euf()->user_propagate_register_batch(batch_eh);
+    }
     
     unsigned user_propagate_register(expr* e) override { 
         return ensure_euf()->user_propagate_register(e);
@@ -90,6 +90,8 @@ namespace sat {
         virtual model const& get_model() const = 0;
         virtual void collect_statistics(statistics& st) const = 0;        
         virtual double get_priority(bool_var v) const { return 0; }
+        // phase suggested to the CDCL solver, l_undef if there is none.
+        virtual lbool get_phase(bool_var v) const { return l_undef; }
 
     };
 
@@ -0,0 +1,272 @@
+/*++
+Copyright (c) 2021 Microsoft Corporation
+
+Module Name:
+
+    sat_vivify.cpp
+
+Abstract:
+
+    Vivification of learned clauses.
+
+--*/
+#include "sat/sat_vivify.h"
+#include "sat/sat_solver.h"
+#include "util/stopwatch.h"
+#include "util/trace.h"
+
+namespace sat {
+
+    struct vivify::report {
+        vivify&   m_vivify;
+        stopwatch m_watch;
+        unsigned  m_num_strengthened;
+        unsigned  m_num_removed_lits;
+        report(vivify& v):
+            m_vivify(v),
+            m_num_strengthened(v.m_num_strengthened),
+            m_num_removed_lits(v.m_num_removed_lits) {
+            m_watch.start();
+        }
+        ~report() {
+            m_watch.stop();
+            IF_VERBOSE(2,
+                       verbose_stream() << " (sat-vivify :strengthened " << (m_vivify.m_num_strengthened - m_num_strengthened)
+                       << " :elim-literals " << (m_vivify.m_num_removed_lits - m_num_removed_lits)
+                       << mem_stat()
+                       << m_watch << ")\n";);
+        }
+    };
+
+    bool vivify::is_candidate(clause const& c) const {
+        return
+            c.is_learned() &&
+            !c.was_removed() &&
+            !c.frozen() &&
+            c.size() > 2 &&
+            c.glue() <= s.get_config().m_vivify_glue;
+    }
+
+    /**
+       \brief lexicographic order on the ordered literals of candidates i and j.
+    */
+    bool vivify::less_than(unsigned i, unsigned j) const {
+        literal const* l1 = m_lits.data() + m_begin[i];
+        literal const* e1 = m_lits.data() + m_begin[i + 1];
+        literal const* l2 = m_lits.data() + m_begin[j];
+        literal const* e2 = m_lits.data() + m_begin[j + 1];
+        for (; l1 != e1 && l2 != e2; ++l1, ++l2)
+            if (*l1 != *l2)
+                return l1->index() < l2->index();
+        return l1 == e1 && l2 != e2;
+    }
+
+    void vivify::backtrack(unsigned num_scopes) {
+        SASSERT(num_scopes <= m_path.size());
+        s.pop(num_scopes);
+        m_path.shrink(m_path.size() - num_scopes);
+        m_decided.shrink(m_path.size());
+    }
+
+    /**
+       \brief keep the scopes for the longest prefix of lits that is on the path.
+    */
+    unsigned vivify::reuse_prefix(literal const* lits, unsigned n) {
+        unsigned k = 0;
+        while (k < n && k < m_path.size() && m_path[k] == lits[k])
+            ++k;
+        backtrack(m_path.size() - k);
+        return k;
+    }
+
+    /**
+       \brief vivify c using the ordered literals lits.
+       Return false if c was deleted.
+    */
+    bool vivify::process(clause& c, literal const* lits, unsigned n) {
+        for (literal l : c) {
+            if (s.value(l) == l_true && s.lvl(l) == 0) {
+                backtrack(m_path.size());
+                s.detach_clause(c);
+                s.del_clause(c);
+                return false;
+            }
+        }
+        unsigned i = reuse_prefix(lits, n);
+        literal true_lit = null_literal;
+        bool conflict = false;
+        for (; i < n && !conflict; ++i) {
+            literal l = lits[i];
+            lbool val = s.value(l);
+            if (val == l_true) {
+                true_lit = l;
+                break;
+            }
+            s.push();
+            m_path.push_back(l);
+            m_decided.push_back(val == l_undef);
+            if (val == l_undef) {
+                unsigned sz = s.m_trail.size();
+                s.assign_scoped(~l);
+                s.propagate_core(false);
+                m_budget -= s.m_trail.size() - sz;
+                conflict = s.inconsistent();
+            }
+        }
+        if (conflict)
+            backtrack(1);
+        else if (true_lit == null_literal)
+            return true;
+
+        // the clause is implied by the decided literals and the true literal.
+        m_keep.reset();
+        for (unsigned j = 0; j < i && j < m_path.size(); ++j)
+            if (m_decided[j])
+                m_keep.push_back(m_path[j]);
+        if (conflict)
+            m_keep.push_back(lits[i - 1]);
+        else
+            m_keep.push_back(true_lit);
+        if (m_keep.size() >= c.size())
+            return true;
+        TRACE("sat_vivify", tout << c << " -> " << m_keep << "\n";);
+        backtrack(m_path.size());
+        return strengthen(c);
+    }
+
+    /**
+       \brief replace c by the literals in m_keep that are not false at the base level.
+       Return false if c was deleted.
+    */
+    bool vivify::strengthen(clause& c) {
+        SASSERT(s.at_base_lvl());
+        scoped_detach scoped_d(s, c);
+        m_mark.reserve(2 * s.num_vars(), false);
+        for (literal l : m_keep)
+            m_mark[l.index()] = true;
+        unsigned old_sz = c.size(), new_sz = 0;
+        bool is_sat = false;
+        for (unsigned i = 0; i < old_sz; ++i) {
+            literal l = c[i];
+            if (!m_mark[l.index()] || s.value(l) == l_false)
+                continue;
+            if (s.value(l) == l_true)
+                is_sat = true;
+            std::swap(c[i], c[new_sz++]);
+        }
+        for (literal l : m_keep)
+            m_mark[l.index()] = false;
+        if (is_sat) {
+            scoped_d.del_clause();
+            return false;
+        }
+        ++m_num_strengthened;
+        m_num_removed_lits += old_sz - new_sz;
+        switch (new_sz) {
+        case 0:
+            s.set_conflict();
+            return true;
+        case 1:
+            s.assign_unit(c[0]);
+            s.propagate_core(false);
+            scoped_d.del_clause();
+            return false;
+        case 2:
+            s.mk_bin_clause(c[0], c[1], c.is_learned());
+            if (s.m_trail.size() > s.m_qhead)
+                s.propagate_core(false);
+            scoped_d.del_clause();
+            return false;
+        default:
+            s.shrink(c, old_sz, new_sz);
+            return true;
+        }
+    }
+
+    void vivify::operator()() {
+        if (!s.get_config().m_vivify)
+            return;
+        s.propagate(false);
+        if (s.inconsistent())
+            return;
+        SASSERT(s.at_base_lvl());
+        report rpt(*this);
+        m_budget = s.get_config().m_vivify_limit;
+
+        // move the candidates to the front of the learned clauses
+        clause_vector& learned = s.m_learned;
+        unsigned num_candidates = 0;
+        for (unsigned i = 0; i < learned.size(); ++i)
+            if (is_candidate(*learned[i]))
+                std::swap(learned[i], learned[num_candidates++]);
+        if (num_candidates == 0)
+            return;
+
+        // order the literals of each candidate by occurrences
+        m_count.reset();
+        m_count.resize(2 * s.num_vars(), 0);
+        for (unsigned i = 0; i < num_candidates; ++i)
+            for (literal l : *learned[i])
+                m_count[l.index()]++;
+        m_lits.reset();
+        m_begin.reset();
+        for (unsigned i = 0; i < num_candidates; ++i) {
+            m_begin.push_back(m_lits.size());
+            unsigned sz = m_lits.size();
+            for (literal l : *learned[i])
+                m_lits.push_back(l);
+            std::sort(m_lits.begin() + sz, m_lits.end(), [&](literal a, literal b) {
+                    unsigned ca = m_count[a.index()], cb = m_count[b.index()];
+                    return ca > cb || (ca == cb && a.index() < b.index());
+                });
+        }
+        m_begin.push_back(m_lits.size());
+        unsigned_vector order;
+        for (unsigned i = 0; i < num_candidates; ++i)
+            order.push_back(i);
+        std::sort(order.begin(), order.end(), [&](unsigned i, unsigned j) { return less_than(i, j); });
+        ptr_vector<clause> candidates;
+        for (unsigned i : order)
+            candidates.push_back(learned[i]);
+        for (unsigned i = 0; i < num_candidates; ++i)
+            learned[i] = candidates[i];
+
+        bool_vector saved_phase(s.m_phase);
+        flet<bool> _is_probing(s.m_is_probing, true);
+        unsigned i = 0, j = 0, sz = learned.size();
+        try {
+            for (; i < num_candidates && m_budget > 0 && !s.inconsistent(); ++i) {
+                s.checkpoint();
+                clause& c = *learned[i];
+                unsigned b = m_begin[order[i]], e = m_begin[order[i] + 1];
+                if (process(c, m_lits.data() + b, e - b))
+                    learned[j++] = &c;
+            }
+        }
+        catch (solver_exception&) {
+            backtrack(m_path.size());
+            for (; i < sz; ++i)
+                learned[j++] = learned[i];
+            learned.shrink(j);
+            s.m_phase = saved_phase;
+            throw;
+        }
+        backtrack(m_path.size());
+        for (; i < sz; ++i)
+            learned[j++] = learned[i];
+        learned.shrink(j);
+        s.m_phase = saved_phase;
+        s.propagate(false);
+        CASSERT("sat_vivify", s.check_invariant());
+    }
+
+    void vivify::collect_statistics(statistics& st) const {
+        st.update("sat vivify strengthened", m_num_strengthened);
+        st.update("sat vivify elim literals", m_num_removed_lits);
+    }
+
+    void vivify::reset_statistics() {
+        m_num_strengthened = 0;
+        m_num_removed_lits = 0;
+    }
+};
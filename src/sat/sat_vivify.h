@@ -0,0 +1,65 @@
+/*++
+Copyright (c) 2021 Microsoft Corporation
+
+Module Name:
+
+    sat_vivify.h
+
+Abstract:
+
+    Vivification of learned clauses.
+
+    A learned clause C with small LBD is strengthened by assigning the
+    negations of its literals one by one and propagating:
+    - if a literal of C becomes true, C is replaced by the decided
+      literals together with the true literal.
+    - if propagation produces a conflict, C is replaced by the decided
+      literals.
+    - literals that become false without being decided are removed.
+
+    Literals of each clause are ordered by their number of occurrences in
+    the candidate clauses and clauses are processed in lexicographic order,
+    so the decisions shared with the previous clause are kept on the trail.
+
+--*/
+#pragma once
+
+#include "util/statistics.h"
+#include "sat/sat_types.h"
+
+namespace sat {
+    class solver;
+
+    class vivify {
+        struct report;
+
+        solver&         s;
+        int64_t         m_budget { 0 };
+        unsigned_vector m_count;      // occurrences of literals in candidate clauses
+        literal_vector  m_lits;       // ordered literals of candidate clauses
+        unsigned_vector m_begin;      // start of candidate literals in m_lits
+        literal_vector  m_path;       // literals decided or skipped at each scope
+        bool_vector     m_decided;    // whether the negation of m_path[i] was decided
+        literal_vector  m_keep;
+        bool_vector     m_mark;
+
+        // stats
+        unsigned        m_num_strengthened { 0 };
+        unsigned        m_num_removed_lits { 0 };
+
+        bool is_candidate(clause const& c) const;
+        bool less_than(unsigned i, unsigned j) const;
+        unsigned reuse_prefix(literal const* lits, unsigned n);
+        void backtrack(unsigned num_scopes);
+        bool process(clause& c, literal const* lits, unsigned n);
+        bool strengthen(clause& c);
+
+    public:
+        vivify(solver& s): s(s) {}
+
+        void operator()();
+
+        void collect_statistics(statistics& st) const;
+        void reset_statistics();
+    };
+};
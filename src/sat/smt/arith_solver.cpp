@@ -72,6 +72,15 @@ namespace arith {
         // clone rows into m_solver, m_nla, m_lia
         // NOT_IMPLEMENTED_YET();
 
+        // the clone keeps the numbering of theory variables, so the basis
+        // of this solver is used to warm start simplex in the clone.
+        for (theory_var w = 0; w < static_cast<theory_var>(get_num_vars()); ++w) {
+            if (!is_registered_var(w))
+                continue;
+            lpvar j = get_lpvar(w);
+            result->m_basis_hints.push_back(lp::lar_solver::column_hint(w, lp().is_base(j), lp().get_column_value(j)));
+        }
+
         return result;        
     }
 
@@ -1087,8 +1096,21 @@ namespace arith {
         }
     }
 
+    void solver::apply_basis_hints() {
+        vector<lp::lar_solver::column_hint> hints;
+        for (auto const& h : m_basis_hints) {
+            theory_var v = h.m_column;
+            if (v < static_cast<theory_var>(get_num_vars()) && is_registered_var(v))
+                hints.push_back(lp::lar_solver::column_hint(get_lpvar(v), h.m_is_basic, h.m_value));
+        }
+        m_basis_hints.reset();
+        lp().apply_column_hints(hints);
+    }
+
     lbool solver::make_feasible() {
         TRACE("pcs", tout << lp().constraints(););
+        if (!m_basis_hints.empty())
+            apply_basis_hints();
         auto status = lp().find_feasible_solution();
         TRACE("arith_verbose", display(tout););
         switch (status) {
@@ -1150,17 +1172,21 @@ namespace arith {
         }
         case lp::lia_move::cut: {
             TRACE("arith", tout << "cut\n";);
-            ++m_stats.m_gomory_cuts;
-            // m_explanation implies term <= k
-            reset_evidence();
-            for (auto ev : m_explanation)
-                set_evidence(ev.ci(), m_core, m_eqs);
-            // The call mk_bound() can set the m_infeasible_column in lar_solver
-            // so the explanation is safer to take before this call.
-            app_ref b = mk_bound(m_lia->get_term(), m_lia->get_offset(), !m_lia->is_upper());
-            IF_VERBOSE(4, verbose_stream() << "cut " << b << "\n");
-            literal lit = expr2literal(b);
-            assign(lit, m_core, m_eqs, m_params);
+            // a batch of gomory cuts is returned one cut at a time
+            do {
+                ++m_stats.m_gomory_cuts;
+                // m_explanation implies term <= k
+                reset_evidence();
+                for (auto ev : m_explanation)
+                    set_evidence(ev.ci(), m_core, m_eqs);
+                // The call mk_bound() can set the m_infeasible_column in lar_solver
+                // so the explanation is safer to take before this call.
+                app_ref b = mk_bound(m_lia->get_term(), m_lia->get_offset(), !m_lia->is_upper());
+                IF_VERBOSE(4, verbose_stream() << "cut " << b << "\n");
+                literal lit = expr2literal(b);
+                assign(lit, m_core, m_eqs, m_params);
+            }
+            while (!s().inconsistent() && m_lia->next_cut());
             lia_check = l_false;
             break;
         }
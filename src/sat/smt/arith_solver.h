@@ -201,6 +201,9 @@ namespace arith {
         symbol                       m_farkas;
         lp::lp_bound_propagator<solver> m_bp;
         mutable vector<std::pair<lp::tv, rational>> m_todo_terms;
+        // basis of the solver this one was cloned from, keyed by theory variable.
+        vector<lp::lar_solver::column_hint> m_basis_hints;
+        void apply_basis_hints();
 
         // lemmas
         lp::explanation     m_explanation;
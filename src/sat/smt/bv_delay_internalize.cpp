@@ -112,11 +112,56 @@ namespace bv {
         if (m_cheap_axioms)
             return true;
 
+        if (add_fixed_bits_lemma(e, r1, r2))
+            return false;
+
         set_delay_internalize(e, internalize_mode::no_delay_i);
         internalize_circuit(e);
         return false;
     }
 
+    /**
+     * Word-level refinement of a delayed term before it is bit-blasted.
+     *
+     * The i+1 least significant bits of sums and products only depend on the
+     * i+1 least significant bits of the arguments. If the value of n differs
+     * from the value of its definition first at bit i, the lemma fixes bit i of n
+     * from the low bits of the arguments. For the other operations bit i is
+     * fixed from the full values of the arguments.
+     * The term is bit-blasted when it has received bv.delay_lemmas lemmas.
+     */
+    bool solver::add_fixed_bits_lemma(app* n, expr* value, expr* arg_value) {
+        rational v1, v2;        
+        if (!bv.is_numeral(value, v1) || !bv.is_numeral(arg_value, v2))
+            return false;
+        unsigned count = 0;
+        if (!m_delay_lemmas.find(n, count))
+            ctx.push(insert_obj_map<expr, unsigned>(m_delay_lemmas, n));
+        if (count >= get_config().m_bv_delay_lemmas)
+            return false;
+        m_delay_lemmas.insert(n, count + 1);
+
+        unsigned sz = bv.get_bv_size(n);
+        unsigned i = 0;
+        while (i < sz && v1.get_bit(i) == v2.get_bit(i))
+            ++i;
+        SASSERT(i < sz);
+        bool low_bits = bv.is_bv_add(n) || bv.is_bv_mul(n);
+        sat::literal_vector lits;
+        for (expr* arg : *n) {
+            sat::literal_vector const& bits = m_bits[expr2enode(arg)->get_th_var(get_id())];
+            unsigned k = low_bits ? i + 1 : bits.size();
+            for (unsigned j = 0; j < k; ++j)
+                lits.push_back(s().value(bits[j]) == l_true ? ~bits[j] : bits[j]);
+        }
+        sat::literal b = m_bits[expr2enode(n)->get_th_var(get_id())][i];
+        lits.push_back(v2.get_bit(i) ? b : ~b);
+        TRACE("bv", tout << "fixed bits lemma for " << mk_bounded_pp(n, m) << " at bit " << i << ": " << lits << "\n";);
+        ++m_stats.m_num_delay_lemmas;
+        add_clause(lits);
+        return true;
+    }
+
     /**
      * Add invertibility condition for multiplication
      * 
@@ -322,6 +367,8 @@ namespace bv {
             return true;
         if (m_cheap_axioms)
             return true;
+        if (add_fixed_bits_lemma(a, r1, r2))
+            return false;
         set_delay_internalize(a, internalize_mode::no_delay_i);
         internalize_circuit(a);
         return false;
@@ -653,6 +653,7 @@ namespace bv {
         st.update("bv bit2eq", m_stats.m_num_bit2eq);
         st.update("bv bit2ne", m_stats.m_num_bit2ne);
         st.update("bv ackerman", m_stats.m_ackerman);
+        st.update("bv delay lemmas", m_stats.m_num_delay_lemmas);
     }
 
     sat::extension* solver::copy(sat::solver* s) { UNREACHABLE(); return nullptr; }
@@ -45,7 +45,7 @@ namespace bv {
         struct stats {
             unsigned   m_num_diseq_static, m_num_diseq_dynamic,  m_num_conflicts;
             unsigned   m_num_bit2eq, m_num_bit2ne, m_num_eq2bit, m_num_ne2bit;
-            unsigned   m_ackerman;
+            unsigned   m_ackerman, m_num_delay_lemmas;
             void reset() { memset(this, 0, sizeof(stats)); }
             stats() { reset(); }
         };
@@ -270,6 +270,7 @@ namespace bv {
         };
 
         obj_map<expr, internalize_mode> m_delay_internalize;
+        obj_map<expr, unsigned> m_delay_lemmas;  // number of word-level lemmas per delayed term
         bool m_cheap_axioms{ true };
         bool should_bit_blast(app * n);
         bool check_delay_internalized(expr* e);
@@ -280,6 +281,7 @@ namespace bv {
         bool check_umul_no_overflow(app* n, expr_ref_vector const& arg_values, expr* value);
         bool check_bv_eval(euf::enode* n);
         bool check_bool_eval(euf::enode* n);
+        bool add_fixed_bits_lemma(app* n, expr* value, expr* arg_value);
         void encode_msb_tail(expr* x, expr_ref_vector& xs);
         void encode_lsb_tail(expr* x, expr_ref_vector& xs);
         internalize_mode get_internalize_mode(expr* e);
@@ -98,6 +98,10 @@ namespace euf {
             attach_lit(si.internalize(e, m_is_redundant), e);
             return true;
         }
+        if (is_lazy_ite(e)) {
+            internalize_lazy_ite(to_app(e));
+            return true;
+        }
         if (is_app(e) && to_app(e)->get_num_args() > 0) {
             m_stack.push_back(sat::eframe(e));
             return false;
@@ -298,7 +302,10 @@ namespace euf {
         expr* e = n->get_expr();
         sat::status st = sat::status::th(m_is_redundant, m.get_basic_family_id());
         expr* c = nullptr, * th = nullptr, * el = nullptr;
-        if (!m.is_bool(e) && m.is_ite(e, c, th, el)) {
+        if (!m.is_bool(e) && m.is_ite(e, c, th, el) && n->num_args() == 0) {
+            // lazy ite, the branches are axiomatized by propagate_lazy_ites
+        }
+        else if (!m.is_bool(e) && m.is_ite(e, c, th, el)) {
             expr_ref eq_th = mk_eq(e, th);
             sat::literal lit_th = mk_literal(eq_th);
             if (th == el) {
@@ -347,6 +354,65 @@ namespace euf {
     }
 
 
+    /**
+     * With relevancy, the branches of a term if-then-else are only internalized 
+     * once the condition is assigned. The node of the ite has no arguments and 
+     * the equality with the selected branch is propagated from the condition.
+     * Internalization of the branches is undone on backtracking.
+     */
+    bool solver::is_lazy_ite(expr* e) {
+        expr* c = nullptr, * th = nullptr, * el = nullptr;
+        return relevancy_enabled() && !m.is_bool(e) && m.is_ite(e, c, th, el) && th != el && !use_drat();
+    }
+
+    struct solver::lazy_ite_trail : public trail {
+        solver& s;
+        sat::bool_var v;
+        lazy_ite_trail(solver& s, sat::bool_var v): s(s), v(v) {}
+        void undo() override { s.m_lazy_ite_watch[v].pop_back(); }
+    };
+
+    void solver::internalize_lazy_ite(app* e) {
+        sat::literal lit_c = mk_literal(e->get_arg(0));
+        attach_node(mk_enode(e, 0, nullptr));
+        sat::bool_var v = lit_c.var();
+        m_lazy_ite_watch.reserve(v + 1);
+        m_lazy_ite_watch[v].push_back(e);
+        push(lazy_ite_trail(*this, v));
+        if (s().value(lit_c) != l_undef)
+            m_lazy_ite_queue.push_back(e);
+    }
+
+    /**
+     * Propagate c => ite(c, th, el) = th and ~c => ite(c, th, el) = el.
+     * The queue may contain terms whose condition was unassigned by backtracking.
+     */
+    bool solver::propagate_lazy_ites() {
+        if (m_lazy_ite_queue.empty())
+            return false;
+        expr_ref_vector queue(m);
+        queue.swap(m_lazy_ite_queue);
+        for (expr* e : queue) {
+            if (s().inconsistent())
+                break;
+            expr* c = nullptr, * th = nullptr, * el = nullptr;
+            VERIFY(m.is_ite(e, c, th, el));
+            enode* n = get_enode(e);
+            if (!n || n->num_args() != 0)
+                continue;
+            sat::literal lit_c = mk_literal(c);
+            lbool val = s().value(lit_c);
+            if (val == l_undef)
+                continue;
+            if (val == l_false)
+                lit_c.neg();
+            expr_ref eq = mk_eq(e, val == l_true ? th : el);
+            sat::literal lit = mk_literal(eq);
+            s().assign(lit, sat::justification(s().lvl(lit_c), ~lit_c));
+        }
+        return true;
+    }
+
     bool solver::is_shared(enode* n) const {
         n = n->get_root();
 
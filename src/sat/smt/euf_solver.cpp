@@ -48,6 +48,7 @@ namespace euf {
         m_lookahead(nullptr),
         m_to_m(&m),
         m_to_si(&si),
+        m_lazy_ite_queue(m),
         m_values(m)
     {
         updt_params(p);
@@ -61,6 +62,7 @@ namespace euf {
 
     void solver::updt_params(params_ref const& p) {
         m_config.updt_params(p);
+        m_egraph.set_batch_merge(m_config.m_euf_batch_merge);
     }
 
     /**
@@ -295,6 +297,9 @@ namespace euf {
             return;
         bool sign = l.sign();   
         m_egraph.set_value(n, sign ? l_false : l_true);
+        if (l.var() < m_lazy_ite_watch.size())
+            for (app* ite : m_lazy_ite_watch[l.var()])
+                m_lazy_ite_queue.push_back(ite);
         for (auto th : enode_th_vars(n))
             m_id2solver[th.get_id()]->asserted(l);
 
@@ -334,7 +339,7 @@ namespace euf {
                 s().set_conflict(sat::justification::mk_ext_justification(lvl, conflict_constraint().to_index()));
                 return true;
             }
-            bool propagated1 = false;
+            bool propagated1 = propagate_lazy_ites();
             if (m_egraph.propagate()) {
                 propagate_literals();
                 propagate_th_eqs();
@@ -125,6 +125,14 @@ namespace euf {
         void add_distinct_axiom(app* e, euf::enode* const* args);
         void add_not_distinct_axiom(app* e, euf::enode* const* args);
         void axiomatize_basic(enode* n);
+
+        // if-then-else terms whose branches are internalized when the condition is assigned
+        struct lazy_ite_trail;
+        vector<ptr_vector<app>> m_lazy_ite_watch;   // condition variable -> lazy ite terms
+        expr_ref_vector         m_lazy_ite_queue;
+        bool is_lazy_ite(expr* e);
+        void internalize_lazy_ite(app* e);
+        bool propagate_lazy_ites();
         bool internalize_root(app* e, bool sign, ptr_vector<enode> const& args);
         void ensure_merged_tf(euf::enode* n);
         euf::enode* mk_true();
@@ -424,6 +432,10 @@ namespace euf {
             check_for_user_propagator();
             m_user_propagator->register_diseq(diseq_eh);
         }
+        void user_propagate_register_batch(::solver::batch_eh_t& batch_eh) {
+            check_for_user_propagator();
+            m_user_propagator->register_batch(batch_eh);
+        }
         unsigned user_propagate_register(expr* e) {
             check_for_user_propagator();
             return m_user_propagator->add_expr(e);
@@ -138,17 +138,24 @@ namespace pb {
                 if (j != i) {
                     swap(i, j);
                 }
-                if (slack <= bound) {
-                    slack += p[j].first;
-                    ++num_watch;
-                }
-                else {
-                    slack1 += p[j].first;
-                }
                 ++j;
             }
         }
 
+        // watch the literals with the largest coefficients, so that
+        // fewer literals are watched and the first unassigned watched
+        // literal has the largest watched coefficient.
+        std::stable_sort(m_wlits, m_wlits + j, [](wliteral a, wliteral b) { return a.first > b.first; });
+        for (unsigned i = 0; i < j; ++i) {
+            if (slack <= bound) {
+                slack += p[i].first;
+                ++num_watch;
+            }
+            else {
+                slack1 += p[i].first;
+            }
+        }
+
         DEBUG_CODE(
             bool is_false = false;
         for (unsigned k = 0; k < sz; ++k) {
@@ -46,6 +46,7 @@ namespace q {
         sat::literal        m_literal = sat::null_literal;
         q::quantifier_stat* m_stat = nullptr;
         binding* m_bindings = nullptr;
+        vector<unsigned_vector> m_lit_vars;  // binding positions used by each literal, computed by eval
 
 
         clause(ast_manager& m, unsigned idx) : m_index(idx), m_q(m) {}
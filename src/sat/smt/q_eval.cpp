@@ -41,12 +41,19 @@ namespace q {
         idx = UINT_MAX;
         unsigned sz = c.m_lits.size();
         unsigned n = c.num_decls();
+        unsigned ev_lim = evidence.size();
         m_indirect_nodes.reset();
+        init_lit_vars(c);
         for (unsigned j = 0; j < sz; ++j) {
             unsigned i = (j + c.m_watch) % sz;
             unsigned lim = m_indirect_nodes.size();
             lit l = c[i];
-            lbool cmp = compare(n, binding, l.lhs, l.rhs, evidence);
+            lbool cmp;
+            if (!find_lit(binding, c, i, cmp, evidence)) {
+                cmp = compare(n, binding, l.lhs, l.rhs, evidence);
+                if (cmp != l_undef)
+                    insert_lit(binding, c, i, cmp, evidence, ev_lim);
+            }
             switch (cmp) {
             case l_false:
                 m_indirect_nodes.shrink(lim);
@@ -76,6 +83,121 @@ namespace q {
         return l_undef;
     }
 
+    /**
+       \brief collect the binding positions of the variables of each literal.
+       Literals with nested quantifiers depend on all variables.
+    */
+    void eval::init_lit_vars(clause& c) {
+        if (c.m_lit_vars.size() == c.size())
+            return;
+        c.m_lit_vars.reset();
+        unsigned n = c.num_decls();
+        ptr_buffer<expr> todo;
+        expr_mark visited;
+        for (auto const& l : c.m_lits) {
+            unsigned_vector vars;
+            bool all = false;
+            visited.reset();
+            todo.push_back(l.lhs);
+            todo.push_back(l.rhs);
+            while (!todo.empty()) {
+                expr* e = todo.back();
+                todo.pop_back();
+                if (visited.is_marked(e) || is_ground(e))
+                    continue;
+                visited.mark(e, true);
+                if (is_var(e)) {
+                    if (to_var(e)->get_idx() < n)
+                        vars.push_back(n - 1 - to_var(e)->get_idx());
+                }
+                else if (is_app(e))
+                    todo.append(to_app(e)->get_num_args(), to_app(e)->get_args());
+                else
+                    all = true;
+            }
+            if (all) {
+                vars.reset();
+                for (unsigned i = 0; i < n; ++i)
+                    vars.push_back(i);
+            }
+            std::sort(vars.begin(), vars.end());
+            c.m_lit_vars.push_back(vars);
+        }
+    }
+
+    unsigned eval::lit_eval_hash::operator()(lit_eval const* e) const {
+        unsigned h = hash_u_u(e->c->index(), e->m_lit);
+        for (unsigned j = e->size(); j-- > 0; )
+            h = combine_hash(h, e->m_nodes[j]->hash());
+        return h;
+    }
+
+    bool eval::lit_eval_eq::operator()(lit_eval const* a, lit_eval const* b) const {
+        if (a->c != b->c || a->m_lit != b->m_lit)
+            return false;
+        for (unsigned j = a->size(); j-- > 0; )
+            if (a->m_nodes[j] != b->m_nodes[j])
+                return false;
+        return true;
+    }
+
+    bool eval::find_lit(euf::enode* const* binding, clause& c, unsigned i, lbool& value, euf::enode_pair_vector& evidence) {
+        auto const& vars = c.m_lit_vars[i];
+        unsigned k = vars.size();
+        if (k == 0 || m_lit_evals.empty())
+            return false;
+        if (k > m_tmp_lit_eval_capacity) {
+            void* mem = memory::allocate(sizeof(lit_eval) + k * sizeof(euf::enode*));
+            m_tmp_lit_eval = new (mem) lit_eval(c, i, l_undef);
+            m_tmp_lit_eval_capacity = k;
+        }
+        lit_eval* t = m_tmp_lit_eval.get();
+        t->c = &c;
+        t->m_lit = i;
+        for (unsigned j = 0; j < k; ++j)
+            t->m_nodes[j] = binding[vars[j]]->get_root();
+        lit_eval* e = nullptr;
+        if (!m_lit_evals.find(t, e))
+            return false;
+        // the variables are bound to nodes that are congruent to the cached ones
+        for (unsigned j = 0; j < k; ++j) 
+            if (binding[vars[j]] != e->m_nodes[k + j])
+                evidence.push_back(euf::enode_pair(binding[vars[j]], e->m_nodes[k + j]));
+        for (unsigned j = 0; j < e->m_num_evidence; ++j)
+            evidence.push_back(e->m_evidence[j]);
+        value = e->m_value;
+        return true;
+    }
+
+    /**
+       \brief cache the value of literal i. Sub-terms are shared between the literals
+       of a clause, so the evidence since the start of the evaluation of the clause
+       is stored with the literal.
+    */
+    void eval::insert_lit(euf::enode* const* binding, clause& c, unsigned i, lbool value, euf::enode_pair_vector const& evidence, unsigned ev_lim) {
+        auto const& vars = c.m_lit_vars[i];
+        unsigned k = vars.size();
+        if (k == 0)
+            return;
+        region& r = ctx.get_region();
+        void* mem = r.allocate(sizeof(lit_eval) + 2 * k * sizeof(euf::enode*));
+        lit_eval* e = new (mem) lit_eval(c, i, value);
+        for (unsigned j = 0; j < k; ++j) {
+            e->m_nodes[j] = binding[vars[j]]->get_root();
+            e->m_nodes[k + j] = binding[vars[j]];
+        }
+        if (m_lit_evals.contains(e))
+            return;
+        e->m_num_evidence = evidence.size() - ev_lim;
+        if (e->m_num_evidence > 0) {
+            e->m_evidence = new (r) euf::enode_pair[e->m_num_evidence];
+            for (unsigned j = 0; j < e->m_num_evidence; ++j)
+                e->m_evidence[j] = evidence[ev_lim + j];
+        }
+        m_lit_evals.insert(e);
+        ctx.push(insert_map<lit_evals, lit_eval*>(m_lit_evals, e));
+    }
+
     lbool eval::operator()(euf::enode* const* binding, clause& c, euf::enode_pair_vector& evidence) {
         unsigned idx = 0;
         return (*this)(binding, c, idx, evidence);
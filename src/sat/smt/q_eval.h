@@ -37,6 +37,42 @@ namespace q {
 
         struct scoped_mark_reset;
 
+        /**
+           Value of a literal under the variables it uses.
+           Equalities and disequalities are not retracted until backtracking,
+           so literals that evaluate to true or false keep their value for
+           every binding that is congruent on the variables of the literal.
+           The entries are removed when the scope they were created in is popped.
+        */
+        struct lit_eval {
+            clause*          c;
+            unsigned         m_lit;
+            lbool            m_value;
+            unsigned         m_num_evidence = 0;
+            euf::enode_pair* m_evidence = nullptr;
+            euf::enode*      m_nodes[0]; // roots of the variables, followed by the nodes they were bound to
+            lit_eval(clause& c, unsigned lit, lbool value): c(&c), m_lit(lit), m_value(value) {}
+            unsigned size() const { return c->m_lit_vars[m_lit].size(); }
+        };
+
+        struct lit_eval_hash {
+            unsigned operator()(lit_eval const* e) const;
+        };
+
+        struct lit_eval_eq {
+            bool operator()(lit_eval const* a, lit_eval const* b) const;
+        };
+
+        typedef ptr_hashtable<lit_eval, lit_eval_hash, lit_eval_eq> lit_evals;
+
+        lit_evals             m_lit_evals;
+        scoped_ptr<lit_eval>  m_tmp_lit_eval;
+        unsigned              m_tmp_lit_eval_capacity = 0;
+
+        void init_lit_vars(clause& c);
+        bool find_lit(euf::enode* const* binding, clause& c, unsigned i, lbool& value, euf::enode_pair_vector& evidence);
+        void insert_lit(euf::enode* const* binding, clause& c, unsigned i, lbool value, euf::enode_pair_vector const& evidence, unsigned ev_lim);
+
         // compare s, t modulo binding
         lbool compare(unsigned n, euf::enode* const* binding, expr* s, expr* t, euf::enode_pair_vector& evidence);
         lbool compare_rec(unsigned n, euf::enode* const* binding, expr* s, expr* t, euf::enode_pair_vector& evidence);
@@ -32,7 +32,8 @@ namespace recfun {
         m_util(m_plugin.u()), 
         m_disabled_guards(m),
         m_enabled_guards(m),
-        m_preds(m) {
+        m_preds(m),
+        m_eval(m) {
     }    
 
     solver::~solver() {
@@ -76,6 +77,21 @@ namespace recfun {
         add_unit(eq);        
     }
 
+    /**
+     * For applications to values, evaluate the definition
+     * and add unit clause `f(args) = value`
+     */
+    bool solver::assert_value_axiom(case_expansion & e) {
+        expr_ref value(m);
+        if (!m_eval(e.m_lhs, value))
+            return false;
+        ++m_stats.m_evaluations;
+        TRACEFN("evaluate " << mk_pp(e.m_lhs, m) << " = " << value);
+        auto eq = eq_internalize(e.m_lhs, value);
+        add_unit(eq);
+        return true;
+    }
+
     /**
      * Add case axioms for every case expansion path.
      *
@@ -89,6 +105,9 @@ namespace recfun {
             return;
         }
 
+        if (assert_value_axiom(e))
+            return;
+
         ++m_stats.m_case_expansions;
         TRACEFN("assert_case_axioms " << e
                 << " with " << e.m_def->get_cases().size() << " cases");
@@ -202,6 +221,7 @@ namespace recfun {
         st.update("recfun macro expansion", m_stats.m_macro_expansions);
         st.update("recfun case expansion", m_stats.m_case_expansions);
         st.update("recfun body expansion", m_stats.m_body_expansions);
+        st.update("recfun evaluations", m_stats.m_evaluations);
     }
 
     euf::th_solver* solver::clone(euf::solver& ctx) {
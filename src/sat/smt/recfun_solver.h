@@ -18,6 +18,7 @@ Author:
 #pragma once
 
 #include "ast/recfun_decl_plugin.h"
+#include "ast/rewriter/recfun_rewriter.h"
 #include "ast/ast_trail.h"
 #include "sat/smt/sat_th.h"
 
@@ -31,7 +32,7 @@ namespace recfun {
     class solver : public euf::th_euf_solver {
 
         struct stats {
-            unsigned m_case_expansions, m_body_expansions, m_macro_expansions;
+            unsigned m_case_expansions, m_body_expansions, m_macro_expansions, m_evaluations;
             void reset() { memset(this, 0, sizeof(stats)); }
             stats() { reset(); }
         };
@@ -48,6 +49,7 @@ namespace recfun {
         expr_ref_vector          m_preds;
         unsigned_vector          m_preds_lim;
         unsigned                 m_num_rounds { 0 };
+        recfun_evaluator         m_eval;
 
         scoped_ptr_vector<propagation_item> m_propagation_queue;
         unsigned                            m_qhead { 0 };
@@ -72,6 +74,7 @@ namespace recfun {
         expr_ref apply_args(vars const & vars, expr_ref_vector const & args, expr * e); 
         void assert_macro_axiom(case_expansion & e);
         void assert_case_axioms(case_expansion & e);
+        bool assert_value_axiom(case_expansion & e);
         void assert_body_axiom(body_expansion & e);
         void assert_guard(expr* guard, expr_ref_vector const& guards);
         void block_core(expr_ref_vector const& core);
@@ -21,7 +21,8 @@ Author:
 namespace user_solver {
 
     solver::solver(euf::solver& ctx) :
-        th_euf_solver(ctx, symbol("user"), ctx.get_manager().mk_family_id("user"))
+        th_euf_solver(ctx, symbol("user"), ctx.get_manager().mk_family_id("user")),
+        m_batch_values(ctx.get_manager())
     {}
 
     solver::~solver() {
@@ -48,23 +49,51 @@ namespace user_solver {
     }
 
     sat::check_result solver::check() {
-        if (!(bool)m_final_eh)
+        if (!(bool)m_final_eh && !has_batch())
             return  sat::check_result::CR_DONE;
         unsigned sz = m_prop.size();
-        m_final_eh(m_user_context, this);
+        flush_batch();
+        if ((bool)m_final_eh)
+            m_final_eh(m_user_context, this);
         return sz == m_prop.size() ? sat::check_result::CR_DONE : sat::check_result::CR_CONTINUE;
     }
 
+    void solver::fixed_eh(euf::theory_var v, expr* value) {
+        if (m_batch_eh) {
+            m_batch_fixed.push_back(v);
+            m_batch_values.push_back(value);
+        }
+        else
+            m_fixed_eh(m_user_context, this, v, value);
+    }
+
+    /**
+     * \brief deliver the fixed values collected since the last call to the batch callback.
+     */
+    void solver::flush_batch() {
+        if (!has_batch())
+            return;
+        force_push();
+        unsigned h = m_batch_head;
+        m_batch_head = m_batch_fixed.size();
+        m_batch_eh(m_user_context, this, m_batch_fixed.size() - h, m_batch_fixed.data() + h, m_batch_values.data() + h, 0, nullptr, nullptr);
+        if (m_batch_lim.empty()) {
+            m_batch_fixed.reset();
+            m_batch_values.reset();
+            m_batch_head = 0;
+        }
+    }
+
     void solver::new_fixed_eh(euf::theory_var v, expr* value, unsigned num_lits, sat::literal const* jlits) {
-        if (!m_fixed_eh)
+        if (!has_fixed())
             return;
         force_push();
         m_id2justification.setx(v, sat::literal_vector(num_lits, jlits), sat::literal_vector());
-        m_fixed_eh(m_user_context, this, v, value);
+        fixed_eh(v, value);
     }
 
     void solver::asserted(sat::literal lit) {
-        if (!m_fixed_eh)
+        if (!has_fixed())
             return;
         force_push();
         auto* n = bool_var2enode(lit.var());
@@ -72,12 +101,13 @@ namespace user_solver {
         sat::literal_vector lits;
         lits.push_back(lit);
         m_id2justification.setx(v, lits, sat::literal_vector());
-        m_fixed_eh(m_user_context, this, v, lit.sign() ? m.mk_false() : m.mk_true());
+        fixed_eh(v, lit.sign() ? m.mk_false() : m.mk_true());
     }
 
     void solver::push_core() {
         th_euf_solver::push_core();
         m_prop_lim.push_back(m_prop.size());
+        m_batch_lim.push_back(m_batch_fixed.size());
         m_push_eh(m_user_context);
     }
 
@@ -86,10 +116,16 @@ namespace user_solver {
         unsigned old_sz = m_prop_lim.size() - num_scopes;
         m_prop.shrink(m_prop_lim[old_sz]);
         m_prop_lim.shrink(old_sz);
+        unsigned batch_sz = m_batch_lim[old_sz];
+        m_batch_fixed.shrink(batch_sz);
+        m_batch_values.shrink(batch_sz);
+        m_batch_head = std::min(m_batch_head, batch_sz);
+        m_batch_lim.shrink(old_sz);
         m_pop_eh(m_user_context, num_scopes);
     }
 
     bool solver::unit_propagate() {
+        flush_batch();
         if (m_qhead == m_prop.size())
             return false;
         force_push();
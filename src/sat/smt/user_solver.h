@@ -54,6 +54,7 @@ namespace user_solver {
         ::solver::fixed_eh_t     m_fixed_eh;
         ::solver::eq_eh_t        m_eq_eh;
         ::solver::eq_eh_t        m_diseq_eh;
+        ::solver::batch_eh_t     m_batch_eh;
         ::solver::context_obj*   m_api_context { nullptr };
         unsigned               m_qhead { 0 };
         vector<prop_info>      m_prop;
@@ -63,6 +64,16 @@ namespace user_solver {
         euf::enode_pair_vector      m_eqs;
         stats                  m_stats;
 
+        // fixed values for m_batch_eh, the ones from m_batch_head on are not yet delivered
+        unsigned_vector        m_batch_fixed;
+        expr_ref_vector        m_batch_values;
+        unsigned               m_batch_head { 0 };
+        unsigned_vector        m_batch_lim;
+
+        bool has_batch() const { return m_batch_head < m_batch_fixed.size(); }
+        void flush_batch();
+        void fixed_eh(euf::theory_var v, expr* value);
+
         struct justification {
             unsigned m_propagation_index { 0 };
 
@@ -106,8 +117,9 @@ namespace user_solver {
         void register_fixed(::solver::fixed_eh_t& fixed_eh) { m_fixed_eh = fixed_eh; }
         void register_eq(::solver::eq_eh_t& eq_eh) { m_eq_eh = eq_eh; }
         void register_diseq(::solver::eq_eh_t& diseq_eh) { m_diseq_eh = diseq_eh; }
+        void register_batch(::solver::batch_eh_t& batch_eh) { m_batch_eh = batch_eh; }
 
-        bool has_fixed() const { return (bool)m_fixed_eh; }
+        bool has_fixed() const { return (bool)m_fixed_eh || (bool)m_batch_eh; }
 
         void propagate_cb(unsigned num_fixed, unsigned const* fixed_ids, unsigned num_eqs, unsigned const* lhs, unsigned const* rhs, expr* conseq) override;
 
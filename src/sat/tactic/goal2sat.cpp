@@ -78,7 +78,13 @@ struct goal2sat::imp : public sat::sat_internalizer {
     bool                        m_drat { false };
     bool                        m_is_redundant { false };
     bool                        m_top_level { false };
+    bool                        m_cnf_polarity { true };
+    obj_map<expr, unsigned>     m_polarity;   // connective -> polarities it occurs in
     sat::literal_vector         aig_lits;
+
+    static const unsigned pos_polarity = 1;
+    static const unsigned neg_polarity = 2;
+    static const unsigned both_polarities = 3;
     
     imp(ast_manager & _m, params_ref const & p, sat::solver_core & s, atom2bool_var & map, dep2asm_map& dep2asm, bool default_external):
         m(_m),
@@ -107,6 +113,90 @@ struct goal2sat::imp : public sat::sat_internalizer {
         m_max_memory = megabytes_to_bytes(p.get_uint("max_memory", UINT_MAX));
         m_euf = sp.euf();
         m_drat = sp.drat_file().is_non_empty_string();
+        m_cnf_polarity = sp.cnf_polarity();
+    }
+
+    /**
+       \brief polarities in which the definition of the connective t is required.
+       Connectives that were not seen by collect_polarities need both.
+    */
+    unsigned polarity(app* t) const {
+        unsigned p = both_polarities;
+        m_polarity.find(t, p);
+        return p;
+    }
+
+    /**
+       \brief record the polarities of the Boolean connectives below the assertions.
+       The positive half l => def is required if the connective occurs positively,
+       and def => l if it occurs negatively. The polarity based encoding is not
+       used if the definitions are shared with euf, proofs or the AIG simplifier.
+    */
+    void collect_polarities(goal const& g) {
+        m_polarity.reset();
+        if (!m_cnf_polarity || m_euf || m_drat || aig())
+            return;
+        svector<std::pair<expr*, unsigned>> todo;
+        ptr_vector<expr> deps;
+        for (unsigned i = 0; i < g.size(); ++i) {
+            todo.push_back(std::make_pair(g.form(i), pos_polarity));
+            if (g.dep(i)) {
+                deps.reset();
+                m.linearize(g.dep(i), deps);
+                for (expr* d : deps)
+                    todo.push_back(std::make_pair(d, both_polarities));
+            }
+        }
+        while (!todo.empty()) {
+            auto [e, p] = todo.back();
+            todo.pop_back();
+            if (!is_app(e))
+                continue;
+            app* a = to_app(e);
+            unsigned old_p = 0;
+            m_polarity.find(a, old_p);
+            if ((old_p | p) == old_p)
+                continue;
+            m_polarity.insert(a, old_p | p);
+            if (a->get_family_id() != m.get_basic_family_id()) {
+                // arguments of pseudo-Boolean constraints
+                if (old_p == 0)
+                    for (expr* arg : *a)
+                        if (m.is_bool(arg))
+                            todo.push_back(std::make_pair(arg, both_polarities));
+                continue;
+            }
+            unsigned flip = ((p & pos_polarity) ? neg_polarity : 0) | ((p & neg_polarity) ? pos_polarity : 0);
+            switch (a->get_decl_kind()) {
+            case OP_NOT:
+                todo.push_back(std::make_pair(a->get_arg(0), flip));
+                break;
+            case OP_AND:
+            case OP_OR:
+                for (expr* arg : *a)
+                    todo.push_back(std::make_pair(arg, p));
+                break;
+            case OP_IMPLIES:
+                todo.push_back(std::make_pair(a->get_arg(0), flip));
+                todo.push_back(std::make_pair(a->get_arg(1), p));
+                break;
+            case OP_ITE:
+                if (!m.is_bool(a))
+                    break;
+                todo.push_back(std::make_pair(a->get_arg(0), both_polarities));
+                todo.push_back(std::make_pair(a->get_arg(1), p));
+                todo.push_back(std::make_pair(a->get_arg(2), p));
+                break;
+            case OP_EQ:
+            case OP_XOR:
+                for (expr* arg : *a)
+                    if (m.is_bool(arg))
+                        todo.push_back(std::make_pair(arg, both_polarities));
+                break;
+            default:
+                break;
+            }
+        }
     }
 
     void throw_op_not_handled(std::string const& s) {
@@ -426,9 +516,11 @@ struct goal2sat::imp : public sat::sat_internalizer {
             sat::bool_var k = add_var(false, t);
             sat::literal  l(k, false);
             cache(t, l);
+            unsigned p = polarity(t);
             sat::literal * lits = m_result_stack.end() - num;       
-            for (unsigned i = 0; i < num; i++) 
-                mk_clause(~lits[i], l);
+            if (p & neg_polarity)
+                for (unsigned i = 0; i < num; i++) 
+                    mk_clause(~lits[i], l);
                        
             m_result_stack.push_back(~l);
             lits = m_result_stack.end() - num - 1;
@@ -438,7 +530,8 @@ struct goal2sat::imp : public sat::sat_internalizer {
             }
             // remark: mk_clause may perform destructive updated to lits.
             // I have to execute it after the binary mk_clause above.
-            mk_clause(num+1, lits);
+            if (p & pos_polarity)
+                mk_clause(num+1, lits);
             if (aig()) 
                 aig()->add_or(l, num, aig_lits.data());
                         
@@ -475,11 +568,14 @@ struct goal2sat::imp : public sat::sat_internalizer {
             sat::bool_var k = add_var(false, t);
             sat::literal  l(k, false);
             cache(t, l);
+            unsigned p = polarity(t);
             sat::literal * lits = m_result_stack.end() - num;
 
             // l => /\ lits
-            for (unsigned i = 0; i < num; i++) {
-                mk_clause(~l, lits[i]);
+            if (p & pos_polarity) {
+                for (unsigned i = 0; i < num; i++) {
+                    mk_clause(~l, lits[i]);
+                }
             }
             // /\ lits => l
             for (unsigned i = 0; i < num; ++i) {
@@ -491,7 +587,8 @@ struct goal2sat::imp : public sat::sat_internalizer {
                 aig_lits.reset();
                 aig_lits.append(num, lits);
             }
-            mk_clause(num+1, lits);
+            if (p & neg_polarity)
+                mk_clause(num+1, lits);
             if (aig()) {
                 aig()->add_and(l, num, aig_lits.data());
             }        
@@ -588,9 +685,13 @@ struct goal2sat::imp : public sat::sat_internalizer {
             sat::literal  l(k, false);
             cache(t, l);
             // l <=> (l1 => l2)
-            mk_clause(~l, ~l1, l2);
-            mk_clause(l1, l);
-            mk_clause(~l2, l);
+            unsigned p = polarity(t);
+            if (p & pos_polarity)
+                mk_clause(~l, ~l1, l2);
+            if (p & neg_polarity) {
+                mk_clause(l1, l);
+                mk_clause(~l2, l);
+            }
             if (sign)
                 l.neg();
             m_result_stack.push_back(l);
@@ -905,10 +1006,12 @@ struct goal2sat::imp : public sat::sat_internalizer {
                 i.m_interface_vars.reset();
                 i.m_app2lit.reset();
                 i.m_lit2app.reset();
+                i.m_polarity.reset();
             }
         };
         scoped_reset _reset(*this);
         collect_boolean_interface(g, m_interface_vars);
+        collect_polarities(g);
         unsigned size = g.size();
         expr_ref f(m), d_new(m);
         ptr_vector<expr> deps;
@@ -219,6 +219,36 @@ lbool solve_parallel(sat::solver& s) {
     return r;
 }
 
+/**
+   \brief solve the cubes of an incremental DIMACS problem.
+   Worker k of n solves the cubes with index i such that i mod n = k, so the
+   cubes produced by dimacs.cubes can be spread over separate processes.
+   The negation of the core of a refuted cube is kept as a lemma for the next cubes.
+   The result is unsat if every cube of the worker is refuted.
+*/
+static lbool conquer_cubes(sat::solver& s, vector<sat::literal_vector> const& cubes, unsigned worker, unsigned num_workers) {
+    lbool result = l_false;
+    sat::literal_vector lemma;
+    for (unsigned i = worker; i < cubes.size(); i += num_workers) {
+        sat::literal_vector const& cube = cubes[i];
+        lbool r = s.check(cube.size(), cube.data());
+        std::cout << "c cube " << i << " " << (r == l_true ? "sat" : r == l_false ? "unsat" : "unknown") << "\n";
+        if (r == l_true)
+            return l_true;
+        if (r == l_undef) {
+            result = l_undef;
+            continue;
+        }
+        if (s.get_core().empty())
+            return l_false;
+        lemma.reset();
+        for (sat::literal lit : s.get_core())
+            lemma.push_back(~lit);
+        s.mk_clause(lemma.size(), lemma.data());
+    }
+    return result;
+}
+
 unsigned read_dimacs(char const * file_name) {
     g_start_time = clock();
     register_on_timeout_proc(on_timeout);
@@ -232,16 +262,17 @@ unsigned read_dimacs(char const * file_name) {
     sat::solver solver(p, limit);
     g_solver = &solver;
 
+    vector<sat::literal_vector> input_cubes;
     if (file_name) {
         std::ifstream in(file_name);
         if (in.bad() || in.fail()) {
             std::cerr << "(error \"failed to open file '" << file_name << "'\")" << std::endl;
             exit(ERR_OPEN_FILE);
         }
-        parse_dimacs(in, std::cerr, solver);
+        parse_icnf(in, std::cerr, solver, input_cubes);
     }
     else {
-        parse_dimacs(std::cin, std::cerr, solver);
+        parse_icnf(std::cin, std::cerr, solver, input_cubes);
     }
     IF_VERBOSE(20, solver.display_status(verbose_stream()););
     
@@ -252,7 +283,23 @@ unsigned read_dimacs(char const * file_name) {
     p2.set_sym("drat.file", symbol::null);
 
     sat::solver solver2(p2, limit);
-    if (p.get_bool("dimacs.core", false)) {
+    unsigned num_cubes = p.get_uint("dimacs.cubes", 0);
+    if (!input_cubes.empty()) {
+        unsigned num_workers = std::max(1u, p.get_uint("dimacs.workers", 1));
+        r = conquer_cubes(solver, input_cubes, p.get_uint("dimacs.worker", 0) % num_workers, num_workers);
+    }
+    else if (num_cubes > 0) {
+        // print the problem and up to num_cubes lookahead cubes for incremental workers
+        sat::bool_var_vector vars;
+        vector<sat::literal_vector> cubes;
+        r = solver.cubes(vars, num_cubes, UINT_MAX, cubes);
+        if (r == l_undef) {
+            solver.display_icnf(std::cout, cubes);
+            display_statistics();
+            return 0;
+        }
+    }
+    else if (p.get_bool("dimacs.core", false)) {
         g_solver = &solver2;        
         sat::literal_vector assumptions;
         track_clauses(solver, solver2, assumptions, tracking_clauses);
@@ -79,6 +79,7 @@ void run_solver(smt_params_helper & params, char const * mps_file_name) {
     solver->settings().set_message_ostream(&std::cout);
     solver->settings().report_frequency = params.arith_rep_freq();
     solver->settings().print_statistics = params.arith_print_stats();
+    solver->settings().lu_refactor_period = std::max(1u, params.arith_lu_refactor_period());
     solver->settings().simplex_strategy() = lp:: simplex_strategy_enum::lu;
 
     solver->find_maximal_solution();
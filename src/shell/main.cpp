@@ -44,12 +44,13 @@ Revision History:
 #include <crtdbg.h>
 #endif
 
-typedef enum { IN_UNSPECIFIED, IN_SMTLIB_2, IN_DATALOG, IN_DIMACS, IN_WCNF, IN_OPB, IN_LP, IN_Z3_LOG, IN_MPS, IN_DRAT } input_kind;
+typedef enum { IN_UNSPECIFIED, IN_SMTLIB_2, IN_DATALOG, IN_DIMACS, IN_WCNF, IN_OPB, IN_LP, IN_Z3_LOG, IN_MPS, IN_DRAT, IN_BINARY, IN_SERVER } input_kind;
 
 static char const * g_input_file          = nullptr;
 static char const * g_drat_input_file     = nullptr;
 static bool         g_standard_input      = false;
 static input_kind   g_input_kind          = IN_UNSPECIFIED;
+static unsigned     g_server_threads      = 1;
 bool                g_display_statistics  = false;
 bool                g_display_model       = false;
 static bool         g_display_istatistics = false;
@@ -85,7 +86,9 @@ void display_usage() {
     std::cout << "  -opb        use parser for PB optimization input format.\n";
     std::cout << "  -lp         use parser for a modest subset of CPLEX LP input format.\n";
     std::cout << "  -log        use parser for Z3 log input format.\n";
+    std::cout << "  -bin        read assertions saved in Z3 binary format (see Z3_solver_to_binary).\n";
     std::cout << "  -in         read formula from standard input.\n";
+    std::cout << "  -server[:threads]  serve SMT 2 requests read from standard input, the input file is an optional prelude.\n";
     std::cout << "  -model      display model for satisfiable SMT.\n";
     std::cout << "\nMiscellaneous:\n";
     std::cout << "  -h, -?      prints this message.\n";
@@ -206,6 +209,14 @@ static void parse_cmd_line_args(std::string& input_file, int argc, char ** argv)
             else if (strcmp(opt_name, "log") == 0) {
                 g_input_kind = IN_Z3_LOG;
             }
+            else if (strcmp(opt_name, "bin") == 0) {
+                g_input_kind = IN_BINARY;
+            }
+            else if (strcmp(opt_name, "server") == 0) {
+                g_input_kind = IN_SERVER;
+                if (opt_arg)
+                    g_server_threads = static_cast<unsigned>(strtol(opt_arg, nullptr, 10));
+            }
             else if (strcmp(opt_name, "st") == 0) {
                 g_display_statistics = true; 
                 gparams::set("stats", "true");
@@ -330,7 +341,7 @@ int STD_CALL main(int argc, char ** argv) {
         if (g_input_file && g_standard_input) {
             error("using standard input to read formula.");
         }
-        if (!g_input_file && !g_standard_input) {
+        if (!g_input_file && !g_standard_input && g_input_kind != IN_SERVER) {
             error("input file was not specified.");
         }
         
@@ -394,6 +405,18 @@ int STD_CALL main(int argc, char ** argv) {
         case IN_DRAT:
             return_value = read_drat(g_drat_input_file, g_input_file);
             break;
+        case IN_BINARY:
+            if (!g_input_file)
+                error("binary input must be read from a file.");
+            memory::exit_when_out_of_memory(true, "(error \"out of memory\")");
+            return_value = read_binary_assertions(g_input_file);
+            break;
+        case IN_SERVER:
+            if (g_standard_input)
+                error("the server reads requests from standard input.");
+            memory::exit_when_out_of_memory(true, "(error \"out of memory\")");
+            return_value = serve_smtlib2_commands(g_input_file, g_server_threads);
+            break;
         default:
             UNREACHABLE();
         }
@@ -19,8 +19,12 @@ Revision History:
 
 --*/
 #include<iostream>
+#include<sstream>
 #include<time.h>
 #include<signal.h>
+#ifndef SINGLE_THREAD
+#include<thread>
+#endif
 #include "util/timeout.h"
 #include "util/mutex.h"
 #include "parsers/smt2/smt2parser.h"
@@ -31,6 +35,7 @@ Revision History:
 #include "cmd_context/extra_cmds/subpaving_cmds.h"
 #include "smt/smt2_extra_cmds.h"
 #include "smt/smt_solver.h"
+#include "ast/ast_binary.h"
 
 static mutex *display_stats_mux = new mutex;
 
@@ -134,12 +139,14 @@ unsigned read_smtlib2_commands(char const * file_name) {
 
     bool result = true;
     if (file_name) {
-        std::ifstream in(file_name);
+        std::ifstream in(file_name, std::ios::binary);
         if (in.bad() || in.fail()) {
             std::cerr << "(error \"failed to open file '" << file_name << "'\")" << std::endl;
             exit(ERR_OPEN_FILE);
         }
-        result = parse_smt2_commands(ctx, in);
+        // scan the whole file from memory, this avoids the per character stream overhead.
+        std::string data((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+        result = parse_smt2_commands(ctx, data.data(), data.size());
     }
     else {
         result = parse_smt2_commands(ctx, std::cin, true);
@@ -151,3 +158,194 @@ unsigned read_smtlib2_commands(char const * file_name) {
     return result ? 0 : 1;
 }
 
+
+unsigned read_binary_assertions(char const * file_name) {
+    g_start_time = clock();
+    register_on_timeout_proc(on_timeout);
+    signal(SIGINT, on_ctrl_c);
+    cmd_context ctx;
+
+    ctx.set_solver_factory(mk_smt_strategic_solver_factory());
+    install_smt2_extra_cmds(ctx);
+
+    g_cmd_context = &ctx;
+
+    std::ifstream in(file_name, std::ios::binary);
+    if (in.bad() || in.fail()) {
+        std::cerr << "(error \"failed to open file '" << file_name << "'\")" << std::endl;
+        exit(ERR_OPEN_FILE);
+    }
+    bool result = true;
+    try {
+        expr_ref_vector fmls(ctx.m());
+        ast_from_binary(ctx.m(), in, fmls);
+        for (expr* e : fmls)
+            ctx.assert_expr(e);
+        std::istringstream cmds("(check-sat)");
+        result = parse_smt2_commands(ctx, cmds);
+    }
+    catch (z3_exception& ex) {
+        std::cerr << "(error \"" << ex.msg() << "\")" << std::endl;
+        result = false;
+    }
+
+    display_statistics();
+    display_model();
+    g_cmd_context = nullptr;
+    return result ? 0 : 1;
+}
+
+
+/**
+   \brief Server mode.
+
+   Requests are read from standard input. A request is a header line
+   
+       <id> <length> [<timeout-ms> [<rlimit>]]
+
+   followed by <length> bytes of SMT2 commands. The response is a header
+   line "<id> <length>" followed by <length> bytes of output. Responses
+   of different workers may be reordered, the id identifies the request.
+
+   Every worker owns a command context that executes the prelude once
+   and records a checkpoint. The context is restored to the checkpoint
+   after each request, so requests do not see each other's declarations.
+   A context whose checkpoint was popped or reset by a request is rebuilt.
+*/
+namespace {
+
+    class smt2_server {
+        std::string    m_prelude;
+        mutex          m_in_mux;
+        mutex          m_out_mux;
+
+        struct request {
+            std::string m_id;
+            unsigned    m_timeout { 0 };
+            unsigned    m_rlimit { 0 };
+            std::string m_data;
+        };
+
+        struct worker {
+            smt2_server&           m_server;
+            scoped_ptr<cmd_context> m_ctx;
+            unsigned               m_base_timeout { UINT_MAX };
+            unsigned               m_base_rlimit { 0 };
+
+            worker(smt2_server& s): m_server(s) {}
+
+            void init() {
+                m_ctx = alloc(cmd_context);
+                m_ctx->set_solver_factory(mk_smt_strategic_solver_factory());
+                install_dl_cmds(*m_ctx);
+                install_dbg_cmds(*m_ctx);
+                install_polynomial_cmds(*m_ctx);
+                install_subpaving_cmds(*m_ctx);
+                install_opt_cmds(*m_ctx);
+                install_smt2_extra_cmds(*m_ctx);
+                std::ostringstream out;
+                m_ctx->set_regular_stream(out);
+                m_ctx->set_diagnostic_stream(out);
+                if (!m_server.m_prelude.empty())
+                    parse_smt2_commands(*m_ctx, m_server.m_prelude.data(), m_server.m_prelude.size());
+                std::cerr << out.str();
+                m_ctx->checkpoint();
+                m_base_timeout = m_ctx->params().m_timeout;
+                m_base_rlimit = m_ctx->params().rlimit();
+            }
+
+            void run(request const& r, std::ostream& out) {
+                if (!m_ctx || !m_ctx->has_checkpoint())
+                    init();
+                m_ctx->set_regular_stream(out);
+                m_ctx->set_diagnostic_stream(out);
+                m_ctx->params().m_timeout = r.m_timeout ? r.m_timeout : m_base_timeout;
+                m_ctx->params().set_rlimit(r.m_rlimit ? r.m_rlimit : m_base_rlimit);
+                try {
+                    parse_smt2_commands(*m_ctx, r.m_data.data(), r.m_data.size());
+                }
+                catch (z3_exception& ex) {
+                    out << "(error \"" << ex.msg() << "\")\n";
+                }
+                m_ctx->params().m_timeout = m_base_timeout;
+                m_ctx->params().set_rlimit(m_base_rlimit);
+                try {
+                    if (m_ctx->has_checkpoint())
+                        m_ctx->restore_checkpoint();
+                    else
+                        m_ctx = nullptr;
+                }
+                catch (z3_exception&) {
+                    m_ctx = nullptr;
+                }
+            }
+        };
+
+        bool read(request& r) {
+            lock_guard lock(m_in_mux);
+            std::string header;
+            while (header.empty()) 
+                if (!std::getline(std::cin, header))
+                    return false;
+            std::istringstream hs(header);
+            size_t length = 0;
+            if (!(hs >> r.m_id >> length)) {
+                std::cerr << "(error \"invalid request header '" << header << "'\")" << std::endl;
+                return false;
+            }
+            r.m_timeout = 0;
+            r.m_rlimit = 0;
+            hs >> r.m_timeout >> r.m_rlimit;
+            r.m_data.resize(length);
+            return !length || std::cin.read(&r.m_data[0], length);
+        }
+
+        void write(request const& r, std::string const& result) {
+            lock_guard lock(m_out_mux);
+            std::cout << r.m_id << " " << result.size() << "\n" << result;
+            std::cout.flush();
+        }
+
+        void serve() {
+            worker w(*this);
+            request r;
+            while (read(r)) {
+                std::ostringstream out;
+                w.run(r, out);
+                write(r, out.str());
+            }
+        }
+
+    public:
+        smt2_server(std::string const& prelude): m_prelude(prelude) {}
+
+        void operator()(unsigned num_threads) {
+#ifndef SINGLE_THREAD
+            if (num_threads > 1) {
+                std::vector<std::thread> threads;
+                for (unsigned i = 0; i < num_threads; ++i)
+                    threads.push_back(std::thread([this]() { serve(); }));
+                for (auto& t : threads)
+                    t.join();
+                return;
+            }
+#endif
+            serve();
+        }
+    };
+}
+
+unsigned serve_smtlib2_commands(char const * prelude_file, unsigned num_threads) {
+    std::string prelude;
+    if (prelude_file) {
+        std::ifstream in(prelude_file, std::ios::binary);
+        if (in.bad() || in.fail()) {
+            std::cerr << "(error \"failed to open file '" << prelude_file << "'\")" << std::endl;
+            exit(ERR_OPEN_FILE);
+        }
+        prelude.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    }
+    smt2_server server(prelude);
+    server(num_threads == 0 ? 1 : num_threads);
+    return 0;
+}
@@ -20,6 +20,8 @@ Revision History:
 
 unsigned read_smtlib_file(char const * benchmark_file);
 unsigned read_smtlib2_commands(char const * command_file);
+unsigned read_binary_assertions(char const * file_name);
+unsigned serve_smtlib2_commands(char const * prelude_file, unsigned num_threads);
 void help_tactics();
 void help_probes();
 void help_tactic(char const* name);
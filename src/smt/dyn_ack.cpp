@@ -165,7 +165,8 @@ namespace smt {
     dyn_ack_manager::dyn_ack_manager(context & ctx, dyn_ack_params & p):
         m_context(ctx),
         m(ctx.get_manager()),
-        m_params(p) {
+        m_params(p),
+        m_stamp(0) {
     }
 
     dyn_ack_manager::~dyn_ack_manager() {
@@ -209,23 +210,18 @@ namespace smt {
         if (m_instantiated.contains(p)) {
             return;
         }
-        unsigned num_occs = 0;
-        if (m_app_pair2num_occs.find(n1, n2, num_occs)) {
-            TRACE("dyn_ack", tout << "used_cg_eh:\n" << mk_pp(n1, m) << "\n" << mk_pp(n2, m) << "\nnum_occs: " << num_occs << "\n";);
-            num_occs++;
-        }
-        else {
-            num_occs = 1;
+        if (!m_app_pair2num_occs.contains(n1, n2)) {
+            if (m_params.m_dack_max_candidates > 0 && m_app_pair2num_occs.size() >= m_params.m_dack_max_candidates)
+                evict();
             m.inc_ref(n1);
             m.inc_ref(n2);
             m_app_pairs.push_back(p);
         }
-        SASSERT(num_occs > 0);
-        m_app_pair2num_occs.insert(n1, n2, num_occs);
-#ifdef Z3DEBUG
-        unsigned num_occs2 = 0;
-        SASSERT(m_app_pair2num_occs.find(n1, n2, num_occs2) && num_occs == num_occs2);
-#endif
+        num_occs & occs = m_app_pair2num_occs.insert_if_not_there(n1, n2, num_occs());
+        TRACE("dyn_ack", tout << "used_cg_eh:\n" << mk_pp(n1, m) << "\n" << mk_pp(n2, m) << "\nnum_occs: " << occs.m_count << "\n";);
+        occs.m_count++;
+        occs.m_last_used = ++m_stamp;
+        unsigned num_occs = occs.m_count;
         if (num_occs == m_params.m_dack_threshold) {
             TRACE("dyn_ack", tout << "found candidate:\n" << mk_pp(n1, m) << "\n" << mk_pp(n2, m) << "\nnum_occs: " << num_occs << "\n";);
             m_to_instantiate.push_back(p);
@@ -272,26 +268,6 @@ namespace smt {
         
     }
 
-    struct app_pair_lt { 
-        typedef std::pair<app *, app *>          app_pair;
-        typedef obj_pair_map<app, app, unsigned> app_pair2num_occs;
-        app_pair2num_occs &  m_app_pair2num_occs;
-        
-        app_pair_lt(app_pair2num_occs & m):
-            m_app_pair2num_occs(m) {
-        }
-        
-        bool operator()(app_pair const & p1, app_pair const & p2) const {
-            unsigned n1 = 0;
-            unsigned n2 = 0;
-            m_app_pair2num_occs.find(p1.first, p1.second, n1);
-            m_app_pair2num_occs.find(p2.first, p2.second, n2);
-            SASSERT(n1 > 0);
-            SASSERT(n2 > 0);
-            return n1 > n2;
-        }
-    };
-
     void dyn_ack_manager::gc() {
         TRACE("dyn_ack", tout << "dyn_ack GC\n";);
         unsigned num_deleted = 0;
@@ -309,8 +285,9 @@ namespace smt {
                 SASSERT(!m_app_pair2num_occs.contains(p.first, p.second));
                 continue;
             }
-            unsigned num_occs = 0;
-            m_app_pair2num_occs.find(p.first, p.second, num_occs);
+            num_occs occs;
+            m_app_pair2num_occs.find(p.first, p.second, occs);
+            unsigned num_occs = occs.m_count;
             // The following invariant is not true. p.first and
             // p.second may have been instantiated, and removed from
             // m_app_pair2num_occs, but not from m_app_pairs.
@@ -328,18 +305,62 @@ namespace smt {
             *it2 = p;
             ++it2;
             SASSERT(num_occs > 0);
-            m_app_pair2num_occs.insert(p.first, p.second, num_occs);
+            occs.m_count = num_occs;
+            m_app_pair2num_occs.insert(p.first, p.second, occs);
             if (num_occs >= m_params.m_dack_threshold)
                 m_to_instantiate.push_back(p);
         }
         m_app_pairs.set_end(it2);
-        app_pair_lt f(m_app_pair2num_occs);
-        // app_pair_lt is not a total order on pairs of expressions.
+        auto lt = [&](app_pair const & p1, app_pair const & p2) {
+            return m_app_pair2num_occs.find(p1.first, p1.second).m_count > m_app_pair2num_occs.find(p2.first, p2.second).m_count;
+        };
+        // lt is not a total order on pairs of expressions.
         // So, we should use stable_sort to avoid different behavior in different platforms.
-        std::stable_sort(m_to_instantiate.begin(), m_to_instantiate.end(), f);
+        std::stable_sort(m_to_instantiate.begin(), m_to_instantiate.end(), lt);
         // IF_VERBOSE(10, if (num_deleted > 0) verbose_stream() << "dynamic ackermann GC: " << num_deleted << "\n";);
     }
 
+    /**
+       \brief remove the least recently used half of the candidates.
+    */
+    void dyn_ack_manager::evict() {
+        unsigned_vector stamps;
+        for (app_pair const & p : m_app_pairs) {
+            num_occs occs;
+            if (m_app_pair2num_occs.find(p.first, p.second, occs))
+                stamps.push_back(occs.m_last_used);
+        }
+        if (stamps.empty())
+            return;
+        unsigned mid = stamps.size() / 2;
+        std::nth_element(stamps.begin(), stamps.begin() + mid, stamps.end());
+        unsigned min_stamp = stamps[mid];
+        unsigned j = 0;
+        for (app_pair const & p : m_app_pairs) {
+            num_occs occs;
+            bool is_candidate = m_app_pair2num_occs.find(p.first, p.second, occs);
+            if (m_instantiated.contains(p) || (is_candidate && occs.m_last_used >= min_stamp)) {
+                m_app_pairs[j++] = p;
+                continue;
+            }
+            if (is_candidate) {
+                m_app_pair2num_occs.erase(p.first, p.second);
+                m_context.m_stats.m_num_dyn_ack_evicted++;
+            }
+            m.dec_ref(p.first);
+            m.dec_ref(p.second);
+        }
+        m_app_pairs.shrink(j);
+        j = m_qhead;
+        for (unsigned i = m_qhead; i < m_to_instantiate.size(); ++i) {
+            app_pair const & p = m_to_instantiate[i];
+            if (m_app_pair2num_occs.contains(p.first, p.second))
+                m_to_instantiate[j++] = p;
+        }
+        m_to_instantiate.shrink(j);
+        TRACE("dyn_ack", tout << "evicted candidates, remaining: " << m_app_pair2num_occs.size() << "\n";);
+    }
+
     class dyn_ack_clause_del_eh : public clause_del_eh {
         dyn_ack_manager & m;
     public:
@@ -356,6 +377,7 @@ namespace smt {
     void dyn_ack_manager::del_clause_eh(clause * cls) {
         m_context.m_stats.m_num_del_dyn_ack++;
         app_pair p((app*)nullptr,(app*)nullptr);
+        m_used_lemmas.erase(cls);
         if (m_clause2app_pair.find(cls, p)) {
             SASSERT(p.first && p.second);
             m_instantiated.erase(p);
@@ -373,6 +395,16 @@ namespace smt {
         }
     }
 
+    void dyn_ack_manager::used_lemma_eh(clause * cls) {
+        if (!m_clause2app_pair.contains(cls) && !m_triple.m_clause2apps.contains(cls))
+            return;
+        m_context.m_stats.m_num_dyn_ack_used++;
+        if (!m_used_lemmas.contains(cls)) {
+            m_used_lemmas.insert(cls);
+            m_context.m_stats.m_num_dyn_ack_useful++;
+        }
+    }
+
     void dyn_ack_manager::propagate_eh() {
         if (m_params.m_dack == dyn_ack_strategy::DACK_DISABLED)
             return;
@@ -445,6 +477,7 @@ namespace smt {
         init_search_eh();
         m_instantiated.reset();
         m_clause2app_pair.reset();
+        m_used_lemmas.reset();
         m_triple.m_instantiated.reset();
         m_triple.m_clause2apps.reset();
     }
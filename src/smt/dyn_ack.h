@@ -31,7 +31,11 @@ namespace smt {
 
     class dyn_ack_manager {
         typedef std::pair<app *, app *>           app_pair;
-        typedef obj_pair_map<app, app, unsigned>  app_pair2num_occs;
+        struct num_occs {
+            unsigned m_count     { 0 };
+            unsigned m_last_used { 0 };  //!< stamp of the last use, the least recently used candidates are evicted first.
+        };
+        typedef obj_pair_map<app, app, num_occs>  app_pair2num_occs;
         typedef svector<app_pair>                 app_pair_vector;
         typedef obj_pair_hashtable<app, app>      app_pair_set;
         typedef obj_map<clause, app_pair>         clause2app_pair;
@@ -46,6 +50,7 @@ namespace smt {
         ast_manager &                              m;
         dyn_ack_params &                           m_params;
         app_pair2num_occs                          m_app_pair2num_occs;
+        unsigned                                   m_stamp;
         app_pair_vector                            m_app_pairs;
         app_pair_vector                            m_to_instantiate;
         unsigned                                   m_qhead;
@@ -53,6 +58,7 @@ namespace smt {
         unsigned                                   m_num_propagations_since_last_gc;
         app_pair_set                               m_instantiated;
         clause2app_pair                            m_clause2app_pair;
+        obj_hashtable<clause>                      m_used_lemmas;     // lemmas that were used in conflicts
 
         struct _triple {
             app_triple2num_occs                    m_app2num_occs;
@@ -69,6 +75,7 @@ namespace smt {
 
 
         void gc();
+        void evict();
         void reset_app_pairs();
         friend class dyn_ack_clause_del_eh;
         void del_clause_eh(clause * cls);
@@ -118,6 +125,11 @@ namespace smt {
         }
 
         
+        /**
+           \brief This method is invoked when a lemma with a deletion handler is used during conflict resolution.
+        */
+        void used_lemma_eh(clause * cls);
+
         /**
            \brief This method is invoked when it is safe to expand the new ackermann rule entries.
         */
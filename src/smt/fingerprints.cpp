@@ -20,16 +20,20 @@ Revision History:
 
 namespace smt {
 
-    fingerprint::fingerprint(region & r, void * d, unsigned d_h, expr* def, unsigned n, enode * const * args):
+    fingerprint::fingerprint(void * d, unsigned d_h, expr* def, unsigned n, enode * const * args):
         m_data(d), 
         m_data_hash(d_h),
         m_def(def),
         m_num_args(n), 
-        m_args(nullptr) {
-        m_args = new (r) enode*[n];
+        m_args(reinterpret_cast<enode**>(this + 1)) {
         memcpy(m_args, args, sizeof(enode*) * n);
     }
 
+    fingerprint * fingerprint::mk(region & r, void * d, unsigned d_h, expr* def, unsigned n, enode * const * args) {
+        void * mem = r.allocate(sizeof(fingerprint) + sizeof(enode*) * n);
+        return new (mem) fingerprint(d, d_h, def, n, args);
+    }
+
     bool fingerprint_set::fingerprint_eq_proc::operator()(fingerprint const * f1, fingerprint const * f2) const {
         if (f1->get_data() != f2->get_data()) 
             return false;
@@ -73,9 +77,10 @@ namespace smt {
             return nullptr;
         }
         TRACE("fingerprint_bug", tout << "inserting @" << m_scopes.size() << " " << *d;);
-        fingerprint * f = new (m_region) fingerprint(m_region, data, data_hash, def, num_args, d->m_args);
+        fingerprint * f = fingerprint::mk(m_region, data, data_hash, def, num_args, d->m_args);
         m_fingerprints.push_back(f);
-        m_defs.push_back(def);
+        if (def)
+            m_defs.push_back(def);
         m_set.insert(f);
         return f;
     }
@@ -99,6 +104,7 @@ namespace smt {
         
     void fingerprint_set::push_scope() {
         m_scopes.push_back(m_fingerprints.size());
+        m_defs_lim.push_back(m_defs.size());
     }
     
     void fingerprint_set::pop_scope(unsigned num_scopes) {
@@ -110,11 +116,25 @@ namespace smt {
         for (unsigned i = old_size; i < size; i++) 
             m_set.erase(m_fingerprints[i]);
         m_fingerprints.shrink(old_size);
-        m_defs.shrink(old_size);
+        m_defs.shrink(m_defs_lim[new_lvl]);
         m_scopes.shrink(new_lvl);
+        m_defs_lim.shrink(new_lvl);
+        compact_set();
         TRACE("fingerprint_bug", tout << "pop @" << m_scopes.size() << "\n";);
     }
 
+    /**
+       \brief shrink the table when popping left it mostly empty, so that
+       the memory of fingerprints from large scopes is not kept by the table.
+    */
+    void fingerprint_set::compact_set() {
+        if (m_set.capacity() <= 1024 || m_set.size() * 8 >= m_set.capacity())
+            return;
+        m_set.finalize();
+        for (fingerprint * f : m_fingerprints)
+            m_set.insert(f);
+    }
+
     void fingerprint_set::display(std::ostream & out) const {
         out << "fingerprints:\n";
         SASSERT(m_set.size() == m_fingerprints.size());
@@ -33,8 +33,10 @@ namespace smt {
 
         friend class fingerprint_set;
         fingerprint() {}
+        fingerprint(void * d, unsigned d_hash, expr* def, unsigned n, enode * const * args);
     public:
-        fingerprint(region & r, void * d, unsigned d_hash, expr* def, unsigned n, enode * const * args);
+        // the arguments are stored in the same allocation, right after the fingerprint.
+        static fingerprint * mk(region & r, void * d, unsigned d_hash, expr* def, unsigned n, enode * const * args);
         void * get_data() const { return m_data; }
         expr * get_def() const { return m_def; }
         unsigned get_data_hash() const { return m_data_hash; }
@@ -65,12 +67,14 @@ namespace smt {
         region &                 m_region;
         set                      m_set;
         ptr_vector<fingerprint>  m_fingerprints;
-        expr_ref_vector          m_defs;
+        expr_ref_vector          m_defs;       // non-null definitions of fingerprints
         unsigned_vector          m_scopes;
+        unsigned_vector          m_defs_lim;
         ptr_vector<enode>        m_tmp;
         fingerprint              m_dummy;
 
         fingerprint * mk_dummy(void * data, unsigned data_hash, unsigned num_args, enode * const * args);
+        void compact_set();
 
     public:
         fingerprint_set(ast_manager& m, region & r): m_region(r), m_defs(m) {}
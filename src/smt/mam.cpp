@@ -17,8 +17,13 @@ Revision History:
 
 --*/
 #include <algorithm>
+#ifndef SINGLE_THREAD
+#include <thread>
+#endif
 
 #include "util/pool.h"
+#include "util/mutex.h"
+#include "util/scoped_ptr_vector.h"
 #include "util/trail.h"
 #include "util/stopwatch.h"
 #include "ast/ast_pp.h"
@@ -1864,6 +1869,53 @@ namespace {
 
         pool<enode_vector>  m_pool;
 
+        // When matching in a worker thread, matches are recorded and added
+        // to the context by flush_matches once all workers are done.
+        struct buffered_match {
+            quantifier * m_qa;
+            app *        m_pat;
+            unsigned     m_num_bindings;
+            unsigned     m_bindings_begin;
+            unsigned     m_used_enodes_begin;
+            unsigned     m_used_enodes_end;
+            unsigned     m_max_generation;
+            unsigned     m_min_top_generation;
+            unsigned     m_max_top_generation;
+        };
+        bool                    m_buffered { false };
+        mutex *                 m_cgr_mutex { nullptr };
+        svector<buffered_match> m_matches;
+        enode_vector            m_match_bindings;
+        vector<std::tuple<enode *, enode *>> m_match_used_enodes;
+        obj_hashtable<enode>    m_visited;
+
+        bool limits_exceeded() {
+            return m_buffered ? m.limit().is_canceled() : m_context.resource_limits_exceeded();
+        }
+
+        enode * get_enode_eq_to(func_decl * f, unsigned num_args, enode * const * args) {
+            if (!m_cgr_mutex)
+                return m_context.get_enode_eq_to(f, num_args, args);
+            lock_guard lock(*m_cgr_mutex);
+            return m_context.get_enode_eq_to(f, num_args, args);
+        }
+
+        void buffer_match(quantifier * qa, app * pat, unsigned num_bindings) {
+            buffered_match bm;
+            bm.m_qa = qa;
+            bm.m_pat = pat;
+            bm.m_num_bindings = num_bindings;
+            bm.m_bindings_begin = m_match_bindings.size();
+            bm.m_used_enodes_begin = m_match_used_enodes.size();
+            bm.m_max_generation = m_max_generation;
+            get_min_max_top_generation(bm.m_min_top_generation, bm.m_max_top_generation);
+            for (unsigned i = 0; i < num_bindings; ++i)
+                m_match_bindings.push_back(m_bindings[i]);
+            m_match_used_enodes.append(m_used_enodes);
+            bm.m_used_enodes_end = m_match_used_enodes.size();
+            m_matches.push_back(bm);
+        }
+
         enode_vector * mk_enode_vector() {
             enode_vector * r = m_pool.mk();
             r->reset();
@@ -1998,6 +2050,32 @@ namespace {
         ~interpreter() {
         }
 
+        /**
+           \brief record matches instead of reporting them to the mam.
+           Lookups in the congruence table are serialized by cgr_mutex.
+        */
+        void set_buffered(mutex * cgr_mutex) {
+            m_buffered = true;
+            m_cgr_mutex = cgr_mutex;
+        }
+
+        /**
+           \brief add the recorded matches to the context in the order they were found.
+        */
+        void flush_matches() {
+            vector<std::tuple<enode *, enode *>> used_enodes;
+            for (buffered_match const& bm : m_matches) {
+                used_enodes.reset();
+                for (unsigned i = bm.m_used_enodes_begin; i < bm.m_used_enodes_end; ++i)
+                    used_enodes.push_back(m_match_used_enodes[i]);
+                m_context.add_instance(bm.m_qa, bm.m_pat, bm.m_num_bindings, m_match_bindings.data() + bm.m_bindings_begin, nullptr,
+                                       bm.m_max_generation, bm.m_min_top_generation, bm.m_max_top_generation, used_enodes);
+            }
+            m_matches.reset();
+            m_match_bindings.reset();
+            m_match_used_enodes.reset();
+        }
+
         void init(code_tree * t) {
             TRACE("mam_bug", tout << "preparing to match tree:\n" << *t << "\n";);
             m_registers.reserve(t->get_num_regs(), nullptr);
@@ -2009,11 +2087,22 @@ namespace {
         void execute(code_tree * t) {
             TRACE("trigger_bug", tout << "execute for code tree:\n"; t->display(tout););
             init(t);
-            if (t->filter_candidates()) {
+            if (t->filter_candidates() && m_buffered) {
+                // enode marks are shared with the other workers.
+                m_visited.reset();
+                for (enode* app : t->get_candidates()) {
+                    if (!m_visited.contains(app) && app->is_cgr()) {
+                        if (limits_exceeded() || !execute_core(t, app))
+                            return;
+                        m_visited.insert(app);
+                    }
+                }
+            }
+            else if (t->filter_candidates()) {
                 for (enode* app : t->get_candidates()) {
                     TRACE("trigger_bug", tout << "candidate\n" << mk_ismt2_pp(app->get_expr(), m) << "\n";);
                     if (!app->is_marked() && app->is_cgr()) {
-                        if (m_context.resource_limits_exceeded() || !execute_core(t, app))
+                        if (limits_exceeded() || !execute_core(t, app))
                             return;
                         app->set_mark();
                     }
@@ -2028,7 +2117,7 @@ namespace {
                     TRACE("trigger_bug", tout << "candidate\n" << mk_ismt2_pp(app->get_expr(), m) << "\n";);
                     if (app->is_cgr()) {
                         TRACE("trigger_bug", tout << "is_cgr\n";);
-                        if (m_context.resource_limits_exceeded() || !execute_core(t, app))
+                        if (limits_exceeded() || !execute_core(t, app))
                             return;
                     }
                 }
@@ -2531,9 +2620,17 @@ namespace {
             m_bindings[0] = m_registers[static_cast<const yield *>(m_pc)->m_bindings[0]];
 #define ON_MATCH(NUM)                                                   \
             m_max_generation = std::max(m_max_generation, get_max_generation(NUM, m_bindings.begin())); \
-            if (m_context.get_cancel_flag()) {                          \
+            if (m_buffered) {                                           \
+                if (m.limit().is_canceled())                            \
+                    return false;                                       \
+                buffer_match(static_cast<const yield *>(m_pc)->m_qa,    \
+                             static_cast<const yield *>(m_pc)->m_pat,   \
+                             NUM);                                      \
+            }                                                           \
+            else if (m_context.get_cancel_flag()) {                     \
                 return false;                                           \
             }                                                           \
+            else                                                        \
             m_mam.on_match(static_cast<const yield *>(m_pc)->m_qa,                                      \
                            static_cast<const yield *>(m_pc)->m_pat,                                     \
                            NUM,                                                                         \
@@ -2596,7 +2693,7 @@ namespace {
 
         case GET_CGR1:
 #define GET_CGR_COMMON()                                                                                                                                                \
-            m_n1 = m_context.get_enode_eq_to(static_cast<const get_cgr *>(m_pc)->m_label, static_cast<const get_cgr *>(m_pc)->m_num_args, m_args.data());              \
+            m_n1 = get_enode_eq_to(static_cast<const get_cgr *>(m_pc)->m_label, static_cast<const get_cgr *>(m_pc)->m_num_args, m_args.data());              \
             if (m_n1 == 0 || !m_context.is_relevant(m_n1))                                                                                                              \
                 goto backtrack;                                                                                                                                         \
             update_max_generation(m_n1, nullptr);                                                                                                                       \
@@ -2707,7 +2804,7 @@ namespace {
 
         if (since_last_check++ > 100) {
             since_last_check = 0;
-            if (m_context.resource_limits_exceeded()) {
+            if (limits_exceeded()) {
                 // Soft timeout...
                 // Cleanup before exiting
                 while (m_top != 0) {
@@ -3090,6 +3187,7 @@ namespace {
         code_tree_manager           m_ct_manager;
         compiler                    m_compiler;
         interpreter                 m_interpreter;
+        scoped_ptr_vector<interpreter> m_workers; // used when matching in parallel
         code_tree_map               m_trees;
 
         ptr_vector<code_tree>       m_tmp_trees;
@@ -3882,13 +3980,61 @@ namespace {
             }
         }
 
+#ifndef SINGLE_THREAD
+        /**
+           \brief execute the code trees in m_to_match using num_threads interpreters.
+           Each interpreter executes a contiguous range of trees and the matches are
+           added to the context in the order of m_to_match, as in sequential matching.
+        */
+        void match_parallel(unsigned num_threads) {
+            while (m_workers.size() < num_threads)
+                m_workers.push_back(alloc(interpreter, m_context, *this, m_use_filters));
+            mutex cgr_mutex;
+            unsigned sz = m_to_match.size();
+            unsigned chunk = (sz + num_threads - 1) / num_threads;
+            std::string ex_msg;
+            bool failed = false;
+            auto worker = [&](unsigned id) {
+                interpreter & w = *m_workers[id];
+                w.set_buffered(&cgr_mutex);
+                try {
+                    unsigned end = std::min(sz, (id + 1) * chunk);
+                    for (unsigned i = id * chunk; i < end; ++i)
+                        w.execute(m_to_match[i]);
+                }
+                catch (z3_exception & ex) {
+                    lock_guard lock(cgr_mutex);
+                    failed = true;
+                    ex_msg = ex.msg();
+                }
+            };
+            vector<std::thread> threads;
+            for (unsigned id = 1; id < num_threads; ++id)
+                threads.push_back(std::thread([&, id]() { worker(id); }));
+            worker(0);
+            for (auto & th : threads)
+                th.join();
+            for (interpreter * w : m_workers)
+                w->flush_matches();
+            if (failed)
+                throw default_exception(std::move(ex_msg));
+        }
+#endif
+
         void match() override {
             TRACE("trigger_bug", tout << "match\n"; display(tout););
+#ifndef SINGLE_THREAD
+            unsigned num_threads = m_context.get_fparams().m_qi_match_threads;
+            if (num_threads > 1 && m_to_match.size() >= 2 * num_threads)
+                match_parallel(num_threads);
+            else
+#endif
             for (code_tree* t : m_to_match) {
                 SASSERT(t->has_candidates());
                 m_interpreter.execute(t);
-                t->reset_candidates();
             }
+            for (code_tree* t : m_to_match)
+                t->reset_candidates();
             m_to_match.reset();
             if (!m_new_patterns.empty()) {
                 match_new_patterns();
@@ -28,6 +28,7 @@ void qi_params::updt_params(params_ref const & _p) {
     m_mbqi_trace = p.mbqi_trace();
     m_mbqi_force_template = p.mbqi_force_template();
     m_mbqi_id = p.mbqi_id();
+    m_mbqi_threads = p.mbqi_threads();
     m_qi_profile = p.qi_profile();
     m_qi_profile_freq = p.qi_profile_freq();
     m_qi_max_instances = p.qi_max_instances();
@@ -36,6 +37,9 @@ void qi_params::updt_params(params_ref const & _p) {
     m_qi_cost = p.qi_cost();
     m_qi_max_eager_multipatterns = p.qi_max_multi_patterns();
     m_qi_quick_checker = static_cast<quick_checker_mode>(p.qi_quick_checker());
+    m_qi_match_threads = p.qi_match_threads();
+    m_qi_learn = p.qi_learn();
+    m_qi_learn_weight = p.qi_learn_weight();
 }
 
 #define DISPLAY_PARAM(X) out << #X"=" << X << std::endl;
@@ -55,6 +59,9 @@ void qi_params::display(std::ostream & out) const {
     DISPLAY_PARAM(m_qi_max_instances);
     DISPLAY_PARAM(m_qi_lazy_instantiation);
     DISPLAY_PARAM(m_qi_conservative_final_check);
+    DISPLAY_PARAM(m_qi_match_threads);
+    DISPLAY_PARAM(m_qi_learn);
+    DISPLAY_PARAM(m_qi_learn_weight);
     DISPLAY_PARAM(m_mbqi);
     DISPLAY_PARAM(m_mbqi_max_cexs);
     DISPLAY_PARAM(m_mbqi_max_cexs_incr);
@@ -62,4 +69,5 @@ void qi_params::display(std::ostream & out) const {
     DISPLAY_PARAM(m_mbqi_trace);
     DISPLAY_PARAM(m_mbqi_force_template);
     DISPLAY_PARAM(m_mbqi_id);
+    DISPLAY_PARAM(m_mbqi_threads);
 }
@@ -42,6 +42,9 @@ struct qi_params {
     unsigned           m_qi_max_instances;
     bool               m_qi_lazy_instantiation;
     bool               m_qi_conservative_final_check;
+    unsigned           m_qi_match_threads;
+    bool               m_qi_learn;
+    double             m_qi_learn_weight;
 
     bool               m_mbqi;
     unsigned           m_mbqi_max_cexs;
@@ -50,6 +53,7 @@ struct qi_params {
     bool               m_mbqi_trace;
     unsigned           m_mbqi_force_template;
     const char *       m_mbqi_id;
+    unsigned           m_mbqi_threads;
 
     qi_params(params_ref const & p = params_ref()):
         /*
@@ -91,13 +95,17 @@ struct qi_params {
         m_qi_max_instances(UINT_MAX),
         m_qi_lazy_instantiation(false),
         m_qi_conservative_final_check(false),
+        m_qi_match_threads(1),
+        m_qi_learn(false),
+        m_qi_learn_weight(1.0),
         m_mbqi(true), // enabled by default
         m_mbqi_max_cexs(1),
         m_mbqi_max_cexs_incr(1),
         m_mbqi_max_iterations(1000),
         m_mbqi_trace(false),
         m_mbqi_force_template(10),
-        m_mbqi_id(nullptr)
+        m_mbqi_id(nullptr),
+        m_mbqi_threads(1)
     {
         updt_params(p);
     }
@@ -42,15 +42,22 @@ void smt_params::updt_local_params(params_ref const & _p) {
     m_delay_units_threshold = p.delay_units_threshold();
     m_preprocess = _p.get_bool("preprocess", true); // hidden parameter
     m_max_conflicts = p.max_conflicts();
+    m_budget = p.budget();
+    m_region_page_size = p.region_page_size();
     m_restart_max   = p.restart_max();
     m_cube_depth    = p.cube_depth();
     m_threads       = p.threads();
     m_threads_max_conflicts  = p.threads_max_conflicts();
     m_threads_cube_frequency = p.threads_cube_frequency();
+    m_threads_cube_and_conquer = p.threads_cube_and_conquer();
     m_core_validate = p.core_validate();
+    m_profile = p.profile();
+    m_profile_file = p.profile_file();
+    m_euf_batch_merge = p.euf_batch_merge();
     m_logic = _p.get_sym("logic", m_logic);
     m_string_solver = p.string_solver();
     validate_string_solver(m_string_solver);
+    m_fpa_lazy = p.fpa_lazy();
     if (_p.get_bool("arith.greatest_error_pivot", false))
         m_arith_pivot_strategy = arith_pivot_strategy::ARITH_PIVOT_GREATEST_ERROR;
     else if (_p.get_bool("arith.least_error_pivot", false))
@@ -110,10 +117,13 @@ void smt_params::display(std::ostream & out) const {
     DISPLAY_PARAM(m_phase_caching_off);
     DISPLAY_PARAM(m_minimize_lemmas);
     DISPLAY_PARAM(m_max_conflicts);
+    DISPLAY_PARAM(m_budget);
+    DISPLAY_PARAM(m_region_page_size);
     DISPLAY_PARAM(m_cube_depth);
     DISPLAY_PARAM(m_threads);
     DISPLAY_PARAM(m_threads_max_conflicts);
     DISPLAY_PARAM(m_threads_cube_frequency);
+    DISPLAY_PARAM(m_threads_cube_and_conquer);
     DISPLAY_PARAM(m_simplify_clauses);
     DISPLAY_PARAM(m_tick);
     DISPLAY_PARAM(m_display_features);
@@ -153,8 +163,12 @@ void smt_params::display(std::ostream & out) const {
     DISPLAY_PARAM(m_smtlib_dump_lemmas);
     DISPLAY_PARAM(m_logic);
     DISPLAY_PARAM(m_string_solver);
+    DISPLAY_PARAM(m_fpa_lazy);
 
     DISPLAY_PARAM(m_profile_res_sub);
+    DISPLAY_PARAM(m_profile);
+    DISPLAY_PARAM(m_profile_file);
+    DISPLAY_PARAM(m_euf_batch_merge);
     DISPLAY_PARAM(m_display_bool_var2expr);
     DISPLAY_PARAM(m_display_ll_bool_var2expr);
 
@@ -69,7 +69,8 @@ enum case_split_strategy {
     CS_RELEVANCY, // case split based on relevancy
     CS_RELEVANCY_ACTIVITY, // case split based on relevancy and activity
     CS_RELEVANCY_GOAL, // based on relevancy and the current goal
-    CS_ACTIVITY_THEORY_AWARE_BRANCHING // activity-based case split, but theory solvers can manipulate activity
+    CS_ACTIVITY_THEORY_AWARE_BRANCHING, // activity-based case split, but theory solvers can manipulate activity
+    CS_LEARNING_RATE // case split based on learning rate and target/best phase rephasing
 };
 
 struct smt_params : public preprocessor_params,
@@ -100,11 +101,14 @@ struct smt_params : public preprocessor_params,
     unsigned         m_phase_caching_off;
     bool             m_minimize_lemmas;
     unsigned         m_max_conflicts;
+    unsigned         m_budget;
+    unsigned         m_region_page_size;
     unsigned         m_restart_max;
     unsigned         m_cube_depth;
     unsigned         m_threads;
     unsigned         m_threads_max_conflicts;
     unsigned         m_threads_cube_frequency;
+    bool             m_threads_cube_and_conquer;
     bool             m_simplify_clauses;
     unsigned         m_tick;
     bool             m_display_features;
@@ -182,6 +186,9 @@ struct smt_params : public preprocessor_params,
     //
     // -----------------------------------
     bool              m_profile_res_sub;
+    bool              m_profile;
+    symbol            m_profile_file;
+    bool              m_euf_batch_merge;
     bool              m_display_bool_var2expr;
     bool              m_display_ll_bool_var2expr;
 
@@ -237,6 +244,13 @@ struct smt_params : public preprocessor_params,
     // -----------------------------------
     symbol m_string_solver;
 
+    // -----------------------------------
+    //
+    // Floating point
+    //
+    // -----------------------------------
+    bool m_fpa_lazy;
+
     smt_params(params_ref const & p = params_ref()):
         m_display_proof(false),
         m_display_dot_proof(false),
@@ -256,10 +270,13 @@ struct smt_params : public preprocessor_params,
         m_phase_caching_off(100),
         m_minimize_lemmas(true),
         m_max_conflicts(UINT_MAX),
+        m_budget(0),
+        m_region_page_size(0),
         m_cube_depth(1),
         m_threads(1),
         m_threads_max_conflicts(UINT_MAX),
         m_threads_cube_frequency(2),
+        m_threads_cube_and_conquer(false),
         m_simplify_clauses(true),
         m_tick(1000),
         m_display_features(false),
@@ -295,6 +312,8 @@ struct smt_params : public preprocessor_params,
         m_smtlib_dump_lemmas(false),
         m_logic(symbol::null),
         m_profile_res_sub(false),
+        m_profile(false),
+        m_euf_batch_merge(false),
         m_display_bool_var2expr(false),
         m_display_ll_bool_var2expr(false),
         m_model(true),
@@ -309,7 +328,8 @@ struct smt_params : public preprocessor_params,
         m_check_at_labels(false),
         m_dump_goal_as_smt(false),
         m_auto_config(true),
-        m_string_solver(symbol("auto")){
+        m_string_solver(symbol("auto")),
+        m_fpa_lazy(false) {
         updt_local_params(p);
     }
 
@@ -37,6 +37,8 @@ void theory_arith_params::updt_params(params_ref const & _p) {
     m_arith_dump_lemmas = p.arith_dump_lemmas();
     m_arith_eager_eq_axioms = p.arith_eager_eq_axioms();
     m_arith_auto_config_simplex = p.arith_auto_config_simplex();
+    m_arith_dl_propagate = p.arith_dl_propagate();
+    m_arith_dl_lazy = p.arith_dl_lazy();
 
     arith_rewriter_params ap(_p);
     m_arith_eq2ineq = ap.eq2ineq();
@@ -78,6 +80,8 @@ void theory_arith_params::display(std::ostream & out) const {
     DISPLAY_PARAM(m_arith_propagation_threshold);
     DISPLAY_PARAM(m_arith_pivot_strategy);
     DISPLAY_PARAM(m_arith_add_binary_bounds);
+    DISPLAY_PARAM(m_arith_dl_propagate);
+    DISPLAY_PARAM(m_arith_dl_lazy);
     DISPLAY_PARAM((unsigned)m_arith_propagation_strategy);
     DISPLAY_PARAM(m_arith_eq_bounds);
     DISPLAY_PARAM(m_arith_lazy_adapter);
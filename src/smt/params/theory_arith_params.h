@@ -88,6 +88,8 @@ struct theory_arith_params {
     // used in diff-logic
     bool                    m_arith_add_binary_bounds = false;
     arith_prop_strategy     m_arith_propagation_strategy = arith_prop_strategy::ARITH_PROP_PROPORTIONAL;
+    unsigned                m_arith_dl_propagate = 0;
+    bool                    m_arith_dl_lazy = false;
 
     // used arith_eq_adapter
     bool                    m_arith_eq_bounds = false;
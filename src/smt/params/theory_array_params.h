@@ -39,6 +39,7 @@ struct theory_array_params {
     bool            m_array_always_prop_upward = true;
     bool            m_array_lazy_ieq = false;
     unsigned        m_array_lazy_ieq_delay = 10;
+    bool            m_array_skip_stores = false;
     bool            m_array_fake_support = false;       // fake support for all array operations to pretend they are satisfiable.
 
     theory_array_params() {}
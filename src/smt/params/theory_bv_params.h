@@ -36,6 +36,8 @@ struct theory_bv_params {
     bool         m_bv_enable_int2bv2int = true;
     bool         m_bv_watch_diseq = false;
     bool         m_bv_delay = true;
+    unsigned     m_bv_delay_lemmas = 8;
+    bool         m_bv_preprocess_bounds = false;
     theory_bv_params(params_ref const & p = params_ref()) {
         updt_params(p);
     }
@@ -20,5 +20,6 @@ Revision History:
 void theory_seq_params::updt_params(params_ref const & _p) {
     smt_params_helper p(_p);
     m_split_w_len = p.seq_split_w_len();
+    m_seq_eager_length = p.seq_eager_length();
     m_seq_validate = p.seq_validate();
 }
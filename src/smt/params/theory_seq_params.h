@@ -23,6 +23,11 @@ struct theory_seq_params {
      * Enable splitting guided by length constraints
      */
     bool m_split_w_len = false;
+
+    /*
+     * Propagate len(s) = len(t) when an equation s = t with concatenations is asserted
+     */
+    bool m_seq_eager_length = true;
     bool m_seq_validate = false;
 
     theory_seq_params(params_ref const & p = params_ref()) {
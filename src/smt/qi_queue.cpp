@@ -16,6 +16,7 @@ Author:
 Revision History:
 
 --*/
+#include <cmath>
 #include "util/warning.h"
 #include "util/stats.h"
 #include "ast/ast_pp.h"
@@ -39,7 +40,7 @@ namespace smt {
         m_subst(m),
         m_instances(m) {
         init_parser_vars();
-        m_vals.resize(15, 0.0f);
+        m_vals.resize(16, 0.0f);
     }
 
     qi_queue::~qi_queue() {
@@ -66,6 +67,8 @@ namespace smt {
     }
 
     void qi_queue::init_parser_vars() {
+#define CONFLICTS 15
+        m_parser.add_var("conflicts");
 #define COST 14
         m_parser.add_var("cost");
 #define MIN_TOP_GENERATION 13
@@ -100,6 +103,7 @@ namespace smt {
 
     q::quantifier_stat * qi_queue::set_values(quantifier * q, app * pat, unsigned generation, unsigned min_top_generation, unsigned max_top_generation, float cost) {
         q::quantifier_stat * stat     = m_qm.get_stat(q);
+        m_vals[CONFLICTS]          = static_cast<float>(stat->get_num_conflicts());
         m_vals[COST]               = cost;
         m_vals[MIN_TOP_GENERATION] = static_cast<float>(min_top_generation);
         m_vals[MAX_TOP_GENERATION] = static_cast<float>(max_top_generation);
@@ -122,10 +126,27 @@ namespace smt {
     float qi_queue::get_cost(quantifier * q, app * pat, unsigned generation, unsigned min_top_generation, unsigned max_top_generation) {
         q::quantifier_stat * stat = set_values(q, pat, generation, min_top_generation, max_top_generation, 0);
         float r = m_evaluator(m_cost_function, m_vals.size(), m_vals.data());
+        if (m_params.m_qi_learn)
+            r += get_learned_cost(stat);
         stat->update_max_cost(r);
         return r;
     }
 
+    /**
+       \brief cost based on how often the instances of a quantifier were used in conflicts.
+       It grows with the ratio of instances to conflicts, so quantifiers whose instances
+       do not contribute are delayed, and it is negative for quantifiers whose instances
+       are used more often than they are created.
+       Quantifiers with few instances are not penalized.
+    */
+    float qi_queue::get_learned_cost(q::quantifier_stat * stat) const {
+        unsigned num_instances = stat->get_num_instances();
+        if (num_instances < 16)
+            return 0.0f;
+        double r = log2(1.0 + num_instances) - log2(1.0 + stat->get_num_conflicts());
+        return static_cast<float>(m_params.m_qi_learn_weight * r);
+    }
+
     unsigned qi_queue::get_new_gen(quantifier * q, unsigned generation, float cost) {
         // max_top_generation and min_top_generation are not available for computing inc_gen
         set_values(q, nullptr, generation, 0, 0, cost);
@@ -148,6 +169,7 @@ namespace smt {
     }
 
     void qi_queue::instantiate() {
+        profile::scope _p(m_context.get_profile(), "qi_queue");
         unsigned since_last_check = 0;
         for (entry & curr : m_new_entries) {
             if (m_context.get_cancel_flag()) {
@@ -73,6 +73,7 @@ namespace smt {
         void init_parser_vars();
         q::quantifier_stat * set_values(quantifier * q, app * pat, unsigned generation, unsigned min_top_generation, unsigned max_top_generation, float cost);
         float get_cost(quantifier * q, app * pat, unsigned generation, unsigned min_top_generation, unsigned max_top_generation);
+        float get_learned_cost(q::quantifier_stat * stat) const;
         unsigned get_new_gen(quantifier * q, unsigned generation, float cost);
         void instantiate(entry & ent);
         void get_min_max_costs(float & min, float & max) const;
@@ -1247,6 +1247,237 @@ namespace {
 
         ~theory_aware_branching_queue() override {};
     };
+
+    /**
+       \brief Case split queue based on learning rate branching (LRB).
+
+       The score of a variable is an exponential moving average of its
+       learning rate: the fraction of the conflicts during which the variable
+       was assigned that it participated in. Participation is signaled by the
+       activity bumps of conflict resolution.
+
+       Phases follow the target phase, the assignment of the longest trail
+       since the last restart, or the best phase, the assignment of the longest
+       trail overall. The modes alternate with the cached phase of the context
+       on a geometric schedule of conflicts. Theory-aware branching priorities
+       are added to the scores and their phases take precedence.
+    */
+    class lrb_case_split_queue : public case_split_queue {
+        struct score_lt {
+            svector<double> const & m_scores;
+            theory_var_priority_map const & m_priority;
+            score_lt(svector<double> const & s, theory_var_priority_map const & p):m_scores(s), m_priority(p) {}
+            double score(bool_var v) const {
+                double p = 0.0;
+                m_priority.find(v, p);
+                return m_scores[v] + p;
+            }
+            bool operator()(bool_var v1, bool_var v2) const {
+                return score(v1) > score(v2);
+            }
+        };
+
+        enum phase_mode {
+            PM_TARGET,
+            PM_BEST,
+            PM_CACHE
+        };
+
+        static constexpr double   lrb_alpha_init   = 0.4;
+        static constexpr double   lrb_alpha_min    = 0.06;
+        static constexpr double   lrb_alpha_step   = 1e-6;
+        static constexpr unsigned rephase_base     = 1000;
+
+        context &               m_context;
+        smt_params &            m_params;
+        svector<double>         m_scores;
+        theory_var_priority_map m_theory_var_priority;
+        map<bool_var, lbool, int_hash, default_eq<bool_var> > m_theory_var_phase;
+        heap<score_lt>          m_queue;
+        unsigned_vector         m_assigned_at;    // number of conflicts when the variable was assigned
+        unsigned_vector         m_participated;   // conflicts the variable participated in since it was assigned
+        svector<lbool>          m_target_phase;
+        svector<lbool>          m_best_phase;
+        unsigned                m_target_size { 0 };
+        unsigned                m_best_size { 0 };
+        phase_mode              m_mode { PM_TARGET };
+        unsigned                m_num_rephases { 0 };
+        unsigned                m_next_rephase { rephase_base };
+
+        void update_score(bool_var v, double new_score) {
+            double old_score = m_scores[v];
+            m_scores[v] = new_score;
+            if (!m_queue.contains(v))
+                m_queue.insert(v);
+            else if (new_score > old_score)
+                m_queue.decreased(v);
+            else if (new_score < old_score)
+                m_queue.increased(v);
+        }
+
+        void save_phases(svector<lbool> & phases) {
+            for (literal l : m_context.assigned_literals())
+                phases[l.var()] = l.sign() ? l_false : l_true;
+        }
+
+        void rephase() {
+            ++m_num_rephases;
+            m_next_rephase = m_context.get_num_conflicts() + rephase_base * (m_num_rephases + 1);
+            switch (m_num_rephases % 4) {
+            case 1:  m_mode = PM_BEST; m_best_size = 0; break;
+            case 3:  m_mode = PM_CACHE; break;
+            default: m_mode = PM_TARGET; break;
+            }
+            TRACE("case_split", tout << "rephase " << m_num_rephases << " mode " << m_mode << "\n";);
+        }
+
+        lbool get_phase(bool_var v) const {
+            lbool phase = l_undef;
+            if (m_theory_var_phase.find(v, phase) && phase != l_undef)
+                return phase;
+            switch (m_mode) {
+            case PM_TARGET: return m_target_phase[v];
+            case PM_BEST:   return m_best_phase[v];
+            default:        return l_undef;
+            }
+        }
+
+    public:
+        lrb_case_split_queue(context & ctx, smt_params & p):
+            m_context(ctx),
+            m_params(p),
+            m_queue(1024, score_lt(m_scores, m_theory_var_priority)) {
+        }
+
+        void activity_increased_eh(bool_var v) override {
+            m_participated[v]++;
+        }
+
+        void activity_decreased_eh(bool_var v) override {}
+
+        void mk_var_eh(bool_var v) override {
+            m_scores.reserve(v+1, 0.0);
+            m_assigned_at.reserve(v+1, 0);
+            m_participated.reserve(v+1, 0);
+            m_target_phase.reserve(v+1, l_undef);
+            m_best_phase.reserve(v+1, l_undef);
+            m_scores[v] = 0.0;
+            m_target_phase[v] = l_undef;
+            m_best_phase[v] = l_undef;
+            m_queue.reserve(v+1);
+            SASSERT(!m_queue.contains(v));
+            m_queue.insert(v);
+        }
+
+        void del_var_eh(bool_var v) override {
+            if (m_queue.contains(v))
+                m_queue.erase(v);
+            m_theory_var_priority.erase(v);
+            m_theory_var_phase.erase(v);
+        }
+
+        void assign_lit_eh(literal l) override {
+            m_assigned_at[l.var()] = m_context.get_num_conflicts();
+            m_participated[l.var()] = 0;
+        }
+
+        void unassign_var_eh(bool_var v) override {
+            unsigned conflicts = m_context.get_num_conflicts();
+            unsigned interval  = conflicts > m_assigned_at[v] ? conflicts - m_assigned_at[v] : 0;
+            if (interval > 0) {
+                double alpha = std::max(lrb_alpha_min, lrb_alpha_init - lrb_alpha_step * conflicts);
+                double rate  = static_cast<double>(m_participated[v]) / interval;
+                update_score(v, (1 - alpha) * m_scores[v] + alpha * rate);
+            }
+            else if (!m_queue.contains(v))
+                m_queue.insert(v);
+        }
+
+        void relevant_eh(expr * n) override {}
+
+        void init_search_eh() override {
+            m_assigned_at.fill(0);
+            m_target_size  = 0;
+            m_next_rephase = rephase_base * (m_num_rephases + 1);
+        }
+
+        void end_search_eh() override {}
+
+        void reset() override {
+            m_queue.reset();
+        }
+
+        void push_scope() override {}
+
+        void pop_scope(unsigned num_scopes) override {
+            unsigned sz = m_context.assigned_literals().size();
+            if (sz > m_target_size) {
+                m_target_size = sz;
+                save_phases(m_target_phase);
+            }
+            if (sz > m_best_size) {
+                m_best_size = sz;
+                save_phases(m_best_phase);
+            }
+            // restarts backtrack to the search level
+            if (m_context.get_scope_level() - num_scopes <= m_context.get_search_level())
+                m_target_size = 0;
+            if (m_context.get_num_conflicts() >= m_next_rephase)
+                rephase();
+        }
+
+        void next_case_split(bool_var & next, lbool & phase) override {
+            phase = l_undef;
+            int threshold = static_cast<int>(m_params.m_random_var_freq * random_gen::max_value());
+            if (m_context.get_random_value() < threshold) {
+                next = m_context.get_random_value() % m_context.get_num_b_internalized(); 
+                TRACE("random_split", tout << "next: " << next << " get_assignment(next): " << m_context.get_assignment(next) << "\n";);
+                if (m_context.get_assignment(next) == l_undef) {
+                    phase = get_phase(next);
+                    return;
+                }
+            }
+            
+            while (!m_queue.empty()) {
+                next = m_queue.erase_min();
+                if (m_context.get_assignment(next) == l_undef) {
+                    phase = get_phase(next);
+                    return;
+                }
+            }
+            
+            next = null_bool_var;
+        }
+
+        void add_theory_aware_branching_info(bool_var v, double priority, lbool phase) override {
+            TRACE("theory_aware_branching", tout << "Add theory-aware branching information for l#" << v << ": priority=" << priority << std::endl;);
+            m_theory_var_phase.insert(v, phase);
+            m_theory_var_priority.insert(v, priority);
+            if (m_queue.contains(v)) {
+                if (priority > 0.0) 
+                    m_queue.decreased(v);
+                else 
+                    m_queue.increased(v);
+            }
+        }
+
+        void display(std::ostream & out) override {
+            bool first = true;
+            for (unsigned v : m_queue) {
+                if (m_context.get_assignment(v) == l_undef) {
+                    if (first) {
+                        out << "remaining case-splits:\n";
+                        first = false;
+                    }
+                    out << "#" << m_context.bool_var2expr(v)->get_id() << " ";
+                }
+            }
+            if (!first)
+                out << "\n";            
+        }
+
+        ~lrb_case_split_queue() override {};
+    };
 }
 
 namespace smt {
@@ -1274,6 +1505,8 @@ namespace smt {
             return alloc(rel_goal_case_split_queue, ctx, p);
         case CS_ACTIVITY_THEORY_AWARE_BRANCHING:
             return alloc(theory_aware_branching_queue, ctx, p);
+        case CS_LEARNING_RATE:
+            return alloc(lrb_case_split_queue, ctx, p);
         default:
             return alloc(act_case_split_queue, ctx, p);
         }
@@ -22,6 +22,148 @@ Revision History:
 
 namespace smt {
 
+    cg_root_table::cg_root_table(unsigned num_args, bool comm):
+        m_num_args(num_args),
+        m_comm(comm),
+        m_size(0),
+        m_mask(7) {
+        SASSERT(num_args == 1 || num_args == 2);
+        SASSERT(!comm || num_args == 2);
+        m_hashes.resize(m_mask + 1, 0);
+        m_roots1.resize(m_mask + 1, nullptr);
+        m_roots2.resize(m_mask + 1, nullptr);
+        m_nodes.resize(m_mask + 1, nullptr);
+    }
+
+    unsigned cg_root_table::mk_hash(enode * r1, enode * r2) const {
+        unsigned h;
+        if (m_num_args == 1) 
+            h = r1->hash();
+        else if (!m_comm) 
+            h = combine_hash(r1->hash(), r2->hash());
+        else {
+            unsigned h1 = r1->hash();
+            unsigned h2 = r2->hash();
+            if (h1 > h2)
+                std::swap(h1, h2);
+            h = hash_u((h1 << 16) | (h2 & 0xFFFF));
+        }
+        // 0 marks free slots
+        return h == 0 ? 1 : h;
+    }
+
+    /**
+       \brief return the slot of the entry with roots r1, r2 or the free slot where it should be inserted.
+    */
+    unsigned cg_root_table::find_slot(enode * r1, enode * r2, unsigned h, bool & comm) const {
+        unsigned idx = h & m_mask;
+        while (true) {
+            unsigned h2 = m_hashes[idx];
+            if (h2 == 0 || (h2 == h && matches(idx, r1, r2, comm)))
+                return idx;
+            idx = (idx + 1) & m_mask;
+        }
+    }
+
+    enode * cg_root_table::find(enode * n, bool & comm) const {
+        enode * r1, * r2;
+        get_roots(n, r1, r2);
+        comm = false;
+        return m_nodes[find_slot(r1, r2, mk_hash(r1, r2), comm)];
+    }
+
+    enode * cg_root_table::insert_if_not_there(enode * n, bool & comm) {
+        if (4 * (m_size + 1) > 3 * (m_mask + 1))
+            expand();
+        enode * r1, * r2;
+        get_roots(n, r1, r2);
+        unsigned h = mk_hash(r1, r2);
+        comm = false;
+        unsigned idx = find_slot(r1, r2, h, comm);
+        if (m_hashes[idx] != 0)
+            return m_nodes[idx];
+        m_hashes[idx] = h;
+        m_roots1[idx] = r1;
+        m_roots2[idx] = r2;
+        m_nodes[idx]  = n;
+        m_size++;
+        return n;
+    }
+
+    void cg_root_table::erase(enode * n) {
+        enode * r1, * r2;
+        get_roots(n, r1, r2);
+        bool comm = false;
+        unsigned i = find_slot(r1, r2, mk_hash(r1, r2), comm);
+        if (m_hashes[i] == 0)
+            return;
+        m_size--;
+        // shift back the entries of the probe sequence that follows the free slot.
+        unsigned j = i;
+        while (true) {
+            m_hashes[i] = 0;
+            m_nodes[i]  = nullptr;
+            unsigned home;
+            do {
+                j = (j + 1) & m_mask;
+                if (m_hashes[j] == 0)
+                    return;
+                home = m_hashes[j] & m_mask;
+            }
+            while (i <= j ? (i < home && home <= j) : (i < home || home <= j));
+            m_hashes[i] = m_hashes[j];
+            m_roots1[i] = m_roots1[j];
+            m_roots2[i] = m_roots2[j];
+            m_nodes[i]  = m_nodes[j];
+            i = j;
+        }
+    }
+
+    void cg_root_table::expand() {
+        unsigned_vector   hashes;
+        ptr_vector<enode> roots1, roots2, nodes;
+        m_hashes.swap(hashes);
+        m_roots1.swap(roots1);
+        m_roots2.swap(roots2);
+        m_nodes.swap(nodes);
+        unsigned old_capacity = m_mask + 1;
+        m_mask = 2 * old_capacity - 1;
+        m_hashes.resize(m_mask + 1, 0);
+        m_roots1.resize(m_mask + 1, nullptr);
+        m_roots2.resize(m_mask + 1, nullptr);
+        m_nodes.resize(m_mask + 1, nullptr);
+        for (unsigned i = 0; i < old_capacity; ++i) {
+            unsigned h = hashes[i];
+            if (h == 0)
+                continue;
+            unsigned idx = h & m_mask;
+            while (m_hashes[idx] != 0)
+                idx = (idx + 1) & m_mask;
+            m_hashes[idx] = h;
+            m_roots1[idx] = roots1[i];
+            m_roots2[idx] = roots2[i];
+            m_nodes[idx]  = nodes[i];
+        }
+    }
+
+    bool cg_root_table::check_invariant() const {
+        unsigned sz = 0;
+        for (unsigned i = 0; i <= m_mask; ++i) {
+            if (m_hashes[i] == 0) {
+                SASSERT(!m_nodes[i]);
+                continue;
+            }
+            ++sz;
+            enode * r1, * r2;
+            get_roots(m_nodes[i], r1, r2);
+            SASSERT(r1 == m_roots1[i] && r2 == m_roots2[i]);
+            SASSERT(m_hashes[i] == mk_hash(r1, r2));
+            DEBUG_CODE(bool comm = false; SASSERT(find_slot(r1, r2, m_hashes[i], comm) == i););
+        }
+        SASSERT(sz == m_size);
+        return true;
+    }
+
     // one table per func_decl implementation
     unsigned cg_table::cg_hash::operator()(enode * n) const {
         SASSERT(n->get_decl()->is_flat_associative() || n->get_num_args() >= 3);
@@ -76,7 +218,7 @@ namespace smt {
         SASSERT(d->get_arity() >= 1);
         switch (d->get_arity()) {
         case 1:
-            r = TAG(void*, alloc(unary_table), UNARY);
+            r = TAG(void*, alloc(cg_root_table, 1, false), UNARY);
             SASSERT(GET_TAG(r) == UNARY);
             return r;
         case 2:
@@ -87,12 +229,12 @@ namespace smt {
                 return r;
             }
             else if (d->is_commutative()) {
-                r = TAG(void*, alloc(comm_table, cg_comm_hash(), cg_comm_eq(m_commutativity)), BINARY_COMM);
+                r = TAG(void*, alloc(cg_root_table, 2, true), BINARY_COMM);
                 SASSERT(GET_TAG(r) == BINARY_COMM);
                 return r;
             }
             else {
-                r = TAG(void*, alloc(binary_table), BINARY);
+                r = TAG(void*, alloc(cg_root_table, 2, false), BINARY);
                 SASSERT(GET_TAG(r) == BINARY);
                 return r;
             }
@@ -126,13 +268,9 @@ namespace smt {
         for (void* t : m_tables) {
             switch (GET_TAG(t)) {
             case UNARY:
-                dealloc(UNTAG(unary_table*, t));
-                break;
             case BINARY:
-                dealloc(UNTAG(binary_table*, t));
-                break;
             case BINARY_COMM:
-                dealloc(UNTAG(comm_table*, t));
+                dealloc(UNTAG(cg_root_table*, t));
                 break;
             case NARY:
                 dealloc(UNTAG(table*, t));
@@ -168,28 +306,31 @@ namespace smt {
     }
 
     void cg_table::display_binary(std::ostream& out, void* t) const {
-        binary_table* tb = UNTAG(binary_table*, t);
+        cg_root_table* tb = UNTAG(cg_root_table*, t);
         out << "b ";
-        for (enode* n : *tb) {
-            out << n->get_owner_id() << " " << cg_binary_hash()(n) << " ";
+        for (enode* n : tb->slots()) {
+            if (n) 
+                out << n->get_owner_id() << " " << cg_binary_hash(n) << " ";
         }
         out << "\n";
     }
     
     void cg_table::display_binary_comm(std::ostream& out, void* t) const {
-        comm_table* tb = UNTAG(comm_table*, t);
+        cg_root_table* tb = UNTAG(cg_root_table*, t);
         out << "bc ";
-        for (enode* n : *tb) {
-            out << n->get_owner_id() << " ";
+        for (enode* n : tb->slots()) {
+            if (n) 
+                out << n->get_owner_id() << " ";
         }
         out << "\n";
     }
     
     void cg_table::display_unary(std::ostream& out, void* t) const {
-        unary_table* tb = UNTAG(unary_table*, t);
+        cg_root_table* tb = UNTAG(cg_root_table*, t);
         out << "un ";
-        for (enode* n : *tb) {
-            out << n->get_owner_id() << " ";
+        for (enode* n : tb->slots()) {
+            if (n) 
+                out << n->get_owner_id() << " ";
         }
         out << "\n";
     }
@@ -210,20 +351,20 @@ namespace smt {
         SASSERT(!m_manager.is_and(n->get_expr()));
         SASSERT(!m_manager.is_or(n->get_expr()));
         enode * n_prime;
+        bool comm = false;
         void * t = get_table(n); 
         switch (static_cast<table_kind>(GET_TAG(t))) {
         case UNARY:
-            n_prime = UNTAG(unary_table*, t)->insert_if_not_there(n);
+            n_prime = UNTAG(cg_root_table*, t)->insert_if_not_there(n, comm);
             return enode_bool_pair(n_prime, false);
         case BINARY:
-            n_prime = UNTAG(binary_table*, t)->insert_if_not_there(n);
-            TRACE("cg_table", tout << "insert: " << n->get_owner_id() << " " << cg_binary_hash()(n) << " inserted: " << (n == n_prime) << " " << n_prime->get_owner_id() << "\n";
+            n_prime = UNTAG(cg_root_table*, t)->insert_if_not_there(n, comm);
+            TRACE("cg_table", tout << "insert: " << n->get_owner_id() << " " << cg_binary_hash(n) << " inserted: " << (n == n_prime) << " " << n_prime->get_owner_id() << "\n";
                   display_binary(tout, t); tout << "contains_ptr: " << contains_ptr(n) << "\n";); 
             return enode_bool_pair(n_prime, false);
         case BINARY_COMM:
-            m_commutativity = false;
-            n_prime = UNTAG(comm_table*, t)->insert_if_not_there(n);
-            return enode_bool_pair(n_prime, m_commutativity);
+            n_prime = UNTAG(cg_root_table*, t)->insert_if_not_there(n, comm);
+            return enode_bool_pair(n_prime, comm);
         default:
             n_prime = UNTAG(table*, t)->insert_if_not_there(n);
             return enode_bool_pair(n_prime, false);
@@ -235,14 +376,12 @@ namespace smt {
         void * t = get_table(n); 
         switch (static_cast<table_kind>(GET_TAG(t))) {
         case UNARY:
-            UNTAG(unary_table*, t)->erase(n);
+        case BINARY_COMM:
+            UNTAG(cg_root_table*, t)->erase(n);
             break;
         case BINARY:
-            TRACE("cg_table", tout << "erase: " << n->get_owner_id() << " " << cg_binary_hash()(n) << " contains: " << contains_ptr(n) << "\n";);
-            UNTAG(binary_table*, t)->erase(n);
-            break;
-        case BINARY_COMM:
-            UNTAG(comm_table*, t)->erase(n);
+            TRACE("cg_table", tout << "erase: " << n->get_owner_id() << " " << cg_binary_hash(n) << " contains: " << contains_ptr(n) << "\n";);
+            UNTAG(cg_root_table*, t)->erase(n);
             break;
         default:
             UNTAG(table*, t)->erase(n);
@@ -255,6 +394,9 @@ namespace smt {
     }
 
     bool cg_table::check_invariant() const {
+        for (void * t : m_tables) 
+            if (GET_TAG(t) != NARY)
+                SASSERT(UNTAG(cg_root_table*, t)->check_invariant());
         return true;
     }
 
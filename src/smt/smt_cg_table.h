@@ -26,84 +26,85 @@ namespace smt {
 
     typedef std::pair<enode *, bool> enode_bool_pair;
     
-    // one table per function symbol
-
     /**
-       \brief Congruence table.
+       \brief Congruence table for applications of a function symbol
+       with one or two arguments.
+
+       Open addressing with linear probing. The hash and the roots of
+       the arguments of every entry are kept inline in separate arrays,
+       so a probe scans the hash array and compares roots without
+       dereferencing the enodes stored in the table.
+       The roots of the arguments of an entry do not change while the
+       entry is in the table: the context removes the parents of a class
+       before merging it and reinserts them afterwards.
     */
-    class cg_table {
-        struct cg_unary_hash {
-            unsigned operator()(enode * n) const {
-                SASSERT(n->get_num_args() == 1);
-                return n->get_arg(0)->get_root()->hash();
-            }
-        };
+    class cg_root_table {
+        unsigned          m_num_args;
+        bool              m_comm;
+        unsigned          m_size;
+        unsigned          m_mask;
+        unsigned_vector   m_hashes;  // 0 for free slots
+        ptr_vector<enode> m_roots1;
+        ptr_vector<enode> m_roots2;
+        ptr_vector<enode> m_nodes;
+
+        void get_roots(enode * n, enode * & r1, enode * & r2) const {
+            SASSERT(n->get_num_args() == m_num_args);
+            r1 = n->get_arg(0)->get_root();
+            r2 = m_num_args == 1 ? nullptr : n->get_arg(1)->get_root();
+        }
 
-        struct cg_unary_eq {
-            bool operator()(enode * n1, enode * n2) const {
-                SASSERT(n1->get_num_args() == 1);
-                SASSERT(n2->get_num_args() == 1);
-                SASSERT(n1->get_decl() == n2->get_decl());
-                return n1->get_arg(0)->get_root() == n2->get_arg(0)->get_root();
-            }
-        };
+        unsigned mk_hash(enode * r1, enode * r2) const;
 
-        typedef chashtable<enode *, cg_unary_hash, cg_unary_eq> unary_table;
-        
-        struct cg_binary_hash {
-            unsigned operator()(enode * n) const {
-                SASSERT(n->get_num_args() == 2);
-                return combine_hash(n->get_arg(0)->get_root()->hash(), n->get_arg(1)->get_root()->hash());
+        bool matches(unsigned idx, enode * r1, enode * r2, bool & comm) const {
+            if (m_roots1[idx] == r1 && m_roots2[idx] == r2) 
+                return true;
+            if (m_comm && m_roots1[idx] == r2 && m_roots2[idx] == r1) {
+                comm = true;
+                return true;
             }
-        };
+            return false;
+        }
 
-        struct cg_binary_eq {
-            bool operator()(enode * n1, enode * n2) const {
-                SASSERT(n1->get_num_args() == 2);
-                SASSERT(n2->get_num_args() == 2);
-                SASSERT(n1->get_decl() == n2->get_decl());
-                return 
-                    n1->get_arg(0)->get_root() == n2->get_arg(0)->get_root() &&
-                    n1->get_arg(1)->get_root() == n2->get_arg(1)->get_root();
-            }
-        };
+        unsigned find_slot(enode * r1, enode * r2, unsigned h, bool & comm) const;
 
-        typedef chashtable<enode*, cg_binary_hash, cg_binary_eq> binary_table;
-        
-        struct cg_comm_hash {
-            unsigned operator()(enode * n) const {
-                SASSERT(n->get_num_args() == 2);
-                unsigned h1 = n->get_arg(0)->get_root()->hash();
-                unsigned h2 = n->get_arg(1)->get_root()->hash();
-                if (h1 > h2)
-                    std::swap(h1, h2);
-                return hash_u((h1 << 16) | (h2 & 0xFFFF));
-            }
-        };
-        
-        struct cg_comm_eq {
-            bool & m_commutativity;
-            cg_comm_eq(bool & c):m_commutativity(c) {}
-            bool operator()(enode * n1, enode * n2) const {
-                SASSERT(n1->get_num_args() == 2);
-                SASSERT(n2->get_num_args() == 2);
-                SASSERT(n1->get_decl() == n2->get_decl());
-                enode * c1_1 = n1->get_arg(0)->get_root();
-                enode * c1_2 = n1->get_arg(1)->get_root();
-                enode * c2_1 = n2->get_arg(0)->get_root();
-                enode * c2_2 = n2->get_arg(1)->get_root();
-                if (c1_1 == c2_1 && c1_2 == c2_2) {
-                    return true;
-                }
-                if (c1_1 == c2_2 && c1_2 == c2_1) {
-                    m_commutativity = true;
-                    return true;
-                }
-                return false;
-            }
-        };
+        void expand();
+
+    public:
+        cg_root_table(unsigned num_args, bool comm);
 
-        typedef chashtable<enode*, cg_comm_hash, cg_comm_eq> comm_table;
+        unsigned size() const { return m_size; }
+
+        /**
+           \brief return the entry congruent to n or nullptr.
+           comm is set to true if the congruence uses commutativity.
+        */
+        enode * find(enode * n, bool & comm) const;
+
+        bool contains(enode * n) const { bool comm; return find(n, comm) != nullptr; }
+
+        enode * insert_if_not_there(enode * n, bool & comm);
+
+        void erase(enode * n);
+
+        /**
+           \brief the entries of the table, nullptr for free slots.
+        */
+        ptr_vector<enode> const & slots() const { return m_nodes; }
+
+        bool check_invariant() const;
+    };
+
+    // one table per function symbol
+
+    /**
+       \brief Congruence table.
+    */
+    class cg_table {
+        static unsigned cg_binary_hash(enode * n) {
+            SASSERT(n->get_num_args() == 2);
+            return combine_hash(n->get_arg(0)->get_root()->hash(), n->get_arg(1)->get_root()->hash());
+        }
 
         struct cg_hash {
             unsigned operator()(enode * n) const;
@@ -116,7 +117,6 @@ namespace smt {
         typedef chashtable<enode*, cg_hash, cg_eq> table;
 
         ast_manager &                 m_manager;
-        bool                          m_commutativity; //!< true if the last found congruence used commutativity
         ptr_vector<void>              m_tables;
         obj_map<func_decl, unsigned>  m_func_decl2id;
 
@@ -155,48 +155,24 @@ namespace smt {
         bool contains(enode * n) const {
             SASSERT(n->get_num_args() > 0);
             void * t = const_cast<cg_table*>(this)->get_table(n); 
-            switch (static_cast<table_kind>(GET_TAG(t))) {
-            case UNARY:
-                return UNTAG(unary_table*, t)->contains(n);
-            case BINARY:
-                return UNTAG(binary_table*, t)->contains(n);
-            case BINARY_COMM:
-                return UNTAG(comm_table*, t)->contains(n);
-            default:
+            if (GET_TAG(t) == NARY)
                 return UNTAG(table*, t)->contains(n);
-            }
+            return UNTAG(cg_root_table*, t)->contains(n);
         }
 
         enode * find(enode * n) const {
             SASSERT(n->get_num_args() > 0);
-            enode * r = nullptr;
             void * t = const_cast<cg_table*>(this)->get_table(n); 
-            switch (static_cast<table_kind>(GET_TAG(t))) {
-            case UNARY:
-                return UNTAG(unary_table*, t)->find(n, r) ? r : nullptr;
-            case BINARY:
-                return UNTAG(binary_table*, t)->find(n, r) ? r : nullptr;
-            case BINARY_COMM:
-                return UNTAG(comm_table*, t)->find(n, r) ? r : nullptr;
-            default:
+            if (GET_TAG(t) == NARY) {
+                enode * r = nullptr;
                 return UNTAG(table*, t)->find(n, r) ? r : nullptr;
             }
+            bool comm = false;
+            return UNTAG(cg_root_table*, t)->find(n, comm);
         }
 
         bool contains_ptr(enode * n) const {
-            enode * r;
-            SASSERT(n->get_num_args() > 0);
-            void * t = const_cast<cg_table*>(this)->get_table(n); 
-            switch (static_cast<table_kind>(GET_TAG(t))) {
-            case UNARY:
-                return UNTAG(unary_table*, t)->find(n, r) && n == r;
-            case BINARY:
-                return UNTAG(binary_table*, t)->find(n, r) && n == r;
-            case BINARY_COMM:
-                return UNTAG(comm_table*, t)->find(n, r) && n == r;
-            default:
-                return UNTAG(table*, t)->find(n, r) && n == r;
-            }
+            return find(n) == n;
         }
 
         void reset();
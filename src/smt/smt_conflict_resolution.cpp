@@ -344,6 +344,13 @@ namespace smt {
                 m_lemma_atoms.push_back(m_ctx.bool_var2expr(var));
             }
         }
+        else if (m_params.m_qi_learn && lvl <= m_ctx.get_base_level()) {
+            // instances are clauses containing the negated quantifier,
+            // and the quantifier is assigned at the base level.
+            expr * n = m_ctx.bool_var2expr(var);
+            if (n && is_quantifier(n))
+                m_ctx.quantifier_conflict_eh(to_quantifier(n));
+        }
     }
 
     void conflict_resolution::process_justification(literal consequent, justification * js, unsigned & num_marks) {
@@ -522,6 +529,8 @@ namespace smt {
                 TRACE("conflict_smt2", m_ctx.display_clause_smt2(tout, *cls););
                 if (cls->is_lemma())
                     cls->inc_clause_activity();
+                if (cls->get_kind() == CLS_TH_LEMMA && cls->get_del_eh())
+                    m_dyn_ack_manager.used_lemma_eh(cls);
                 unsigned num_lits = cls->get_num_literals();
                 unsigned i        = 0;
                 if (consequent != false_literal) {
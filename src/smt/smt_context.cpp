@@ -62,6 +62,7 @@ namespace smt {
         m_progress_callback(nullptr),
         m_next_progress_sample(0),
         m_clause_proof(*this),
+        m_region(static_cast<size_t>(p.m_region_page_size) * 1024),
         m_fingerprints(m, m_region),
         m_b_internalized_stack(m),
         m_e_internalized_stack(m),
@@ -93,6 +94,7 @@ namespace smt {
             m_fparams.m_relevancy_lemma = false;
 
         m_model_generator->set_context(this);
+        m_profile.set_enabled(m_fparams.m_profile);
     }
 
 
@@ -110,6 +112,7 @@ namespace smt {
         if (!m_setup.already_configured()) {
             m_fparams.updt_params(p);
         }
+        m_profile.set_enabled(m_fparams.m_profile);
     }
 
     unsigned context::relevancy_lvl() const {
@@ -1621,6 +1624,7 @@ namespace smt {
 
     bool context::propagate_theories() {
         for (theory * t : m_theory_set) {
+            profile::scope _p(m_profile, t->get_name());
             t->propagate();
             if (inconsistent())
                 return false;
@@ -1687,6 +1691,7 @@ namespace smt {
      */
     bool context::propagate() {
         TRACE("propagate", tout << "propagating... " << m_qhead << ":" << m_assigned_literals.size() << "\n";);
+        profile::scope _p(m_profile, "propagate");
         while (true) {
             if (inconsistent())
                 return false;
@@ -3652,6 +3657,7 @@ namespace smt {
 
 
     lbool context::search() {
+        scoped_rlimit_account _account(m.limit(), "smt", m_fparams.m_budget);
         if (m_asserted_formulas.inconsistent()) {
             asserted_inconsistent();
             return l_false;
@@ -3912,7 +3918,12 @@ namespace smt {
         m_stats.m_num_final_checks++;
         TRACE("final_check_stats", tout << "m_stats.m_num_final_checks = " << m_stats.m_num_final_checks << "\n";);
 
-        final_check_status ok = m_qmanager->final_check_eh(false);
+        profile::scope _p(m_profile, "final_check");
+        final_check_status ok;
+        {
+            profile::scope _q(m_profile, "quantifiers");
+            ok = m_qmanager->final_check_eh(false);
+        }
         if (ok != FC_DONE)
             return ok;
 
@@ -3930,6 +3941,7 @@ namespace smt {
             if (m_final_check_idx < num_th) {
                 theory * th = m_theory_set[m_final_check_idx];
                 IF_VERBOSE(100, verbose_stream() << "(smt.final-check \"" << th->get_name() << "\")\n";);
+                profile::scope _t(m_profile, th->get_name());
                 ok = th->final_check_eh();
                 TRACE("final_check_step", tout << "final check '" << th->get_name() << " ok: " << ok << " inconsistent " << inconsistent() << "\n";);
                 if (ok == FC_GIVEUP) {
@@ -3938,6 +3950,7 @@ namespace smt {
                 }
             }
             else {
+                profile::scope _q(m_profile, "quantifiers");
                 ok = m_qmanager->final_check_eh(true);
                 TRACE("final_check_step", tout << "quantifier  ok: " << ok << " " << "inconsistent " << inconsistent() << "\n";);
             }
@@ -3993,6 +4006,7 @@ namespace smt {
 
 
     bool context::resolve_conflict() {
+        profile::scope _p(m_profile, "resolve_conflict");
         m_stats.m_num_conflicts++;
         m_num_conflicts ++;
         m_num_conflicts_since_restart ++;
@@ -31,6 +31,7 @@ Revision History:
 #include "smt/smt_theory.h"
 #include "smt/smt_quantifier.h"
 #include "smt/smt_statistics.h"
+#include "smt/smt_profile.h"
 #include "smt/smt_conflict_resolution.h"
 #include "smt/smt_relevancy.h"
 #include "smt/smt_case_split_queue.h"
@@ -83,6 +84,7 @@ namespace smt {
         setup                       m_setup;
         unsigned                    m_relevancy_lvl;
         timer                       m_timer;
+        profile                     m_profile;
         asserted_formulas           m_asserted_formulas;
         th_rewriter                 m_rewriter;
         scoped_ptr<quantifier_manager>   m_qmanager;
@@ -260,6 +262,10 @@ namespace smt {
             return m_params;
         }
 
+        profile & get_profile() {
+            return m_profile;
+        }
+
         void updt_params(params_ref const& p);
 
         bool get_cancel_flag();
@@ -564,6 +570,13 @@ namespace smt {
             return m_qmanager->get_generation(q);
         }
 
+        /**
+           \brief Record that an instance of q was used to resolve a conflict.
+        */
+        void quantifier_conflict_eh(quantifier * q) {
+            m_qmanager->conflict_eh(q);
+        }
+
         /**
            \brief Return true if the logical context internalized universal quantifiers.
         */
@@ -1723,6 +1736,12 @@ namespace smt {
             m_user_propagator->register_diseq(diseq_eh);
         }
 
+        void user_propagate_register_batch(solver::batch_eh_t& batch_eh) {
+            if (!m_user_propagator) 
+                throw default_exception("user propagator must be initialized");
+            m_user_propagator->register_batch(batch_eh);
+        }
+
         unsigned user_propagate_register(expr* e) {
             if (!m_user_propagator) 
                 throw default_exception("user propagator must be initialized");
@@ -414,16 +414,22 @@ namespace smt {
         st.update("mk clause", m_stats.m_num_mk_clause);
         st.update("del clause", m_stats.m_num_del_clause);
         st.update("dyn ack", m_stats.m_num_dyn_ack);
+        st.update("dyn ack used", m_stats.m_num_dyn_ack_used);
+        st.update("dyn ack useful", m_stats.m_num_dyn_ack_useful);
+        st.update("dyn ack evicted", m_stats.m_num_dyn_ack_evicted);
         st.update("interface eqs", m_stats.m_num_interface_eqs);
         st.update("max generation", m_stats.m_max_generation);
         st.update("minimized lits", m_stats.m_num_minimized_lits);
         st.update("num checks", m_stats.m_num_checks);
         st.update("mk bool var", m_stats.m_num_mk_bool_var ? m_stats.m_num_mk_bool_var - 1 : 0);
+        m_region.collect_statistics(st);
         m_qmanager->collect_statistics(st);
         m_asserted_formulas.collect_statistics(st);
         for (theory* th : m_theory_set) {
             th->collect_statistics(st);
         }
+        if (m_profile.enabled())
+            m_profile.collect_statistics(st);
     }
 
     void context::display_statistics(std::ostream & out) const {
@@ -18,6 +18,7 @@ Revision History:
 --*/
 #include "smt/smt_context.h"
 #include "ast/ast_pp.h"
+#include <fstream>
 
 namespace smt {
 
@@ -144,5 +145,12 @@ namespace smt {
     void context::display_profile(std::ostream & out) const {
         if (m_fparams.m_profile_res_sub)
             display_profile_res_sub(out);
+        if (m_profile.enabled() && m_fparams.m_profile_file.is_non_empty_string()) {
+            std::ofstream fout(m_fparams.m_profile_file.str());
+            if (!fout)
+                warning_msg("could not open %s for writing the profile", m_fparams.m_profile_file.str().c_str());
+            else
+                m_profile.display_folded(fout);
+        }
     }
 };
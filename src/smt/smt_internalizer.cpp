@@ -332,6 +332,7 @@ namespace smt {
     }
 
     void context::internalize(expr * n, bool gate_ctx, unsigned generation) {
+        profile::scope _p(m_profile, "internalize");
         flet<unsigned> l(m_generation, generation);
         m_stats.m_max_generation = std::max(m_generation, m_stats.m_max_generation);
         internalize_rec(n, gate_ctx);
@@ -350,11 +351,13 @@ namespace smt {
        - gate_ctx is true if the expression is in the context of a logical gate.
     */
     void context::internalize(expr * n, bool gate_ctx) {
+        profile::scope _p(m_profile, "internalize");
         internalize_deep(n);
         internalize_rec(n, gate_ctx);
     }
 
     void context::internalize(expr* const* exprs, unsigned num_exprs, bool gate_ctx) {
+        profile::scope _p(m_profile, "internalize");
         internalize_deep(exprs, num_exprs);
         for (unsigned i = 0; i < num_exprs; ++i) 
             internalize_rec(exprs[i], gate_ctx);
@@ -245,6 +245,10 @@ namespace smt {
             m_kernel.user_propagate_register_diseq(diseq_eh);
         }
 
+        void user_propagate_register_batch(solver::batch_eh_t& batch_eh) {
+            m_kernel.user_propagate_register_batch(batch_eh);
+        }
+
         unsigned user_propagate_register(expr* e) {
             return m_kernel.user_propagate_register(e);
         }
@@ -473,6 +477,10 @@ namespace smt {
         m_imp->user_propagate_register_diseq(diseq_eh);
     }
 
+    void kernel::user_propagate_register_batch(solver::batch_eh_t& batch_eh) {
+        m_imp->user_propagate_register_batch(batch_eh);
+    }
+
     unsigned kernel::user_propagate_register(expr* e) {
         return m_imp->user_propagate_register(e);
     }        
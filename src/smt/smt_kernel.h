@@ -301,6 +301,8 @@ namespace smt {
         
         void user_propagate_register_diseq(solver::eq_eh_t& diseq_eh);
 
+        void user_propagate_register_batch(solver::batch_eh_t& batch_eh);
+
 
         /**
            \brief register an expression to be tracked fro user propagation.
@@ -29,11 +29,15 @@ Revision History:
 #include "ast/ast_pp.h"
 #include "ast/array_decl_plugin.h"
 #include "ast/ast_smt2_pp.h"
+#include "ast/ast_translation.h"
 #include "smt/smt_model_checker.h"
 #include "smt/smt_context.h"
 #include "smt/smt_model_finder.h"
 #include "model/model_pp.h"
 #include <tuple>
+#ifndef SINGLE_THREAD
+#include <thread>
+#endif
 
 namespace smt {
 
@@ -53,6 +57,7 @@ namespace smt {
     }
 
     model_checker::~model_checker() {
+        m_worker_contexts.reset(); // delete worker contexts before their managers and params
         m_aux_context = nullptr; // delete aux context before fparams
         m_fparams = nullptr;
     }
@@ -140,29 +145,28 @@ namespace smt {
     }
 
     /**
-       \brief Assert in m_aux_context, the constraint
+       \brief Add to fmls the constraint
 
          sk = e_1 OR ... OR sk = e_n
 
          where {e_1, ..., e_n} is the universe.
      */
-    void model_checker::restrict_to_universe(expr * sk, obj_hashtable<expr> const & universe) {
+    void model_checker::restrict_to_universe(expr * sk, obj_hashtable<expr> const & universe, expr_ref_vector & fmls) {
         SASSERT(!universe.empty());
         ptr_buffer<expr> eqs;
         for (expr * e : universe) {
             eqs.push_back(m.mk_eq(sk, e));
         }
-        expr_ref fml(m.mk_or(eqs.size(), eqs.data()), m);
-        m_aux_context->assert_expr(fml);
+        fmls.push_back(m.mk_or(eqs.size(), eqs.data()));
     }
 
     /**
-       \brief Assert the negation of q after applying the interpretation in m_curr_model to the uninterpreted symbols in q.
+       \brief Add to fmls the negation of q after applying the interpretation in m_curr_model to the uninterpreted symbols in q.
 
        The variables are replaced by skolem constants. These constants are stored in sks.
     */
 
-    bool model_checker::assert_neg_q_m(quantifier * q, expr_ref_vector & sks) {
+    bool model_checker::mk_neg_q_m(quantifier * q, expr_ref_vector & sks, expr_ref_vector & fmls) {
         expr_ref tmp(m);
         
         TRACE("model_checker", tout << "curr_model:\n"; model_pp(tout, *m_curr_model););
@@ -181,7 +185,7 @@ namespace smt {
             sks[num_decls - i - 1]        = sk;
             subst_args[num_decls - i - 1] = sk;
             if (m_curr_model->is_finite(s)) {
-                restrict_to_universe(sk, m_curr_model->get_known_universe(s));
+                restrict_to_universe(sk, m_curr_model->get_known_universe(s), fmls);
             }
         }
 
@@ -190,7 +194,19 @@ namespace smt {
         expr_ref r(m);
         r = m.mk_not(sk_body);
         TRACE("model_checker", tout << "mk_neg_q_m:\n" << mk_ismt2_pp(r, m) << "\n";);
-        m_aux_context->assert_expr(r);
+        fmls.push_back(r);
+        return true;
+    }
+
+    /**
+       \brief Assert in m_aux_context the negation of q in m_curr_model.
+    */
+    bool model_checker::assert_neg_q_m(quantifier * q, expr_ref_vector & sks) {
+        expr_ref_vector fmls(m);
+        if (!mk_neg_q_m(q, sks, fmls))
+            return false;
+        for (expr * f : fmls)
+            m_aux_context->assert_expr(f);
         return true;
     }
 
@@ -405,6 +421,91 @@ namespace smt {
         }
     }
 
+#ifndef SINGLE_THREAD
+    /**
+       \brief Create n worker contexts, each one with its own manager, for checking quantifiers in parallel.
+       The workers are copies of m_aux_context and are kept between calls to the model checker.
+    */
+    void model_checker::init_workers(unsigned n) {
+        while (m_worker_contexts.size() < n) {
+            ast_manager * wm = alloc(ast_manager, m, true);
+            m_worker_managers.push_back(wm);
+            smt_params * wp = alloc(smt_params, *m_fparams);
+            wp->m_array_fake_support = true;
+            m_worker_params.push_back(wp);
+            params_ref p;
+            p.set_bool("arith.dump_lemmas", false);
+            context * wctx = alloc(context, *wm, *wp, p);
+            context::copy(*m_aux_context, *wctx, true);
+            m_worker_contexts.push_back(wctx);
+        }
+    }
+
+    /**
+       \brief Check the negations of the quantifiers qs against m_curr_model in parallel.
+       The result for qs[i] is stored in results[i]; l_false means that qs[i] is satisfied by the model.
+
+       The negated formulas are created and translated to the worker managers by the
+       calling thread, because translation updates reference counts in m.
+       Counter-examples and instances are not produced here.
+    */
+    void model_checker::screen_quantifiers(ptr_vector<quantifier> const & qs, svector<lbool> & results) {
+        results.reset();
+        results.resize(qs.size(), l_undef);
+        unsigned num_threads = std::min(m_params.m_mbqi_threads, qs.size());
+        if (num_threads <= 1)
+            return;
+        init_workers(num_threads);
+
+        vector<expr_ref_vector> fmls;
+        bool_vector valid;
+        for (unsigned i = 0; i < qs.size(); ++i) {
+            ast_manager & wm = *m_worker_managers[i % num_threads];
+            fmls.push_back(expr_ref_vector(wm));
+            expr_ref_vector sks(m), fs(m);
+            valid.push_back(mk_neg_q_m(get_flat_quantifier(qs[i]), sks, fs));
+            ast_translation tr(m, wm);
+            for (expr * f : fs)
+                fmls.back().push_back(tr(f));
+        }
+
+        scoped_limits sl(m.limit());
+        for (unsigned w = 0; w < num_threads; ++w)
+            sl.push_child(&(m_worker_managers[w]->limit()));
+
+        auto worker_thread = [&](unsigned w) {
+            context & ctx = *m_worker_contexts[w];
+            for (unsigned i = w; i < qs.size(); i += num_threads) {
+                if (!valid[i] || !ctx.get_manager().inc())
+                    continue;
+                try {
+                    scoped_ctx_push _push(&ctx);
+                    for (expr * f : fmls[i])
+                        ctx.assert_expr(f);
+                    results[i] = ctx.check();
+                }
+                catch (z3_exception &) {
+                    results[i] = l_undef;
+                }
+            }
+        };
+
+        vector<std::thread> threads;
+        for (unsigned w = 0; w < num_threads; ++w)
+            threads.push_back(std::thread([&, w]() { worker_thread(w); }));
+        for (auto & th : threads)
+            th.join();
+        TRACE("model_checker", for (unsigned i = 0; i < qs.size(); ++i) tout << "screened " << qs[i]->get_qid() << " " << results[i] << "\n";);
+    }
+#else
+    void model_checker::init_workers(unsigned n) {}
+
+    void model_checker::screen_quantifiers(ptr_vector<quantifier> const & qs, svector<lbool> & results) {
+        results.reset();
+        results.resize(qs.size(), l_undef);
+    }
+#endif
+
     bool model_checker::check(proto_model * md, obj_map<enode, app *> const & root2value) {
         SASSERT(md != nullptr);
 
@@ -482,14 +583,22 @@ namespace smt {
     //
 
     void model_checker::check_quantifiers(bool& found_relevant, unsigned& num_failures) {
+        ptr_vector<quantifier> qs;
         for (quantifier * q : *m_qm) {
-            if (!(m_qm->mbqi_enabled(q) &&
-                  m_context->is_relevant(q) &&
-                  m_context->get_assignment(q) == l_true &&
-                  (!m_context->get_fparams().m_ematching || !m.is_lambda_def(q)))) {
-                continue;
+            if (m_qm->mbqi_enabled(q) &&
+                m_context->is_relevant(q) &&
+                m_context->get_assignment(q) == l_true &&
+                (!m_context->get_fparams().m_ematching || !m.is_lambda_def(q))) {
+                qs.push_back(q);
             }
+        }
 
+        // quantifiers that the workers show to be satisfied are not checked again.
+        svector<lbool> screened;
+        screen_quantifiers(qs, screened);
+
+        for (unsigned i = 0; i < qs.size(); ++i) {
+            quantifier * q = qs[i];
             TRACE("model_checker",
                   tout << "Check: " << mk_pp(q, m) << "\n";
                   tout << m_context->get_assignment(q) << "\n";);
@@ -498,6 +607,8 @@ namespace smt {
                 verbose_stream() << "(smt.mbqi :checking " << q->get_qid() << ")\n";
             }
             found_relevant = true;
+            if (screened[i] == l_false)
+                continue;
             if (!check(q)) {
                 if (m_params.m_mbqi_trace || get_verbosity_level() >= 5) {
                     IF_VERBOSE(0, verbose_stream() << "(smt.mbqi :failed " << q->get_qid() << ")\n");
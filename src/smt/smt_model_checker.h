@@ -21,6 +21,7 @@ Revision History:
 #pragma once
 
 #include "util/obj_hashtable.h"
+#include "util/scoped_ptr_vector.h"
 #include "ast/ast.h"
 #include "ast/array_decl_plugin.h"
 #include "ast/normal_forms/defined_names.h"
@@ -53,6 +54,11 @@ namespace smt {
         proto_model *                               m_curr_model;
         obj_map<expr, expr *>                       m_value2expr;
         expr_ref_vector                             m_fresh_exprs;
+        // workers for checking quantifiers in parallel (mbqi.threads).
+        // managers are declared first so they are deleted after the contexts that use them.
+        scoped_ptr_vector<ast_manager>              m_worker_managers;
+        scoped_ptr_vector<smt_params>               m_worker_params;
+        scoped_ptr_vector<context>                  m_worker_contexts;
 
         friend class model_instantiation_set;
 
@@ -61,8 +67,11 @@ namespace smt {
         expr * get_term_from_ctx(expr * val);
         expr * get_type_compatible_term(expr * val);
         expr_ref replace_value_from_ctx(expr * e);
-        void restrict_to_universe(expr * sk, obj_hashtable<expr> const & universe);
+        void restrict_to_universe(expr * sk, obj_hashtable<expr> const & universe, expr_ref_vector & fmls);
+        bool mk_neg_q_m(quantifier * q, expr_ref_vector & sks, expr_ref_vector & fmls);
         bool assert_neg_q_m(quantifier * q, expr_ref_vector & sks);
+        void init_workers(unsigned n);
+        void screen_quantifiers(ptr_vector<quantifier> const & qs, svector<lbool> & results);
         bool add_blocking_clause(model * cex, expr_ref_vector & sks);
         bool check(quantifier * q);
         void check_quantifiers(bool& found_relevant, unsigned& num_failures);
@@ -43,7 +43,8 @@ namespace smt {
         m_context(nullptr),
         m_fresh_idx(1),
         m_asts(m),
-        m_model(nullptr) {
+        m_model(nullptr),
+        m_mark_stamp(0) {
     }
 
     model_generator::~model_generator() {
@@ -86,14 +87,12 @@ namespace smt {
     }
 
     /**
-       \brief Create the mapping root2proc: enode-root -> model_value_proc, and roots.
+       \brief Create the mapping m_root2proc: enode-root -> model_value_proc, and roots.
        Store the new model_value_proc at procs.
     */
-    void model_generator::mk_value_procs(obj_map<enode, model_value_proc *> & root2proc, ptr_vector<enode> & roots, 
-                                         ptr_vector<model_value_proc> & procs) {
+    void model_generator::mk_value_procs(ptr_vector<enode> & roots, ptr_vector<model_value_proc> & procs) {
         for (enode * r : m_context->enodes()) {
             if (r == r->get_root() && (m_context->is_relevant(r) || m.is_value(r->get_expr()))) {
-                roots.push_back(r);
                 sort * s      = r->get_sort();
                 model_value_proc * proc = nullptr;
                 if (m.is_bool(s)) {
@@ -127,7 +126,9 @@ namespace smt {
                 }
                 SASSERT(proc);
                 procs.push_back(proc);
-                root2proc.insert(r, proc);
+                m_root2proc.reserve(r->get_owner_id() + 1, nullptr);
+                m_root2proc[r->get_owner_id()] = proc;
+                roots.push_back(r);
             }
         }
     }
@@ -148,20 +149,36 @@ namespace smt {
 #define White 0
 #define Grey  1
 #define Black 2
-    
-    static int get_color(source2color const & colors, source const & s) {
-        int color;
-        if (colors.find(s, color))
-            return color;
-        return White;
+
+    /**
+       \brief a mark encodes the stamp of the current topological sort and a color.
+       Marks of previous sorts are White.
+    */
+    int model_generator::get_color(source const & s) const {
+        unsigned mark = s.is_fresh_value() ? 
+            m_fresh_marks.get(s.get_value()->get_idx(), 0) : 
+            m_enode_marks.get(s.get_enode()->get_owner_id(), 0);
+        return mark / 3 == m_mark_stamp ? static_cast<int>(mark % 3) : White;
     }
-    
-    static void set_color(source2color & colors, source const & s, int c) {
-        colors.insert(s, c);
+
+    void model_generator::set_color(source const & s, int c) {
+        unsigned_vector & marks = s.is_fresh_value() ? m_fresh_marks : m_enode_marks;
+        unsigned idx = s.is_fresh_value() ? s.get_value()->get_idx() : s.get_enode()->get_owner_id();
+        marks.reserve(idx + 1, 0);
+        marks[idx] = 3 * m_mark_stamp + c;
+    }
+
+    void model_generator::reset_colors() {
+        if (m_mark_stamp >= UINT_MAX / 3 - 1) {
+            m_mark_stamp = 0;
+            m_enode_marks.fill(0);
+            m_fresh_marks.fill(0);
+        }
+        ++m_mark_stamp;
     }
     
-    static void visit_child(source const & s, source2color & colors, svector<source> & todo, bool & visited) {
-        if (get_color(colors, s) == White) {
+    void model_generator::visit_child(source const & s, svector<source> & todo, bool & visited) {
+        if (get_color(s) == White) {
             todo.push_back(s);
             visited = false;
         }
@@ -169,8 +186,6 @@ namespace smt {
     
     bool model_generator::visit_children(source const & src, 
                                          ptr_vector<enode> const & roots, 
-                                         obj_map<enode, model_value_proc *> const & root2proc, 
-                                         source2color & colors, 
                                          obj_hashtable<sort> & already_traversed, 
                                          svector<source> & todo) {
 
@@ -186,10 +201,10 @@ namespace smt {
                 if (r->get_sort() != s)
                     continue;
                 SASSERT(r == r->get_root());
-                if (root2proc[r]->is_fresh()) 
+                if (get_proc(r)->is_fresh()) 
                     continue; // r is associated with a fresh value...
                 TRACE("mg_top_sort", tout << "fresh!" << src.get_value()->get_idx() << " -> #" << r->get_owner_id() << " " << mk_pp(r->get_sort(), m) << "\n";);
-                visit_child(source(r), colors, todo, visited);
+                visit_child(source(r), todo, visited);
                 TRACE("mg_top_sort", tout << "visited: " << visited << ", todo.size(): " << todo.size() << "\n";);
             }
             already_traversed.insert(s);
@@ -201,11 +216,11 @@ namespace smt {
         enode * n = src.get_enode();
         SASSERT(n == n->get_root());
         bool visited = true;
-        model_value_proc * proc = root2proc[n];
+        model_value_proc * proc = get_proc(n);
         buffer<model_value_dependency> dependencies;
         proc->get_dependencies(dependencies);
         for (model_value_dependency const& dep : dependencies) {
-            visit_child(dep, colors, todo, visited);
+            visit_child(dep, todo, visited);
         }
         TRACE("mg_top_sort",
               tout << "src: " << src << " ";
@@ -219,14 +234,12 @@ namespace smt {
 
     void model_generator::process_source(source const & src,
                                          ptr_vector<enode> const & roots, 
-                                         obj_map<enode, model_value_proc *> const & root2proc, 
-                                         source2color & colors, 
                                          obj_hashtable<sort> & already_traversed, 
                                          svector<source> & todo,
                                          svector<source> & sorted_sources) {
         TRACE("mg_top_sort", tout << "process source, is_fresh: " << src.is_fresh_value() << " ";
               tout << src << ", todo.size(): " << todo.size() << "\n";);
-        int color     = get_color(colors, src);
+        int color     = get_color(src);
         SASSERT(color != Grey);
         if (color == Black)
             return;
@@ -236,14 +249,14 @@ namespace smt {
             source curr = todo.back();
             TRACE("mg_top_sort", tout << "current source, is_fresh: " << curr.is_fresh_value() << " ";
                   tout << curr << ", todo.size(): " << todo.size() << "\n";);
-            switch (get_color(colors, curr)) {
+            switch (get_color(curr)) {
             case White:
-                set_color(colors, curr, Grey);
-                visit_children(curr, roots, root2proc, colors, already_traversed, todo);
+                set_color(curr, Grey);
+                visit_children(curr, roots, already_traversed, todo);
                 break;
             case Grey:
-                // SASSERT(visit_children(curr, roots, root2proc, colors, already_traversed, todo));
-                set_color(colors, curr, Black);
+                // SASSERT(visit_children(curr, roots, already_traversed, todo));
+                set_color(curr, Black);
                 TRACE("mg_top_sort", tout << "append " << curr << "\n";);
                 sorted_sources.push_back(curr);
                 break;
@@ -261,11 +274,10 @@ namespace smt {
        \brief Topological sort of 'sources'. Store result in sorted_sources.
     */
     void model_generator::top_sort_sources(ptr_vector<enode> const & roots, 
-                                           obj_map<enode, model_value_proc *> const & root2proc, 
                                            svector<source> & sorted_sources) {
         
         svector<source>     todo;
-        source2color        colors;
+        reset_colors();
         // The following 'set' of sorts is used to avoid traversing roots looking for enodes of sort S.
         // That is, a sort S is in already_traversed, if all enodes of sort S in roots were already traversed.
         obj_hashtable<sort> already_traversed;
@@ -274,31 +286,30 @@ namespace smt {
 
         // traverse all extra fresh values...
         for (extra_fresh_value * f : m_extra_fresh_values) {
-            process_source(source(f), roots, root2proc, colors, already_traversed, todo, sorted_sources);
+            process_source(source(f), roots, already_traversed, todo, sorted_sources);
         }
 
         // traverse all enodes that are associated with fresh values...
         for (enode* r : roots) {
-            if (root2proc[r]->is_fresh()) {
-                process_source(source(r), roots, root2proc, colors, already_traversed, todo, sorted_sources);
+            if (get_proc(r)->is_fresh()) {
+                process_source(source(r), roots, already_traversed, todo, sorted_sources);
             }
         }
 
         for (enode * r : roots) {
-            process_source(source(r), roots, root2proc, colors, already_traversed, todo, sorted_sources);
+            process_source(source(r), roots, already_traversed, todo, sorted_sources);
         }
     }
 
     void model_generator::mk_values() {
-        obj_map<enode, model_value_proc *> root2proc;
         ptr_vector<enode> roots;
         ptr_vector<model_value_proc> procs;
-        scoped_reset _scoped_reset(*this, procs);
+        scoped_reset _scoped_reset(*this, roots, procs);
         svector<source> sources;
         buffer<model_value_dependency> dependencies;
         expr_ref_vector dependency_values(m);
-        mk_value_procs(root2proc, roots, procs);
-        top_sort_sources(roots, root2proc, sources);
+        mk_value_procs(roots, procs);
+        top_sort_sources(roots, sources);
         TRACE("sorted_sources",
               for (source const& curr : sources) {
                   if (curr.is_fresh_value()) {
@@ -310,7 +321,7 @@ namespace smt {
                       tout << mk_pp(n->get_expr(), m) << "\n";
                       sort * s = n->get_sort();
                       tout << curr << " " << mk_pp(s, m);
-                      tout << " is_fresh: " << root2proc[n]->is_fresh() << "\n";
+                      tout << " is_fresh: " << get_proc(n)->is_fresh() << "\n";
                   }
               }
               m_context->display(tout);
@@ -332,8 +343,7 @@ namespace smt {
                 TRACE("mg_top_sort", tout << curr << "\n";);
                 dependencies.reset();
                 dependency_values.reset();
-                model_value_proc * proc = root2proc[n];
-                SASSERT(proc);
+                model_value_proc * proc = get_proc(n);
                 proc->get_dependencies(dependencies);
                 for (model_value_dependency const& d : dependencies) {
                     if (d.is_fresh_value()) {
@@ -368,10 +378,12 @@ namespace smt {
         }
     }
 
-    model_generator::scoped_reset::scoped_reset(model_generator& mg, ptr_vector<model_value_proc>& procs): 
-        mg(mg), procs(procs) {}
+    model_generator::scoped_reset::scoped_reset(model_generator& mg, ptr_vector<enode>& roots, ptr_vector<model_value_proc>& procs): 
+        mg(mg), roots(roots), procs(procs) {}
 
     model_generator::scoped_reset::~scoped_reset() {
+        for (enode * r : roots)
+            mg.m_root2proc[r->get_owner_id()] = nullptr;
         std::for_each(procs.begin(), procs.end(), delete_proc<model_value_proc>());
         std::for_each(mg.m_extra_fresh_values.begin(), mg.m_extra_fresh_values.end(), delete_proc<extra_fresh_value>());
         mg.m_extra_fresh_values.reset();
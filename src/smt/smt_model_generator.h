@@ -127,8 +127,6 @@ namespace smt {
         }
     };
 
-    typedef map<source, int, source_hash_proc, source_eq_proc> source2color;
-
     /**
        \brief Model value builder. This functor is used to specify the dependencies 
        needed to build a value, and to build the actual value.
@@ -185,10 +183,23 @@ namespace smt {
         ast_ref_vector                m_asts;
         ref<proto_model>              m_model;
         obj_hashtable<func_decl>      m_hidden_ufs;
+        // The following vectors are indexed by enode owner ids and fresh value indices.
+        // They are kept between models so that rebuilding a model does not allocate
+        // and populate hash tables proportional to the number of roots.
+        ptr_vector<model_value_proc>  m_root2proc;
+        unsigned_vector               m_enode_marks;
+        unsigned_vector               m_fresh_marks;
+        unsigned                      m_mark_stamp;
+
+        int get_color(source const & s) const;
+        void set_color(source const & s, int c);
+        void reset_colors();
+        void visit_child(source const & s, svector<source> & todo, bool & visited);
+        model_value_proc * get_proc(enode * r) const { SASSERT(m_root2proc.get(r->get_owner_id(), nullptr)); return m_root2proc[r->get_owner_id()]; }
 
         void init_model();
         void mk_bool_model();
-        void mk_value_procs(obj_map<enode, model_value_proc *> & root2proc, ptr_vector<enode> & roots,  ptr_vector<model_value_proc> & procs);
+        void mk_value_procs(ptr_vector<enode> & roots,  ptr_vector<model_value_proc> & procs);
         void mk_values();
         bool include_func_interp(func_decl * f) const;
         void mk_func_interps();
@@ -197,18 +208,19 @@ namespace smt {
         void register_existing_model_values();
         void register_macros();
 
-        bool visit_children(source const & src, ptr_vector<enode> const & roots, obj_map<enode, model_value_proc *> const & root2proc, 
-                            source2color & colors, obj_hashtable<sort> & already_traversed, svector<source> & todo);
+        bool visit_children(source const & src, ptr_vector<enode> const & roots, 
+                            obj_hashtable<sort> & already_traversed, svector<source> & todo);
 
-        void process_source(source const & src, ptr_vector<enode> const & roots, obj_map<enode, model_value_proc *> const & root2proc, 
-                            source2color & colors, obj_hashtable<sort> & already_traversed, svector<source> & todo, svector<source> & sorted_sources);
+        void process_source(source const & src, ptr_vector<enode> const & roots, 
+                            obj_hashtable<sort> & already_traversed, svector<source> & todo, svector<source> & sorted_sources);
 
-        void top_sort_sources(ptr_vector<enode> const & roots, obj_map<enode, model_value_proc *> const & root2proc, svector<source> & sorted_sources);
+        void top_sort_sources(ptr_vector<enode> const & roots, svector<source> & sorted_sources);
 
         struct scoped_reset {
             model_generator& mg;
+            ptr_vector<enode>& roots;
             ptr_vector<model_value_proc>& procs;
-            scoped_reset(model_generator& mg, ptr_vector<model_value_proc>& procs);
+            scoped_reset(model_generator& mg, ptr_vector<enode>& roots, ptr_vector<model_value_proc>& procs);
             ~scoped_reset();            
         };
 
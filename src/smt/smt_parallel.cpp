@@ -36,6 +36,9 @@ namespace smt {
 #else
 
 #include <thread>
+#include <deque>
+#include "util/thread_pool.h"
+#include <condition_variable>
 
 namespace smt {
     
@@ -87,10 +90,13 @@ namespace smt {
             context& new_ctx = *pctxs.back();
             context::copy(ctx, new_ctx, true);
             new_ctx.set_random_seed(i + ctx.get_fparams().m_random_seed);
-            ast_translation tr(m, *new_m);
-            pasms.push_back(tr(asms));
             sl.push_child(&(new_m->limit()));
         }
+        {
+            ptr_vector<ast_manager> targets;
+            for (ast_manager* pm : pms) targets.push_back(pm);
+            translate_parallel(m, asms, targets, pasms);
+        }
 
         auto cube = [](context& ctx, expr_ref_vector& lasms, expr_ref& c) {
             lookahead lh(ctx);
@@ -212,16 +218,257 @@ namespace smt {
             }
         };
 
-        // for debugging:  num_threads = 1;
+        // Cube-and-conquer with work stealing.
+        // Each thread owns a deque of open cubes over the shared manager m. A thread works
+        // on the most recent cube of its own deque and idle threads steal the oldest cube
+        // from another deque. Cubes that exhaust the conflict budget are split using lookahead.
+        // Unsat cores that depend on cube literals are shared as lemmas among all threads
+        // and prune queued cubes that contain the refuted literals.
+        // All access to m and the shared containers is protected by mux.
+
+        struct cube_t {
+            expr_ref_vector lits;
+            unsigned        budget;
+            cube_t(expr_ref_vector const& lits, unsigned budget): lits(lits), budget(budget) {}
+        };
+        std::vector<std::deque<cube_t>> cubes(num_threads);
+        std::condition_variable cv;
+        expr_ref_vector lemmas(m), core_asms(m);
+        obj_hashtable<expr> asms_set, core_asms_set;
+        unsigned_vector lemma_lim(num_threads, 0u);
+        unsigned num_active = 0, total_conflicts = 0;
+        bool refuted_all = false;
+        for (expr* a : asms)
+            asms_set.insert(a);
+
+        auto cancel_others = [&](unsigned i) {
+            for (ast_manager* m : pms) 
+                if (m != pms[i]) m->limit().cancel();
+        };
+
+        // caller holds mux.
+        auto pop_cube = [&](unsigned i, expr_ref_vector& lits, unsigned& budget) {
+            for (unsigned k = 0; k < num_threads; ++k) {
+                auto& q = cubes[(i + k) % num_threads];
+                if (q.empty())
+                    continue;
+                cube_t& c = k == 0 ? q.back() : q.front();
+                lits.append(c.lits);
+                budget = c.budget;
+                if (k == 0) q.pop_back(); else q.pop_front();
+                if (k > 0) 
+                    IF_VERBOSE(2, verbose_stream() << "(smt.thread " << i << " :steal " << lits.size() << ")\n");
+                return true;
+            }
+            return false;
+        };
+
+        // caller holds mux. Remove queued cubes that contain all cube literals of a core.
+        auto prune_cubes = [&](expr_ref_vector const& core) {
+            ptr_buffer<expr> lits;
+            for (expr* e : core) 
+                if (!asms_set.contains(e))
+                    lits.push_back(e);
+            unsigned num_pruned = 0;
+            for (auto& q : cubes) {
+                std::deque<cube_t> keep;
+                for (cube_t& c : q) {
+                    bool subsumed = true;
+                    for (expr* e : lits)
+                        subsumed &= c.lits.contains(e);
+                    if (subsumed) 
+                        ++num_pruned; 
+                    else 
+                        keep.push_back(c);
+                }
+                q.swap(keep);
+            }
+            IF_VERBOSE(2, if (num_pruned > 0) verbose_stream() << "(smt.thread :pruned " << num_pruned << ")\n");
+        };
+
+        auto cube_worker = [&](unsigned i) {
+            context& pctx = *pctxs[i];
+            ast_manager& pm = *pms[i];
+            while (true) {
+                expr_ref_vector lcube(pm), new_lemmas(pm);
+                unsigned budget = 0;
+                {
+                    std::unique_lock<std::mutex> lock(mux);
+                    expr_ref_vector cube(m);
+                    while (!done && !pop_cube(i, cube, budget)) {
+                        if (num_active == 0) {
+                            // every cube was refuted
+                            done = true;
+                            refuted_all = true;
+                            finished_id = i;
+                            result = l_false;
+                            break;
+                        }
+                        cv.wait(lock);
+                    }
+                    if (done) {
+                        cv.notify_all();
+                        return;
+                    }
+                    ++num_active;
+                    ast_translation tr(m, pm);
+                    lcube.append(tr(cube));
+                    for (unsigned j = lemma_lim[i]; j < lemmas.size(); ++j)
+                        new_lemmas.push_back(tr(lemmas.get(j)));
+                    lemma_lim[i] = lemmas.size();
+                }
+
+                for (expr* lemma : new_lemmas)
+                    pctx.assert_expr(lemma);
+                expr_ref_vector lasms(pasms[i]);
+                lasms.append(lcube);
+                pctx.get_fparams().m_max_conflicts = budget;
+                IF_VERBOSE(1, verbose_stream() << "(smt.thread " << i << " :cube " << lcube.size() << " :budget " << budget << ")\n");
+                lbool r = pctx.check(lasms.size(), lasms.data());
+
+                if (r == l_true) {
+                    {
+                        std::lock_guard<std::mutex> lock(mux);
+                        if (done) return;
+                        done = true;
+                        finished_id = i;
+                        result = l_true;
+                    }
+                    cancel_others(i);
+                    cv.notify_all();
+                    return;
+                }
+
+                if (r == l_false) {
+                    expr_ref_vector const& core = pctx.unsat_core();
+                    bool uses_cube = false;
+                    for (expr* e : core)
+                        uses_cube |= lcube.contains(e);
+                    {
+                        std::lock_guard<std::mutex> lock(mux);
+                        if (done) return;
+                        --num_active;
+                        total_conflicts += pctx.m_num_conflicts;
+                        if (!uses_cube) {
+                            done = true;
+                            finished_id = i;
+                            result = l_false;
+                        }
+                        else {
+                            ast_translation tr(pm, m);
+                            expr_ref_vector mcore(tr(core));
+                            for (expr* e : mcore) {
+                                if (asms_set.contains(e) && !core_asms_set.contains(e)) {
+                                    core_asms_set.insert(e);
+                                    core_asms.push_back(e);
+                                }
+                            }
+                            lemmas.push_back(mk_not(mk_and(mcore)));
+                            prune_cubes(mcore);
+                        }
+                    }
+                    if (!uses_cube) 
+                        cancel_others(i);
+                    else 
+                        pctx.assert_expr(mk_not(mk_and(core)));
+                    cv.notify_all();
+                    continue;
+                }
+
+                // r == l_undef
+                bool exhausted = !pm.limit().is_canceled() && pctx.m_num_conflicts >= budget;
+                expr_ref lit(pm);
+                bool give_up = false;
+                if (exhausted) {
+                    lookahead lh(pctx);
+                    lit = lh.choose();
+                    if (lit && (lcube.contains(lit) || lcube.contains(mk_not(lit))))
+                        lit = nullptr;
+                }
+                {
+                    std::lock_guard<std::mutex> lock(mux);
+                    if (done) return;
+                    --num_active;
+                    total_conflicts += pctx.m_num_conflicts;
+                    if (!exhausted || total_conflicts >= max_conflicts) {
+                        give_up = true;
+                        done = true;
+                        finished_id = i;
+                        result = l_undef;
+                    }
+                    else {
+                        ast_translation tr(pm, m);
+                        expr_ref_vector cube(tr(lcube));
+                        if (lit) {
+                            // push both branches; siblings at the front are preferred by thieves.
+                            expr_ref mlit(tr(lit.get()), m);
+                            cube.push_back(mk_not(mlit));
+                            cubes[i].emplace_back(cube, budget);
+                            cube.set(cube.size() - 1, mlit);
+                            cubes[i].emplace_back(cube, budget);
+                        }
+                        else {
+                            // no new split literal, retry the cube with a larger budget.
+                            cubes[i].emplace_back(cube, 2 * budget);
+                        }
+                    }
+                }
+                if (give_up) 
+                    cancel_others(i);
+                cv.notify_all();
+            }
+        };
 
-        while (true) {
-            vector<std::thread> threads(num_threads);
+        auto cube_thread = [&](unsigned i) {
+            try {
+                cube_worker(i);
+                return;
+            }
+            catch (z3_error & err) {
+                std::lock_guard<std::mutex> lock(mux);
+                if (finished_id == UINT_MAX) {
+                    error_code = err.error_code();
+                    ex_kind = ERROR_EX;
+                }
+                done = true;
+            }
+            catch (z3_exception & ex) {
+                std::lock_guard<std::mutex> lock(mux);
+                if (finished_id == UINT_MAX) {
+                    ex_msg = ex.msg();
+                    ex_kind = DEFAULT_EX;
+                }
+                done = true;
+            }
+            catch (...) {
+                std::lock_guard<std::mutex> lock(mux);
+                if (finished_id == UINT_MAX) {
+                    ex_msg = "unknown exception";
+                    ex_kind = ERROR_EX;
+                }
+                done = true;
+            }
+            cancel_others(i);
+            cv.notify_all();
+        };
+
+        if (ctx.get_fparams().m_threads_cube_and_conquer) {
+            cubes[0].emplace_back(expr_ref_vector(m), std::max(thread_max_conflicts, 1u));
+            thread_pool threads;
             for (unsigned i = 0; i < num_threads; ++i) {
-                threads[i] = std::thread([&, i]() { worker_thread(i); });
+                threads.run([&, i]() { cube_thread(i); });
             }
-            for (auto & th : threads) {
-                th.join();
+            threads.join();
+        }
+
+        // for debugging:  num_threads = 1;
+
+        while (!ctx.get_fparams().m_threads_cube_and_conquer) {
+            thread_pool threads;
+            for (unsigned i = 0; i < num_threads; ++i) {
+                threads.run([&, i]() { worker_thread(i); });
             }
+            threads.join();
             if (done) break;
 
             collect_units();
@@ -252,8 +499,11 @@ namespace smt {
             break;
         case l_false:
             ctx.m_unsat_core.reset();
-            for (expr* e : pctx.unsat_core()) 
-                ctx.m_unsat_core.push_back(tr(e));
+            if (refuted_all) 
+                ctx.m_unsat_core.append(core_asms);
+            else 
+                for (expr* e : pctx.unsat_core()) 
+                    ctx.m_unsat_core.push_back(tr(e));
             break;
         default:
             break;
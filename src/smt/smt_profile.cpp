@@ -0,0 +1,116 @@
+/*++
+Copyright (c) 2021 Microsoft Corporation
+
+Module Name:
+
+    smt_profile.cpp
+
+Abstract:
+
+    Scoped timers that attribute time to the phases of the SMT core.
+
+--*/
+#include <cstring>
+#include <string>
+#include "util/symbol.h"
+#include "util/map.h"
+#include "smt/smt_profile.h"
+
+namespace smt {
+
+    profile::profile() {
+        reset();
+    }
+
+    void profile::reset() {
+        m_frames.reset();
+        m_frames.push_back(frame("smt", UINT_MAX));
+        m_curr = 0;
+    }
+
+    unsigned profile::enter(char const * name) {
+        frame const & curr = m_frames[m_curr];
+        if (curr.m_name == name || strcmp(curr.m_name, name) == 0)
+            return UINT_MAX;
+        for (unsigned child : curr.m_children) {
+            char const * n = m_frames[child].m_name;
+            if (n == name || strcmp(n, name) == 0) {
+                m_curr = child;
+                return child;
+            }
+        }
+        unsigned id = m_frames.size();
+        m_frames.push_back(frame(name, m_curr));
+        m_frames[m_curr].m_children.push_back(id);
+        m_curr = id;
+        return id;
+    }
+
+    void profile::leave(unsigned id, uint64_t nanos) {
+        SASSERT(id == m_curr);
+        frame & f = m_frames[id];
+        f.m_calls++;
+        f.m_nanos += nanos;
+        m_curr = f.m_parent;
+    }
+
+    uint64_t profile::self_nanos(frame const & f) const {
+        uint64_t children = 0;
+        for (unsigned child : f.m_children)
+            children += m_frames[child].m_nanos;
+        return f.m_nanos > children ? f.m_nanos - children : 0;
+    }
+
+    /**
+       \brief report the time of each phase, keyed by the phase and the phase it
+       was called from, e.g. "time propagate/arithmetic". Frames with the same key
+       on different call paths are added up.
+    */
+    void profile::collect_statistics(::statistics & st) const {
+        typedef map<symbol, double, symbol_hash_proc, symbol_eq_proc> key2time;
+        key2time totals;
+        svector<symbol> keys;
+        for (unsigned i = 1; i < m_frames.size(); ++i) {
+            frame const & f = m_frames[i];
+            if (f.m_calls == 0)
+                continue;
+            std::string name = "time ";
+            if (f.m_parent != 0)
+                name += std::string(m_frames[f.m_parent].m_name) + "/";
+            name += f.m_name;
+            // the statistics object keeps the key, symbols are never deallocated.
+            symbol key(name.c_str());
+            if (!totals.contains(key)) {
+                keys.push_back(key);
+                totals.insert(key, 0.0);
+            }
+            totals[key] += f.m_nanos / 1e9;
+        }
+        for (symbol const & k : keys)
+            st.update(k.bare_str(), totals[k]);
+    }
+
+    /**
+       \brief display the self time of every call path in microseconds, one line per path:
+       smt;propagate;arithmetic 1234
+    */
+    void profile::display_folded(std::ostream & out) const {
+        svector<char const*> path;
+        for (unsigned i = 1; i < m_frames.size(); ++i) {
+            frame const & f = m_frames[i];
+            uint64_t self = self_nanos(f) / 1000;
+            if (self == 0)
+                continue;
+            path.reset();
+            for (unsigned j = i; j != UINT_MAX; j = m_frames[j].m_parent)
+                path.push_back(m_frames[j].m_name);
+            for (unsigned j = path.size(); j-- > 0; ) {
+                out << path[j];
+                if (j > 0)
+                    out << ";";
+            }
+            out << " " << self << "\n";
+        }
+    }
+
+};
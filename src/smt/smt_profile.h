@@ -0,0 +1,85 @@
+/*++
+Copyright (c) 2021 Microsoft Corporation
+
+Module Name:
+
+    smt_profile.h
+
+Abstract:
+
+    Scoped timers that attribute time to the phases of the SMT core.
+
+    Scopes nest and time is accumulated per call path, so the profile can
+    be written in the folded stack format read by flame graph tools.
+    When profiling is disabled a scope costs a single test.
+
+--*/
+#pragma once
+
+#include <chrono>
+#include <ostream>
+#include "util/vector.h"
+#include "util/statistics.h"
+#include "util/phase_profiler.h"
+
+namespace smt {
+
+    class profile {
+        struct frame {
+            char const *    m_name;
+            unsigned        m_parent;
+            unsigned        m_calls { 0 };
+            uint64_t        m_nanos { 0 };
+            unsigned_vector m_children;
+            frame(char const * name, unsigned parent): m_name(name), m_parent(parent) {}
+        };
+        typedef std::chrono::steady_clock clock;
+
+        bool           m_enabled { false };
+        vector<frame>  m_frames;
+        unsigned       m_curr { 0 };
+
+        unsigned enter(char const * name);
+        void leave(unsigned id, uint64_t nanos);
+        uint64_t self_nanos(frame const & f) const;
+
+    public:
+        profile();
+
+        void set_enabled(bool f) { m_enabled = f; }
+        bool enabled() const { return m_enabled; }
+        void reset();
+
+        void collect_statistics(::statistics & st) const;
+        void display_folded(std::ostream & out) const;
+
+        /**
+           \brief attribute the time spent in the enclosing block to \c name.
+           \c name must outlive the profile. A scope nested directly in a
+           scope with the same name is not recorded separately.
+        */
+        class scope {
+            profile *          m_profile { nullptr };
+            unsigned           m_id { 0 };
+            clock::time_point  m_start;
+            scoped_phase       m_phase;
+        public:
+            scope(profile & p, char const * name): m_phase(name) {
+                if (p.m_enabled) {
+                    m_id = p.enter(name);
+                    if (m_id != UINT_MAX) {
+                        m_profile = &p;
+                        m_start = clock::now();
+                    }
+                }
+            }
+            ~scope() {
+                if (m_profile) {
+                    auto d = std::chrono::duration_cast<std::chrono::nanoseconds>(clock::now() - m_start);
+                    m_profile->leave(m_id, static_cast<uint64_t>(d.count()));
+                }
+            }
+        };
+    };
+
+};
@@ -185,7 +185,10 @@ namespace smt {
                 out.width(3);
                 out << num_instances_checker_sat << " : ";
                 out.width(3);
-                out << max_generation << " : " << max_cost << "\n";
+                out << max_generation << " : " << max_cost;
+                if (m_params.m_qi_learn)
+                    out << " : " << s->get_num_conflicts();
+                out << "\n";
             }
         }
 
@@ -324,6 +327,12 @@ namespace smt {
             return f != nullptr;
         }
 
+        void conflict_eh(quantifier * q) {
+            q::quantifier_stat * s = nullptr;
+            if (m_quantifier_stat.find(q, s))
+                s->inc_num_conflicts();
+        }
+
         void init_search_eh() {
             m_num_instances = 0;
             for (quantifier * q : m_quantifiers) {
@@ -488,6 +497,10 @@ namespace smt {
         m_imp->init_search_eh();
     }
 
+    void quantifier_manager::conflict_eh(quantifier * q) {
+        m_imp->conflict_eh(q);
+    }
+
     void quantifier_manager::assign_eh(quantifier * q) {
         m_imp->assign_eh(q);
     }
@@ -748,7 +761,10 @@ namespace smt {
         void propagate() override {
             if (!m_active)
                 return;
-            m_mam->match();
+            {
+                profile::scope _p(m_context->get_profile(), "mam");
+                m_mam->match();
+            }
             if (!m_context->relevancy() && use_ematching()) {
                 ptr_vector<enode>::const_iterator it  = m_context->begin_enodes();
                 ptr_vector<enode>::const_iterator end = m_context->end_enodes();
@@ -798,6 +814,7 @@ namespace smt {
         final_check_status final_check_quant() {
             if (use_ematching()) {
                 if (m_lazy_matching_idx < m_fparams->m_qi_max_lazy_multipattern_matching) {
+                    profile::scope _p(m_context->get_profile(), "mam");
                     m_lazy_mam->rematch();
                     m_context->push_trail(value_trail<unsigned>(m_lazy_matching_idx));
                     m_lazy_matching_idx++;
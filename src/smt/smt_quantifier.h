@@ -67,6 +67,7 @@ namespace smt {
         bool add_instance(quantifier * q, unsigned num_bindings, enode * const * bindings, expr* def, unsigned generation = 0);
 
         void init_search_eh();
+        void conflict_eh(quantifier * q);
         void assign_eh(quantifier * q);
         void add_eq_eh(enode * n1, enode * n2);
         void relevant_eh(enode * n);
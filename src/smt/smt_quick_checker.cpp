@@ -39,6 +39,24 @@ namespace smt {
             m_candidates[i].reset();
         }
         m_cache.reset();
+        m_arg_roots_idx.reset();
+        m_arg_roots.reset();
+    }
+
+    quick_checker::enode_set const & quick_checker::collector::arg_roots(func_decl * f, unsigned i) {
+        decl_pos k(f, i);
+        unsigned idx;
+        if (m_arg_roots_idx.find(k, idx))
+            return m_arg_roots[idx];
+        idx = m_arg_roots.size();
+        m_arg_roots.push_back(enode_set());
+        m_arg_roots_idx.insert(k, idx);
+        enode_set & s = m_arg_roots.back();
+        for (enode * curr : m_context.enodes_of(f)) {
+            if (m_context.is_relevant(curr) && curr->is_cgr() && i < curr->get_num_args())
+                s.insert(curr->get_arg(i)->get_root());
+        }
+        return s;
     }
 
     /**
@@ -52,11 +70,7 @@ namespace smt {
     bool quick_checker::collector::check_arg(enode * n, func_decl * f, unsigned i) {
         if (!f || !m_conservative)
             return true;
-        for (enode * curr : m_context.enodes_of(f)) {
-            if (m_context.is_relevant(curr) && curr->is_cgr() && i < curr->get_num_args() && curr->get_arg(i)->get_root() == n->get_root())
-                return true;
-        }
-        return false;
+        return arg_roots(f, i).contains(n->get_root());
     }
 
     void quick_checker::collector::collect_core(app * n, func_decl * p, unsigned i) {
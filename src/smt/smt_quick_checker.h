@@ -57,6 +57,14 @@ namespace smt {
             typedef hashtable<entry, obj_hash<entry>, default_eq<entry> > cache;
             cache                m_cache;
 
+            // roots of the i-th arguments of the relevant congruence roots of f,
+            // computed on demand for every (f, i) during a call to operator().
+            typedef std::pair<func_decl *, unsigned> decl_pos;
+            typedef pair_hash<obj_ptr_hash<func_decl>, unsigned_hash> decl_pos_hash;
+            map<decl_pos, unsigned, decl_pos_hash, default_eq<decl_pos> > m_arg_roots_idx;
+            vector<enode_set>    m_arg_roots;
+            enode_set const & arg_roots(func_decl * f, unsigned i);
+
             void init(quantifier * q);
             bool check_arg(enode * n, func_decl * f, unsigned i);
             void collect_core(app * n, func_decl * p, unsigned i);
@@ -129,10 +129,23 @@ namespace smt {
     struct relevancy_propagator_imp : public relevancy_propagator {
         unsigned                       m_qhead;
         expr_ref_vector                m_relevant_exprs; 
-        uint_set                       m_is_relevant;
+        /**
+           \brief An expression is relevant if it was marked at a scope level
+           that is still open. Every scope gets a fresh stamp, so marks of
+           popped scopes become stale without being undone.
+        */
+        struct mark {
+            unsigned m_lvl   { UINT_MAX };
+            unsigned m_stamp { 0 };
+            mark() {}
+            mark(unsigned lvl, unsigned stamp):m_lvl(lvl), m_stamp(stamp) {}
+        };
+        svector<mark>                  m_marks;         // indexed by expression id
+        unsigned_vector                m_scope_stamps;  // stamp of each open scope level
+        unsigned                       m_stamp;
         typedef list<relevancy_eh *>   relevancy_ehs;
-        obj_map<expr, relevancy_ehs *> m_relevant_ehs;
-        obj_map<expr, relevancy_ehs *> m_watches[2];
+        ptr_vector<relevancy_ehs>      m_relevant_ehs;  // indexed by expression id
+        ptr_vector<relevancy_ehs>      m_watches[2];    // indexed by expression id
         struct eh_trail {
             enum kind { POS_WATCH, NEG_WATCH, HANDLER };
             kind   m_kind;
@@ -152,38 +165,37 @@ namespace smt {
 
         relevancy_propagator_imp(context & ctx):
             relevancy_propagator(ctx), m_qhead(0), m_relevant_exprs(ctx.get_manager()),
-            m_propagating(false) {}
+            m_stamp(0), m_propagating(false) {
+            m_scope_stamps.push_back(0);
+        }
 
         ~relevancy_propagator_imp() override {
             undo_trail(0);
         }
 
+        static relevancy_ehs * get(ptr_vector<relevancy_ehs> const & v, expr * n) {
+            return v.get(n->get_id(), nullptr);
+        }
+
+        static void set(ptr_vector<relevancy_ehs> & v, expr * n, relevancy_ehs * ehs) {
+            v.reserve(n->get_id() + 1, nullptr);
+            v[n->get_id()] = ehs;
+        }
+
         relevancy_ehs * get_handlers(expr * n) {
-            relevancy_ehs * r = nullptr;
-            m_relevant_ehs.find(n, r);
-            SASSERT(m_relevant_ehs.contains(n) || r == 0);
-            return r;
+            return get(m_relevant_ehs, n);
         }
 
         void set_handlers(expr * n, relevancy_ehs * ehs) {
-            if (ehs == nullptr)
-                m_relevant_ehs.erase(n);
-            else
-                m_relevant_ehs.insert(n, ehs);
+            set(m_relevant_ehs, n, ehs);
         }
 
         relevancy_ehs * get_watches(expr * n, bool val) {
-            relevancy_ehs * r = nullptr;
-            m_watches[val ? 1 : 0].find(n, r);
-            SASSERT(m_watches[val ? 1 : 0].contains(n) || r == 0);
-            return r;
+            return get(m_watches[val ? 1 : 0], n);
         }
 
         void set_watches(expr * n, bool val, relevancy_ehs * ehs) {
-            if (ehs == nullptr)
-                m_watches[val ? 1 : 0].erase(n);
-            else
-                m_watches[val ? 1 : 0].insert(n, ehs);
+            set(m_watches[val ? 1 : 0], n, ehs);
         }
 
         void push_trail(eh_trail const & t) {
@@ -242,7 +254,13 @@ namespace smt {
             }
         }
         
-        bool is_relevant_core(expr * n) const { return m_is_relevant.contains(n->get_id()); }
+        bool is_relevant_core(expr * n) const { 
+            unsigned id = n->get_id();
+            if (id >= m_marks.size())
+                return false;
+            mark const & mk = m_marks[id];
+            return mk.m_lvl < m_scope_stamps.size() && m_scope_stamps[mk.m_lvl] == mk.m_stamp;
+        }
         
         bool is_relevant(expr * n) const override {
             return !enabled() || is_relevant_core(n);
@@ -253,6 +271,28 @@ namespace smt {
             scope & s                  = m_scopes.back();
             s.m_relevant_exprs_lim     = m_relevant_exprs.size();
             s.m_trail_lim              = m_trail.size();
+            if (m_stamp == UINT_MAX)
+                reset_stamps();
+            m_scope_stamps.push_back(++m_stamp);
+        }
+
+        /**
+           \brief renumber the stamps of the open scopes and the marks of the
+           relevant expressions when the stamps are exhausted.
+        */
+        void reset_stamps() {
+            m_marks.reset();
+            for (unsigned lvl = 0; lvl < m_scope_stamps.size(); ++lvl)
+                m_scope_stamps[lvl] = lvl;
+            m_stamp = m_scope_stamps.size() - 1;
+            unsigned lvl = 0;
+            for (unsigned i = 0; i < m_relevant_exprs.size(); ++i) {
+                while (lvl < m_scope_stamps.size() - 1 && m_scopes[lvl].m_relevant_exprs_lim <= i)
+                    ++lvl;
+                unsigned id = m_relevant_exprs.get(i)->get_id();
+                m_marks.reserve(id + 1);
+                m_marks[id] = mark(lvl, lvl);
+            }
         }
 
         void pop(unsigned num_scopes) override {
@@ -264,20 +304,15 @@ namespace smt {
             unmark_relevant_exprs(s.m_relevant_exprs_lim);
             undo_trail(s.m_trail_lim);
             m_scopes.shrink(new_lvl);
+            m_scope_stamps.shrink(new_lvl + 1);
         }
 
         /**
-           \brief Unmark expressions marked as relevant.
+           \brief Remove the expressions marked as relevant in popped scopes.
+           Their marks are stale since the stamps of the popped scopes are not reused.
         */
         void unmark_relevant_exprs(unsigned old_lim) {
             SASSERT(old_lim <= m_relevant_exprs.size());
-            unsigned i = m_relevant_exprs.size();
-            while (i != old_lim) {
-                --i;
-                expr * n = m_relevant_exprs.get(i);
-                m_is_relevant.remove(n->get_id());
-                TRACE("propagate_relevancy", tout << "unmarking:\n" << mk_ismt2_pp(n, get_manager()) << "\n";);
-            }
             m_relevant_exprs.shrink(old_lim);
             m_qhead = m_relevant_exprs.size();
         }
@@ -303,7 +338,10 @@ namespace smt {
         }
 
         void set_relevant(expr * n) {
-            m_is_relevant.insert(n->get_id());
+            unsigned id  = n->get_id();
+            unsigned lvl = m_scope_stamps.size() - 1;
+            m_marks.reserve(id + 1);
+            m_marks[id] = mark(lvl, m_scope_stamps[lvl]);
             m_relevant_exprs.push_back(n);
             m_context.relevant_eh(n);
         }
@@ -63,10 +63,17 @@ namespace {
         cuber*               m_cuber;
         symbol               m_logic;
         bool                 m_minimizing_core;
+        bool                 m_core_minimize;
+        expr_ref_vector      m_core;               // core of the last check, valid until the next check
+        bool                 m_core_valid;
         bool                 m_core_extend_patterns;
         unsigned             m_core_extend_patterns_max_distance;
         bool                 m_core_extend_nonlocal_patterns;
         obj_map<expr, expr*> m_name2assertion;
+        obj_hashtable<expr>  m_asserted;           // live assertions, re-assertions are skipped
+        expr_ref_vector      m_asserted_trail;
+        unsigned_vector      m_asserted_lim;
+        unsigned             m_num_duplicates;
 
     public:
         smt_solver(ast_manager & m, params_ref const & p, symbol const & l) :
@@ -75,9 +82,14 @@ namespace {
             m_context(m, m_smt_params),
             m_cuber(nullptr),
             m_minimizing_core(false),
+            m_core_minimize(false),
+            m_core(m),
+            m_core_valid(false),
             m_core_extend_patterns(false),
             m_core_extend_patterns_max_distance(UINT_MAX),
-            m_core_extend_nonlocal_patterns(false) {            
+            m_core_extend_nonlocal_patterns(false),
+            m_asserted_trail(m),
+            m_num_duplicates(0) {            
             m_logic = l;
             if (m_logic != symbol::null)
                 m_context.set_logic(m_logic);
@@ -115,6 +127,8 @@ namespace {
             m_smt_params.updt_params(solver::get_params());
             m_context.updt_params(solver::get_params());
             smt_params_helper smth(solver::get_params());
+            m_core_minimize = smth.core_minimize();
+            m_core_valid = false;
             m_core_extend_patterns = smth.core_extend_patterns();
             m_core_extend_patterns_max_distance = smth.core_extend_patterns_max_distance();
             m_core_extend_nonlocal_patterns = smth.core_extend_nonlocal_patterns();
@@ -144,10 +158,13 @@ namespace {
 
         void collect_statistics(statistics & st) const override {
             m_context.collect_statistics(st);
+            if (m_num_duplicates > 0)
+                st.update("solver duplicate assertions", m_num_duplicates);
         }
 
         lbool get_consequences_core(expr_ref_vector const& assumptions, expr_ref_vector const& vars, expr_ref_vector& conseq) override {
             expr_ref_vector unfixed(m_context.m());
+            m_core_valid = false;
             return m_context.get_consequences(assumptions, vars, conseq, unfixed);
         }
 
@@ -156,6 +173,12 @@ namespace {
         }
 
         void assert_expr_core(expr * t) override {
+            if (m_asserted.contains(t)) {
+                ++m_num_duplicates;
+                return;
+            }
+            m_asserted.insert(t);
+            m_asserted_trail.push_back(t);
             m_context.assert_expr(t);
         }
         void set_phase(expr* e) override { m_context.set_phase(e); }
@@ -174,6 +197,7 @@ namespace {
         }
 
         void push_core() override {
+            m_asserted_lim.push_back(m_asserted_trail.size());
             m_context.push();
         }
 
@@ -192,16 +216,26 @@ namespace {
                     m.dec_ref(key);
                 }
             }
+            if (n > 0) {
+                unsigned old_sz = m_asserted_lim[m_asserted_lim.size() - n];
+                for (unsigned i = old_sz; i < m_asserted_trail.size(); ++i)
+                    m_asserted.remove(m_asserted_trail.get(i));
+                m_asserted_trail.shrink(old_sz);
+                m_asserted_lim.shrink(m_asserted_lim.size() - n);
+            }
+            m_core_valid = false;
             m_context.pop(n);
         }
 
         lbool check_sat_core2(unsigned num_assumptions, expr * const * assumptions) override {
             TRACE("solver_na2as", tout << "smt_solver::check_sat_core: " << num_assumptions << "\n";);
+            m_core_valid = false;
             return m_context.check(num_assumptions, assumptions);
         }
 
 
         lbool check_sat_cc_core(expr_ref_vector const& cube, vector<expr_ref_vector> const& clauses) override {
+            m_core_valid = false;
             return m_context.check(cube, clauses);
         }
 
@@ -237,6 +271,10 @@ namespace {
             m_context.user_propagate_register_diseq(diseq_eh);
         }
 
+        void user_propagate_register_batch(solver::batch_eh_t& batch_eh) override {
+            m_context.user_propagate_register_batch(batch_eh);
+        }
+
         unsigned user_propagate_register(expr* e) override { 
             return m_context.user_propagate_register(e);
         }
@@ -256,12 +294,17 @@ namespace {
         };
 
         void get_unsat_core(expr_ref_vector & r) override {
+            // the core is minimized and extended once per check.
+            if (m_core_valid && !m_minimizing_core) {
+                r.append(m_core);
+                return;
+            }
             unsigned sz = m_context.get_unsat_core_size();
             for (unsigned i = 0; i < sz; i++) {
                 r.push_back(m_context.get_unsat_core_expr(i));
             }
 
-            if (!m_minimizing_core && smt_params_helper(get_params()).core_minimize()) {
+            if (!m_minimizing_core && m_core_minimize) {
                 scoped_minimize_core scm(*this);
                 mus mus(*this);
                 mus.add_soft(r.size(), r.data());
@@ -276,6 +319,12 @@ namespace {
                 add_pattern_literals_to_core(r);
             if (m_core_extend_nonlocal_patterns)
                 add_nonlocal_pattern_literals_to_core(r);
+
+            if (!m_minimizing_core) {
+                m_core.reset();
+                m_core.append(r);
+                m_core_valid = true;
+            }
         }
 
         void get_model_core(model_ref & m) override {
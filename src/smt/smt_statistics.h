@@ -41,6 +41,9 @@ namespace smt {
         unsigned m_num_mk_lits;
         unsigned m_num_dyn_ack;
         unsigned m_num_del_dyn_ack;
+        unsigned m_num_dyn_ack_used;
+        unsigned m_num_dyn_ack_useful;
+        unsigned m_num_dyn_ack_evicted;
         unsigned m_num_interface_eqs;
         unsigned m_max_generation;
         unsigned m_num_minimized_lits;
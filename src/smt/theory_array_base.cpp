@@ -140,10 +140,10 @@ namespace smt {
         SASSERT(store->get_num_args() == 1 + select->get_num_args());
                 
         ptr_buffer<expr> sel1_args, sel2_args;
-        enode *         a  = store->get_arg(0);
         enode * const * is = select->get_args() + 1;
         enode * const * js = store->get_args() + 1;
         unsigned num_args = select->get_num_args() - 1;
+        enode *         a  = skip_stores(store->get_arg(0), num_args, is);
         sel1_args.push_back(store->get_expr());
         sel2_args.push_back(a->get_expr());
 
@@ -198,6 +198,31 @@ namespace smt {
         }
     }
     
+    /**
+       \brief Return the array below the chain of stores starting at a whose indices
+       are values distinct from the indices is, so that select(a, is) = select(r, is)
+       is valid for the result r. Memory models with concrete addresses otherwise
+       create a select term and an axiom for every store of the chain.
+       Only stores that are used by stores alone are skipped, since the selects
+       on them are not created.
+    */
+    enode * theory_array_base::skip_stores(enode * a, unsigned num_args, enode * const * is) {
+        if (!ctx.get_fparams().m_array_skip_stores)
+            return a;
+        while (is_store(a) && a->get_root() == a && a->get_class_size() == 1) {
+            bool distinct = false;
+            for (unsigned i = 0; !distinct && i < num_args; ++i)
+                distinct = m.are_distinct(a->get_arg(i + 1)->get_expr(), is[i]->get_expr());
+            if (!distinct)
+                break;
+            for (enode * p : a->get_parents())
+                if (!is_store(p) || p->get_arg(0) != a)
+                    return a;
+            a = a->get_arg(0);
+        }
+        return a;
+    }
+
     bool theory_array_base::assert_store_axiom2(enode * store, enode * select) { 
         unsigned num_args = select->get_num_args();
         unsigned        i = 1;
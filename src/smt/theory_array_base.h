@@ -82,6 +82,7 @@ namespace smt {
         void assert_store_axiom2_core(enode * store, enode * select);
         void assert_store_axiom1(enode * n) { m_axiom1_todo.push_back(n); }
         bool assert_store_axiom2(enode * store, enode * select);
+        enode * skip_stores(enode * a, unsigned num_args, enode * const * is);
 
         void assert_extensionality_core(enode * a1, enode * a2);
         bool assert_extensionality(enode * a1, enode * a2);
@@ -336,6 +336,51 @@ namespace smt {
         find_wpos(v);
     }
 
+    /**
+       \brief Multiplications and divisions produce large circuits. Their bits are cached,
+       such that a term that is internalized again after a pop reuses the circuit.
+       The bits of the arguments are bit2bool atoms or circuits over them, so the
+       cached bits remain valid when the arguments are internalized again.
+    */
+    bool theory_bv::is_blast_cached(app * n) const {
+        switch (n->get_decl_kind()) {
+        case OP_BMUL:
+        case OP_BUDIV:
+        case OP_BUDIV_I:
+        case OP_BSDIV:
+        case OP_BSDIV_I:
+        case OP_BUREM:
+        case OP_BUREM_I:
+        case OP_BSREM:
+        case OP_BSREM_I:
+        case OP_BSMOD:
+        case OP_BSMOD_I:
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    bool theory_bv::find_blasted(app * n, expr_ref_vector & bits) {
+        unsigned offset;
+        if (!m_blast2offset.find(n, offset))
+            return false;
+        unsigned sz = get_bv_size(n);
+        for (unsigned i = 0; i < sz; ++i)
+            bits.push_back(m_blast_bits.get(offset + i));
+        m_stats.m_num_blast_reused++;
+        return true;
+    }
+
+    void theory_bv::insert_blasted(app * n, expr_ref_vector const & bits) {
+        if (!is_blast_cached(n))
+            return;
+        SASSERT(bits.size() == get_bv_size(n));
+        m_blast2offset.insert(n, m_blast_bits.size());
+        m_blast_terms.push_back(n);
+        m_blast_bits.append(bits);
+    }
+
     /**
        \brief Find an unassigned bit for m_wpos[v], if such bit cannot be found invoke fixed_var_eh
     */
@@ -750,10 +795,13 @@ namespace smt {
         process_args(n);                                                                \
         enode * e       = mk_enode(n);                                                  \
         expr_ref_vector arg1_bits(m), arg2_bits(m), bits(m);                            \
-        get_arg_bits(e, 0, arg1_bits);                                                  \
-        get_arg_bits(e, 1, arg2_bits);                                                  \
-        SASSERT(arg1_bits.size() == arg2_bits.size());                                  \
-        m_bb.BLAST_OP(arg1_bits.size(), arg1_bits.data(), arg2_bits.data(), bits);    \
+        if (!find_blasted(n, bits)) {                                                   \
+            get_arg_bits(e, 0, arg1_bits);                                              \
+            get_arg_bits(e, 1, arg2_bits);                                              \
+            SASSERT(arg1_bits.size() == arg2_bits.size());                              \
+            m_bb.BLAST_OP(arg1_bits.size(), arg1_bits.data(), arg2_bits.data(), bits); \
+            insert_blasted(n, bits);                                                    \
+        }                                                                               \
         init_bits(e, bits);                                                             \
     }
 
@@ -767,17 +815,20 @@ namespace smt {
         expr_ref_vector arg_bits(m);                                                            \
         expr_ref_vector bits(m);                                                                \
         expr_ref_vector new_bits(m);                                                            \
-        unsigned i = n->get_num_args();                                                         \
-        --i;                                                                                    \
-        get_arg_bits(e, i, bits);                                                               \
-        while (i > 0) {                                                                         \
+        if (!find_blasted(n, bits)) {                                                           \
+            unsigned i = n->get_num_args();                                                     \
             --i;                                                                                \
-            arg_bits.reset();                                                                   \
-            get_arg_bits(e, i, arg_bits);                                                       \
-            SASSERT(arg_bits.size() == bits.size());                                            \
-            new_bits.reset();                                                                   \
-            m_bb.BLAST_OP(arg_bits.size(), arg_bits.data(), bits.data(), new_bits);           \
-            bits.swap(new_bits);                                                                \
+            get_arg_bits(e, i, bits);                                                           \
+            while (i > 0) {                                                                     \
+                --i;                                                                            \
+                arg_bits.reset();                                                               \
+                get_arg_bits(e, i, arg_bits);                                                   \
+                SASSERT(arg_bits.size() == bits.size());                                        \
+                new_bits.reset();                                                               \
+                m_bb.BLAST_OP(arg_bits.size(), arg_bits.data(), bits.data(), new_bits);       \
+                bits.swap(new_bits);                                                            \
+            }                                                                                   \
+            insert_blasted(n, bits);                                                            \
         }                                                                                       \
         init_bits(e, bits);                                                                     \
         TRACE("bv_verbose", tout << arg_bits << " " << bits << " " << new_bits << "\n";); \
@@ -1457,6 +1508,8 @@ namespace smt {
         m_bb(ctx.get_manager(), ctx.get_fparams()),
         m_trail_stack(),
         m_find(*this),
+        m_blast_terms(ctx.get_manager()),
+        m_blast_bits(ctx.get_manager()),
         m_approximates_large_bvs(false) {
         memset(m_eq_activity, 0, sizeof(m_eq_activity));
         memset(m_diseq_activity, 0, sizeof(m_diseq_activity));
@@ -1466,7 +1519,13 @@ namespace smt {
     }
 
     theory* theory_bv::mk_fresh(context* new_ctx) {
-        return alloc(theory_bv, *new_ctx);
+        theory_bv* th = alloc(theory_bv, *new_ctx);
+        if (&new_ctx->get_manager() == &m) {
+            th->m_blast2offset = m_blast2offset;
+            th->m_blast_terms.append(m_blast_terms);
+            th->m_blast_bits.append(m_blast_bits);
+        }
+        return th;
     }
 
     
@@ -1803,6 +1862,7 @@ namespace smt {
         st.update("bv bit2core", m_stats.m_num_bit2core);
         st.update("bv->core eq", m_stats.m_num_th2core_eq);
         st.update("bv dynamic eqs", m_stats.m_num_eq_dynamic);
+        st.update("bv blast reused", m_stats.m_num_blast_reused);
     }
 
     bool theory_bv::check_assignment(theory_var v) {
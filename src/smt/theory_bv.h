@@ -30,7 +30,7 @@ namespace smt {
     
     struct theory_bv_stats {
         unsigned   m_num_diseq_static, m_num_diseq_dynamic, m_num_bit2core, m_num_th2core_eq, m_num_conflicts;
-        unsigned   m_num_eq_dynamic;
+        unsigned   m_num_eq_dynamic, m_num_blast_reused;
         void reset() { memset(this, 0, sizeof(theory_bv_stats)); }
         theory_bv_stats() { reset(); }
     };
@@ -114,6 +114,11 @@ namespace smt {
         svector<unsigned>        m_wpos;     // per var, watch position for fixed variable detection. 
         vector<zero_one_bits>    m_zero_one_bits; // per var, see comment in the struct zero_one_bit
         bool_var2atom            m_bool_var2atom;
+        // Bits of multiplications and divisions. They are kept across pops, such that
+        // a term that is internalized again is not bit-blasted again.
+        obj_map<app, unsigned>   m_blast2offset;
+        app_ref_vector           m_blast_terms;
+        expr_ref_vector          m_blast_bits;
         typedef svector<theory_var> vars;
 
         typedef std::pair<numeral, unsigned> value_sort_pair;
@@ -174,6 +179,9 @@ namespace smt {
         void find_new_diseq_axioms(var_pos_occ * occs, theory_var v, unsigned idx);
         void add_bit(theory_var v, literal l);
         void init_bits(enode * n, expr_ref_vector const & bits);
+        bool is_blast_cached(app * n) const;
+        bool find_blasted(app * n, expr_ref_vector & bits);
+        void insert_blasted(app * n, expr_ref_vector const & bits);
         void find_wpos(theory_var v);
         friend class fixed_eq_justification;
         void fixed_var_eh(theory_var v);
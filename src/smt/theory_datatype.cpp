@@ -480,14 +480,10 @@ namespace smt {
         int num_vars = get_num_vars();
         final_check_status r = FC_DONE;
         final_check_st _guard(this); 
+        if (occurs_check_merged())
+            return FC_CONTINUE;
         for (int v = 0; v < num_vars; v++) {
             if (v == static_cast<int>(m_find.find(v))) {
-                enode * node = get_enode(v);
-                if (m_util.is_recursive(node->get_sort()) && !oc_cycle_free(node) && occurs_check(node)) {
-                    // conflict was detected... 
-                    // return...
-                    return FC_CONTINUE;
-                }
                 if (params().m_dt_lazy_splits > 0) {
                     // using lazy case splits...
                     var_data * d = m_var_data[v];
@@ -502,6 +498,37 @@ namespace smt {
         return r;
     }
 
+    /**
+       \brief Run the occurs check on the classes merged since the last check.
+       Internalizing a term cannot close a cycle, and backtracking only removes
+       edges, so a new cycle passes through a class merged since then.
+       Arrays of datatypes add edges on merges of arrays, so with nested arrays
+       all classes are checked.
+    */
+    bool theory_datatype::occurs_check_merged() {
+        if (m_util.has_nested_arrays()) {
+            int num_vars = get_num_vars();
+            for (int v = 0; v < num_vars; v++) {
+                if (v == static_cast<int>(m_find.find(v))) {
+                    enode * node = get_enode(v);
+                    if (m_util.is_recursive(node->get_sort()) && !oc_cycle_free(node) && occurs_check(node))
+                        return true;
+                }
+            }
+            return false;
+        }
+        for (unsigned i = m_oc_head; i < m_oc_todo.size(); ++i) {
+            enode * node = m_oc_todo[i]->get_root();
+            if (!oc_cycle_free(node) && occurs_check(node))
+                return true;
+        }
+        if (m_oc_head < m_oc_todo.size()) {
+            m_trail_stack.push(value_trail<unsigned>(m_oc_head));
+            m_oc_head = m_oc_todo.size();
+        }
+        return false;
+    }
+
     // Assuming `app` is equal to a constructor term, return the constructor enode
     inline enode * theory_datatype::oc_get_cstor(enode * app) {
         theory_var v = app->get_root()->get_th_var(get_id());
@@ -677,6 +704,8 @@ namespace smt {
         
     void theory_datatype::reset_eh() {
         m_trail_stack.reset();
+        m_oc_todo.reset();
+        m_oc_head = 0;
         std::for_each(m_var_data.begin(), m_var_data.end(), delete_proc<var_data>());
         m_var_data.reset();
         theory::reset_eh();
@@ -794,6 +823,10 @@ namespace smt {
         SASSERT(v1 == static_cast<int>(m_find.find(v1)));
         var_data * d1 = m_var_data[v1];
         var_data * d2 = m_var_data[v2];
+        if (m_util.is_recursive(get_enode(v1)->get_sort())) {
+            m_oc_todo.push_back(get_enode(v1));
+            m_trail_stack.push(push_back_vector<ptr_vector<enode>>(m_oc_todo));
+        }
         if (d2->m_constructor != nullptr) {
             if (d1->m_constructor != nullptr && d1->m_constructor->get_decl() != d2->m_constructor->get_decl()) {
                 region & r    = ctx.get_region();
@@ -79,6 +79,8 @@ namespace smt {
         enode_pair_vector     m_used_eqs; // conflict, if any
         parent_tbl            m_parent; // parent explanation for occurs_check
         svector<stack_entry>  m_stack; // stack for DFS for occurs_check
+        ptr_vector<enode>     m_oc_todo; // merged classes of recursive sort, a cycle must pass through one of them
+        unsigned              m_oc_head = 0; // classes before m_oc_head passed the occurs check
         literal_vector        m_lits;
 
         void clear_mark();
@@ -103,6 +105,7 @@ namespace smt {
 
         enode * oc_get_cstor(enode * n);
         bool occurs_check(enode * n);
+        bool occurs_check_merged();
         bool occurs_check_enter(enode * n);
         void occurs_check_explain(enode * top, enode * root);
         void explain_is_child(enode* parent, enode* child);
@@ -47,6 +47,7 @@ namespace smt {
         unsigned   m_num_conflicts;
         unsigned   m_num_assertions;
         unsigned   m_num_th2core_eqs;
+        unsigned   m_num_th2core_props;
 
         unsigned   m_num_core2th_eqs;
         unsigned   m_num_core2th_diseqs;
@@ -155,6 +156,28 @@ namespace smt {
             }
         };
 
+        // Justification for an atom whose edge is implied by a path through an asserted edge.
+        // The path is computed when the antecedents are needed.
+        class implied_bound_justification : public justification {
+            theory_diff_logic& m_theory;
+            edge_id            m_bridge_edge;
+            edge_id            m_subsumed_edge;
+        public:
+            implied_bound_justification(theory_diff_logic& th, edge_id bridge_edge, edge_id subsumed_edge):
+                m_theory(th), m_bridge_edge(bridge_edge), m_subsumed_edge(subsumed_edge) {}
+
+            void get_antecedents(conflict_resolution & cr) override {
+                m_theory.get_implied_bound_antecedents(m_bridge_edge, m_subsumed_edge, cr);
+            }
+
+            // implied atoms are only propagated when proofs are disabled.
+            proof * mk_proof(conflict_resolution & cr) override { UNREACHABLE(); return nullptr; }
+
+            theory_id get_from_theory() const override { return m_theory.get_id(); }
+
+            char const * get_name() const override { return "dl-implied-bound"; }
+        };
+
         struct scope {
             unsigned      m_atoms_lim;
             unsigned      m_asserted_atoms_lim;
@@ -193,6 +216,7 @@ namespace smt {
         arith_factory *                m_factory;
         rational                       m_delta;
         nc_functor                     m_nc_functor;   
+        svector<edge_id>               m_subsumed;     // edges implied by the last asserted edge
 
         // For optimization purpose
         typedef vector <std::pair<theory_var, rational> > objective_term;
@@ -276,6 +300,10 @@ namespace smt {
         }
     
         bool can_propagate() override {
+            return !m_params.m_arith_dl_lazy && has_unpropagated_atoms();
+        }
+
+        bool has_unpropagated_atoms() const {
             return m_asserted_qhead != m_asserted_atoms.size();
         }
         
@@ -360,6 +388,8 @@ namespace smt {
 
         void get_implied_bound_antecedents(edge_id bridge_edge, edge_id subsumed_edge, conflict_resolution & cr);
 
+        void propagate_implied_atoms(edge_id bridge_edge);
+
         void init_zero();
 
         theory_var get_zero(bool is_int) { return is_int ? m_izero : m_rzero; }
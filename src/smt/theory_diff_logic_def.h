@@ -327,6 +327,7 @@ template<typename Ext>
 void theory_diff_logic<Ext>::collect_statistics(::statistics & st) const {
     st.update("dl conflicts", m_stats.m_num_conflicts);
     st.update("dl asserts", m_stats.m_num_assertions);
+    st.update("dl propagations", m_stats.m_num_th2core_props);
     st.update("core->dl eqs", m_stats.m_num_core2th_eqs);
     st.update("core->dl diseqs", m_stats.m_num_core2th_diseqs);
     m_arith_eq_adapter.collect_statistics(st);
@@ -370,7 +371,7 @@ void theory_diff_logic<Ext>::pop_scope_eh(unsigned num_scopes) {
 template<typename Ext>
 final_check_status theory_diff_logic<Ext>::final_check_eh() {
 
-    if (can_propagate()) {
+    if (has_unpropagated_atoms()) {
         propagate_core();
         return FC_CONTINUE;
     }
@@ -569,7 +570,7 @@ void theory_diff_logic<Ext>::inc_conflicts() {
 template<typename Ext>
 void theory_diff_logic<Ext>::propagate_core() {
     bool consistent = true;
-    while (consistent && can_propagate()) {
+    while (consistent && has_unpropagated_atoms()) {
         atom * a = m_asserted_atoms[m_asserted_qhead];
         m_asserted_qhead++;
         consistent = propagate_atom(a);
@@ -589,9 +590,34 @@ bool theory_diff_logic<Ext>::propagate_atom(atom* a) {
         
         return false;
     }
+    if (m_params.m_arith_dl_propagate > 0 && !m.proofs_enabled()) 
+        propagate_implied_atoms(edge_id);
     return true;
 }
 
+/**
+   \brief assign the atoms whose edges are implied by the graph after bridge_edge was enabled.
+   Mode 1 only considers edges that are implied by the bridge edge together with one 
+   adjacent edge. Mode 2 searches the relevant part of the shortest paths through the 
+   bridge edge, following Cotton and Maler. 
+ */
+template<typename Ext>
+void theory_diff_logic<Ext>::propagate_implied_atoms(edge_id bridge_edge) {
+    m_subsumed.reset();
+    if (m_params.m_arith_dl_propagate == 1) 
+        m_graph.find_subsumed2(bridge_edge, m_subsumed);
+    else
+        m_graph.find_subsumed(bridge_edge, m_subsumed);
+    for (edge_id e : m_subsumed) {
+        literal l = m_graph.get_explanation(e);
+        if (l == null_literal || ctx.get_assignment(l) != l_undef) 
+            continue;
+        TRACE("arith", tout << "implied " << l << " by edge " << bridge_edge << "\n";);
+        ++m_stats.m_num_th2core_props;
+        ctx.assign(l, ctx.mk_justification(implied_bound_justification(*this, bridge_edge, e)));
+    }
+}
+
 template<typename Ext>
 void theory_diff_logic<Ext>::new_edge(dl_var src, dl_var dst, unsigned num_edges, edge_id const* edges) {
 
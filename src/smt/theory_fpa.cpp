@@ -34,11 +34,13 @@ namespace smt {
         m_fpa_util(m_converter.fu()),
         m_bv_util(m_converter.bu()),
         m_arith_util(m_converter.au()),
-        m_is_initialized(true)
+        m_is_initialized(true),
+        m_lazy_apps(ctx.get_manager())
     {
         params_ref p;
         p.set_bool("arith_lhs", true);
         m_th_rw.updt_params(p);
+        m_converter.set_lazy(ctx.get_fparams().m_fpa_lazy);
     }
 
     theory_fpa::~theory_fpa()
@@ -224,6 +226,144 @@ namespace smt {
         literal lit(ctx.get_literal(e));
         ctx.mark_as_relevant(lit);
         ctx.mk_th_axiom(get_id(), 1, &lit);
+        if (m_converter.has_lazy())
+            collect_lazy(e);
+    }
+
+    /**
+       \brief Record the abstracted operations that occur in e.
+       The conversions are cached across scopes, so an occurrence that was
+       recorded for a constraint that has been backtracked reappears here.
+    */
+    void theory_fpa::collect_lazy(expr * e) {
+        ast_mark visited;
+        ptr_buffer<expr> todo;
+        todo.push_back(e);
+        while (!todo.empty()) {
+            expr * n = todo.back();
+            todo.pop_back();
+            if (!is_app(n) || visited.is_marked(n))
+                continue;
+            visited.mark(n, true);
+            if (m_converter.get_lazy_op(n) && !m_lazy_seen.contains(n)) {
+                m_lazy_apps.push_back(n);
+                m_trail_stack.push(push_back_vector<expr_ref_vector>(m_lazy_apps));
+                m_lazy_seen.insert(n);
+                m_trail_stack.push(insert_obj_trail<expr>(m_lazy_seen, n));
+            }
+            todo.append(to_app(n)->get_num_args(), to_app(n)->get_args());
+        }
+    }
+
+    bool theory_fpa::get_bv_value(expr * e, rational & r) {
+        if (m_bv_util.is_numeral(e, r))
+            return true;
+        if (!is_app(e) || !ctx.e_internalized(e))
+            return false;
+        theory_bv * th = dynamic_cast<theory_bv*>(ctx.get_theory(m_bv_util.get_family_id()));
+        return th && th->get_fixed_value(to_app(e), r);
+    }
+
+    bool theory_fpa::get_fp_value(expr * e, mpf & v) {
+        if (m_fpa_util.is_numeral(e, v))
+            return true;
+        if (!m_fpa_util.is_fp(e))
+            return false;
+        expr * s = to_app(e)->get_arg(0), * ex = to_app(e)->get_arg(1), * sg = to_app(e)->get_arg(2);
+        rational sv, exv, sgv;
+        if (!get_bv_value(s, sv) || !get_bv_value(ex, exv) || !get_bv_value(sg, sgv))
+            return false;
+        expr_ref sn(m_bv_util.mk_numeral(sv, 1), m);
+        expr_ref exn(m_bv_util.mk_numeral(exv, m_bv_util.get_bv_size(ex)), m);
+        expr_ref sgn(m_bv_util.mk_numeral(sgv, m_bv_util.get_bv_size(sg)), m);
+        expr_ref val(m_converter.bv2fpa_value(e->get_sort(), sn, exn, sgn), m);
+        return m_fpa_util.is_numeral(val, v);
+    }
+
+    bool theory_fpa::get_rm_value(expr * e, mpf_rounding_mode & rm) {
+        if (m_fpa_util.is_rm_numeral(e, rm))
+            return true;
+        rational bv;
+        if (!m_fpa_util.is_bv2rm(e) || !get_bv_value(to_app(e)->get_arg(0), bv))
+            return false;
+        expr_ref bn(m_bv_util.mk_numeral(bv, 3), m);
+        expr_ref val(m_converter.bv2rm_value(bn), m);
+        return m_fpa_util.is_rm_numeral(val, rm);
+    }
+
+    /**
+       \brief Check whether the current assignment gives the abstraction a
+       the value of the operation it stands for on the values of its arguments.
+    */
+    bool theory_fpa::is_lazy_consistent(app * a) {
+        func_decl * f = m_converter.get_lazy_op(a);
+        mpf_manager & mpfm = m_fpa_util.fm();
+        scoped_mpf x(mpfm), y(mpfm), z(mpfm), r(mpfm), v(mpfm);
+        mpf_rounding_mode rm;
+        rational val;
+        if (!get_bv_value(a, val))
+            return false;
+        expr_ref bn(m_bv_util.mk_numeral(val, m_bv_util.get_bv_size(a)), m);
+        expr_ref fv(m_converter.bv2fpa_value(f->get_range(), bn), m);
+        VERIFY(m_fpa_util.is_numeral(fv, v));
+        switch (f->get_decl_kind()) {
+        case OP_FPA_DIV:
+            if (!get_rm_value(a->get_arg(0), rm) || !get_fp_value(a->get_arg(1), x) || !get_fp_value(a->get_arg(2), y))
+                return false;
+            mpfm.div(rm, x, y, r);
+            break;
+        case OP_FPA_REM:
+            if (!get_fp_value(a->get_arg(0), x) || !get_fp_value(a->get_arg(1), y))
+                return false;
+            mpfm.rem(x, y, r);
+            break;
+        case OP_FPA_FMA:
+            if (!get_rm_value(a->get_arg(0), rm) || !get_fp_value(a->get_arg(1), x) ||
+                !get_fp_value(a->get_arg(2), y) || !get_fp_value(a->get_arg(3), z))
+                return false;
+            mpfm.fma(rm, x, y, z, r);
+            break;
+        case OP_FPA_SQRT:
+            if (!get_rm_value(a->get_arg(0), rm) || !get_fp_value(a->get_arg(1), x))
+                return false;
+            mpfm.sqrt(rm, x, r);
+            break;
+        default:
+            UNREACHABLE();
+            return false;
+        }
+        if (mpfm.is_nan(r) || mpfm.is_nan(v))
+            return mpfm.is_nan(r) && mpfm.is_nan(v);
+        return mpfm.eq(r, v) && mpfm.sgn(r) == mpfm.sgn(v);
+    }
+
+    bool theory_fpa::refine_lazy(app * a) {
+        expr_ref bv(m), c(m);
+        if (!m_converter.blast_lazy(a, bv))
+            return false;
+        TRACE("t_fpa", tout << "refining " << mk_ismt2_pp(a, m) << "\n";);
+        m_stats.m_num_lazy_refinements++;
+        m_lazy_refined.insert(a);
+        m_trail_stack.push(insert_obj_trail<expr>(m_lazy_refined, a));
+        c = m.mk_and(m.mk_eq(a, bv), mk_side_conditions());
+        m_th_rw(c);
+        assert_cnstr(c);
+        return true;
+    }
+
+    final_check_status theory_fpa::check_lazy() {
+        bool refined = false, giveup = false;
+        // refinements may record new abstractions
+        for (unsigned i = 0; i < m_lazy_apps.size(); ++i) {
+            app * a = to_app(m_lazy_apps.get(i));
+            if (m_lazy_refined.contains(a) || !ctx.e_internalized(a) || !ctx.is_relevant(a) || is_lazy_consistent(a))
+                continue;
+            if (refine_lazy(a))
+                refined = true;
+            else
+                giveup = true;
+        }
+        return refined ? FC_CONTINUE : giveup ? FC_GIVEUP : FC_DONE;
     }
 
     void theory_fpa::attach_new_th_var(enode * n) {
@@ -504,9 +644,15 @@ namespace smt {
     final_check_status theory_fpa::final_check_eh() {
         TRACE("t_fpa", tout << "final_check_eh\n";);
         SASSERT(m_converter.m_extra_assertions.empty());
+        if (!m_lazy_apps.empty())
+            return check_lazy();
         return FC_DONE;
     }
 
+    void theory_fpa::collect_statistics(::statistics & st) const {
+        st.update("fpa lazy refinements", m_stats.m_num_lazy_refinements);
+    }
+
     void theory_fpa::init_model(model_generator & mg) {
         TRACE("t_fpa", tout << "initializing model" << std::endl; display(tout););
         m_factory = alloc(fpa_value_factory, m, get_family_id());
@@ -79,6 +79,12 @@ namespace smt {
             app * mk_value(model_generator & mg, expr_ref_vector const & values) override;
         };
 
+        struct stats {
+            unsigned m_num_lazy_refinements;
+            void reset() { memset(this, 0, sizeof(stats)); }
+            stats() { reset(); }
+        };
+
     protected:
         th_rewriter               m_th_rw;
         fpa2bv_converter_wrapped  m_converter;
@@ -91,6 +97,10 @@ namespace smt {
         obj_map<expr, expr*>      m_conversions;
         bool                      m_is_initialized;
         obj_hashtable<func_decl>  m_is_added_to_model;
+        expr_ref_vector           m_lazy_apps;      // abstracted operations of the asserted constraints (fpa.lazy)
+        obj_hashtable<expr>       m_lazy_seen;
+        obj_hashtable<expr>       m_lazy_refined;
+        stats                     m_stats;
 
         final_check_status final_check_eh() override;
         bool internalize_atom(app * atom, bool gate_ctx) override;
@@ -116,6 +126,7 @@ namespace smt {
         ~theory_fpa() override;
 
         void display(std::ostream & out) const override;
+        void collect_statistics(::statistics & st) const override;
 
     protected:
         expr_ref mk_side_conditions();
@@ -124,6 +135,14 @@ namespace smt {
         void attach_new_th_var(enode * n);
         void assert_cnstr(expr * e);
 
+        void collect_lazy(expr * e);
+        final_check_status check_lazy();
+        bool is_lazy_consistent(app * a);
+        bool refine_lazy(app * a);
+        bool get_bv_value(expr * e, rational & r);
+        bool get_fp_value(expr * e, mpf & v);
+        bool get_rm_value(expr * e, mpf_rounding_mode & rm);
+
 
         enode* ensure_enode(expr* e);
         enode* get_root(expr* a) { return ensure_enode(a)->get_root(); }
@@ -36,6 +36,7 @@
 #include "util/scoped_timer.h"
 #include "util/nat_set.h"
 #include "ast/ast_pp.h"
+#include "ast/ast_translation.h"
 #include "model/numeral_factory.h"
 #include "smt/smt_theory.h"
 #include "smt/smt_context.h"
@@ -173,6 +174,10 @@ class theory_lra::imp {
     unsigned_vector        m_bounds_trail;
     unsigned               m_asserted_qhead;
 
+    // basis of the solver this one was copied from, keyed by translated terms.
+    expr_ref_vector         m_hint_exprs;
+    vector<lp::lar_solver::column_hint> m_hints;
+
     svector<unsigned>       m_bv_to_propagate;      // Boolean variables that can be propagated
     
     svector<std::pair<theory_var, theory_var> >       m_assume_eq_candidates; 
@@ -859,6 +864,7 @@ public:
         m_rzero_var(UINT_MAX),
         m_not_handled(nullptr),
         m_asserted_qhead(0), 
+        m_hint_exprs(m),
         m_assume_eq_head(0),
         m_num_conflicts(0),
         m_model_eqs(DEFAULT_HASHTABLE_INITIAL_CAPACITY, var_value_hash(*this), var_value_eq(*this)),
@@ -1897,26 +1903,30 @@ public:
         }
         case lp::lia_move::cut: {
             TRACE("arith", tout << "cut\n";);
-            ++m_stats.m_gomory_cuts;
-            // m_explanation implies term <= k
-            reset_evidence();
-            for (auto ev : m_explanation) {
-                set_evidence(ev.ci(), m_core, m_eqs);
-            }
-            // The call mk_bound() can set the m_infeasible_column in lar_solver
-            // so the explanation is safer to take before this call.
-            app_ref b = mk_bound(m_lia->get_term(), m_lia->get_offset(), !m_lia->is_upper());
-            if (m.has_trace_stream()) {
-                th.log_axiom_instantiation(b);
-                m.trace_stream() << "[end-of-instance]\n";
+            // a batch of gomory cuts is returned one cut at a time
+            do {
+                ++m_stats.m_gomory_cuts;
+                // m_explanation implies term <= k
+                reset_evidence();
+                for (auto ev : m_explanation) {
+                    set_evidence(ev.ci(), m_core, m_eqs);
+                }
+                // The call mk_bound() can set the m_infeasible_column in lar_solver
+                // so the explanation is safer to take before this call.
+                app_ref b = mk_bound(m_lia->get_term(), m_lia->get_offset(), !m_lia->is_upper());
+                if (m.has_trace_stream()) {
+                    th.log_axiom_instantiation(b);
+                    m.trace_stream() << "[end-of-instance]\n";
+                }
+                IF_VERBOSE(4, verbose_stream() << "cut " << b << "\n");
+                TRACE("arith", dump_cut_lemma(tout, m_lia->get_term(), m_lia->get_offset(), m_explanation, m_lia->is_upper()););
+                literal lit(ctx().get_bool_var(b), false);
+                TRACE("arith", 
+                      ctx().display_lemma_as_smt_problem(tout << "new cut:\n", m_core.size(), m_core.data(), m_eqs.size(), m_eqs.data(), lit);
+                      display(tout););
+                assign(lit, m_core, m_eqs, m_params);
             }
-            IF_VERBOSE(4, verbose_stream() << "cut " << b << "\n");
-            TRACE("arith", dump_cut_lemma(tout, m_lia->get_term(), m_lia->get_offset(), m_explanation, m_lia->is_upper()););
-            literal lit(ctx().get_bool_var(b), false);
-            TRACE("arith", 
-                  ctx().display_lemma_as_smt_problem(tout << "new cut:\n", m_core.size(), m_core.data(), m_eqs.size(), m_eqs.data(), lit);
-                  display(tout););
-            assign(lit, m_core, m_eqs, m_params);
+            while (!ctx().inconsistent() && m_lia->next_cut());
             lia_check = l_false;
             break;
         }
@@ -3079,8 +3089,43 @@ public:
         assign_eq(v, w);                    
     }
 
+    /**
+       \brief record the basis and values of src, such that simplex is warm started
+       once the terms of src are internalized in this context.
+    */
+    void copy_basis(imp const& src) {
+        if (!src.m_solver)
+            return;
+        ast_translation tr(src.m, m);
+        theory_var sz = static_cast<theory_var>(src.th.get_num_vars());
+        for (theory_var v = 0; v < sz; ++v) {
+            if (!src.is_registered_var(v))
+                continue;
+            lpvar j = src.get_lpvar(v);
+            m_hint_exprs.push_back(tr(src.th.get_enode(v)->get_expr()));
+            m_hints.push_back(lp::lar_solver::column_hint(j, src.lp().is_base(j), src.lp().get_column_value(j)));
+        }
+    }
+
+    void apply_basis_hints() {
+        vector<lp::lar_solver::column_hint> hints;
+        for (unsigned i = 0; i < m_hints.size(); ++i) {
+            expr* e = m_hint_exprs.get(i);
+            if (!ctx().e_internalized(e))
+                continue;
+            theory_var v = ctx().get_enode(e)->get_th_var(get_id());
+            if (v != null_theory_var && is_registered_var(v))
+                hints.push_back(lp::lar_solver::column_hint(get_lpvar(v), m_hints[i].m_is_basic, m_hints[i].m_value));
+        }
+        m_hint_exprs.reset();
+        m_hints.reset();
+        lp().apply_column_hints(hints);
+    }
+
     lbool make_feasible() {
         TRACE("pcs",  tout << lp().constraints(););
+        if (!m_hints.empty())
+            apply_basis_hints();
         auto status = lp().find_feasible_solution();
         TRACE("arith_verbose", display(tout););
         switch (status) {
@@ -3770,7 +3815,9 @@ theory_lra::~theory_lra() {
     dealloc(m_imp);
 }   
 theory* theory_lra::mk_fresh(context* new_ctx) {
-    return alloc(theory_lra, *new_ctx);
+    theory_lra* r = alloc(theory_lra, *new_ctx);
+    r->m_imp->copy_basis(*m_imp);
+    return r;
 }
 void theory_lra::init() {
     m_imp->init();
@@ -34,7 +34,8 @@ namespace smt {
           m_util(m_plugin.u()), 
           m_disabled_guards(m),
           m_enabled_guards(m),
-          m_preds(m) {
+          m_preds(m),
+          m_eval(m) {
         }
 
     theory_recfun::~theory_recfun() {
@@ -310,6 +311,9 @@ namespace smt {
             return;
         }
 
+        if (assert_value_axiom(e))
+            return;
+
         ++m_stats.m_case_expansions;
         TRACEFN("assert_case_axioms " << e
                 << " with " << e.m_def->get_cases().size() << " cases");
@@ -350,6 +354,23 @@ namespace smt {
         ctx.mk_th_axiom(get_id(), preds);       
     }
 
+    /**
+     * For applications to values, unfolding the case predicates is not needed:
+     * the definition is evaluated and `f(args) = value` is asserted.
+     */
+    bool theory_recfun::assert_value_axiom(recfun::case_expansion & e) {
+        expr_ref value(m);
+        if (!m_eval(e.m_lhs, value))
+            return false;
+        ++m_stats.m_evaluations;
+        TRACEFN("evaluate " << mk_pp(e.m_lhs, m) << " = " << value);
+        literal lit = mk_eq_lit(e.m_lhs, value);
+        std::function<literal(void)> fn = [&]() { return lit; };
+        scoped_trace_stream _tr(*this, fn);
+        ctx.mk_th_axiom(get_id(), 1, &lit);
+        return true;
+    }
+
     void theory_recfun::activate_guard(expr* pred_applied, expr_ref_vector const& guards) {
         literal concl = mk_literal(pred_applied);
         literal_vector lguards;
@@ -476,6 +497,7 @@ namespace smt {
         st.update("recfun macro expansion", m_stats.m_macro_expansions);
         st.update("recfun case expansion", m_stats.m_case_expansions);
         st.update("recfun body expansion", m_stats.m_body_expansions);
+        st.update("recfun evaluations", m_stats.m_evaluations);
     }
 
 }
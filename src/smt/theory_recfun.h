@@ -23,12 +23,13 @@ Revision History:
 #include "smt/smt_context.h"
 #include "ast/ast_pp.h"
 #include "ast/recfun_decl_plugin.h"
+#include "ast/rewriter/recfun_rewriter.h"
 
 namespace smt {
 
     class theory_recfun : public theory {
         struct stats {
-            unsigned m_case_expansions, m_body_expansions, m_macro_expansions;
+            unsigned m_case_expansions, m_body_expansions, m_macro_expansions, m_evaluations;
             void reset() { memset(this, 0, sizeof(stats)); }
             stats() { reset(); }
         };
@@ -45,6 +46,7 @@ namespace smt {
         expr_ref_vector          m_preds;
         unsigned_vector          m_preds_lim;
         unsigned                 m_num_rounds { 0 };
+        recfun_evaluator         m_eval;
 
         typedef recfun::propagation_item propagation_item;
 
@@ -72,6 +74,7 @@ namespace smt {
         expr_ref apply_args(unsigned depth, recfun::vars const & vars, expr_ref_vector const & args, expr * e); //!< substitute variables by args
         void assert_macro_axiom(recfun::case_expansion & e);
         void assert_case_axioms(recfun::case_expansion & e);
+        bool assert_value_axiom(recfun::case_expansion & e);
         void assert_body_axiom(recfun::body_expansion & e);
         void block_core(expr_ref_vector const& core);
         literal mk_literal(expr* e);
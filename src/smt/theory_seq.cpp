@@ -321,6 +321,7 @@ final_check_status theory_seq::final_check_eh() {
     if (!m_has_seq) {
         return FC_DONE;
     }
+    force_push();
     
     m_new_propagation = false;
     TRACE("seq", display(tout << "level: " << ctx.get_scope_level() << "\n"););
@@ -859,6 +860,24 @@ void theory_seq::enforce_length_coherence(enode* n1, enode* n2) {
     }
 }
 
+/*
+  Abstract the equation e1 = e2 to the linear equation len(e1) = len(e2).
+  The lengths of concatenations are rewritten to sums of the lengths of
+  their arguments, so the arithmetic solver can detect length conflicts
+  and fix the lengths used by the equation solver before the
+  equations are split in the final check.
+*/
+void theory_seq::propagate_length_eq(dependency* deps, expr* e1, expr* e2) {
+    if (!m_util.str.is_concat(e1) && !m_util.str.is_concat(e2))
+        return;
+    expr_ref len1 = mk_len(e1);
+    expr_ref len2 = mk_len(e2);
+    if (len1 == len2)
+        return;
+    TRACE("seq", tout << len1 << " = " << len2 << "\n";);
+    ++m_stats.m_eager_length;
+    propagate_eq(deps, len1, len2, false);
+}
 
 bool theory_seq::lift_ite(expr_ref_vector const& ls, expr_ref_vector const& rs, dependency* deps) {
     if (ls.size() != 1 || rs.size() != 1) {
@@ -1434,6 +1453,7 @@ bool theory_seq::internalize_atom(app* a, bool) {
 }
 
 bool theory_seq::internalize_term(app* term) {
+    force_push();
     m_has_seq = true;
 
     if (m_util.str.is_in_re(term)) 
@@ -1681,6 +1701,7 @@ bool theory_seq::branch_itos(expr* e) {
 
 
 void theory_seq::apply_sort_cnstr(enode* n, sort* s) {
+    force_push();
     mk_var(n);
 }
 
@@ -1850,6 +1871,7 @@ void theory_seq::collect_statistics(::statistics & st) const {
     st.update("seq fixed length", m_stats.m_fixed_length);
     st.update("seq int.to.str", m_stats.m_int_string);
     st.update("seq str.from_ubv", m_stats.m_ubv_string);
+    st.update("seq eager length", m_stats.m_eager_length);
 }
 
 void theory_seq::init_search_eh() {
@@ -1877,6 +1899,7 @@ void theory_seq::finalize_model(model_generator& mg) {
 }
 
 void theory_seq::init_model(model_generator & mg) {
+    force_push();
     m_rep.push_scope();
     m_factory = alloc(seq_factory, get_manager(), get_family_id(), mg.get_model());
     mg.register_factory(m_factory);
@@ -2377,6 +2400,7 @@ void theory_seq::validate_fmls(enode_pair_vector const& eqs, literal_vector cons
 }
 
 theory_var theory_seq::mk_var(enode* n) {
+    force_push();
     expr* o = n->get_expr();
 
     if (!m_util.is_seq(o) && !m_util.is_re(o) && !m_util.str.is_nth_u(o))
@@ -2585,6 +2609,9 @@ void theory_seq::add_dependency(dependency*& dep, enode* a, enode* b) {
 
 
 void theory_seq::propagate() {
+    if (!can_propagate())
+        return;
+    force_push();
     if (m_regex.can_propagate())
         m_regex.propagate();
     while (m_axioms_head < m_axioms.size() && !ctx.inconsistent()) {
@@ -2946,6 +2973,7 @@ bool theory_seq::propagate_eq(dependency* deps, literal_vector const& _lits, exp
 }
 
 void theory_seq::assign_eh(bool_var v, bool is_true) {
+    force_push();
     expr* e = ctx.bool_var2expr(v);
     expr* e1 = nullptr, *e2 = nullptr;
     expr_ref f(m);
@@ -3057,6 +3085,7 @@ void theory_seq::assign_eh(bool_var v, bool is_true) {
 }
 
 void theory_seq::new_eq_eh(theory_var v1, theory_var v2) {
+    force_push();
     enode* n1 = get_enode(v1);
     enode* n2 = get_enode(v2);
     expr* o1 = n1->get_expr();
@@ -3091,6 +3120,8 @@ void theory_seq::new_eq_eh(dependency* deps, enode* n1, enode* n2) {
         m_eqs.push_back(mk_eqdep(o1, o2, deps));
         solve_eqs(m_eqs.size()-1);
         enforce_length_coherence(n1, n2);
+        if (get_fparams().m_seq_eager_length)
+            propagate_length_eq(deps, o1, o2);
     }
     else if (n1 != n2 && m_util.is_re(e1)) {
         UNREACHABLE();
@@ -3098,6 +3129,7 @@ void theory_seq::new_eq_eh(dependency* deps, enode* n1, enode* n2) {
 }
 
 void theory_seq::new_diseq_eh(theory_var v1, theory_var v2) {
+    force_push();
     enode* n1 = get_enode(v1);
     enode* n2 = get_enode(v2);    
     expr_ref e1(n1->get_expr(), m);
@@ -3130,6 +3162,8 @@ void theory_seq::new_diseq_eh(theory_var v1, theory_var v2) {
 }
 
 void theory_seq::push_scope_eh() {
+    if (lazy_push())
+        return;
     theory::push_scope_eh();
     m_rep.push_scope();
     m_exclude.push_scope();
@@ -3144,27 +3178,33 @@ void theory_seq::push_scope_eh() {
 }
 
 void theory_seq::pop_scope_eh(unsigned num_scopes) {
-    m_trail_stack.pop_scope(num_scopes);
-    theory::pop_scope_eh(num_scopes);
-    m_dm.pop_scope(num_scopes);
-    m_rep.pop_scope(num_scopes);
-    m_exclude.pop_scope(num_scopes);
-    m_eqs.pop_scope(num_scopes);
-    m_nqs.pop_scope(num_scopes);
-    m_ncs.pop_scope(num_scopes);
-    m_lts.pop_scope(num_scopes);
-    m_regex.pop_scope(num_scopes);
-    m_rewrite.reset();    
-    if (ctx.get_base_level() > ctx.get_scope_level() - num_scopes) {
+    // the context levels refer to all popped scopes, including the lazy ones.
+    unsigned num_ctx_scopes = num_scopes;
+    bool below_base = ctx.get_base_level() > ctx.get_scope_level() - num_scopes;
+    if (!lazy_pop(num_scopes)) {
+        m_trail_stack.pop_scope(num_scopes);
+        theory::pop_scope_eh(num_scopes);
+        m_dm.pop_scope(num_scopes);
+        m_rep.pop_scope(num_scopes);
+        m_exclude.pop_scope(num_scopes);
+        m_eqs.pop_scope(num_scopes);
+        m_nqs.pop_scope(num_scopes);
+        m_ncs.pop_scope(num_scopes);
+        m_lts.pop_scope(num_scopes);
+        m_regex.pop_scope(num_scopes);
+        m_rewrite.reset();    
+    }
+    if (below_base) {
         m_replay.reset();
     }
-    m_offset_eq.pop_scope_eh(num_scopes);
+    m_offset_eq.pop_scope_eh(num_ctx_scopes);
 }
 
 void theory_seq::restart_eh() {
 }
 
 void theory_seq::relevant_eh(app* n) {
+    force_push();
     if (m_util.str.is_index(n)   ||
         m_util.str.is_replace(n) ||
         m_util.str.is_extract(n) ||
@@ -3219,6 +3259,7 @@ void theory_seq::add_unhandled_expr(expr* n) {
 
 void theory_seq::add_theory_assumptions(expr_ref_vector & assumptions) {
     if (m_has_seq) {
+        force_push();
         TRACE("seq", tout << "add_theory_assumption\n";);
         expr_ref dlimit = m_sk.mk_max_unfolding_depth(m_max_unfolding_depth);
         m_trail_stack.push(value_trail<literal>(m_max_unfolding_lit));
@@ -3235,6 +3276,7 @@ bool theory_seq::should_research(expr_ref_vector & unsat_core) {
     TRACE("seq", tout << unsat_core << " " << m_util.has_re() << "\n";);
     if (!m_has_seq) 
         return false;
+    force_push();
     unsigned k_min = UINT_MAX, k = 0, n = 0;
     expr* s_min = nullptr, *s = nullptr;
     bool has_max_unfolding = false;
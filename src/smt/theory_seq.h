@@ -324,6 +324,7 @@ namespace smt {
             unsigned m_propagate_contains;
             unsigned m_int_string;
             unsigned m_ubv_string;
+            unsigned m_eager_length;
         };
         typedef hashtable<rational, rational::hash_proc, rational::eq_proc> rational_set;
 
@@ -563,6 +564,7 @@ namespace smt {
         bool add_length_to_eqc(expr* n);
         bool enforce_length(expr_ref_vector const& es, vector<rational>& len);
         void enforce_length_coherence(enode* n1, enode* n2);
+        void propagate_length_eq(dependency* deps, expr* e1, expr* e2);
 
         void add_length_limit(expr* s, unsigned k, bool is_searching);
 
@@ -58,6 +58,8 @@ namespace smt {
         m_scopes.shrink(new_lvl);
         m_graph.pop(num_scopes);        
         m_ufctx.get_trail_stack().pop_scope(num_scopes);
+        m_po_atoms_checked = std::min(m_po_atoms_checked, m_asserted_atoms.size());
+        m_po_edges_checked = std::min(m_po_edges_checked, m_graph.get_num_enabled_edges());
     }
 
     void theory_special_relations::relation::ensure_var(theory_var v) {
@@ -579,23 +581,50 @@ namespace smt {
         return l_true;
     }
 
+    /**
+       \brief check that no asserted v1 !-> v2 within a connected component 
+       has a path from v1 to v2.
+
+       Atoms that were checked before without enabling new edges since are 
+       skipped. The remaining atoms are grouped by v1 and the nodes reachable 
+       from v1 are computed once per group, so that the shortest path search 
+       is only used when there is a path.
+     */
     lbool theory_special_relations::final_check_po(relation& r) {
-        for (atom* ap : r.m_asserted_atoms) {
+        unsigned num_edges = r.m_graph.get_num_enabled_edges();
+        unsigned start = num_edges == r.m_po_edges_checked ? r.m_po_atoms_checked : 0;
+        ptr_vector<atom> todo;
+        for (unsigned i = start; i < r.m_asserted_atoms.size(); ++i) {
+            atom* a = r.m_asserted_atoms[i];
+            if (!a->phase() && r.m_uf.find(a->v1()) == r.m_uf.find(a->v2())) 
+                todo.push_back(a);
+        }
+        std::stable_sort(todo.begin(), todo.end(), [](atom* a, atom* b) { return a->v1() < b->v1(); });
+        uint_set reach, empty;
+        theory_var src = null_theory_var;
+        for (atom* ap : todo) {
             atom& a = *ap;
-            if (!a.phase() && r.m_uf.find(a.v1()) == r.m_uf.find(a.v2())) {
-                // v1 !-> v2
-                // find v1 -> v3 -> v4 -> v2 path
-                r.m_explanation.reset();
-                unsigned timestamp = r.m_graph.get_timestamp();
-                bool found_path = r.m_graph.find_shortest_reachable_path(a.v1(), a.v2(), timestamp, r);
-                if (found_path) {
-                    TRACE("special_relations", tout << "check po conflict\n";);
-                    r.m_explanation.push_back(a.explanation());
-                    set_conflict(r);
-                    return l_false;
-                }
+            if (a.v1() != src) {
+                theory_var w;
+                src = a.v1();
+                r.m_graph.reachable(src, empty, reach, w);
+            }
+            if (!reach.contains(a.v2()))
+                continue;
+            // v1 !-> v2
+            // find v1 -> v3 -> v4 -> v2 path
+            r.m_explanation.reset();
+            unsigned timestamp = r.m_graph.get_timestamp();
+            bool found_path = r.m_graph.find_shortest_reachable_path(a.v1(), a.v2(), timestamp, r);
+            if (found_path) {
+                TRACE("special_relations", tout << "check po conflict\n";);
+                r.m_explanation.push_back(a.explanation());
+                set_conflict(r);
+                return l_false;
             }
         }
+        r.m_po_atoms_checked = r.m_asserted_atoms.size();
+        r.m_po_edges_checked = num_edges;
         return l_true;
     }
 
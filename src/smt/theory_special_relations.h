@@ -102,8 +102,15 @@ namespace smt {
             union_find_default_ctx m_ufctx;
             union_find_t           m_uf;
             literal_vector         m_explanation;
-
-            relation(sr_property p, func_decl* d, ast_manager& m): m(m), m_next(m), m_property(p), m_decl(d), m_asserted_qhead(0), m_uf(m_ufctx) {}
+            // final_check_po verified the first m_po_atoms_checked asserted atoms
+            // when the graph had m_po_edges_checked enabled edges.
+            // Backtracking only removes edges, so the verified atoms stay valid
+            // as long as no new edge is enabled.
+            unsigned               m_po_atoms_checked;
+            unsigned               m_po_edges_checked;
+
+            relation(sr_property p, func_decl* d, ast_manager& m): m(m), m_next(m), m_property(p), m_decl(d), m_asserted_qhead(0), m_uf(m_ufctx), 
+                m_po_atoms_checked(0), m_po_edges_checked(0) {}
 
             func_decl* decl() { return m_decl; }
 
@@ -198,6 +198,13 @@ namespace smt {
         st.update("str refine negated equation", m_stats.m_refine_neq);
         st.update("str refine function", m_stats.m_refine_f);
         st.update("str refine negated function", m_stats.m_refine_nf);
+        st.update("str final checks", m_stats.m_final_checks);
+        st.update("str time eqc check", m_fc_watches.m_eqc.get_seconds());
+        st.update("str time dependence analysis", m_fc_watches.m_dep_analysis.get_seconds());
+        st.update("str time backpropagation", m_fc_watches.m_backpropagation.get_seconds());
+        st.update("str time length propagation", m_fc_watches.m_length.get_seconds());
+        st.update("str time regex", m_fc_watches.m_regex.get_seconds());
+        st.update("str time model construction", m_fc_watches.m_model.get_seconds());
     }
 
     void theory_str::assert_axiom(expr * _e) {
@@ -8229,19 +8236,17 @@ namespace smt {
 
         TRACE("str", tout << "final check" << std::endl;);
         TRACE_CODE(if (is_trace_enabled("t_str_dump_assign")) { dump_assignments(); });
+        m_stats.m_final_checks++;
         check_variable_scope();
 
         if (opt_DeferEQCConsistencyCheck) {
             TRACE("str", tout << "performing deferred EQC consistency check" << std::endl;);
-            std::set<enode*> eqc_roots;
-            for (auto const &e : ctx.enodes()) {
-                enode * root = e->get_root();
-                eqc_roots.insert(root);
-            }
-
+            scoped_watch _sw(m_fc_watches.m_eqc);
             bool found_inconsistency = false;
 
-            for (auto const &e : eqc_roots) {
+            for (enode * e : ctx.enodes()) {
+                if (!e->is_root())
+                    continue;
                 app * a = e->get_expr();
                 if (!(a->get_sort() == u.str.mk_string_sort())) {
                     TRACE("str", tout << "EQC root " << mk_pp(a, m) << " not a string term; skipping" << std::endl;);
@@ -8285,7 +8290,11 @@ namespace smt {
         std::map<expr*, int> varAppearInAssign;
         std::map<expr*, int> freeVar_map;
         std::map<expr*, std::map<expr*, int> > var_eq_concat_map;
-        int conflictInDep = ctx_dep_analysis(varAppearInAssign, freeVar_map, var_eq_concat_map);
+        int conflictInDep;
+        {
+            scoped_watch _sw(m_fc_watches.m_dep_analysis);
+            conflictInDep = ctx_dep_analysis(varAppearInAssign, freeVar_map, var_eq_concat_map);
+        }
         if (conflictInDep == -1) {
             m_stats.m_solved_by = 2;
             return FC_DONE;
@@ -8293,6 +8302,7 @@ namespace smt {
 
         // enhancement: improved backpropagation of string constants into var=concat terms
         bool backpropagation_occurred = false;
+        m_fc_watches.m_backpropagation.start();
         for (auto const &veqc_map_it : var_eq_concat_map) {
             expr * var = veqc_map_it.first;
             for (auto const &concat_map_it : veqc_map_it.second) {
@@ -8340,6 +8350,7 @@ namespace smt {
             }
         }
 
+        m_fc_watches.m_backpropagation.stop();
         if (backpropagation_occurred) {
             TRACE("str", tout << "Resuming search due to axioms added by backpropagation." << std::endl;);
             return FC_CONTINUE;
@@ -8347,6 +8358,7 @@ namespace smt {
 
         // enhancement: improved backpropagation of length information
         {
+            scoped_watch _sw(m_fc_watches.m_length);
             std::set<expr*> varSet;
             std::set<expr*> concatSet;
             std::map<expr*, int> exprLenMap;
@@ -8358,7 +8370,12 @@ namespace smt {
             }
         }
 
-        if (!solve_regex_automata()) {
+        bool regex_solved;
+        {
+            scoped_watch _sw(m_fc_watches.m_regex);
+            regex_solved = solve_regex_automata();
+        }
+        if (!regex_solved) {
             TRACE("str", tout << "regex engine requested to give up!" << std::endl;);
             return FC_GIVEUP;
         }
@@ -8502,6 +8519,7 @@ namespace smt {
             // TODO if we're using fixed-length testing, do we care about finding free variables any more?
             // that work might be useless
             TRACE("str", tout << "using fixed-length model construction" << std::endl;);
+            scoped_watch _sw(m_fc_watches.m_model);
 
             arith_value v(get_manager());
             v.init(&ctx);
@@ -20,6 +20,7 @@
 #include "util/union_find.h"
 #include "util/scoped_ptr_vector.h"
 #include "util/hashtable.h"
+#include "util/stopwatch.h"
 #include "ast/ast_pp.h"
 #include "ast/arith_decl_plugin.h"
 #include "ast/rewriter/th_rewriter.h"
@@ -305,6 +306,17 @@ class theory_str : public theory {
         unsigned m_refine_nf;
         unsigned m_solved_by;
         unsigned m_fixed_length_iterations;
+        unsigned m_final_checks;
+    };
+
+    // time spent in the phases of final_check_eh
+    struct final_check_watches {
+        stopwatch m_eqc;
+        stopwatch m_dep_analysis;
+        stopwatch m_backpropagation;
+        stopwatch m_length;
+        stopwatch m_regex;
+        stopwatch m_model;
     };
 
 protected:
@@ -494,6 +506,7 @@ protected:
     obj_map<expr, zstring> candidate_model;
     
     stats m_stats;
+    final_check_watches m_fc_watches;
 
 protected:
     void reset_internal_data_structures();
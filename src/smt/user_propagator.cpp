@@ -23,7 +23,8 @@ Author:
 using namespace smt;
 
 user_propagator::user_propagator(context& ctx):
-    theory(ctx, ctx.get_manager().mk_family_id("user_propagator"))
+    theory(ctx, ctx.get_manager().mk_family_id("user_propagator")),
+    m_batch_values(ctx.get_manager())
 {}
 
 user_propagator::~user_propagator() {
@@ -35,6 +36,29 @@ void user_propagator::force_push() {
         theory::push_scope_eh();
         m_push_eh(m_user_context);
         m_prop_lim.push_back(m_prop.size());
+        m_batch_lim.push_back(std::make_pair(m_batch_fixed.size(), m_batch_lhs.size()));
+    }
+}
+
+/**
+   \brief deliver the events collected since the last call to the batch callback.
+*/
+void user_propagator::flush_batch() {
+    if (!has_batch())
+        return;
+    force_push();
+    unsigned fh = m_batch_fixed_head, eh = m_batch_eqs_head;
+    m_batch_fixed_head = m_batch_fixed.size();
+    m_batch_eqs_head = m_batch_lhs.size();
+    m_batch_eh(m_user_context, this, 
+               m_batch_fixed.size() - fh, m_batch_fixed.data() + fh, m_batch_values.data() + fh, 
+               m_batch_lhs.size() - eh, m_batch_lhs.data() + eh, m_batch_rhs.data() + eh);
+    if (m_batch_lim.empty()) {
+        m_batch_fixed.reset();
+        m_batch_values.reset();
+        m_batch_lhs.reset();
+        m_batch_rhs.reset();
+        m_batch_fixed_head = m_batch_eqs_head = 0;
     }
 }
 
@@ -65,22 +89,25 @@ theory * user_propagator::mk_fresh(context * new_ctx) {
     if ((bool)m_final_eh) th->register_final(m_final_eh);
     if ((bool)m_eq_eh) th->register_eq(m_eq_eh);
     if ((bool)m_diseq_eh) th->register_diseq(m_diseq_eh);
+    if ((bool)m_batch_eh) th->register_batch(m_batch_eh);
     return th;
 }
 
 final_check_status user_propagator::final_check_eh() {
-    if (!(bool)m_final_eh)
+    if (!(bool)m_final_eh && !has_batch())
         return FC_DONE;
     force_push();
     unsigned sz = m_prop.size();
-    m_final_eh(m_user_context, this);
+    flush_batch();
+    if ((bool)m_final_eh)
+        m_final_eh(m_user_context, this);
     propagate();
     bool done = (sz == m_prop.size()) && !ctx.inconsistent();
     return done ? FC_DONE : FC_CONTINUE;
 }
 
 void user_propagator::new_fixed_eh(theory_var v, expr* value, unsigned num_lits, literal const* jlits) {
-    if (!m_fixed_eh)
+    if (!m_fixed_eh && !m_batch_eh)
         return;
     force_push();
     if (m_fixed.contains(v))
@@ -88,7 +115,22 @@ void user_propagator::new_fixed_eh(theory_var v, expr* value, unsigned num_lits,
     m_fixed.insert(v);
     ctx.push_trail(insert_map<uint_set, unsigned>(m_fixed, v));
     m_id2justification.setx(v, literal_vector(num_lits, jlits), literal_vector());
-    m_fixed_eh(m_user_context, this, v, value);
+    if (m_batch_eh) {
+        m_batch_fixed.push_back(v);
+        m_batch_values.push_back(value);
+    }
+    else
+        m_fixed_eh(m_user_context, this, v, value);
+}
+
+void user_propagator::new_eq_eh(theory_var v1, theory_var v2) {
+    if (m_batch_eh) {
+        force_push();
+        m_batch_lhs.push_back(v1);
+        m_batch_rhs.push_back(v2);
+    }
+    else if (m_eq_eh)
+        m_eq_eh(m_user_context, this, v1, v2);
 }
 
 void user_propagator::push_scope_eh() {
@@ -106,13 +148,22 @@ void user_propagator::pop_scope_eh(unsigned num_scopes) {
     unsigned old_sz = m_prop_lim.size() - num_scopes;
     m_prop.shrink(m_prop_lim[old_sz]);
     m_prop_lim.shrink(old_sz);
+    auto [fixed_sz, eqs_sz] = m_batch_lim[old_sz];
+    m_batch_fixed.shrink(fixed_sz);
+    m_batch_values.shrink(fixed_sz);
+    m_batch_lhs.shrink(eqs_sz);
+    m_batch_rhs.shrink(eqs_sz);
+    m_batch_fixed_head = std::min(m_batch_fixed_head, fixed_sz);
+    m_batch_eqs_head = std::min(m_batch_eqs_head, eqs_sz);
+    m_batch_lim.shrink(old_sz);
 }
 
 bool user_propagator::can_propagate() {
-    return m_qhead < m_prop.size();
+    return m_qhead < m_prop.size() || has_batch();
 }
 
 void user_propagator::propagate() {
+    flush_batch();
     if (m_qhead == m_prop.size())
         return;
     force_push();
@@ -56,6 +56,7 @@ namespace smt {
         solver::fixed_eh_t     m_fixed_eh;
         solver::eq_eh_t        m_eq_eh;
         solver::eq_eh_t        m_diseq_eh;
+        solver::batch_eh_t     m_batch_eh;
         solver::context_obj*   m_api_context = nullptr;
         unsigned               m_qhead = 0;
         uint_set               m_fixed;
@@ -67,8 +68,19 @@ namespace smt {
         enode_pair_vector      m_eqs;
         stats                  m_stats;
 
+        // events for m_batch_eh, the ones from the heads on are not yet delivered
+        unsigned_vector        m_batch_fixed;
+        expr_ref_vector        m_batch_values;
+        unsigned_vector        m_batch_lhs, m_batch_rhs;
+        unsigned               m_batch_fixed_head = 0;
+        unsigned               m_batch_eqs_head = 0;
+        svector<std::pair<unsigned, unsigned>> m_batch_lim;
+
         void force_push();
 
+        bool has_batch() const { return m_batch_fixed_head < m_batch_fixed.size() || m_batch_eqs_head < m_batch_lhs.size(); }
+        void flush_batch();
+
     public:
         user_propagator(context& ctx);
         
@@ -94,8 +106,9 @@ namespace smt {
         void register_fixed(solver::fixed_eh_t& fixed_eh) { m_fixed_eh = fixed_eh; }
         void register_eq(solver::eq_eh_t& eq_eh) { m_eq_eh = eq_eh; }
         void register_diseq(solver::eq_eh_t& diseq_eh) { m_diseq_eh = diseq_eh; }
+        void register_batch(solver::batch_eh_t& batch_eh) { m_batch_eh = batch_eh; }
 
-        bool has_fixed() const { return (bool)m_fixed_eh; }
+        bool has_fixed() const { return (bool)m_fixed_eh || (bool)m_batch_eh; }
 
         void propagate_cb(unsigned num_fixed, unsigned const* fixed_ids, unsigned num_eqs, unsigned const* lhs, unsigned const* rhs, expr* conseq) override;
 
@@ -104,7 +117,7 @@ namespace smt {
         theory * mk_fresh(context * new_ctx) override;
         bool internalize_atom(app * atom, bool gate_ctx) override { UNREACHABLE(); return false; }
         bool internalize_term(app * term) override { UNREACHABLE(); return false; }
-        void new_eq_eh(theory_var v1, theory_var v2) override { if (m_eq_eh) m_eq_eh(m_user_context, this, v1, v2); }
+        void new_eq_eh(theory_var v1, theory_var v2) override;
         void new_diseq_eh(theory_var v1, theory_var v2) override { if (m_diseq_eh) m_diseq_eh(m_user_context, this, v1, v2); }
         bool use_diseqs() const override { return ((bool)m_diseq_eh); }
         bool build_models() const override { return false; }
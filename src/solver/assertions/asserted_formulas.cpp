@@ -26,6 +26,7 @@ Revision History:
 #include "ast/pattern/pattern_inference.h"
 #include "ast/macros/quasi_macros.h"
 #include "ast/occurs.h"
+#include "ast/rewriter/expr_safe_replace.h"
 #include "solver/assertions/asserted_formulas.h"
 
 
@@ -60,6 +61,7 @@ asserted_formulas::asserted_formulas(ast_manager & m, smt_params & sp, params_re
     m_nnf_cnf(*this),
     m_apply_quasi_macros(*this),
     m_flatten_clauses(*this),
+    m_bv_bounds(*this),
     m_lazy_scopes(0) {
 
     m_macro_finder = alloc(macro_finder, m, m_macro_manager);
@@ -203,6 +205,7 @@ void asserted_formulas::push_scope_core() {
     m_elim_term_ite.push();
     m_bv_sharing.push_scope();
     m_macro_manager.push_scope();
+    m_bv_bounds.push();
     commit();
     TRACE("asserted_formulas_scopes", tout << "after push: " << m_scopes.size() << "\n";);
 }
@@ -223,6 +226,7 @@ void asserted_formulas::pop_scope(unsigned num_scopes) {
     TRACE("asserted_formulas_scopes", tout << "before pop " << num_scopes << " of " << m_scopes.size() << "\n";);
     m_bv_sharing.pop_scope(num_scopes);
     m_macro_manager.pop_scope(num_scopes);
+    m_bv_bounds.pop(num_scopes);
     unsigned new_lvl    = m_scopes.size() - num_scopes;
     scope & s           = m_scopes[new_lvl];
     m_inconsistent      = s.m_inconsistent_old;
@@ -242,6 +246,7 @@ void asserted_formulas::reset() {
     m_formulas.reset();
     m_macro_manager.reset();
     m_bv_sharing.reset();
+    m_bv_bounds.reset();
     m_rewriter.reset();
     m_inconsistent = false;
 }
@@ -296,6 +301,7 @@ void asserted_formulas::reduce() {
     if (!invoke(m_elim_bvs_from_quantifiers)) return;
     if (!invoke(m_reduce_asserted_formulas)) return;
     if (!invoke(m_flatten_clauses)) return;
+    if (!invoke(m_bv_bounds)) return;
 //    if (!invoke(m_propagate_values)) return;
 
     IF_VERBOSE(10, verbose_stream() << "(smt.simplifier-done)\n";);
@@ -378,19 +384,164 @@ void asserted_formulas::find_macros_core() {
    \brief rewrite (a or (b & c)) to (a or b), (a or c) if the reference count of (b & c) is 1.
    This avoids the literal for (b & c)
 */
+bool asserted_formulas::bv_bounds_fn::is_bound(expr* e, expr*& x, bool& is_upper, rational& c) {
+    expr* a, * b;
+    if (!m_bv.is_bv_ule(e, a, b))
+        return false;
+    if (m_bv.is_numeral(b, c) && !m_bv.is_numeral(a)) {
+        x = a;
+        is_upper = true;
+        return true;
+    }
+    if (m_bv.is_numeral(a, c) && !m_bv.is_numeral(b)) {
+        x = b;
+        is_upper = false;
+        return true;
+    }
+    return false;
+}
+
+bool asserted_formulas::bv_bounds_fn::is_unit_bound(expr* e) {
+    expr* x;
+    bool is_upper;
+    rational c;
+    m.is_not(e, e);
+    return is_bound(e, x, is_upper, c);
+}
+
+void asserted_formulas::bv_bounds_fn::add_bound(expr* e) {
+    bool sign = m.is_not(e, e);
+    expr* x = nullptr;
+    bool is_upper = false;
+    rational c;
+    VERIFY(is_bound(e, x, is_upper, c));
+    if (sign) {
+        // not (x <= c) <=> c + 1 <= x, not (c <= x) <=> x <= c - 1
+        c += rational(is_upper ? 1 : -1);
+        is_upper = !is_upper;
+    }
+    interval b(rational::zero(), rational::power_of_two(m_bv.get_bv_size(x)) - 1);
+    bool fresh = !m_bounds.find(x, b);
+    interval old = b;
+    if (is_upper && c < b.second)
+        b.second = c;
+    else if (!is_upper && c > b.first)
+        b.first = c;
+    else if (!fresh)
+        return;
+    m_trail.push_back({ x, old, fresh });
+    if (fresh)
+        m_pinned.push_back(x);
+    m_bounds.insert(x, b);
+    TRACE("asserted_formulas", tout << mk_pp(x, m) << " in [" << b.first << ", " << b.second << "]\n";);
+}
+
+lbool asserted_formulas::bv_bounds_fn::eval(expr* e) {
+    expr* x = nullptr;
+    bool is_upper = false;
+    rational c;
+    interval b;
+    if (!is_bound(e, x, is_upper, c) || !m_bounds.find(x, b))
+        return l_undef;
+    if (is_upper)
+        return b.second <= c ? l_true : (b.first > c ? l_false : l_undef);
+    return b.first >= c ? l_true : (b.second < c ? l_false : l_undef);
+}
+
+void asserted_formulas::bv_bounds_fn::operator()() {
+    for (unsigned i = af.m_qhead; i < af.m_formulas.size(); ++i) {
+        expr* f = af.m_formulas[i].get_fml();
+        if (is_unit_bound(f))
+            add_bound(f);
+    }
+    if (!m_bounds.empty())
+        simplify_fmls::operator()();
+}
+
+/**
+   Unit bounds are kept as they are unless the other bounds contradict them,
+   other formulas have their bound atoms replaced by the values implied by the bounds.
+*/
+void asserted_formulas::bv_bounds_fn::simplify(justified_expr const& j, expr_ref& n, proof_ref& p) {
+    expr* f = j.get_fml();
+    n = f;
+    if (is_unit_bound(f)) {
+        expr* e = f;
+        bool sign = m.is_not(f, e);
+        if (eval(e) == (sign ? l_true : l_false))
+            n = m.mk_false();
+        return;
+    }
+    expr_safe_replace rep(m);
+    bool found = false;
+    ast_mark visited;
+    ptr_buffer<expr> todo;
+    todo.push_back(f);
+    while (!todo.empty()) {
+        expr* e = todo.back();
+        todo.pop_back();
+        if (visited.is_marked(e))
+            continue;
+        visited.mark(e, true);
+        lbool v = eval(e);
+        if (v != l_undef) {
+            rep.insert(e, v == l_true ? m.mk_true() : m.mk_false());
+            found = true;
+        }
+        else if (is_app(e) && to_app(e)->get_family_id() == m.get_basic_family_id()) {
+            for (expr* arg : *to_app(e))
+                if (m.is_bool(arg))
+                    todo.push_back(arg);
+        }
+    }
+    if (found) {
+        rep(f, n);
+        af.m_rewriter(n);
+    }
+}
+
+void asserted_formulas::bv_bounds_fn::pop(unsigned n) {
+    unsigned lim = m_lim[m_lim.size() - n];
+    for (unsigned i = m_trail.size(); i-- > lim; ) {
+        undo const& u = m_trail[i];
+        if (u.m_fresh) {
+            m_bounds.remove(u.m_term);
+            m_pinned.pop_back();
+        }
+        else
+            m_bounds.insert(u.m_term, u.m_old);
+    }
+    m_trail.shrink(lim);
+    m_lim.shrink(m_lim.size() - n);
+}
+
+void asserted_formulas::bv_bounds_fn::reset() {
+    m_bounds.reset();
+    m_trail.reset();
+    m_lim.reset();
+    m_pinned.reset();
+}
+
+/**
+   \brief Decompose (or a (not (or b1 .. bn))) into (or a (not bi)) and (ite a b c) into two clauses.
+   The clauses produced by a decomposition are examined again right away, so the formulas
+   are traversed once instead of once per round of decompositions.
+   A formula is released from m_formulas before its decomposition, so the reference counts
+   of its sub-terms only reflect sharing with other formulas.
+*/
 void asserted_formulas::flatten_clauses() {
     if (m.proofs_enabled()) return;
-    bool change = true;
-    vector<justified_expr> new_fmls;
+    vector<justified_expr> new_fmls, todo;
     auto mk_not = [this](expr* e) { return m.is_not(e, e) ? e : m.mk_not(e); };
     auto is_literal = [this](expr *e) { m.is_not(e, e); return !is_app(e) || to_app(e)->get_num_args() == 0; };
     expr *a = nullptr, *b = nullptr, *c = nullptr;
-    while (change) {
-        change = false;        
-        new_fmls.reset();
-        unsigned sz = m_formulas.size();
-        for (unsigned i = m_qhead; i < sz; ++i) {
-            auto const& j = m_formulas.get(i);
+    unsigned sz = m_formulas.size();
+    for (unsigned i = m_qhead; i < sz; ++i) {
+        todo.push_back(m_formulas.get(i));
+        m_formulas[i] = justified_expr(m, m.mk_true(), nullptr);
+        while (!todo.empty()) {
+            justified_expr j = todo.back();
+            todo.pop_back();
             expr* f = j.get_fml();
             bool decomposed = false;
             if (m.is_or(f, a, b) && m.is_not(b, b) && m.is_or(b) && (b->get_ref_count() == 1 || is_literal(a))) {
@@ -400,23 +551,19 @@ void asserted_formulas::flatten_clauses() {
                 decomposed = true;
             }            
             if (decomposed) {
-                for (expr* arg : *to_app(b)) {
-                    justified_expr j1(m, m.mk_or(a, mk_not(arg)), nullptr);
-                    new_fmls.push_back(j1);
-                }
-                change = true;
+                for (unsigned k = to_app(b)->get_num_args(); k-- > 0; ) 
+                    todo.push_back(justified_expr(m, m.mk_or(a, mk_not(to_app(b)->get_arg(k))), nullptr));
                 continue;
             }
             if (m.is_ite(f, a, b, c)) {
-                new_fmls.push_back(justified_expr(m, m.mk_or(mk_not(a), b), nullptr));
-                new_fmls.push_back(justified_expr(m, m.mk_or(a, c), nullptr));
-                change = true;
+                todo.push_back(justified_expr(m, m.mk_or(a, c), nullptr));
+                todo.push_back(justified_expr(m, m.mk_or(mk_not(a), b), nullptr));
                 continue;
             }
             new_fmls.push_back(j);            
         }
-        swap_asserted_formulas(new_fmls);
     }
+    swap_asserted_formulas(new_fmls);
 }
 
 
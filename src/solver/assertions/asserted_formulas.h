@@ -169,6 +169,37 @@ class asserted_formulas {
     };
     void flatten_clauses();
 
+    /**
+       \brief Simplify unsigned bit-vector inequalities using the bounds asserted as units.
+       The bounds are kept across scopes, so only the formulas after the queue head
+       are scanned when new assertions arrive.
+    */
+    class bv_bounds_fn : public simplify_fmls {
+        typedef std::pair<rational, rational> interval;
+        struct undo {
+            expr*    m_term;
+            interval m_old;
+            bool     m_fresh;
+        };
+        bv_util                   m_bv;
+        obj_map<expr, interval>   m_bounds;
+        expr_ref_vector           m_pinned;
+        vector<undo>              m_trail;
+        unsigned_vector           m_lim;
+        bool is_bound(expr* e, expr*& x, bool& is_upper, rational& c);
+        bool is_unit_bound(expr* e);
+        void add_bound(expr* e);
+        lbool eval(expr* e);
+    public:
+        bv_bounds_fn(asserted_formulas& af): simplify_fmls(af, "bv-bounds"), m_bv(af.m), m_pinned(af.m) {}
+        void operator()() override;
+        void simplify(justified_expr const& j, expr_ref& n, proof_ref& p) override;
+        bool should_apply() const override { return af.m_smt_params.m_bv_preprocess_bounds && !m.proofs_enabled(); }
+        void push() { m_lim.push_back(m_trail.size()); }
+        void pop(unsigned n);
+        void reset();
+    };
+
 #define MK_SIMPLIFIERA(NAME, FUNCTOR, MSG, APP, ARG, REDUCE)            \
     class NAME : public simplify_fmls {                                 \
     public:                                                             \
@@ -208,6 +239,7 @@ class asserted_formulas {
     nnf_cnf_fn                  m_nnf_cnf;
     apply_quasi_macros_fn       m_apply_quasi_macros;
     flatten_clauses_fn          m_flatten_clauses;
+    bv_bounds_fn                m_bv_bounds;
     unsigned                    m_lazy_scopes;
 
     void force_push();
@@ -22,6 +22,7 @@ Notes:
 #include "util/common_msgs.h"
 #include "ast/ast_pp.h"
 #include "solver/solver.h"
+#include "solver/preprocess_solver.h"
 #include "solver/combined_solver_params.hpp"
 #include <atomic>
 #define PS_VB_LVL 15
@@ -274,6 +275,11 @@ public:
         return m_solver2->cube(vars, backtrack_level);
     }
 
+    void cubes(expr_ref_vector& vars, unsigned backtrack_level, unsigned max_cubes, vector<expr_ref_vector>& result) override {
+        switch_inc_mode();
+        m_solver2->cubes(vars, backtrack_level, max_cubes, result);
+    }
+
     expr * get_assumption(unsigned idx) const override {
         unsigned c1 = m_solver1->get_num_assumptions();
         if (idx < c1) return m_solver1->get_assumption(idx);
@@ -348,6 +354,9 @@ public:
 
 
 solver * mk_combined_solver(solver * s1, solver * s2, params_ref const & p) {
+    combined_solver_params cp(p);
+    if (cp.solver2_preprocess())
+        s2 = mk_preprocess_solver(s2->get_manager(), p, s2);
     return alloc(combined_solver, s1, s2, p);
 }
 
@@ -22,7 +22,12 @@ Notes:
 #include "solver/mus.h"
 #include "ast/ast_pp.h"
 #include "ast/ast_util.h"
+#include "ast/ast_translation.h"
 #include "model/model_evaluator.h"
+#include "util/scoped_ptr_vector.h"
+#ifndef SINGLE_THREAD
+#include "util/thread_pool.h"
+#endif
 
 
 struct mus::imp {
@@ -38,6 +43,7 @@ struct mus::imp {
     expr_ref_vector          m_soft;
     vector<rational>         m_weights;
     rational                 m_weight;
+    unsigned                 m_num_threads { 1 };
 
     imp(solver& s): 
         m_solver(s), m(s.get_manager()), m_lit2expr(m),  m_assumptions(m), m_soft(m)
@@ -74,9 +80,134 @@ struct mus::imp {
             mus.push_back(m_lit2expr.back());
             return l_true;
         }
+        if (m_num_threads > 1 && m_lit2expr.size() > 2) 
+            return get_mus_par(mus);
         return get_mus1(mus);
     }
 
+    /**
+       \brief Shrink the core by testing up to m_num_threads literals in parallel.
+
+       The literals of a batch are tested against the same set of literals S on
+       copies of the solver. A literal that is critical for S is critical for all
+       subsets of S, so all critical literals of a batch are added to the mus.
+       Only the first literal that is not critical is removed, then S shrinks to
+       its core, and the other non-critical literals are tested again.
+    */
+    lbool get_mus_par(expr_ref_vector& mus) {
+#ifdef SINGLE_THREAD
+        return get_mus1(mus);
+#else
+        unsigned n = m_num_threads;
+        scoped_ptr_vector<ast_manager> managers;
+        sref_vector<solver> solvers;
+        try {
+            for (unsigned j = 0; j < n; ++j) {
+                managers.push_back(alloc(ast_manager, m, true));
+                solvers.push_back(m_solver.translate(*managers.back(), m_solver.get_params()));
+            }
+        }
+        catch (z3_exception&) {
+            // the solver cannot be copied in its current state.
+            return get_mus1(mus);
+        }
+        scoped_limits sl(m.limit());
+        for (ast_manager* wm : managers)
+            sl.push_child(&(wm->limit()));
+
+        ptr_vector<expr> unknown(m_lit2expr.size(), m_lit2expr.data());
+        ptr_vector<expr> batch, retest;
+        vector<expr_ref_vector> asms, cores;
+        svector<lbool> results;
+        for (unsigned j = 0; j < n; ++j) {
+            asms.push_back(expr_ref_vector(*managers[j]));
+            cores.push_back(expr_ref_vector(*managers[j]));
+        }
+        while (!unknown.empty()) {
+            IF_VERBOSE(12, verbose_stream() << "(mus reducing core: " << unknown.size() << " new core: " << mus.size() << ")\n";);
+            unsigned k = std::min(n, unknown.size());
+            batch.reset();
+            for (unsigned j = 0; j < k; ++j) {
+                batch.push_back(unknown.back());
+                unknown.pop_back();
+            }
+            for (unsigned j = 0; j < k; ++j) {
+                ast_translation tr(m, *managers[j]);
+                expr_ref_vector& a = asms[j];
+                a.reset();
+                cores[j].reset();
+                for (expr* e : mus) a.push_back(tr(e));
+                for (expr* e : unknown) a.push_back(tr(e));
+                for (expr* e : m_assumptions) a.push_back(tr(e));
+                for (unsigned i = 0; i < k; ++i) 
+                    if (i != j) 
+                        a.push_back(tr(batch[i]));
+                a.push_back(tr(mk_not(m, batch[j])));
+            }
+            results.reset();
+            results.resize(k, l_undef);
+            thread_pool threads;
+            for (unsigned j = 0; j < k; ++j) {
+                threads.run([&, j]() {
+                    try {
+                        results[j] = solvers[j]->check_sat(asms[j]);
+                        if (results[j] == l_false)
+                            solvers[j]->get_unsat_core(cores[j]);
+                    }
+                    catch (z3_exception&) {
+                        results[j] = l_undef;
+                    }
+                });
+            }
+            threads.join();
+
+            int removed = -1;
+            retest.reset();
+            for (unsigned j = 0; j < k; ++j) {
+                switch (results[j]) {
+                case l_undef:
+                    return l_undef;
+                case l_true:
+                    mus.push_back(batch[j]);
+                    if (!m_soft.empty()) {
+                        model_ref mdl;
+                        solvers[j]->get_model(mdl);
+                        if (mdl) {
+                            ast_translation tr(*managers[j], m);
+                            model_ref mdl1 = mdl->translate(tr);
+                            update_model(mdl1);
+                        }
+                    }
+                    break;
+                default:
+                    if (removed == -1)
+                        removed = j;
+                    else
+                        retest.push_back(batch[j]);
+                    break;
+                }
+            }
+            if (removed == -1) 
+                continue;
+            ast_translation tr(*managers[removed], m);
+            expr_ref not_lit(mk_not(m, batch[removed]), m);
+            expr_ref_vector core(m);
+            for (expr* c : cores[removed])
+                core.push_back(tr(c));
+            if (core.contains(not_lit)) {
+                unknown.append(retest);
+                continue;
+            }
+            // unknown := core \ mus
+            unknown.reset();
+            for (expr* c : core) 
+                if (m_expr2lit.contains(c) && !mus.contains(c))
+                    unknown.push_back(c);
+        }
+        return l_true;
+#endif
+    }
+
     lbool get_mus1(expr_ref_vector& mus) {
         ptr_vector<expr> unknown(m_lit2expr.size(), m_lit2expr.data());
         expr_ref_vector core_exprs(m);
@@ -327,8 +458,11 @@ struct mus::imp {
     void update_model() {
         if (m_soft.empty()) return;
         model_ref mdl;
-        expr_ref tmp(m);
         m_solver.get_model(mdl);
+        update_model(mdl);
+    }
+
+    void update_model(model_ref& mdl) {
         rational w;
         for (unsigned i = 0; i < m_soft.size(); ++i) {
             if (!mdl->is_true(m_soft.get(i))) {
@@ -373,6 +507,10 @@ void mus::reset() {
     m_imp->reset();
 }
 
+void mus::set_num_threads(unsigned n) {
+    m_imp->m_num_threads = std::max(1u, n);
+}
+
 void mus::set_soft(unsigned sz, expr* const* soft, rational const* weights) {
     m_imp->set_soft(sz, soft, weights);
 }
@@ -49,6 +49,12 @@ class mus {
     lbool get_mus(expr_ref_vector& mus);
     
     void reset();
+
+    /**
+       Test up to n literals of the core in parallel on copies of the solver.
+       The solver has to support translate.
+    */
+    void set_num_threads(unsigned n);
     
     /**
        Instrument MUS extraction to also provide the minimal
@@ -49,6 +49,7 @@ tactic * mk_parallel_tactic(solver* s, params_ref const& p) {
 
 #include <atomic>
 #include <thread>
+#include "util/thread_pool.h"
 #include <mutex>
 #include <cmath>
 #include <condition_variable>
@@ -710,11 +711,10 @@ private:
 
     lbool solve(model_ref& mdl) {        
         add_branches(1);
-        vector<std::thread> threads;
+        thread_pool threads;
         for (unsigned i = 0; i < m_num_threads; ++i) 
-            threads.push_back(std::thread([this]() { run_solver(); }));
-        for (std::thread& t : threads) 
-            t.join();
+            threads.run([this]() { run_solver(); });
+        threads.join();
         m_queue.stats(m_stats);
         m_manager.limit().reset_cancel();
         if (m_exn_code == -1) 
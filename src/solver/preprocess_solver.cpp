@@ -0,0 +1,314 @@
+/*++
+Copyright (c) 2021 Microsoft Corporation
+
+Module Name:
+
+    preprocess_solver.cpp
+
+Abstract:
+
+    Incremental preprocessing of the assertions of a solver.
+
+    Assertions are simplified when they are passed to the solver, at the
+    next push or check. An assertion of the form x = t, x, or (not x) where
+    x is an uninterpreted constant that does not occur in t or in any
+    assertion passed to the solver so far, eliminates x: it is not passed
+    to the solver, later assertions are simplified with x replaced by t,
+    and the model of the solver is extended with the definition of x.
+
+    Constants that occur in assertions passed to the solver or in the
+    definitions are frozen and never eliminated. Hence every definition
+    only refers to constants known to the solver and the elimination is
+    undone on pop by forgetting the definitions and frozen constants of
+    the popped scopes.
+
+    Assumptions and the variables of consequence finding are not rewritten.
+    If they contain an eliminated constant, its definition is passed to
+    the solver as an equation.
+
+Notes:
+
+    Elimination is disabled when proofs are enabled.
+
+--*/
+
+#include "util/statistics.h"
+#include "ast/ast_pp.h"
+#include "ast/ast_translation.h"
+#include "ast/for_each_expr.h"
+#include "ast/expr_substitution.h"
+#include "ast/occurs.h"
+#include "ast/rewriter/th_rewriter.h"
+#include "tactic/generic_model_converter.h"
+#include "solver/solver_na2as.h"
+#include "solver/preprocess_solver.h"
+
+class preprocess_solver : public solver_na2as {
+
+    struct scope {
+        unsigned m_assertions_lim;
+        unsigned m_vars_lim;
+        unsigned m_frozen_lim;
+    };
+
+    ast_manager&                 m;
+    expr_ref_vector              m_assertions;   // assertions as they were asserted
+    mutable unsigned             m_qhead;        // assertions before m_qhead are passed to the solver
+    mutable ref<solver>          m_solver;
+    mutable th_rewriter          m_rewriter;
+    mutable expr_substitution    m_subst;
+    mutable app_ref_vector       m_vars;         // eliminated constants
+    mutable expr_ref_vector      m_defs;         // m_vars[i] = m_defs[i]
+    mutable obj_hashtable<app>   m_frozen;
+    mutable app_ref_vector       m_frozen_trail;
+    svector<scope>               m_lim;
+    mutable unsigned             m_num_elim;
+
+    bool is_frozen(app* x) const { return m_frozen.contains(x); }
+
+    void freeze(expr* e) const {
+        for (expr* t : subterms::all(expr_ref(e, m))) {
+            if (is_uninterp_const(t) && !m_frozen.contains(to_app(t))) {
+                m_frozen.insert(to_app(t));
+                m_frozen_trail.push_back(to_app(t));
+            }
+        }
+    }
+
+    bool is_solved(expr* v, expr* t) const {
+        return is_uninterp_const(v) && !is_frozen(to_app(v)) && !occurs(v, t);
+    }
+
+    bool solve(expr* f, app_ref& x, expr_ref& t) const {
+        expr* a, * b;
+        if (is_uninterp_const(f) && !is_frozen(to_app(f))) {
+            x = to_app(f);
+            t = m.mk_true();
+            return true;
+        }
+        if (m.is_not(f, a) && is_uninterp_const(a) && !is_frozen(to_app(a))) {
+            x = to_app(a);
+            t = m.mk_false();
+            return true;
+        }
+        if (m.is_eq(f, a, b) && is_solved(a, b)) {
+            x = to_app(a);
+            t = b;
+            return true;
+        }
+        if (m.is_eq(f, a, b) && is_solved(b, a)) {
+            x = to_app(b);
+            t = a;
+            return true;
+        }
+        return false;
+    }
+
+    void flush_assertions() const {
+        if (m_qhead == m_assertions.size())
+            return;
+        bool elim = !m.proofs_enabled();
+        expr_ref fml(m), t(m);
+        app_ref x(m);
+        ptr_vector<expr> todo;
+        for (; m_qhead < m_assertions.size(); ++m_qhead) {
+            m_rewriter(m_assertions.get(m_qhead), fml);
+            todo.push_back(fml);
+            while (!todo.empty()) {
+                expr* f = todo.back();
+                todo.pop_back();
+                if (m.is_and(f)) {
+                    for (unsigned i = to_app(f)->get_num_args(); i-- > 0; )
+                        todo.push_back(to_app(f)->get_arg(i));
+                }
+                else if (elim && solve(f, x, t)) {
+                    TRACE("preprocess_solver", tout << x << " := " << t << "\n";);
+                    m_vars.push_back(x);
+                    m_defs.push_back(t);
+                    m_subst.insert(x, t);
+                    freeze(t);
+                    m_rewriter.set_substitution(&m_subst);
+                    ++m_num_elim;
+                }
+                else if (!m.is_true(f)) {
+                    freeze(f);
+                    m_solver->assert_expr(f);
+                }
+            }
+        }
+    }
+
+    /**
+       \brief Freeze the constants of es, in particular before pending assertions
+       are processed, and pass the definitions of eliminated constants of es
+       to the solver.
+    */
+    void restore(unsigned n, expr* const* es) const {
+        for (unsigned i = 0; i < n; ++i) {
+            for (expr* t : subterms::all(expr_ref(es[i], m))) {
+                if (!is_uninterp_const(t) || is_frozen(to_app(t)))
+                    continue;
+                expr* def = nullptr;
+                proof* pr = nullptr;
+                if (m_subst.find(t, def, pr))
+                    m_solver->assert_expr(m.mk_eq(t, def));
+                freeze(t);
+            }
+        }
+    }
+
+public:
+
+    preprocess_solver(ast_manager& m, params_ref const& p, solver* s):
+        solver_na2as(m),
+        m(m),
+        m_assertions(m),
+        m_qhead(0),
+        m_solver(s),
+        m_rewriter(m, p),
+        m_subst(m, false, false),
+        m_vars(m),
+        m_defs(m),
+        m_frozen_trail(m),
+        m_num_elim(0) {
+        solver::updt_params(p);
+        m_rewriter.set_substitution(&m_subst);
+    }
+
+    ~preprocess_solver() override {}
+
+    solver* translate(ast_manager& dst_m, params_ref const& p) override {
+        if (!m_lim.empty())
+            throw default_exception("translation of contexts is only supported at base level");
+        flush_assertions();
+        ast_translation tr(m, dst_m);
+        solver* s = m_solver->translate(dst_m, p);
+        for (unsigned i = 0; i < m_vars.size(); ++i)
+            s->assert_expr(tr(m.mk_eq(m_vars.get(i), m_defs.get(i))));
+        preprocess_solver* result = alloc(preprocess_solver, dst_m, p, s);
+        for (expr* e : m_assertions)
+            result->m_assertions.push_back(tr(e));
+        result->m_qhead = result->m_assertions.size();
+        for (app* x : m_frozen_trail)
+            result->freeze(tr(x));
+        for (app* x : m_vars)
+            result->freeze(tr(x));
+        if (mc0())
+            result->set_model_converter(mc0()->translate(tr));
+        return result;
+    }
+
+    void assert_expr_core(expr * t) override {
+        m_assertions.push_back(t);
+    }
+
+    void push_core() override {
+        flush_assertions();
+        m_lim.push_back({ m_assertions.size(), m_vars.size(), m_frozen_trail.size() });
+        m_solver->push();
+    }
+
+    void pop_core(unsigned n) override {
+        n = std::min(n, m_lim.size());
+        scope s = m_lim[m_lim.size() - n];
+        m_lim.shrink(m_lim.size() - n);
+        m_assertions.shrink(s.m_assertions_lim);
+        m_qhead = s.m_assertions_lim;
+        for (unsigned i = s.m_vars_lim; i < m_vars.size(); ++i)
+            m_subst.erase(m_vars.get(i));
+        m_vars.shrink(s.m_vars_lim);
+        m_defs.shrink(s.m_vars_lim);
+        for (unsigned i = s.m_frozen_lim; i < m_frozen_trail.size(); ++i)
+            m_frozen.remove(m_frozen_trail.get(i));
+        m_frozen_trail.shrink(s.m_frozen_lim);
+        m_rewriter.set_substitution(&m_subst);
+        m_solver->pop(n);
+    }
+
+    lbool check_sat_core2(unsigned num_assumptions, expr * const * assumptions) override {
+        restore(num_assumptions, assumptions);
+        flush_assertions();
+        return m_solver->check_sat_core(num_assumptions, assumptions);
+    }
+
+    void updt_params(params_ref const & p) override { solver::updt_params(p); m_rewriter.updt_params(p); m_solver->updt_params(p); }
+    void collect_param_descrs(param_descrs & r) override { m_solver->collect_param_descrs(r); }
+    void set_produce_models(bool f) override { m_solver->set_produce_models(f); }
+    void set_progress_callback(progress_callback * callback) override { m_solver->set_progress_callback(callback); }
+    void collect_statistics(statistics & st) const override {
+        m_solver->collect_statistics(st);
+        st.update("preprocess eliminated", m_num_elim);
+    }
+    void get_unsat_core(expr_ref_vector & r) override { m_solver->get_unsat_core(r); }
+    void get_model_core(model_ref & mdl) override {
+        m_solver->get_model(mdl);
+        if (mdl) {
+            model_converter_ref mc = local_model_converter();
+            if (mc) (*mc)(mdl);
+        }
+    }
+    void set_phase(expr* e) override { m_solver->set_phase(e); }
+    phase* get_phase() override { return m_solver->get_phase(); }
+    void set_phase(phase* p) override { m_solver->set_phase(p); }
+    void move_to_front(expr* e) override { m_solver->move_to_front(e); }
+
+    void get_levels(ptr_vector<expr> const& vars, unsigned_vector& depth) override {
+        m_solver->get_levels(vars, depth);
+    }
+
+    expr_ref_vector get_trail() override {
+        return m_solver->get_trail();
+    }
+
+    model_converter* external_model_converter() const {
+        return concat(mc0(), local_model_converter());
+    }
+
+    model_converter_ref get_model_converter() const override {
+        model_converter_ref mc = external_model_converter();
+        mc = concat(mc.get(), m_solver->get_model_converter().get());
+        return mc;
+    }
+    proof * get_proof() override { return m_solver->get_proof(); }
+    std::string reason_unknown() const override { return m_solver->reason_unknown(); }
+    void set_reason_unknown(char const* msg) override { m_solver->set_reason_unknown(msg); }
+    void get_labels(svector<symbol> & r) override { m_solver->get_labels(r); }
+    ast_manager& get_manager() const override { return m; }
+    expr_ref_vector cube(expr_ref_vector& vars, unsigned backtrack_level) override {
+        restore(vars.size(), vars.data());
+        flush_assertions();
+        return m_solver->cube(vars, backtrack_level);
+    }
+    lbool find_mutexes(expr_ref_vector const& vars, vector<expr_ref_vector>& mutexes) override {
+        restore(vars.size(), vars.data());
+        flush_assertions();
+        return m_solver->find_mutexes(vars, mutexes);
+    }
+    lbool get_consequences_core(expr_ref_vector const& asms, expr_ref_vector const& vars, expr_ref_vector& consequences) override {
+        restore(asms.size(), asms.data());
+        restore(vars.size(), vars.data());
+        flush_assertions();
+        return m_solver->get_consequences(asms, vars, consequences);
+    }
+
+    model_converter* local_model_converter() const {
+        if (m_vars.empty())
+            return nullptr;
+        generic_model_converter* mc = alloc(generic_model_converter, m, "preprocess");
+        for (unsigned i = 0; i < m_vars.size(); ++i)
+            mc->add(m_vars.get(i), m_defs.get(i));
+        return mc;
+    }
+
+    unsigned get_num_assertions() const override {
+        return m_assertions.size();
+    }
+
+    expr * get_assertion(unsigned idx) const override {
+        return m_assertions.get(idx);
+    }
+};
+
+solver * mk_preprocess_solver(ast_manager & m, params_ref const & p, solver* s) {
+    return alloc(preprocess_solver, m, p, s);
+}
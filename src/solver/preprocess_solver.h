@@ -0,0 +1,22 @@
+/*++
+Copyright (c) 2021 Microsoft Corporation
+
+Module Name:
+
+    preprocess_solver.h
+
+Abstract:
+
+    Incremental preprocessing of the assertions of a solver.
+
+Notes:
+
+--*/
+#pragma once
+
+#include "ast/ast.h"
+#include "util/params.h"
+
+class solver;
+
+solver * mk_preprocess_solver(ast_manager & m, params_ref const & p, solver* s);
@@ -21,6 +21,7 @@ Notes:
 #include "ast/ast_util.h"
 #include "ast/ast_pp.h"
 #include "ast/ast_pp_util.h"
+#include "ast/pp_params.hpp"
 #include "ast/display_dimacs.h"
 #include "tactic/model_converter.h"
 #include "solver/solver.h"
@@ -50,7 +51,7 @@ std::ostream& solver::display(std::ostream & out, unsigned n, expr* const* assum
     visitor.collect(fmls);
     visitor.collect(n, assumptions);
     visitor.display_decls(out);
-    visitor.display_asserts(out, fmls, true);
+    visitor.display_asserts(out, fmls, !pp_params().compact());
     if (mc.get()) {
         mc->display(out);
         mc->set_env(nullptr);
@@ -186,6 +187,16 @@ lbool solver::preferred_sat(expr_ref_vector const& asms, vector<expr_ref_vector>
     return check_sat(0, nullptr);
 }
 
+void solver::cubes(expr_ref_vector& vars, unsigned backtrack_level, unsigned max_cubes, vector<expr_ref_vector>& result) {
+    for (unsigned i = 0; i < max_cubes; ++i) {
+        expr_ref_vector c = cube(vars, backtrack_level);
+        result.push_back(c);
+        if (c.empty() || (c.size() == 1 && (get_manager().is_true(c.get(0)) || get_manager().is_false(c.get(0)))))
+            return;
+        backtrack_level = UINT_MAX;
+    }
+}
+
 
 static bool is_m_atom(ast_manager& m, expr* f) {
     if (!is_app(f)) return true;
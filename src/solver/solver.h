@@ -238,6 +238,12 @@ public:
 
     virtual expr_ref_vector cube(expr_ref_vector& vars, unsigned backtrack_level) = 0;
 
+    /**
+       \brief extract up to max_cubes cubes in one call. backtrack_level applies to the first cube.
+       The last cube is empty, true or false when the cuber has no further cubes to offer.
+    */
+    virtual void cubes(expr_ref_vector& vars, unsigned backtrack_level, unsigned max_cubes, vector<expr_ref_vector>& result);
+
 
     class propagate_callback {
     public:
@@ -251,6 +257,7 @@ public:
     typedef std::function<void(void*, solver::propagate_callback*)> final_eh_t;
     typedef std::function<void(void*, solver::propagate_callback*, unsigned, expr*)> fixed_eh_t;
     typedef std::function<void(void*, solver::propagate_callback*, unsigned, unsigned)> eq_eh_t;
+    typedef std::function<void(void*, solver::propagate_callback*, unsigned, unsigned const*, expr* const*, unsigned, unsigned const*, unsigned const*)> batch_eh_t;
     typedef std::function<void*(void*, ast_manager&, solver::context_obj*&)> fresh_eh_t;
     typedef std::function<void(void*)>                 push_eh_t;
     typedef std::function<void(void*,unsigned)>        pop_eh_t;
@@ -280,6 +287,14 @@ public:
         throw default_exception("user-propagators are only supported on the SMT solver");
     }
 
+    /**
+       \brief register a callback that receives the fixed values and equalities
+       since its last invocation in bulk, instead of one fixed_eh or eq_eh call per event.
+    */
+    virtual void user_propagate_register_batch(batch_eh_t& batch_eh) {
+        throw default_exception("user-propagators are only supported on the SMT solver");
+    }
+
     virtual unsigned user_propagate_register(expr* e) { 
         throw default_exception("user-propagators are only supported on the SMT solver");
     }
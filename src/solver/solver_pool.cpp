@@ -21,8 +21,25 @@ Notes:
 #include "solver/solver_na2as.h"
 #include "ast/proofs/proof_utils.h"
 #include "ast/ast_util.h"
+#include "util/scoped_ptr_vector.h"
 
 class pool_solver : public solver_na2as {
+
+    /**
+       \brief Result of a check for a set of assumptions.
+       Entries are valid as long as the assertions of the solver do not
+       change and the epoch of the pool is the same.
+    */
+    struct cache_entry {
+        unsigned_vector   m_key;     // sorted ids of the assumptions
+        unsigned          m_epoch;
+        lbool             m_status;
+        model_ref         m_model;
+        expr_ref_vector   m_core;
+        cache_entry(ast_manager& m): m_epoch(0), m_status(l_undef), m_core(m) {}
+    };
+    static const unsigned max_cache_size = 1024;
+
     solver_pool&       m_pool;
     app_ref            m_pred;
     proof_ref          m_proof;
@@ -35,6 +52,62 @@ class pool_solver : public solver_na2as {
     bool               m_dump_benchmarks;
     double             m_dump_threshold;
     unsigned           m_dump_counter;
+    scoped_ptr_vector<cache_entry> m_cache;
+    u_map<unsigned>    m_cache_index;   // hash of key -> position in m_cache
+    cache_entry*       m_cache_hit;     // the last check was answered by the cache
+    unsigned_vector    m_key;
+
+    void reset_cache() {
+        m_cache.reset();
+        m_cache_index.reset();
+        m_cache_hit = nullptr;
+    }
+
+    unsigned mk_key(unsigned num_assumptions, expr * const * assumptions) {
+        m_key.reset();
+        for (unsigned i = 0; i < num_assumptions; ++i)
+            m_key.push_back(assumptions[i]->get_id());
+        std::sort(m_key.begin(), m_key.end());
+        unsigned h = 17;
+        for (unsigned id : m_key)
+            h = combine_hash(h, id);
+        return h;
+    }
+
+    cache_entry* find_cache(unsigned h) {
+        unsigned idx;
+        if (!m_cache_index.find(h, idx))
+            return nullptr;
+        cache_entry* e = m_cache[idx];
+        if (e->m_epoch != m_pool.m_epoch || e->m_key != m_key)
+            return nullptr;
+        return e;
+    }
+
+    void insert_cache(unsigned h, lbool res) {
+        if (res == l_undef || m.proofs_enabled())
+            return;
+        if (m_cache.size() >= max_cache_size)
+            reset_cache();
+        cache_entry* e = nullptr;
+        unsigned idx;
+        if (m_cache_index.find(h, idx))
+            e = m_cache[idx];
+        else {
+            e = alloc(cache_entry, m);
+            m_cache_index.insert(h, m_cache.size());
+            m_cache.push_back(e);
+        }
+        e->m_key = m_key;
+        e->m_epoch = m_pool.m_epoch;
+        e->m_status = res;
+        e->m_model = nullptr;
+        e->m_core.reset();
+        if (res == l_true)
+            m_base->get_model(e->m_model);
+        else
+            get_unsat_core(e->m_core);
+    }
 
 
     bool is_virtual() const { return !m.is_true(m_pred); }
@@ -52,7 +125,8 @@ public:
         m_in_delayed_scope(false),
         m_dump_benchmarks(false),
         m_dump_threshold(5.0),
-        m_dump_counter(0) {
+        m_dump_counter(0),
+        m_cache_hit(nullptr) {
         if (is_virtual()) {
             solver_na2as::assert_expr_core2(m.mk_true(), pred);
         }
@@ -88,6 +162,11 @@ public:
     expr * get_assertion(unsigned idx) const override { return m_base->get_assertion(idx); }
 
     void get_unsat_core(expr_ref_vector& r) override {
+        if (m_cache_hit) {
+            r.reset();
+            r.append(m_cache_hit->m_core);
+            return;
+        }
         m_base->get_unsat_core(r);
         unsigned j = 0;
         for (unsigned i = 0; i < r.size(); ++i)
@@ -136,12 +215,20 @@ public:
         m_proof.reset();
         scoped_watch _t_(m_pool.m_check_watch);
         m_pool.m_stats.m_num_checks++;
+        m_cache_hit = nullptr;
+        unsigned h = mk_key(num_assumptions, assumptions);
+        if (m_head == m_assertions.size() && (m_cache_hit = find_cache(h))) {
+            m_pool.m_stats.m_num_cached_checks++;
+            set_status(m_cache_hit->m_status);
+            return m_cache_hit->m_status;
+        }
 
         stopwatch sw;
         sw.start();
         internalize_assertions();
         lbool res = m_base->check_sat(num_assumptions, assumptions);
         sw.stop();
+        insert_cache(h, res);
         switch (res) {
         case l_true:
             m_pool.m_check_sat_watch.add(sw);
@@ -170,6 +257,7 @@ public:
         m_proof.reset();
         scoped_watch _t_(m_pool.m_check_watch);
         m_pool.m_stats.m_num_checks++;
+        m_cache_hit = nullptr;
 
         stopwatch sw;
         sw.start();
@@ -198,6 +286,7 @@ public:
 
     void push_core() override {
         SASSERT(!m_pushed || get_scope_level() > 0);
+        reset_cache();
         if (m_in_delayed_scope) {
             // second push
             internalize_assertions();
@@ -218,8 +307,10 @@ public:
     void pop_core(unsigned n) override {
         unsigned lvl = get_scope_level();
         SASSERT(!m_pushed || lvl > 0);
+        reset_cache();
         if (m_pushed) {
             SASSERT(!m_in_delayed_scope);
+            m_pool.m_epoch++;
             m_base->pop(n);
             m_pushed = lvl - n > 0;
         }
@@ -231,6 +322,7 @@ public:
     void assert_expr_core(expr * e) override {
         SASSERT(!m_pushed || get_scope_level() > 0);
         if (m.is_true(e)) return;
+        reset_cache();
         if (m_in_delayed_scope) {
             internalize_assertions();
             m_base->push();
@@ -239,6 +331,8 @@ public:
         }
 
         if (m_pushed) {
+            // the assertion is not guarded by an activation literal.
+            m_pool.m_epoch++;
             m_base->assert_expr(e);
         }
         else {
@@ -249,7 +343,12 @@ public:
         }
     }
 
-    void get_model_core(model_ref & _m) override { m_base->get_model_core(_m); }
+    void get_model_core(model_ref & _m) override {
+        if (m_cache_hit) 
+            _m = m_cache_hit->m_model ? m_cache_hit->m_model->copy() : nullptr;
+        else
+            m_base->get_model_core(_m);
+    }
 
     expr * get_assumption(unsigned idx) const override {
         return solver_na2as::get_assumption(idx + is_virtual());
@@ -264,17 +363,35 @@ public:
 
     ast_manager& get_manager() const override { return m_base->get_manager(); }
 
+    bool is_pushed() const { return m_pushed; }
+
     void refresh(solver* new_base) {
         SASSERT(!m_pushed);
         m_head = 0;
         m_base = new_base;
+        reset_cache();
     }
 
+    /**
+       \brief Remove the assertions of the solver.
+       The activation literal of a virtual solver is retired and replaced by a
+       fresh one, the base solver is recycled by the pool once it has
+       accumulated enough dead activation literals.
+    */
     void reset() {
         SASSERT(!m_pushed);
         m_head = 0;
         m_assertions.reset();
-        m_pool.refresh(m_base.get());
+        reset_cache();
+        if (is_virtual() && get_scope_level() == 0) {
+            m_base->assert_expr(m.mk_not(m_pred));
+            m_pred = m_pool.mk_pred();
+            m_assumptions.set(0, m_pred);
+            m_pool.retire(m_base.get());
+        }
+        else {
+            m_pool.refresh(m_base.get());
+        }
     }
 
 private:
@@ -333,7 +450,10 @@ private:
 solver_pool::solver_pool(solver* base_solver, unsigned num_pools):
     m_base_solver(base_solver),
     m_num_pools(num_pools),
-    m_current_pool(0)
+    m_current_pool(0),
+    m_num_preds(0),
+    m_epoch(0),
+    m_max_dead(64)
 {
     SASSERT(num_pools > 0);
 }
@@ -351,6 +471,7 @@ ptr_vector<solver> solver_pool::get_base_solvers() const {
 }
 
 void solver_pool::updt_params(const params_ref &p) {
+    m_max_dead = p.get_uint("max_dead_literals", 64);
     m_base_solver->updt_params(p);
     for (solver *s : m_solvers) s->updt_params(p);
 }
@@ -364,6 +485,8 @@ void solver_pool::collect_statistics(statistics &st) const {
     st.update("pool_solver.checks", m_stats.m_num_checks);
     st.update("pool_solver.checks.sat", m_stats.m_num_sat_checks);
     st.update("pool_solver.checks.undef", m_stats.m_num_undef_checks);
+    st.update("pool_solver.checks.cached", m_stats.m_num_cached_checks);
+    st.update("pool_solver.recycled", m_stats.m_num_recycled);
 }
 
 void solver_pool::reset_statistics() {
@@ -397,9 +520,7 @@ solver* solver_pool::mk_solver() {
         solver* s = m_solvers[(m_current_pool++) % m_num_pools];
         base_solver = dynamic_cast<pool_solver*>(s)->base_solver();
     }
-    std::stringstream name;
-    name << "vsolver#" << m_solvers.size();
-    app_ref pred(m.mk_const(symbol(name.str()), m.mk_bool_sort()), m);
+    app_ref pred = mk_pred();
     pool_solver* solver = alloc(pool_solver, base_solver.get(), *this, pred);
     m_solvers.push_back(solver);
     return solver;
@@ -411,9 +532,46 @@ void solver_pool::reset_solver(solver* s) {
     if (ps) ps->reset();
 }
 
+app_ref solver_pool::mk_pred() {
+    ast_manager& m = m_base_solver->get_manager();
+    std::stringstream name;
+    name << "vsolver#" << m_num_preds++;
+    return app_ref(m.mk_const(symbol(name.str()), m.mk_bool_sort()), m);
+}
+
+/**
+   \brief Record that an activation literal of base_solver is dead.
+   The base solver is replaced by a fresh copy of the original base solver
+   when it has m_max_dead dead literals and none of its solvers has scopes.
+*/
+void solver_pool::retire(solver* base_solver) {
+    unsigned i = 0;
+    for (; i < m_num_dead.size() && m_num_dead[i].first != base_solver; ++i)
+        ;
+    if (i == m_num_dead.size())
+        m_num_dead.push_back(std::make_pair(base_solver, 0u));
+    if (++m_num_dead[i].second < m_max_dead)
+        return;
+    for (solver* s0 : m_solvers) {
+        pool_solver* s = dynamic_cast<pool_solver*>(s0);
+        if (base_solver == s->base_solver() && s->is_pushed())
+            return;
+    }
+    m_stats.m_num_recycled++;
+    refresh(base_solver);
+}
+
 void solver_pool::refresh(solver* base_solver) {
     ast_manager& m = m_base_solver->get_manager();
     ref<solver> new_base = m_base_solver->translate(m, m_base_solver->get_params());
+    m_epoch++;
+    for (unsigned i = 0; i < m_num_dead.size(); ++i) {
+        if (m_num_dead[i].first == base_solver) {
+            m_num_dead[i] = m_num_dead.back();
+            m_num_dead.pop_back();
+            break;
+        }
+    }
     for (solver* s0 : m_solvers) {
         pool_solver* s = dynamic_cast<pool_solver*>(s0);
         if (base_solver == s->base_solver()) {
@@ -37,6 +37,8 @@ class solver_pool {
         unsigned m_num_checks;
         unsigned m_num_sat_checks;
         unsigned m_num_undef_checks;
+        unsigned m_num_cached_checks;
+        unsigned m_num_recycled;
         stats() { reset(); }
         void reset() { memset(this, 0, sizeof(*this)); }
     };
@@ -46,6 +48,10 @@ class solver_pool {
     unsigned            m_current_pool;
     sref_vector<solver> m_solvers;
     stats               m_stats;
+    unsigned            m_num_preds;
+    unsigned            m_epoch;          // incremented when assertions outside of activation literals change
+    unsigned            m_max_dead;       // recycle a base solver with this many dead activation literals
+    svector<std::pair<solver*, unsigned>> m_num_dead;
 
     stopwatch m_check_watch;
     stopwatch m_check_sat_watch;
@@ -53,6 +59,8 @@ class solver_pool {
     stopwatch m_proof_watch;
 
     void refresh(solver* s);
+    void retire(solver* s);
+    app_ref mk_pred();
 
     ptr_vector<solver> get_base_solvers() const;
   
@@ -27,6 +27,7 @@ Notes:
 class card2bv_tactic : public tactic {
     ast_manager &              m;
     params_ref                 m_params;
+    statistics                 m_stats;
     
 public:
 
@@ -52,6 +53,13 @@ public:
         rw.collect_param_descrs(r);
     }
 
+    void collect_statistics(statistics & st) const override {
+        st.copy(m_stats);
+    }
+
+    void reset_statistics() override {
+        m_stats.reset();
+    }
     
     void operator()(goal_ref const & g, 
                     goal_ref_buffer & result) override {
@@ -84,6 +92,7 @@ public:
         for (expr* e : fmls) {
             g->assert_expr(e);
         }
+        rw2.collect_statistics(m_stats);
 
         func_decl_ref_vector const& fns = rw2.fresh_constants();
         if (!fns.empty()) {
@@ -22,6 +22,15 @@ Notes:
 #include "ast/ast_pp.h"
 #include "model/model_pp.h"
 #include "ast/rewriter/rewriter_types.h"
+#include "ast/ast_translation.h"
+#include "ast/for_each_expr.h"
+#include "ast/bv_decl_plugin.h"
+#include "util/union_find.h"
+#include "util/scoped_ptr_vector.h"
+#ifndef SINGLE_THREAD
+#include <mutex>
+#include "util/thread_pool.h"
+#endif
 
 class bit_blaster_tactic : public tactic {
 
@@ -31,6 +40,8 @@ class bit_blaster_tactic : public tactic {
         bit_blaster_rewriter*  m_rewriter;    
         unsigned               m_num_steps;
         bool                   m_blast_quant;
+        unsigned               m_threads;
+        params_ref             m_params;
 
         imp(ast_manager & m, bit_blaster_rewriter* rw, params_ref const & p):
             m_base_rewriter(m, p),
@@ -40,9 +51,11 @@ class bit_blaster_tactic : public tactic {
 
         void updt_params_core(params_ref const & p) {
             m_blast_quant = p.get_bool("blast_quant", false);
+            m_threads     = p.get_uint("blast_threads", 1);
         }
 
         void updt_params(params_ref const & p) {
+            m_params = p;
             m_rewriter->updt_params(p);
             updt_params_core(p);
         }
@@ -61,6 +74,9 @@ class bit_blaster_tactic : public tactic {
             
             TRACE("before_bit_blaster", g->display(tout););
             m_num_steps = 0;
+
+            if (blast_parallel(g, result))
+                return;
             
             m_rewriter->start_rewrite();
             expr_ref   new_curr(m());
@@ -96,6 +112,175 @@ class bit_blaster_tactic : public tactic {
             m_rewriter->cleanup();
         }
         
+        /**
+           \brief Bit-blast groups of assertions that share no uninterpreted constants on separate threads.
+           
+           Each group is translated into a private manager, blasted there and translated back
+           in group order. The fresh bit constants of group i are numbered from an offset
+           computed from the bit-widths of the constants in the groups before i, so the result
+           does not depend on thread scheduling.
+           Return false if the goal is not split, then the caller blasts sequentially.
+        */
+        bool blast_parallel(goal_ref const & g, goal_ref_buffer & result) {
+#ifdef SINGLE_THREAD
+            return false;
+#else
+            unsigned size = g->size();
+            if (m_threads <= 1 || size <= 1 || g->proofs_enabled() || m_blast_quant || m_rewriter != &m_base_rewriter || g->inconsistent())
+                return false;
+
+            // partition assertions by shared uninterpreted constants.
+            basic_union_find uf;
+            obj_map<func_decl, unsigned> owner;
+            unsigned_vector weight;
+            for (unsigned idx = 0; idx < size; ++idx) {
+                uf.mk_var();
+                weight.push_back(0);
+            }
+            for (unsigned idx = 0; idx < size; ++idx) {
+                for (expr* e : subterms::ground(expr_ref(g->form(idx), m()))) {
+                    ++weight[idx];
+                    if (!is_uninterp_const(e))
+                        continue;
+                    func_decl* f = to_app(e)->get_decl();
+                    unsigned j;
+                    if (owner.find(f, j))
+                        uf.merge(idx, j);
+                    else
+                        owner.insert(f, idx);
+                }
+            }
+
+            // assign groups to buckets, balancing the number of subterms.
+            unsigned_vector group2bucket(size, UINT_MAX);
+            unsigned num_groups = 0;
+            for (unsigned idx = 0; idx < size; ++idx) 
+                if (uf.find(idx) == idx)
+                    ++num_groups;
+            if (num_groups <= 1)
+                return false;
+            unsigned num_buckets = std::min(m_threads, num_groups);
+            unsigned_vector load(num_buckets, 0u);
+            vector<unsigned_vector> bucket2forms(num_buckets);
+            unsigned_vector group_weight(size, 0u);
+            for (unsigned idx = 0; idx < size; ++idx) 
+                group_weight[uf.find(idx)] += weight[idx];
+            for (unsigned idx = 0; idx < size; ++idx) {
+                unsigned root = uf.find(idx);
+                if (group2bucket[root] == UINT_MAX) {
+                    unsigned best = 0;
+                    for (unsigned b = 1; b < num_buckets; ++b)
+                        if (load[b] < load[best])
+                            best = b;
+                    group2bucket[root] = best;
+                    load[best] += group_weight[root];
+                }
+                bucket2forms[group2bucket[root]].push_back(idx);
+            }
+
+            // reserve fresh identifiers for the bits created in each bucket.
+            bv_util bv(m());
+            unsigned_vector fresh_start;
+            unsigned fresh = m().get_fresh_id();
+            for (unsigned b = 0; b < num_buckets; ++b) {
+                fresh_start.push_back(fresh);
+                for (auto const& [f, idx] : owner) 
+                    if (group2bucket[uf.find(idx)] == b && bv.is_bv_sort(f->get_range()))
+                        fresh += bv.get_bv_size(f->get_range());
+            }
+            fresh_start.push_back(fresh);
+
+            scoped_ptr_vector<ast_manager> managers;
+            scoped_ptr_vector<bit_blaster_rewriter> rewriters;
+            vector<expr_ref_vector> forms, results;
+            for (unsigned b = 0; b < num_buckets; ++b) {
+                ast_manager* bm = alloc(ast_manager, m(), true);
+                bm->update_fresh_id(fresh_start[b]);
+                managers.push_back(bm);
+                rewriters.push_back(alloc(bit_blaster_rewriter, *bm, m_params));
+                ast_translation tr(m(), *bm);
+                forms.push_back(expr_ref_vector(*bm));
+                results.push_back(expr_ref_vector(*bm));
+                for (unsigned idx : bucket2forms[b])
+                    forms.back().push_back(tr(g->form(idx)));
+            }
+            
+            unsigned_vector num_steps(num_buckets, 0u);
+            std::string ex_msg;
+            bool has_exception = false;
+            std::mutex mux;
+            auto worker = [&](unsigned b) {
+                try {
+                    bit_blaster_rewriter& rw = *rewriters[b];
+                    ast_manager& bm = *managers[b];
+                    rw.start_rewrite();
+                    expr_ref r(bm);
+                    proof_ref pr(bm);
+                    for (expr* f : forms[b]) {
+                        rw(f, r, pr);
+                        num_steps[b] += rw.get_num_steps();
+                        results[b].push_back(r);
+                    }
+                }
+                catch (z3_exception& ex) {
+                    std::lock_guard<std::mutex> lock(mux);
+                    ex_msg = ex.msg();
+                    has_exception = true;
+                }
+            };
+            thread_pool threads;
+            for (unsigned b = 0; b < num_buckets; ++b)
+                threads.run([&, b]() { worker(b); });
+            threads.join();
+            if (has_exception)
+                throw tactic_exception(std::move(ex_msg));
+
+            // fall back if a bucket created more fresh symbols than were reserved.
+            for (unsigned b = 0; b < num_buckets; ++b) 
+                if (managers[b]->get_fresh_id() > fresh_start[b + 1])
+                    return false;
+            
+            obj_map<func_decl, expr*> const2bits;
+            ptr_vector<func_decl> newbits;
+            expr_ref_vector pinned(m());
+            func_decl_ref_vector pinned_decls(m());
+            bool change = false;
+            for (unsigned b = 0; b < num_buckets; ++b) {
+                ast_translation tr(*managers[b], m());
+                m_num_steps += num_steps[b];
+                if (g->models_enabled()) {
+                    obj_map<func_decl, expr*> b_const2bits;
+                    ptr_vector<func_decl> b_newbits;
+                    rewriters[b]->end_rewrite(b_const2bits, b_newbits);
+                    for (auto const& [f, bits] : b_const2bits) {
+                        pinned_decls.push_back(tr(f));
+                        pinned.push_back(tr(bits));
+                        const2bits.insert(pinned_decls.back(), pinned.back());
+                    }
+                    for (func_decl* f : b_newbits) {
+                        pinned_decls.push_back(tr(f));
+                        newbits.push_back(pinned_decls.back());
+                    }
+                }
+                for (unsigned i = 0; i < bucket2forms[b].size(); ++i) {
+                    unsigned idx = bucket2forms[b][i];
+                    expr_ref new_curr(tr(results[b].get(i)), m());
+                    if (new_curr != g->form(idx)) {
+                        change = true;
+                        g->update(idx, new_curr, nullptr, g->dep(idx));
+                    }
+                }
+            }
+            m().update_fresh_id(fresh);
+            if (change && g->models_enabled()) 
+                g->add(mk_bit_blaster_model_converter(m(), const2bits, newbits));
+            g->inc_depth();
+            result.push_back(g.get());
+            IF_VERBOSE(10, verbose_stream() << "(bit-blaster :threads " << num_buckets << " :groups " << num_groups << ")\n");
+            return true;
+#endif
+        }
+
         unsigned get_num_steps() const { return m_num_steps; }
     };
 
@@ -130,6 +315,7 @@ public:
         r.insert("blast_mul", CPK_BOOL, "(default: true) bit-blast multipliers (and dividers, remainders).");
         r.insert("blast_add", CPK_BOOL, "(default: true) bit-blast adders.");
         r.insert("blast_quant", CPK_BOOL, "(default: false) bit-blast quantified variables.");
+        r.insert("blast_threads", CPK_UINT, "(default: 1) number of threads used for bit-blasting independent groups of assertions.");
         r.insert("blast_full", CPK_BOOL, "(default: false) bit-blast any term with bit-vector sort, this option will make E-matching ineffective in any pattern containing bit-vector terms.");
     }
      
@@ -11,6 +11,9 @@ Abstract:
     The idea is to rewrite AC terms to maximize sharing.
     This rewriter is particularly useful for reducing
     the number of Adders and Multipliers before "bit-blasting".
+    With pair_frequency, the arguments of AC terms are first
+    grouped by the number of AC terms in the goal that
+    contain both arguments.
 
 Author:
 
@@ -24,20 +27,27 @@ Revision History:
 #include "ast/rewriter/rewriter_def.h"
 #include "util/obj_pair_hashtable.h"
 #include "ast/ast_lt.h"
+#include "ast/for_each_expr.h"
 
 class max_bv_sharing_tactic : public tactic {
     
     struct rw_cfg : public default_rewriter_cfg {
         typedef std::pair<expr *, expr *> expr_pair;
         typedef obj_pair_hashtable<expr, expr> set;
+        typedef obj_pair_map<expr, expr, unsigned> pair_count;
         bv_util            m_util;
         set                m_add_apps;
         set                m_mul_apps;
         set                m_xor_apps;
         set                m_or_apps;
+        pair_count         m_add_freq;
+        pair_count         m_mul_freq;
+        pair_count         m_xor_freq;
+        pair_count         m_or_freq;
         unsigned long long m_max_memory;
         unsigned           m_max_steps;
         unsigned           m_max_args;
+        bool               m_pair_frequency;
         
         ast_manager & m() const { return m_util.get_manager(); }
         
@@ -51,12 +61,17 @@ class max_bv_sharing_tactic : public tactic {
             m_mul_apps.finalize();
             m_or_apps.finalize();
             m_xor_apps.finalize();
+            m_add_freq.reset();
+            m_mul_freq.reset();
+            m_xor_freq.reset();
+            m_or_freq.reset();
         }
 
         void updt_params(params_ref const & p) {
             m_max_memory     = megabytes_to_bytes(p.get_uint("max_memory", UINT_MAX));
             m_max_steps      = p.get_uint("max_steps", UINT_MAX);
             m_max_args       = p.get_uint("max_args", 128);
+            m_pair_frequency = p.get_bool("pair_frequency", true);
         }
 
         bool max_steps_exceeded(unsigned num_steps) const { 
@@ -77,6 +92,95 @@ class max_bv_sharing_tactic : public tactic {
             }
         }
 
+        pair_count & f2freq(func_decl * f) {
+            switch (f->get_decl_kind()) {
+            case OP_BADD: return m_add_freq;
+            case OP_BMUL: return m_mul_freq;
+            case OP_BXOR: return m_xor_freq;
+            case OP_BOR:  return m_or_freq;
+            default:
+                UNREACHABLE();
+                return m_or_freq; // avoid compilation error
+            }
+        }
+
+        static bool is_ac_app(bv_util & u, expr * e) {
+            return u.is_bv_add(e) || u.is_bv_mul(e) || u.is_bv_xor(e) || u.is_bv_or(e);
+        }
+
+        static expr_pair mk_key(expr * arg1, expr * arg2) {
+            return arg1->get_id() < arg2->get_id() ? expr_pair(arg1, arg2) : expr_pair(arg2, arg1);
+        }
+
+        unsigned freq(pair_count const & c, expr * arg1, expr * arg2) const {
+            expr_pair k = mk_key(arg1, arg2);
+            unsigned r = 0;
+            c.find(k.first, k.second, r);
+            return r;
+        }
+
+        /**
+           \brief Count for every pair of non-numeral arguments of the AC term a
+           the number of AC terms with the same operator that contain both.
+        */
+        void count_pairs(app * a) {
+            unsigned num_args = a->get_num_args();
+            if (!is_ac_app(m_util, a) || num_args >= m_max_args)
+                return;
+            pair_count & c = f2freq(a->get_decl());
+            for (unsigned i = 0; i < num_args; i++) {
+                expr * arg1 = a->get_arg(i);
+                if (m_util.is_numeral(arg1))
+                    continue;
+                for (unsigned j = i + 1; j < num_args; j++) {
+                    expr * arg2 = a->get_arg(j);
+                    if (arg1 == arg2 || m_util.is_numeral(arg2))
+                        continue;
+                    expr_pair k = mk_key(arg1, arg2);
+                    c.insert_if_not_there(k.first, k.second, 0)++;
+                }
+            }
+        }
+
+        /**
+           \brief Combine first the pairs of arguments that occur together in
+           most AC terms, such that their sums and products are shared.
+           Pairs that occur only once are left to the tree construction.
+        */
+        void pair_by_frequency(set & s, func_decl * f, ptr_buffer<expr, 128> & args, unsigned & num_args) {
+            pair_count const & c = f2freq(f);
+            if (c.empty())
+                return;
+            svector<std::pair<unsigned, std::pair<unsigned, unsigned>>> cands;
+            for (unsigned i = 0; i < num_args; i++) {
+                for (unsigned j = i + 1; j < num_args; j++) {
+                    unsigned n = freq(c, args[i], args[j]);
+                    if (n > 1)
+                        cands.push_back(std::make_pair(n, std::make_pair(i, j)));
+                }
+            }
+            if (cands.empty())
+                return;
+            std::stable_sort(cands.begin(), cands.end(), [](auto const & a, auto const & b) { return a.first > b.first; });
+            ptr_buffer<expr, 128> new_args;
+            bool_vector used(num_args, false);
+            for (auto const & cand : cands) {
+                unsigned i = cand.second.first, j = cand.second.second;
+                if (used[i] || used[j])
+                    continue;
+                used[i] = used[j] = true;
+                s.insert(expr_pair(args[i], args[j]));
+                new_args.push_back(m().mk_app(f, args[i], args[j]));
+            }
+            for (unsigned i = 0; i < num_args; i++)
+                if (!used[i])
+                    new_args.push_back(args[i]);
+            TRACE("bv_sharing_detail", tout << "paired by frequency: " << num_args << " -> " << new_args.size() << "\n";);
+            num_args = new_args.size();
+            for (unsigned i = 0; i < num_args; i++)
+                args[i] = new_args[i];
+        }
+
         expr * reuse(set & s, func_decl * f, expr * arg1, expr * arg2) {
             if (s.contains(expr_pair(arg1, arg2)))
                 return m().mk_app(f, arg1, arg2);
@@ -169,6 +273,8 @@ class max_bv_sharing_tactic : public tactic {
             }
             return BR_DONE;
 #else       
+            if (m_pair_frequency && num_args > 2 && num_args < m_max_args)
+                pair_by_frequency(s, f, _args, num_args);
             // Create "tree-like circuit"
             while (true) {
                 TRACE("bv_sharing_detail", tout << "tree-loop: num_args: " << num_args << "\n";);
@@ -242,6 +348,14 @@ class max_bv_sharing_tactic : public tactic {
             expr_ref   new_curr(m());
             proof_ref  new_pr(m());
             unsigned size = g->size();
+            expr_ref_vector fmls(m());
+            if (m_rw.cfg().m_pair_frequency) {
+                for (unsigned idx = 0; idx < size; idx++)
+                    fmls.push_back(g->form(idx));
+                for (expr * t : subterms::ground(fmls))
+                    if (is_app(t))
+                        m_rw.cfg().count_pairs(to_app(t));
+            }
             for (unsigned idx = 0; idx < size; idx++) {
                 if (g->inconsistent())
                     break;
@@ -287,6 +401,8 @@ public:
         insert_max_steps(r);
         r.insert("max_args", CPK_UINT, 
                  "(default: 128) maximum number of arguments (per application) that will be considered by the greedy (quadratic) heuristic.");
+        r.insert("pair_frequency", CPK_BOOL,
+                 "(default: true) group arguments of AC terms by the number of terms that contain them together.");
     }
     
     void operator()(goal_ref const & in, 
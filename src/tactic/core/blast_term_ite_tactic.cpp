@@ -20,6 +20,7 @@ Notes:
 #include "ast/rewriter/rewriter_def.h"
 #include "ast/scoped_proof.h"
 #include "tactic/tactical.h"
+#include "tactic/goal_shared_occs.h"
 #include "tactic/tactic_params.hpp"
 
 
@@ -28,6 +29,13 @@ Notes:
 // (f (if c1 (if c2 e1 e2) e3) b c) -> 
 // (if c1 (if c2 (f e1 b c)
 //
+// Each step duplicates the application of f. When the if-then-else term
+// is shared, the duplication is repeated for every occurrence, so on goals
+// with a deeply shared if-then-else DAG the size grows exponentially.
+// With blast_term_ite.shared the terms that are shared in the goal are not
+// lifted, and blast_term_ite.max_growth bounds the number of steps for the
+// whole goal.
+//
 
 
 class blast_term_ite_tactic : public tactic {
@@ -39,13 +47,21 @@ class blast_term_ite_tactic : public tactic {
         unsigned             m_max_steps;
         unsigned             m_max_inflation;
         unsigned             m_init_term_size;
+        unsigned             m_max_growth;
+        unsigned             m_num_growth; // number of expansions for the goal
+        bool                 m_shared;
+        goal_shared_occs *   m_occs;
 
         rw_cfg(ast_manager & _m, params_ref const & p):
             m(_m),
             m_num_fresh(0),
             m_max_steps(UINT_MAX), 
             m_max_inflation(UINT_MAX), 
-            m_init_term_size(0) {
+            m_init_term_size(0),
+            m_max_growth(UINT_MAX),
+            m_num_growth(0),
+            m_shared(false),
+            m_occs(nullptr) {
             updt_params(p);
         }
 
@@ -54,6 +70,8 @@ class blast_term_ite_tactic : public tactic {
             m_max_memory    = megabytes_to_bytes(p.get_uint("max_memory", UINT_MAX));
             m_max_steps = p.get_uint("max_steps", tp.blast_term_ite_max_steps());
             m_max_inflation = p.get_uint("max_inflation", tp.blast_term_ite_max_inflation());  // multiplicative factor of initial term size.
+            m_max_growth = p.get_uint("max_growth", tp.blast_term_ite_max_growth());
+            m_shared = p.get_bool("shared", tp.blast_term_ite_shared());
         }
 
         
@@ -72,10 +90,15 @@ class blast_term_ite_tactic : public tactic {
                 m_init_term_size > 0 && 
                 m_max_inflation * m_init_term_size < m_num_fresh) 
                 return BR_FAILED;
+            if (m_num_growth >= m_max_growth)
+                return BR_FAILED;
             
             for (unsigned i = 0; i < num_args; ++i) {
                 expr* c, *t, *e;
                 if (!m.is_bool(args[i]) && m.is_ite(args[i], c, t, e)) {
+                    // terms created by earlier steps are not in m_occs and are lifted.
+                    if (m_occs && m_occs->is_shared(args[i]))
+                        continue;
                     TRACE("blast_term_ite", result = m.mk_app(f, num_args, args); tout << result << "\n";);
                     expr_ref e1(m), e2(m);
                     ptr_vector<expr> args1(num_args, args);
@@ -90,6 +113,7 @@ class blast_term_ite_tactic : public tactic {
                         e2 = m.mk_app(f, num_args, args1.data());
                         result = m.mk_ite(c, e1, e2);
                         ++m_num_fresh;
+                        ++m_num_growth;
                         return BR_REWRITE3;
                     }
                 }
@@ -135,6 +159,13 @@ class blast_term_ite_tactic : public tactic {
             proof_ref  new_pr(m);
             unsigned   size = g->size();
             unsigned   num_fresh = 0;
+            unsigned   size_before = g->num_exprs();
+            goal_shared_occs occs(m);
+            if (m_rw.m_cfg.m_shared) {
+                occs(*g);
+                m_rw.m_cfg.m_occs = &occs;
+            }
+            m_rw.m_cfg.m_num_growth = 0;
             for (unsigned idx = 0; idx < size; idx++) {
                 expr * curr = g->form(idx);
                 if (m_rw.m_cfg.m_max_inflation < UINT_MAX) {
@@ -149,7 +180,10 @@ class blast_term_ite_tactic : public tactic {
                 }
                 g->update(idx, new_curr, new_pr, g->dep(idx));
             }
+            m_rw.m_cfg.m_occs = nullptr;
             report_tactic_progress(":blast-term-ite-consts", m_rw.m_cfg.m_num_fresh + num_fresh);
+            report_tactic_progress(":blast-term-ite-size-before", size_before);
+            report_tactic_progress(":blast-term-ite-size-after", g->num_exprs());
             g->inc_depth();
             result.push_back(g.get());
         }
@@ -180,6 +214,8 @@ public:
         insert_max_memory(r);
         insert_max_steps(r);
         r.insert("max_inflation", CPK_UINT, "(default: infinity) multiplicative factor of initial term size.");
+        r.insert("max_growth", CPK_UINT, "(default: infinity) maximal number of if-then-else terms introduced for a goal.");
+        r.insert("shared", CPK_BOOL, "(default: false) do not duplicate if-then-else terms that are shared in the goal.");
     }
     
     void operator()(goal_ref const & in, goal_ref_buffer & result) override {
@@ -131,6 +131,8 @@ void expr_dominators::extract_tree() {
 }
 
 bool expr_dominators::compile(expr * e) {
+    if (is_compiled(e))
+        return true;
     reset();
     m_root = e;
     compute_post_order();
@@ -194,6 +196,7 @@ void dom_simplify_tactic::cleanup() {
     m_args.reset();
     m_result.reset();
     m_dominators.reset();
+    m_subexpr_cache.reset();
 }
 
 expr_ref dom_simplify_tactic::simplify_ite(app * ite) {
@@ -301,7 +304,6 @@ expr_ref dom_simplify_tactic::simplify_rec(expr * e0) {
     cache(e0, r);
     CTRACE("simplify", e0 != r, tout << "depth: " << m_depth << " " << mk_pp(e0, m) << " -> " << r << "\n";);
     --m_depth;
-    m_subexpr_cache.reset();
     return r;
 }
 
@@ -375,6 +377,7 @@ bool dom_simplify_tactic::init(goal& g) {
     expr_ref fml = mk_and(args);
     m_result.reset();
     m_trail.reset();
+    m_subexpr_cache.reset();
     return m_dominators.compile(fml);
 }
 
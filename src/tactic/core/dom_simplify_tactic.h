@@ -55,6 +55,10 @@ public:
 
     bool compile(expr * e);
     bool compile(unsigned sz, expr * const* es);
+    /**
+       \brief the dominator tree of e is available from a previous compilation.
+    */
+    bool is_compiled(expr * e) const { return e == m_root && !m_tree.empty(); }
     tree_t const& get_tree() { return m_tree; }
     void reset();
     expr* idom(expr *e) const { return m_doms[e]; }
@@ -760,6 +760,13 @@ class elim_uncnstr_tactic : public tactic {
     ref<mc>                          m_mc;
     obj_hashtable<expr>              m_vars;
     scoped_ptr<rw>                   m_rw;
+    // number of occurrences of the subterms of the goal, counted as in collect_occs:
+    // the edges from the distinct subterms and the formulas of the goal.
+    // It is updated when a formula is rewritten.
+    obj_map<expr, unsigned>          m_occs;
+    ptr_vector<expr>                 m_occs_todo;
+    ptr_vector<expr>                 m_occs_changed;
+    bool                             m_new_uncnstr = false;
     unsigned                         m_num_elim_apps = 0;
     unsigned long long               m_max_memory;
     unsigned                         m_max_steps;
@@ -777,6 +784,66 @@ class elim_uncnstr_tactic : public tactic {
         m_rw = alloc(rw, m(), produce_proofs, m_vars, m_mc.get(), m_max_memory, m_max_steps);            
     }
 
+    template<typename F>
+    void push_children(expr * e, F& f) {
+        if (is_app(e))
+            for (expr * arg : *to_app(e))
+                f(arg);
+        else if (is_quantifier(e))
+            f(to_quantifier(e)->get_expr());
+    }
+
+    void inc_occs(expr * e) {
+        m_occs_todo.push_back(e);
+        auto push = [&](expr* arg) { m_occs_todo.push_back(arg); };
+        while (!m_occs_todo.empty()) {
+            e = m_occs_todo.back();
+            m_occs_todo.pop_back();
+            if (is_uninterp_const(e))
+                m_occs_changed.push_back(e);
+            if (m_occs.insert_if_not_there(e, 0)++ == 0)
+                push_children(e, push);
+        }
+    }
+
+    void dec_occs(expr * e) {
+        m_occs_todo.push_back(e);
+        auto push = [&](expr* arg) { m_occs_todo.push_back(arg); };
+        while (!m_occs_todo.empty()) {
+            e = m_occs_todo.back();
+            m_occs_todo.pop_back();
+            if (is_uninterp_const(e))
+                m_occs_changed.push_back(e);
+            auto* entry = m_occs.find_core(e);
+            SASSERT(entry && entry->get_data().m_value > 0);
+            if (--entry->get_data().m_value == 0) {
+                m_occs.erase(e);
+                push_children(e, push);
+            }
+        }
+    }
+
+    /**
+       \brief the constants whose number of occurrences changed are unconstrained
+       if they occur once. Newly unconstrained constants are used by the
+       rewriter for the remaining formulas of the same pass.
+    */
+    void update_vars() {
+        for (expr * v : m_occs_changed) {
+            unsigned n = 0;
+            m_occs.find(v, n);
+            if (n == 1) {
+                if (!m_vars.contains(v)) {
+                    m_vars.insert(v);
+                    m_new_uncnstr = true;
+                }
+            }
+            else
+                m_vars.erase(v);
+        }
+        m_occs_changed.reset();
+    }
+
     void run(goal_ref const & g, goal_ref_buffer & result) {
         bool produce_proofs = g->proofs_enabled();
         
@@ -796,8 +863,14 @@ class elim_uncnstr_tactic : public tactic {
                 tout << "\n";);
         init_mc(g->models_enabled());
         init_rw(produce_proofs);
+        m_occs.reset();
+        m_new_uncnstr = false;
+        for (unsigned i = 0; i < g->size(); ++i)
+            inc_occs(g->form(i));
+        m_occs_changed.reset();
         
         expr_ref   new_f(m());
+        expr_ref   old_f(m());
         proof_ref  new_pr(m());
         unsigned round = 0;
         unsigned size  = g->size();
@@ -813,7 +886,20 @@ class elim_uncnstr_tactic : public tactic {
                     proof * pr = g->pr(idx);
                     new_pr     = m().mk_modus_ponens(pr, new_pr);
                 }
+                old_f = f;
+                unsigned old_size = g->size();
                 g->update(idx, new_f, new_pr, g->dep(idx));
+                if (g->inconsistent()) {
+                    m_new_uncnstr = false;
+                    break;
+                }
+                // the goal may simplify new_f and add its conjuncts at the end.
+                inc_occs(g->form(idx));
+                for (unsigned j = old_size; j < g->size(); ++j)
+                    inc_occs(g->form(j));
+                dec_occs(old_f);
+                old_f = nullptr;
+                update_vars();
             }
             if (!modified) {
                 if (round == 0) {                        
@@ -825,6 +911,7 @@ class elim_uncnstr_tactic : public tactic {
                 TRACE("elim_uncnstr", if (m_mc) m_mc->display(tout); else tout << "no mc\n";);
                 m_mc = nullptr;
                 m_rw = nullptr;                    
+                m_occs.reset();
                 result.push_back(g.get());
                 g->inc_depth();
                 TRACE("goal", g->display(tout););
@@ -834,15 +921,12 @@ class elim_uncnstr_tactic : public tactic {
             round ++;
             size       = g->size();
             m_rw->reset(); // reset cache
-            m_vars.reset(); 
-            {
-                collect_occs p;
-                p(*g, m_vars);
-            }
-            if (m_vars.empty()) 
+            // m_vars is up to date. Another pass is only useful if it changed.
+            if (m_vars.empty() || !m_new_uncnstr) 
                 idx = size; // force to finish 
             else
                 idx = 0;
+            m_new_uncnstr = false;
         }
     }
     
@@ -878,6 +962,7 @@ public:
         m_mc = nullptr;
         m_rw = nullptr;
         m_vars.reset();
+        m_occs.reset();
     }
 
     void collect_statistics(statistics & st) const override {
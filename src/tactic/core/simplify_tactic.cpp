@@ -19,16 +19,33 @@ Notes:
 #include "tactic/core/simplify_tactic.h"
 #include "ast/rewriter/th_rewriter.h"
 #include "ast/ast_pp.h"
+#include "ast/ast_translation.h"
+#include "ast/for_each_expr.h"
+#include "util/union_find.h"
+#include "util/scoped_ptr_vector.h"
+#ifndef SINGLE_THREAD
+#include <mutex>
+#include "util/thread_pool.h"
+#endif
 
 struct simplify_tactic::imp {
     ast_manager &   m_manager;
     th_rewriter     m_r;
     unsigned        m_num_steps;
+    params_ref      m_params;
+    unsigned        m_threads;
 
     imp(ast_manager & m, params_ref const & p):
         m_manager(m),
         m_r(m, p),
         m_num_steps(0) {
+        updt_params(p);
+    }
+
+    void updt_params(params_ref const & p) {
+        m_r.updt_params(p);
+        m_params = p;
+        m_threads = p.get_uint("simplify_threads", 1);
     }
 
     ~imp() {
@@ -47,6 +64,8 @@ struct simplify_tactic::imp {
         m_num_steps = 0;
         if (g.inconsistent())
             return;
+        if (simplify_parallel(g))
+            return;
         expr_ref   new_curr(m());
         proof_ref  new_pr(m());
         unsigned size = g.size();
@@ -67,6 +86,136 @@ struct simplify_tactic::imp {
         TRACE("after_simplifier_detail", g.display_with_dependencies(tout););
     }
 
+    /**
+       \brief Simplify groups of assertions that share no sub-terms on separate threads.
+
+       Each group is translated into a private manager with its own rewriter and cache,
+       simplified there and translated back in the order of the goal.
+       Return false if the goal is not split, then the caller simplifies sequentially.
+    */
+    bool simplify_parallel(goal & g) {
+#ifdef SINGLE_THREAD
+        return false;
+#else
+        unsigned size = g.size();
+        if (m_threads <= 1 || size <= 1 || g.proofs_enabled() || m().has_trace_stream())
+            return false;
+
+        // partition assertions by shared sub-terms other than values.
+        basic_union_find uf;
+        obj_map<expr, unsigned> owner;
+        unsigned_vector weight;
+        for (unsigned idx = 0; idx < size; ++idx) {
+            uf.mk_var();
+            weight.push_back(0);
+        }
+        for (unsigned idx = 0; idx < size; ++idx) {
+            for (expr* e : subterms::all(expr_ref(g.form(idx), m()))) {
+                ++weight[idx];
+                if (m().is_value(e))
+                    continue;
+                unsigned j;
+                if (owner.find(e, j))
+                    uf.merge(idx, j);
+                else
+                    owner.insert(e, idx);
+            }
+        }
+        unsigned num_groups = 0;
+        for (unsigned idx = 0; idx < size; ++idx)
+            if (uf.find(idx) == idx)
+                ++num_groups;
+        if (num_groups <= 1)
+            return false;
+
+        // assign groups to buckets, balancing the number of sub-terms.
+        unsigned num_buckets = std::min(m_threads, num_groups);
+        unsigned_vector load(num_buckets, 0u);
+        unsigned_vector group2bucket(size, UINT_MAX);
+        unsigned_vector group_weight(size, 0u);
+        vector<unsigned_vector> bucket2forms(num_buckets);
+        for (unsigned idx = 0; idx < size; ++idx)
+            group_weight[uf.find(idx)] += weight[idx];
+        for (unsigned idx = 0; idx < size; ++idx) {
+            unsigned root = uf.find(idx);
+            if (group2bucket[root] == UINT_MAX) {
+                unsigned best = 0;
+                for (unsigned b = 1; b < num_buckets; ++b)
+                    if (load[b] < load[best])
+                        best = b;
+                group2bucket[root] = best;
+                load[best] += group_weight[root];
+            }
+            bucket2forms[group2bucket[root]].push_back(idx);
+        }
+
+        scoped_ptr_vector<ast_manager> managers;
+        scoped_ptr_vector<th_rewriter> rewriters;
+        vector<expr_ref_vector> forms, results;
+        unsigned_vector fresh_start;
+        scoped_limits sl(m().limit());
+        for (unsigned b = 0; b < num_buckets; ++b) {
+            ast_manager* bm = alloc(ast_manager, m(), true);
+            bm->update_fresh_id(m().get_fresh_id());
+            fresh_start.push_back(bm->get_fresh_id());
+            managers.push_back(bm);
+            sl.push_child(&(bm->limit()));
+            rewriters.push_back(alloc(th_rewriter, *bm, m_params));
+            ast_translation tr(m(), *bm);
+            forms.push_back(expr_ref_vector(*bm));
+            results.push_back(expr_ref_vector(*bm));
+            for (unsigned idx : bucket2forms[b])
+                forms.back().push_back(tr(g.form(idx)));
+        }
+
+        unsigned_vector num_steps(num_buckets, 0u);
+        std::string ex_msg;
+        bool has_exception = false;
+        std::mutex mux;
+        auto worker = [&](unsigned b) {
+            try {
+                th_rewriter& rw = *rewriters[b];
+                expr_ref r(*managers[b]);
+                for (expr* f : forms[b]) {
+                    rw(f, r);
+                    num_steps[b] += rw.get_num_steps();
+                    results[b].push_back(r);
+                }
+            }
+            catch (z3_exception& ex) {
+                std::lock_guard<std::mutex> lock(mux);
+                ex_msg = ex.msg();
+                has_exception = true;
+            }
+        };
+        thread_pool threads;
+        for (unsigned b = 0; b < num_buckets; ++b)
+            threads.run([&, b]() { worker(b); });
+        threads.join();
+        if (has_exception)
+            throw tactic_exception(std::move(ex_msg));
+
+        // fresh symbols of different buckets could clash.
+        for (unsigned b = 0; b < num_buckets; ++b)
+            if (managers[b]->get_fresh_id() != fresh_start[b])
+                return false;
+
+        for (unsigned b = 0; b < num_buckets; ++b) {
+            ast_translation tr(*managers[b], m());
+            m_num_steps += num_steps[b];
+            for (unsigned i = 0; i < bucket2forms[b].size(); ++i) {
+                unsigned idx = bucket2forms[b][i];
+                expr_ref new_curr(tr(results[b].get(i)), m());
+                g.update(idx, new_curr, nullptr, g.dep(idx));
+            }
+        }
+        IF_VERBOSE(10, verbose_stream() << "(simplifier :threads " << num_buckets << " :groups " << num_groups << ")\n");
+        TRACE("simplifier", g.display(tout););
+        g.elim_redundancies();
+        return true;
+#endif
+    }
+
     unsigned get_num_steps() const { return m_num_steps; }
 };
 
@@ -81,11 +230,12 @@ simplify_tactic::~simplify_tactic() {
 
 void simplify_tactic::updt_params(params_ref const & p) {
     m_params = p;
-    m_imp->m_r.updt_params(p);
+    m_imp->updt_params(p);
 }
 
 void simplify_tactic::get_param_descrs(param_descrs & r) {
     th_rewriter::get_param_descrs(r);
+    r.insert("simplify_threads", CPK_UINT, "(default: 1) number of threads used for simplifying independent groups of assertions.");
 }
 
 void simplify_tactic::operator()(goal_ref const & in, 
@@ -54,6 +54,14 @@ class solve_eqs_tactic : public tactic {
         ptr_vector<app>               m_vars;
         expr_sparse_mark              m_nonzero;
         ptr_vector<app>               m_ordered_vars;
+        // uninterpreted constants of the arguments of m_arg_occs_app, with the number
+        // of arguments they occur in. Used by occurs_except for large sums.
+        app*                          m_arg_occs_app { nullptr };
+        obj_map<expr, unsigned>       m_arg_occs;
+        // uninterpreted constants to the formulas of the goal that contain them.
+        // Used by the context solver, it is built on demand in each round.
+        obj_map<expr, unsigned_vector> m_occ_index;
+        bool                          m_occ_index_valid { false };
         bool                          m_produce_proofs;
         bool                          m_produce_unsat_cores;
         bool                          m_produce_models;
@@ -181,6 +189,12 @@ class solve_eqs_tactic : public tactic {
         */
         bool occurs_except(expr * x, app * t, unsigned i) {
             unsigned num = t->get_num_args();
+            if (num > 8 && is_uninterp_const(x)) {
+                init_arg_occs(t);
+                unsigned n = 0;
+                m_arg_occs.find(x, n);
+                return n > (occurs(x, t->get_arg(i)) ? 1u : 0u);
+            }
             for (unsigned j = 0; j < num; j++) {
                 if (i != j && occurs(x, t->get_arg(j)))
                     return true;
@@ -188,6 +202,54 @@ class solve_eqs_tactic : public tactic {
             return false;
         }
 
+        void collect_uninterp_consts(expr * e, expr_mark & visited, ptr_buffer<expr> & result) {
+            ptr_buffer<expr> todo;
+            todo.push_back(e);
+            while (!todo.empty()) {
+                e = todo.back();
+                todo.pop_back();
+                if (visited.is_marked(e))
+                    continue;
+                visited.mark(e, true);
+                if (is_uninterp_const(e))
+                    result.push_back(e);
+                else if (is_app(e))
+                    todo.append(to_app(e)->get_num_args(), to_app(e)->get_args());
+                else if (is_quantifier(e))
+                    todo.push_back(to_quantifier(e)->get_expr());
+            }
+        }
+
+        void init_arg_occs(app * t) {
+            if (m_arg_occs_app == t)
+                return;
+            m_arg_occs_app = t;
+            m_arg_occs.reset();
+            ptr_buffer<expr> consts;
+            for (expr * arg : *t) {
+                expr_mark visited;
+                consts.reset();
+                collect_uninterp_consts(arg, visited, consts);
+                for (expr * c : consts)
+                    m_arg_occs.insert_if_not_there(c, 0)++;
+            }
+        }
+
+        void init_occ_index(goal const & g) {
+            if (m_occ_index_valid)
+                return;
+            m_occ_index_valid = true;
+            m_occ_index.reset();
+            ptr_buffer<expr> consts;
+            for (unsigned j = 0; j < g.size(); ++j) {
+                expr_mark visited;
+                consts.reset();
+                collect_uninterp_consts(g.form(j), visited, consts);
+                for (expr * c : consts)
+                    m_occ_index.insert_if_not_there(c, unsigned_vector()).push_back(j);
+            }
+        }
+
         void add_pos(expr* f) {
             expr* lhs = nullptr, *rhs = nullptr;
             rational val;
@@ -438,6 +500,7 @@ class solve_eqs_tactic : public tactic {
             m_marked_candidates.reset();
             m_vars.reset();
             m_nonzero.reset();
+            m_arg_occs_app = nullptr;
             app_ref  var(m());
             expr_ref  def(m());
             proof_ref pr(m());
@@ -475,11 +538,11 @@ class solve_eqs_tactic : public tactic {
         };
 
         ptr_vector<expr> m_todo;       
-        void mark_occurs(expr_mark& occ, goal const& g, expr* v) {
+        void mark_occurs(expr_mark& occ, goal const& g, unsigned_vector const& forms, expr* v) {
             expr_fast_mark2 visited;
             occ.mark(v, true);
             visited.mark(v, true);
-            for (unsigned j = 0; j < g.size(); ++j) {              
+            for (unsigned j : forms) {              
                 m_todo.push_back(g.form(j));
             }
             while (!m_todo.empty()) {
@@ -524,16 +587,19 @@ class solve_eqs_tactic : public tactic {
             }
         }
 
+        // only the formulas that contain v need to be checked
         bool is_compatible(goal const& g, unsigned idx, vector<nnf_context> const & path, expr* v, expr* eq) {
             expr_mark occ;
             svector<lbool> cache;
-            mark_occurs(occ, g, v);
-            return is_goal_compatible(g, occ, cache, idx, v, eq) && is_path_compatible(occ, cache, path, v, eq);
+            init_occ_index(g);
+            unsigned_vector const& forms = m_occ_index.insert_if_not_there(v, unsigned_vector());
+            mark_occurs(occ, g, forms, v);
+            return is_goal_compatible(g, occ, cache, forms, idx, v, eq) && is_path_compatible(occ, cache, path, v, eq);
         }
 
-        bool is_goal_compatible(goal const& g, expr_mark& occ, svector<lbool>& cache, unsigned idx, expr* v, expr* eq) {
+        bool is_goal_compatible(goal const& g, expr_mark& occ, svector<lbool>& cache, unsigned_vector const& forms, unsigned idx, expr* v, expr* eq) {
             bool all_e = false;
-            for (unsigned j = 0; j < g.size(); ++j) {              
+            for (unsigned j : forms) {              
                 if (j != idx && !check_eq_compat_rec(occ, cache, g.form(j), v, eq, all_e)) {
                     TRACE("solve_eqs", tout << "occurs goal " << mk_pp(eq, m()) << "\n";);
                     return false;
@@ -684,10 +750,13 @@ class solve_eqs_tactic : public tactic {
             unsigned size = g.size();
             ast_mark mark;
             vector<nnf_context> path;
+            m_occ_index_valid = false;
             for (unsigned idx = 0; idx < size; idx++) {
                 checkpoint();
                 hoist_nnf(g, g.form(idx), path, idx, 0, mark);
             }
+            m_occ_index.reset();
+            m_occ_index_valid = false;
         }
 
         void distribute_and_or(goal & g) {
@@ -914,9 +983,9 @@ class solve_eqs_tactic : public tactic {
         }
 
         void substitute(goal & g) {
-            // force the cache of m_r to be reset.
-            m_r->set_substitution(m_norm_subst.get());
-            
+            // the cache of m_r is shared with normalize: the variables are normalized
+            // in topological order, so the cached values do not depend on variables
+            // that were inserted into m_norm_subst after they were computed.
             expr_ref new_f(m());
             proof_ref new_pr(m());
             expr_dependency_ref new_dep(m());
@@ -1705,9 +1705,7 @@ namespace smtfd {
             for (unsigned round = 0; !m_context.at_max() && m_context.add_theory_axioms(terms, round); ++round) {}
             
             TRACE("smtfd", m_context.display(tout););
-            for (expr* f : m_context) {
-                assert_fd(f);
-            }
+            assert_lemmas();
             m_stats.m_num_lemmas += m_context.size();
             if (m_context.at_max()) {
                 m_context.set_max_lemmas(3*m_context.get_max_lemmas()/2);
@@ -1777,10 +1775,8 @@ namespace smtfd {
             if (!m_mbqi.check_quantifiers(core) && m_context.empty()) {
                 return l_false;
             }
-            for (expr* f : m_context) {
-                IF_VERBOSE(10, verbose_stream() << "lemma: " << f->get_id() << ": " << expr_ref(f, m) << "\n");
-                assert_fd(f);
-            }
+            IF_VERBOSE(10, for (expr* f : m_context) verbose_stream() << "lemma: " << f->get_id() << ": " << expr_ref(f, m) << "\n");
+            assert_lemmas();
             m_stats.m_num_mbqi += m_context.size();
             IF_VERBOSE(10, verbose_stream() << "context size: " << m_context.size() << "\n");
             return m_context.empty() ? is_decided : l_undef;
@@ -1827,7 +1823,6 @@ namespace smtfd {
         expr_ref_vector& abs(expr_ref_vector& v) { for (unsigned i = v.size(); i-- > 0; ) v[i] = abs(v.get(i)); return v; }
         
         void init() {
-            m_axioms.reset();
             if (!m_fd_sat_solver) {
                 m_fd_sat_solver = mk_fd_solver(m, get_params());
                 m_fd_core_solver = mk_fd_solver(m, get_params());
@@ -1917,6 +1912,22 @@ namespace smtfd {
         }
 
         void assert_fd(expr* fml) {
+            add_axiom(fml);
+            flush_atom_defs();
+        }
+
+        /**
+         * \brief assert the lemmas of the current round.
+         * The definitions of the new atoms are flushed once for the batch.
+         */
+        void assert_lemmas() {
+            for (expr* f : m_context) {
+                add_axiom(f);
+            }
+            flush_atom_defs();
+        }
+
+        void add_axiom(expr* fml) {
             expr_ref _fml(fml, m);
             TRACE("smtfd", tout << mk_bounded_pp(fml, m, 3) << "\n";);
             CTRACE("smtfd", m_axioms.contains(fml), 
@@ -1931,7 +1942,6 @@ namespace smtfd {
             TRACE("smtfd", tout << mk_bounded_pp(_fml, m, 3) << "\n";);
             m_fd_sat_solver->assert_expr(_fml);
             m_fd_core_solver->assert_expr(_fml);
-            flush_atom_defs();
         }
 
         void block_core(expr_ref_vector const& core) {
@@ -2007,9 +2017,7 @@ namespace smtfd {
                 TRACE("smtfd_verbose", 
                       for (expr* f : m_context) tout << "refine " << mk_bounded_pp(f, m, 3) << "\n";
                       m_context.display(tout););
-                for (expr* f : m_context) {
-                    assert_fd(f);
-                }        
+                assert_lemmas();
                 m_stats.m_num_lemmas += m_context.size();
                 m_context.reset(m_model);
                 r = check_abs(core.size(), core.data());
@@ -49,6 +49,8 @@ void generic_model_converter::operator()(model_ref & md) {
     expr_ref val(m);
     unsigned arity;
     bool reset_ev = false;
+    obj_map<func_decl, unsigned> first_use;
+    bool first_use_valid = false;
     for (unsigned i = m_entries.size(); i-- > 0; ) {
         entry const& e = m_entries[i];
         switch (e.m_instruction) {
@@ -82,6 +84,15 @@ void generic_model_converter::operator()(model_ref & md) {
                     md->register_decl(e.m_f, new_fi);
                 }
             }
+            if (reset_ev) {
+                if (!first_use_valid) {
+                    compute_first_use(first_use);
+                    first_use_valid = true;
+                }
+                unsigned j = 0;
+                // the cache is stale only if a definition that remains to be evaluated uses e.m_f
+                reset_ev = first_use.find(e.m_f, j) && j < i;
+            }
             if (reset_ev) {
                 ev.reset();
                 ev.set_model_completion(true);
@@ -93,6 +104,40 @@ void generic_model_converter::operator()(model_ref & md) {
     TRACE("model_converter", tout << "after generic_model_converter\n"; model_v2_pp(tout, *md););
 }
 
+/**
+   \brief Map every function symbol occurring in a definition to the
+   smallest index of an entry whose definition contains it.
+*/
+void generic_model_converter::compute_first_use(obj_map<func_decl, unsigned>& first_use) const {
+    expr_mark visited;
+    ptr_buffer<expr> todo;
+    for (unsigned i = 0; i < m_entries.size(); ++i) {
+        entry const& e = m_entries[i];
+        if (e.m_instruction != instruction::ADD)
+            continue;
+        todo.push_back(e.m_def);
+        while (!todo.empty()) {
+            expr* t = todo.back();
+            todo.pop_back();
+            if (visited.is_marked(t))
+                continue;
+            visited.mark(t, true);
+            if (is_app(t)) {
+                func_decl* f = to_app(t)->get_decl();
+                first_use.insert_if_not_there(f, i);
+                for (parameter const& p : f->parameters())
+                    if (p.is_ast() && is_func_decl(p.get_ast()))
+                        first_use.insert_if_not_there(to_func_decl(p.get_ast()), i);
+                for (expr* arg : *to_app(t))
+                    todo.push_back(arg);
+            }
+            else if (is_quantifier(t)) {
+                todo.push_back(to_quantifier(t)->get_expr());
+            }
+        }
+    }
+}
+
 void generic_model_converter::display(std::ostream & out) {
     for (entry const& e : m_entries) {
         switch (e.m_instruction) {
@@ -37,6 +37,8 @@ class generic_model_converter : public model_converter {
 
     expr_ref simplify_def(entry const& e);
 
+    void compute_first_use(obj_map<func_decl, unsigned>& first_use) const;
+
 public:
     generic_model_converter(ast_manager & m, char const* orig) : m(m), m_orig(orig) {}
     
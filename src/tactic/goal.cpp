@@ -659,6 +659,8 @@ bool goal::is_decided() const {
 }
 
 bool is_equal(goal const & s1, goal const & s2) {
+    if (&s1.m() == &s2.m() && s1.shares_forms(s2))
+        return true;
     if (s1.size() != s2.size())
         return false;
     unsigned num1 = 0; // num unique ASTs in s1
@@ -148,6 +148,8 @@ public:
     bool is_decided_unsat() const;
     bool is_decided() const;
     bool is_well_formed() const;
+    // the formulas of g are shared with this goal and neither goal was updated since it was copied
+    bool shares_forms(goal const & g) const { return m().is_shared(m_forms, g.m_forms); }
 
     dependency_converter* dc() { return m_dc.get(); }
     model_converter* mc() const { return m_mc.get(); }
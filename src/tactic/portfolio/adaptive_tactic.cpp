@@ -0,0 +1,382 @@
+/*++
+Copyright (c) 2021 Microsoft Corporation
+
+Module Name:
+
+    adaptive_tactic.cpp
+
+Abstract:
+
+    Strategy selection for the default tactic from a model over probe values.
+
+    The strategies are the ones of the default tactic. A strategy is
+    applicable if the probe of its logic holds, smt is always applicable.
+    The model file given by tactic.portfolio.model is a sequence of lines
+
+        features <probe> ... <probe>
+        <strategy> <bias> <weight> ... <weight> [:<param> <value>]*
+
+    The features line selects the probes used as features, by default all
+    the probes in the table below. Each strategy line gives a linear score
+    over log(1 + v) of the feature values v, and optionally parameters for
+    the strategy. A strategy can occur on several lines with different
+    parameters. Lines starting with # are comments.
+
+    The applicable entry with the highest score is run, where the score is
+    lowered by log(1 + t) for the average running time t of the entry
+    observed so far in the process. Without a model the first applicable
+    strategy is run, in the order of the default tactic.
+
+    If tactic.portfolio.log is set, every run appends the line
+
+        <strategy> <status> <seconds> <feature values>
+
+    to the log file, for training models offline.
+
+--*/
+#include <cmath>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include "util/stopwatch.h"
+#include "util/warning.h"
+#include "tactic/tactical.h"
+#include "tactic/tactic_params.hpp"
+#include "tactic/portfolio/adaptive_tactic.h"
+#include "tactic/core/simplify_tactic.h"
+#include "tactic/smtlogics/qfbv_tactic.h"
+#include "tactic/smtlogics/qflia_tactic.h"
+#include "tactic/smtlogics/qflra_tactic.h"
+#include "tactic/smtlogics/qfnia_tactic.h"
+#include "tactic/smtlogics/qfnra_tactic.h"
+#include "tactic/smtlogics/nra_tactic.h"
+#include "tactic/arith/probe_arith.h"
+#include "tactic/smtlogics/quant_tactics.h"
+#include "tactic/fpa/qffp_tactic.h"
+#include "tactic/fpa/qffplra_tactic.h"
+#include "tactic/smtlogics/qfaufbv_tactic.h"
+#include "tactic/smtlogics/qfauflia_tactic.h"
+#include "tactic/fd_solver/fd_solver.h"
+#include "tactic/smtlogics/smt_tactic.h"
+
+namespace {
+
+    struct feature_info {
+        char const* m_name;
+        probe* (*m_mk)();
+    };
+
+    static const feature_info g_features[] = {
+        { "size", mk_size_probe },
+        { "depth", mk_depth_probe },
+        { "num-exprs", mk_num_exprs_probe },
+        { "num-consts", mk_num_consts_probe },
+        { "num-bool-consts", mk_num_bool_consts_probe },
+        { "num-arith-consts", mk_num_arith_consts_probe },
+        { "num-bv-consts", mk_num_bv_consts_probe },
+        { "arith-max-deg", mk_arith_max_degree_probe },
+        { "arith-avg-deg", mk_arith_avg_degree_probe },
+        { "arith-max-bw", mk_arith_max_bw_probe },
+        { "arith-avg-bw", mk_arith_avg_bw_probe },
+        { "has-quantifiers", mk_has_quantifier_probe },
+    };
+
+    // average running times of the entries, shared by all instances of the tactic.
+    struct run_stats {
+        std::mutex                                          m_mux;
+        std::map<std::string, std::pair<unsigned, double>>  m_times;
+
+        double avg(std::string const& name) {
+            std::lock_guard<std::mutex> lock(m_mux);
+            auto it = m_times.find(name);
+            return it == m_times.end() ? 0.0 : it->second.second / it->second.first;
+        }
+
+        void add(std::string const& name, double secs) {
+            std::lock_guard<std::mutex> lock(m_mux);
+            auto& e = m_times[name];
+            e.first++;
+            e.second += secs;
+        }
+    };
+
+    run_stats& get_run_stats() {
+        static run_stats* s = new run_stats();
+        return *s;
+    }
+}
+
+class adaptive_tactic : public tactic {
+
+    struct strategy {
+        symbol      m_name;
+        probe_ref   m_applicable;
+        tactic_ref  m_tactic;
+    };
+
+    struct entry {
+        unsigned         m_strategy;
+        std::string      m_name;       // strategy and parameters
+        double           m_bias;
+        svector<double>  m_weights;
+        tactic_ref       m_tactic;
+    };
+
+    ast_manager&     m;
+    params_ref       m_params;
+    vector<strategy> m_strategies;
+    vector<probe_ref> m_features;
+    svector<char const*> m_feature_names;
+    vector<entry>    m_entries;
+    symbol           m_model_file;
+    symbol           m_log_file;
+    tactic_ref       m_last;
+
+    void add_strategy(char const* name, probe* p, tactic* t) {
+        m_strategies.push_back(strategy());
+        m_strategies.back().m_name = symbol(name);
+        m_strategies.back().m_applicable = p;
+        m_strategies.back().m_tactic = t;
+    }
+
+    void init_strategies() {
+        params_ref const& p = m_params;
+        add_strategy("fd", mk_and(mk_is_propositional_probe(), mk_not(mk_produce_proofs_probe())), mk_fd_tactic(m, p));
+        add_strategy("qfbv", mk_is_qfbv_probe(), mk_qfbv_tactic(m));
+        add_strategy("qfaufbv", mk_is_qfaufbv_probe(), mk_qfaufbv_tactic(m));
+        add_strategy("qflia", mk_is_qflia_probe(), mk_qflia_tactic(m));
+        add_strategy("qfauflia", mk_is_qfauflia_probe(), mk_qfauflia_tactic(m));
+        add_strategy("qflra", mk_is_qflra_probe(), mk_qflra_tactic(m));
+        add_strategy("qfnra", mk_is_qfnra_probe(), mk_qfnra_tactic(m));
+        add_strategy("qfnia", mk_is_qfnia_probe(), mk_qfnia_tactic(m));
+        add_strategy("lira", mk_is_lira_probe(), mk_lira_tactic(m, p));
+        add_strategy("nra", mk_is_nra_probe(), mk_nra_tactic(m));
+        add_strategy("qffp", mk_is_qffp_probe(), mk_qffp_tactic(m, p));
+        add_strategy("qffplra", mk_is_qffplra_probe(), mk_qffplra_tactic(m, p));
+        add_strategy("smt", mk_const_probe(1.0), and_then(mk_preamble_tactic(m), mk_smt_tactic(m)));
+    }
+
+    void add_feature(char const* name) {
+        for (auto const& f : g_features) {
+            if (strcmp(f.m_name, name) == 0) {
+                m_features.push_back(probe_ref(f.m_mk()));
+                m_feature_names.push_back(f.m_name);
+                return;
+            }
+        }
+        throw default_exception(std::string("unknown feature ") + name);
+    }
+
+    static void set_param(params_ref& p, std::string const& key, std::string const& value) {
+        char const* k = key.c_str();
+        if (value == "true" || value == "false")
+            p.set_bool(k, value == "true");
+        else if (!value.empty() && value.find_first_not_of("0123456789") == std::string::npos)
+            p.set_uint(k, static_cast<unsigned>(std::stoul(value)));
+        else if (!value.empty() && value.find_first_not_of("0123456789.") == std::string::npos)
+            p.set_double(k, std::stod(value));
+        else
+            p.set_sym(k, symbol(value.c_str()));
+    }
+
+    void load_model() {
+        m_entries.reset();
+        m_features.reset();
+        m_feature_names.reset();
+        if (m_model_file.is_null() || m_model_file.str().empty())
+            return;
+        std::ifstream in(m_model_file.str());
+        if (!in) {
+            warning_msg("could not open portfolio model %s", m_model_file.str().c_str());
+            return;
+        }
+        try {
+            std::string line;
+            while (std::getline(in, line)) {
+                std::istringstream ls(line);
+                std::string name;
+                if (!(ls >> name) || name[0] == '#')
+                    continue;
+                if (name == "features") {
+                    m_features.reset();
+                    m_feature_names.reset();
+                    std::string f;
+                    while (ls >> f)
+                        add_feature(f.c_str());
+                    continue;
+                }
+                if (m_features.empty())
+                    for (auto const& f : g_features)
+                        add_feature(f.m_name);
+                unsigned idx = 0;
+                while (idx < m_strategies.size() && m_strategies[idx].m_name != symbol(name.c_str()))
+                    ++idx;
+                if (idx == m_strategies.size())
+                    throw default_exception("unknown strategy " + name);
+                entry e;
+                e.m_strategy = idx;
+                e.m_name = name;
+                if (!(ls >> e.m_bias))
+                    throw default_exception("missing bias for " + name);
+                for (unsigned i = 0; i < m_features.size(); ++i) {
+                    double w;
+                    if (!(ls >> w))
+                        throw default_exception("missing weight for " + name);
+                    e.m_weights.push_back(w);
+                }
+                params_ref p;
+                std::string key, value;
+                while (ls >> key >> value) {
+                    if (key[0] != ':')
+                        throw default_exception("expected parameter for " + name);
+                    set_param(p, key.substr(1), value);
+                    e.m_name += " " + key + " " + value;
+                }
+                e.m_tactic = p.empty() ? m_strategies[idx].m_tactic.get() : using_params(m_strategies[idx].m_tactic.get(), p);
+                m_entries.push_back(e);
+            }
+        }
+        catch (default_exception& ex) {
+            warning_msg("invalid portfolio model %s: %s", m_model_file.str().c_str(), ex.msg());
+            m_entries.reset();
+        }
+    }
+
+    bool is_applicable(unsigned idx, goal const& g) {
+        return m_strategies[idx].m_applicable->operator()(g).is_true();
+    }
+
+    /**
+       \brief Select the entry to run, return its tactic and name.
+    */
+    tactic* select(goal const& g, svector<double> const& values, std::string& name) {
+        tactic* best = nullptr;
+        double best_score = 0;
+        for (entry const& e : m_entries) {
+            if (!is_applicable(e.m_strategy, g))
+                continue;
+            double score = e.m_bias;
+            for (unsigned i = 0; i < values.size(); ++i)
+                score += e.m_weights[i] * std::log(1 + std::max(0.0, values[i]));
+            score -= std::log(1 + get_run_stats().avg(e.m_name));
+            if (!best || score > best_score) {
+                best = e.m_tactic.get();
+                best_score = score;
+                name = e.m_name;
+            }
+        }
+        if (best)
+            return best;
+        for (unsigned idx = 0; idx < m_strategies.size(); ++idx) {
+            if (is_applicable(idx, g)) {
+                name = m_strategies[idx].m_name.str();
+                return m_strategies[idx].m_tactic.get();
+            }
+        }
+        UNREACHABLE();
+        return nullptr;
+    }
+
+    void log(std::string const& name, goal_ref_buffer const& result, bool failed, double secs, svector<double> const& values) {
+        if (m_log_file.is_null() || m_log_file.str().empty())
+            return;
+        std::ofstream out(m_log_file.str(), std::ios_base::app);
+        if (!out) 
+            return;
+        char const* status = failed ? "error" : is_decided_sat(result) ? "sat" : is_decided_unsat(result) ? "unsat" : "unknown";
+        out << name << " " << status << " " << secs;
+        for (double v : values)
+            out << " " << v;
+        out << "\n";
+    }
+
+public:
+    adaptive_tactic(ast_manager& m, params_ref const& p):
+        m(m),
+        m_params(p) {
+        init_strategies();
+        tactic_params tp(p);
+        m_model_file = tp.portfolio_model();
+        m_log_file = tp.portfolio_log();
+        load_model();
+    }
+
+    tactic* translate(ast_manager& m) override {
+        return alloc(adaptive_tactic, m, m_params);
+    }
+
+    void updt_params(params_ref const& p) override {
+        m_params.append(p);
+        tactic_params tp(m_params);
+        symbol model_file = tp.portfolio_model();
+        m_log_file = tp.portfolio_log();
+        for (strategy& s : m_strategies)
+            s.m_tactic->updt_params(p);
+        if (model_file != m_model_file) {
+            m_model_file = model_file;
+            load_model();
+        }
+    }
+
+    void collect_param_descrs(param_descrs& r) override {
+        for (strategy& s : m_strategies)
+            s.m_tactic->collect_param_descrs(r);
+    }
+
+    void operator()(goal_ref const& in, goal_ref_buffer& result) override {
+        svector<double> values;
+        if (!m_log_file.is_null() && m_features.empty())
+            for (auto const& f : g_features)
+                add_feature(f.m_name);
+        for (probe_ref& p : m_features)
+            values.push_back((*p)(*in).get_value());
+        std::string name;
+        tactic* t = select(*in, values, name);
+        IF_VERBOSE(10, verbose_stream() << "(adaptive :strategy " << name << ")\n");
+        m_last = t;
+        stopwatch sw;
+        sw.start();
+        try {
+            (*t)(in, result);
+        }
+        catch (...) {
+            sw.stop();
+            get_run_stats().add(name, sw.get_seconds());
+            log(name, result, true, sw.get_seconds(), values);
+            throw;
+        }
+        sw.stop();
+        get_run_stats().add(name, sw.get_seconds());
+        log(name, result, false, sw.get_seconds(), values);
+    }
+
+    void cleanup() override {
+        for (strategy& s : m_strategies)
+            s.m_tactic->cleanup();
+    }
+
+    void collect_statistics(statistics& st) const override {
+        if (m_last)
+            m_last->collect_statistics(st);
+    }
+
+    void reset_statistics() override {
+        for (strategy& s : m_strategies)
+            s.m_tactic->reset_statistics();
+    }
+
+    void set_logic(symbol const& l) override {
+        for (strategy& s : m_strategies)
+            s.m_tactic->set_logic(l);
+    }
+
+    void set_progress_callback(progress_callback* callback) override {
+        for (strategy& s : m_strategies)
+            s.m_tactic->set_progress_callback(callback);
+    }
+};
+
+tactic * mk_adaptive_tactic(ast_manager & m, params_ref const & p) {
+    return using_params(and_then(mk_simplify_tactic(m), alloc(adaptive_tactic, m, p)), p);
+}
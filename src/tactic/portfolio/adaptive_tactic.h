@@ -0,0 +1,23 @@
+/*++
+Copyright (c) 2021 Microsoft Corporation
+
+Module Name:
+
+    adaptive_tactic.h
+
+Abstract:
+
+    Strategy selection for the default tactic from a model over probe values.
+
+--*/
+#pragma once
+
+#include "util/params.h"
+class ast_manager;
+class tactic;
+
+tactic * mk_adaptive_tactic(ast_manager & m, params_ref const & p = params_ref());
+
+/*
+ADD_TACTIC("adaptive", "select the strategy of the default tactic using the model of tactic.portfolio.model.", "mk_adaptive_tactic(m, p)")
+*/
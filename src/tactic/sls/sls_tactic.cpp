@@ -26,9 +26,15 @@ Notes:
 #include "tactic/core/elim_uncnstr_tactic.h"
 #include "tactic/core/nnf_tactic.h"
 #include "util/stopwatch.h"
+#include "util/scoped_ptr_vector.h"
+#include "ast/ast_translation.h"
 #include "tactic/sls/sls_tactic.h"
 #include "tactic/sls/sls_params.hpp"
 #include "tactic/sls/sls_engine.h"
+#ifndef SINGLE_THREAD
+#include <mutex>
+#include "util/thread_pool.h"
+#endif
 
 class sls_tactic : public tactic {    
     ast_manager    & m;
@@ -67,12 +73,87 @@ public:
         tactic_report report("sls", *g);
         
         model_converter_ref mc;
-        m_engine->operator()(g, mc);
+        sls_params p(m_params);
+#ifndef SINGLE_THREAD
+        if (p.threads() > 1 && !g->inconsistent())
+            run_replicas(p.threads(), p.random_seed(), g, mc);
+        else
+#endif
+            m_engine->operator()(g, mc);
         g->add(mc.get());
         g->inc_depth();
         result.push_back(g.get());
     }
 
+#ifndef SINGLE_THREAD
+    /**
+       \brief run one engine per thread on a copy of the goal, each in its
+       own manager and with its own random seed. The first replica that
+       finds a model cancels the others.
+    */
+    void run_replicas(unsigned num_threads, unsigned seed, goal_ref const & g, model_converter_ref & mc) {
+        scoped_ptr_vector<ast_manager> managers;
+        scoped_limits sl(m.limit());
+        goal_ref_vector goals;
+        scoped_ptr_vector<sls_engine> engines;
+        vector<model_converter_ref> mcs;
+        for (unsigned i = 0; i < num_threads; ++i) {
+            ast_manager* rm = alloc(ast_manager, m, true);
+            managers.push_back(rm);
+            sl.push_child(&(rm->limit()));
+            ast_translation tr(m, *rm);
+            goals.push_back(g->translate(tr));
+            params_ref rp(m_params);
+            rp.set_uint("random_seed", seed + i);
+            engines.push_back(alloc(sls_engine, *rm, rp));
+            mcs.push_back(model_converter_ref());
+        }
+
+        std::mutex mux;
+        unsigned winner = UINT_MAX;
+        std::string ex_msg;
+        thread_pool threads;
+        for (unsigned i = 0; i < num_threads; ++i) {
+            threads.run([&, i]() {
+                try {
+                    model_converter_ref rmc;
+                    (*engines[i])(goals[i], rmc);
+                    if (goals[i]->size() != 0)
+                        return;
+                    std::lock_guard<std::mutex> lock(mux);
+                    if (winner != UINT_MAX)
+                        return;
+                    winner = i;
+                    mcs[i] = rmc;
+                    for (unsigned j = 0; j < num_threads; ++j)
+                        if (j != i)
+                            managers[j]->limit().cancel();
+                }
+                catch (z3_exception & ex) {
+                    // replicas that lost the race are canceled.
+                    std::lock_guard<std::mutex> lock(mux);
+                    if (ex_msg.empty())
+                        ex_msg = ex.msg();
+                }
+            });
+        }
+        threads.join();
+
+        if (winner == UINT_MAX) {
+            tactic::checkpoint(m);
+            if (!ex_msg.empty())
+                throw tactic_exception(std::move(ex_msg));
+            mc = nullptr;
+            return;
+        }
+        if (mcs[winner]) {
+            ast_translation tr(*managers[winner], m);
+            mc = mcs[winner]->translate(tr);
+        }
+        g->reset();
+    }
+#endif
+
     void cleanup() override {
         sls_engine * d = alloc(sls_engine, m, m_params);
         std::swap(d, m_engine);            
@@ -56,7 +56,8 @@ struct tactic_report::imp {
     }
 };
 
-tactic_report::tactic_report(char const * id, goal const & g) {
+tactic_report::tactic_report(char const * id, goal const & g):
+    m_phase(id) {
     if (get_verbosity_level() >= TACTIC_VERBOSITY_LVL)
         m_imp = alloc(imp, id, g);
     else
@@ -25,6 +25,7 @@ Notes:
 #include "util/statistics.h"
 #include "tactic/tactic_exception.h"
 #include "util/lbool.h"
+#include "util/phase_profiler.h"
 
 class progress_callback;
 
@@ -93,6 +94,7 @@ typedef sref_buffer<tactic> tactic_ref_buffer;
 class tactic_report {
     struct imp;
     imp *  m_imp;
+    scoped_phase m_phase;
 public:
     tactic_report(char const * id, goal const & g);
     ~tactic_report();
@@ -21,7 +21,7 @@ Notes:
 #include "util/scoped_ptr_vector.h"
 #include "tactic/tactical.h"
 #ifndef SINGLE_THREAD
-#include <thread>
+#include "util/thread_pool.h"
 #endif
 #include <vector>
 
@@ -463,14 +463,12 @@ public:
             }
         };
 
-        vector<std::thread> threads(sz);
+        thread_pool threads;
 
         for (unsigned i = 0; i < sz; ++i) {
-            threads[i] = std::thread([&, i]() { worker_thread(i); });
-        }
-        for (unsigned i = 0; i < sz; ++i) {
-            threads[i].join();
+            threads.run([&, i]() { worker_thread(i); });
         }
+        threads.join();
         
         if (finished_id == UINT_MAX) {
             switch (ex_kind) {
@@ -675,13 +673,11 @@ public:
             if (m.has_trace_stream())
                 throw default_exception("threads and trace are incompatible");
 
-            vector<std::thread> threads(r1_size);
-            for (unsigned i = 0; i < r1_size; ++i) {
-                threads[i] = std::thread([&, i]() { worker_thread(i); });
-            }
+            thread_pool threads;
             for (unsigned i = 0; i < r1_size; ++i) {
-                threads[i].join();
+                threads.run([&, i]() { worker_thread(i); });
             }
+            threads.join();
             
             if (failed) {
                 switch (ex_kind) {
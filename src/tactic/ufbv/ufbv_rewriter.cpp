@@ -43,6 +43,8 @@ ufbv_rewriter::ufbv_rewriter(ast_manager & m):
 
 ufbv_rewriter::~ufbv_rewriter() {
     reset_dealloc_values(m_fwd_idx);
+    for (auto & kv : m_fwd_arg_idx)
+        dealloc(kv.m_value);
     reset_dealloc_values(m_back_idx);
     for (auto & kv : m_demodulator2lhs_rhs) {
         m.dec_ref(kv.m_key);
@@ -211,6 +213,14 @@ void ufbv_rewriter::insert_fwd_idx(expr * large, expr * small, quantifier * demo
     SASSERT(it->m_value);
     it->m_value->insert(demodulator);
 
+    uint64_t key = fwd_arg_key(fd, to_app(large)->get_num_args(), to_app(large)->get_args());
+    quantifier_set * qs = nullptr;
+    if (!m_fwd_arg_idx.find(key, qs)) {
+        qs = alloc(quantifier_set, 1);
+        m_fwd_arg_idx.insert(key, qs);
+    }
+    qs->insert(demodulator);
+
     m.inc_ref(demodulator);
     m.inc_ref(large);
     m.inc_ref(small);
@@ -226,6 +236,10 @@ void ufbv_rewriter::remove_fwd_idx(func_decl * f, quantifier * demodulator) {
         expr_pair p = fit->m_value;
         m_demodulator2lhs_rhs.erase(demodulator);
         it->m_value->erase(demodulator);
+        app * large = to_app(p.first);
+        quantifier_set * qs = nullptr;
+        if (m_fwd_arg_idx.find(fwd_arg_key(f, large->get_num_args(), large->get_args()), qs))
+            qs->erase(demodulator);
         m.dec_ref(p.first);
         m.dec_ref(p.second);
         m.dec_ref(demodulator);
@@ -265,35 +279,52 @@ void ufbv_rewriter::show_fwd_idx(std::ostream & out) {
     }
 }
 
-bool ufbv_rewriter::rewrite1(func_decl * f, expr_ref_vector & m_new_args, expr_ref & np) {
-    fwd_idx_map::iterator it = m_fwd_idx.find_iterator(f);
-    if (it != m_fwd_idx.end()) {
-        TRACE("demodulator_bug", tout << "trying to rewrite: " << f->get_name() << " args:\n";
-              tout << m_new_args << "\n";);
-        for (quantifier* d : *it->m_value) {
+/**
+   \brief key of the demodulators for f(args) in m_fwd_arg_idx.
+   The key combines f with the top symbol of the first argument, or
+   is the variable key of f if there is no first argument that is an application.
+*/
+uint64_t ufbv_rewriter::fwd_arg_key(func_decl * f, unsigned num_args, expr * const * args) {
+    if (num_args == 0 || !is_app(args[0]))
+        return fwd_var_key(f);
+    return fwd_var_key(f) | (to_app(args[0])->get_decl()->get_id() + 1);
+}
 
-            SASSERT(m_demodulator2lhs_rhs.contains(d));
-            expr_pair l_s;
-            m_demodulator2lhs_rhs.find(d, l_s);
-            app * large = to_app(l_s.first);
+bool ufbv_rewriter::rewrite1(quantifier_set const & ds, expr_ref_vector & m_new_args, expr_ref & np) {
+    for (quantifier* d : ds) {
 
-            if (large->get_num_args() != m_new_args.size())
-                continue;
+        SASSERT(m_demodulator2lhs_rhs.contains(d));
+        expr_pair l_s;
+        m_demodulator2lhs_rhs.find(d, l_s);
+        app * large = to_app(l_s.first);
 
-            TRACE("demodulator_bug", tout << "Matching with demodulator: " << mk_pp(d, m) << std::endl; );
+        if (large->get_num_args() != m_new_args.size())
+            continue;
 
-            SASSERT(large->get_decl() == f);
+        TRACE("demodulator_bug", tout << "Matching with demodulator: " << mk_pp(d, m) << std::endl; );
 
-            if (m_match_subst(large, l_s.second, m_new_args.data(), np)) {
-                TRACE("demodulator_bug", tout << "succeeded...\n" << mk_pp(l_s.second, m) << "\n===>\n" << mk_pp(np, m) << "\n";);
-                return true;
-            }
+        if (m_match_subst(large, l_s.second, m_new_args.data(), np)) {
+            TRACE("demodulator_bug", tout << "succeeded...\n" << mk_pp(l_s.second, m) << "\n===>\n" << mk_pp(np, m) << "\n";);
+            return true;
         }
     }
-
     return false;
 }
 
+bool ufbv_rewriter::rewrite1(func_decl * f, expr_ref_vector & m_new_args, expr_ref & np) {
+    if (!m_fwd_idx.contains(f))
+        return false;
+    TRACE("demodulator_bug", tout << "trying to rewrite: " << f->get_name() << " args:\n";
+          tout << m_new_args << "\n";);
+    // only demodulators with the same top symbol in the first argument,
+    // or a variable as first argument, can match f(m_new_args).
+    quantifier_set * ds = nullptr;
+    uint64_t key = fwd_arg_key(f, m_new_args.size(), m_new_args.data());
+    if (key != fwd_var_key(f) && m_fwd_arg_idx.find(key, ds) && rewrite1(*ds, m_new_args, np))
+        return true;
+    return m_fwd_arg_idx.find(fwd_var_key(f), ds) && rewrite1(*ds, m_new_args, np);
+}
+
 bool ufbv_rewriter::rewrite_visit_children(app * a) {
     bool res=true;
     unsigned j = a->get_num_args();
@@ -488,15 +519,16 @@ public:
     }
 };
 
-void ufbv_rewriter::reschedule_processed(func_decl * f) {
+void ufbv_rewriter::reschedule_processed(func_decl * f, expr * lhs) {
     //use m_back_idx to find all formulas p in m_processed that contains f {
+    //the formulas without an instance of lhs are not changed by the new demodulator.
     back_idx_map::iterator it = m_back_idx.find_iterator(f);
     if (it != m_back_idx.end()) {
         SASSERT(it->m_value);
         expr_set temp;
 
         for (expr* p : *it->m_value) {
-            if (m_processed.contains(p))
+            if (m_processed.contains(p) && can_rewrite(p, lhs))
               temp.insert(p);
         }
 
@@ -679,7 +711,7 @@ void ufbv_rewriter::operator()(unsigned n, expr * const * exprs, proof * const *
             // let f be the top symbol of n'
             func_decl * f = large->get_decl();
 
-            reschedule_processed(f);
+            reschedule_processed(f, large);
             reschedule_demodulators(f, large);
 
             // insert n' into m_fwd_idx
@@ -26,6 +26,7 @@ Revision History:
 #include "util/obj_hashtable.h"
 #include "util/obj_pair_hashtable.h"
 #include "util/array_map.h"
+#include "util/map.h"
 
 /**
    \brief Apply demodulators as a preprocessing technique.
@@ -114,6 +115,7 @@ class ufbv_rewriter final {
     typedef obj_map<func_decl, expr_set *> back_idx_map;
     typedef obj_hashtable<quantifier> quantifier_set;
     typedef obj_map<func_decl, quantifier_set *> fwd_idx_map;
+    typedef u64_map<quantifier_set *> fwd_arg_idx_map;
     typedef obj_map<quantifier, expr_pair> demodulator2lhs_rhs;
     typedef expr_map rewrite_cache_map;
 
@@ -160,6 +162,7 @@ class ufbv_rewriter final {
     match_subst         m_match_subst;
     bool_rewriter       m_bsimp;
     fwd_idx_map         m_fwd_idx;
+    fwd_arg_idx_map     m_fwd_arg_idx;
     back_idx_map        m_back_idx;
     demodulator2lhs_rhs m_demodulator2lhs_rhs;
     expr_ref_buffer     m_todo;
@@ -171,6 +174,9 @@ class ufbv_rewriter final {
     rewrite_cache_map   m_rewrite_cache;
     expr_ref_buffer     m_new_exprs;
     
+    static uint64_t fwd_arg_key(func_decl * f, unsigned num_args, expr * const * args);
+    static uint64_t fwd_var_key(func_decl * f) { return static_cast<uint64_t>(f->get_id()) << 32; }
+    bool rewrite1(quantifier_set const & ds, expr_ref_vector & m_new_args, expr_ref & np);
     void insert_fwd_idx(expr * large, expr * small, quantifier * demodulator);
     void remove_fwd_idx(func_decl * f, quantifier * demodulator);
     bool check_fwd_idx_consistency();
@@ -182,7 +188,7 @@ class ufbv_rewriter final {
     bool rewrite1(func_decl * f, expr_ref_vector & m_new_args, expr_ref & np);
     bool rewrite_visit_children(app * a);
     void rewrite_cache(expr * e, expr * new_e, bool done);
-    void reschedule_processed(func_decl * f);
+    void reschedule_processed(func_decl * f, expr * lhs);
     void reschedule_demodulators(func_decl * f, expr * np);
     unsigned max_var_id(expr * e);
 
@@ -211,6 +217,8 @@ public:
       - m_todo:          The todo-stack of formulas to be processed.
       - m_fwd_idx:       "Forward index" for finding efficiently which demodulators can be used to rewrite an expression.
                          We organize this set as a mapping from func_decl to a set of demodulators which start with the same top symbol.
+      - m_fwd_arg_idx:   Refines m_fwd_idx by the top symbol of the first argument of the left-hand side. Demodulators
+                         whose first argument is a variable are stored under the variable key of the top symbol.
       - m_processed:     The set of already processed formulas. We can represent it using a hashtable.
       - m_back_idx:      "Backward index" we use it to find efficiently which already processed expressions and demodulators may be rewritten
                          by a new demodulator. Again, we use a very simple index, for each uninterpreted function symbol (ignore constants)
@@ -269,6 +269,35 @@ static void tst_dejan() {
     std::cout << "sum1: " << sum1 << " " << root_obj_pp(sum1) << "\n";
 }
 
+static void tst_compare_cache() {
+    reslimit rl;
+    unsynch_mpq_manager qm;
+    algebraic_numbers::manager am(rl, qm);
+
+    // a = 2^(1/2) and b = (2^(1/2) + 2^(1/3)) - 2^(1/3) are the same number
+    // defined by different polynomials with overlapping intervals.
+    scoped_anum a(am), b(am), c(am);
+    am.set(a, 2);
+    am.root(a, 2, a);
+    am.set(c, 2);
+    am.root(c, 3, c);
+    am.add(a, c, b);
+    am.sub(b, c, b);
+    for (unsigned i = 0; i < 3; ++i) {
+        ENSURE(am.compare(a, b) == 0);
+        ENSURE(am.compare(b, a) == 0);
+    }
+    // the cached result must not be used after the value of a changes
+    am.neg(a);
+    ENSURE(am.compare(a, b) < 0);
+    ENSURE(am.compare(b, a) > 0);
+    am.neg(b);
+    ENSURE(am.compare(a, b) == 0);
+    am.set(c, a);
+    ENSURE(am.compare(c, b) == 0);
+    std::cout << "compare cache: " << a << " " << b << "\n";
+}
+
 static void tst_select_small(mpbq_manager & m, scoped_mpbq const & l, scoped_mpbq const & u, bool expected) {
     scoped_mpbq r(m);
     std::cout << "----------\n";
@@ -643,6 +672,7 @@ void tst_algebraic() {
     tst_eval_sign();
     tst_select_small();
     tst_dejan();
+    tst_compare_cache();
     tst_wilkinson();
     tst1();
     tst_refine_mpbq();
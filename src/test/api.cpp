@@ -107,10 +107,31 @@ static void test_mk_distinct() {
     
 }
 
+static void test_mk_app_dag() {
+    Z3_config cfg = Z3_mk_config();
+    Z3_context ctx = Z3_mk_context(cfg);
+    Z3_sort bv8 = Z3_mk_bv_sort(ctx, 8);
+    Z3_ast x = Z3_mk_const(ctx, Z3_mk_string_symbol(ctx, "x"), bv8);
+    Z3_ast y = Z3_mk_const(ctx, Z3_mk_string_symbol(ctx, "y"), bv8);
+    Z3_func_decl decls[] = { Z3_get_app_decl(ctx, Z3_to_app(ctx, Z3_mk_bvadd(ctx, x, y))),
+                             Z3_get_app_decl(ctx, Z3_to_app(ctx, Z3_mk_eq(ctx, x, y))) };
+    Z3_ast leaves[] = { x, y };
+    // n0 = x + y, n1 = n0 + x, n2 = (n1 = y)
+    unsigned code[] = { 0, 2, 0, 1,   0, 2, 2, 0,   1, 2, 3, 1 };
+    Z3_ast nodes[3];
+    Z3_ast r = Z3_mk_app_dag(ctx, 2, decls, 2, leaves, 12, code, 3, nodes);
+    ENSURE(Z3_get_error_code(ctx) == Z3_OK);
+    ENSURE(r == nodes[2]);
+    ENSURE(Z3_is_eq_ast(ctx, nodes[1], Z3_mk_bvadd(ctx, nodes[0], x)));
+    Z3_del_config(cfg);
+    Z3_del_context(ctx);
+}
+
 void tst_api() {
     test_apps();
     test_bvneg();
     test_mk_distinct();
+    test_mk_app_dag();
 }
 #else
 void tst_api() {
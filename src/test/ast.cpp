@@ -17,6 +17,8 @@ Revision History:
 
 --*/
 #include "ast/ast.h"
+#include "ast/arith_decl_plugin.h"
+#include "ast/reg_decl_plugins.h"
 
 static void tst1() {
     ast_manager m;
@@ -131,6 +133,83 @@ static void tst5() {
     m.del(arr3);
 }
 
+#ifndef SINGLE_THREAD
+#include <thread>
+
+static void tst6() {
+    // terms created concurrently in a shared manager are hash-consed to the same node.
+    ast_manager m;
+    sort_ref s(m.mk_uninterpreted_sort(symbol("S")), m);
+    func_decl_ref f(m.mk_func_decl(symbol("f"), s, s, s), m);
+    app_ref a(m.mk_const(symbol("a"), s), m);
+    m.set_concurrent(true);
+    unsigned num_threads = 4, depth = 200;
+    vector<expr_ref_vector> results;
+    for (unsigned i = 0; i < num_threads; ++i) 
+        results.push_back(expr_ref_vector(m));
+    vector<std::thread> threads(num_threads);
+    for (unsigned i = 0; i < num_threads; ++i) {
+        threads[i] = std::thread([&, i]() {
+            expr_ref t(a, m);
+            for (unsigned j = 0; j < depth; ++j) {
+                t = m.mk_app(f.get(), t.get(), a.get());
+                results[i].push_back(t);
+            }
+        });
+    }
+    for (auto& th : threads)
+        th.join();
+    for (unsigned i = 1; i < num_threads; ++i) 
+        for (unsigned j = 0; j < depth; ++j) 
+            ENSURE(results[i].get(j) == results[0].get(j));
+    results.reset();
+    m.set_concurrent(false);
+}
+#else
+static void tst6() {}
+#endif
+
+static void tst7() {
+    // references that are still live when the manager is destroyed are released in bulk.
+    ast_manager* m = alloc(ast_manager);
+    reg_decl_plugins(*m);
+    {
+        arith_util a(*m);
+        expr_ref_vector es(*m);
+        expr_ref x(m->mk_const(symbol("x"), a.mk_int()), *m);
+        for (unsigned i = 0; i < 100; ++i) 
+            es.push_back(a.mk_add(x, a.mk_int(i)));
+        m->start_bulk_release();
+    }
+    ENSURE(m->get_num_asts() > 100);
+    dealloc(m);
+}
+
+static void tst8() {
+    // tree sizes are cached in the nodes, visit epochs nest by falling back to a table.
+    ast_manager m;
+    sort_ref s(m.mk_uninterpreted_sort(symbol("S")), m);
+    func_decl_ref f(m.mk_func_decl(symbol("f"), s, s, s), m);
+    expr_ref t(m.mk_const(symbol("a"), s), m);
+    for (unsigned i = 0; i < 40; ++i)
+        t = m.mk_app(f.get(), t.get(), t.get());
+    ENSURE(get_tree_size(t) == UINT_MAX);
+    expr_ref u(m.mk_app(f.get(), m.mk_const(symbol("b"), s), m.mk_const(symbol("c"), s)), m);
+    ENSURE(get_tree_size(u) == 3);
+    for (unsigned i = 0; i < 10000; ++i) {
+        expr_epoch_mark outer(m);
+        ENSURE(!outer.is_marked(u));
+        outer.mark(u);
+        {
+            expr_epoch_mark inner(m);
+            ENSURE(!inner.is_marked(u));
+            inner.mark(to_app(u)->get_arg(0));
+            ENSURE(inner.is_marked(to_app(u)->get_arg(0)));
+        }
+        ENSURE(outer.is_marked(u));
+        ENSURE(!outer.is_marked(to_app(u)->get_arg(0)));
+    }
+}
 
 struct foo {
     unsigned       m_id; 
@@ -153,5 +232,8 @@ void tst_ast() {
     tst3();
     tst4();
     tst5();
+    tst6();
+    tst7();
+    tst8();
 }
 
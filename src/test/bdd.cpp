@@ -73,6 +73,27 @@ namespace dd {
         std::cout << c1 << "\n";
         std::cout << c1.bdd_size() << "\n";
     }
+
+    static void test5() {
+        bdd_manager m(6);
+        bdd v0 = m.mk_var(0);
+        bdd v1 = m.mk_var(1);
+        bdd v2 = m.mk_var(2);
+        bdd v3 = m.mk_var(3);
+        bdd c1 = (v0 && v1) || (v2 && v3);
+        bdd c2 = m.mk_ite(v0, v1 || v3, v2 && v3);
+        bdd c3 = m.mk_exists(1, c1);
+        bdd x1 = v0 ^ v1 ^ v2 ^ v3;
+        m.gc();
+        // cached results computed before gc are still sound
+        SASSERT(c1 == ((v2 && v3) || (v1 && v0)));
+        SASSERT(c2 == m.mk_ite(v0, v1 || v3, v2 && v3));
+        SASSERT(c3 == m.mk_exists(1, (v0 && v1) || (v2 && v3)));
+        SASSERT(c3 == (v0 || (v2 && v3)));
+        SASSERT(x1 == (v3 ^ v2 ^ v1 ^ v0));
+        SASSERT((x1 ^ v0) == (v1 ^ v2 ^ v3));
+        SASSERT((c1 && !c1) == m.mk_false());
+    }
 }
 
 void tst_bdd() {
@@ -80,4 +101,5 @@ void tst_bdd() {
     dd::test2();
     dd::test3();
     dd::test4();
+    dd::test5();
 }
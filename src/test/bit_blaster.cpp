@@ -188,6 +188,30 @@ void tst_multiplier(ast_manager & m, bit_blaster & blaster) {
     ENSURE_INT(mdl, c, 7); // b111 * b001
 }
 
+void tst_gates(ast_manager & m, bit_blaster & blaster) {
+    app_ref b1(m.mk_const("b1", m.mk_bool_sort()), m);
+    app_ref b2(m.mk_const("b2", m.mk_bool_sort()), m);
+    expr_ref r1(m), r2(m), t(m);
+
+    // gates that only differ in the order of their inputs are shared
+    blaster.mk_and(b1, b2, r1);
+    blaster.mk_and(b2, b1, r2);
+    ENSURE(r1 == r2);
+    blaster.mk_or(b1, b2, r1);
+    blaster.mk_or(b2, b1, r2);
+    ENSURE(r1 == r2);
+
+    // two-level absorption
+    blaster.mk_or(b1, b2, t);
+    blaster.mk_and(b1, t, r1);
+    ENSURE(r1 == b1.get());
+    blaster.mk_and(t, b2, r1);
+    ENSURE(r1 == b2.get());
+    blaster.mk_and(b1, b2, t);
+    blaster.mk_or(t, b1, r1);
+    ENSURE(r1 == b1.get());
+}
+
 void tst_le(ast_manager & m, unsigned sz) {
 //     expr_ref_vector a(m);
 //     expr_ref_vector b(m);
@@ -239,6 +263,7 @@ void tst_bit_blaster() {
 
     tst_adder(m, blaster);
     tst_multiplier(m, blaster);
+    tst_gates(m, blaster);
     tst_le(m, 4);
     tst_eqs(m, 8);
     tst_sh(m, 4);
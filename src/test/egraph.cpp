@@ -129,9 +129,57 @@ static void test3() {
         std::cout << "conflict: " << *j << "\n";
 }
 
+// merge chains of unary terms with and without deferred rebuilding, and undo the merges.
+static void test4(bool batch) {
+    ast_manager m;
+    reg_decl_plugins(m);
+    euf::egraph g(m);
+    g.set_batch_merge(batch);
+    sort_ref S(m.mk_uninterpreted_sort(symbol("S")), m);
+    unsigned d = 20, w = 20;
+    euf::enode_vector nodes, top_nodes;
+    expr_ref_vector pinned(m);
+    for (unsigned i = 0; i < w; ++i) {
+        std::string xn("x");
+        xn += std::to_string(i);
+        expr_ref x = mk_const(m, xn.c_str(), S);
+        euf::enode* n = g.mk(x, 0, 0, nullptr);
+        nodes.push_back(n);
+        for (unsigned j = 0; j < d; ++j) {
+            std::string f("f");
+            f += std::to_string(j);
+            x = mk_app(f.c_str(), x, S);
+            n = g.mk(x, 0, 1, &n);
+        }
+        top_nodes.push_back(n);
+        pinned.push_back(x);
+    }
+    for (unsigned k = 0; k < 2; ++k) {
+        g.push();
+        for (unsigned i = 1; i < w; i += 2)
+            g.merge(nodes[i], nodes[i - 1], nullptr);
+        g.propagate();
+        g.push();
+        for (unsigned i = 2; i < w; i += 2)
+            g.merge(nodes[i], nodes[0], nullptr);
+        g.propagate();
+        for (euf::enode* n : top_nodes)
+            VERIFY(n->get_root() == top_nodes[0]->get_root());
+        g.pop(1);
+        for (unsigned i = 1; i < w; ++i)
+            VERIFY((top_nodes[i]->get_root() == top_nodes[i - 1]->get_root()) == (i % 2 == 1));
+        g.pop(1);
+        for (unsigned i = 1; i < w; ++i)
+            VERIFY(top_nodes[i]->get_root() != top_nodes[0]->get_root());
+        DEBUG_CODE(g.invariant(););
+    }
+}
+
 void tst_egraph() {
     enable_trace("euf");
     test3();
     test1();
     test2();
+    test4(false);
+    test4(true);
 }
@@ -16,6 +16,57 @@ Author:
 Revision History:
 
 --*/
+#include<iostream>
+#include<unordered_set>
+#include<stdlib.h>
+#include "util/hashtable.h"
+#include "util/swiss_hashtable.h"
+
+struct swiss_int_hash_proc { unsigned operator()(int x) const { return x * 2654435761u; } };
+typedef swiss_hashtable<int_hash_entry<INT_MIN, INT_MIN + 1>, swiss_int_hash_proc, default_eq<int> > swiss_int_set;
+
+static void tst_swiss(unsigned range) {
+    swiss_int_set h1;
+    std::unordered_set<int> h2;
+    for (unsigned i = 0; i < 20000; ++i) {
+        int v = rand() % range;
+        switch (rand() % 4) {
+        case 0:
+            h1.erase(v);
+            h2.erase(v);
+            ENSURE(!h1.contains(v));
+            break;
+        case 1: {
+            int_hash_entry<INT_MIN, INT_MIN + 1>* e = nullptr;
+            bool is_new = h1.insert_if_not_there_core(v, e);
+            ENSURE(is_new == h2.insert(v).second);
+            ENSURE(e && e->get_data() == v);
+            break;
+        }
+        default:
+            h1.insert(v);
+            h2.insert(v);
+            ENSURE(h1.contains(v));
+            break;
+        }
+        ENSURE(h1.size() == h2.size());
+    }
+    for (int v : h2)
+        ENSURE(h1.contains(v));
+    unsigned n = 0;
+    for (int v : h1) {
+        ENSURE(h2.count(v) == 1);
+        ++n;
+    }
+    ENSURE(n == h1.size());
+    swiss_int_set h3(h1);
+    ENSURE(h3.size() == h1.size());
+    for (int v : h2)
+        ENSURE(h3.contains(v));
+    h1.reset();
+    ENSURE(h1.empty() && !h1.contains(*h2.begin()));
+}
+
 #ifdef _WINDOWS
 #include<iostream>
 #include<unordered_set>
@@ -124,8 +175,12 @@ void tst_hashtable() {
     for (int i = 0; i < 100; i++) 
         tst2();
     tst1();
+    tst_swiss(100);
+    tst_swiss(100000);
 }
 #else
 void tst_hashtable() {
+    tst_swiss(100);
+    tst_swiss(100000);
 }
 #endif
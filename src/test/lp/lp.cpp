@@ -59,6 +59,7 @@
 #include "math/lp/cross_nested.h"
 #include "math/lp/int_cube.h"
 #include "math/lp/emonics.h"
+#include "math/lp/small_rational.h"
 namespace nla {
 void test_horner();
 void test_monics();
@@ -2163,6 +2164,7 @@ void setup_args_parser(argument_parser & parser) {
     parser.add_option_with_help_string("-nla_blnt_fm", "test_basic_lemma_for_mon_neutral_from_factors_to_monomial");
     parser.add_option_with_help_string("-hnf", "test hermite normal form");
     parser.add_option_with_help_string("-gomory", "gomory");
+    parser.add_option_with_help_string("-small_rational", "test the small rational coefficients");
     parser.add_option_with_help_string("-intd", "test integer_domain");
     parser.add_option_with_help_string("-xyz_sample", "run a small interactive scenario");
     parser.add_option_with_after_string_with_help("--density", "the percentage of non-zeroes in the matrix below which it is not dense");
@@ -3327,6 +3329,46 @@ void test_rationals() {
     std::cout << T_to_string(r) << std::endl;
 }
 
+void test_small_rational() {
+    // compare with mpq, including values that overflow 64 bits
+    int64_t big = INT64_MAX / 3;
+    for (unsigned k = 0; k < 10000; k++) {
+        int64_t n1 = my_random() % 1000 - 500, d1 = 1 + my_random() % 100;
+        int64_t n2 = my_random() % 1000 - 500, d2 = 1 + my_random() % 100;
+        if (k % 7 == 0) n1 = big - n1;
+        if (k % 11 == 0) d2 = big - d2;
+        small_rational a(n1, d1), b(n2, d2);
+        mpq qa = a.to_mpq(), qb = b.to_mpq();
+        VERIFY((a + b).to_mpq() == qa + qb);
+        VERIFY((a - b).to_mpq() == qa - qb);
+        VERIFY((a * b).to_mpq() == qa * qb);
+        VERIFY(b.is_zero() || (a / b).to_mpq() == qa / qb);
+        VERIFY((-a).to_mpq() == -qa);
+        VERIFY((a < b) == (qa < qb));
+        VERIFY((a == b) == (qa == qb));
+        small_rational c(a);
+        c.addmul(a, b);
+        VERIFY(c.to_mpq() == qa + qa * qb);
+        // values that fit again are demoted
+        VERIFY((a - a).is_zero() && !(a - a).is_big());
+    }
+
+    stopwatch sw;
+    vector<small_rational> c, x;
+    for (unsigned j = 0; j < 10; j++) {
+        c.push_back(small_rational(my_random() % 100, 1 + my_random() % 100));
+        x.push_back(small_rational(my_random() % 100, 1 + my_random() % 100));
+    }
+    small_rational r = zero_of_type<small_rational>();
+    sw.start();
+    for (unsigned j = 0; j < 100000; j++)
+        for (unsigned i = 0; i < c.size(); i++)
+            addmul(r, c[i], x[i]);
+    sw.stop();
+    std::cout << "operation with small rationals " << sw.get_seconds() << std::endl;
+    std::cout << r << std::endl;
+}
+
 void get_random_interval(bool& neg_inf, bool& pos_inf, int& x, int &y) {
     int i = my_random() % 10;
     if (i == 0) {
@@ -3948,6 +3990,11 @@ void test_lp_local(int argn, char**argv) {
         return finalize(0);
     }
 
+    if (args_parser.option_is_used("-small_rational")) {
+        test_small_rational();
+        return finalize(0);
+    }
+
     if (args_parser.option_is_used("--test_mpq")) {
         test_rationals();
         return finalize(0);
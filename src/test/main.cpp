@@ -255,7 +255,11 @@ int main(int argc, char ** argv) {
     TST(pb2bv);
     TST_ARGV(sat_lookahead);
     TST_ARGV(sat_local_search);
+    TST_ARGV(sat_inprocessing);
+    TST_ARGV(smt_relevancy);
+    TST_ARGV(mp_bench);
     TST_ARGV(cnf_backbones);
+    TST_ARGV(smt2_delta);
     TST(bdd);
     TST(pdd);
     TST(pdd_solver);
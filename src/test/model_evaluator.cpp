@@ -1,12 +1,124 @@
 #include "model/model.h"
 #include "model/model_evaluator.h"
 #include "model/model_pp.h"
+#include "model/bv_batch_evaluator.h"
 #include "ast/arith_decl_plugin.h"
+#include "ast/bv_decl_plugin.h"
 #include "ast/reg_decl_plugins.h"
 #include "ast/ast_pp.h"
 
 
+// the batch evaluator agrees with the model evaluator on every assignment
+static void tst_bv_batch(unsigned sz) {
+    ast_manager m;
+    reg_decl_plugins(m);
+    bv_util bv(m);
+    app_ref x(m.mk_const("x", bv.mk_sort(sz)), m);
+    app_ref y(m.mk_const("y", bv.mk_sort(sz)), m);
+    expr_ref_vector ts(m);
+    ts.push_back(bv.mk_bv_add(x, bv.mk_bv_mul(x, y)));
+    ts.push_back(bv.mk_bv_sub(bv.mk_bv_not(x), bv.mk_bv_neg(y)));
+    ts.push_back(bv.mk_bv_udiv(x, y));
+    ts.push_back(bv.mk_bv_urem(x, y));
+    ts.push_back(bv.mk_bv_ashr(x, bv.mk_bv_and(y, bv.mk_numeral(sz - 1, sz))));
+    ts.push_back(bv.mk_bv_shl(x, y));
+    ts.push_back(bv.mk_concat(bv.mk_extract(sz - 1, sz / 2, x), bv.mk_extract(sz / 2 - 1, 0, y)));
+    ts.push_back(bv.mk_sign_extend(64 - sz, bv.mk_bv_xor(x, y)));
+    ts.push_back(m.mk_ite(bv.mk_slt(x, y), x, bv.mk_bv_or(x, y)));
+    ts.push_back(m.mk_and(bv.mk_ule(x, y), m.mk_not(m.mk_eq(x, y))));
+
+    unsigned const n = 64;
+    random_gen r(sz);
+    uint64_t mask = sz == 64 ? ~0ull : (1ull << sz) - 1;
+    svector<uint64_t> values, result;
+    result.resize(n);
+    for (unsigned i = 0; i < 2 * n; ++i) {
+        uint64_t v = (static_cast<uint64_t>(r()) << 48) ^ (static_cast<uint64_t>(r()) << 32) ^ (r() << 16) ^ r();
+        values.push_back(i % 8 == 0 ? 0 : v & mask);
+    }
+    ptr_vector<expr> vars;
+    vars.push_back(x);
+    vars.push_back(y);
+    bv_batch_evaluator be(m);
+    for (expr* t : ts) {
+        // a compiled program agrees with direct evaluation on every batch
+        bv_batch_evaluator::program p(m);
+        VERIFY(be.compile(t, vars, p));
+        svector<uint64_t> result2, result3, values2;
+        result2.resize(n / 2);
+        result3.resize(n / 2);
+        for (unsigned k = 0; k < 2; ++k) {
+            values2.reset();
+            for (unsigned j = 0; j < 2; ++j)
+                for (unsigned i = 0; i < n / 2; ++i)
+                    values2.push_back(values[j * n + k * (n / 2) + i]);
+            be.run(p, n / 2, values2.data(), result2.data());
+            VERIFY(be(t, vars, n / 2, values2.data(), result3.data()));
+            ENSURE(result2 == result3);
+        }
+        VERIFY(be(t, vars, n, values.data(), result.data()));
+        for (unsigned i = 0; i < n; ++i) {
+            model mdl(m);
+            mdl.register_decl(x->get_decl(), bv.mk_numeral(values[i], sz));
+            mdl.register_decl(y->get_decl(), bv.mk_numeral(values[n + i], sz));
+            model_evaluator ev(mdl);
+            expr_ref v = ev(t);
+            rational val;
+            if (m.is_bool(t)) {
+                ENSURE(m.is_true(v) == (result[i] != 0) && (m.is_true(v) || m.is_false(v)));
+            }
+            else {
+                ENSURE(bv.is_numeral(v, val) && val.get_uint64() == result[i]);
+            }
+        }
+    }
+}
+
+// lookups through the hash index of large interpretations
+static void tst_func_interp_index() {
+    ast_manager m;
+    reg_decl_plugins(m);
+    arith_util a(m);
+    unsigned const n = 100;
+    func_interp fi(m, 2);
+    expr_ref_vector pinned(m);
+    for (unsigned i = 0; i < n; ++i) {
+        expr* args[2] = { a.mk_int(i), a.mk_int(2 * i) };
+        pinned.append(2, args);
+        fi.insert_new_entry(args, a.mk_int(i % 3));
+    }
+    for (unsigned i = 0; i < n; ++i) {
+        expr* args[2] = { a.mk_int(i), a.mk_int(2 * i) };
+        pinned.append(2, args);
+        func_entry* e = fi.get_entry(args);
+        ENSURE(e && e->get_result() == a.mk_int(i % 3));
+        expr* other[2] = { a.mk_int(i), a.mk_int(2 * i + 1) };
+        pinned.append(2, other);
+        ENSURE(!fi.get_entry(other));
+    }
+    expr* args0[2] = { a.mk_int(0), a.mk_int(0) };
+    pinned.append(2, args0);
+    fi.insert_entry(args0, a.mk_int(7));
+    ENSURE(fi.num_entries() == n && fi.get_entry(args0)->get_result() == a.mk_int(7));
+    fi.del_entry(0);
+    ENSURE(!fi.get_entry(args0));
+    fi.set_else(a.mk_int(0));
+    fi.compress();
+    for (unsigned i = 1; i < n; ++i) {
+        expr* args[2] = { a.mk_int(i), a.mk_int(2 * i) };
+        pinned.append(2, args);
+        func_entry* e = fi.get_entry(args);
+        ENSURE((i % 3 == 0) == !e);
+        ENSURE(!e || e->get_result() == a.mk_int(i % 3));
+    }
+}
+
 void tst_model_evaluator() {
+    tst_func_interp_index();
+    tst_bv_batch(8);
+    tst_bv_batch(32);
+    tst_bv_batch(64);
+
     ast_manager m;
     reg_decl_plugins(m);
     arith_util a(m);
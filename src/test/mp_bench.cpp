@@ -0,0 +1,302 @@
+/*++
+Copyright (c) 2021 Microsoft Corporation
+
+Module Name:
+
+    mp_bench.cpp
+
+Abstract:
+
+    Throughput benchmark for the multi-precision arithmetic kernels.
+
+    Usage: test-z3 [options] mp_bench [ops]
+
+    Each workload runs ops operations (default 1000000) over a pool of
+    random operands and writes the number of operations per second and
+    the number of heap allocations per operation to standard output as
+    one JSON object per workload. The benchmark can be used to compare
+    builds with and without GMP.
+
+    The integer operands follow the size distribution of the numerals
+    seen in the tableaux of the arithmetic solvers: most fit in a machine
+    word, a few take several words and rare ones take dozens.
+
+--*/
+#include <iostream>
+#include <cstdlib>
+#include <string>
+#include "util/util.h"
+#include "util/stopwatch.h"
+#include "util/memory_manager.h"
+#include "util/mpz.h"
+#include "util/mpq.h"
+#include "util/mpf.h"
+#include "util/mpff.h"
+#include "util/mpfx.h"
+#include "util/mpbq.h"
+
+namespace {
+
+    const unsigned g_pool_size = 1024;
+
+    class bench {
+        std::ostream&      m_out;
+        std::string        m_name;
+        unsigned           m_ops;
+        stopwatch          m_watch;
+        unsigned long long m_allocs;
+    public:
+        bench(std::ostream& out, std::string const& name, unsigned ops): m_out(out), m_name(name), m_ops(ops) {
+            m_allocs = memory::get_allocation_count();
+            m_watch.start();
+        }
+
+        ~bench() {
+            m_watch.stop();
+            unsigned long long allocs = memory::get_allocation_count() - m_allocs;
+            double secs = m_watch.get_seconds();
+            m_out << "{ \"workload\": \"" << m_name << "\""
+                  << ", \"ops\": " << m_ops
+                  << ", \"time\": " << secs
+                  << ", \"ops/sec\": " << (secs > 0 ? m_ops / secs : 0)
+                  << ", \"allocs/op\": " << static_cast<double>(allocs) / m_ops << " }";
+        }
+    };
+
+    // random_gen only produces 15 bits at a time
+    unsigned random_digit(random_gen& r) {
+        unsigned hi = r(), lo = r();
+        return ((hi << 16) | (lo << 1) | r(2)) & INT_MAX;
+    }
+
+    // number of 31-bit digits of a random operand
+    unsigned random_digits(random_gen& r) {
+        unsigned k = r(100);
+        if (k < 60) return 1;
+        if (k < 85) return 2;
+        if (k < 95) return 4;
+        if (k < 99) return 8;
+        return 32;
+    }
+
+    void mk_random(unsynch_mpz_manager& m, random_gen& r, unsigned digits, mpz& a) {
+        m.set(a, 1 + static_cast<int>(random_digit(r) >> 1));
+        for (unsigned i = 1; i < digits; ++i) {
+            m.mul2k(a, 31);
+            scoped_mpz d(m);
+            m.set(d, static_cast<int>(random_digit(r)));
+            m.add(a, d, a);
+        }
+        if (r(2) == 0)
+            m.neg(a);
+    }
+
+    void mk_pool(unsynch_mpz_manager& m, random_gen& r, scoped_mpz_vector& pool) {
+        scoped_mpz a(m);
+        for (unsigned i = 0; i < g_pool_size; ++i) {
+            mk_random(m, r, random_digits(r), a);
+            pool.push_back(a);
+        }
+    }
+
+    void bench_mpz(std::ostream& out, unsigned ops) {
+        unsynch_mpz_manager m;
+        random_gen r(17);
+        scoped_mpz_vector as(m), bs(m), ds(m);
+        mk_pool(m, r, as);
+        mk_pool(m, r, bs);
+        // divisors are at most as large as the dividends
+        scoped_mpz d(m);
+        for (unsigned i = 0; i < g_pool_size; ++i) {
+            unsigned digits = random_digits(r);
+            mk_random(m, r, digits > 1 ? digits / 2 : 1, d);
+            ds.push_back(d);
+        }
+        scoped_mpz c(m);
+        unsigned mask = g_pool_size - 1;
+        {
+            bench b(out, "mpz add", ops);
+            for (unsigned i = 0; i < ops; ++i)
+                m.add(as[i & mask], bs[(i * 7 + 3) & mask], c);
+        }
+        out << ",\n";
+        {
+            bench b(out, "mpz mul", ops);
+            for (unsigned i = 0; i < ops; ++i)
+                m.mul(as[i & mask], bs[(i * 7 + 3) & mask], c);
+        }
+        out << ",\n";
+        {
+            bench b(out, "mpz gcd", ops);
+            for (unsigned i = 0; i < ops; ++i)
+                m.gcd(as[i & mask], bs[(i * 7 + 3) & mask], c);
+        }
+        out << ",\n";
+        {
+            bench b(out, "mpz div", ops);
+            for (unsigned i = 0; i < ops; ++i)
+                m.div(as[i & mask], ds[(i * 7 + 3) & mask], c);
+        }
+        out << ",\n";
+        {
+            bench b(out, "mpz rem", ops);
+            for (unsigned i = 0; i < ops; ++i)
+                m.rem(as[i & mask], ds[(i * 7 + 3) & mask], c);
+        }
+    }
+
+    void bench_mpq(std::ostream& out, unsigned ops) {
+        unsynch_mpq_manager m;
+        random_gen r(23);
+        scoped_mpq_vector as(m), bs(m);
+        scoped_mpz n(m), d(m);
+        scoped_mpq q(m);
+        for (unsigned i = 0; i < 2 * g_pool_size; ++i) {
+            mk_random(m, r, random_digits(r), n);
+            // fractions of the tableaux mostly have small denominators
+            mk_random(m, r, r(4) == 0 ? random_digits(r) : 1, d);
+            m.abs(d);
+            m.set(q, n, d);
+            (i < g_pool_size ? as : bs).push_back(q);
+        }
+        unsigned mask = g_pool_size - 1;
+        {
+            bench b(out, "mpq add", ops);
+            for (unsigned i = 0; i < ops; ++i)
+                m.add(as[i & mask], bs[(i * 7 + 3) & mask], q);
+        }
+        out << ",\n";
+        {
+            bench b(out, "mpq mul", ops);
+            for (unsigned i = 0; i < ops; ++i)
+                m.mul(as[i & mask], bs[(i * 7 + 3) & mask], q);
+        }
+        out << ",\n";
+        {
+            bench b(out, "mpq div", ops);
+            for (unsigned i = 0; i < ops; ++i)
+                m.div(as[i & mask], bs[(i * 7 + 3) & mask], q);
+        }
+    }
+
+    void bench_mpf(std::ostream& out, unsigned ops, char const* name, unsigned ebits, unsigned sbits) {
+        mpf_manager m;
+        random_gen r(31);
+        scoped_mpf_vector as(m);
+        scoped_mpf x(m);
+        for (unsigned i = 0; i < g_pool_size; ++i) {
+            double v = (static_cast<double>(random_digit(r)) - INT_MAX / 2) / (1 + r(1 << 14));
+            m.set(x, ebits, sbits, v);
+            as.push_back(x);
+        }
+        mpf_rounding_mode const rms[] = {
+            MPF_ROUND_NEAREST_TEVEN, MPF_ROUND_NEAREST_TAWAY, MPF_ROUND_TOWARD_POSITIVE,
+            MPF_ROUND_TOWARD_NEGATIVE, MPF_ROUND_TOWARD_ZERO
+        };
+        unsigned mask = g_pool_size - 1;
+        std::string n(name);
+        {
+            bench b(out, n + " add", ops);
+            for (unsigned i = 0; i < ops; ++i)
+                m.add(rms[i % 5], as[i & mask], as[(i * 7 + 3) & mask], x);
+        }
+        out << ",\n";
+        {
+            bench b(out, n + " mul", ops);
+            for (unsigned i = 0; i < ops; ++i)
+                m.mul(rms[i % 5], as[i & mask], as[(i * 7 + 3) & mask], x);
+        }
+        out << ",\n";
+        {
+            bench b(out, n + " div", ops);
+            for (unsigned i = 0; i < ops; ++i)
+                m.div(rms[i % 5], as[i & mask], as[(i * 7 + 3) & mask], x);
+        }
+        out << ",\n";
+        {
+            bench b(out, n + " round", ops);
+            for (unsigned i = 0; i < ops; ++i)
+                m.round_to_integral(rms[i % 5], as[i & mask], x);
+        }
+    }
+
+    template<typename Manager, typename Scoped, typename Vector>
+    void bench_fixed(std::ostream& out, unsigned ops, char const* name, Manager& m) {
+        random_gen r(37);
+        Vector as(m);
+        Scoped x(m);
+        for (unsigned i = 0; i < g_pool_size; ++i) {
+            m.set(x, static_cast<int>(r(1 << 16)) - (1 << 15), 1 + r(1 << 10));
+            as.push_back(x);
+        }
+        unsigned mask = g_pool_size - 1;
+        std::string n(name);
+        {
+            bench b(out, n + " add", ops);
+            for (unsigned i = 0; i < ops; ++i)
+                m.add(as[i & mask], as[(i * 7 + 3) & mask], x);
+        }
+        out << ",\n";
+        {
+            bench b(out, n + " mul", ops);
+            for (unsigned i = 0; i < ops; ++i)
+                m.mul(as[i & mask], as[(i * 7 + 3) & mask], x);
+        }
+    }
+
+    void bench_mpbq(std::ostream& out, unsigned ops) {
+        unsynch_mpz_manager zm;
+        mpbq_manager m(zm);
+        random_gen r(41);
+        scoped_mpbq_vector as(m);
+        scoped_mpbq x(m);
+        scoped_mpz n(zm);
+        for (unsigned i = 0; i < g_pool_size; ++i) {
+            mk_random(zm, r, random_digits(r), n);
+            m.set(x, n, r(64));
+            as.push_back(x);
+        }
+        unsigned mask = g_pool_size - 1;
+        {
+            bench b(out, "mpbq add", ops);
+            for (unsigned i = 0; i < ops; ++i)
+                m.add(as[i & mask], as[(i * 7 + 3) & mask], x);
+        }
+        out << ",\n";
+        {
+            bench b(out, "mpbq mul", ops);
+            for (unsigned i = 0; i < ops; ++i)
+                m.mul(as[i & mask], as[(i * 7 + 3) & mask], x);
+        }
+    }
+}
+
+void tst_mp_bench(char ** argv, int argc, int& i) {
+    unsigned ops = 1000000;
+    if (i + 1 < argc && argv[i + 1][0] != '-') {
+        ++i;
+        ops = std::max(1, atoi(argv[i]));
+    }
+    std::ostream& out = std::cout;
+    out << "[\n";
+    bench_mpz(out, ops);
+    out << ",\n";
+    bench_mpq(out, ops);
+    out << ",\n";
+    bench_mpf(out, ops, "mpf double", 11, 53);
+    out << ",\n";
+    bench_mpf(out, ops, "mpf quad", 15, 113);
+    out << ",\n";
+    {
+        mpff_manager m;
+        bench_fixed<mpff_manager, scoped_mpff, scoped_mpff_vector>(out, ops, "mpff", m);
+    }
+    out << ",\n";
+    {
+        mpfx_manager m;
+        bench_fixed<mpfx_manager, scoped_mpfx, scoped_mpfx_vector>(out, ops, "mpfx", m);
+    }
+    out << ",\n";
+    bench_mpbq(out, ops);
+    out << "\n]\n";
+}
@@ -289,11 +289,14 @@ static void tst5() {
     std::cout << "max. heap size: " << static_cast<double>(mem)/static_cast<double>(1024*1024) << " Mbytes\n";
 
     m.copy(a1, a2);
+    ENSURE(m.is_shared(a1, a2));
     
     for (unsigned i = 0; i < 1000000; i++) {
         m.set(a1, i % 100, m.mk_var(rand() % 100, m.mk_bool_sort()));
     }
 
+    ENSURE(!m.is_shared(a1, a2));
+
     mem = memory::get_max_used_memory();
     std::cout << "max. heap size: " << static_cast<double>(mem)/static_cast<double>(1024*1024) << " Mbytes\n";
     
@@ -205,10 +205,71 @@ static void test4() {
     std::cout << "is_atom: " << is_atom(m, eq) << "\n";
 }
 
+// cardinality constraints over the same literals share their networks.
+static void test5() {
+    ast_manager m;
+    reg_decl_plugins(m);
+    pb_util pb(m);
+    params_ref p;
+    pb2bv_rewriter rw(m, p);
+    expr_ref_vector vars(m), rvars(m);
+    unsigned N = 6;
+    for (unsigned i = 0; i < N; ++i) {
+        std::stringstream strm;
+        strm << "b" << i;
+        vars.push_back(m.mk_const(symbol(strm.str()), m.mk_bool_sort()));
+    }
+    for (unsigned i = N; i-- > 0; )
+        rvars.push_back(vars.get(i));
+    expr_ref_vector results(m);
+    svector<std::pair<unsigned, unsigned>> cnstrs;
+    vector<rational> ones(N, rational::one());
+    for (unsigned kind = 0; kind < 3; ++kind) {
+        for (unsigned k = 0; k <= N; ++k) {
+            expr_ref_vector const& xs = k % 2 == 0 ? vars : rvars;
+            expr_ref fml(m), result(m);
+            proof_ref proof(m);
+            switch (kind) {
+            case 0: fml = pb.mk_at_least_k(N, xs.data(), k); break;
+            case 1: fml = pb.mk_at_most_k(N, xs.data(), k); break;
+            default: fml = pb.mk_eq(N, ones.data(), xs.data(), rational(k)); break;
+            }
+            rw(true, fml, result, proof);
+            results.push_back(result);
+            cnstrs.push_back(std::make_pair(kind, k));
+        }
+    }
+    expr_ref_vector lemmas(m);
+    rw.flush_side_constraints(lemmas);
+    statistics st;
+    rw.collect_statistics(st);
+    st.display(std::cout);
+    for (unsigned values = 0; values < static_cast<unsigned>(1 << N); ++values) {
+        smt_params fp;
+        smt::kernel solver(m, fp);
+        unsigned num_true = 0;
+        for (unsigned i = 0; i < N; ++i) {
+            bool is_true = 0 != (values & (1 << i));
+            num_true += is_true;
+            solver.assert_expr(is_true ? vars.get(i) : m.mk_not(vars.get(i)));
+        }
+        solver.assert_expr(lemmas);
+        for (unsigned i = 0; i < results.size(); ++i) {
+            unsigned kind = cnstrs[i].first, k = cnstrs[i].second;
+            bool holds = kind == 0 ? num_true >= k : (kind == 1 ? num_true <= k : num_true == k);
+            solver.push();
+            solver.assert_expr(holds ? m.mk_not(results.get(i)) : results.get(i));
+            VERIFY(l_false == solver.check());
+            solver.pop(1);
+        }
+    }
+}
+
 void tst_pb2bv() {
     test1();
     test2();
     test3();
     test4();
+    test5();
 }
 
@@ -322,6 +322,30 @@ public :
         SASSERT(!(2*a*b + 3*b + 2).is_non_zero());
     }
 
+    static void gc_cache() {
+        std::cout << "gc cache\n";
+        pdd_manager m(4);
+        pdd a = m.mk_var(0);
+        pdd b = m.mk_var(1);
+        pdd c = m.mk_var(2);
+        pdd p = (a + b) * (a - c);
+        pdd q = (a + b + c) * (a + b + c);
+        {
+            pdd r = (b * c + 3) * (a + 2);
+            std::cout << r << "\n";
+        }
+        m.gc();
+        // results cached before gc are consistent with recomputation
+        VERIFY(p == (a + b) * (a - c));
+        VERIFY(p == a*a - a*c + a*b - b*c);
+        VERIFY(q == (a + b + c) * (a + b + c));
+        VERIFY((b * c + 3) * (a + 2) == a*b*c + 2*b*c + 3*a + 6);
+        VERIFY(m.reduce(q, a + b) == c*c);
+        statistics st;
+        m.collect_statistics(st);
+        st.display(std::cout);
+    }
+
 };
 
 }
@@ -336,4 +360,5 @@ void tst_pdd() {
     dd::test::order();
     dd::test::order_lm();
     dd::test::mod4_operations();
+    dd::test::gc_cache();
 }
@@ -17,13 +17,38 @@ Revision History:
 
 --*/
 #include<stdlib.h>
+#include<string.h>
 #include "util/region.h"
+#include "util/statistics.h"
+#include "util/debug.h"
 
 static void tst1() {
     // TODO
 }
 
+static void tst2(size_t page_size) {
+    region r(page_size);
+    char * a = static_cast<char*>(r.allocate(100));
+    memset(a, 1, 100);
+    r.push_scope();
+    for (unsigned i = 0; i < 1000; ++i) {
+        char * b = static_cast<char*>(r.allocate(i + 1));
+        memset(b, 2, i + 1);
+    }
+    char * big = static_cast<char*>(r.allocate(3 * page_size));
+    memset(big, 3, 3 * page_size);
+    r.pop_scope();
+    for (unsigned i = 0; i < 100; ++i)
+        ENSURE(a[i] == 1);
+    statistics st;
+    r.collect_statistics(st);
+    st.display(std::cout);
+    r.reset();
+}
+
 void tst_region() {
     tst1();
+    tst2(1024);
+    tst2(64 * 1024);
 }
 
@@ -0,0 +1,157 @@
+/*++
+Copyright (c) 2021 Microsoft Corporation
+
+Module Name:
+
+    sat_inprocessing.cpp
+
+Abstract:
+
+    Benchmark harness for the inprocessing passes of sat::solver.
+
+    Usage: test-z3 [options] sat_inprocessing file1.cnf file2.cnf ... [sat.max_conflicts=N]
+
+    Every file is solved once with the default configuration and once per
+    inprocessing pass with that pass toggled. For each run the solve time,
+    result and, per pass, the number of calls, time and clauses removed or
+    added are written to standard output as one JSON object per file.
+
+--*/
+#include <iostream>
+#include <fstream>
+#include <cstring>
+#include "util/rlimit.h"
+#include "util/stopwatch.h"
+#include "util/statistics.h"
+#include "sat/dimacs.h"
+#include "sat/sat_solver.h"
+
+namespace {
+
+    struct pass_config {
+        char const* m_name;
+        char const* m_params[2];  // sat parameters that control the pass
+        bool        m_default;    // value of the parameters in the default configuration
+    };
+
+    // binspr is disabled in sat_config and cannot be toggled from parameters.
+    const pass_config g_passes[] = {
+        { "scc",          { "scc", nullptr },                 true },
+        { "simplifier",   { "elim_vars", "subsumption" },     true },
+        { "probing",      { "probing", nullptr },             true },
+        { "asymm-branch", { "asymm_branch", nullptr },        true },
+        { "vivify",       { "vivify", nullptr },              false },
+        { "lookahead",    { "lookahead_simplify", nullptr },  false },
+        { "anf",          { "anf", nullptr },                 false },
+        { "cut",          { "cut", nullptr },                 false },
+    };
+
+    void display_json_string(std::ostream& out, char const* s) {
+        out << "\"";
+        for (; *s; ++s) {
+            if (*s == '"' || *s == '\\')
+                out << "\\";
+            out << *s;
+        }
+        out << "\"";
+    }
+
+    void display_result(std::ostream& out, lbool r) {
+        switch (r) {
+        case l_true:  out << "\"sat\""; break;
+        case l_false: out << "\"unsat\""; break;
+        default:      out << "\"unknown\""; break;
+        }
+    }
+
+    void display_config(std::ostream& out, pass_config const* toggled) {
+        out << "\"config\": \"";
+        if (toggled)
+            out << (toggled->m_default ? "no-" : "with-") << toggled->m_name;
+        else
+            out << "default";
+        out << "\"";
+    }
+
+    void run(std::ostream& out, char const* file_name, pass_config const* toggled) {
+        reslimit limit;
+        params_ref p;
+        p.set_bool("inprocess.profile", true);
+        if (toggled) {
+            for (char const* name : toggled->m_params)
+                if (name)
+                    p.set_bool(name, !toggled->m_default);
+        }
+        sat::solver solver(p, limit);
+        std::ifstream in(file_name);
+        if (in.bad() || in.fail() || !parse_dimacs(in, std::cerr, solver)) {
+            out << "{ ";
+            display_config(out, toggled);
+            out << ", \"error\": \"could not read input\" }";
+            return;
+        }
+
+        stopwatch watch;
+        watch.start();
+        lbool r = l_undef;
+        try {
+            r = solver.check();
+        }
+        catch (z3_exception& ex) {
+            std::cerr << ex.msg() << "\n";
+        }
+        watch.stop();
+
+        statistics st;
+        solver.collect_statistics(st);
+        out << "{ ";
+        display_config(out, toggled);
+        out << ", \"result\": ";
+        display_result(out, r);
+        out << ", \"time\": " << watch.get_seconds();
+        out << ", \"stats\": {";
+        bool first = true;
+        for (unsigned i = 0; i < st.size(); ++i) {
+            char const* key = st.get_key(i);
+            if (strncmp(key, "sat inprocess ", 14) != 0 && strcmp(key, "sat conflicts") != 0)
+                continue;
+            out << (first ? " " : ", ");
+            first = false;
+            display_json_string(out, key);
+            out << ": ";
+            if (st.is_uint(i))
+                out << st.get_uint_value(i);
+            else
+                out << st.get_double_value(i);
+        }
+        out << " } }";
+    }
+}
+
+void tst_sat_inprocessing(char ** argv, int argc, int& i) {
+    if (argc < i + 2) {
+        std::cout << "require dimacs file names\n";
+        return;
+    }
+    std::ostream& out = std::cout;
+    out << "[\n";
+    bool first_file = true;
+    for (++i; i < argc; ++i) {
+        char const* file_name = argv[i];
+        if (strchr(file_name, '='))
+            continue;
+        if (!first_file)
+            out << ",\n";
+        first_file = false;
+        out << "{ \"file\": ";
+        display_json_string(out, file_name);
+        out << ", \"runs\": [\n  ";
+        run(out, file_name, nullptr);
+        for (pass_config const& pc : g_passes) {
+            out << ",\n  ";
+            run(out, file_name, &pc);
+        }
+        out << "\n] }";
+    }
+    out << "\n]\n";
+}
@@ -0,0 +1,62 @@
+/*++
+Copyright (c) 2021 Microsoft Corporation
+
+Module Name:
+
+    smt2_delta.cpp
+
+Abstract:
+
+    Write the n'th delta of the assertions of an SMT-LIB2 file.
+
+    test-z3 smt2_delta <in.smt2> <n> <out.smt2>
+
+    The deltas are enumerated by expr_delta in dfs order. The output
+    file is not created if there is no n'th delta. scripts/z3_bench.py
+    uses this to reduce benchmarks whose performance regressed.
+
+--*/
+
+#include <fstream>
+#include <iostream>
+#include <cstdlib>
+#include "ast/ast_smt_pp.h"
+#include "ast/reg_decl_plugins.h"
+#include "cmd_context/cmd_context.h"
+#include "parsers/smt2/smt2parser.h"
+#include "test/fuzzing/expr_delta.h"
+
+void tst_smt2_delta(char ** argv, int argc, int& i) {
+    if (i + 3 >= argc) {
+        std::cerr << "usage: smt2_delta <in.smt2> <n> <out.smt2>\n";
+        exit(1);
+    }
+    char const* file = argv[i + 1];
+    unsigned n = atoi(argv[i + 2]);
+    char const* out_file = argv[i + 3];
+    i += 3;
+
+    ast_manager m;
+    reg_decl_plugins(m);
+    cmd_context ctx(false, &m);
+    ctx.set_ignore_check(true);
+    std::ifstream in(file);
+    if (in.bad() || in.fail() || !parse_smt2_commands(ctx, in, false, params_ref(), file)) {
+        std::cerr << "could not parse " << file << "\n";
+        exit(1);
+    }
+
+    expr_delta delta(m);
+    for (expr* e : ctx.assertions())
+        delta.assert_cnstr(e);
+    expr_ref_vector result(m);
+    if (!delta.delta_dfs(n, result))
+        return;
+
+    ast_smt_pp pp(m);
+    pp.set_logic(ctx.get_logic());
+    for (expr* e : result)
+        pp.add_assumption(e);
+    std::ofstream out(out_file);
+    pp.display_smt2(out, m.mk_true());
+}
@@ -8,7 +8,9 @@ Copyright (c) 2015 Microsoft Corporation
 // for SMT-LIB2.
 
 #include "api/z3.h"
+#include "util/debug.h"
 #include <iostream>
+#include <string>
 
 void test_print(Z3_context ctx, Z3_ast_vector av) {
     Z3_set_ast_print_mode(ctx, Z3_PRINT_SMTLIB2_COMPLIANT);
@@ -64,8 +66,29 @@ void test_parseprint(char const* spec) {
     Z3_del_context(ctx);
 }
 
+// tokens longer than the scanner buffer, parsed from a stream and from memory.
+static void test_long_tokens() {
+    std::string name(3000, 'x');
+    std::string spec;
+    spec += ";" + std::string(5000, 'c') + "\n";
+    spec += "(declare-const " + name + " Int)\n";
+    spec += "(declare-const |q" + std::string(2000, ' ') + "\\|q| Int)\n";
+    spec += "(assert (= " + name + " |q" + std::string(2000, ' ') + "\\|q|))\n";
+    spec += "(assert (= (str.len \"" + std::string(1500, 'a') + "\"\"b\") 1502))\n";
+    Z3_context ctx = Z3_mk_context(nullptr);
+    Z3_ast_vector a = Z3_parse_smtlib2_string(ctx, spec.c_str(), 0, nullptr, nullptr, 0, nullptr, nullptr);
+    ENSURE(Z3_get_error_code(ctx) == Z3_OK);
+    ENSURE(Z3_ast_vector_size(ctx, a) == 2);
+    std::string r = Z3_eval_smtlib2_string(ctx, (spec + "(check-sat)\n").c_str());
+    std::cout << r;
+    ENSURE(r == "sat\n");
+    Z3_del_context(ctx);
+}
+
 void tst_smt2print_parse() {
 
+    test_long_tokens();
+
     // test basic datatypes  
     char const* spec1 = 
         "(declare-datatypes (T) ((list (nil) (cons (car T) (cdr list)))))\n"
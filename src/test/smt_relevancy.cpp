@@ -0,0 +1,134 @@
+/*++
+Copyright (c) 2021 Microsoft Corporation
+
+Module Name:
+
+    smt_relevancy.cpp
+
+Abstract:
+
+    Benchmark harness for the relevancy levels of the SMT core.
+
+    Usage: test-z3 [options] smt_relevancy file1.smt2 file2.smt2 ...
+
+    The assertions of every file are solved with smt.relevancy set to 0, 1
+    and 2. For each run the solve time, result and the search statistics
+    are written to standard output as one JSON object per file.
+
+--*/
+#include <iostream>
+#include <cstring>
+#include "api/z3.h"
+#include "util/stopwatch.h"
+
+namespace {
+
+    // statistics that measure the work of the search
+    char const* const g_keys[] = {
+        "conflicts", "decisions", "propagations", "quant instantiations", "memory"
+    };
+
+    void display_json_string(std::ostream& out, char const* s) {
+        out << "\"";
+        for (; *s; ++s) {
+            if (*s == '"' || *s == '\\')
+                out << "\\";
+            out << *s;
+        }
+        out << "\"";
+    }
+
+    void display_result(std::ostream& out, Z3_lbool r) {
+        switch (r) {
+        case Z3_L_TRUE:  out << "\"sat\""; break;
+        case Z3_L_FALSE: out << "\"unsat\""; break;
+        default:         out << "\"unknown\""; break;
+        }
+    }
+
+    void display_stats(std::ostream& out, Z3_context ctx, Z3_stats st) {
+        out << ", \"stats\": {";
+        bool first = true;
+        for (unsigned i = 0; i < Z3_stats_size(ctx, st); ++i) {
+            char const* key = Z3_stats_get_key(ctx, st, i);
+            bool found = false;
+            for (char const* k : g_keys)
+                found |= strcmp(key, k) == 0;
+            if (!found)
+                continue;
+            out << (first ? " " : ", ");
+            first = false;
+            display_json_string(out, key);
+            out << ": ";
+            if (Z3_stats_is_uint(ctx, st, i))
+                out << Z3_stats_get_uint_value(ctx, st, i);
+            else
+                out << Z3_stats_get_double_value(ctx, st, i);
+        }
+        out << " }";
+    }
+
+    void run(std::ostream& out, char const* file_name, unsigned relevancy) {
+        Z3_config cfg = Z3_mk_config();
+        Z3_context ctx = Z3_mk_context(cfg);
+        Z3_del_config(cfg);
+        Z3_set_error_handler(ctx, nullptr);
+        Z3_solver s = Z3_mk_simple_solver(ctx);
+        Z3_solver_inc_ref(ctx, s);
+        Z3_params p = Z3_mk_params(ctx);
+        Z3_params_inc_ref(ctx, p);
+        Z3_params_set_uint(ctx, p, Z3_mk_string_symbol(ctx, "relevancy"), relevancy);
+        Z3_solver_set_params(ctx, s, p);
+        Z3_params_dec_ref(ctx, p);
+
+        out << "{ \"relevancy\": " << relevancy;
+        Z3_solver_from_file(ctx, s, file_name);
+        if (Z3_get_error_code(ctx) != Z3_OK) {
+            out << ", \"error\": \"could not read input\" }";
+        }
+        else {
+            stopwatch watch;
+            watch.start();
+            Z3_lbool r = Z3_solver_check(ctx, s);
+            watch.stop();
+            out << ", \"result\": ";
+            display_result(out, r);
+            out << ", \"time\": " << watch.get_seconds();
+            Z3_stats st = Z3_solver_get_statistics(ctx, s);
+            Z3_stats_inc_ref(ctx, st);
+            display_stats(out, ctx, st);
+            Z3_stats_dec_ref(ctx, st);
+            out << " }";
+        }
+        Z3_solver_dec_ref(ctx, s);
+        Z3_del_context(ctx);
+    }
+}
+
+void tst_smt_relevancy(char ** argv, int argc, int& i) {
+    if (argc < i + 2) {
+        std::cout << "require smt2 file names\n";
+        return;
+    }
+    std::ostream& out = std::cout;
+    out << "[\n";
+    bool first_file = true;
+    for (++i; i < argc; ++i) {
+        char const* file_name = argv[i];
+        if (strchr(file_name, '='))
+            continue;
+        if (!first_file)
+            out << ",\n";
+        first_file = false;
+        out << "{ \"file\": ";
+        display_json_string(out, file_name);
+        out << ", \"runs\": [\n  ";
+        for (unsigned relevancy = 0; relevancy <= 2; ++relevancy) {
+            if (relevancy > 0)
+                out << ",\n  ";
+            run(out, file_name, relevancy);
+        }
+        out << "\n] }";
+    }
+    out << "\n]\n";
+}
@@ -1,6 +1,7 @@
 #include "ast/reg_decl_plugins.h"
 #include "solver/solver_pool.h"
 #include "smt/smt_solver.h"
+#include "model/model.h"
 
 void tst_solver_pool() {
     ast_manager m;
@@ -38,4 +39,30 @@ void tst_solver_pool() {
     std::cout << *s1;
     std::cout << *s2;
     std::cout << *base;
+
+    // repeated queries are answered from the cache.
+    ENSURE(s2->check_sat(asms) == l_false);
+    expr_ref_vector core(m);
+    s2->get_unsat_core(core);
+    ENSURE(core.size() == 1 && core.get(0) == asms.get(0));
+    ENSURE(s1->check_sat(asms) == l_true);
+    model_ref mdl;
+    s1->get_model(mdl);
+    ENSURE(mdl && mdl->is_true(c));
+
+    // reset retires activation literals until the base solver is recycled.
+    params_ref pp;
+    pp.set_uint("max_dead_literals", 2);
+    pool.updt_params(pp);
+    for (unsigned i = 0; i < 5; ++i) {
+        pool.reset_solver(s2.get());
+        ENSURE(s2->check_sat(asms) == l_true);
+        fml = m.mk_and(a, b);
+        s2->assert_expr(fml);
+        ENSURE(s2->check_sat(asms) == l_false);
+    }
+    ENSURE(s1->check_sat(asms) == l_true);
+    statistics st;
+    pool.collect_statistics(st);
+    st.display(std::cout);
 }
@@ -653,6 +653,39 @@ static void test_pb(unsigned max_w, unsigned sz, unsigned_vector& ws) {
     }
 }
 
+// the outputs of at_most_outputs enforce decreasing bounds without new clauses.
+static void test_at_most_outputs(unsigned n, unsigned k) {
+    ast_manager m;
+    reg_decl_plugins(m);
+    ast_ext2 ext(m);
+    expr_ref_vector in(m);
+    ptr_vector<expr> out;
+    for (unsigned i = 0; i < n; ++i) {
+        in.push_back(m.mk_fresh_const("a",m.mk_bool_sort()));
+    }
+    smt_params fp;
+    smt::kernel solver(m, fp);
+    psort_nw<ast_ext2> sn(ext);
+    sn.at_most_outputs(k, in.size(), in.data(), out);
+    ENSURE(out.size() == std::min(k, n));
+    for (expr* cls : ext.m_clauses) {
+        solver.assert_expr(cls);
+    }
+    unsigned num_clauses = ext.m_clauses.size();
+    for (unsigned b = out.size(); b-- > 0; ) {
+        solver.assert_expr(m.mk_not(out[b]));
+        solver.push();
+        for (unsigned i = 0; i < b; ++i) {
+            solver.assert_expr(in.get(i));
+        }
+        ENSURE(solver.check() == l_true);
+        solver.assert_expr(in.get(b));
+        ENSURE(solver.check() == l_false);
+        solver.pop(1);
+    }
+    ENSURE(num_clauses == ext.m_clauses.size());
+}
+
 static void tst_pb() {
     unsigned_vector ws;
     test_pb(3, 3, ws);
@@ -669,5 +702,10 @@ void tst_sorting_network() {
     test_sorting2();
     test_sorting3();
     test_sorting4();
+    for (unsigned n = 1; n < 12; ++n) {
+        for (unsigned k = 1; k <= n + 1; ++k) {
+            test_at_most_outputs(n, k);
+        }
+    }
 }
 
@@ -51,8 +51,21 @@ static void tst1() {
     ENSURE(lt(symbol("zzz"), symbol("zzzb")));
 }
 
+static void tst2() {
+    char const * strs[] = { "foo", nullptr, "bar", "foo", "baz" };
+    symbol syms[5];
+    symbol::intern(5, strs, syms);
+    ENSURE(syms[0] == symbol("foo"));
+    ENSURE(syms[1].is_null());
+    ENSURE(syms[2] == symbol("bar"));
+    ENSURE(syms[3] == syms[0]);
+    ENSURE(syms[4] == "baz");
+    ENSURE(syms[4] != syms[2]);
+}
+
 void tst_symbol() {
     tst1();
+    tst2();
 }
 
 
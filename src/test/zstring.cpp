@@ -20,6 +20,57 @@ static void tst_ascii_roundtrip() {
     }
 }
 
+// Substrings, concatenations and copies share or convert the packed
+// representation; the operations must not depend on it.
+static void tst_packed() {
+    std::string text;
+    for (unsigned i = 0; i < 200; ++i)
+        text += static_cast<char>('a' + i % 26);
+    zstring s(text);
+    zstring w(0x1F600u);
+    ENSURE(s.length() == 200);
+
+    zstring big = s.extract(10, 150);
+    zstring small = s.extract(10, 5);
+    ENSURE(big.length() == 150 && small.length() == 5);
+    ENSURE(big.encode() == text.substr(10, 150));
+    ENSURE(small.encode() == text.substr(10, 5));
+    ENSURE(small.prefixof(big));
+    ENSURE(big.extract(0, 5) == small);
+    ENSURE(big.extract(0, 5).hash() == small.hash());
+    ENSURE(s.contains(big) && !big.contains(s));
+    ENSURE(s.indexofu(small, 0) == 10);
+    ENSURE(s.last_indexof(zstring("abc")) == 182);
+    ENSURE(big.extract(140, 20).length() == 10);
+    ENSURE(s.extract(200, 1).empty());
+
+    // a wide string whose substring only has narrow characters
+    zstring mixed = w + s + w;
+    ENSURE(mixed.length() == 202);
+    ENSURE(mixed[0] == 0x1F600u && mixed[201] == 0x1F600u);
+    zstring inner = mixed.extract(1, 200);
+    ENSURE(inner == s && s == inner);
+    ENSURE(inner.hash() == s.hash());
+    ENSURE(!(inner < s) && !(s < inner));
+    ENSURE(mixed.extract(1, 5) == s.extract(0, 5));
+    ENSURE(w.suffixof(mixed) && w.prefixof(mixed));
+    ENSURE(mixed.reverse().reverse() == mixed);
+    ENSURE(mixed.reverse()[1] == s[199]);
+
+    zstring r = s.replace(zstring("cde"), w);
+    ENSURE(r.length() == 198 && r[2] == 0x1F600u && r[3] == 'f');
+    ENSURE(r.replace(w, zstring("cde")) == s);
+
+    zstring c(s);
+    zstring d;
+    d = c;
+    c = zstring("x");
+    ENSURE(d == s && c.length() == 1);
+    d = std::move(c);
+    ENSURE(d == zstring("x") && c.empty());
+}
+
 void tst_zstring() {
     tst_ascii_roundtrip();
+    tst_packed();
 }
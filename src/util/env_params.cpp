@@ -21,6 +21,7 @@ Notes:
 #include "util/gparams.h"
 #include "util/util.h"
 #include "util/memory_manager.h"
+#include "util/phase_profiler.h"
 
 void env_params::updt_params() {
     params_ref const& p = gparams::get_ref();
@@ -29,6 +30,15 @@ void env_params::updt_params() {
     memory::set_max_size(megabytes_to_bytes(p.get_uint("memory_max_size", 0)));
     memory::set_max_alloc_count(p.get_uint("memory_max_alloc_count", 0));
     memory::set_high_watermark(p.get_uint("memory_high_watermark", 0));
+    static unsigned s_sample_ms = 0;
+    unsigned sample_ms = p.get_uint("profile_sample_ms", 0);
+    if (sample_ms != s_sample_ms) {
+        s_sample_ms = sample_ms;
+        if (sample_ms > 0)
+            phase_profiler::start(sample_ms, p.get_str("profile_file", "z3-profile.json"));
+        else
+            phase_profiler::stop();
+    }
 }
 
 void env_params::collect_param_descrs(param_descrs & d) {
@@ -37,4 +47,7 @@ void env_params::collect_param_descrs(param_descrs & d) {
     d.insert("memory_max_size", CPK_UINT, "set hard upper limit for memory consumption (in megabytes), if 0 then there is no limit", "0");
     d.insert("memory_max_alloc_count", CPK_UINT, "set hard upper limit for memory allocations, if 0 then there is no limit", "0");
     d.insert("memory_high_watermark", CPK_UINT, "set high watermark for memory consumption (in megabytes), if 0 then there is no limit", "0");
+    d.insert("profile_sample_ms", CPK_UINT, "sample the active phases (tactics, theories, sat inprocessing) of all threads every given milliseconds, if 0 then sampling is disabled", "0");
+    d.insert("async_threads", CPK_UINT, "maximal number of checks started by Z3_solver_check_async that run at the same time, if 0 then the number of hardware threads", "0");
+    d.insert("profile_file", CPK_STRING, "file where the sampled phases are written in the Chrome trace event format", "z3-profile.json");
 }
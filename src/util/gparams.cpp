@@ -22,9 +22,49 @@ Notes:
 #include "util/mutex.h"
 #include "util/region.h"
 #include "util/map.h"
+#include <atomic>
+#include <string>
 
 static DECLARE_MUTEX(gparams_mux);
 
+// incremented, while gparams_mux is held, whenever parameters are set or reset.
+static std::atomic<unsigned> g_params_version(1);
+
+/**
+   \brief Per thread cache of the module parameters returned by get_module.
+   An entry is valid as long as its version is the current one.
+*/
+struct module_params_cache {
+    static const unsigned SIZE = 16;
+    struct entry {
+        std::string m_name;
+        unsigned    m_version { 0 };
+        params_ref  m_params;
+    };
+    entry    m_entries[SIZE];
+    unsigned m_next { 0 };
+
+    bool find(char const * name, unsigned version, params_ref & result) const {
+        for (entry const & e : m_entries) {
+            if (e.m_version == version && e.m_name == name) {
+                result = e.m_params;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void insert(char const * name, unsigned version, params_ref const & p) {
+        entry & e = m_entries[m_next];
+        m_next = (m_next + 1) % SIZE;
+        e.m_name = name;
+        e.m_version = version;
+        e.m_params = p;
+    }
+};
+
+static thread_local module_params_cache g_module_params_cache;
+
 extern void gparams_register_modules();
 
 static char const * g_old_params_names[] = {
@@ -183,6 +223,7 @@ public:
 
     void reset() {
         lock_guard lock(*gparams_mux);
+        g_params_version++;
         m_params.reset();
         for (auto & kv : m_module_params) {
             dealloc(kv.m_value);
@@ -395,6 +436,7 @@ public:
         std::string m, p;
         normalize(name, m, p);
         lock_guard lock(*gparams_mux);
+        g_params_version++;
         if (!m[0]) {
             validate_type(p, value, get_param_descrs());
             set(get_param_descrs(), p, value, m);
@@ -463,15 +505,22 @@ public:
 
     // unfortunately, params_ref is not thread safe
     // so better create a local copy of the parameters.
+    // The copy is cached for the thread until parameters are set or reset.
     params_ref get_module(char const* module_name) {
         params_ref result;
+        module_params_cache & cache = g_module_params_cache;
+        if (cache.find(module_name, g_params_version, result))
+            return result;
         params_ref * ps = nullptr;
+        unsigned version;
         {
             lock_guard lock(*gparams_mux);
+            version = g_params_version;
             if (m_module_params.find(module_name, ps)) {
                 result.copy(*ps);
             }
         }
+        cache.insert(module_name, version, result);
         return result;
     }
     
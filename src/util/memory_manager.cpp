@@ -13,6 +13,7 @@ Copyright (c) 2015 Microsoft Corporation
 #include "util/error_codes.h"
 #include "util/debug.h"
 #include "util/scoped_timer.h"
+#include "util/thread_pool.h"
 // The following two function are automatically generated by the mk_make.py script.
 // The script collects ADD_INITIALIZER and ADD_FINALIZER commands in the .h files.
 // For example, rational.h contains
@@ -39,11 +40,11 @@ out_of_memory_error::out_of_memory_error():z3_error(ERR_MEMOUT) {
 static DECLARE_INIT_MUTEX(g_memory_mux);
 static atomic<bool> g_memory_out_of_memory(false);
 static bool       g_memory_initialized       = false;
-static long long  g_memory_alloc_size        = 0;
+static atomic<long long> g_memory_alloc_size(0);
 static long long  g_memory_max_size          = 0;
-static long long  g_memory_max_used_size     = 0;
+static atomic<long long> g_memory_max_used_size(0);
 static long long  g_memory_watermark         = 0;
-static long long  g_memory_alloc_count       = 0;
+static atomic<long long> g_memory_alloc_count(0);
 static long long  g_memory_max_alloc_count   = 0;
 static bool       g_exit_when_out_of_memory  = false;
 static char const * g_out_of_memory_msg      = "ERROR: out of memory";
@@ -114,7 +115,6 @@ void memory::set_high_watermark(size_t watermark) {
 bool memory::above_high_watermark() {
     if (g_memory_watermark == 0)
         return false;
-    lock_guard lock(*g_memory_mux);
     return g_memory_watermark < g_memory_alloc_size;
 }
 
@@ -143,28 +143,20 @@ void memory::finalize(bool shutdown) {
 
         if (shutdown) {
             scoped_timer::finalize();
+            thread_pool::finalize();
         }
     }
 }
 
 unsigned long long memory::get_allocation_size() {
-    long long r;
-    {
-        lock_guard lock(*g_memory_mux);
-        r = g_memory_alloc_size;
-    }
+    long long r = g_memory_alloc_size;
     if (r < 0)
         r = 0;
     return r;
 }
 
 unsigned long long memory::get_max_used_memory() {
-    unsigned long long r;
-    {
-        lock_guard lock(*g_memory_mux);
-        r = g_memory_max_used_size;
-    }
-    return r;
+    return g_memory_max_used_size;
 }
 
 #if defined(_WINDOWS)
@@ -183,10 +175,6 @@ unsigned long long memory::get_max_memory_size() {
 #endif
 }
 
-unsigned long long memory::get_allocation_count() {
-    return g_memory_alloc_count;
-}
-
 
 void memory::display_max_usage(std::ostream & os) {
     unsigned long long mem = get_max_used_memory();
@@ -215,6 +203,88 @@ void * memory::allocate(char const* file, int line, char const* obj, size_t s) {
 }
 #endif
 
+// ==================================
+// ==================================
+// ALLOCATOR BACKEND
+// ==================================
+// ==================================
+// When the allocator reports the size of a block, the blocks are handed out as is.
+// Otherwise, the size of the block is stored in an extra field in front of it.
+
+#if defined(__GLIBC__)
+#include <malloc.h>
+#define HAS_MALLOC_USABLE_SIZE
+#define z3_malloc_size(p) malloc_usable_size(p)
+#elif defined(__APPLE__)
+#include <malloc/malloc.h>
+#define HAS_MALLOC_USABLE_SIZE
+#define z3_malloc_size(p) malloc_size(p)
+#elif defined(_WINDOWS)
+#include <malloc.h>
+#define HAS_MALLOC_USABLE_SIZE
+#define z3_malloc_size(p) _msize(p)
+#endif
+
+#ifdef HAS_MALLOC_USABLE_SIZE
+
+static inline size_t block_size(void * p) {
+    return z3_malloc_size(p);
+}
+
+static inline void * block_malloc(size_t s, size_t & sz) {
+    void * r = malloc(s == 0 ? 1 : s);
+    sz = r ? z3_malloc_size(r) : 0;
+    return r;
+}
+
+static inline void * block_realloc(void * p, size_t s, size_t & sz) {
+    void * r = realloc(p, s == 0 ? 1 : s);
+    sz = r ? z3_malloc_size(r) : 0;
+    return r;
+}
+
+static inline void block_free(void * p) {
+    free(p);
+}
+
+static inline size_t block_overhead() {
+    return 0;
+}
+
+#else
+
+static inline size_t block_size(void * p) {
+    return *(reinterpret_cast<size_t*>(p) - 1);
+}
+
+static inline void * block_malloc(size_t s, size_t & sz) {
+    sz = s + sizeof(size_t); // we allocate an extra field!
+    void * r = malloc(sz);
+    if (r == nullptr)
+        return nullptr;
+    *(static_cast<size_t*>(r)) = sz;
+    return static_cast<size_t*>(r) + 1; // we return a pointer to the location after the extra field
+}
+
+static inline void * block_realloc(void * p, size_t s, size_t & sz) {
+    sz = s + sizeof(size_t);
+    void * r = realloc(reinterpret_cast<size_t*>(p) - 1, sz);
+    if (r == nullptr)
+        return nullptr;
+    *(static_cast<size_t*>(r)) = sz;
+    return static_cast<size_t*>(r) + 1;
+}
+
+static inline void block_free(void * p) {
+    free(reinterpret_cast<size_t*>(p) - 1);
+}
+
+static inline size_t block_overhead() {
+    return sizeof(size_t);
+}
+
+#endif
+
 #if !defined(SINGLE_THREAD) && (defined(_WINDOWS) || defined(_USE_THREAD_LOCAL))
 // ==================================
 // ==================================
@@ -239,16 +309,17 @@ static void synchronize_counters(bool allocating) {
     bool counts_exceeded = false;
     {
         lock_guard lock(*g_memory_mux);
-        g_memory_alloc_size += g_memory_thread_alloc_size;
-        g_memory_alloc_count += g_memory_thread_alloc_count;
-        if (g_memory_alloc_size > g_memory_max_used_size)
-            g_memory_max_used_size = g_memory_alloc_size;
-        if (g_memory_max_size != 0 && g_memory_alloc_size > g_memory_max_size)
+        long long sz = (g_memory_alloc_size += g_memory_thread_alloc_size);
+        long long count = (g_memory_alloc_count += g_memory_thread_alloc_count);
+        if (sz > g_memory_max_used_size)
+            g_memory_max_used_size = sz;
+        if (g_memory_max_size != 0 && sz > g_memory_max_size)
             out_of_mem = true;
-        if (g_memory_max_alloc_count != 0 && g_memory_alloc_count > g_memory_max_alloc_count)
+        if (g_memory_max_alloc_count != 0 && count > g_memory_max_alloc_count)
             counts_exceeded = true;
     }
     g_memory_thread_alloc_size = 0;
+    g_memory_thread_alloc_count = 0;
     if (out_of_mem && allocating) {
         throw_out_of_memory();
     }
@@ -257,53 +328,49 @@ static void synchronize_counters(bool allocating) {
     }
 }
 
+unsigned long long memory::get_allocation_count() {
+    // include the allocations of the calling thread that were not synchronized yet
+    return g_memory_alloc_count + g_memory_thread_alloc_count;
+}
+
 void memory::deallocate(void * p) {
-    size_t * sz_p  = reinterpret_cast<size_t*>(p) - 1;
-    size_t sz      = *sz_p;
-    void * real_p  = reinterpret_cast<void*>(sz_p);
-    g_memory_thread_alloc_size -= sz;
-    free(real_p);
+    g_memory_thread_alloc_size -= block_size(p);
+    block_free(p);
     if (g_memory_thread_alloc_size < -SYNCH_THRESHOLD) {
         synchronize_counters(false);
     }
 }
 
 void * memory::allocate(size_t s) {
-    s = s + sizeof(size_t); // we allocate an extra field!
-    void * r = malloc(s);
-    if (r == 0) {
+    size_t sz;
+    void * r = block_malloc(s, sz);
+    if (r == nullptr) {
         throw_out_of_memory();
         return nullptr;
     }
-    *(static_cast<size_t*>(r)) = s;
-    g_memory_thread_alloc_size += s;
+    g_memory_thread_alloc_size += sz;
     g_memory_thread_alloc_count += 1;
     if (g_memory_thread_alloc_size > SYNCH_THRESHOLD) {
         synchronize_counters(true);
     }
-
-    return static_cast<size_t*>(r) + 1; // we return a pointer to the location after the extra field
+    return r;
 }
 
 void* memory::reallocate(void *p, size_t s) {
-    size_t *sz_p = reinterpret_cast<size_t*>(p)-1;
-    size_t sz = *sz_p;
-    void *real_p = reinterpret_cast<void*>(sz_p);
-    s = s + sizeof(size_t); // we allocate an extra field!
-
-    g_memory_thread_alloc_size += s - sz;
+    // account for the requested size before the block is moved
+    g_memory_thread_alloc_size += static_cast<long long>(s + block_overhead()) - static_cast<long long>(block_size(p));
     g_memory_thread_alloc_count += 1;
     if (g_memory_thread_alloc_size > SYNCH_THRESHOLD) {
         synchronize_counters(true);
     }
-
-    void *r = realloc(real_p, s);
-    if (r == 0) {
+    size_t sz;
+    void *r = block_realloc(p, s, sz);
+    if (r == nullptr) {
         throw_out_of_memory();
         return nullptr;
     }
-    *(static_cast<size_t*>(r)) = s;
-    return static_cast<size_t*>(r) + 1; // we return a pointer to the location after the extra field
+    g_memory_thread_alloc_size += sz - s - block_overhead();
+    return r;
 }
 
 #else
@@ -312,64 +379,67 @@ void* memory::reallocate(void *p, size_t s) {
 // NO THREAD LOCAL VERSION
 // ==================================
 // ==================================
-// allocate & deallocate without using thread local storage
+// allocate & deallocate without using thread local storage.
+// The counters are updated atomically; the maximal used size is
+// a statistic and may miss a peak reached by concurrent updates.
+
+unsigned long long memory::get_allocation_count() {
+    return g_memory_alloc_count;
+}
+
+static void check_counters(long long sz, long long count) {
+    if (sz > g_memory_max_used_size)
+        g_memory_max_used_size = sz;
+    if (g_memory_max_size != 0 && sz > g_memory_max_size)
+        throw_out_of_memory();
+    if (g_memory_max_alloc_count != 0 && count > g_memory_max_alloc_count)
+        throw_alloc_counts_exceeded();
+}
 
 void memory::deallocate(void * p) {
-    size_t * sz_p  = reinterpret_cast<size_t*>(p) - 1;
-    size_t sz      = *sz_p;
-    void * real_p  = reinterpret_cast<void*>(sz_p);
-    {
-        lock_guard lock(*g_memory_mux);
-        g_memory_alloc_size -= sz;
-    }
-    free(real_p);
+    g_memory_alloc_size -= block_size(p);
+    block_free(p);
 }
 
 void * memory::allocate(size_t s) {
-    s = s + sizeof(size_t); // we allocate an extra field!
-    {
-        lock_guard lock(*g_memory_mux);
-        g_memory_alloc_size += s;
-        g_memory_alloc_count += 1;
-        if (g_memory_alloc_size > g_memory_max_used_size)
-            g_memory_max_used_size = g_memory_alloc_size;
-        if (g_memory_max_size != 0 && g_memory_alloc_size > g_memory_max_size)
-            throw_out_of_memory();
-        if (g_memory_max_alloc_count != 0 && g_memory_alloc_count > g_memory_max_alloc_count)
-            throw_alloc_counts_exceeded();
-    }
-    void * r = malloc(s);
+    size_t sz;
+    void * r = block_malloc(s, sz);
     if (r == nullptr) {
         throw_out_of_memory();
         return nullptr;
     }
-    *(static_cast<size_t*>(r)) = s;
-    return static_cast<size_t*>(r) + 1; // we return a pointer to the location after the extra field
+    long long total = (g_memory_alloc_size += sz);
+    long long count = (g_memory_alloc_count += 1);
+    try {
+        check_counters(total, count);
+    }
+    catch (...) {
+        deallocate(r);
+        throw;
+    }
+    return r;
 }
 
 void* memory::reallocate(void *p, size_t s) {
-    size_t * sz_p  = reinterpret_cast<size_t*>(p) - 1;
-    size_t sz      = *sz_p;
-    void * real_p  = reinterpret_cast<void*>(sz_p);
-    s = s + sizeof(size_t); // we allocate an extra field!
-    {
-        lock_guard lock(*g_memory_mux);
-        g_memory_alloc_size += s - sz;
-        g_memory_alloc_count += 1;
-        if (g_memory_alloc_size > g_memory_max_used_size)
-            g_memory_max_used_size = g_memory_alloc_size;
-        if (g_memory_max_size != 0 && g_memory_alloc_size > g_memory_max_size)
-            throw_out_of_memory();
-        if (g_memory_max_alloc_count != 0 && g_memory_alloc_count > g_memory_max_alloc_count)
-            throw_alloc_counts_exceeded();
+    // account for the requested size before the block is moved
+    long long delta = static_cast<long long>(s + block_overhead()) - static_cast<long long>(block_size(p));
+    long long total = (g_memory_alloc_size += delta);
+    long long count = (g_memory_alloc_count += 1);
+    try {
+        check_counters(total, count);
+    }
+    catch (...) {
+        g_memory_alloc_size -= delta;
+        throw;
     }
-    void *r = realloc(real_p, s);
+    size_t sz;
+    void *r = block_realloc(p, s, sz);
     if (r == nullptr) {
         throw_out_of_memory();
         return nullptr;
     }
-    *(static_cast<size_t*>(r)) = s;
-    return static_cast<size_t*>(r) + 1; // we return a pointer to the location after the extra field
+    g_memory_alloc_size += sz - s - block_overhead();
+    return r;
 }
  
 #endif
@@ -55,7 +55,7 @@ class mpq_manager : public mpz_manager<SYNCH> {
 
     void normalize(mpq & a) {
         if (SYNCH) {
-            mpz tmp;
+            mpz_stack tmp;
             gcd(a.m_num, a.m_den, tmp);
             if (is_one(tmp)) {
                 del(tmp);
@@ -79,7 +79,7 @@ class mpq_manager : public mpz_manager<SYNCH> {
     void rat_add(mpq const & a, mpz const & b, mpq & c) {
         STRACE("rat_mpq", tout << "[mpq] " << to_string(a) << " + " << to_string(b) << " == ";); 
         if (SYNCH) {
-            mpz tmp1;
+            mpz_stack tmp1;
             mul(b, a.m_den, tmp1);
             set(c.m_den, a.m_den);
             add(a.m_num, tmp1, c.m_num);
@@ -440,7 +440,7 @@ public:
             return;
         }
         if (&b == &c) {
-            mpz tmp; // it is not safe to use c.m_num at this point.
+            mpz_stack tmp; // it is not safe to use c.m_num at this point.
             mul(a.m_num, b.m_den, tmp);
             mul(a.m_den, b.m_num, c.m_den);
             set(c.m_num, tmp);
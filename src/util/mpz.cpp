@@ -179,6 +179,73 @@ mpz_manager<SYNCH>::~mpz_manager() {
 }
 
 #ifndef _MP_GMP
+#ifndef SINGLE_THREAD
+/**
+   \brief Per thread cache of the cells of the synchronized managers.
+
+   The cells of a synchronized manager are allocated by the memory manager,
+   so a cell released by any synchronized manager can be reused by any other
+   one in the same thread. Cells are kept in one free list per capacity,
+   and only small capacities are cached, since these are the ones used by
+   the temporaries of rational arithmetic.
+*/
+class mpz_cell_cache {
+    static const unsigned MAX_CAPACITY = 32;
+    static const unsigned MAX_CELLS = 64;
+    struct free_cell { free_cell * m_next; };
+    free_cell * m_free[MAX_CAPACITY + 1];
+    unsigned    m_num_free[MAX_CAPACITY + 1];
+public:
+    mpz_cell_cache() {
+        for (unsigned i = 0; i <= MAX_CAPACITY; ++i) {
+            m_free[i] = nullptr;
+            m_num_free[i] = 0;
+        }
+    }
+
+    ~mpz_cell_cache();
+
+    mpz_cell * allocate(unsigned capacity) {
+        if (capacity <= MAX_CAPACITY && m_free[capacity]) {
+            free_cell * c = m_free[capacity];
+            m_free[capacity] = c->m_next;
+            m_num_free[capacity]--;
+            return reinterpret_cast<mpz_cell*>(c);
+        }
+        return nullptr;
+    }
+
+    bool deallocate(unsigned capacity, mpz_cell * ptr) {
+        if (capacity > MAX_CAPACITY || m_num_free[capacity] >= MAX_CELLS)
+            return false;
+        free_cell * c = reinterpret_cast<free_cell*>(ptr);
+        c->m_next = m_free[capacity];
+        m_free[capacity] = c;
+        m_num_free[capacity]++;
+        return true;
+    }
+};
+
+// cells released after the cache of the thread was destroyed go to the memory manager.
+static thread_local bool g_cell_cache_destroyed = false;
+
+mpz_cell_cache::~mpz_cell_cache() {
+    g_cell_cache_destroyed = true;
+    for (unsigned i = 0; i <= MAX_CAPACITY; ++i) {
+        while (m_free[i]) {
+            free_cell * c = m_free[i];
+            m_free[i] = c->m_next;
+            memory::deallocate(c);
+        }
+    }
+}
+
+static mpz_cell_cache * get_cell_cache() {
+    static thread_local mpz_cell_cache cache;
+    return g_cell_cache_destroyed ? nullptr : &cache;
+}
+#endif
+
 template<bool SYNCH>
 mpz_cell * mpz_manager<SYNCH>::allocate(unsigned capacity) {
     SASSERT(capacity >= m_init_cell_capacity);
@@ -187,7 +254,10 @@ mpz_cell * mpz_manager<SYNCH>::allocate(unsigned capacity) {
     cell = reinterpret_cast<mpz_cell*>(m_allocator.allocate(cell_size(capacity)));
 #else
     if (SYNCH) {
-        cell = reinterpret_cast<mpz_cell*>(memory::allocate(cell_size(capacity)));
+        mpz_cell_cache * cache = get_cell_cache();
+        cell = cache ? cache->allocate(capacity) : nullptr;
+        if (!cell)
+            cell = reinterpret_cast<mpz_cell*>(memory::allocate(cell_size(capacity)));
     }
     else {
         cell = reinterpret_cast<mpz_cell*>(m_allocator.allocate(cell_size(capacity)));
@@ -206,7 +276,9 @@ void mpz_manager<SYNCH>::deallocate(bool is_heap, mpz_cell * ptr) {
         m_allocator.deallocate(cell_size(ptr->m_capacity), ptr); 
 #else
         if (SYNCH) {
-            memory::deallocate(ptr);
+            mpz_cell_cache * cache = get_cell_cache();
+            if (!cache || !cache->deallocate(ptr->m_capacity, ptr))
+                memory::deallocate(ptr);
         }
         else {
             m_allocator.deallocate(cell_size(ptr->m_capacity), ptr);        
@@ -27,6 +27,11 @@ struct lock_guard {
   lock_guard(mutex &) {}
 };
 
+struct recursive_mutex {
+  void lock() {}
+  void unlock() {}
+};
+
 #define DECLARE_MUTEX(name) mutex *name = nullptr
 #define DECLARE_INIT_MUTEX(name) mutex *name = nullptr
 #define ALLOC_MUTEX(name) (void)0
@@ -39,6 +44,7 @@ struct lock_guard {
 template<typename T> using atomic = std::atomic<T>;
 typedef std::mutex mutex;
 typedef std::lock_guard<std::mutex> lock_guard;
+typedef std::recursive_mutex recursive_mutex;
 
 #define ATOMIC_EXCHANGE(ret, var, val) ret = var.exchange(val)
 #define DECLARE_MUTEX(name) mutex *name = nullptr
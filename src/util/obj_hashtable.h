@@ -52,7 +52,11 @@ public:
 
 };
 
-template<typename Key, typename Value>
+/**
+   \brief Map from objects to values. The hashtable implementation can be
+   selected per instantiation, e.g., obj_map<expr, unsigned, swiss_hashtable>.
+*/
+template<typename Key, typename Value, template<typename, typename, typename> class Table = core_hashtable>
 class obj_map {
 public:
     struct key_data {
@@ -93,7 +97,7 @@ public:
         void mark_as_free() { m_data.m_key = nullptr; }
     };
 
-    typedef core_hashtable<obj_map_entry, obj_hash<key_data>, default_eq<key_data> > table;
+    typedef Table<obj_map_entry, obj_hash<key_data>, default_eq<key_data> > table;
 
     table m_table;
   
@@ -18,6 +18,9 @@ Revision History:
 --*/
 #include "util/page.h"
 #include "util/debug.h"
+#if defined(__linux__)
+#include <sys/mman.h>
+#endif
 
 inline void set_page_header(char * page, char * prev, bool default_page) {
     size_t header = reinterpret_cast<size_t>(prev) | static_cast<size_t>(default_page); 
@@ -26,7 +29,23 @@ inline void set_page_header(char * page, char * prev, bool default_page) {
     SASSERT(prev_page(page) == prev);
 }
 
-inline char * alloc_page(size_t s) { char * r = alloc_svect(char, s+PAGE_HEADER_SZ); return r + PAGE_HEADER_SZ; }
+// Ask the kernel to back the huge page aligned part of the page by huge pages.
+inline void advise_huge_page(char * p, size_t s) {
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+    if (s < HUGE_PAGE_SIZE)
+        return;
+    size_t begin = (reinterpret_cast<size_t>(p) + HUGE_PAGE_SIZE - 1) & ~static_cast<size_t>(HUGE_PAGE_SIZE - 1);
+    size_t end   = (reinterpret_cast<size_t>(p) + s) & ~static_cast<size_t>(HUGE_PAGE_SIZE - 1);
+    if (begin < end)
+        madvise(reinterpret_cast<void *>(begin), end - begin, MADV_HUGEPAGE);
+#endif
+}
+
+inline char * alloc_page(size_t s) { 
+    char * r = alloc_svect(char, s+PAGE_HEADER_SZ); 
+    advise_huge_page(r, s+PAGE_HEADER_SZ);
+    return r + PAGE_HEADER_SZ; 
+}
 
 inline void del_page(char * page) { dealloc_svect(page - PAGE_HEADER_SZ); }
 
@@ -38,19 +57,23 @@ void del_pages(char * page) {
     }
 }
 
-char * allocate_default_page(char * prev, char * & free_pages) {
+char * allocate_default_page(char * prev, char * & free_pages, size_t sz) {
     char * r;
     if (free_pages) {
         r = free_pages;
         free_pages = prev_page(free_pages);
     }
     else {
-        r = alloc_page(DEFAULT_PAGE_SIZE);
+        r = alloc_page(sz);
     }
     set_page_header(r, prev, true);
     return r;
 }
 
+char * allocate_default_page(char * prev, char * & free_pages) {
+    return allocate_default_page(prev, free_pages, DEFAULT_PAGE_SIZE);
+}
+
 char * allocate_page(char * prev, size_t sz) {
     char * r = alloc_page(sz);
     set_page_header(r, prev, false);
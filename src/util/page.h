@@ -32,9 +32,16 @@ inline bool is_default_page(char * page) {
     size_t tagged_ptr = reinterpret_cast<size_t *>(page)[-1];
     return static_cast<bool>(tagged_ptr & 1);
 }
+// pages of at least this size are backed by huge pages where the platform supports it.
+#define HUGE_PAGE_SIZE (2*1024*1024)
+
 inline char * end_of_default_page(char * p) { return p + DEFAULT_PAGE_SIZE; }
 void del_pages(char * page);
 char * allocate_default_page(char * prev, char * & free_pages);
+/**
+   \brief Allocate a recyclable page of the given size. All pages in free_pages must have this size.
+*/
+char * allocate_default_page(char * prev, char * & free_pages, size_t sz);
 char * allocate_page(char * prev, size_t sz);
 void recycle_page(char * p, char * & free_pages);
 
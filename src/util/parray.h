@@ -291,6 +291,13 @@ public:
         t.m_updt_counter = 0; 
     }
 
+    /**
+       \brief Return true if s and t are copies of each other that have not been updated since.
+    */
+    bool is_shared(ref const & s, ref const & t) const {
+        return s.m_ref == t.m_ref;
+    }
+
     unsigned size(ref const & r) const {
         cell * c = r.m_ref;
         if (c == nullptr) return 0;
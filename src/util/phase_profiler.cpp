@@ -0,0 +1,255 @@
+/*++
+Copyright (c) 2021 Microsoft Corporation
+
+Module Name:
+
+    phase_profiler.cpp
+
+Abstract:
+
+    Sampling profiler for the phases of the solvers.
+
+    A phase stack is only written by its thread. The sampler reads the
+    depth with acquire semantics and then the names below the depth;
+    a name is written before the depth is incremented. A sample that
+    races with a pop may observe a stale name, which only affects the
+    sample.
+
+    The sampler keeps, per thread and stack level, the phase that was
+    observed last and when it was first observed. When a level changes,
+    the events of the level and the levels above it are closed. The
+    events are complete events ("ph":"X") of the Chrome trace event
+    format, so nested phases appear as a flame chart.
+
+    The profiler uses the standard allocator, so it does not interfere
+    with the memory limits of the solvers.
+
+--*/
+
+#include "util/phase_profiler.h"
+#include <chrono>
+#include <condition_variable>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace phase_profiler {
+
+    std::atomic<bool> g_enabled(false);
+
+    static const unsigned MAX_DEPTH = 32;
+
+    struct phase_stack;
+
+    struct event {
+        char const * m_name;
+        unsigned     m_tid;
+        long long    m_start;
+        long long    m_end;
+    };
+
+    struct level {
+        char const * m_name  { nullptr };
+        long long    m_start { 0 };
+    };
+
+    struct thread_state {
+        unsigned           m_tid;
+        std::vector<level> m_levels;
+    };
+
+    struct state {
+        std::mutex                 m_mux;        // guards m_stacks and the sampler
+        std::vector<phase_stack*>  m_stacks;
+        unsigned                   m_next_tid { 0 };
+        std::thread                m_sampler;
+        std::condition_variable    m_cv;
+        bool                       m_stop { false };
+        bool                       m_running { false };
+        unsigned                   m_sample_ms { 0 };
+        std::string                m_file;
+        std::vector<event>         m_events;
+        std::vector<thread_state>  m_threads;    // indexed by thread id
+        std::chrono::steady_clock::time_point m_epoch;
+    };
+
+    static state& get_state() {
+        // leaked on purpose: threads may unregister during static destruction.
+        static state* s = new state();
+        return *s;
+    }
+
+    struct phase_stack {
+        std::atomic<unsigned> m_depth { 0 };
+        char const *          m_names[MAX_DEPTH];
+        unsigned              m_tid;
+
+        phase_stack() {
+            state& s = get_state();
+            std::lock_guard<std::mutex> lock(s.m_mux);
+            m_tid = s.m_next_tid++;
+            s.m_stacks.push_back(this);
+        }
+
+        ~phase_stack() {
+            state& s = get_state();
+            std::lock_guard<std::mutex> lock(s.m_mux);
+            for (unsigned i = 0; i < s.m_stacks.size(); ++i) {
+                if (s.m_stacks[i] == this) {
+                    s.m_stacks[i] = s.m_stacks.back();
+                    s.m_stacks.pop_back();
+                    break;
+                }
+            }
+        }
+    };
+
+    static phase_stack& get_stack() {
+        static thread_local phase_stack st;
+        return st;
+    }
+
+    void push(char const * name) {
+        phase_stack& st = get_stack();
+        unsigned d = st.m_depth.load(std::memory_order_relaxed);
+        if (d < MAX_DEPTH)
+            st.m_names[d] = name;
+        st.m_depth.store(d + 1, std::memory_order_release);
+    }
+
+    void pop() {
+        phase_stack& st = get_stack();
+        unsigned d = st.m_depth.load(std::memory_order_relaxed);
+        if (d > 0)
+            st.m_depth.store(d - 1, std::memory_order_release);
+    }
+
+    static long long now(state& s) {
+        return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - s.m_epoch).count();
+    }
+
+    static void close_levels(state& s, thread_state& ts, unsigned from, long long t) {
+        for (unsigned i = ts.m_levels.size(); i-- > from; ) {
+            level const& l = ts.m_levels[i];
+            if (l.m_name)
+                s.m_events.push_back({ l.m_name, ts.m_tid, l.m_start, t });
+        }
+        ts.m_levels.resize(from);
+    }
+
+    static thread_state& get_thread_state(state& s, unsigned tid) {
+        while (s.m_threads.size() <= tid)
+            s.m_threads.push_back({ static_cast<unsigned>(s.m_threads.size()), {} });
+        return s.m_threads[tid];
+    }
+
+    // called with s.m_mux held
+    static void sample(state& s) {
+        long long t = now(s);
+        std::vector<bool> seen(s.m_threads.size(), false);
+        for (phase_stack* st : s.m_stacks) {
+            unsigned depth = st->m_depth.load(std::memory_order_acquire);
+            if (depth > MAX_DEPTH)
+                depth = MAX_DEPTH;
+            thread_state& ts = get_thread_state(s, st->m_tid);
+            if (seen.size() <= st->m_tid)
+                seen.resize(st->m_tid + 1, false);
+            seen[st->m_tid] = true;
+            unsigned i = 0;
+            for (; i < depth && i < ts.m_levels.size(); ++i)
+                if (ts.m_levels[i].m_name != st->m_names[i])
+                    break;
+            close_levels(s, ts, i, t);
+            for (; i < depth; ++i)
+                ts.m_levels.push_back({ st->m_names[i], t });
+        }
+        // threads that exited
+        for (unsigned tid = 0; tid < s.m_threads.size(); ++tid)
+            if (!seen[tid])
+                close_levels(s, s.m_threads[tid], 0, t);
+    }
+
+    static void run_sampler() {
+        state& s = get_state();
+        std::unique_lock<std::mutex> lock(s.m_mux);
+        while (!s.m_stop) {
+            s.m_cv.wait_for(lock, std::chrono::milliseconds(s.m_sample_ms));
+            sample(s);
+        }
+    }
+
+    static void display_string(std::ostream& out, char const * str) {
+        out << '"';
+        for (; *str; ++str) {
+            if (*str == '"' || *str == '\\')
+                out << '\\';
+            out << *str;
+        }
+        out << '"';
+    }
+
+    static void write_trace(state& s) {
+        std::ofstream out(s.m_file);
+        if (!out) {
+            std::cerr << "(error \"could not open profile file " << s.m_file << "\")\n";
+            return;
+        }
+        out << "{\"traceEvents\":[\n";
+        bool first = true;
+        for (event const& e : s.m_events) {
+            if (!first)
+                out << ",\n";
+            first = false;
+            out << "{\"name\":";
+            display_string(out, e.m_name);
+            out << ",\"ph\":\"X\",\"pid\":1,\"tid\":" << e.m_tid
+                << ",\"ts\":" << e.m_start << ",\"dur\":" << (e.m_end - e.m_start) << "}";
+        }
+        out << "\n],\"displayTimeUnit\":\"ms\"}\n";
+    }
+
+    void start(unsigned sample_ms, char const * file) {
+        stop();
+        state& s = get_state();
+        {
+            std::lock_guard<std::mutex> lock(s.m_mux);
+            s.m_sample_ms = sample_ms == 0 ? 1 : sample_ms;
+            s.m_file = file;
+            s.m_events.clear();
+            s.m_threads.clear();
+            s.m_stop = false;
+            s.m_running = true;
+            s.m_epoch = std::chrono::steady_clock::now();
+        }
+        g_enabled = true;
+        s.m_sampler = std::thread(run_sampler);
+    }
+
+    void stop() {
+        state& s = get_state();
+        {
+            std::lock_guard<std::mutex> lock(s.m_mux);
+            if (!s.m_running)
+                return;
+            s.m_stop = true;
+        }
+        g_enabled = false;
+        s.m_cv.notify_all();
+        s.m_sampler.join();
+        std::lock_guard<std::mutex> lock(s.m_mux);
+        long long t = now(s);
+        for (thread_state& ts : s.m_threads)
+            close_levels(s, ts, 0, t);
+        write_trace(s);
+        s.m_events.clear();
+        s.m_threads.clear();
+        s.m_running = false;
+    }
+};
+
+void finalize_phase_profiler() {
+    phase_profiler::stop();
+}
@@ -0,0 +1,63 @@
+/*++
+Copyright (c) 2021 Microsoft Corporation
+
+Module Name:
+
+    phase_profiler.h
+
+Abstract:
+
+    Sampling profiler for the phases of the solvers.
+
+    Every thread keeps a stack of the phases it is in, such as the
+    tactic or the inprocessing pass that runs. A phase is entered with
+    a scoped_phase object and its name must be a static string. When
+    sampling is enabled (global parameter profile_sample_ms), a
+    thread samples the phase stacks of all threads at the given rate.
+    The samples are written in the Chrome trace event format to the
+    file given by the global parameter profile_file when the profiler
+    is stopped or memory is finalized.
+
+--*/
+#pragma once
+
+#include <atomic>
+
+void finalize_phase_profiler();
+/*
+  ADD_FINALIZER('finalize_phase_profiler();')
+*/
+
+namespace phase_profiler {
+
+    extern std::atomic<bool> g_enabled;
+
+    /**
+       \brief Start sampling every sample_ms milliseconds. The trace is written to file.
+       A running profiler is stopped first.
+    */
+    void start(unsigned sample_ms, char const * file);
+
+    /**
+       \brief Stop sampling and write the trace.
+    */
+    void stop();
+
+    inline bool enabled() { return g_enabled.load(std::memory_order_relaxed); }
+
+    void push(char const * name);
+    void pop();
+};
+
+class scoped_phase {
+    bool m_active;
+public:
+    scoped_phase(char const * name): m_active(phase_profiler::enabled()) {
+        if (m_active)
+            phase_profiler::push(name);
+    }
+    ~scoped_phase() {
+        if (m_active)
+            phase_profiler::pop();
+    }
+};
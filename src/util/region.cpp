@@ -17,6 +17,7 @@ Revision History:
 
 --*/
 #include "util/region.h"
+#include "util/statistics.h"
 
 #ifdef Z3DEBUG
 
@@ -24,6 +25,10 @@ void region::display_mem_stats(std::ostream & out) const {
     out << "num. objects:      " << m_chunks.size() << "\n";
 }
 
+void region::collect_statistics(statistics & st) const {
+    st.update("region objects", m_chunks.size());
+}
+
 void * region::allocate(size_t size) {
     char * r = alloc_svect(char, size);
     m_chunks.push_back(r);
@@ -56,17 +61,19 @@ void region::pop_scope() {
 #include "util/page.h"
 
 inline void region::allocate_page() {
-    m_curr_page     = allocate_default_page(m_curr_page, m_free_pages);
+    m_curr_page     = allocate_default_page(m_curr_page, m_free_pages, m_page_size);
     m_curr_ptr      = m_curr_page;
-    m_curr_end_ptr  = end_of_default_page(m_curr_page);
+    m_curr_end_ptr  = m_curr_page + m_page_size;
 }
 
-region::region() {
+region::region(size_t page_size) {
     m_curr_page    = nullptr;
     m_curr_ptr     = nullptr;
     m_curr_end_ptr = nullptr;
     m_free_pages   = nullptr;
     m_mark         = nullptr;
+    m_page_size    = page_size == 0 ? DEFAULT_PAGE_SIZE : page_size;
+    m_allocated    = 0;
     allocate_page();
 }
 
@@ -77,12 +84,13 @@ region::~region() {
 
 void * region::allocate(size_t size) {
     char * new_curr_ptr = m_curr_ptr + size;
+    m_allocated += size;
     if (new_curr_ptr < m_curr_end_ptr) {
         char * result = m_curr_ptr;
         m_curr_ptr = ALIGN(char *, new_curr_ptr);
         return result;
     }
-    else if (size < DEFAULT_PAGE_SIZE) {
+    else if (size < m_page_size) {
         allocate_page(); 
         char * result = m_curr_ptr;
         m_curr_ptr += size;
@@ -112,13 +120,15 @@ void region::reset() {
     m_curr_ptr     = nullptr;
     m_curr_end_ptr = nullptr;
     m_mark         = nullptr;
+    m_allocated    = 0;
     allocate_page();
 }
 
 void region::push_scope() {
     char * curr_page = m_curr_page;
     char * curr_ptr  = m_curr_ptr;
-    m_mark = new (*this) mark(curr_page, curr_ptr, m_mark);
+    size_t allocated = m_allocated;
+    m_mark = new (*this) mark(curr_page, curr_ptr, m_mark, allocated);
 }
 
 void region::pop_scope() {
@@ -126,22 +136,33 @@ void region::pop_scope() {
     char * old_curr_page = m_mark->m_curr_page;
     SASSERT(is_default_page(old_curr_page));
     m_curr_ptr           = m_mark->m_curr_ptr;
+    m_allocated          = m_mark->m_allocated;
     m_mark               = m_mark->m_prev_mark;
     while (m_curr_page != old_curr_page) {
         recycle_curr_page();
     }
     SASSERT(is_default_page(m_curr_page));
-    m_curr_end_ptr       = end_of_default_page(m_curr_page);
+    m_curr_end_ptr       = m_curr_page + m_page_size;
 }
 
-void region::display_mem_stats(std::ostream & out) const {
+static unsigned num_pages(char * page) {
     unsigned n = 0;
-    char * page = m_curr_page;
     while (page != nullptr) {
         n++;
         page = prev_page(page);
     }
-    out << "num. pages:      " << n << "\n";
+    return n;
+}
+
+void region::display_mem_stats(std::ostream & out) const {
+    out << "num. pages:      " << num_pages(m_curr_page) << "\n";
+}
+
+void region::collect_statistics(statistics & st) const {
+    unsigned n = num_pages(m_curr_page);
+    st.update("region pages", n);
+    st.update("region free pages", num_pages(m_free_pages));
+    st.update("region utilization", static_cast<double>(m_allocated) / (static_cast<double>(n) * m_page_size));
 }
 
 #endif
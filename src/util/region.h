@@ -20,6 +20,8 @@ Revision History:
 #include<cstdlib>
 #include<iostream>
 
+class statistics;
+
 #ifdef Z3DEBUG
 
 #include "util/vector.h"
@@ -28,6 +30,8 @@ class region {
     ptr_vector<char> m_chunks;
     unsigned_vector  m_scopes;
 public:
+    region(size_t /* page_size */ = 0) {}
+
     ~region() {
         reset();
     }
@@ -50,29 +54,42 @@ public:
     }
 
     void display_mem_stats(std::ostream & out) const;
+
+    void collect_statistics(statistics & st) const;
 };
 
 #else
 
 /**
 \brief Implement explicit region memory manager.
+
+The pages released by pop_scope and reset are kept for reuse by the region.
+They have the size given to the constructor; pages of at least HUGE_PAGE_SIZE
+are backed by huge pages where the platform supports it.
 */
 class region {
     struct mark {
         char * m_curr_page;
         char * m_curr_ptr;
         mark * m_prev_mark;
-        mark(char * page, char * ptr, mark * m):m_curr_page(page), m_curr_ptr(ptr), m_prev_mark(m) {}
+        size_t m_allocated;
+        mark(char * page, char * ptr, mark * m, size_t allocated):
+            m_curr_page(page), m_curr_ptr(ptr), m_prev_mark(m), m_allocated(allocated) {}
     };
     char *   m_curr_page;
     char *   m_curr_ptr;     //!< Next free space in the current page.
     char *   m_curr_end_ptr; //!< Point to the end of the current page.
     char *   m_free_pages;
     mark *   m_mark;
+    size_t   m_page_size;
+    size_t   m_allocated;    //!< Bytes requested since the region was created or reset.
     void allocate_page();
     void recycle_curr_page();
 public:
-    region();
+    /**
+       \brief Create a region whose pages have page_size bytes, 0 means DEFAULT_PAGE_SIZE.
+    */
+    region(size_t page_size = 0);
     ~region();
     void * allocate(size_t size);
     void reset();
@@ -84,6 +101,8 @@ public:
         }
     }
     void display_mem_stats(std::ostream & out) const;
+
+    void collect_statistics(statistics & st) const;
 };
 
 #endif
@@ -19,6 +19,7 @@ Revision History:
 #include "util/rlimit.h"
 #include "util/common_msgs.h"
 #include "util/mutex.h"
+#include <cstring>
 
 
 static DECLARE_MUTEX(g_rlimit_mux);
@@ -35,7 +36,8 @@ reslimit::reslimit():
     m_cancel(0),
     m_suspend(false),
     m_count(0),
-    m_limit(std::numeric_limits<uint64_t>::max()) {
+    m_limit(std::numeric_limits<uint64_t>::max()),
+    m_account_start(0) {
 }
 
 uint64_t reslimit::count() const {
@@ -71,6 +73,28 @@ void reslimit::pop() {
     m_cancel = 0;
 }
 
+void reslimit::charge_account() {
+    if (!m_account_stack.empty())
+        m_accounts[m_account_stack.back()].m_count += m_count - m_account_start;
+    m_account_start = m_count;
+}
+
+void reslimit::push_account(char const * name) {
+    charge_account();
+    unsigned idx = 0;
+    for (; idx < m_accounts.size(); ++idx)
+        if (m_accounts[idx].m_name == name || strcmp(m_accounts[idx].m_name, name) == 0)
+            break;
+    if (idx == m_accounts.size())
+        m_accounts.push_back({ name, 0 });
+    m_account_stack.push_back(idx);
+}
+
+void reslimit::pop_account() {
+    charge_account();
+    m_account_stack.pop_back();
+}
+
 char const* reslimit::get_cancel_msg() const {
     if (m_cancel > 0) {
         return Z3_CANCELED_MSG;
@@ -36,6 +36,17 @@ class reslimit {
     svector<uint64_t> m_limits;
     ptr_vector<reslimit> m_children;
 
+    // resource units charged to the subsystems that consumed them
+    struct account {
+        char const * m_name;
+        uint64_t     m_count;
+    };
+    svector<account>  m_accounts;
+    unsigned_vector   m_account_stack;
+    uint64_t          m_account_start;
+
+    void charge_account();
+
     void set_cancel(unsigned f);
     friend class scoped_suspend_rlimit;
 
@@ -59,6 +70,21 @@ public:
 
     void inc_cancel();
     void dec_cancel();
+
+    /**
+       \brief Charge the resource units consumed until the matching pop_account
+       to the account name, excluding the units charged to nested accounts.
+       name must be a static string.
+    */
+    void push_account(char const * name);
+    void pop_account();
+
+    template<typename Fn>
+    void for_each_account(Fn fn) {
+        charge_account();
+        for (account const& a : m_accounts)
+            fn(a.m_name, a.m_count);
+    }
 };
 
 class scoped_rlimit {
@@ -89,6 +115,26 @@ public:
     }
 };
 
+/**
+   \brief Charge the resource units of a scope to the account name and
+   bound them by a budget of limit units, where 0 means no budget.
+*/
+class scoped_rlimit_account {
+    reslimit& m_limit;
+    bool      m_budget;
+public:
+    scoped_rlimit_account(reslimit& r, char const * name, unsigned limit = 0): m_limit(r), m_budget(limit != 0) {
+        r.push_account(name);
+        if (m_budget)
+            r.push(limit);
+    }
+    ~scoped_rlimit_account() {
+        if (m_budget)
+            m_limit.pop();
+        m_limit.pop_account();
+    }
+};
+
 struct scoped_limits {
     reslimit&  m_limit;
     unsigned   m_sz;
@@ -24,6 +24,7 @@ Revision History:
 #include "util/util.h"
 #include <atomic>
 #include <chrono>
+#include <algorithm>
 #include <climits>
 #include <condition_variable>
 #include <mutex>
@@ -33,83 +34,209 @@ Revision History:
 #include <pthread.h>
 #endif
 
-struct scoped_timer_state {
-    std::thread m_thread;
-    std::timed_mutex m_mutex;
-    event_handler * eh;
-    unsigned ms;
-    std::atomic<int> work;
-    std::condition_variable_any cv;
-};
+/**
+   A single thread serves all timers. The timers are kept in a heap
+   ordered by deadline that is only accessed by the timer thread.
+
+   A new timer is pushed on a lock-free list of incoming timers. The
+   mutex is only taken to wake up the timer thread when the deadline of
+   the new timer is earlier than the time the thread waits for. The
+   timer thread publishes this time before and after it drains the
+   incoming list, so a timer that is not drained is either handled at the
+   next wake up or it wakes up the thread.
+
+   A timer is cancelled by its owner without taking the mutex. The entry
+   is shared by the owner and the timer thread, and it is deleted when
+   both released it. Cancelled entries are removed from the heap when
+   they expire or when they make up most of the heap.
+*/
+namespace {
+
+    typedef std::chrono::steady_clock timer_clock;
+
+    enum timer_status { TIMER_PENDING, TIMER_FIRING, TIMER_DONE };
 
-static std::vector<scoped_timer_state*> available_workers;
-static std::mutex workers;
-static atomic<unsigned> num_workers(0);
+    struct timer_entry {
+        event_handler *         m_eh;
+        timer_clock::time_point m_deadline;
+        std::atomic<int>        m_status { TIMER_PENDING };
+        std::atomic<int>        m_refs { 2 };
+        timer_entry *           m_next { nullptr };
 
-static void thread_func(scoped_timer_state *s) {
-    workers.lock();
-    while (true) {
-        s->cv.wait(workers, [=]{ return s->work > 0; });
-        workers.unlock();
+        timer_entry(event_handler * eh, unsigned ms):
+            m_eh(eh),
+            m_deadline(timer_clock::now() + std::chrono::milliseconds(ms)) {}
 
-        // exiting..
-        if (s->work == 2)
-            return;
+        void release() {
+            if (--m_refs == 0)
+                delete this;
+        }
+    };
+
+    struct later {
+        bool operator()(timer_entry * a, timer_entry * b) const { return a->m_deadline > b->m_deadline; }
+    };
+
+    class timer_service {
+        std::mutex                  m_mutex;
+        std::condition_variable     m_cv;
+        std::thread                 m_thread;
+        std::atomic<bool>           m_running { false };
+        bool                        m_stop { false };
+        std::atomic<timer_entry*>   m_incoming { nullptr };
+        std::atomic<long long>      m_wakeup { LLONG_MAX };   // deadline the thread waits for, in ticks
+        std::vector<timer_entry*>   m_heap;
 
-        auto end = std::chrono::steady_clock::now() + std::chrono::milliseconds(s->ms);
+        static long long ticks(timer_clock::time_point t) { return t.time_since_epoch().count(); }
 
-        while (!s->m_mutex.try_lock_until(end)) {
-            if (std::chrono::steady_clock::now() >= end) {
-                s->eh->operator()(TIMEOUT_EH_CALLER);
-                goto next;
+        void drain() {
+            timer_entry * e = m_incoming.exchange(nullptr);
+            while (e) {
+                timer_entry * next = e->m_next;
+                m_heap.push_back(e);
+                std::push_heap(m_heap.begin(), m_heap.end(), later());
+                e = next;
             }
         }
 
-        s->m_mutex.unlock();
+        void publish_wakeup() {
+            m_wakeup = m_heap.empty() ? LLONG_MAX : ticks(m_heap.front()->m_deadline);
+        }
 
-    next:
-        s->work = 0;
-        workers.lock();
-        available_workers.push_back(s);
-    }
-}
+        void purge() {
+            unsigned num_cancelled = 0;
+            for (timer_entry * e : m_heap)
+                if (e->m_status != TIMER_PENDING)
+                    ++num_cancelled;
+            if (num_cancelled < 64 || 2 * num_cancelled < m_heap.size())
+                return;
+            unsigned j = 0;
+            for (timer_entry * e : m_heap) {
+                if (e->m_status == TIMER_PENDING)
+                    m_heap[j++] = e;
+                else
+                    e->release();
+            }
+            m_heap.resize(j);
+            std::make_heap(m_heap.begin(), m_heap.end(), later());
+        }
+
+        void fire_expired() {
+            auto now = timer_clock::now();
+            while (!m_heap.empty() && m_heap.front()->m_deadline <= now) {
+                std::pop_heap(m_heap.begin(), m_heap.end(), later());
+                timer_entry * e = m_heap.back();
+                m_heap.pop_back();
+                int status = TIMER_PENDING;
+                if (e->m_status.compare_exchange_strong(status, TIMER_FIRING)) {
+                    e->m_eh->operator()(TIMEOUT_EH_CALLER);
+                    e->m_status = TIMER_DONE;
+                }
+                e->release();
+            }
+        }
 
+        bool has_pending() const {
+            for (timer_entry * e : m_heap)
+                if (e->m_status == TIMER_PENDING)
+                    return true;
+            return false;
+        }
 
-struct scoped_timer::imp {
-private:
-    scoped_timer_state *s;
-
-public:
-    imp(unsigned ms, event_handler * eh) {
-        workers.lock();
-        bool new_worker = false;
-        if (available_workers.empty()) {
-            workers.unlock();
-            s = new scoped_timer_state;
-            new_worker = true;
-            ++num_workers;
-        } 
-        else {
-            s = available_workers.back();
-            available_workers.pop_back();
-            workers.unlock();
+        void run() {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            while (true) {
+                publish_wakeup();
+                drain();
+                publish_wakeup();
+                fire_expired();
+                purge();
+                if (m_stop && m_incoming == nullptr && !has_pending())
+                    break;
+                publish_wakeup();
+                if (m_incoming != nullptr)
+                    continue;
+                if (m_heap.empty())
+                    m_cv.wait(lock);
+                else
+                    m_cv.wait_until(lock, m_heap.front()->m_deadline);
+            }
+            for (timer_entry * e : m_heap)
+                e->release();
+            m_heap.clear();
+            m_wakeup = LLONG_MAX;
+        }
+
+        void ensure_running() {
+            if (m_running)
+                return;
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (m_running)
+                return;
+            m_stop = false;
+            m_thread = std::thread([this]() { run(); });
+            m_running = true;
+        }
+
+    public:
+
+        void add(timer_entry * e) {
+            ensure_running();
+            timer_entry * head = m_incoming.load();
+            do {
+                e->m_next = head;
+            }
+            while (!m_incoming.compare_exchange_weak(head, e));
+            if (ticks(e->m_deadline) < m_wakeup) {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_cv.notify_one();
+            }
         }
-        s->ms = ms;
-        s->eh = eh;
-        s->m_mutex.lock();
-        s->work = 1;
-        if (new_worker) {
-            s->m_thread = std::thread(thread_func, s);
-        } 
-        else {
-            s->cv.notify_one();
+
+        void cancel(timer_entry * e) {
+            int status = TIMER_PENDING;
+            if (!e->m_status.compare_exchange_strong(status, TIMER_DONE)) {
+                // the handler may be running
+                while (e->m_status != TIMER_DONE)
+                    std::this_thread::yield();
+            }
+            e->release();
+        }
+
+        /**
+           \brief Stop the timer thread once the pending timers expired or were cancelled.
+        */
+        void stop() {
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                if (!m_running)
+                    return;
+                m_stop = true;
+                m_cv.notify_one();
+            }
+            m_thread.join();
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_running = false;
         }
+    };
+
+    timer_service & get_timer_service() {
+        // leaked on purpose: timers may be released during static destruction.
+        static timer_service * s = new timer_service();
+        return *s;
+    }
+}
+
+struct scoped_timer::imp {
+    timer_entry * m_entry;
+
+    imp(unsigned ms, event_handler * eh):
+        m_entry(new timer_entry(eh, ms)) {
+        get_timer_service().add(m_entry);
     }
 
     ~imp() {
-        s->m_mutex.unlock();
-        while (s->work == 1)
-            std::this_thread::yield();
+        get_timer_service().cancel(m_entry);
     }
 };
 
@@ -135,23 +262,5 @@ void scoped_timer::initialize() {
 }
 
 void scoped_timer::finalize() {
-    unsigned deleted = 0;
-    while (deleted < num_workers) {
-        workers.lock();
-        for (auto w : available_workers) {
-            w->work = 2;
-            w->cv.notify_one();
-        }
-        decltype(available_workers) cleanup_workers;
-        std::swap(available_workers, cleanup_workers);
-        workers.unlock();
-
-        for (auto w : cleanup_workers) {
-            ++deleted;
-            w->m_thread.join();
-            delete w;
-        }
-    }
-    num_workers = 0;
-    available_workers.clear();
+    get_timer_service().stop();
 }
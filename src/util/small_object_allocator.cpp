@@ -23,8 +23,67 @@ Revision History:
 #include "util/debug.h"
 #include "util/util.h"
 #include "util/vector.h"
+#include "util/mutex.h"
 #include<iomanip>
 
+/**
+   Chunks released by an allocator are kept in a process-level pool,
+   so that they can be reused by the allocators of other contexts and
+   threads. At most MAX_POOLED_CHUNKS are kept; the others are returned
+   to the memory manager.
+*/
+#define MAX_POOLED_CHUNKS 512
+
+static DECLARE_INIT_MUTEX(g_chunk_mux);
+static void *   g_chunk_pool       = nullptr;
+static unsigned g_num_pooled_chunks = 0;
+
+small_object_allocator::chunk * small_object_allocator::alloc_chunk() {
+    chunk * c = nullptr;
+    {
+        lock_guard lock(*g_chunk_mux);
+        if (g_chunk_pool) {
+            c = static_cast<chunk*>(g_chunk_pool);
+            g_chunk_pool = c->m_next;
+            --g_num_pooled_chunks;
+        }
+    }
+    if (!c)
+        return alloc(chunk);
+    c->m_next = nullptr;
+    c->m_curr = c->m_data;
+    return c;
+}
+
+void small_object_allocator::dealloc_chunk(chunk * c) {
+    {
+        lock_guard lock(*g_chunk_mux);
+        if (g_num_pooled_chunks < MAX_POOLED_CHUNKS) {
+            c->m_next = static_cast<chunk*>(g_chunk_pool);
+            g_chunk_pool = c;
+            ++g_num_pooled_chunks;
+            return;
+        }
+    }
+    dealloc(c);
+}
+
+void finalize_small_object_allocator() {
+    void * pool = nullptr;
+    {
+        lock_guard lock(*g_chunk_mux);
+        pool = g_chunk_pool;
+        g_chunk_pool = nullptr;
+        g_num_pooled_chunks = 0;
+    }
+    auto * c = static_cast<small_object_allocator::chunk*>(pool);
+    while (c) {
+        auto * next = c->m_next;
+        dealloc(c);
+        c = next;
+    }
+}
+
 small_object_allocator::small_object_allocator(char const * id) {
     for (unsigned i = 0; i < NUM_SLOTS; i++) {
         m_chunks[i] = nullptr;
@@ -41,7 +100,7 @@ small_object_allocator::~small_object_allocator() {
         chunk * c = m_chunks[i];
         while (c) {
             chunk * next = c->m_next;
-            dealloc(c);
+            dealloc_chunk(c);
             c = next;
         }
     }
@@ -57,7 +116,7 @@ void small_object_allocator::reset() {
         chunk * c = m_chunks[i];
         while (c) {
             chunk * next = c->m_next;
-            dealloc(c);
+            dealloc_chunk(c);
             c = next;
         }
         m_chunks[i] = nullptr;
@@ -130,7 +189,7 @@ void * small_object_allocator::allocate(size_t size) {
             return r;
         }
     }
-    chunk * new_c = alloc(chunk);
+    chunk * new_c = alloc_chunk();
     new_c->m_next = c;
     m_chunks[slot_id] = new_c;
     void * r = new_c->m_curr;
@@ -219,7 +278,7 @@ void small_object_allocator::consolidate() {
                 num_free_in_chunk++;
             }
             if (num_free_in_chunk == num_objs_per_chunk) {
-                dealloc(curr_chunk);
+                dealloc_chunk(curr_chunk);
             }
             else {
                 curr_chunk->m_next = last_chunk;
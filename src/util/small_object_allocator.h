@@ -23,6 +23,11 @@ Revision History:
 #include "util/debug.h"
 #include "util/trace.h"
 
+void finalize_small_object_allocator();
+/*
+  ADD_FINALIZER('finalize_small_object_allocator();')
+*/
+
 class small_object_allocator {
     static const unsigned CHUNK_SIZE     = (8192 - sizeof(void*)*2);
     static const unsigned SMALL_OBJ_SIZE = 256;
@@ -33,6 +38,9 @@ class small_object_allocator {
         char    m_data[CHUNK_SIZE];
         chunk():m_curr(m_data) {}
     };
+    friend void finalize_small_object_allocator();
+    static chunk * alloc_chunk();
+    static void dealloc_chunk(chunk * c);
     chunk *     m_chunks[NUM_SLOTS];
     void  *     m_free_list[NUM_SLOTS];
     size_t      m_alloc_size;
@@ -1225,6 +1225,30 @@ Notes:
                   );
         }
 
+        /**
+           \brief Create the first k outputs of a network sorting xs, 
+           such that out[i] is implied if at least i+1 literals of xs are true.
+           Asserting the negation of out[i] restricts xs to at most i true literals,
+           so the same outputs enforce all bounds below k.
+         */
+        void at_most_outputs(unsigned k, unsigned n, literal const* xs, literal_vector& out) {
+            m_t = LE;
+            card(std::min(k, n), n, xs, out);
+        }
+
+        /**
+           \brief Create the first k outputs of a network sorting xs.
+           If at_most holds, out[i] is implied if at least i+1 literals of xs are true.
+           If at_least holds, out[i] implies that at least i+1 literals of xs are true.
+           With both directions the outputs serve at-most, at-least and exactly
+           constraints over xs for all bounds below k.
+         */
+        void card_outputs(bool at_most, bool at_least, unsigned k, unsigned n, literal const* xs, literal_vector& out) {
+            SASSERT(at_most || at_least);
+            m_t = at_most ? (at_least ? EQ : LE) : GE;
+            card(std::min(k, n), n, xs, out);
+        }
+
     private:
         vc vc_sorting(unsigned n) {
             switch(n) {
@@ -21,6 +21,7 @@ Notes:
 #include "util/str_hashtable.h"
 #include "util/buffer.h"
 #include "util/smt2_util.h"
+#include "util/symbol.h"
 #include<iomanip>
 
 void statistics::update(char const * key, unsigned inc) {
@@ -243,4 +244,9 @@ void get_memory_statistics(statistics& st) {
 
 void get_rlimit_statistics(reslimit& l, statistics& st) {
     get_uint64_stats(st, "rlimit count", l.count());
+    l.for_each_account([&](char const * name, uint64_t count) {
+        // statistics keep the key, so it is interned
+        symbol key(("rlimit " + std::string(name)).c_str());
+        get_uint64_stats(st, key.bare_str(), count);
+    });
 }
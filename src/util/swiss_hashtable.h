@@ -0,0 +1,454 @@
+/*++
+Copyright (c) 2021 Microsoft Corporation
+
+Module Name:
+
+    swiss_hashtable.h
+
+Abstract:
+
+    Open addressing hashtable with control bytes and group probing.
+
+    The table has the interface of core_hashtable and uses the same
+    entries. Besides the entries, it keeps one control byte per slot:
+    the slot is empty, deleted, or it is used and the control byte
+    stores 7 bits of the hash code. A lookup probes groups of
+    GROUP_SIZE slots. The control bytes of a group are compared with
+    the hash bits at once (using SSE2 when it is available), and only
+    the entries whose control byte matches are compared.
+
+    The state of an entry is kept in sync with its control byte, so
+    the iterators of core_hashtable can be used.
+
+--*/
+#pragma once
+
+#include <cstring>
+#include "util/hashtable.h"
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define SWISS_HASHTABLE_SSE2
+#endif
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+template<typename Entry, typename HashProc, typename EqProc>
+class swiss_hashtable : private HashProc, private EqProc {
+public:
+    typedef typename Entry::data data;
+    typedef Entry                entry;
+    typedef typename core_hashtable<Entry, HashProc, EqProc>::iterator iterator;
+
+protected:
+    static const unsigned GROUP_SIZE = 16;
+    static const signed char CTRL_EMPTY   = -128;
+    static const signed char CTRL_DELETED = -2;
+
+    signed char * m_ctrl;
+    Entry *       m_table;
+    unsigned      m_capacity;
+    unsigned      m_size;
+    unsigned      m_num_deleted;
+
+    static signed char h2(unsigned hash) { return static_cast<signed char>(hash >> 25); }
+
+    static unsigned first_bit(unsigned mask) {
+        SASSERT(mask != 0);
+#if defined(__GNUC__) || defined(__clang__)
+        return __builtin_ctz(mask);
+#elif defined(_MSC_VER)
+        unsigned long r;
+        _BitScanForward(&r, mask);
+        return r;
+#else
+        unsigned r = 0;
+        while ((mask & 1) == 0) { mask >>= 1; ++r; }
+        return r;
+#endif
+    }
+
+#ifdef SWISS_HASHTABLE_SSE2
+    static unsigned match(signed char const * g, signed char c) {
+        __m128i ctrl = _mm_loadu_si128(reinterpret_cast<__m128i const*>(g));
+        return static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(c), ctrl)));
+    }
+    static unsigned match_free(signed char const * g) {
+        // empty and deleted slots are the ones with the sign bit set
+        __m128i ctrl = _mm_loadu_si128(reinterpret_cast<__m128i const*>(g));
+        return static_cast<unsigned>(_mm_movemask_epi8(ctrl));
+    }
+#else
+    static unsigned match(signed char const * g, signed char c) {
+        unsigned r = 0;
+        for (unsigned i = 0; i < GROUP_SIZE; ++i)
+            if (g[i] == c)
+                r |= (1u << i);
+        return r;
+    }
+    static unsigned match_free(signed char const * g) {
+        unsigned r = 0;
+        for (unsigned i = 0; i < GROUP_SIZE; ++i)
+            if (g[i] < 0)
+                r |= (1u << i);
+        return r;
+    }
+#endif
+    static unsigned match_empty(signed char const * g) { return match(g, CTRL_EMPTY); }
+
+    unsigned num_groups() const { return m_capacity / GROUP_SIZE; }
+
+    unsigned get_hash(data const & e) const { return HashProc::operator()(e); }
+    bool equals(data const & e1, data const & e2) const { return EqProc::operator()(e1, e2); }
+
+    static unsigned adjust_capacity(unsigned c) {
+        return c < GROUP_SIZE ? GROUP_SIZE : c;
+    }
+
+    void alloc_table(unsigned capacity) {
+        SASSERT(is_power_of_two(capacity) && capacity >= GROUP_SIZE);
+        m_capacity = capacity;
+        m_table    = alloc_vect<Entry>(capacity);
+        m_ctrl     = static_cast<signed char*>(memory::allocate(capacity));
+        memset(m_ctrl, CTRL_EMPTY, capacity);
+    }
+
+    void delete_table() {
+        if (m_table) {
+            dealloc_vect(m_table, m_capacity);
+            memory::deallocate(m_ctrl);
+        }
+        m_table = nullptr;
+        m_ctrl  = nullptr;
+    }
+
+    /**
+       \brief Return the first free slot on the probe sequence of hash.
+       Groups are probed in triangular order, which visits every group.
+    */
+    unsigned find_free_slot(unsigned hash) const {
+        unsigned gmask = num_groups() - 1;
+        unsigned g     = hash & gmask;
+        for (unsigned step = 1; ; ++step) {
+            unsigned mask = match_free(m_ctrl + g * GROUP_SIZE);
+            if (mask)
+                return g * GROUP_SIZE + first_bit(mask);
+            g = (g + step) & gmask;
+        }
+    }
+
+    void move_to(Entry * source, signed char * ctrl, unsigned capacity) {
+        for (unsigned i = 0; i < capacity; ++i) {
+            if (ctrl[i] >= 0) {
+                unsigned hash = source[i].get_hash();
+                unsigned j    = find_free_slot(hash);
+                m_ctrl[j]     = h2(hash);
+                m_table[j]    = std::move(source[i]);
+            }
+        }
+    }
+
+    void rehash(unsigned new_capacity) {
+        Entry *       old_table    = m_table;
+        signed char * old_ctrl     = m_ctrl;
+        unsigned      old_capacity = m_capacity;
+        alloc_table(new_capacity);
+        move_to(old_table, old_ctrl, old_capacity);
+        dealloc_vect(old_table, old_capacity);
+        memory::deallocate(old_ctrl);
+        m_num_deleted = 0;
+    }
+
+    void reserve_slot() {
+        if ((m_size + m_num_deleted + 1) * 8 > m_capacity * 7)
+            rehash(m_num_deleted > m_size ? m_capacity : m_capacity << 1);
+    }
+
+    /**
+       \brief Return the slot of e, or UINT_MAX if e is not in the table.
+    */
+    unsigned find_slot(data const & e, unsigned hash) const {
+        unsigned gmask = num_groups() - 1;
+        unsigned g     = hash & gmask;
+        signed char c  = h2(hash);
+        for (unsigned step = 1; step <= num_groups(); ++step) {
+            signed char const * grp = m_ctrl + g * GROUP_SIZE;
+            unsigned mask = match(grp, c);
+            while (mask) {
+                unsigned i = g * GROUP_SIZE + first_bit(mask);
+                if (m_table[i].get_hash() == hash && equals(m_table[i].get_data(), e))
+                    return i;
+                mask &= mask - 1;
+            }
+            if (match_empty(grp))
+                return UINT_MAX;
+            g = (g + step) & gmask;
+        }
+        return UINT_MAX;
+    }
+
+    entry * insert_new(data && e, unsigned hash) {
+        unsigned i = find_free_slot(hash);
+        if (m_ctrl[i] == CTRL_DELETED)
+            m_num_deleted--;
+        m_ctrl[i] = h2(hash);
+        m_table[i].set_data(std::move(e));
+        m_table[i].set_hash(hash);
+        m_size++;
+        return m_table + i;
+    }
+
+public:
+    swiss_hashtable(unsigned initial_capacity = DEFAULT_HASHTABLE_INITIAL_CAPACITY,
+                    HashProc const & h = HashProc(),
+                    EqProc const & e = EqProc()):
+        HashProc(h),
+        EqProc(e),
+        m_size(0),
+        m_num_deleted(0) {
+        SASSERT(is_power_of_two(initial_capacity));
+        alloc_table(adjust_capacity(initial_capacity));
+    }
+
+    swiss_hashtable(swiss_hashtable const & source):
+        HashProc(source),
+        EqProc(source),
+        m_size(0),
+        m_num_deleted(0) {
+        alloc_table(source.m_capacity);
+        for (unsigned i = 0; i < m_capacity; ++i) {
+            m_ctrl[i] = source.m_ctrl[i] == CTRL_DELETED ? CTRL_EMPTY : source.m_ctrl[i];
+            if (m_ctrl[i] >= 0)
+                m_table[i] = source.m_table[i];
+        }
+        m_size = source.m_size;
+        if (source.m_num_deleted > 0) {
+            // slots that were deleted in source are empty in this table
+            rehash(m_capacity);
+        }
+    }
+
+    swiss_hashtable(swiss_hashtable && source) noexcept:
+        HashProc(source),
+        EqProc(source),
+        m_ctrl(nullptr),
+        m_table(nullptr),
+        m_capacity(source.m_capacity),
+        m_size(source.m_size),
+        m_num_deleted(source.m_num_deleted) {
+        std::swap(m_table, source.m_table);
+        std::swap(m_ctrl, source.m_ctrl);
+    }
+
+    ~swiss_hashtable() {
+        delete_table();
+    }
+
+    void swap(swiss_hashtable & source) {
+        std::swap(m_ctrl,        source.m_ctrl);
+        std::swap(m_table,       source.m_table);
+        std::swap(m_capacity,    source.m_capacity);
+        std::swap(m_size,        source.m_size);
+        std::swap(m_num_deleted, source.m_num_deleted);
+    }
+
+    void reset() {
+        if (m_size == 0 && m_num_deleted == 0)
+            return;
+        unsigned overhead = m_capacity - m_size - m_num_deleted;
+        for (unsigned i = 0; i < m_capacity; ++i)
+            if (m_ctrl[i] >= 0)
+                m_table[i].mark_as_free();
+        if (m_capacity > 16 && overhead << 2 > (m_capacity * 3)) {
+            delete_table();
+            alloc_table(m_capacity >> 1);
+        }
+        else {
+            memset(m_ctrl, CTRL_EMPTY, m_capacity);
+        }
+        m_size        = 0;
+        m_num_deleted = 0;
+    }
+
+    void finalize() {
+        if (m_capacity > SMALL_TABLE_CAPACITY) {
+            delete_table();
+            alloc_table(SMALL_TABLE_CAPACITY);
+            m_size        = 0;
+            m_num_deleted = 0;
+        }
+        else {
+            reset();
+        }
+    }
+
+    bool empty() const { return m_size == 0; }
+
+    unsigned size() const { return m_size; }
+
+    unsigned capacity() const { return m_capacity; }
+
+    iterator begin() const { return iterator(m_table, m_table + m_capacity); }
+
+    iterator end() const { return iterator(m_table + m_capacity, m_table + m_capacity); }
+
+    void insert(data && e) {
+        unsigned hash = get_hash(e);
+        unsigned i    = find_slot(e, hash);
+        if (i != UINT_MAX) {
+            m_table[i].set_data(std::move(e));
+            return;
+        }
+        reserve_slot();
+        insert_new(std::move(e), hash);
+    }
+
+    void insert(const data & e) {
+        data tmp(e);
+        insert(std::move(tmp));
+    }
+
+    /**
+       \brief Insert the element e if it is not in the table.
+       Return true if it is a new element, and false otherwise.
+       Store the entry/slot of the table in et.
+    */
+    bool insert_if_not_there_core(data && e, entry * & et) {
+        unsigned hash = get_hash(e);
+        unsigned i    = find_slot(e, hash);
+        if (i != UINT_MAX) {
+            et = m_table + i;
+            return false;
+        }
+        reserve_slot();
+        et = insert_new(std::move(e), hash);
+        return true;
+    }
+
+    bool insert_if_not_there_core(const data & e, entry * & et) {
+        data temp(e);
+        return insert_if_not_there_core(std::move(temp), et);
+    }
+
+    data const & insert_if_not_there(data const & e) {
+        entry * et;
+        insert_if_not_there_core(e, et);
+        return et->get_data();
+    }
+
+    entry * insert_if_not_there2(data const & e) {
+        entry * et;
+        insert_if_not_there_core(e, et);
+        return et;
+    }
+
+    entry * find_core(data const & e) const {
+        unsigned i = find_slot(e, get_hash(e));
+        return i == UINT_MAX ? nullptr : m_table + i;
+    }
+
+    bool find(data const & k, data & r) const {
+        entry * e = find_core(k);
+        if (e != nullptr) {
+            r = e->get_data();
+            return true;
+        }
+        return false;
+    }
+
+    bool contains(data const & e) const {
+        return find_core(e) != nullptr;
+    }
+
+    iterator find(data const & e) const {
+        entry * r = find_core(e);
+        if (r)
+            return iterator(r, m_table + m_capacity);
+        else
+            return end();
+    }
+
+    void remove(data const & e) {
+        unsigned i = find_slot(e, get_hash(e));
+        if (i == UINT_MAX)
+            return;
+        m_table[i].mark_as_free();
+        m_size--;
+        // a probe does not pass a group that has an empty slot;
+        // the slot can therefore be reused as an empty slot.
+        if (match_empty(m_ctrl + (i / GROUP_SIZE) * GROUP_SIZE)) {
+            m_ctrl[i] = CTRL_EMPTY;
+        }
+        else {
+            m_ctrl[i] = CTRL_DELETED;
+            m_num_deleted++;
+        }
+    }
+
+    void erase(data const & e) { remove(e); }
+
+    swiss_hashtable& operator|=(swiss_hashtable const& other) {
+        if (this == &other) return *this;
+        for (const data& d : other)
+            insert(d);
+        return *this;
+    }
+
+    swiss_hashtable& operator&=(swiss_hashtable const& other) {
+        if (this == &other) return *this;
+        swiss_hashtable copy(*this);
+        for (const data& d : copy)
+            if (!other.contains(d))
+                remove(d);
+        return *this;
+    }
+
+    swiss_hashtable& operator=(swiss_hashtable const& other) {
+        if (this == &other) return *this;
+        reset();
+        for (const data& d : other)
+            insert(d);
+        return *this;
+    }
+
+#ifdef Z3DEBUG
+    bool check_invariant() {
+        unsigned num_deleted = 0;
+        unsigned num_used    = 0;
+        for (unsigned i = 0; i < m_capacity; ++i) {
+            if (m_ctrl[i] == CTRL_DELETED)
+                num_deleted++;
+            if (m_ctrl[i] >= 0) {
+                SASSERT(m_table[i].is_used());
+                SASSERT(m_ctrl[i] == h2(m_table[i].get_hash()));
+                num_used++;
+            }
+        }
+        SASSERT(num_deleted == m_num_deleted);
+        SASSERT(num_used == m_size);
+        return true;
+    }
+#endif
+
+    unsigned long long get_num_collision() const { return 0; }
+
+    void get_collisions(data const& e, vector<data>& collisions) {
+        unsigned hash = get_hash(e);
+        unsigned gmask = num_groups() - 1;
+        unsigned g     = hash & gmask;
+        for (unsigned step = 1; step <= num_groups(); ++step) {
+            signed char const * grp = m_ctrl + g * GROUP_SIZE;
+            for (unsigned j = 0; j < GROUP_SIZE; ++j) {
+                unsigned i = g * GROUP_SIZE + j;
+                if (grp[j] < 0)
+                    continue;
+                if (m_table[i].get_hash() == hash && equals(m_table[i].get_data(), e))
+                    return;
+                collisions.push_back(m_table[i].get_data());
+            }
+            if (match_empty(grp))
+                return;
+            g = (g + step) & gmask;
+        }
+    }
+};
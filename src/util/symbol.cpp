@@ -52,9 +52,8 @@ public:
         DEALLOC_MUTEX(lock);
     }
 
-    char const * get_str(char const * d) {
+    char const * get_str_core(char const * d) {
         const char * result;
-        lock_guard _lock(*lock);
         str_hashtable::entry * e;
         if (m_table.insert_if_not_there_core(d, e)) {
             // new entry
@@ -74,6 +73,20 @@ public:
         SASSERT(m_table.contains(result));
         return result;
     }
+
+    char const * get_str(char const * d) {
+        lock_guard _lock(*lock);
+        return get_str_core(d);
+    }
+
+    /**
+       \brief Intern the strings ds[idxs[i]] under a single lock.
+    */
+    void get_strs(unsigned n, unsigned const * idxs, char const * const * ds, char const ** result) {
+        lock_guard _lock(*lock);
+        for (unsigned i = 0; i < n; ++i)
+            result[idxs[i]] = get_str_core(ds[idxs[i]]);
+    }
 };
 }
 
@@ -90,6 +103,11 @@ void finalize_symbols() {
     g_symbol_tables.reset();
 }
 
+static void intern_symbols(unsigned n, char const * const * ds, char const ** result) {
+    for (unsigned i = 0; i < n; ++i)
+        result[i] = ds[i] ? g_symbol_tables->get_str(ds[i]) : nullptr;
+}
+
 #else
 
 struct internal_symbol_tables {
@@ -108,12 +126,78 @@ struct internal_symbol_tables {
         dealloc_vect<internal_symbol_table*>(tables, sz);
     }
 
-    char const * get_str(char const * d) {
-        auto* table = tables[string_hash(d, static_cast<unsigned>(strlen(d)), 251) % sz];
-        return table->get_str(d);
-    }
+    unsigned shard(unsigned h) const { return h % sz; }
+
+    char const * get_str(char const * d);
+
+    void get_strs(unsigned n, char const * const * ds, char const ** result);
 };
 
+/**
+   \brief Each thread caches the strings it interned recently, so that a
+   repeated string is found without taking the lock of its table.
+   The cache is invalidated when the tables are finalized.
+*/
+#define SYMBOL_CACHE_SIZE 1024
+
+struct symbol_cache {
+    unsigned     m_epoch;
+    char const * m_strs[SYMBOL_CACHE_SIZE];
+};
+
+static thread_local symbol_cache g_symbol_cache;
+static std::atomic<unsigned>     g_symbol_epoch(1);
+
+static char const *& cached_str(unsigned h) {
+    symbol_cache & c = g_symbol_cache;
+    unsigned epoch = g_symbol_epoch.load(std::memory_order_relaxed);
+    if (c.m_epoch != epoch) {
+        memset(c.m_strs, 0, sizeof(c.m_strs));
+        c.m_epoch = epoch;
+    }
+    return c.m_strs[h & (SYMBOL_CACHE_SIZE - 1)];
+}
+
+char const * internal_symbol_tables::get_str(char const * d) {
+    unsigned h = string_hash(d, static_cast<unsigned>(strlen(d)), 251);
+    char const *& r = cached_str(h);
+    if (r && strcmp(r, d) == 0)
+        return r;
+    r = tables[shard(h)]->get_str(d);
+    return r;
+}
+
+void internal_symbol_tables::get_strs(unsigned n, char const * const * ds, char const ** result) {
+    unsigned_vector hashes, idxs;
+    svector<unsigned> offsets(sz + 1, 0u);
+    for (unsigned i = 0; i < n; ++i) {
+        result[i] = nullptr;
+        unsigned h = 0;
+        if (ds[i]) {
+            h = string_hash(ds[i], static_cast<unsigned>(strlen(ds[i])), 251);
+            char const * r = cached_str(h);
+            if (r && strcmp(r, ds[i]) == 0)
+                result[i] = r;
+            else
+                offsets[shard(h) + 1]++;
+        }
+        hashes.push_back(h);
+    }
+    // bucket the missing strings by table
+    for (unsigned j = 0; j < sz; ++j)
+        offsets[j + 1] += offsets[j];
+    idxs.resize(offsets[sz]);
+    svector<unsigned> pos(offsets);
+    for (unsigned i = 0; i < n; ++i)
+        if (ds[i] && !result[i])
+            idxs[pos[shard(hashes[i])]++] = i;
+    for (unsigned j = 0; j < sz; ++j)
+        if (offsets[j] < offsets[j + 1])
+            tables[j]->get_strs(offsets[j + 1] - offsets[j], idxs.data() + offsets[j], ds, result);
+    for (unsigned i = 0; i < n; ++i)
+        if (ds[i])
+            cached_str(hashes[i]) = result[i];
+}
 
 static internal_symbol_tables* g_symbol_tables = nullptr;
 
@@ -128,6 +212,11 @@ void initialize_symbols() {
 void finalize_symbols() {
     dealloc(g_symbol_tables);
     g_symbol_tables = nullptr;
+    ++g_symbol_epoch;
+}
+
+static void intern_symbols(unsigned n, char const * const * ds, char const ** result) {
+    g_symbol_tables->get_strs(n, ds, result);
 }
 #endif
 
@@ -143,6 +232,14 @@ symbol & symbol::operator=(char const * d) {
     return *this;
 }
 
+void symbol::intern(unsigned n, char const * const * ds, symbol * result) {
+    svector<char const *> strs;
+    strs.resize(n, nullptr);
+    intern_symbols(n, ds, strs.data());
+    for (unsigned i = 0; i < n; ++i)
+        result[i].m_data = strs[i];
+}
+
 std::string symbol::str() const {
     SASSERT(!is_marked());
     if (GET_TAG(m_data) == 0) {
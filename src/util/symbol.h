@@ -64,6 +64,11 @@ public:
     static symbol dummy() { return m_dummy; }
     static const symbol null;
     symbol & operator=(char const * d);
+    /**
+       \brief Create the symbols for the strings ds[0], ..., ds[n-1]. The strings of
+       the same table are interned under a single lock.
+    */
+    static void intern(unsigned n, char const * const * ds, symbol * result);
     friend bool operator==(symbol const & s1, symbol const & s2) { return s1.m_data == s2.m_data; }
     friend bool operator!=(symbol const & s1, symbol const & s2) { return s1.m_data != s2.m_data; }
     bool is_numerical() const { return GET_TAG(m_data) == 1; }
@@ -0,0 +1,129 @@
+/*++
+Copyright (c) 2021 Microsoft Corporation
+
+Module Name:
+
+    thread_pool.cpp
+
+Abstract:
+
+    Run tasks on threads that are reused across the process.
+
+--*/
+
+#include "util/thread_pool.h"
+#include "util/util.h"
+#include "util/memory_manager.h"
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+struct thread_pool_worker {
+    std::thread              m_thread;
+    std::function<void()>    m_task;
+    thread_pool*             m_group { nullptr };
+    int                      m_work { 0 };      // 0: idle, 1: task assigned, 2: exit
+    std::condition_variable  m_cv;
+    static void loop(thread_pool_worker* w);
+};
+
+static std::vector<thread_pool_worker*> available_workers;
+static std::mutex workers;
+static std::atomic<unsigned> num_workers(0);
+
+void thread_pool_worker::loop(thread_pool_worker* w) {
+    std::unique_lock<std::mutex> lock(workers);
+    while (true) {
+        w->m_cv.wait(lock, [=] { return w->m_work > 0; });
+        if (w->m_work == 2)
+            return;
+        lock.unlock();
+        w->m_task();
+        w->m_task = nullptr;
+        thread_pool* group = w->m_group;
+        w->m_group = nullptr;
+        lock.lock();
+        w->m_work = 0;
+        available_workers.push_back(w);
+        lock.unlock();
+        // the group may be destroyed as soon as the task is reported done.
+        group->task_done();
+        lock.lock();
+    }
+}
+
+struct thread_pool::imp {
+    std::mutex              m_mutex;
+    std::condition_variable m_cv;
+    unsigned                m_running { 0 };
+};
+
+thread_pool::thread_pool():
+    m_imp(alloc(imp)) {
+}
+
+thread_pool::~thread_pool() {
+    join();
+    dealloc(m_imp);
+}
+
+void thread_pool::task_done() {
+    std::lock_guard<std::mutex> lock(m_imp->m_mutex);
+    --m_imp->m_running;
+    m_imp->m_cv.notify_all();
+}
+
+void thread_pool::run(std::function<void()> const& task) {
+    {
+        std::lock_guard<std::mutex> lock(m_imp->m_mutex);
+        ++m_imp->m_running;
+    }
+    thread_pool_worker* w = nullptr;
+    std::unique_lock<std::mutex> lock(workers);
+    if (!available_workers.empty()) {
+        w = available_workers.back();
+        available_workers.pop_back();
+        w->m_task = task;
+        w->m_group = this;
+        w->m_work = 1;
+        w->m_cv.notify_one();
+        return;
+    }
+    lock.unlock();
+    w = new thread_pool_worker;
+    ++num_workers;
+    w->m_task = task;
+    w->m_group = this;
+    w->m_work = 1;
+    w->m_thread = std::thread(thread_pool_worker::loop, w);
+}
+
+void thread_pool::join() {
+    std::unique_lock<std::mutex> lock(m_imp->m_mutex);
+    m_imp->m_cv.wait(lock, [&] { return m_imp->m_running == 0; });
+}
+
+void thread_pool::finalize() {
+    unsigned deleted = 0;
+    while (deleted < num_workers) {
+        decltype(available_workers) cleanup_workers;
+        {
+            std::lock_guard<std::mutex> lock(workers);
+            for (auto w : available_workers) {
+                w->m_work = 2;
+                w->m_cv.notify_one();
+            }
+            std::swap(available_workers, cleanup_workers);
+        }
+        for (auto w : cleanup_workers) {
+            ++deleted;
+            w->m_thread.join();
+            delete w;
+        }
+        if (deleted < num_workers)
+            std::this_thread::yield();
+    }
+    num_workers = 0;
+}
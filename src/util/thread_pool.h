@@ -0,0 +1,48 @@
+/*++
+Copyright (c) 2021 Microsoft Corporation
+
+Module Name:
+
+    thread_pool.h
+
+Abstract:
+
+    Run tasks on threads that are reused across the process.
+
+    A thread_pool object is a group of tasks. Each task is started on an
+    idle worker thread, or on a new worker when all workers are busy, so
+    the tasks of a group run concurrently as if each had its own
+    std::thread. Workers return to a process-wide list of idle workers
+    when their task is done and are reused by later groups.
+
+    Tasks are canceled cooperatively through the reslimit of the managers
+    they use. A task must not throw.
+
+--*/
+#pragma once
+
+#include <functional>
+
+struct thread_pool_worker;
+
+class thread_pool {
+    friend struct thread_pool_worker;
+    struct imp;
+    imp* m_imp;
+    void task_done();
+public:
+    thread_pool();
+    ~thread_pool();
+
+    /**
+       \brief Start task on a worker thread.
+    */
+    void run(std::function<void()> const& task);
+
+    /**
+       \brief Wait until all tasks started by this group are done.
+    */
+    void join();
+
+    static void finalize();
+};
@@ -14,6 +14,7 @@ Author:
     Nikolaj Bjorner (nbjorner) 2021-01-26
 
 --*/
+#include <cstring>
 #include "util/gparams.h"
 #include "util/zstring.h"
 
@@ -71,17 +72,84 @@ bool zstring::is_escape_char(char const *& s, unsigned& result) {
     return false;
 }
 
+zstring::chars* zstring::mk_chars(unsigned sz, bool wide) {
+    SASSERT(sz > 0);
+    void* mem = memory::allocate(sizeof(chars) + sz * (wide ? sizeof(uint32_t) : sizeof(uint8_t)));
+    chars* c = new (mem) chars();
+    c->m_ref    = 1;
+    c->m_size   = sz;
+    c->m_wide   = wide;
+    return c;
+}
+
+void zstring::dec_ref() {
+    if (m_chars && --m_chars->m_ref == 0) {
+        m_chars->~chars();
+        memory::deallocate(m_chars);
+    }
+    m_chars  = nullptr;
+    m_offset = 0;
+    m_length = 0;
+}
+
+void zstring::init(unsigned sz, unsigned const* s) {
+    SASSERT(!m_chars);
+    if (sz == 0)
+        return;
+    bool wide = false;
+    for (unsigned i = 0; !wide && i < sz; ++i)
+        wide = s[i] > 255;
+    m_chars  = mk_chars(sz, wide);
+    m_length = sz;
+    if (wide) {
+        memcpy(m_chars->wide(), s, sz * sizeof(uint32_t));
+    }
+    else {
+        uint8_t* d = m_chars->narrow();
+        for (unsigned i = 0; i < sz; ++i)
+            d[i] = static_cast<uint8_t>(s[i]);
+    }
+}
+
+zstring& zstring::operator=(zstring const& other) {
+    if (m_chars != other.m_chars) {
+        chars* c = other.m_chars;
+        if (c)
+            c->m_ref++;
+        dec_ref();
+        m_chars = c;
+    }
+    m_offset = other.m_offset;
+    m_length = other.m_length;
+    return *this;
+}
+
+zstring& zstring::operator=(zstring && other) noexcept {
+    if (this != &other) {
+        dec_ref();
+        m_chars  = other.m_chars;
+        m_offset = other.m_offset;
+        m_length = other.m_length;
+        other.m_chars  = nullptr;
+        other.m_offset = 0;
+        other.m_length = 0;
+    }
+    return *this;
+}
+
 zstring::zstring(char const* s) {
+    buffer<unsigned> chs;
     while (*s) {
         unsigned ch = 0;
         if (is_escape_char(s, ch)) {
-            m_buffer.push_back(ch);
+            chs.push_back(ch);
         }
         else {
-            m_buffer.push_back(*s);
+            chs.push_back(*s);
             ++s;
         }
     }
+    init(chs.size(), chs.data());
     SASSERT(well_formed());
 }
 
@@ -96,7 +164,8 @@ string_encoding zstring::get_encoding() {
 }
 
 bool zstring::well_formed() const {
-    for (unsigned ch : m_buffer) {
+    for (unsigned i = 0; i < length(); ++i) {
+        unsigned ch = (*this)[i];
         if (ch > max_char()) {
             IF_VERBOSE(0, verbose_stream() << "large character: " << ch << "\n";);
             return false;
@@ -106,41 +175,41 @@ bool zstring::well_formed() const {
 }
 
 zstring::zstring(unsigned ch) {
-    m_buffer.push_back(ch);
+    init(1, &ch);
 }
 
 zstring zstring::reverse() const {
     zstring result;
-    for (unsigned i = length(); i-- > 0; ) {
-        result.m_buffer.push_back(m_buffer[i]);
+    if (empty())
+        return result;
+    result.m_chars  = mk_chars(length(), is_wide());
+    result.m_length = length();
+    if (is_wide()) {
+        uint32_t* d = result.m_chars->wide();
+        for (unsigned i = 0; i < length(); ++i)
+            d[i] = wide()[length() - i - 1];
+    }
+    else {
+        uint8_t* d = result.m_chars->narrow();
+        for (unsigned i = 0; i < length(); ++i)
+            d[i] = narrow()[length() - i - 1];
     }
     return result;
 }
 
 zstring zstring::replace(zstring const& src, zstring const& dst) const {
-    zstring result;
     if (length() < src.length()) {
         return zstring(*this);
     }
     if (src.length() == 0) {
         return dst + zstring(*this);
     }
-    bool found = false;
-    for (unsigned i = 0; i < length(); ++i) {
-        bool eq = !found && i + src.length() <= length();
-        for (unsigned j = 0; eq && j < src.length(); ++j) {
-            eq = m_buffer[i+j] == src[j];
-        }
-        if (eq) {
-            result.m_buffer.append(dst.m_buffer);
-            found = true;
-            i += src.length() - 1;
-        }
-        else {
-            result.m_buffer.push_back(m_buffer[i]);
-        }
+    int i = indexofu(src, 0);
+    if (i < 0) {
+        return zstring(*this);
     }
-    return result;
+    unsigned j = static_cast<unsigned>(i);
+    return extract(0, j) + dst + extract(j + src.length(), length() - j - src.length());
 }
 
 std::string zstring::encode() const {
@@ -148,9 +217,9 @@ std::string zstring::encode() const {
     char buffer[100];
     unsigned offset = 0;
 #define _flush() if (offset > 0) { buffer[offset] = 0; strm << buffer; offset = 0; }
-    for (unsigned i = 0; i < m_buffer.size(); ++i) {
-        unsigned ch = m_buffer[i];
-        if (ch < 32 || ch >= 128 || ('\\' == ch && i + 1 < m_buffer.size() && 'u' == m_buffer[i+1])) {
+    for (unsigned i = 0; i < length(); ++i) {
+        unsigned ch = (*this)[i];
+        if (ch < 32 || ch >= 128 || ('\\' == ch && i + 1 < length() && 'u' == (*this)[i+1])) {
             _flush();
             strm << "\\u{" << std::hex << ch << std::dec << "}";
         }
@@ -164,35 +233,34 @@ std::string zstring::encode() const {
     return strm.str();
 }
 
+// true if the characters of a at position i are the characters of b
+static bool matches_at(zstring const& a, unsigned i, zstring const& b) {
+    SASSERT(i + b.length() <= a.length());
+    for (unsigned j = 0; j < b.length(); ++j) {
+        if (a[i + j] != b[j])
+            return false;
+    }
+    return true;
+}
+
 bool zstring::suffixof(zstring const& other) const {
     if (length() > other.length()) return false;
-    bool suffix = true;
-    for (unsigned i = 0; suffix && i < length(); ++i) {
-        suffix = m_buffer[length()-i-1] == other[other.length()-i-1];
-    }
-    return suffix;
+    return matches_at(other, other.length() - length(), *this);
 }
 
 bool zstring::prefixof(zstring const& other) const {
     if (length() > other.length()) return false;
-    bool prefix = true;
-    for (unsigned i = 0; prefix && i < length(); ++i) {
-        prefix = m_buffer[i] == other[i];
-    }
-    return prefix;
+    return matches_at(other, 0, *this);
 }
 
 bool zstring::contains(zstring const& other) const {
     if (other.length() > length()) return false;
     unsigned last = length() - other.length();
-    bool cont = false;
-    for (unsigned i = 0; !cont && i <= last; ++i) {
-        cont = true;
-        for (unsigned j = 0; cont && j < other.length(); ++j) {
-            cont = other[j] == m_buffer[j+i];
-        }
+    for (unsigned i = 0; i <= last; ++i) {
+        if (matches_at(*this, i, other))
+            return true;
     }
-    return cont;
+    return false;
 }
 
 int zstring::indexofu(zstring const& other, unsigned offset) const {
@@ -202,11 +270,7 @@ int zstring::indexofu(zstring const& other, unsigned offset) const {
     if (other.length() + offset > length()) return -1;
     unsigned last = length() - other.length();
     for (unsigned i = offset; i <= last; ++i) {
-        bool prefix = true;
-        for (unsigned j = 0; prefix && j < other.length(); ++j) {
-            prefix = m_buffer[i + j] == other[j];
-        }
-        if (prefix) {
+        if (matches_at(*this, i, other)) {
             return static_cast<int>(i);
         }
     }
@@ -217,11 +281,7 @@ int zstring::last_indexof(zstring const& other) const {
     if (other.length() == 0) return length();
     if (other.length() > length()) return -1;
     for (unsigned last = length() - other.length(); last-- > 0; ) {
-        bool suffix = true;
-        for (unsigned j = 0; suffix && j < other.length(); ++j) {
-            suffix = m_buffer[last + j] == other[j];
-        }
-        if (suffix) {
+        if (matches_at(*this, last, other)) {
             return static_cast<int>(last);
         }
     }
@@ -231,20 +291,58 @@ int zstring::last_indexof(zstring const& other) const {
 zstring zstring::extract(unsigned offset, unsigned len) const {
     zstring result;
     if (offset + len < offset) return result;
-    int last = std::min(offset+len, length());
-    for (int i = offset; i < last; ++i) {
-        result.m_buffer.push_back(m_buffer[i]);
+    unsigned last = std::min(offset+len, length());
+    if (offset >= last) return result;
+    unsigned sz = last - offset;
+    // large substrings share the characters,
+    // small ones are copied so that they do not keep large strings alive.
+    if (sz >= 64 && 4 * sz >= m_chars->m_size) {
+        result = *this;
+        result.m_offset += offset;
+        result.m_length = sz;
+    }
+    else if (is_wide()) {
+        result.init(sz, wide() + offset);
+    }
+    else {
+        result.m_chars  = mk_chars(sz, false);
+        result.m_length = sz;
+        memcpy(result.m_chars->narrow(), narrow() + offset, sz);
     }
     return result;
 }
 
 unsigned zstring::hash() const {
-    return unsigned_ptr_hash(m_buffer.data(), m_buffer.size(), 23);
+    if (is_wide())
+        return unsigned_ptr_hash(wide(), length(), 23);
+    buffer<unsigned> chs;
+    for (unsigned i = 0; i < length(); ++i)
+        chs.push_back(narrow()[i]);
+    return unsigned_ptr_hash(chs.data(), chs.size(), 23);
 }
 
 zstring zstring::operator+(zstring const& other) const {
-    zstring result(*this);
-    result.m_buffer.append(other.m_buffer);
+    if (other.empty())
+        return *this;
+    if (empty())
+        return other;
+    zstring result;
+    unsigned sz = length() + other.length();
+    bool w = is_wide() || other.is_wide();
+    result.m_chars  = mk_chars(sz, w);
+    result.m_length = sz;
+    if (w) {
+        uint32_t* d = result.m_chars->wide();
+        for (unsigned i = 0; i < length(); ++i)
+            d[i] = (*this)[i];
+        for (unsigned i = 0; i < other.length(); ++i)
+            d[length() + i] = other[i];
+    }
+    else {
+        uint8_t* d = result.m_chars->narrow();
+        memcpy(d, narrow(), length());
+        memcpy(d + length(), other.narrow(), other.length());
+    }
     return result;
 }
 
@@ -254,12 +352,13 @@ bool zstring::operator==(const zstring& other) const {
     if (length() != other.length()) {
         return false;
     }
-    for (unsigned i = 0; i < length(); ++i) {
-        if (m_buffer[i] != other[i]) {
-            return false;
-        }
+    if (empty() || (m_chars == other.m_chars && m_offset == other.m_offset)) {
+        return true;
     }
-    return true;
+    if (!is_wide() && !other.is_wide()) {
+        return memcmp(narrow(), other.narrow(), length()) == 0;
+    }
+    return matches_at(*this, 0, other);
 }
 
 bool zstring::operator!=(const zstring& other) const {
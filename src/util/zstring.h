@@ -16,6 +16,7 @@ Author:
 --*/
 #pragma once
 
+#include <atomic>
 #include <cstdint>
 #include <string>
 #include "util/buffer.h"
@@ -29,7 +30,30 @@ enum string_encoding {
 
 class zstring {
 private:
-    buffer<uint32_t> m_buffer;
+    // The characters of a string are immutable and shared by its copies
+    // and by large substrings. They take one byte each when all
+    // characters of the string are at most 255.
+    struct chars {
+        std::atomic<unsigned> m_ref;
+        unsigned              m_size;
+        bool                  m_wide;
+        uint8_t * narrow() { return reinterpret_cast<uint8_t*>(this + 1); }
+        uint32_t * wide() { return reinterpret_cast<uint32_t*>(this + 1); }
+        uint8_t const * narrow() const { return reinterpret_cast<uint8_t const*>(this + 1); }
+        uint32_t const * wide() const { return reinterpret_cast<uint32_t const*>(this + 1); }
+    };
+
+    chars*   m_chars { nullptr };
+    unsigned m_offset { 0 };
+    unsigned m_length { 0 };
+
+    static chars* mk_chars(unsigned sz, bool wide);
+    void inc_ref() { if (m_chars) m_chars->m_ref++; }
+    void dec_ref();
+    void init(unsigned sz, unsigned const* s);
+    bool is_wide() const { return m_chars && m_chars->m_wide; }
+    uint8_t const* narrow() const { return m_chars->narrow() + m_offset; }
+    uint32_t const* wide() const { return m_chars->wide() + m_offset; }
     bool well_formed() const;
     bool is_escape_char(char const *& s, unsigned& result);
 public:
@@ -63,17 +87,22 @@ public:
     }
     static string_encoding get_encoding();
     zstring() = default;
+    zstring(zstring const& other): m_chars(other.m_chars), m_offset(other.m_offset), m_length(other.m_length) { inc_ref(); }
+    zstring(zstring && other) noexcept: m_chars(other.m_chars), m_offset(other.m_offset), m_length(other.m_length) { other.m_chars = nullptr; other.m_length = 0; }
     zstring(char const* s);
     zstring(const std::string &str) : zstring(str.c_str()) {}
     zstring(rational const& r): zstring(r.to_string()) {}
-    zstring(unsigned sz, unsigned const* s) { m_buffer.append(sz, s); SASSERT(well_formed()); }
+    zstring(unsigned sz, unsigned const* s) { init(sz, s); SASSERT(well_formed()); }
     zstring(unsigned ch);
+    ~zstring() { dec_ref(); }
+    zstring& operator=(zstring const& other);
+    zstring& operator=(zstring && other) noexcept;
     zstring replace(zstring const& src, zstring const& dst) const;
     zstring reverse() const;
     std::string encode() const;
-    unsigned length() const { return m_buffer.size(); }
-    unsigned operator[](unsigned i) const { return m_buffer[i]; }
-    bool empty() const { return m_buffer.empty(); }
+    unsigned length() const { return m_length; }
+    unsigned operator[](unsigned i) const { SASSERT(i < m_length); return is_wide() ? wide()[i] : narrow()[i]; }
+    bool empty() const { return m_length == 0; }
     bool suffixof(zstring const& other) const;
     bool prefixof(zstring const& other) const;
     bool contains(zstring const& other) const;